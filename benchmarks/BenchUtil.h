@@ -0,0 +1,64 @@
+// @(#)root/benchmarks:$Id$
+// Author: ROOT team
+
+/////////////////////////////////////////////////////////////////
+//
+// Small helpers shared by the micro-benchmarks in this directory.
+//
+// Every benchmark reports, per measured section, the achieved
+// throughput together with a MARKS number: the ratio (in percent)
+// of the measured throughput to a reference value recorded on the
+// reference machine (see README). Comparing the MARKS printed by
+// two releases on the same machine quantifies the performance
+// change of the measured path; the absolute throughputs mostly
+// quantify the machine.
+//
+/////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_BenchUtil
+#define ROOT_BenchUtil
+
+#include "TROOT.h"
+#include "TStopwatch.h"
+
+#include <stdio.h>
+
+namespace BenchUtil {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print one benchmark result line.
+///  - name:      short name of the measured section
+///  - value:     measured throughput
+///  - unit:      unit of the throughput (e.g. "Mevts/s", "MB/s")
+///  - reference: throughput of this section on the reference machine
+
+inline void PrintResult(const char *name, Double_t value, const char *unit,
+                        Double_t reference)
+{
+   Double_t marks = (reference > 0) ? 100.*value/reference : 0;
+   printf("*  %-28s %10.2f %-10s MARKS = %7.1f  *\n", name, value, unit, marks);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the standard header/trailer of a benchmark program.
+
+inline void PrintHeader(const char *benchname)
+{
+   printf("****************************************************************\n");
+   printf("*  Benchmark: %-48s  *\n", benchname);
+   printf("*  Root%-8s  %d/%d %34s  *\n", gROOT->GetVersion(),
+          gROOT->GetVersionDate(), gROOT->GetVersionTime(), "");
+   printf("****************************************************************\n");
+}
+
+inline void PrintTrailer(TStopwatch &timer)
+{
+   printf("****************************************************************\n");
+   printf("*  Real Time = %7.2f seconds, Cpu Time = %7.2f seconds      *\n",
+          timer.RealTime(), timer.CpuTime());
+   printf("****************************************************************\n");
+}
+
+} // namespace BenchUtil
+
+#endif
@@ -0,0 +1,112 @@
+// @(#)root/benchmarks:$Id$
+// Author: ROOT team
+
+/////////////////////////////////////////////////////////////////
+//
+// Micro-benchmark of object streaming through TBufferFile:
+//  - writing a TH1D into a memory buffer
+//  - reading it back
+//  - writing/reading a TClonesArray of TNamed objects
+//
+// This isolates the Streamer/TClass machinery from file and
+// compression effects (see benchTreeIO for those).
+//
+// Usage:  benchTBufferFile [iterations]   (default 20000)
+//
+/////////////////////////////////////////////////////////////////
+
+#include "TBufferFile.h"
+#include "TClonesArray.h"
+#include "TH1.h"
+#include "TNamed.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include "BenchUtil.h"
+
+#include <stdlib.h>
+
+// Throughputs (MB/s of buffer payload) on the reference machine, see README
+static const Double_t kRefHistW  = 900.;
+static const Double_t kRefHistR  = 650.;
+static const Double_t kRefArrayW = 250.;
+static const Double_t kRefArrayR = 180.;
+
+int main(int argc, char **argv)
+{
+   Int_t niter = 20000;
+   if (argc > 1) niter = atoi(argv[1]);
+
+   BenchUtil::PrintHeader("benchTBufferFile: object streaming");
+
+   TStopwatch total;
+   total.Start();
+
+   TStopwatch timer;
+   Int_t i;
+
+   // ------ payloads
+   TH1D hist("hist", "streamed histogram", 1000, -4, 4);
+   TRandom3 rndm(4357);
+   hist.FillRandom("gaus", 100000);
+
+   TClonesArray arr("TNamed", 100);
+   for (i = 0; i < 100; i++)
+      new (arr[i]) TNamed(Form("named%d", i), "a named object with a title");
+
+   // ------ TH1D write
+   TBufferFile wbuf(TBuffer::kWrite, 1024*1024);
+   Double_t nbytes = 0;
+   timer.Start();
+   for (i = 0; i < niter; i++) {
+      wbuf.Reset();
+      wbuf.WriteObjectAny(&hist, TH1D::Class());
+      nbytes += wbuf.Length();
+   }
+   timer.Stop();
+   BenchUtil::PrintResult("TH1D streaming (write)", nbytes/timer.RealTime()/1.e6,
+                          "MB/s", kRefHistW);
+
+   // ------ TH1D read
+   timer.Start();
+   nbytes = 0;
+   for (i = 0; i < niter; i++) {
+      TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+      TH1D *h = (TH1D *) rbuf.ReadObjectAny(TH1D::Class());
+      nbytes += rbuf.Length();
+      delete h;
+   }
+   timer.Stop();
+   BenchUtil::PrintResult("TH1D streaming (read)", nbytes/timer.RealTime()/1.e6,
+                          "MB/s", kRefHistR);
+
+   // ------ TClonesArray write
+   wbuf.Reset();
+   timer.Start();
+   nbytes = 0;
+   for (i = 0; i < niter; i++) {
+      wbuf.Reset();
+      wbuf.WriteObjectAny(&arr, TClonesArray::Class());
+      nbytes += wbuf.Length();
+   }
+   timer.Stop();
+   BenchUtil::PrintResult("TClonesArray (write)", nbytes/timer.RealTime()/1.e6,
+                          "MB/s", kRefArrayW);
+
+   // ------ TClonesArray read
+   timer.Start();
+   nbytes = 0;
+   for (i = 0; i < niter; i++) {
+      TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+      TClonesArray *a = (TClonesArray *) rbuf.ReadObjectAny(TClonesArray::Class());
+      nbytes += rbuf.Length();
+      delete a;
+   }
+   timer.Stop();
+   BenchUtil::PrintResult("TClonesArray (read)", nbytes/timer.RealTime()/1.e6,
+                          "MB/s", kRefArrayR);
+
+   total.Stop();
+   BenchUtil::PrintTrailer(total);
+   return 0;
+}
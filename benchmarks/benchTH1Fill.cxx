@@ -0,0 +1,111 @@
+// @(#)root/benchmarks:$Id$
+// Author: ROOT team
+
+/////////////////////////////////////////////////////////////////
+//
+// Micro-benchmark of the histogram filling hot paths:
+//  - TH1D::Fill with unit weight
+//  - TH1D::Fill with weight
+//  - TH1D::FillN (bulk filling from arrays)
+//  - TH2D::Fill
+//  - TProfile::Fill
+//
+// The input values are pre-generated so that only the filling
+// itself is timed, not the random number generation.
+//
+// Usage:  benchTH1Fill [nfills-in-million]   (default 20)
+//
+/////////////////////////////////////////////////////////////////
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include "BenchUtil.h"
+
+#include <stdlib.h>
+#include <vector>
+
+// Throughputs (Mfills/s) measured on the reference machine, see README
+static const Double_t kRefFill1D   = 110.;
+static const Double_t kRefFill1DW  = 100.;
+static const Double_t kRefFillN    = 180.;
+static const Double_t kRefFill2D   =  55.;
+static const Double_t kRefFillProf =  45.;
+
+int main(int argc, char **argv)
+{
+   Long64_t nfill = 20;
+   if (argc > 1) nfill = atoll(argv[1]);
+   nfill *= 1000000;
+
+   BenchUtil::PrintHeader("benchTH1Fill: histogram filling");
+
+   TStopwatch total;
+   total.Start();
+
+   // Pre-generate the values to be filled (chunked, reused cyclically)
+   const Int_t nbuf = 1000000;
+   std::vector<Double_t> x(nbuf), y(nbuf), w(nbuf);
+   TRandom3 rndm(4357);
+   for (Int_t i = 0; i < nbuf; i++) {
+      x[i] = rndm.Gaus(0, 1);
+      y[i] = rndm.Gaus(0, 2);
+      w[i] = 0.5 + rndm.Rndm();
+   }
+
+   TStopwatch timer;
+   Long64_t i, done;
+
+   // ------ TH1D::Fill, unit weight
+   TH1D h1("h1", "h1", 100, -4, 4);
+   timer.Start();
+   for (i = 0, done = 0; done < nfill; ++done, i = (i+1 == nbuf) ? 0 : i+1)
+      h1.Fill(x[i]);
+   timer.Stop();
+   BenchUtil::PrintResult("TH1D::Fill", nfill/timer.RealTime()/1.e6,
+                          "Mfills/s", kRefFill1D);
+
+   // ------ TH1D::Fill, weighted
+   TH1D h1w("h1w", "h1w", 100, -4, 4);
+   h1w.Sumw2();
+   timer.Start();
+   for (i = 0, done = 0; done < nfill; ++done, i = (i+1 == nbuf) ? 0 : i+1)
+      h1w.Fill(x[i], w[i]);
+   timer.Stop();
+   BenchUtil::PrintResult("TH1D::Fill (weighted)", nfill/timer.RealTime()/1.e6,
+                          "Mfills/s", kRefFill1DW);
+
+   // ------ TH1D::FillN, bulk interface
+   TH1D h1n("h1n", "h1n", 100, -4, 4);
+   timer.Start();
+   for (done = 0; done < nfill; done += nbuf)
+      h1n.FillN(nbuf, &x[0], 0);
+   timer.Stop();
+   BenchUtil::PrintResult("TH1D::FillN", done/timer.RealTime()/1.e6,
+                          "Mfills/s", kRefFillN);
+
+   // ------ TH2D::Fill
+   TH2D h2("h2", "h2", 40, -4, 4, 40, -8, 8);
+   timer.Start();
+   for (i = 0, done = 0; done < nfill; ++done, i = (i+1 == nbuf) ? 0 : i+1)
+      h2.Fill(x[i], y[i]);
+   timer.Stop();
+   BenchUtil::PrintResult("TH2D::Fill", nfill/timer.RealTime()/1.e6,
+                          "Mfills/s", kRefFill2D);
+
+   // ------ TProfile::Fill
+   TProfile hp("hp", "hp", 100, -4, 4);
+   timer.Start();
+   for (i = 0, done = 0; done < nfill; ++done, i = (i+1 == nbuf) ? 0 : i+1)
+      hp.Fill(x[i], y[i]);
+   timer.Stop();
+   BenchUtil::PrintResult("TProfile::Fill", nfill/timer.RealTime()/1.e6,
+                          "Mfills/s", kRefFillProf);
+
+   total.Stop();
+   BenchUtil::PrintTrailer(total);
+   return 0;
+}
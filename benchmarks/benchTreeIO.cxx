@@ -0,0 +1,141 @@
+// @(#)root/benchmarks:$Id$
+// Author: ROOT team
+
+/////////////////////////////////////////////////////////////////
+//
+// Micro-benchmark of the TTree I/O path:
+//  - writing a canned dataset (plain branches, zlib level 1)
+//  - reading it back without a cache (basket decompression path)
+//  - reading it back through the TTreeCache, reporting the cache
+//    efficiency together with the throughput
+//
+// The dataset is generated on the fly in the current directory
+// (bench_tree.root, removed at the end), so results are
+// reproducible without shipping data files.
+//
+// Usage:  benchTreeIO [nevents]   (default 1000000)
+//
+/////////////////////////////////////////////////////////////////
+
+#include "TFile.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "BenchUtil.h"
+
+#include <stdlib.h>
+
+// Throughputs on the reference machine, see README
+static const Double_t kRefWrite     = 4.0;   // Mevts/s
+static const Double_t kRefReadNoCa  = 5.0;   // Mevts/s
+static const Double_t kRefReadCache = 5.5;   // Mevts/s
+static const Double_t kRefDecomp    = 250.;  // MB/s of uncompressed baskets
+
+static const char *kFileName = "bench_tree.root";
+
+int main(int argc, char **argv)
+{
+   Long64_t nevents = 1000000;
+   if (argc > 1) nevents = atoll(argv[1]);
+
+   BenchUtil::PrintHeader("benchTreeIO: tree write/read, basket decompression");
+
+   TStopwatch total;
+   total.Start();
+
+   TStopwatch timer;
+   Long64_t i;
+
+   Int_t    ev, ntrk;
+   Double_t px, py, pz;
+   Double_t pos[3];
+   Double_t trkpt[50];
+
+   // ------ write the canned dataset
+   {
+      TFile f(kFileName, "RECREATE", "TreeIO benchmark file", 101); // zlib level 1
+      TTree tree("bench", "TreeIO benchmark tree");
+      tree.Branch("ev", &ev, "ev/I");
+      tree.Branch("px", &px, "px/D");
+      tree.Branch("py", &py, "py/D");
+      tree.Branch("pz", &pz, "pz/D");
+      tree.Branch("pos", pos, "pos[3]/D");
+      tree.Branch("ntrk", &ntrk, "ntrk/I");
+      tree.Branch("trkpt", trkpt, "trkpt[ntrk]/D");
+
+      TRandom3 rndm(4357);
+      timer.Start();
+      for (i = 0; i < nevents; i++) {
+         ev = i;
+         px = rndm.Gaus(0, 1);
+         py = rndm.Gaus(0, 1);
+         pz = rndm.Gaus(0, 5);
+         pos[0] = rndm.Rndm(); pos[1] = rndm.Rndm(); pos[2] = rndm.Gaus(0, 10);
+         ntrk = 1 + Int_t(49*rndm.Rndm());
+         for (Int_t k = 0; k < ntrk; k++) trkpt[k] = rndm.Exp(10.);
+         tree.Fill();
+      }
+      tree.Write();
+      timer.Stop();
+      BenchUtil::PrintResult("TTree write (zlib-1)", nevents/timer.RealTime()/1.e6,
+                             "Mevts/s", kRefWrite);
+   }
+
+   // ------ read back without cache: times the basket decompression path
+   {
+      TFile f(kFileName);
+      TTree *tree = (TTree *) f.Get("bench");
+      tree->SetCacheSize(0);
+      tree->SetBranchAddress("ev", &ev);
+      tree->SetBranchAddress("px", &px);
+      tree->SetBranchAddress("py", &py);
+      tree->SetBranchAddress("pz", &pz);
+      tree->SetBranchAddress("pos", pos);
+      tree->SetBranchAddress("ntrk", &ntrk);
+      tree->SetBranchAddress("trkpt", trkpt);
+      timer.Start();
+      for (i = 0; i < nevents; i++) tree->GetEntry(i);
+      timer.Stop();
+      BenchUtil::PrintResult("TTree read (no cache)", nevents/timer.RealTime()/1.e6,
+                             "Mevts/s", kRefReadNoCa);
+      BenchUtil::PrintResult("Basket decompression",
+                             tree->GetTotBytes()/timer.RealTime()/1.e6,
+                             "MB/s", kRefDecomp);
+   }
+
+   // ------ read back through the TTreeCache
+   {
+      TFile f(kFileName);
+      TTree *tree = (TTree *) f.Get("bench");
+      tree->SetCacheSize(10000000);
+      tree->AddBranchToCache("*", kTRUE);
+      tree->SetBranchAddress("ev", &ev);
+      tree->SetBranchAddress("px", &px);
+      tree->SetBranchAddress("py", &py);
+      tree->SetBranchAddress("pz", &pz);
+      tree->SetBranchAddress("pos", pos);
+      tree->SetBranchAddress("ntrk", &ntrk);
+      tree->SetBranchAddress("trkpt", trkpt);
+      timer.Start();
+      for (i = 0; i < nevents; i++) tree->GetEntry(i);
+      timer.Stop();
+      BenchUtil::PrintResult("TTree read (TTreeCache)", nevents/timer.RealTime()/1.e6,
+                             "Mevts/s", kRefReadCache);
+
+      TTreeCache *cache = (TTreeCache *) f.GetCacheRead(tree);
+      if (cache) {
+         printf("*  %-28s %10.3f (rel %6.3f), %d read calls %8s*\n",
+                "TTreeCache efficiency", cache->GetEfficiency(),
+                cache->GetEfficiencyRel(), f.GetReadCalls(), "");
+      }
+   }
+
+   gSystem->Unlink(kFileName);
+
+   total.Stop();
+   BenchUtil::PrintTrailer(total);
+   return 0;
+}
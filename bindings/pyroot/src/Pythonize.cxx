@@ -32,6 +32,7 @@
 #include "TObjArray.h"
 #include "TSeqCollection.h"
 
+#include "TBuffer.h"
 #include "TTree.h"
 #include "TBranch.h"
 #include "TBranchElement.h"
@@ -1830,6 +1831,309 @@ namespace {
       return self;
    }
 
+//- zero-copy numpy views -----------------------------------------------------
+   PyObject* BuildArrayInterface( void* data, const char* typestr, Py_ssize_t nx, Py_ssize_t ny )
+   {
+   // Build a version 3 __array_interface__ dictionary for the given storage;
+   // pass ny < 0 for a flat view. Numpy keeps the python object providing the
+   // dictionary alive through the base of the view it creates, which ties the
+   // lifetime of the view to the ROOT object owning the storage.
+      PyObject* shape = 0;
+      if ( 0 <= ny )
+         shape = Py_BuildValue( (char*)"(nn)", nx, ny );
+      else
+         shape = Py_BuildValue( (char*)"(n)", nx );
+
+      PyObject* dict = PyDict_New();
+      PyObject* item = PyInt_FromLong( 3 );
+      PyDict_SetItemString( dict, (char*)"version", item );
+      Py_DECREF( item );
+      item = PyROOT_PyUnicode_FromString( typestr );
+      PyDict_SetItemString( dict, (char*)"typestr", item );
+      Py_DECREF( item );
+      PyDict_SetItemString( dict, (char*)"shape", shape );
+      Py_DECREF( shape );
+      item = Py_BuildValue( (char*)"(NO)", PyLong_FromVoidPtr( data ), Py_False );
+      PyDict_SetItemString( dict, (char*)"data", item );
+      Py_DECREF( item );
+      return dict;
+   }
+
+   const char* LeafTypestr( const char* typeName )
+   {
+   // Map a ROOT basic type name onto a numpy typestr in native byte order,
+   // or 0 when there is no fixed-size equivalent.
+#ifdef R__BYTESWAP
+      static const char byteorder = '<';
+#else
+      static const char byteorder = '>';
+#endif
+      static char typestr[ 4 ] = { 0, 0, 0, 0 };
+      typestr[ 0 ] = byteorder;
+      if      ( strcmp( typeName, "Double_t" ) == 0 )  { typestr[1] = 'f'; typestr[2] = '8'; }
+      else if ( strcmp( typeName, "Float_t" ) == 0 )   { typestr[1] = 'f'; typestr[2] = '4'; }
+      else if ( strcmp( typeName, "Long64_t" ) == 0 )  { typestr[1] = 'i'; typestr[2] = '8'; }
+      else if ( strcmp( typeName, "ULong64_t" ) == 0 ) { typestr[1] = 'u'; typestr[2] = '8'; }
+      else if ( strcmp( typeName, "Int_t" ) == 0 )     { typestr[1] = 'i'; typestr[2] = '4'; }
+      else if ( strcmp( typeName, "UInt_t" ) == 0 )    { typestr[1] = 'u'; typestr[2] = '4'; }
+      else if ( strcmp( typeName, "Short_t" ) == 0 )   { typestr[1] = 'i'; typestr[2] = '2'; }
+      else if ( strcmp( typeName, "UShort_t" ) == 0 )  { typestr[1] = 'u'; typestr[2] = '2'; }
+      else if ( strcmp( typeName, "Char_t" ) == 0 )    { typestr[0] = '|'; typestr[1] = 'i'; typestr[2] = '1'; }
+      else if ( strcmp( typeName, "UChar_t" ) == 0 )   { typestr[0] = '|'; typestr[1] = 'u'; typestr[2] = '1'; }
+      else if ( strcmp( typeName, "Bool_t" ) == 0 )    { typestr[0] = '|'; typestr[1] = 'b'; typestr[2] = '1'; }
+      else return 0;
+      return typestr;
+   }
+
+   void* GetBufferPointer( PyObject* pybuf )
+   {
+   // Retrieve the raw memory address wrapped by a PyROOT low level view.
+      void* data = 0;
+      Py_ssize_t buflen = 0;
+      if ( PyObject_AsWriteBuffer( pybuf, &data, &buflen ) == -1 ) {
+         PyErr_Clear();
+         return 0;
+      }
+      return data;
+   }
+
+   PyObject* ArrayInterfaceFromTArray( ObjectProxy* self )
+   {
+   // __array_interface__ getter for classes with TArray storage (the arrays
+   // themselves and the histograms): a flat zero-copy view of the element
+   // array; for histograms this includes the under- and overflow bins.
+      TClass* klass = OP2TCLASS( self );
+      const char* typestr = 0;
+      if      ( klass->InheritsFrom( "TArrayD" ) ) typestr = LeafTypestr( "Double_t" );
+      else if ( klass->InheritsFrom( "TArrayF" ) ) typestr = LeafTypestr( "Float_t" );
+      else if ( klass->InheritsFrom( "TArrayI" ) ) typestr = LeafTypestr( "Int_t" );
+      else if ( klass->InheritsFrom( "TArrayL" ) )
+         typestr = LeafTypestr( sizeof(Long_t) == 8 ? "Long64_t" : "Int_t" );
+      else if ( klass->InheritsFrom( "TArrayS" ) ) typestr = LeafTypestr( "Short_t" );
+      else if ( klass->InheritsFrom( "TArrayC" ) ) typestr = LeafTypestr( "Char_t" );
+      if ( ! typestr ) {
+         PyErr_Format( PyExc_TypeError, "%s has no TArray storage", klass->GetName() );
+         return 0;
+      }
+
+      PyObject* pybuf = CallPyObjMethod( (PyObject*)self, "GetArray" );
+      if ( ! pybuf )
+         return 0;
+      void* data = GetBufferPointer( pybuf );
+      Py_DECREF( pybuf );
+
+      PyObject* pysize = CallPyObjMethod( (PyObject*)self, "GetSize" );
+      if ( ! pysize )
+         return 0;
+      Py_ssize_t size = PyInt_AsSsize_t( pysize );
+      Py_DECREF( pysize );
+
+      if ( ! data || size < 0 ) {
+         PyErr_Format( PyExc_ValueError, "cannot access the storage of %s", klass->GetName() );
+         return 0;
+      }
+      return BuildArrayInterface( data, typestr, size, -1 );
+   }
+
+   PyObject* ArrayInterfaceFromMatrix( ObjectProxy* self )
+   {
+   // __array_interface__ getter for TMatrixT/TVectorT instantiations: the
+   // element storage is contiguous and row major, so matrices map onto 2-d
+   // views and vectors onto flat ones.
+      TClass* klass = OP2TCLASS( self );
+      std::string clName = klass->GetName();
+      const char* typestr = 0;
+      if ( clName.find( "<double>" ) != std::string::npos ) typestr = LeafTypestr( "Double_t" );
+      else if ( clName.find( "<float>" ) != std::string::npos ) typestr = LeafTypestr( "Float_t" );
+      if ( ! typestr ) {
+         PyErr_Format( PyExc_TypeError, "no fixed-size element type for %s", clName.c_str() );
+         return 0;
+      }
+
+      PyObject* pybuf = CallPyObjMethod( (PyObject*)self, "GetMatrixArray" );
+      if ( ! pybuf )
+         return 0;
+      void* data = GetBufferPointer( pybuf );
+      Py_DECREF( pybuf );
+
+      PyObject* pyrows = CallPyObjMethod( (PyObject*)self, "GetNrows" );
+      if ( ! pyrows )
+         return 0;
+      Py_ssize_t nrows = PyInt_AsSsize_t( pyrows );
+      Py_DECREF( pyrows );
+
+      Py_ssize_t ncols = -1;
+      if ( clName.substr( 0, 8 ) != "TVectorT" ) {
+         PyObject* pycols = CallPyObjMethod( (PyObject*)self, "GetNcols" );
+         if ( ! pycols )
+            return 0;
+         ncols = PyInt_AsSsize_t( pycols );
+         Py_DECREF( pycols );
+      }
+
+      if ( ! data || nrows < 0 ) {
+         PyErr_Format( PyExc_ValueError, "cannot access the storage of %s", clName.c_str() );
+         return 0;
+      }
+      return BuildArrayInterface( data, typestr, nrows, ncols );
+   }
+
+   void AddArrayInterface( PyObject* pyclass, PyCFunction cfunc )
+   {
+   // Install cfunc as the getter of the __array_interface__ property.
+      Utility::AddToClass( pyclass, "_get_array_interface", cfunc, METH_NOARGS );
+      PyObject* getter = PyObject_GetAttrString( pyclass, (char*)"_get_array_interface" );
+      if ( ! getter ) {
+         PyErr_Clear();
+         return;
+      }
+      PyObject* property = PyObject_CallFunctionObjArgs( (PyObject*)&PyProperty_Type, getter, NULL );
+      Py_DECREF( getter );
+      if ( ! property ) {
+         PyErr_Clear();
+         return;
+      }
+      PyObject_SetAttrString( pyclass, (char*)"__array_interface__", property );
+      Py_DECREF( property );
+   }
+
+//- zero-copy views of bulk branch reads --------------------------------------
+   struct BulkViewProxy {
+      PyObject_HEAD
+      PyObject* fArrayInterface;   // prebuilt __array_interface__ dictionary
+      PyObject* fOwner;            // python proxy of the TBuffer owning the data
+   };
+
+   void bulkview_dealloc( BulkViewProxy* view )
+   {
+      Py_XDECREF( view->fArrayInterface );
+      Py_XDECREF( view->fOwner );
+      PyObject_Del( view );
+   }
+
+   PyObject* bulkview_getai( BulkViewProxy* view, void* )
+   {
+      Py_INCREF( view->fArrayInterface );
+      return view->fArrayInterface;
+   }
+
+   PyGetSetDef bulkview_getset[] = {
+      { (char*)"__array_interface__", (getter)bulkview_getai, NULL, NULL, NULL },
+      { (char*)NULL, NULL, NULL, NULL, NULL }
+   };
+
+   PyTypeObject BulkViewProxy_Type = {
+      PyVarObject_HEAD_INIT( &PyType_Type, 0 )
+      (char*)"ROOT.TBranchBulkView",       // tp_name
+      sizeof(BulkViewProxy),     // tp_basicsize
+      0,                         // tp_itemsize
+      (destructor)bulkview_dealloc, // tp_dealloc
+      0,                         // tp_print
+      0,                         // tp_getattr
+      0,                         // tp_setattr
+      0,                         // tp_compare
+      0,                         // tp_repr
+      0,                         // tp_as_number
+      0,                         // tp_as_sequence
+      0,                         // tp_as_mapping
+      0,                         // tp_hash
+      0,                         // tp_call
+      0,                         // tp_str
+      0,                         // tp_getattro
+      0,                         // tp_setattro
+      0,                         // tp_as_buffer
+      Py_TPFLAGS_DEFAULT,        // tp_flags
+      (char*)"zero-copy view of a bulk branch read",      // tp_doc
+      0,                         // tp_traverse
+      0,                         // tp_clear
+      0,                         // tp_richcompare
+      0,                         // tp_weaklistoffset
+      0,                         // tp_iter
+      0,                         // tp_iternext
+      0,                         // tp_methods
+      0,                         // tp_members
+      bulkview_getset,           // tp_getset
+      0,                         // tp_base
+      0,                         // tp_dict
+      0,                         // tp_descr_get
+      0,                         // tp_descr_set
+      0,                         // tp_dictoffset
+      0,                         // tp_init
+      0,                         // tp_alloc
+      0,                         // tp_new
+      0,                         // tp_free
+      0,                         // tp_is_gc
+      0,                         // tp_bases
+      0,                         // tp_mro
+      0,                         // tp_cache
+      0,                         // tp_subclasses
+      0                          // tp_weaklist
+#if PY_VERSION_HEX >= 0x02030000
+      , 0                        // tp_del
+#endif
+#if PY_VERSION_HEX >= 0x02060000
+      , 0                        // tp_version_tag
+#endif
+#if PY_VERSION_HEX >= 0x03040000
+      , 0                        // tp_finalize
+#endif
+   };
+
+   PyObject* TBranchGetBulkView( ObjectProxy* self, PyObject* args )
+   {
+   // Deserialize as many consecutive entries as one basket holds into the
+   // given TBuffer (TBranch::GetBulkEntries) and return (nentries, view),
+   // where view exposes the values as a zero-copy, native-order numpy array
+   // through the __array_interface__ protocol. The view holds a reference to
+   // the buffer proxy, so the storage stays alive as long as any array
+   // created from it. Returns (n, None) with n <= 0 when the branch does not
+   // support bulk reading or the entry does not exist.
+      Long64_t entry = 0;
+      PyObject* pybuf = 0;
+      if ( ! PyArg_ParseTuple( args, const_cast< char* >( "LO:GetBulkView" ), &entry, &pybuf ) )
+         return 0;
+
+      if ( ! BulkViewProxy_Type.tp_dict && PyType_Ready( &BulkViewProxy_Type ) < 0 )
+         return 0;
+
+      TBranch* branch =
+         (TBranch*)OP2TCLASS(self)->DynamicCast( TBranch::Class(), self->GetObject() );
+      TBuffer* buf = 0;
+      if ( ObjectProxy_Check( pybuf ) && ((ObjectProxy*)pybuf)->GetObject() )
+         buf = (TBuffer*)OP2TCLASS((ObjectProxy*)pybuf)->DynamicCast(
+            TBuffer::Class(), ((ObjectProxy*)pybuf)->GetObject() );
+      if ( ! branch || ! buf ) {
+         PyErr_SetString( PyExc_TypeError,
+            "GetBulkView must be called with a TBranch instance, an entry number and a TBuffer" );
+         return 0;
+      }
+
+      Int_t nentries = branch->GetBulkEntries( entry, *buf );
+      if ( nentries <= 0 )
+         return Py_BuildValue( (char*)"iO", nentries, Py_None );
+
+      TLeaf* leaf = (TLeaf*)branch->GetListOfLeaves()->UncheckedAt( 0 );
+      const char* typestr = LeafTypestr( leaf->GetTypeName() );
+      if ( ! typestr ) {
+         PyErr_Format( PyExc_TypeError,
+            "unsupported leaf type %s for a bulk view", leaf->GetTypeName() );
+         return 0;
+      }
+
+      // values start at the current position of the buffer
+      void* data = buf->Buffer() + buf->Length();
+      Py_ssize_t len = leaf->GetLen();
+
+      BulkViewProxy* view = PyObject_New( BulkViewProxy, &BulkViewProxy_Type );
+      view->fArrayInterface = ( 1 < len ) ?
+         BuildArrayInterface( data, typestr, nentries, len ) :
+         BuildArrayInterface( data, typestr, nentries, -1 );
+      Py_INCREF( pybuf );
+      view->fOwner = pybuf;
+
+      return Py_BuildValue( (char*)"iN", nentries, view );
+   }
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -2588,9 +2892,13 @@ Bool_t PyROOT::Pythonize( PyObject* pyclass, const std::string& name )
       Py_DECREF( ctor );
    }
 
-   else if ( name == "TH1" )       // allow hist *= scalar
+   else if ( name == "TH1" ) {     // allow hist *= scalar
       Utility::AddToClass( pyclass, "__imul__", (PyCFunction) THNIMul, METH_O );
 
+   // zero-copy numpy view of the bin contents (through the TArray base)
+      AddArrayInterface( pyclass, (PyCFunction) ArrayInterfaceFromTArray );
+   }
+
    else if ( name == "TF1" )       // allow instantiation with python callable
       Utility::AddToClass( pyclass, "__init__", new TF1InitWithPyFunc );
 
@@ -2636,12 +2944,26 @@ Bool_t PyROOT::Pythonize( PyObject* pyclass, const std::string& name )
       Utility::AddToClass( pyclass, "_getitem__unchecked", "__getitem__" );
       Utility::AddToClass( pyclass, "__getitem__", (PyCFunction) CheckedGetItem, METH_O );
 
+   // zero-copy numpy view of the element storage
+      AddArrayInterface( pyclass, (PyCFunction) ArrayInterfaceFromMatrix );
+
+   }
+
+   else if ( name.substr(0,8) == "TMatrixT" ) {  // zero-copy numpy view (2-d)
+      AddArrayInterface( pyclass, (PyCFunction) ArrayInterfaceFromMatrix );
+   }
+
+   else if ( name == "TBranch" ) { // zero-copy numpy view of bulk basket reads
+      Utility::AddToClass( pyclass, "GetBulkView", (PyCFunction) TBranchGetBulkView, METH_VARARGS );
    }
 
    else if ( name.substr(0,6) == "TArray" && name != "TArray" ) {    // allow proper iteration
       // __len__ is already set from GetSize()
       Utility::AddToClass( pyclass, "_getitem__unchecked", "__getitem__" );
       Utility::AddToClass( pyclass, "__getitem__", (PyCFunction) CheckedGetItem, METH_O );
+
+   // zero-copy numpy view of the element storage
+      AddArrayInterface( pyclass, (PyCFunction) ArrayInterfaceFromTArray );
    }
 
 // Make RooFit 'using' member functions available (not supported by dictionary)
@@ -467,6 +467,11 @@ if(vc)
 else()
   set(hasvc undef)
 endif()
+if(vdt OR builtin_vdt)
+  set(hasvdt define)
+else()
+  set(hasvdt undef)
+endif()
 if(cxx11)
   set(cxxversion cxx11)
   set(usec++11 define)
@@ -18,12 +18,16 @@
 //                                                                      //
 // A set of inline byte swapping routines for arrays.                   //
 //                                                                      //
-// The bswapcpy16() and bswapcpy32() routines are used for packing      //
-// arrays of basic types into a buffer in a byte swapped order. Use     //
-// of asm and the `bswap' opcode (available on i486 and up) reduces     //
-// byte swapping overhead on linux.                                     //
+// The bswapcpy16(), bswapcpy32() and bswapcpy64() routines are used    //
+// for packing arrays of basic types into a buffer in a byte swapped    //
+// order (and back). The loops are plain element-wise swaps written so  //
+// that optimizing compilers recognize the byte swap pattern and emit   //
+// vectorized code (e.g. a single pshufb per vector on x86), which is   //
+// substantially faster than the historical i386 string-instruction     //
+// implementation and works on every architecture.                      //
 //                                                                      //
-// Use of routines is similar to that of memcpy.                        //
+// Use of routines is similar to that of memcpy; the source and        //
+// destination may be unaligned.                                        //
 //                                                                      //
 // ATTENTION:                                                           //
 //                                                                      //
@@ -31,8 +35,8 @@
 //        (It is not the number of bytes!)                              //
 //                                                                      //
 // For arrays of short type (2 bytes in size) use bswapcpy16().         //
-// For arrays of of 4-byte types (int, float) use bswapcpy32().         //
-//                                                                      //
+// For arrays of 4-byte types (int, float) use bswapcpy32().            //
+// For arrays of 8-byte types (long long, double) use bswapcpy64().     //
 //                                                                      //
 // Author: Alexandre V. Vaniachine <AVVaniachine@lbl.gov>               //
 //                                                                      //
@@ -40,42 +44,57 @@
 
 #if !defined(__CINT__)
 #include <sys/types.h>
+#include <string.h>
 #endif
 
-extern inline void * bswapcpy16(void * to, const void * from, size_t n)
+inline void * bswapcpy16(void * to, const void * from, size_t n)
 {
-int d0, d1, d2, d3;
-__asm__ __volatile__(
-        "cld\n"
-        "1:\tlodsw\n\t"
-        "rorw $8, %%ax\n\t"
-        "stosw\n\t"
-        "loop 1b\n\t"
-        :"=&c" (d0), "=&D" (d1), "=&S" (d2), "=&a" (d3)
-        :"0" (n), "1" ((long) to),"2" ((long) from)
-        :"memory");
-return (to);
+   size_t i;
+   const char *f = (const char *) from;
+   char *t = (char *) to;
+   for (i = 0; i < n; i++) {
+      unsigned short v;
+      memcpy(&v, f + 2*i, sizeof(v));
+      v = (unsigned short) ((v >> 8) | (v << 8));
+      memcpy(t + 2*i, &v, sizeof(v));
+   }
+   return to;
 }
 
-extern inline void * bswapcpy32(void * to, const void * from, size_t n)
+inline void * bswapcpy32(void * to, const void * from, size_t n)
 {
-int d0, d1, d2, d3;
-__asm__ __volatile__(
-        "cld\n"
-        "1:\tlodsl\n\t"
-#if !defined __i486__ && !defined __pentium__ && !defined __pentiumpro__ && \
-    !defined __pentium4__ && !defined __x86_64__
-        "rorw $8, %%ax\n\t"
-        "rorl $16, %%eax\n\t"
-        "rorw $8, %%ax\n\t"
-#else
-        "bswap %%eax\n\t"
-#endif
-        "stosl\n\t"
-        "loop 1b\n\t"
-        :"=&c" (d0), "=&D" (d1), "=&S" (d2), "=&a" (d3)
-        :"0" (n), "1" ((long) to),"2" ((long) from)
-        :"memory");
-return (to);
+   size_t i;
+   const char *f = (const char *) from;
+   char *t = (char *) to;
+   for (i = 0; i < n; i++) {
+      unsigned int v;
+      memcpy(&v, f + 4*i, sizeof(v));
+      v = ((v & 0xff000000U) >> 24) | ((v & 0x00ff0000U) >>  8) |
+          ((v & 0x0000ff00U) <<  8) | ((v & 0x000000ffU) << 24);
+      memcpy(t + 4*i, &v, sizeof(v));
+   }
+   return to;
+}
+
+inline void * bswapcpy64(void * to, const void * from, size_t n)
+{
+   size_t i;
+   const char *f = (const char *) from;
+   char *t = (char *) to;
+   for (i = 0; i < n; i++) {
+      unsigned long long v;
+      memcpy(&v, f + 8*i, sizeof(v));
+      v = ((v & 0xff00000000000000ULL) >> 56) |
+          ((v & 0x00ff000000000000ULL) >> 40) |
+          ((v & 0x0000ff0000000000ULL) >> 24) |
+          ((v & 0x000000ff00000000ULL) >>  8) |
+          ((v & 0x00000000ff000000ULL) <<  8) |
+          ((v & 0x0000000000ff0000ULL) << 24) |
+          ((v & 0x000000000000ff00ULL) << 40) |
+          ((v & 0x00000000000000ffULL) << 56);
+      memcpy(t + 8*i, &v, sizeof(v));
+   }
+   return to;
 }
+
 #endif
@@ -69,6 +69,11 @@
 #pragma link C++ function SysError;
 #pragma link C++ function Fatal;
 #pragma link C++ function Obsolete;
+#pragma link C++ function R__TraceEnable;
+#pragma link C++ function R__TraceDisable;
+#pragma link C++ function R__TraceDump;
+#pragma link C++ function R__TraceInstallHandler;
+#pragma link C++ enum ETraceProbe;
 #pragma link C++ function Form;
 #pragma link C++ function Printf;
 #pragma link C++ function Strip;
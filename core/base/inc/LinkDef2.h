@@ -105,6 +105,7 @@
 #pragma link C++ class TMacro+;
 #pragma link C++ class TMD5+;
 #pragma link C++ class TMemberInspector;
+#pragma link C++ class TMemoryGovernor;
 #pragma link C++ class TMessageHandler+;
 #pragma link C++ class TNamed+;
 #pragma link C++ class TObjString+;
@@ -125,6 +126,7 @@
 #pragma link C++ class TStopwatch+;
 #pragma link C++ class TStorage;
 #pragma link C++ class TString-!;
+#pragma link C++ class TStringInterner;
 //#pragma link C++ class TString::Rep_t-!;
 #pragma link off class TString::Rep_t;
 #pragma link C++ class TStringLong-;
@@ -70,6 +70,7 @@ public:
    enum EMode { kRead = 0, kWrite = 1 };
    enum { kIsOwner = BIT(16) };                        //if set TBuffer owns fBuffer
    enum { kCannotHandleMemberWiseStreaming = BIT(17)}; //if set TClonesArray should not use member wise streaming
+   enum { kIsPooled = BIT(19) };                       //if set fBuffer came from TStorage::AllocBuffer
    enum { kInitialSize = 1024, kMinimalSize = 128 };
 
    TBuffer(EMode mode);
@@ -91,6 +91,7 @@ protected:
    TString       fPathBuffer;      //!Buffer for GetPath() function
    TContext     *fContext;         //!Pointer to a list of TContext object pointing to this TDirectory
    static Bool_t fgAddDirectory;   //!flag to add histograms, graphs,etc to the directory
+   static Bool_t fgThreadLocalDirectory; //!flag to give each spawned thread its own working directory
 
           Bool_t  cd1(const char *path);
    static Bool_t  Cd1(const char *path);
@@ -112,6 +113,10 @@ public:
    virtual ~TDirectory();
    static  void        AddDirectory(Bool_t add=kTRUE);
    static  Bool_t      AddDirectoryStatus();
+   static  void        SetThreadLocalDirectory(Bool_t use=kTRUE);
+   static  Bool_t      ThreadLocalDirectoryStatus();
+   static  TDirectory *ThreadLocalDirectory();
+   static  void        MergeThreadLocalDirectories(TDirectory *target = 0);
    virtual void        Append(TObject *obj, Bool_t replace = kFALSE);
    virtual void        Add(TObject *obj, Bool_t replace = kFALSE) { Append(obj,replace); }
    virtual Int_t       AppendKey(TKey *) {return 0;}
@@ -0,0 +1,57 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMemoryGovernor
+#define ROOT_TMemoryGovernor
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMemoryGovernor                                                      //
+//                                                                      //
+// Central accounting of the memory held by the reclaimable buffers of  //
+// a ROOT session (TTreeCache, TFileCacheWrite, ...), grouped in named  //
+// categories, with an optional process-wide budget.  When a budget is  //
+// set and a registered allocation would exceed it, the registered      //
+// reclaim callbacks are invoked to shrink other buffers first.         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+// Reclaim callback: asked to release up to nbytes held by the object ctx;
+// returns the number of bytes actually released.
+typedef Long64_t (*MemReclaimFun_t)(void *ctx, Long64_t nbytes);
+
+class TMemoryGovernor {
+
+private:
+   static Long64_t fgLimit;    // budget in bytes, 0 or negative: accounting only
+   static Bool_t   fgInit;     // limit initialized from rootrc/environment
+
+   static void     InitLimit();
+
+public:
+   virtual ~TMemoryGovernor() { }
+
+   static void     Accumulate(const char *category, Long64_t nbytes);
+   static Long64_t GetUsage(const char *category);
+   static Long64_t GetTotalUsage();
+   static Long64_t GetLimit();
+   static void     SetLimit(Long64_t nbytes);
+   static void     RegisterReclaimer(const char *category, void *ctx, MemReclaimFun_t fun);
+   static void     UnregisterReclaimer(void *ctx);
+   static Bool_t   RequestMemory(const char *category, Long64_t nbytes);
+   static void     Print(Option_t *option = "");
+
+   ClassDef(TMemoryGovernor,0)  //Memory budget manager
+};
+
+#endif
@@ -37,7 +37,9 @@ public:
    TNamed(const char *name, const char *title) : fName(name), fTitle(title) { }
    TNamed(const TString &name, const TString &title) : fName(name), fTitle(title) { }
    TNamed(const TNamed &named);
+   TNamed(TNamed &&named);
    TNamed& operator=(const TNamed& rhs);
+   TNamed& operator=(TNamed&& rhs);
    virtual ~TNamed() { }
    virtual void     Clear(Option_t *option ="");
    virtual TObject *Clone(const char *newname="") const;
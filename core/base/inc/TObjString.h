@@ -24,6 +24,8 @@
 #include "TObject.h"
 #include "TString.h"
 
+#include <utility>
+
 
 class TObjString : public TObject {
 
@@ -33,6 +35,9 @@ private:
 public:
    TObjString(const char *s = "") : fString(s) { }
    TObjString(const TObjString &s) : TObject(), fString(s.fString) { }
+   TObjString(TObjString &&s) : TObject(), fString(std::move(s.fString)) { }
+   TObjString &operator=(const TObjString &s) { fString = s.fString; return *this; }
+   TObjString &operator=(TObjString &&s) { fString = std::move(s.fString); return *this; }
    ~TObjString() { }
    Int_t       Compare(const TObject *obj) const;
    const char *GetName() const { return fString; }
@@ -43,6 +48,7 @@ public:
    Bool_t      IsEqual(const TObject *obj) const;
    void        ReadBuffer(char *&buffer) { fString.ReadBuffer(buffer); }
    void        SetString(const char *s) { fString = s; }
+   void        SetString(TString &&s) { fString = std::move(s); }
    TString     GetString() const { return fString; }
    Int_t       Sizeof() const { return fString.Sizeof(); }
    TString    &String() { return fString; }
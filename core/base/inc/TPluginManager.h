@@ -74,6 +74,13 @@
 //                          "TSapDBServer", "SapDB",                    //
 //             "TSapDBServer(const char*,const char*, const char*)");   //
 //                                                                      //
+// On batch systems the cost of interpreting the plugin macros at       //
+// every job startup can be avoided by generating a snapshot of the     //
+// handler records once, using WriteHandlersSnapshot(), and pointing    //
+// the jobs to it via the Root.PluginSnapshot resource. The snapshot    //
+// is memory mapped read-only and is ignored automatically as soon      //
+// as any plugin macro or directory changes.                            //
+//                                                                      //
 // A list of currently defined handlers can be printed using:           //
 //                                                                      //
 //   gPluginMgr->Print(); // use option="a" to see ctors                //
@@ -183,16 +190,23 @@ public:
 class TPluginManager : public TObject {
 
 private:
-   TList      *fHandlers;     // list of plugin handlers
-   THashTable *fBasesLoaded;  //! table of base classes already checked or loaded
-   Bool_t      fReadingDirs;  //! true if we are running LoadHandlersFromPluginDirs
+   TList      *fHandlers;      // list of plugin handlers
+   THashTable *fBasesLoaded;   //! table of base classes already checked or loaded
+   Bool_t      fReadingDirs;   //! true if we are running LoadHandlersFromPluginDirs
+   char       *fSnapshot;      //! memory mapped plugin handler snapshot
+   Long64_t    fSnapshotLen;   //! length of the mapped snapshot
+   Int_t       fSnapshotState; //! -1 not checked yet, 0 missing or stale, 1 valid
 
    TPluginManager(const TPluginManager& pm);              // not implemented
    TPluginManager& operator=(const TPluginManager& pm);   // not implemented
    void   LoadHandlerMacros(const char *path);
+   Bool_t OpenHandlersSnapshot();
+   void   CloseHandlersSnapshot();
+   Int_t  LoadHandlersFromSnapshot(const char *base);
 
 public:
-   TPluginManager() : fHandlers(0), fBasesLoaded(0), fReadingDirs(kFALSE) { }
+   TPluginManager() : fHandlers(0), fBasesLoaded(0), fReadingDirs(kFALSE),
+      fSnapshot(0), fSnapshotLen(0), fSnapshotState(-1) { }
    ~TPluginManager();
 
    void   LoadHandlersFromEnv(TEnv *env);
@@ -207,6 +221,7 @@ public:
    void   Print(Option_t *opt = "") const;
    Int_t  WritePluginMacros(const char *dir, const char *plugin = 0) const;
    Int_t  WritePluginRecords(const char *envFile, const char *plugin = 0) const;
+   Int_t  WriteHandlersSnapshot(const char *fname = 0) const;
 
    ClassDef(TPluginManager,1)  // Manager for plugin handlers
 };
@@ -72,6 +72,8 @@ private:
    TProcessID(const TProcessID &ref);            // TProcessID are not copiable.
    TProcessID& operator=(const TProcessID &ref); // TProcessID are not copiable.
 
+   static void UpdateSnapshot();  // Rebuild the lock-free snapshot of fgPIDs; caller must hold gROOTMutex.
+
 protected:
    std::atomic_int    fCount;                           //!Reference count to this object (from TFile)
    ROOT::Internal::TAtomicPointer<TObjArray*> fObjects; //!Array pointing to the referenced objects
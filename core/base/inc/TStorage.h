@@ -56,6 +56,9 @@ public:
    static void          *ReAlloc(void *vp, size_t size, size_t oldsize);
    static char          *ReAllocChar(char *vp, size_t size, size_t oldsize);
    static Int_t         *ReAllocInt(Int_t *vp, size_t size, size_t oldsize);
+   static void          *AllocBuffer(size_t size);
+   static char          *ReAllocBuffer(char *vp, size_t size, size_t copysize, size_t oldsize);
+   static void           FreeBuffer(void *vp, size_t size);
    static void          *ObjectAlloc(size_t size);
    static void          *ObjectAllocArray(size_t size);
    static void          *ObjectAlloc(size_t size, void *vp);
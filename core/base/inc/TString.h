@@ -285,6 +285,7 @@ public:
    TString    &operator=(char s);                // Replace string
    TString    &operator=(const char *s);
    TString    &operator=(const TString &s);
+   TString    &operator=(TString &&s);           // Move assignment
    TString    &operator=(const std::string &s);
    TString    &operator=(const std::string_view &s);
    TString    &operator=(const TSubString &s);
@@ -0,0 +1,47 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TStringInterner
+#define ROOT_TStringInterner
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TStringInterner                                                      //
+//                                                                      //
+// Process-wide table of unique, immutable copies of C strings.         //
+// Interning equal character sequences always returns the same          //
+// pointer, so two interned strings can be compared for equality by     //
+// comparing the pointers instead of the characters. The returned       //
+// pointers stay valid for the lifetime of the process; entries are     //
+// never removed. Intended for strings with a bounded vocabulary, like  //
+// branch, leaf and class names, not for arbitrary user data.           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "THashTable.h"
+
+class TStringInterner {
+
+private:
+   THashTable   fTable;     // unique strings (TObjString), owned by the table
+
+   TStringInterner();
+   static TStringInterner *Instance();
+
+public:
+   static const char *Intern(const char *str);
+   static const char *Find(const char *str);
+   static Int_t       GetSize();
+
+   ClassDef(TStringInterner,0)  //Process-wide unique string table
+};
+
+#endif
@@ -0,0 +1,81 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTrace
+#define ROOT_TTrace
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Hot-path tracing.                                                    //
+//                                                                      //
+// A fixed set of probes compiled into performance critical code paths  //
+// (basket read and unzip, TClass resolution, autoparse, lock           //
+// acquisition). Each probe is a single predicted-off branch while      //
+// tracing is inactive; when activated with R__TraceEnable the probes   //
+// append timestamped records to a lock-free in-memory ring buffer      //
+// which can be dumped at any time - including from a signal handler -  //
+// with R__TraceDump. This replaces recompiling with printfs when       //
+// bisecting production stalls; gDebug logging is far too expensive to  //
+// leave in hot loops.                                                  //
+//                                                                      //
+//   R__TraceEnable();                  // allocate ring, arm probes    //
+//   ... run the workload ...                                           //
+//   R__TraceDump();                    // newest records to stderr     //
+//                                                                      //
+// or send SIGUSR2 after R__TraceInstallHandler() to dump a wedged      //
+// process. Timestamps are raw rdtsc cycles on x86 (nanoseconds from    //
+// clock_gettime elsewhere); records carry the thread id, the probe     //
+// id, one integer argument and an optional literal/persistent label.   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <atomic>
+
+/// Probe identifiers; extend at the end and update gTraceProbeName.
+enum ETraceProbe {
+   kTraceBasketRead  = 0,  ///< TBasket::ReadBasketBuffers entered (arg: bytes on file)
+   kTraceBasketUnzip = 1,  ///< basket payload decompression (arg: uncompressed bytes)
+   kTraceClassGet    = 2,  ///< slow path of TClass::GetClass (label: class name)
+   kTraceAutoParse   = 3,  ///< TCling::AutoParse invocation (label: class name)
+   kTraceLock        = 4,  ///< TLockGuard acquisition (arg: mutex address)
+   kTraceUser        = 5,  ///< free for ad hoc instrumentation
+   kTraceNProbes     = 6
+};
+
+R__EXTERN std::atomic<Bool_t> gTraceActive;
+
+/// Append one record to the trace ring. Call through R__TRACE so that the
+/// inactive case costs only a predicted-off branch. The label must outlive
+/// the trace session (string literal or interned/persistent name).
+extern void R__TraceEvent(Int_t probe, Long64_t arg = 0, const char *label = 0);
+
+/// Allocate the ring (nrecords rounded up to a power of two) and arm the
+/// probes. Re-enabling keeps the existing ring.
+extern void R__TraceEnable(UInt_t nrecords = 65536);
+
+/// Disarm the probes; the ring and its content stay available for dumping.
+extern void R__TraceDisable();
+
+/// Write the ring content, oldest record first, to the given file
+/// descriptor. Only uses write() and is async-signal safe.
+extern void R__TraceDump(Int_t fd = 2);
+
+/// Install a signal handler that calls R__TraceDump(2) (default SIGUSR2).
+extern void R__TraceInstallHandler(Int_t signum = 0);
+
+#define R__TRACE(probe, arg, label)                                   \
+   do {                                                               \
+      if (R__unlikely(gTraceActive.load(std::memory_order_relaxed)))  \
+         ::R__TraceEvent(probe, arg, label);                          \
+   } while (false)
+
+#endif
@@ -23,6 +23,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TObject.h"
+#include "TTrace.h"
 
 class TVirtualMutex;
 
@@ -74,7 +75,13 @@ private:
 
 public:
    TLockGuard(TVirtualMutex *mutex)
-     : fMutex(mutex) { if (fMutex) fMutex->Lock(); }
+     : fMutex(mutex)
+   {
+      if (fMutex) {
+         R__TRACE(kTraceLock, (Long64_t)(Long_t)fMutex, 0);
+         fMutex->Lock();
+      }
+   }
    Int_t UnLock() {
       if (!fMutex) return 0;
       auto tmp = fMutex;
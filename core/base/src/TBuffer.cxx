@@ -32,6 +32,22 @@ static char *R__NoReAllocChar(char *, size_t, size_t)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the data buffer, going through the TStorage buffer pool whenever
+/// the regular heap is active. While TMapFile has redirected operator new
+/// into its memory mapped region the pool must stay out of the way: it
+/// recycles plain heap blocks and the two must never mix.
+
+static char *R__AllocBuffer(size_t size, Bool_t &pooled)
+{
+   if (ROOT::Internal::gMmallocDesc) {
+      pooled = kFALSE;
+      return new char[size];
+   }
+   pooled = kTRUE;
+   return (char *) TStorage::AllocBuffer(size);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create an I/O buffer object. Mode should be either TBuffer::kRead or
 /// TBuffer::kWrite. By default the I/O buffer has a size of
@@ -46,7 +62,9 @@ TBuffer::TBuffer(EMode mode)
 
    SetBit(kIsOwner);
 
-   fBuffer = new char[fBufSize+kExtraSpace];
+   Bool_t pooled;
+   fBuffer = R__AllocBuffer(fBufSize+kExtraSpace, pooled);
+   if (pooled) SetBit(kIsPooled);
 
    fBufCur = fBuffer;
    fBufMax = fBuffer + fBufSize;
@@ -68,7 +86,9 @@ TBuffer::TBuffer(EMode mode, Int_t bufsiz)
 
    SetBit(kIsOwner);
 
-   fBuffer = new char[fBufSize+kExtraSpace];
+   Bool_t pooled;
+   fBuffer = R__AllocBuffer(fBufSize+kExtraSpace, pooled);
+   if (pooled) SetBit(kIsPooled);
 
    fBufCur = fBuffer;
    fBufMax = fBuffer + fBufSize;
@@ -106,7 +126,9 @@ TBuffer::TBuffer(EMode mode, Int_t bufsiz, void *buf, Bool_t adopt, ReAllocCharF
       if (fBufSize < kMinimalSize) {
          fBufSize = kMinimalSize;
       }
-      fBuffer = new char[fBufSize+kExtraSpace];
+      Bool_t pooled;
+      fBuffer = R__AllocBuffer(fBufSize+kExtraSpace, pooled);
+      if (pooled) SetBit(kIsPooled);
    }
    fBufCur = fBuffer;
    fBufMax = fBuffer + fBufSize;
@@ -125,7 +147,10 @@ TBuffer::~TBuffer()
 {
    if (TestBit(kIsOwner)) {
       //printf("Deleting fBuffer=%lx\n", fBuffer);
-      delete [] fBuffer;
+      if (TestBit(kIsPooled))
+         TStorage::FreeBuffer(fBuffer, fBufSize + (((fMode&kWrite)!=0) ? kExtraSpace : 0));
+      else
+         delete [] fBuffer;
    }
    fBuffer = 0;
    fParent = 0;
@@ -164,8 +189,14 @@ void TBuffer::AutoExpand(Int_t size_needed)
 
 void TBuffer::SetBuffer(void *buf, UInt_t newsiz, Bool_t adopt, ReAllocCharFun_t reallocfunc)
 {
-   if (fBuffer && TestBit(kIsOwner))
-      delete [] fBuffer;
+   if (fBuffer && TestBit(kIsOwner)) {
+      if (TestBit(kIsPooled))
+         TStorage::FreeBuffer(fBuffer, fBufSize + (((fMode&kWrite)!=0) ? kExtraSpace : 0));
+      else
+         delete [] fBuffer;
+   }
+   // Whatever its provenance, the incoming buffer is not ours to recycle.
+   ResetBit(kIsPooled);
 
    if (adopt)
       SetBit(kIsOwner);
@@ -204,7 +235,18 @@ void TBuffer::Expand(Int_t newsize, Bool_t copy)
    if ( (l > newsize) && copy ) {
       newsize = l;
    }
-   if ( (fMode&kWrite)!=0 ) {
+   if (TestBit(kIsPooled) &&
+       (fReAllocFunc != TStorage::ReAllocChar || ROOT::Internal::gMmallocDesc)) {
+      // A custom reallocator (or the TMapFile mapped region) is about to
+      // replace the allocation behind the pool's back; from here on this is
+      // an ordinary heap buffer.
+      ResetBit(kIsPooled);
+   }
+   if (TestBit(kIsPooled)) {
+      const Int_t extra = ((fMode&kWrite)!=0) ? kExtraSpace : 0;
+      fBuffer  = TStorage::ReAllocBuffer(fBuffer, newsize+extra,
+                                         copy ? fBufSize+extra : 0, fBufSize+extra);
+   } else if ( (fMode&kWrite)!=0 ) {
       fBuffer  = fReAllocFunc(fBuffer, newsize+kExtraSpace,
                               copy ? fBufSize+kExtraSpace : 0);
    } else {
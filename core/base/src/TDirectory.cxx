@@ -9,6 +9,8 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 #include <stdlib.h>
+#include <mutex>
+#include <vector>
 
 #include "Riostream.h"
 #include "Strlen.h"
@@ -25,11 +27,30 @@
 #include "TVirtualMutex.h"
 #include "TThreadSlots.h"
 #include "TMethod.h"
+#include "ThreadLocalStorage.h"
 
 Bool_t TDirectory::fgAddDirectory = kTRUE;
+Bool_t TDirectory::fgThreadLocalDirectory = kFALSE;
 
 const Int_t  kMaxLen = 2048;
 
+namespace {
+   // Registry of the per-thread directories handed out by
+   // TDirectory::ThreadLocalDirectory(), so that the objects they collect can
+   // later be moved to a regular directory by
+   // TDirectory::MergeThreadLocalDirectories().  Function local statics are
+   // used to be independent of the static initialization order across
+   // translation units.
+   std::mutex &R__ThreadDirMutex() {
+      static std::mutex mutex;
+      return mutex;
+   }
+   std::vector<TDirectory*> &R__ThreadDirList() {
+      static std::vector<TDirectory*> dirs;
+      return dirs;
+   }
+}
+
 /** \class TDirectory
 \ingroup Base
 
@@ -144,6 +165,110 @@ Bool_t TDirectory::AddDirectoryStatus()
    return fgAddDirectory;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sets the flag controlling the thread local directory mode.
+///
+/// By default (fgThreadLocalDirectory = kFALSE) every spawned thread starts
+/// with gROOT as its current directory, so objects created on several threads
+/// are all registered in the same (shared) list of objects, serialized by a
+/// global lock.  When the mode is enabled, a spawned thread whose current
+/// directory is still the gROOT default is switched to its own private, in
+/// memory directory (see TDirectory::ThreadLocalDirectory); histograms and
+/// other self registering objects created on that thread are collected there
+/// without locking and without being visible to the other threads.  This
+/// removes the need to call TH1::AddDirectory(kFALSE) in multi-threaded
+/// histogram filling code.
+///
+/// Once the worker threads have terminated, the collected objects can be
+/// moved to a regular (file) directory with
+/// TDirectory::MergeThreadLocalDirectories.
+///
+/// An explicit cd() to a file or directory on a spawned thread takes
+/// precedence over this mode, as does an explicit SetDirectory() on the
+/// object.  The current directory of the main thread is never redirected.
+///
+///  NOTE that this is a static function. To call it, use:
+/// ~~~ {.cpp}
+///     TDirectory::SetThreadLocalDirectory
+/// ~~~
+
+void TDirectory::SetThreadLocalDirectory(Bool_t use)
+{
+   fgThreadLocalDirectory = use;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function: see TDirectory::SetThreadLocalDirectory for more comments.
+
+Bool_t TDirectory::ThreadLocalDirectoryStatus()
+{
+   return fgThreadLocalDirectory;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning the private, in memory directory of the calling
+/// thread, creating it the first time the thread asks for it.
+///
+/// The directory has no mother and is not registered in any list of objects,
+/// so using it (in particular appending to it) requires no locking.  It is
+/// owned by the registry consulted by MergeThreadLocalDirectories and stays
+/// alive after the thread terminates, until its content has been merged.
+
+TDirectory *TDirectory::ThreadLocalDirectory()
+{
+   TTHREAD_TLS(TDirectory*) threadDirectory = 0;
+   if (!threadDirectory) {
+      TDirectory *dir = new TDirectory();
+      {
+         std::lock_guard<std::mutex> guard(R__ThreadDirMutex());
+         dir->fName.Form("Thread_%d", (Int_t)R__ThreadDirList().size());
+         R__ThreadDirList().push_back(dir);
+      }
+      dir->fTitle = "Thread private working directory";
+      dir->Build(0, 0);
+      threadDirectory = dir;
+   }
+   return threadDirectory;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function moving the objects collected in all the thread private
+/// directories (see TDirectory::ThreadLocalDirectory) into the directory
+/// target, or into gROOT if target is not specified.
+///
+/// Objects are moved with their class DirectoryAutoAdd functions, so e.g. a
+/// histogram ends up owned by target exactly as if it had been created there.
+/// This is intended to be called from the main thread once the worker threads
+/// have terminated; it is not safe to call it while other threads are still
+/// creating objects.
+
+void TDirectory::MergeThreadLocalDirectories(TDirectory *target)
+{
+   if (!target) target = gROOT;
+
+   std::vector<TDirectory*> dirs;
+   {
+      std::lock_guard<std::mutex> guard(R__ThreadDirMutex());
+      dirs = R__ThreadDirList();
+   }
+
+   R__LOCKGUARD2(gROOTMutex);
+   for (std::vector<TDirectory*>::iterator idir = dirs.begin(); idir != dirs.end(); ++idir) {
+      TList *list = (*idir)->GetList();
+      if (!list) continue;
+      TObject *obj;
+      while ((obj = list->First())) {
+         list->Remove(obj);
+         ROOT::DirAutoAdd_t func = obj->IsA()->GetDirectoryAutoAdd();
+         if (func) {
+            func(obj, target);
+         } else {
+            target->Append(obj);
+         }
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Append object to this directory.
 ///
@@ -320,8 +445,16 @@ TDirectory *&TDirectory::CurrentDirectory()
    static TDirectory *currentDirectory = 0;
    if (!gThreadTsd)
       return currentDirectory;
-   else
-      return *(TDirectory**)(*gThreadTsd)(&currentDirectory,ROOT::kDirectoryThreadSlot);
+   TDirectory **current = (TDirectory**)(*gThreadTsd)(&currentDirectory,ROOT::kDirectoryThreadSlot);
+   // In thread local directory mode a spawned thread that has not yet cd()'d
+   // anywhere works in its own private directory instead of in gROOT, so that
+   // registering objects does not touch a list shared between the threads.
+   // The main thread (for which gThreadTsd hands back &currentDirectory) is
+   // never redirected.  See TDirectory::SetThreadLocalDirectory.
+   if (fgThreadLocalDirectory && current != &currentDirectory
+       && (!*current || *current == gROOT))
+      *current = ThreadLocalDirectory();
+   return *current;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,240 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TMemoryGovernor
+\ingroup Base
+
+Central accounting of the memory held by the reclaimable buffers of a
+ROOT session, with an optional process-wide budget.
+
+Buffer owners (TFileCacheRead and hence TTreeCache, TFileCacheWrite)
+report the bytes they hold with Accumulate under a category name, and
+can register a reclaim callback able to give memory back.  The usage of
+every category can be queried at any time with GetUsage/GetTotalUsage
+and listed with Print.
+
+By default the governor only does the accounting.  A budget can be set
+with the rootrc variable
+
+    MemoryGovernor.Limit:  0
+
+(in MBytes, 0 keeps the budget disabled), with the environment variable
+ROOT_MEMORY_LIMIT (also in MBytes, overriding the rootrc value), or
+programmatically with SetLimit.  When a budget is active, RequestMemory
+calls that would take the accounted total above it invoke the registered
+reclaim callbacks to shrink the other buffers before the new allocation,
+so that many sessions sharing one node degrade their cache sizes instead
+of taking the node into the ground.
+*/
+
+#include "TMemoryGovernor.h"
+
+#include "TEnv.h"
+#include "TError.h"
+#include "TSystem.h"
+#include "TVirtualMutex.h"
+
+#include <stdlib.h>
+#include <map>
+#include <string>
+#include <vector>
+
+ClassImp(TMemoryGovernor)
+
+Long64_t TMemoryGovernor::fgLimit = 0;
+Bool_t   TMemoryGovernor::fgInit  = kFALSE;
+
+namespace {
+
+   struct MemReclaimer_t {
+      std::string     fCategory; // category the registered buffer reports under
+      void           *fCtx;      // object passed back to the callback
+      MemReclaimFun_t fFun;      // the reclaim callback
+   };
+
+   // function-local statics: usable during static initialization of other modules
+   std::map<std::string, Long64_t> &Categories()
+   {
+      static std::map<std::string, Long64_t> categories;
+      return categories;
+   }
+
+   std::vector<MemReclaimer_t> &Reclaimers()
+   {
+      static std::vector<MemReclaimer_t> reclaimers;
+      return reclaimers;
+   }
+
+   Long64_t &TotalUsage()
+   {
+      static Long64_t total = 0;
+      return total;
+   }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the budget from MemoryGovernor.Limit (rootrc, in MBytes) and from
+/// the environment variable ROOT_MEMORY_LIMIT (in MBytes, takes precedence).
+
+void TMemoryGovernor::InitLimit()
+{
+   if (fgInit) return;
+   fgInit = kTRUE;
+   Long64_t mbytes = 0;
+   if (gEnv) mbytes = gEnv->GetValue("MemoryGovernor.Limit", 0);
+   const char *env = gSystem ? gSystem->Getenv("ROOT_MEMORY_LIMIT") : 0;
+   if (env && *env) mbytes = atol(env);
+   if (mbytes > 0) fgLimit = mbytes * 1024 * 1024;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Report nbytes (positive: held, negative: released) under the given category.
+
+void TMemoryGovernor::Accumulate(const char *category, Long64_t nbytes)
+{
+   if (!category || !nbytes) return;
+   R__LOCKGUARD(gGlobalMutex);
+   Categories()[category] += nbytes;
+   TotalUsage() += nbytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes currently reported under the given category.
+
+Long64_t TMemoryGovernor::GetUsage(const char *category)
+{
+   if (!category) return 0;
+   R__LOCKGUARD(gGlobalMutex);
+   std::map<std::string, Long64_t>::const_iterator it = Categories().find(category);
+   return (it != Categories().end()) ? it->second : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes currently reported over all categories.
+
+Long64_t TMemoryGovernor::GetTotalUsage()
+{
+   R__LOCKGUARD(gGlobalMutex);
+   return TotalUsage();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the budget in bytes (0 or negative: accounting only).
+
+Long64_t TMemoryGovernor::GetLimit()
+{
+   InitLimit();
+   return fgLimit;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the budget in bytes; 0 or negative disables the backpressure and
+/// keeps only the accounting.
+
+void TMemoryGovernor::SetLimit(Long64_t nbytes)
+{
+   fgInit  = kTRUE;
+   fgLimit = nbytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register a reclaim callback for the buffer owned by ctx.  The callback
+/// is invoked by RequestMemory when the budget is exceeded; it is asked to
+/// release up to nbytes and returns the number of bytes it released.
+
+void TMemoryGovernor::RegisterReclaimer(const char *category, void *ctx, MemReclaimFun_t fun)
+{
+   if (!ctx || !fun) return;
+   R__LOCKGUARD(gGlobalMutex);
+   MemReclaimer_t reclaimer;
+   reclaimer.fCategory = category ? category : "";
+   reclaimer.fCtx      = ctx;
+   reclaimer.fFun      = fun;
+   Reclaimers().push_back(reclaimer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the reclaim callback registered for ctx (to be called before the
+/// owning object goes away).
+
+void TMemoryGovernor::UnregisterReclaimer(void *ctx)
+{
+   R__LOCKGUARD(gGlobalMutex);
+   std::vector<MemReclaimer_t> &reclaimers = Reclaimers();
+   for (std::vector<MemReclaimer_t>::iterator it = reclaimers.begin(); it != reclaimers.end(); ++it) {
+      if (it->fCtx == ctx) {
+         reclaimers.erase(it);
+         return;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Account nbytes under the given category, applying backpressure first
+/// when a budget is set: if the new total would exceed the budget, the
+/// registered reclaim callbacks are asked to release the overshoot.
+/// Returns kTRUE if the total fits in the budget afterwards (always kTRUE
+/// when no budget is set).  The allocation is accounted either way: the
+/// caller may prefer to proceed over budget rather than fail.
+
+Bool_t TMemoryGovernor::RequestMemory(const char *category, Long64_t nbytes)
+{
+   InitLimit();
+   Long64_t excess = 0;
+   if (fgLimit > 0 && nbytes > 0) {
+      {
+         R__LOCKGUARD(gGlobalMutex);
+         excess = TotalUsage() + nbytes - fgLimit;
+      }
+      if (excess > 0) {
+         // Copy the reclaimer list and call the callbacks without the lock:
+         // releasing memory re-enters Accumulate.
+         std::vector<MemReclaimer_t> reclaimers;
+         {
+            R__LOCKGUARD(gGlobalMutex);
+            reclaimers = Reclaimers();
+         }
+         for (std::vector<MemReclaimer_t>::const_iterator it = reclaimers.begin();
+              it != reclaimers.end() && excess > 0; ++it) {
+            excess -= it->fFun(it->fCtx, excess);
+         }
+         if (excess > 0) {
+            ::Warning("TMemoryGovernor::RequestMemory",
+                      "allocating %lld bytes for %s exceeds the memory budget of %lld bytes by %lld bytes",
+                      nbytes, category, fgLimit, excess);
+         }
+      }
+   }
+   Accumulate(category, nbytes);
+   return (excess <= 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the usage of every category and the total.
+
+void TMemoryGovernor::Print(Option_t *)
+{
+   std::map<std::string, Long64_t> categories;
+   Long64_t total, limit = GetLimit();
+   {
+      R__LOCKGUARD(gGlobalMutex);
+      categories = Categories();
+      total = TotalUsage();
+   }
+   for (std::map<std::string, Long64_t>::const_iterator it = categories.begin();
+        it != categories.end(); ++it) {
+      Printf(" %-24s %12lld bytes", it->first.c_str(), it->second);
+   }
+   if (limit > 0)
+      Printf(" %-24s %12lld bytes (budget %lld bytes)", "Total", total, limit);
+   else
+      Printf(" %-24s %12lld bytes", "Total", total);
+}
@@ -27,6 +27,8 @@ overridden by the derived classes.
 #include "TVirtualPad.h"
 #include "TClass.h"
 
+#include <utility>
+
 ClassImp(TNamed)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +38,14 @@ TNamed::TNamed(const TNamed &named) : TObject(named),fName(named.fName),fTitle(n
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// TNamed move ctor. Steals the string buffers instead of copying them.
+
+TNamed::TNamed(TNamed &&named) :
+   TObject(named),fName(std::move(named.fName)),fTitle(std::move(named.fTitle))
+{
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TNamed assignment operator.
 
@@ -49,6 +59,19 @@ TNamed& TNamed::operator=(const TNamed& rhs)
    return *this;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// TNamed move-assignment operator.
+
+TNamed& TNamed::operator=(TNamed&& rhs)
+{
+   if (this != &rhs) {
+      TObject::operator=(rhs);
+      fName  = std::move(rhs.fName);
+      fTitle = std::move(rhs.fTitle);
+   }
+   return *this;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set name and title to empty strings ("").
 
@@ -102,8 +102,15 @@ TFile, TSQLServer, TGrid, etc. functionality.
 #include "TObjString.h"
 #include "ThreadLocalStorage.h"
 
+#include <cstring>
 #include <memory>
 
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
 TPluginManager *gPluginMgr;   // main plugin manager created in TROOT
 
 static TVirtualMutex *gPluginManagerMutex;
@@ -113,6 +120,19 @@ static bool &TPH__IsReadingDirs() {
    return readingDirs;
 }
 
+static TString TPH__PluginDirs() {
+   // Return the list of plugin directories as specified by Root.PluginPath,
+   // defaulting to $ROOTSYS/etc/plugins.
+   TString plugindirs = gEnv->GetValue("Root.PluginPath", (char*)0);
+   if (plugindirs.Length() == 0) {
+      plugindirs = "plugins";
+      gSystem->PrependPathName(TROOT::GetEtcDir(), plugindirs);
+   }
+   return plugindirs;
+}
+
+static const char *gPluginSnapshotMagic = "# ROOT plugin handler snapshot 1";
+
 ClassImp(TPluginHandler)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -337,6 +357,7 @@ TPluginManager::~TPluginManager()
 {
    delete fHandlers;
    delete fBasesLoaded;
+   CloseHandlersSnapshot();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -467,13 +488,15 @@ void TPluginManager::LoadHandlersFromPluginDirs(const char *base)
          fBasesLoaded->Add(new TObjString(sbase));
       }
 
+      // Replay the handler records from the pre-generated snapshot, if one
+      // is configured and up to date, instead of interpreting the plugin
+      // macros (see WriteHandlersSnapshot).
+      if (LoadHandlersFromSnapshot(sbase))
+         return;
+
       TPH__IsReadingDirs() = kTRUE;
 
-      TString plugindirs = gEnv->GetValue("Root.PluginPath", (char*)0);
-      if (plugindirs.Length() == 0) {
-         plugindirs = "plugins";
-         gSystem->PrependPathName(TROOT::GetEtcDir(), plugindirs);
-      }
+      TString plugindirs = TPH__PluginDirs();
 #ifdef WIN32
       dirs = plugindirs.Tokenize(";");
 #else
@@ -519,6 +542,176 @@ void TPluginManager::LoadHandlersFromPluginDirs(const char *base)
    delete dirs;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Map read-only the plugin handler snapshot specified via the
+/// Root.PluginSnapshot resource and verify that the plugin directories and
+/// macros it was generated from have not changed since (see
+/// WriteHandlersSnapshot). The result is cached; a stale snapshot is ignored
+/// for the rest of the session. Returns kTRUE if the snapshot can be used.
+
+Bool_t TPluginManager::OpenHandlersSnapshot()
+{
+   if (fSnapshotState != -1)
+      return fSnapshotState == 1;
+   fSnapshotState = 0;
+
+   TString sname = gEnv->GetValue("Root.PluginSnapshot", "");
+   if (sname.IsNull())
+      return kFALSE;
+
+#ifndef WIN32
+   int fd = open(sname.Data(), O_RDONLY);
+   if (fd == -1)
+      return kFALSE;
+   Long64_t len = lseek(fd, 0, SEEK_END);
+   if (len <= 0) {
+      close(fd);
+      return kFALSE;
+   }
+   void *addr = mmap(0, len, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED)
+      return kFALSE;
+   fSnapshot = (char*) addr;
+   fSnapshotLen = len;
+#else
+   FILE *sf = fopen(sname.Data(), "rb");
+   if (!sf)
+      return kFALSE;
+   fseek(sf, 0, SEEK_END);
+   Long64_t len = ftell(sf);
+   fseek(sf, 0, SEEK_SET);
+   if (len <= 0) {
+      fclose(sf);
+      return kFALSE;
+   }
+   fSnapshot = new char[len];
+   fSnapshotLen = len;
+   if (fread(fSnapshot, 1, len, sf) != (size_t) len) {
+      fclose(sf);
+      CloseHandlersSnapshot();
+      return kFALSE;
+   }
+   fclose(sf);
+#endif
+
+   // Validate: the first line must be the magic, the P line must match the
+   // current plugin search path and every recorded directory and macro must
+   // be unchanged (a changed directory mtime catches added or removed files).
+   Bool_t valid = kTRUE;
+   Bool_t first = kTRUE;
+   const char *end = fSnapshot + fSnapshotLen;
+   for (const char *line = fSnapshot; valid && line < end; ) {
+      const char *eol = (const char*) memchr(line, '\n', end - line);
+      if (!eol) eol = end;
+      TString l(line, eol - line);
+      line = eol + 1;
+      if (first) {
+         valid = (l == gPluginSnapshotMagic);
+         first = kFALSE;
+      } else if (l.BeginsWith("P ")) {
+         valid = (TString(l(2, l.Length())) == TPH__PluginDirs());
+      } else if (l.BeginsWith("D ")) {
+         Ssiz_t sp = l.Index(" ", 2);
+         if (sp == kNPOS) {
+            valid = kFALSE;
+            break;
+         }
+         Long_t mtime = (Long_t) TString(l(2, sp - 2)).Atoll();
+         TString path = l(sp + 1, l.Length());
+         Long_t id, size, flags, cmtime;
+         if (gSystem->GetPathInfo(path, &id, &size, &flags, &cmtime) != 0 ||
+             cmtime != mtime)
+            valid = kFALSE;
+      } else if (l.BeginsWith("F ")) {
+         Ssiz_t sp1 = l.Index(" ", 2);
+         Ssiz_t sp2 = sp1 == kNPOS ? kNPOS : l.Index(" ", sp1 + 1);
+         if (sp2 == kNPOS) {
+            valid = kFALSE;
+            break;
+         }
+         Long_t mtime = (Long_t) TString(l(2, sp1 - 2)).Atoll();
+         Long_t fsize = (Long_t) TString(l(sp1 + 1, sp2 - sp1 - 1)).Atoll();
+         TString path = l(sp2 + 1, l.Length());
+         Long_t id, size, flags, cmtime;
+         if (gSystem->GetPathInfo(path, &id, &size, &flags, &cmtime) != 0 ||
+             cmtime != mtime || size != fsize)
+            valid = kFALSE;
+      }
+   }
+
+   if (!valid) {
+      if (gDebug > 0)
+         Info("OpenHandlersSnapshot", "ignoring stale plugin snapshot %s", sname.Data());
+      CloseHandlersSnapshot();
+      return kFALSE;
+   }
+
+   if (gDebug > 0)
+      Info("OpenHandlersSnapshot", "using plugin snapshot %s", sname.Data());
+   fSnapshotState = 1;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unmap the plugin handler snapshot.
+
+void TPluginManager::CloseHandlersSnapshot()
+{
+   if (!fSnapshot)
+      return;
+#ifndef WIN32
+   munmap(fSnapshot, fSnapshotLen);
+#else
+   delete [] fSnapshot;
+#endif
+   fSnapshot = 0;
+   fSnapshotLen = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the plugin handlers recorded in the snapshot for the specified
+/// base class (all bases if base is ""), without interpreting the plugin
+/// macros. base must be in the NameSpace@@BaseClass form used by
+/// fBasesLoaded. Returns 1 if the snapshot was used, 0 if there is no valid
+/// snapshot and the plugin macros must be interpreted.
+
+Int_t TPluginManager::LoadHandlersFromSnapshot(const char *base)
+{
+   if (!OpenHandlersSnapshot())
+      return 0;
+
+   TString sbase = base;
+   const char *end = fSnapshot + fSnapshotLen;
+   for (const char *line = fSnapshot; line < end; ) {
+      const char *eol = (const char*) memchr(line, '\n', end - line);
+      if (!eol) eol = end;
+      TString l(line, eol - line);
+      line = eol + 1;
+      if (!l.BeginsWith("H "))
+         continue;
+      TString rec = l(2, l.Length());
+      TString fld[6];
+      Int_t nf = 0;
+      Ssiz_t from = 0, tab;
+      while (nf < 5 && (tab = rec.Index("\t", from)) != kNPOS) {
+         fld[nf++] = rec(from, tab - from);
+         from = tab + 1;
+      }
+      if (nf != 5)
+         continue;
+      fld[nf] = rec(from, rec.Length() - from);
+      TString hbase = fld[0];
+      hbase.ReplaceAll("::", "@@");
+      if (sbase != "" && hbase != sbase)
+         continue;
+      AddHandler(fld[0], fld[1], fld[2], fld[3], fld[4], fld[5]);
+      if (sbase == "" && !fBasesLoaded->FindObject(hbase))
+         fBasesLoaded->Add(new TObjString(hbase));
+   }
+   return 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add plugin handler to the list of handlers. If there is already a
 /// handler defined for the same base and regexp it will be replaced.
@@ -783,3 +976,100 @@ Int_t TPluginManager::WritePluginRecords(const char *envFile, const char *plugin
 
    return 0;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write a snapshot of all plugin handler records defined via macros in the
+/// plugin directories. Subsequent processes pointed to the snapshot via the
+/// Root.PluginSnapshot resource map it read-only and replay the records
+/// instead of interpreting the plugin macros, which considerably reduces the
+/// startup time of short jobs. The snapshot records the modification time of
+/// every plugin directory and macro and is ignored as soon as any of them
+/// changes. Handlers defined via rootrc resources are not written, they are
+/// read from the environment in every process anyway. If fname is 0 or ""
+/// the value of Root.PluginSnapshot is used. Returns -1 on error, 0
+/// otherwise.
+
+Int_t TPluginManager::WriteHandlersSnapshot(const char *fname) const
+{
+   TString sname = fname;
+   if (sname.IsNull())
+      sname = gEnv->GetValue("Root.PluginSnapshot", "");
+   if (sname.IsNull()) {
+      Error("WriteHandlersSnapshot", "no file name specified and Root.PluginSnapshot not set");
+      return -1;
+   }
+
+   const_cast<TPluginManager*>(this)->LoadHandlersFromPluginDirs();
+
+   // write to a temporary file and rename it at the end so that concurrent
+   // jobs never see a partially written snapshot
+   TString tmpname;
+   tmpname.Form("%s.%d.tmp", sname.Data(), gSystem->GetPid());
+   FILE *f = fopen(tmpname, "w");
+   if (!f) {
+      Error("WriteHandlersSnapshot", "cannot create file %s", tmpname.Data());
+      return -1;
+   }
+   fprintf(f, "%s\n", gPluginSnapshotMagic);
+
+   TString plugindirs = TPH__PluginDirs();
+   fprintf(f, "P %s\n", plugindirs.Data());
+
+#ifdef WIN32
+   TObjArray *dirs = plugindirs.Tokenize(";");
+#else
+   TObjArray *dirs = plugindirs.Tokenize(":");
+#endif
+   for (Int_t i = 0; i < dirs->GetEntriesFast(); i++) {
+      TString d = ((TObjString*)dirs->At(i))->GetString();
+      Long_t id, size, flags, modtime;
+      if (gSystem->GetPathInfo(d, &id, &size, &flags, &modtime) != 0)
+         continue;
+      fprintf(f, "D %ld %s\n", modtime, d.Data());
+      void *dirp = gSystem->OpenDirectory(d);
+      if (!dirp) continue;
+      const char *f1;
+      while ((f1 = gSystem->GetDirEntry(dirp))) {
+         TString b = f1;
+         if (b == "." || b == "..") continue;
+         const char *p = gSystem->ConcatFileName(d, b);
+         if (gSystem->GetPathInfo(p, &id, &size, &flags, &modtime) == 0 &&
+             (flags & 2)) {
+            fprintf(f, "D %ld %s\n", modtime, p);
+            void *subdirp = gSystem->OpenDirectory(p);
+            if (subdirp) {
+               const char *f2;
+               while ((f2 = gSystem->GetDirEntry(subdirp))) {
+                  TString m = f2;
+                  if (m[0] == 'P' && m.EndsWith(".C")) {
+                     const char *mp = gSystem->ConcatFileName(p, m);
+                     if (gSystem->GetPathInfo(mp, &id, &size, &flags, &modtime) == 0)
+                        fprintf(f, "F %ld %ld %s\n", modtime, size, mp);
+                     delete [] mp;
+                  }
+               }
+               gSystem->FreeDirectory(subdirp);
+            }
+         }
+         delete [] p;
+      }
+      gSystem->FreeDirectory(dirp);
+   }
+   delete dirs;
+
+   TIter next(fHandlers);
+   TPluginHandler *h;
+   while ((h = (TPluginHandler*) next())) {
+      if (h->fOrigin == "TEnv") continue;
+      fprintf(f, "H %s\t%s\t%s\t%s\t%s\t%s\n", h->fBase.Data(), h->fRegexp.Data(),
+              h->fClass.Data(), h->fPlugin.Data(), h->fCtor.Data(), h->fOrigin.Data());
+   }
+   fclose(f);
+
+   if (gSystem->Rename(tmpname, sname) != 0) {
+      Error("WriteHandlersSnapshot", "cannot rename %s to %s", tmpname.Data(), sname.Data());
+      gSystem->Unlink(tmpname);
+      return -1;
+   }
+   return 0;
+}
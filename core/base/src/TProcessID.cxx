@@ -57,6 +57,21 @@ UInt_t      TProcessID::fgNumber = 0; //Current referenced object instance count
 TExMap     *TProcessID::fgObjPIDs= 0; //Table (pointer,pids)
 ClassImp(TProcessID)
 
+namespace {
+   // Immutable snapshot of fgPIDs, so that TRef resolution can translate a
+   // pid number into a TProcessID* without taking gROOTMutex.  A new snapshot
+   // is published (under gROOTMutex) whenever the table changes; readers only
+   // ever see a fully built table.
+   struct TPIDSnapshot {
+      UInt_t        fSize;  // number of slots
+      TProcessID  **fPIDs;  // slot i holds the TProcessID with pid i, may be 0
+   };
+   std::atomic<const TPIDSnapshot*> &PIDSnapshot() {
+      static std::atomic<const TPIDSnapshot*> snapshot(nullptr);
+      return snapshot;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return hash value for this object.
 
@@ -92,6 +107,25 @@ TProcessID::~TProcessID()
    fObjects = 0;
    R__LOCKGUARD2(gROOTMutex);
    fgPIDs->Remove(this);
+   UpdateSnapshot();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Publish a new immutable snapshot of fgPIDs for the lock-free readers
+/// (see GetProcessID).  The caller must hold gROOTMutex.  The previous
+/// snapshot is intentionally not deleted: another thread may still be
+/// reading it.  Snapshots are tiny and the table changes rarely (once per
+/// I/O session), so the retired copies are not worth tracking.
+
+void TProcessID::UpdateSnapshot()
+{
+   TPIDSnapshot *snap = new TPIDSnapshot;
+   snap->fSize = fgPIDs ? fgPIDs->GetLast() + 1 : 0;
+   snap->fPIDs = snap->fSize ? new TProcessID*[snap->fSize] : 0;
+   for (UInt_t i = 0; i < snap->fSize; ++i) {
+      snap->fPIDs[i] = (TProcessID*)fgPIDs->UncheckedAt(i);
+   }
+   PIDSnapshot().store(snap, std::memory_order_release);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -128,6 +162,7 @@ TProcessID *TProcessID::AddProcessID()
    TUUID u;
    //apid = fgPIDs->GetEntriesFast();
    pid->SetTitle(u.AsString());
+   UpdateSnapshot();
    return pid;
 }
 
@@ -193,6 +228,7 @@ void TProcessID::Cleanup()
    gROOT->GetListOfCleanups()->Remove(fgPIDs);
    delete fgPIDs;
    fgPIDs = 0;
+   UpdateSnapshot();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -228,10 +264,16 @@ Int_t TProcessID::DecrementCount()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// static function returning a pointer to TProcessID number pid in fgPIDs
+///
+/// The lookup goes through the immutable snapshot of fgPIDs and takes no
+/// lock, so it can be called concurrently with TRef resolution on other
+/// threads.
 
 TProcessID *TProcessID::GetProcessID(UShort_t pid)
 {
-   return (TProcessID*)fgPIDs->At(pid);
+   const TPIDSnapshot *snap = PIDSnapshot().load(std::memory_order_acquire);
+   if (!snap || pid >= snap->fSize) return 0;
+   return snap->fPIDs[pid];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -248,16 +290,16 @@ UInt_t TProcessID::GetNProcessIDs()
 
 TProcessID *TProcessID::GetProcessWithUID(UInt_t uid, const void *obj)
 {
-   R__LOCKGUARD2(gROOTMutex);
-
    Int_t pid = (uid>>24)&0xff;
    if (pid==0xff) {
-      // Look up the pid in the table (pointer,pid)
+      // Look up the pid in the table (pointer,pid); this is the rare case of
+      // a session with more than 255 process ids and still needs the lock.
+      R__LOCKGUARD2(gROOTMutex);
       if (fgObjPIDs==0) return 0;
       ULong_t hash = Void_Hash(obj);
       pid = fgObjPIDs->GetValue(hash,(Long_t)obj);
    }
-   return (TProcessID*)fgPIDs->At(pid);
+   return GetProcessID((UShort_t)pid);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
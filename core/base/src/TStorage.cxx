@@ -35,9 +35,11 @@ and statistics gathering in the system.
 #include "TROOT.h"
 #include "TObjectTable.h"
 #include "TError.h"
+#include "TClass.h"
 #include "TString.h"
 #include "TVirtualMutex.h"
 #include "TInterpreter.h"
+#include "ThreadLocalStorage.h"
 
 #if !defined(R__NOSTATS)
 #   define MEM_DEBUG
@@ -88,6 +90,52 @@ static Int_t    gTraceCapacity = 10, gTraceIndex = 0,
 ROOT::Internal::FreeIfTMapFile_t *ROOT::Internal::gFreeIfTMapFile = nullptr;
 void *ROOT::Internal::gMmallocDesc = 0; //is used and set in TMapFile
 
+// I/O buffer pool used by AllocBuffer/ReAllocBuffer/FreeBuffer. Buffers are
+// rounded up to a power-of-two size class and recycled through a per-thread
+// free list, so the steady state of an event loop (every entry allocating and
+// releasing basket and message buffers of the same few sizes) performs no
+// malloc/free at all and never contends on the allocator lock. The caches are
+// thread local on purpose: with many I/O worker threads a shared pool would
+// simply move the contention from the allocator into the pool.
+static const int gBufferPoolMinBits = 10;  // smallest pooled class, 1 KB
+static const int gBufferPoolMaxBits = 26;  // largest pooled class, 64 MB
+static const int gBufferPoolDepth   = 4;   // buffers kept per class and thread
+
+namespace {
+   struct BufferPool_t {
+      char  *fSlot[gBufferPoolMaxBits-gBufferPoolMinBits+1][gBufferPoolDepth];
+      Int_t  fCount[gBufferPoolMaxBits-gBufferPoolMinBits+1];
+      BufferPool_t() {
+         memset(fSlot, 0, sizeof(fSlot));
+         memset(fCount, 0, sizeof(fCount));
+      }
+      ~BufferPool_t() {
+         for (int cl = 0; cl <= gBufferPoolMaxBits-gBufferPoolMinBits; cl++)
+            for (int i = 0; i < fCount[cl]; i++)
+               delete [] fSlot[cl][i];
+      }
+   };
+}
+
+static BufferPool_t &GetBufferPool()
+{
+   TTHREAD_TLS_DECL(BufferPool_t, pool);
+   return pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size class for a buffer request, i.e. the smallest exponent cl
+/// with (1<<cl) >= size, clamped from below to gBufferPoolMinBits. A result
+/// larger than gBufferPoolMaxBits means the request is too big to be pooled.
+
+static int BufferPoolClass(size_t size)
+{
+   int cl = gBufferPoolMinBits;
+   while (cl <= gBufferPoolMaxBits && (((size_t)1) << cl) < size)
+      cl++;
+   return cl;
+}
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -318,6 +366,80 @@ Int_t *TStorage::ReAllocInt(Int_t *ovp, size_t size, size_t oldsize)
    return vp;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate an I/O buffer of at least size bytes, recycling a previously
+/// released buffer of the same size class when one is available in the
+/// calling thread's pool. The buffer must be released with FreeBuffer(),
+/// passing the same size, or with plain delete[] (the pooled buffers are
+/// ordinary char arrays); only the former returns it to the pool.
+
+void *TStorage::AllocBuffer(size_t size)
+{
+   int cl = BufferPoolClass(size);
+   if (cl <= gBufferPoolMaxBits) {
+      BufferPool_t &pool = GetBufferPool();
+      int idx = cl - gBufferPoolMinBits;
+      if (pool.fCount[idx] > 0)
+         return pool.fSlot[idx][--pool.fCount[idx]];
+      return new char[((size_t)1) << cl];
+   }
+   return new char[size];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reallocate an I/O buffer obtained from AllocBuffer(). oldsize must be the
+/// size that was requested from AllocBuffer() (or from the previous
+/// ReAllocBuffer()); the first copysize bytes are preserved and, as in
+/// ReAllocChar(), the remainder of the new buffer is zeroed. When the new
+/// size falls in the same size class as the old one the existing allocation
+/// is large enough and is returned unchanged.
+
+char *TStorage::ReAllocBuffer(char *ovp, size_t size, size_t copysize, size_t oldsize)
+{
+   if (ovp == 0)
+      return (char*) AllocBuffer(size);
+
+   int cl = BufferPoolClass(size);
+   if (cl <= gBufferPoolMaxBits && cl == BufferPoolClass(oldsize)) {
+      if (copysize < size)
+         memset(ovp+copysize, 0, size-copysize);
+      return ovp;
+   }
+
+   char *vp = (char*) AllocBuffer(size);
+   if (copysize)
+      memcpy(vp, ovp, copysize < size ? copysize : size);
+   if (copysize < size)
+      memset(vp+copysize, 0, size-copysize);
+   FreeBuffer(ovp, oldsize);
+   return vp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release an I/O buffer obtained from AllocBuffer() into the calling
+/// thread's pool, where the next AllocBuffer() of the same size class will
+/// pick it up. size may be any value not larger than the size the buffer was
+/// allocated with (the class lookup rounds the same way on both sides).
+/// Buffers above the largest pooled class, or arriving when the class is
+/// already full, are simply deleted.
+
+void TStorage::FreeBuffer(void *vp, size_t size)
+{
+   if (vp == 0)
+      return;
+
+   int cl = BufferPoolClass(size);
+   if (cl <= gBufferPoolMaxBits) {
+      BufferPool_t &pool = GetBufferPool();
+      int idx = cl - gBufferPoolMinBits;
+      if (pool.fCount[idx] < gBufferPoolDepth) {
+         pool.fSlot[idx][pool.fCount[idx]++] = (char*) vp;
+         return;
+      }
+   }
+   delete [] (char*) vp;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Used to allocate a TObject on the heap (via TObject::operator new()).
 /// Directly after this routine one can call (in the TObject ctor)
@@ -439,6 +561,49 @@ void TStorage::PrintStatistics()
    }
    Printf("================================================");
    Printf(" ");
+
+   // Report the allocation hotspots: the block sizes with the highest
+   // allocation counts, together with the loaded classes of matching
+   // instance size as candidate culprits. Unlike the table above this
+   // includes blocks that were freed again, since total churn rather than
+   // leakage is what determines the allocator pressure.
+   const int kMaxHot = 10;
+   int hotIdx[kMaxHot], nHot = 0;
+   for (int j = 0; j < kMaxHot; j++) {
+      int hot = -1;
+      for (i = 0; i < (int)kObjMaxSize; i++) {
+         if (!gAllocated[i]) continue;
+         Bool_t taken = kFALSE;
+         for (int k = 0; k < nHot; k++)
+            if (hotIdx[k] == i) { taken = kTRUE; break; }
+         if (taken) continue;
+         if (hot < 0 || gAllocated[i] > gAllocated[hot]) hot = i;
+      }
+      if (hot < 0) break;
+      hotIdx[nHot++] = hot;
+   }
+
+   if (nHot > 0) {
+      Printf("Allocation hotspots");
+      Printf("%12s%12s  %s", "size", "alloc", "candidate classes");
+      Printf("================================================");
+      for (int j = 0; j < nHot; j++) {
+         TString cand;
+         if (TROOT::Initialized()) {
+            TIter next(gROOT->GetListOfClasses());
+            TClass *cl;
+            while ((cl = (TClass*) next())) {
+               if (cl->Size() != hotIdx[j]) continue;
+               if (cand.Length()) cand += ", ";
+               if (cand.Length() > 60) { cand += "..."; break; }
+               cand += cl->GetName();
+            }
+         }
+         Printf("%12d%12d  %s", hotIdx[j], gAllocated[hotIdx[j]], cand.Data());
+      }
+      Printf("================================================");
+      Printf(" ");
+   }
 #endif
 }
 
@@ -310,6 +310,19 @@ TString& TString::operator=(const TString &rhs)
    return *this;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Move-assignment operator. Short or long, all data is in fRaw.
+
+TString& TString::operator=(TString &&rhs)
+{
+   if (this != &rhs) {
+      UnLink();
+      fRep.fRaw = rhs.fRep.fRaw;
+      rhs.Init(0,0);
+   }
+   return *this;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Assign a TSubString substr to TString.
 
@@ -0,0 +1,95 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TStringInterner
+Process-wide table of unique, immutable copies of C strings.
+
+Interning the same character sequence always returns the same pointer,
+so two interned strings can be compared for equality by comparing the
+pointers instead of the characters. This trades a one-time hash lookup
+for O(1) comparisons afterwards and stores each distinct string only
+once, which matters for metadata names (branches, leaves, classes) that
+are otherwise duplicated in every object referring to them.
+
+The canonical pointers stay valid for the lifetime of the process;
+entries are never removed. Do not intern unbounded user data: the table
+only grows.
+*/
+
+#include "TStringInterner.h"
+
+#include "TObjString.h"
+#include "TVirtualMutex.h"
+
+ClassImp(TStringInterner)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the table. Private: use the static interface.
+
+TStringInterner::TStringInterner() : fTable(1000, 3)
+{
+   fTable.SetOwner(kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the process-wide table. The instance is never deleted so that
+/// interned pointers remain valid in static destructors at process exit.
+
+TStringInterner *TStringInterner::Instance()
+{
+   static TStringInterner *table = new TStringInterner;
+   return table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the canonical copy of str, inserting it into the table if it is
+/// not yet known. Returns 0 for a null input. The returned pointer is valid
+/// for the lifetime of the process.
+
+const char *TStringInterner::Intern(const char *str)
+{
+   if (!str) return 0;
+
+   TStringInterner *si = Instance();
+
+   R__LOCKGUARD(gGlobalMutex);
+   TObjString *obj = (TObjString*) si->fTable.FindObject(str);
+   if (!obj) {
+      obj = new TObjString(str);
+      si->fTable.Add(obj);
+   }
+   return obj->GetName();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the canonical copy of str if it has been interned, 0 otherwise
+/// (also for a null input). Unlike Intern, the table is not modified.
+
+const char *TStringInterner::Find(const char *str)
+{
+   if (!str) return 0;
+
+   TStringInterner *si = Instance();
+
+   R__LOCKGUARD(gGlobalMutex);
+   TObjString *obj = (TObjString*) si->fTable.FindObject(str);
+   return obj ? obj->GetName() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of distinct strings in the table.
+
+Int_t TStringInterner::GetSize()
+{
+   TStringInterner *si = Instance();
+
+   R__LOCKGUARD(gGlobalMutex);
+   return si->fTable.GetEntries();
+}
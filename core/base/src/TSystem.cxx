@@ -46,6 +46,7 @@ allows a simple partial implementation for new OS'es.
 #include "TTimer.h"
 #include "TObjString.h"
 #include "TError.h"
+#include "TMD5.h"
 #include "TPluginManager.h"
 #include "TUrl.h"
 #include "TVirtualMutex.h"
@@ -2688,6 +2689,150 @@ static void R__WriteDependencyFile(const TString &build_loc, const TString &depf
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the file recording the content digests of the inputs
+/// of an ACLiC build, derived from the name of the dependency file.
+
+static TString R__AclicChecksumFilename(const TString &depfilename)
+{
+   TString sumfilename(depfilename);
+   sumfilename.Remove(sumfilename.Length()-2); // strip the trailing ".d"
+   sumfilename += ".sum";
+   return sumfilename;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the MD5 digest of the build configuration string (ROOT release,
+/// compiler flags, include and define directives) as an hexadecimal string.
+
+static TString R__AclicConfigDigest(const TString &config)
+{
+   TMD5 md5;
+   md5.Update((const UChar_t*)config.Data(), config.Length());
+   md5.Final();
+   return md5.AsString();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record in 'sumfilename' the MD5 digests of the build configuration, of
+/// the script and of all the files listed in the dependency file. The file
+/// holds one "digest name" line per input; the configuration digest is
+/// stored under the pseudo name ":config:".
+
+static void R__AclicWriteChecksums(const TString &sumfilename, const TString &depfilename,
+                                   const TString &scriptname, const TString &config)
+{
+   FILE *depfile = fopen(depfilename.Data(),"r");
+   if (depfile==0) return;
+
+   std::ofstream sumfile( sumfilename, std::ios::out );
+   if (!sumfile) {
+      fclose(depfile);
+      return;
+   }
+   sumfile << "# File Automatically generated by the ROOT Script Compiler "
+           << std::endl;
+   sumfile << R__AclicConfigDigest(config) << " :config:" << std::endl;
+
+   TMD5 *scriptsum = TMD5::FileChecksum(scriptname);
+   if (scriptsum) {
+      sumfile << scriptsum->AsString() << " " << scriptname << std::endl;
+      delete scriptsum;
+   }
+
+   // Collect the dependencies; the parsing mirrors the dependency check in
+   // TSystem::CompileMacro.
+   Int_t sz = 256;
+   char *line = new char[sz];
+   line[0] = 0;
+
+   int c;
+   Int_t current = 0;
+   Int_t nested = 0;
+   Bool_t skipversion = kFALSE;
+
+   while ((c = fgetc(depfile)) != EOF) {
+      if (c=='#') {
+         // skip comment
+         while ((c = fgetc(depfile)) != EOF) {
+            if (c=='\n') {
+               break;
+            }
+         }
+         continue;
+      }
+      if (isspace(c) && !nested) {
+         if (current) {
+            line[current] = 0;
+            if (line[current-1]=='=') {
+               // The next word is the version number (already part of the
+               // configuration digest), not a file.
+               skipversion = kTRUE;
+            } else if (skipversion) {
+               skipversion = kFALSE;
+            } else if (line[current-1]!=':' && scriptname != line) {
+               // ignore targets and the script recorded above
+               TMD5 *filesum = TMD5::FileChecksum(line);
+               if (filesum) {
+                  sumfile << filesum->AsString() << " " << line << std::endl;
+                  delete filesum;
+               }
+            }
+         }
+         current = 0;
+         line[0] = 0;
+      } else {
+         if (current==sz-1) {
+            sz = 2*sz;
+            char *newline = new char[sz];
+            strcpy(newline,line);
+            delete [] line;
+            line = newline;
+         }
+         if (c=='"') nested = !nested;
+         else {
+            line[current] = c;
+            current++;
+         }
+      }
+   }
+   delete [] line;
+   fclose(depfile);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check the digests recorded in 'sumfilename' against the current build
+/// configuration and the current content of the dependencies. Returns kTRUE
+/// only if the file exists and every digest matches, i.e. the existing
+/// library was built from identical inputs and can be reused as is.
+
+static Bool_t R__AclicVerifyChecksums(const TString &sumfilename, const TString &config)
+{
+   std::ifstream sumfile( sumfilename.Data() );
+   if (!sumfile) return kFALSE;
+
+   Bool_t match = kFALSE; // an empty or comment-only file does not count
+   std::string linebuf;
+   while (std::getline(sumfile, linebuf)) {
+      if (linebuf.empty() || linebuf[0]=='#') continue;
+      std::string::size_type space = linebuf.find(' ');
+      if (space == std::string::npos || (space+1) >= linebuf.length()) return kFALSE;
+      std::string digest = linebuf.substr(0, space);
+      std::string name = linebuf.substr(space+1);
+      if (name == ":config:") {
+         if (digest != R__AclicConfigDigest(config).Data()) return kFALSE;
+      } else {
+         TMD5 *filesum = TMD5::FileChecksum(name.c_str());
+         if (!filesum) return kFALSE;
+         Bool_t same = (digest == filesum->AsString());
+         delete filesum;
+         if (!same) return kFALSE;
+      }
+      match = kTRUE;
+   }
+   return match;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This method compiles and loads a shared library containing
 /// the code from the file "filename".
@@ -2719,6 +2864,14 @@ static void R__WriteDependencyFile(const TString &build_loc, const TString &depf
 /// other's library.
 /// See also TSystem::SetBuildDir.
 ///
+/// If the rootrc variable ACLiC.UseContentHash is set to 1, a successful
+/// build records the MD5 digests of the script, of the files it depends on
+/// and of the build configuration next to the library. A rebuild that would
+/// be triggered only by changed timestamps is then skipped when those
+/// digests still match, and the existing library is loaded directly. In
+/// combination with a shared ACLiC.BuildDir this lets several jobs reuse a
+/// single compilation of the same macros.
+///
 /// If dirmode is not zero and we need to create the target directory, the
 /// file mode bit will be change to 'dirmode' using chmod.
 ///
@@ -3074,6 +3227,16 @@ int TSystem::CompileMacro(const char *filename, Option_t *opt,
 
    }
 
+   // The configuration the content hash cache has to match, in addition to
+   // the content of the script and of its dependencies.
+   Bool_t useContentHash = gEnv ? gEnv->GetValue("ACLiC.UseContentHash",0) != 0 : kFALSE;
+   TString hashConfig;
+   if (useContentHash) {
+      hashConfig.Form("%s|%s|%s|%s", ROOT_RELEASE,
+                      (mode==kDebug) ? fFlagsDebug.Data() : fFlagsOpt.Data(),
+                      includes.Data(), defines.Data());
+   }
+
    TString emergency_loc;
    {
       UserGroup_t *ug = gSystem->GetUserInfo(gSystem->GetUid());
@@ -3199,6 +3362,21 @@ int TSystem::CompileMacro(const char *filename, Option_t *opt,
       }
    }
 
+   if (recompile && modified && useContentHash) {
+      // The timestamps are stale, but the content of the inputs may still be
+      // unchanged (e.g. sources freshly deployed to a batch node): check the
+      // digests recorded by the build that produced the library before
+      // paying for a recompilation.
+      if (!gSystem->AccessPathName(library,kReadPermission) &&
+          R__AclicVerifyChecksums(R__AclicChecksumFilename(depfilename), hashConfig)) {
+         if (withInfo && verboseLevel>3) {
+            ::Info("ACLiC","the content digests of %s and its dependencies are unchanged, reusing the existing library",filename);
+         }
+         recompile = kFALSE;
+         modified = kFALSE;
+      }
+   }
+
    if ( gInterpreter->IsLoaded(library)
         || strlen(GetLibraries(library,"D",kFALSE)) != 0 ) {
       // The library has already been built and loaded.
@@ -3660,6 +3838,13 @@ int TSystem::CompileMacro(const char *filename, Option_t *opt,
       if (!keep) k->SetBit(kMustCleanup);
       fCompiled->Add(k);
 
+      if (useContentHash) {
+         // Record the content digests of the inputs of this build, so that
+         // later jobs can reuse the library even when the timestamps differ.
+         R__AclicWriteChecksums(R__AclicChecksumFilename(depfilename), depfilename,
+                                filename_fullpath, hashConfig);
+      }
+
       if (needLoadMap) {
           gInterpreter->LoadLibraryMap(libmapfilename);
       }
@@ -0,0 +1,222 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \file TTrace.cxx
+Hot-path tracing ring buffer (see TTrace.h).
+
+The ring is a single power-of-two array of fixed-size records; writers
+claim a slot with one relaxed fetch_add on the global sequence number,
+so concurrent probes never block each other and the newest records
+overwrite the oldest when the ring wraps. The dump path deliberately
+formats by hand and only calls write(), so it can run from a signal
+handler while every other thread is wedged - the main use case.
+*/
+
+#include "TTrace.h"
+
+#include <signal.h>
+#include <string.h>
+#ifndef WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#define write _write
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+std::atomic<Bool_t> gTraceActive(kFALSE);
+
+namespace {
+
+struct TraceRecord_t {
+   ULong64_t    fTime;    // rdtsc cycles (x86) or ns since an arbitrary origin
+   Long64_t     fArg;     // probe argument
+   const char  *fLabel;   // optional literal/persistent label, may be 0
+   ULong64_t    fThread;  // id of the emitting thread
+   Int_t        fProbe;   // ETraceProbe
+};
+
+TraceRecord_t             *gTraceRing = 0;
+UInt_t                     gTraceRingMask = 0; // ring size - 1 (power of two)
+std::atomic<ULong64_t>     gTraceSeq(0);       // next record sequence number
+
+const char *const gTraceProbeName[kTraceNProbes] = {
+   "basket-read",
+   "basket-unzip",
+   "class-get",
+   "autoparse",
+   "lock",
+   "user"
+};
+
+ULong64_t TraceClock()
+{
+#if defined(__x86_64__) || defined(__i386__)
+   return __rdtsc();
+#else
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (ULong64_t)ts.tv_sec * 1000000000ULL + (ULong64_t)ts.tv_nsec;
+#endif
+}
+
+ULong64_t TraceThreadId()
+{
+#ifndef WIN32
+   // The address of a thread local is unique per live thread and cheap to
+   // obtain; we only need to tell threads apart in the dump.
+   static thread_local char tid;
+   return (ULong64_t)(&tid);
+#else
+   return 0;
+#endif
+}
+
+// Async-signal-safe helpers for the dump path: format into a caller
+// provided buffer and return the number of characters emitted.
+
+int TraceFmtU64(char *buf, ULong64_t v)
+{
+   char tmp[24];
+   int n = 0, i;
+   do {
+      tmp[n++] = (char)('0' + (v % 10));
+      v /= 10;
+   } while (v);
+   for (i = 0; i < n; i++) buf[i] = tmp[n - 1 - i];
+   return n;
+}
+
+int TraceFmtI64(char *buf, Long64_t v)
+{
+   if (v < 0) {
+      buf[0] = '-';
+      return 1 + TraceFmtU64(buf + 1, (ULong64_t)(-v));
+   }
+   return TraceFmtU64(buf, (ULong64_t)v);
+}
+
+void TraceSignalHandler(int)
+{
+   R__TraceDump(2);
+}
+
+} // unnamed namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append one record to the trace ring; called by the R__TRACE macro when
+/// tracing is active. Safe to call from any thread; never blocks.
+
+void R__TraceEvent(Int_t probe, Long64_t arg, const char *label)
+{
+   TraceRecord_t *ring = gTraceRing;
+   if (!ring) return;
+
+   ULong64_t seq = gTraceSeq.fetch_add(1, std::memory_order_relaxed);
+   TraceRecord_t &rec = ring[seq & gTraceRingMask];
+   rec.fTime = TraceClock();
+   rec.fArg = arg;
+   rec.fLabel = label;
+   rec.fThread = TraceThreadId();
+   rec.fProbe = probe;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the ring buffer (nrecords rounded up to a power of two, at
+/// least 1024) and arm the probes. When tracing was enabled before, the
+/// existing ring is kept and only re-armed.
+
+void R__TraceEnable(UInt_t nrecords)
+{
+   if (!gTraceRing) {
+      UInt_t size = 1024;
+      while (size < nrecords && size < (1U << 24)) size <<= 1;
+      TraceRecord_t *ring = new TraceRecord_t[size];
+      memset(ring, 0, size * sizeof(TraceRecord_t));
+      gTraceRingMask = size - 1;
+      gTraceRing = ring;
+   }
+   gTraceActive.store(kTRUE, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Disarm the probes. The ring is kept so that the records gathered so far
+/// can still be dumped (and so that concurrent probes in flight stay valid).
+
+void R__TraceDisable()
+{
+   gTraceActive.store(kFALSE, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the content of the trace ring to the given file descriptor,
+/// oldest record first, one line per record:
+///
+///   <time> <thread> <probe> <arg> [label]
+///
+/// Only write() is used, no allocation and no stdio, so this is safe to
+/// call from a signal handler (see R__TraceInstallHandler).
+
+void R__TraceDump(Int_t fd)
+{
+   TraceRecord_t *ring = gTraceRing;
+   if (!ring) return;
+
+   ULong64_t last = gTraceSeq.load(std::memory_order_acquire);
+   ULong64_t nring = (ULong64_t)gTraceRingMask + 1;
+   ULong64_t first = (last > nring) ? last - nring : 0;
+
+   char line[256];
+   for (ULong64_t seq = first; seq < last; seq++) {
+      const TraceRecord_t &rec = ring[seq & gTraceRingMask];
+      int n = 0;
+      n += TraceFmtU64(line + n, rec.fTime);
+      line[n++] = ' ';
+      n += TraceFmtU64(line + n, rec.fThread);
+      line[n++] = ' ';
+      if (rec.fProbe >= 0 && rec.fProbe < kTraceNProbes) {
+         const char *name = gTraceProbeName[rec.fProbe];
+         int l = strlen(name);
+         memcpy(line + n, name, l);
+         n += l;
+      } else {
+         line[n++] = '?';
+      }
+      line[n++] = ' ';
+      n += TraceFmtI64(line + n, rec.fArg);
+      if (rec.fLabel) {
+         int l = strlen(rec.fLabel);
+         if (l > (int)sizeof(line) - n - 2) l = sizeof(line) - n - 2;
+         line[n++] = ' ';
+         memcpy(line + n, rec.fLabel, l);
+         n += l;
+      }
+      line[n++] = '\n';
+      if (write(fd, line, n) != n) return;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Install a signal handler that dumps the trace ring to stderr, so that a
+/// wedged process can be asked post mortem what its hot paths were doing.
+/// The default signal is SIGUSR2.
+
+void R__TraceInstallHandler(Int_t signum)
+{
+#ifndef WIN32
+   if (signum == 0) signum = SIGUSR2;
+#endif
+   if (signum > 0) signal(signum, TraceSignalHandler);
+}
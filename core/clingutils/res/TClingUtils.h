@@ -175,6 +175,7 @@ private:
    std::string fRequestedName;
    std::string fNormalizedName;
    bool fRequestStreamerInfo;
+   bool fRequestCompiledStreamer = false;
    bool fRequestNoStreamer;
    bool fRequestNoInputOperator;
    bool fRequestOnlyTClass;
@@ -249,6 +250,12 @@ public:
       // Equivalent to CINT's cl.RootFlag() & G__USEBYTECOUNT
       return fRequestStreamerInfo;
    }
+   bool RequestCompiledStreamer() const {
+      // True if a specialized straight-line Streamer body was requested
+      // (options=compiledstreamer in the linkdef).
+      return fRequestCompiledStreamer;
+   }
+   void SetRequestCompiledStreamer(bool compiledStreamer) { fRequestCompiledStreamer = compiledStreamer; }
    bool RequestNoInputOperator() const { return fRequestNoInputOperator; }
    bool RequestNoStreamer() const { return fRequestNoStreamer; }
    bool RequestOnlyTClass() const { return fRequestOnlyTClass; }
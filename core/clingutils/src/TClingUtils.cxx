@@ -2688,7 +2688,11 @@ void ROOT::TMetaUtils::WriteClassCode(CallWriteStreamer_t WriteStreamerFunc,
       // This is to maintain the behaviour of ROOT5 and ROOT6 up to 6.07 included.
       if (cl.RootFlag() && !isGenreflex) ROOT::TMetaUtils::WritePointersSTL(cl, interp, normCtxt); // In particular this detect if the class has a version number.
       if (!(cl.RequestNoStreamer())) {
-         (*WriteStreamerFunc)(cl, interp, normCtxt, dictStream, isGenreflex || cl.RequestStreamerInfo());
+         // options=compiledstreamer requests the specialized straight-line
+         // Streamer body even when the class is otherwise selected for the
+         // generic TStreamerInfo-driven I/O.
+         (*WriteStreamerFunc)(cl, interp, normCtxt, dictStream,
+                              (isGenreflex || cl.RequestStreamerInfo()) && !cl.RequestCompiledStreamer());
       } else
          ROOT::TMetaUtils::Info(0, "Class %s: Do not generate Streamer() [*** custom streamer ***]\n",fullname.c_str());
    } else {
@@ -0,0 +1,167 @@
+/* @(#)root/core/cont:$Id$ */
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TPoolVector
+#define ROOT_TPoolVector
+
+#include "ThreadLocalStorage.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+\class ROOT::TPoolVector
+\brief A typed, contiguous collection that recycles both its heap storage
+and its constructed elements.
+
+\tparam T Type of the elements.
+\ingroup Containers
+
+TPoolVector is a typed successor to the TClonesArray usage pattern of
+"allocate once, Clear per event, refill": the elements live contiguously
+in a std::vector, Clear() is O(1) and never walks destructors (it only
+resets the logical size; the constructed elements stay behind and are
+handed out again by ConstructedAt/EmplaceBack, like
+TClonesArray::ConstructedAt), and when a TPoolVector dies its buffer is
+parked in a per-thread, per-type pool from which the next TPoolVector of
+the same type is constructed. Code that creates and clears hundreds of
+collections per event therefore touches the allocator only during the
+first event.
+
+Typical event-loop usage:
+~~~{.cpp}
+   ROOT::TPoolVector<Hit> hits;          // buffer comes from the pool
+   for (...) {
+      hits.Clear();                      // O(1), no destructor walk
+      for (Int_t i = 0; i < nhits; ++i) {
+         Hit &h = hits.EmplaceBack();    // recycled, already constructed
+         h.Set(...);
+      }
+      for (const Hit &h : hits) { ... }  // contiguous iteration
+   }
+~~~
+
+Since Clear() recycles the constructed elements, elements obtained from
+ConstructedAt/EmplaceBack may carry the state of a previous use and must
+be reset by the caller, exactly as with TClonesArray::ConstructedAt.
+Reset() destroys the elements for payload types whose stale state must
+not be recycled.
+
+For I/O, call TrimToSize() and stream the std::vector returned by
+Data(): the standard STL collection proxy takes care of it whenever a
+dictionary for the element type exists.
+**/
+
+namespace ROOT {
+
+   template <class T>
+   class TPoolVector {
+   private:
+      std::vector<T> fData;  ///< Constructed elements; its size is the high-water mark.
+      std::size_t    fSize;  ///< Logical size, fSize <= fData.size().
+
+      /// Retired buffers, recycled by the next TPoolVector<T> built on
+      /// this thread. Per thread so that no lock is needed.
+      static std::vector<std::vector<T>> &GetBufferPool()
+      {
+         TTHREAD_TLS_DECL(std::vector<std::vector<T>>, pool);
+         return pool;
+      }
+
+      static const std::size_t fgMaxPooledBuffers = 32;
+
+      TPoolVector(const TPoolVector &);            // not implemented
+      TPoolVector &operator=(const TPoolVector &); // not implemented
+
+   public:
+      using value_type = T;
+      using size_type = std::size_t;
+      using iterator = T *;
+      using const_iterator = const T *;
+
+      TPoolVector() : fSize(0)
+      {
+         auto &pool = GetBufferPool();
+         if (!pool.empty()) {
+            fData = std::move(pool.back());
+            pool.pop_back();
+         }
+      }
+
+      ~TPoolVector()
+      {
+         auto &pool = GetBufferPool();
+         if (pool.size() < fgMaxPooledBuffers)
+            pool.push_back(std::move(fData));
+      }
+
+      /// Return the element at position idx, constructing any element up
+      /// to there if needed. Like TClonesArray::ConstructedAt the object
+      /// may have been used before and carries its previous state.
+      T *ConstructedAt(size_type idx)
+      {
+         if (idx >= fData.size()) fData.resize(idx + 1);
+         if (idx >= fSize) fSize = idx + 1;
+         return &fData[idx];
+      }
+
+      /// Append one element, recycling a previously constructed one when
+      /// available, and return a reference to it.
+      T &EmplaceBack() { return *ConstructedAt(fSize); }
+
+      /// Forget the content without destroying it: O(1), no destructor
+      /// walk. The elements stay constructed and are recycled by the
+      /// next ConstructedAt/EmplaceBack calls.
+      void Clear() { fSize = 0; }
+
+      /// Destroy the elements (the heap storage is kept). Use this
+      /// instead of Clear() when stale element state must not leak into
+      /// the next fill.
+      void Reset()
+      {
+         fData.clear();
+         fSize = 0;
+      }
+
+      /// Destroy the elements beyond the logical size, making Data()
+      /// hold exactly the collection content (e.g. before streaming it).
+      void TrimToSize() { fData.resize(fSize); }
+
+      size_type size() const { return fSize; }
+      bool empty() const { return fSize == 0; }
+      /// Number of constructed elements kept for recycling.
+      size_type Capacity() const { return fData.size(); }
+
+      T &operator[](size_type idx) { return fData[idx]; }
+      const T &operator[](size_type idx) const { return fData[idx]; }
+
+      iterator begin() { return fData.data(); }
+      iterator end() { return fData.data() + fSize; }
+      const_iterator begin() const { return fData.data(); }
+      const_iterator end() const { return fData.data() + fSize; }
+
+      /// Access to the underlying vector; only the first size() elements
+      /// are collection content unless TrimToSize() was called.
+      std::vector<T> &Data() { return fData; }
+      const std::vector<T> &Data() const { return fData; }
+
+      /// Drop the buffers parked on this thread's pool.
+      static void DropBufferPool()
+      {
+         std::vector<std::vector<T>>().swap(GetBufferPool());
+      }
+   };
+
+}
+
+#endif
@@ -75,6 +75,30 @@ public:
       operator Bool_t() const;
    };
 
+   //----- Iteration over the bits set to 1
+   // The iterator dereferences to the position of the current set bit and
+   // advances with FirstSetBit, which scans the container 64 bits at a
+   // time; see BeginSetBits below.
+   class TSetBitIterator {
+      friend class TBits;
+
+      const TBits *fBits; //!
+      UInt_t       fPos;  //!
+
+      TSetBitIterator(const TBits &bits, UInt_t pos) : fBits(&bits), fPos(pos) { }
+
+   public:
+      UInt_t operator*() const { return fPos; }
+      TSetBitIterator& operator++() { fPos = fBits->FirstSetBit(fPos+1); return *this; }
+      Bool_t operator==(const TSetBitIterator& rhs) const { return fPos == rhs.fPos; }
+      Bool_t operator!=(const TSetBitIterator& rhs) const { return fPos != rhs.fPos; }
+   };
+
+   // Iterator on the position of the first bit set to 1 at or after startBit;
+   // it compares equal to EndSetBits() once all set bits have been visited.
+   TSetBitIterator BeginSetBits(UInt_t startBit = 0) const { return TSetBitIterator(*this, FirstSetBit(startBit)); }
+   TSetBitIterator EndSetBits() const { return TSetBitIterator(*this, fNbits); }
+
    //----- bit manipulation
    //----- (note the difference with TObject's bit manipulations)
    void   ResetAllBits(Bool_t value=kFALSE);  // if value=1 set all bits to 1
@@ -52,6 +52,14 @@ private:
    Int_t       fTally;
 
    Bool_t      HighWaterMark() { return (Bool_t) (fTally >= ((3*fSize)/4)); }
+   Int_t       Bucket(ULong64_t hash) const {
+      // Map the (externally provided) hash to a bucket of the power-of-two
+      // sized table. The Fibonacci multiplier spreads the bits so that the
+      // always-set bit(0) (the in-use marker) does not bias the bucket, and
+      // the mask avoids the modulo against a prime of the old scheme.
+      hash *= 0x9E3779B97F4A7C15ULL;
+      return Int_t((hash >> 32) & (fSize - 1));
+   }
    Int_t       FindElement(ULong64_t hash, Long64_t key);
    void        FixCollisions(Int_t index);
 
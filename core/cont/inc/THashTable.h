@@ -42,9 +42,16 @@ private:
    Int_t       fUsedSlots;     //Number of used slots
    Int_t       fRehashLevel;   //Average collision rate which triggers rehash
 
+   Int_t       BucketFor(ULong64_t hash) const {
+      // Object hashes are often small or poorly spread in their low bits;
+      // the Fibonacci multiplier mixes the bits before masking with the
+      // power-of-two table size, avoiding a modulo on every lookup
+      hash *= 0x9E3779B97F4A7C15ULL;
+      return Int_t((hash >> 32) & (fSize - 1));
+   }
    Int_t       GetHashValue(const TObject *obj) const;
-   Int_t       GetHashValue(TString &s) const { return s.Hash() % fSize; }
-   Int_t       GetHashValue(const char *str) const { return ::Hash(str) % fSize; }
+   Int_t       GetHashValue(TString &s) const { return BucketFor(s.Hash()); }
+   Int_t       GetHashValue(const char *str) const { return BucketFor(::Hash(str)); }
 
    THashTable(const THashTable&);             // not implemented
    THashTable& operator=(const THashTable&);  // not implemented
@@ -86,8 +93,7 @@ inline Float_t THashTable::AverageCollisions() const
 
 inline Int_t THashTable::GetHashValue(const TObject *obj) const
 {
-   Int_t i = Int_t(obj->Hash() % fSize);  // need intermediary i for Linux g++
-   return i;
+   return BucketFor(obj->Hash());
 }
 
 
@@ -76,6 +76,7 @@ public:
    Int_t              GetN(Int_t pid) const {return fN[GetInternalIdxForPID(pid)];}
    TObject           *GetOwner() const {return fOwner;}
    TObject           *GetParent(Int_t uid, TProcessID* context = 0) const;
+   Int_t              GetParents(const Int_t *uids, Int_t nuids, TObject **parents, TProcessID* context = 0) const;
    TObjArray         *GetParents() const {return fParents;}
    UInt_t             GetUID() const {return fUID;}
    TProcessID        *GetUIDContext() const {return fUIDContext;}
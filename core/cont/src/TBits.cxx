@@ -27,6 +27,54 @@ occupied by the upper bits that are 0.
 
 ClassImp(TBits)
 
+namespace {
+
+   // Number of bits set to 1 in a 64-bit word.
+   inline UInt_t CountBitsWord(ULong64_t w)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_popcountll(w);
+#else
+      w = w - ((w >> 1) & 0x5555555555555555ULL);
+      w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+      w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+      return (UInt_t) ((w * 0x0101010101010101ULL) >> 56);
+#endif
+   }
+
+#ifdef R__BYTESWAP
+   // Index of the lowest bit set to 1 of a non null 64-bit word.  On a
+   // little endian machine the lowest bit of the word loaded from the byte
+   // array is the first bit of the container, see the note in Set/Get below.
+   inline UInt_t LowestBitWord(ULong64_t w)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(w);
+#else
+      UInt_t n = 0;
+      while ((w & 0xFF) == 0) { w >>= 8; n += 8; }
+      while ((w & 1) == 0) { w >>= 1; ++n; }
+      return n;
+#endif
+   }
+#endif
+
+   // Load/store a 64-bit word from/to the byte array; memcpy keeps the
+   // access alignment-safe and compiles to a single move.
+   inline ULong64_t LoadWord(const UChar_t *bits)
+   {
+      ULong64_t w;
+      memcpy(&w, bits, sizeof(w));
+      return w;
+   }
+
+   inline void StoreWord(UChar_t *bits, ULong64_t w)
+   {
+      memcpy(bits, &w, sizeof(w));
+   }
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TBits constructor.  All bits set to 0
 
@@ -136,22 +184,24 @@ UInt_t TBits::CountBits(UInt_t startBit) const
              4,5,5,6,5,6,6,7,5,6,6,7,6,7,7,8};
 
    UInt_t i,count = 0;
-   if (startBit == 0) {
-      for(i=0; i<fNbytes; i++) {
-         count += nbits[fAllBits[i]];
+   UInt_t startByte = 0;
+   if (startBit) {
+      if (startBit >= fNbits) return count;
+      startByte = startBit/8;
+      UInt_t ibit = startBit%8;
+      if (ibit) {
+         for (i=ibit;i<8;i++) {
+            if (fAllBits[startByte] & (1<<i)) count++;
+         }
+         startByte++;
       }
-      return count;
    }
-   if (startBit >= fNbits) return count;
-   UInt_t startByte = startBit/8;
-   UInt_t ibit = startBit%8;
-   if (ibit) {
-      for (i=ibit;i<8;i++) {
-         if (fAllBits[startByte] & (1<<ibit)) count++;
-      }
-      startByte++;
+   // count whole 64-bit words with the population count instruction,
+   // the remaining bytes with the lookup table
+   for(i=startByte; i+8<=fNbytes; i+=8) {
+      count += CountBitsWord(LoadWord(&(fAllBits[i])));
    }
-   for(i=startByte; i<fNbytes; i++) {
+   for(; i<fNbytes; i++) {
       count += nbits[fAllBits[i]];
    }
    return count;
@@ -165,7 +215,11 @@ UInt_t TBits::CountBits(UInt_t startBit) const
 void TBits::DoAndEqual(const TBits& rhs)
 {
    UInt_t min = (fNbytes<rhs.fNbytes) ? fNbytes : rhs.fNbytes;
-   for(UInt_t i=0; i<min; ++i) {
+   UInt_t i = 0;
+   for(; i+8<=min; i+=8) {
+      StoreWord(&(fAllBits[i]), LoadWord(&(fAllBits[i])) & LoadWord(&(rhs.fAllBits[i])));
+   }
+   for(; i<min; ++i) {
       fAllBits[i] &= rhs.fAllBits[i];
    }
    if (fNbytes>min) {
@@ -181,7 +235,11 @@ void TBits::DoAndEqual(const TBits& rhs)
 void TBits::DoOrEqual(const TBits& rhs)
 {
    UInt_t min = (fNbytes<rhs.fNbytes) ? fNbytes : rhs.fNbytes;
-   for(UInt_t i=0; i<min; ++i) {
+   UInt_t i = 0;
+   for(; i+8<=min; i+=8) {
+      StoreWord(&(fAllBits[i]), LoadWord(&(fAllBits[i])) | LoadWord(&(rhs.fAllBits[i])));
+   }
+   for(; i<min; ++i) {
       fAllBits[i] |= rhs.fAllBits[i];
    }
 }
@@ -194,7 +252,11 @@ void TBits::DoOrEqual(const TBits& rhs)
 void TBits::DoXorEqual(const TBits& rhs)
 {
    UInt_t min = (fNbytes<rhs.fNbytes) ? fNbytes : rhs.fNbytes;
-   for(UInt_t i=0; i<min; ++i) {
+   UInt_t i = 0;
+   for(; i+8<=min; i+=8) {
+      StoreWord(&(fAllBits[i]), LoadWord(&(fAllBits[i])) ^ LoadWord(&(rhs.fAllBits[i])));
+   }
+   for(; i<min; ++i) {
       fAllBits[i] ^= rhs.fAllBits[i];
    }
 }
@@ -204,7 +266,11 @@ void TBits::DoXorEqual(const TBits& rhs)
 
 void TBits::DoFlip()
 {
-   for(UInt_t i=0; i<fNbytes; ++i) {
+   UInt_t i = 0;
+   for(; i+8<=fNbytes; i+=8) {
+      StoreWord(&(fAllBits[i]), ~LoadWord(&(fAllBits[i])));
+   }
+   for(; i<fNbytes; ++i) {
       fAllBits[i] = ~fAllBits[i];
    }
    // NOTE: out-of-bounds bit were also flipped!
@@ -282,22 +348,32 @@ UInt_t TBits::FirstNullBit(UInt_t startBit) const
              0,1,0,2,0,1,0,3,0,1,0,2,0,1,0,8};
 
    UInt_t i;
-   if (startBit == 0) {
-      for(i=0; i<fNbytes; i++) {
-         if (fAllBits[i] != 255) return 8*i + fbits[fAllBits[i]];
+   UInt_t startByte = 0;
+   if (startBit) {
+      if (startBit >= fNbits) return fNbits;
+      startByte = startBit/8;
+      UInt_t ibit = startBit%8;
+      if (ibit) {
+         for (i=ibit;i<8;i++) {
+            if ((fAllBits[startByte] & (1<<i)) == 0) return 8*startByte+i;
+         }
+         startByte++;
       }
-      return fNbits;
    }
-   if (startBit >= fNbits) return fNbits;
-   UInt_t startByte = startBit/8;
-   UInt_t ibit = startBit%8;
-   if (ibit) {
-      for (i=ibit;i<8;i++) {
-         if ((fAllBits[startByte] & (1<<i)) == 0) return 8*startByte+i;
+   // skip the all-ones 64-bit words, then locate the bit within the word
+   // (with count-trailing-zeros on little endian, with the lookup table
+   // on the bytes of the word otherwise)
+   for(i=startByte; i+8<=fNbytes; i+=8) {
+      ULong64_t word = ~LoadWord(&(fAllBits[i]));
+      if (word != 0) {
+#ifdef R__BYTESWAP
+         return 8*i + LowestBitWord(word);
+#else
+         break;
+#endif
       }
-      startByte++;
    }
-   for(i=startByte; i<fNbytes; i++) {
+   for(; i<fNbytes; i++) {
       if (fAllBits[i] != 255) return 8*i + fbits[fAllBits[i]];
    }
    return fNbits;
@@ -366,22 +442,32 @@ UInt_t TBits::FirstSetBit(UInt_t startBit) const
              4,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0};
 
    UInt_t i;
-   if (startBit == 0) {
-      for(i=0; i<fNbytes; i++) {
-         if (fAllBits[i] != 0) return 8*i + fbits[fAllBits[i]];
+   UInt_t startByte = 0;
+   if (startBit) {
+      if (startBit >= fNbits) return fNbits;
+      startByte = startBit/8;
+      UInt_t ibit = startBit%8;
+      if (ibit) {
+         for (i=ibit;i<8;i++) {
+            if ((fAllBits[startByte] & (1<<i)) != 0) return 8*startByte+i;
+         }
+         startByte++;
       }
-      return fNbits;
    }
-   if (startBit >= fNbits) return fNbits;
-   UInt_t startByte = startBit/8;
-   UInt_t ibit = startBit%8;
-   if (ibit) {
-      for (i=ibit;i<8;i++) {
-         if ((fAllBits[startByte] & (1<<i)) != 0) return 8*startByte+i;
+   // skip the all-zeros 64-bit words, then locate the bit within the word
+   // (with count-trailing-zeros on little endian, with the lookup table
+   // on the bytes of the word otherwise)
+   for(i=startByte; i+8<=fNbytes; i+=8) {
+      ULong64_t word = LoadWord(&(fAllBits[i]));
+      if (word != 0) {
+#ifdef R__BYTESWAP
+         return 8*i + LowestBitWord(word);
+#else
+         break;
+#endif
       }
-      startByte++;
    }
-   for(i=startByte; i<fNbytes; i++) {
+   for(; i<fNbytes; i++) {
       if (fAllBits[i] != 0) return 8*i + fbits[fAllBits[i]];
    }
    return fNbits;
@@ -34,13 +34,10 @@ TExMap::TExMap(Int_t mapSize)
    // needed for automatic resizing to guarantee that one slot is always empty
    if (mapSize < 4) mapSize = 5;
 
-   switch (mapSize) {
-      // Avoid calling NextPrime for the common case:
-      case   5: fSize = 5; break;
-      case 503: fSize = 503; break;
-      default:
-         fSize  = (Int_t)TMath::NextPrime(mapSize);
-   }
+   // round up to the next power of two so that Bucket() can derive the
+   // slot from the hash with a multiply and a mask instead of a modulo
+   fSize = 8;
+   while (fSize < mapSize) fSize <<= 1;
    fTable = new Assoc_t [fSize];
 
    memset(fTable,0,sizeof(Assoc_t)*fSize);
@@ -175,7 +172,7 @@ Long64_t TExMap::GetValue(ULong64_t hash, Long64_t key)
    if (!fTable) return 0;
 
    hash |= 0x1;
-   Int_t slot = Int_t(hash % fSize);
+   Int_t slot = Bucket(hash);
    Int_t firstSlot = slot;
    do {
       if (!fTable[slot].InUse()) return 0;
@@ -198,7 +195,7 @@ Long64_t TExMap::GetValue(ULong64_t hash, Long64_t key, UInt_t &slot)
    if (!fTable) { slot = 0; return 0; }
 
    hash |= 0x1;
-   slot = Int_t(hash % fSize);
+   slot = Bucket(hash);
    UInt_t firstSlot = slot;
    do {
       if (!fTable[slot].InUse()) return 0;
@@ -238,7 +235,7 @@ Int_t TExMap::FindElement(ULong64_t hash, Long64_t key)
    if (!fTable) return 0;
 
    hash |= 0x1;
-   Int_t slot = Int_t(hash % fSize);
+   Int_t slot = Bucket(hash);
    Int_t firstSlot = slot;
    do {
       if (!fTable[slot].InUse()) return slot;
@@ -280,7 +277,9 @@ void TExMap::Expand(Int_t newSize)
    Int_t i;
    Assoc_t *oldTable = fTable;
    Int_t oldsize = fSize;
-   newSize = (Int_t)TMath::NextPrime(newSize);
+   Int_t pow2 = 8;
+   while (pow2 < newSize) pow2 <<= 1;
+   newSize = pow2;
    fTable  = new Assoc_t [newSize];
 
    for (i = newSize; --i >= 0;) {
@@ -325,12 +324,10 @@ void TExMap::Streamer(TBuffer &b)
             b >> hash;
             b >> key;
             b >> value;
-            Assoc_t *assoc = fTable + slot;
-            assoc->SetHash(hash);
-            assoc->fKey = key;
-            assoc->fValue = value;
+            // the stored slot was computed with the writer's table size and
+            // bucket mapping, so re-insert instead of placing it verbatim
+            Add(hash, key, value);
          }
-         fTally = tally;
       } else if (R__v >= 2) {
          // new custom streamer with slots indices stored.
          Int_t size, tally;
@@ -345,12 +342,10 @@ void TExMap::Streamer(TBuffer &b)
             b >> hash;
             b >> key;
             b >> value;
-            Assoc_t* assoc = fTable + slot;
-            assoc->SetHash(hash);
-            assoc->fKey = key;
-            assoc->fValue = value;
+            // the stored slot was computed with the writer's table size and
+            // bucket mapping, so re-insert instead of placing it verbatim
+            Add(hash, key, value);
          }
-         fTally = tally;
       } else {
          // old custom streamer that only allows slow dynamic rebuild of TExMap:
          Int_t n;
@@ -47,7 +47,11 @@ THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
    } else if (capacity == 0)
       capacity = TCollection::kInitHashTableCapacity;
 
-   fSize = (Int_t)TMath::NextPrime(TMath::Max(capacity,(int)TCollection::kInitHashTableCapacity));
+   // round up to the next power of two so that BucketFor() can derive the
+   // slot from the hash with a multiply and a mask instead of a modulo
+   Int_t minCapacity = TMath::Max(capacity,(int)TCollection::kInitHashTableCapacity);
+   fSize = 8;
+   while (fSize < minCapacity) fSize <<= 1;
    fCont = new TList* [fSize];
    memset(fCont, 0, fSize*sizeof(TList*));
 
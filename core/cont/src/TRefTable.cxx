@@ -262,6 +262,44 @@ TObject *TRefTable::GetParent(Int_t uid, TProcessID *context /* =0 */ ) const
    return fParents->UncheckedAt(pnumber);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate a whole set of uids in one pass.
+///
+/// For each of the nuids entries of uids, store in parents[i] the object
+/// GetParent would return for uids[i] (or 0 when the uid is not in the
+/// table).  The internal index of context is resolved only once for the
+/// whole batch instead of once per reference, which matters when translating
+/// all the references of a basket at a time.  All uids must refer to the
+/// same context.  Returns the number of uids that resolved to a parent.
+
+Int_t TRefTable::GetParents(const Int_t *uids, Int_t nuids, TObject **parents,
+                            TProcessID *context /* =0 */) const
+{
+   if (nuids <= 0) return 0;
+   if (!fParents) {
+      for (Int_t i = 0; i < nuids; ++i) parents[i] = 0;
+      return 0;
+   }
+
+   if (!context) context = TProcessID::GetSessionProcessID();
+   Int_t iid = GetInternalIdxForPID(context);
+
+   const Int_t *parentIDs = fParentIDs[iid];
+   Int_t n = fN[iid];
+   Int_t nparents = fParents->GetEntriesFast();
+   Int_t nresolved = 0;
+   for (Int_t i = 0; i < nuids; ++i) {
+      Int_t uid = uids[i] & 0xFFFFFF;
+      parents[i] = 0;
+      if (uid < 0 || uid >= n) continue;
+      Int_t pnumber = parentIDs[uid] - 1;
+      if (pnumber < 0 || pnumber >= nparents) continue;
+      parents[i] = fParents->UncheckedAt(pnumber);
+      ++nresolved;
+   }
+   return nresolved;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the index for fProcessIDs, fAllocSize, etc given a PID.
 /// Uses fMapPIDtoInternal and the pid's GUID / fProcessGUID
@@ -37,6 +37,7 @@ private:
    bool fIsInheritable;
 
    bool fRequestStreamerInfo;    // for linkdef.h: true if we had '+' at the end of a class name
+   bool fRequestCompiledStreamer = false; // for linkdef.h: true if options=compiledstreamer was given
    bool fRequestNoStreamer;      // for linkdef.h: true if we had '-' or "-!" at the end of a class name
    bool fRequestNoInputOperator; // for linkdef.h: true if we had '!' at the end of a class name
    bool fRequestOnlyTClass;      // True if the user want the TClass intiliazer but *not* the interpreter meta data
@@ -71,6 +72,7 @@ public:
    void SetInheritable(bool inherit); //sets the inheritance rule for the class
 
    void SetRequestStreamerInfo(bool needStreamerInfo);
+   void SetRequestCompiledStreamer(bool compiledStreamer);
    void SetRequestNoStreamer(bool noStreamer);
    void SetRequestNoInputOperator(bool excl);
    void SetRequestOnlyTClass(bool val);
@@ -82,6 +84,7 @@ public:
    bool RequestNoStreamer() const;      // Request no Streamer function in the dictionary
    bool RequestNoInputOperator() const; // Request no generation on a default input operator by rootcint or the compiler.
    bool RequestStreamerInfo() const;    // Request the ROOT 4+ I/O streamer
+   bool RequestCompiledStreamer() const; // Request a specialized straight-line Streamer body
    bool RequestProtected() const;
    bool RequestPrivate() const;
    int  RequestedVersionNumber() const;
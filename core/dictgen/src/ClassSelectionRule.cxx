@@ -117,6 +117,16 @@ void ClassSelectionRule::SetRequestStreamerInfo(bool pl)
    fRequestStreamerInfo = pl;
 }
 
+bool ClassSelectionRule::RequestCompiledStreamer() const
+{
+   return fRequestCompiledStreamer;
+}
+
+void ClassSelectionRule::SetRequestCompiledStreamer(bool cs)
+{
+   fRequestCompiledStreamer = cs;
+}
+
 bool ClassSelectionRule::RequestNoStreamer() const
 {
    return fRequestNoStreamer;
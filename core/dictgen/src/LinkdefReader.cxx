@@ -47,7 +47,7 @@ std::map<std::string, LinkdefReader::EPragmaNames> LinkdefReader::fgMapPragmaNam
 std::map<std::string, LinkdefReader::ECppNames> LinkdefReader::fgMapCppNames;
 
 struct LinkdefReader::Options {
-   Options() : fNoStreamer(0), fNoInputOper(0), fUseByteCount(0), fVersionNumber(-1) {}
+   Options() : fNoStreamer(0), fNoInputOper(0), fUseByteCount(0), fCompiledStreamer(0), fVersionNumber(-1) {}
 
    int fNoStreamer;
    int fNoInputOper;
@@ -55,6 +55,7 @@ struct LinkdefReader::Options {
       int fUseByteCount;
       int fRequestStreamerInfo;
    };
+   int fCompiledStreamer;
    int fVersionNumber;
 };
 
@@ -405,6 +406,7 @@ bool LinkdefReader::AddRule(const std::string& ruletype,
                   if (options->fNoStreamer) csr.SetRequestNoStreamer(true);
                   if (options->fNoInputOper) csr.SetRequestNoInputOperator(true);
                   if (options->fRequestStreamerInfo) csr.SetRequestStreamerInfo(true);
+                  if (options->fCompiledStreamer) csr.SetRequestCompiledStreamer(true);
                   if (options->fVersionNumber >= 0) csr.SetRequestedVersionNumber(options->fVersionNumber);
                }
                if (csr.RequestStreamerInfo() && csr.RequestNoStreamer()) {
@@ -658,6 +660,8 @@ public:
        *   nostreamer: set G__NOSTREAMER flag
        *   noinputoper: set G__NOINPUTOPERATOR flag
        *   evolution: set G__USEBYTECOUNT flag
+       *   compiledstreamer: emit a specialized straight-line Streamer body
+       *                     instead of the generic TStreamerInfo-driven one
        *   nomap: (ignored by roocling; prevents entry in ROOT's rootmap file)
        *   stub: (ignored by rootcling was a directly for CINT code generation)
        *   version(x): sets the version number of the class to x
@@ -682,6 +686,7 @@ public:
          } else if (tok.getIdentifierInfo()->getName() == "nostreamer") options.fNoStreamer = 1;
          else if (tok.getIdentifierInfo()->getName() == "noinputoper") options.fNoInputOper = 1;
          else if (tok.getIdentifierInfo()->getName() == "evolution") options.fRequestStreamerInfo = 1;
+         else if (tok.getIdentifierInfo()->getName() == "compiledstreamer") options.fCompiledStreamer = 1;
          else if (tok.getIdentifierInfo()->getName() == "stub") {
             // This was solely for CINT dictionary, ignore for now.
             // options.fUseStubs = 1;
@@ -542,6 +542,7 @@ int RScanner::AddAnnotatedRecordDecl(const ClassSelectionRule* selected,
                                     fInterpreter,
                                     fNormCtxt);
    }
+   fSelectedClasses.back().SetRequestCompiledStreamer(selected->RequestCompiledStreamer());
 
    if (fVerboseLevel > 0) {
       std::string qual_name;
@@ -79,7 +79,9 @@ const char *rootClingHelp =
    "  Needs the -s flag. See its documentation.                                 \n"
    "                                                                            \n"
    " -inlineInputHeader\tAdd the argument header to the code of the dictionary. \n"
-   "  This allows the header to be inlined within the dictionary.               \n"
+   "  This allows the header to be inlined within the dictionary. Such a        \n"
+   "  dictionary is self-contained: loaded with autoparse disabled (rootrc      \n"
+   "  variable Interpreter.AutoParse=0) it needs no header files at run time.   \n"
    "                                                                            \n"
    " -interpreteronly\tNo IO information in the dictionary.                     \n"
    "                                                                            \n"
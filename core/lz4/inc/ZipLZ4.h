@@ -0,0 +1,33 @@
+// @(#)root/lz4:$Id$
+// Author: Philippe Canal   May 2017
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_ZipLZ4
+#define ROOT_ZipLZ4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void R__zipLZ4(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
+
+void R__unzipLZ4(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+
+/* Check the envelope of one LZ4 block without decompressing it.
+   Returns 1 when the block carries a checksum and it matches,
+   0 when the block is structurally valid but has no checksum (version 1),
+   -1 when the header is malformed and -2 on a checksum mismatch. */
+int R__lz4VerifyBlock(const unsigned char *src, int srcsize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
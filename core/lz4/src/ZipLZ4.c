@@ -0,0 +1,447 @@
+// @(#)root/lz4:$Id$
+// Author: Philippe Canal   May 2017
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/*
+  In-memory LZ4 compression and decompression with the ROOT 9 byte
+  envelope ('L','4' signature).  The block codec below is a compact,
+  self-contained implementation of the LZ4 block format
+  (https://lz4.github.io/lz4/): greedy parsing with a small hash table
+  on the compression side, sequential token decoding on the other.
+  It trades a few percent of ratio against zlib for a much cheaper
+  decompression loop, which is what the analysis read path is bound by.
+
+  Since version 2 of the envelope, each block also stores a CRC32C of
+  its compressed bytes (computed with the SSE4.2 crc32 instruction when
+  the CPU has it), which is validated before decompression so that
+  silent corruption from the storage layer is diagnosed at the point of
+  the read.  Version 1 blocks, without checksum, are still readable.
+*/
+
+#include "ZipLZ4.h"
+#include <stdio.h>
+#include <string.h>
+
+static const int kHeaderSize = 9;
+
+/* Version 2 blocks carry a CRC32C of the compressed data right after the
+   envelope; the stored compressed size includes these 4 bytes, so the
+   generic consistency checks in R__unzip keep working unchanged. */
+static const int kChecksumSize = 4;
+
+/* ------------------------------------------------------------------ */
+/* CRC32C (Castagnoli polynomial), as computed by the SSE4.2 crc32
+   instruction. The table based fallback is used on other hardware.   */
+
+static unsigned R__crc32c_table[256];
+static volatile int R__crc32c_table_ready = 0;
+
+static void R__crc32c_maketable(void)
+{
+   /* Racing initializations write identical values, so this needs
+      no synchronization */
+   unsigned i, j, c;
+   for (i = 0; i < 256; i++) {
+      c = i;
+      for (j = 0; j < 8; j++)
+         c = (c & 1) ? (c >> 1) ^ 0x82f63b78U : (c >> 1);
+      R__crc32c_table[i] = c;
+   }
+   R__crc32c_table_ready = 1;
+}
+
+static unsigned R__crc32c_sw(unsigned crc, const unsigned char *buf, int len)
+{
+   if (!R__crc32c_table_ready) R__crc32c_maketable();
+   while (len--)
+      crc = R__crc32c_table[(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+   return crc;
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define R__LZ4_HWCRC
+#include <nmmintrin.h>
+
+__attribute__((target("sse4.2")))
+static unsigned R__crc32c_hw(unsigned crc, const unsigned char *buf, int len)
+{
+#ifdef __x86_64__
+   unsigned long long c = crc;
+   while (len >= 8) {
+      unsigned long long v;
+      memcpy(&v, buf, 8);
+      c = _mm_crc32_u64(c, v);
+      buf += 8;
+      len -= 8;
+   }
+   crc = (unsigned) c;
+#endif
+   while (len >= 4) {
+      unsigned v;
+      memcpy(&v, buf, 4);
+      crc = _mm_crc32_u32(crc, v);
+      buf += 4;
+      len -= 4;
+   }
+   while (len--)
+      crc = _mm_crc32_u8(crc, *buf++);
+   return crc;
+}
+#endif
+
+static unsigned R__crc32c(const unsigned char *buf, int len)
+{
+#ifdef R__LZ4_HWCRC
+   static volatile int hwcrc = -1;
+   if (hwcrc < 0) hwcrc = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+   if (hwcrc)
+      return R__crc32c_hw(0xffffffffU, buf, len) ^ 0xffffffffU;
+#endif
+   return R__crc32c_sw(0xffffffffU, buf, len) ^ 0xffffffffU;
+}
+
+#define LZ4_HASHLOG     13
+#define LZ4_HASHSIZE    (1 << LZ4_HASHLOG)
+#define LZ4_MINMATCH    4
+#define LZ4_MFLIMIT     12      /* matches must not start closer to the end */
+#define LZ4_LASTLITERALS 5      /* the last bytes are always literals */
+#define LZ4_MAXOFFSET   65535
+#define LZ4_SKIPTRIGGER 6
+
+static unsigned R__lz4_read32(const unsigned char *p)
+{
+   unsigned v;
+   memcpy(&v, p, 4);
+   return v;
+}
+
+static unsigned R__lz4_hash(unsigned sequence)
+{
+   return (sequence * 2654435761U) >> (32 - LZ4_HASHLOG);
+}
+
+/* Compress srcsize bytes into dst (capacity dstcap) in LZ4 block format.
+   Returns the compressed size, or 0 if the data does not fit in dst.
+   acceleration >= 1 makes the match search give up faster on
+   incompressible input, trading ratio for speed. */
+static int R__lz4_compress_block(const char *src, int srcsize, char *dst, int dstcap,
+                                 int acceleration)
+{
+   const unsigned char *ip = (const unsigned char *) src;
+   const unsigned char *anchor = ip;
+   const unsigned char *const iend = ip + srcsize;
+   const unsigned char *const mflimit = (srcsize > LZ4_MFLIMIT) ? iend - LZ4_MFLIMIT : ip;
+   const unsigned char *const matchlimit = iend - LZ4_LASTLITERALS;
+   const unsigned char *const base = ip;
+   unsigned char *op = (unsigned char *) dst;
+   unsigned char *const oend = op + dstcap;
+   unsigned htab[LZ4_HASHSIZE];     /* position + 1, 0 means empty */
+   unsigned searchMatchNb = (unsigned) acceleration << LZ4_SKIPTRIGGER;
+
+   memset(htab, 0, sizeof(htab));
+
+   if (srcsize > LZ4_MFLIMIT) {
+      for (;;) {
+         const unsigned char *match = 0;
+         unsigned h;
+
+         /* Find a 4 byte match within the 64k window */
+         for (;;) {
+            unsigned cand;
+            if (ip > mflimit) goto lastliterals;
+            h = R__lz4_hash(R__lz4_read32(ip));
+            cand = htab[h];
+            htab[h] = (unsigned) (ip - base) + 1;
+            if (cand && ((unsigned) (ip - base) + 1 - cand) <= LZ4_MAXOFFSET &&
+                R__lz4_read32(base + cand - 1) == R__lz4_read32(ip)) {
+               match = base + cand - 1;
+               break;
+            }
+            /* Step grows while no match is found, so incompressible
+               stretches are skipped quickly */
+            ip += searchMatchNb++ >> LZ4_SKIPTRIGGER;
+         }
+
+         /* Extend the match backwards over pending literals */
+         while (ip > anchor && match > base && ip[-1] == match[-1]) {
+            ip--;
+            match--;
+         }
+
+         {
+            int litlen = (int) (ip - anchor);
+            unsigned offset = (unsigned) (ip - match);
+            const unsigned char *mend;
+            int mlen;
+            unsigned char *token;
+
+            /* Worst case for this sequence: token + litlen bytes + literals
+               + offset + matchlen bytes */
+            if (op + 1 + (litlen / 255) + 1 + litlen + 2 + 5 > oend) return 0;
+
+            token = op++;
+            if (litlen >= 15) {
+               int l = litlen - 15;
+               *token = (unsigned char) (15 << 4);
+               for (; l >= 255; l -= 255) *op++ = 255;
+               *op++ = (unsigned char) l;
+            } else {
+               *token = (unsigned char) (litlen << 4);
+            }
+            memcpy(op, anchor, litlen);
+            op += litlen;
+
+            /* Count the match length */
+            mend = ip + LZ4_MINMATCH;
+            match += LZ4_MINMATCH;
+            while (mend < matchlimit && *mend == *match) {
+               mend++;
+               match++;
+            }
+            mlen = (int) (mend - ip);
+
+            *op++ = (unsigned char) (offset & 0xff);
+            *op++ = (unsigned char) ((offset >> 8) & 0xff);
+
+            mlen -= LZ4_MINMATCH;
+            if (mlen >= 15) {
+               int l = mlen - 15;
+               *token |= 15;
+               for (; l >= 255; l -= 255) {
+                  if (op >= oend) return 0;
+                  *op++ = 255;
+               }
+               if (op >= oend) return 0;
+               *op++ = (unsigned char) l;
+            } else {
+               *token |= (unsigned char) mlen;
+            }
+
+            ip = mend;
+            anchor = ip;
+         }
+      }
+   }
+
+lastliterals:
+   {
+      /* The block always ends with a literals-only sequence */
+      int litlen = (int) (iend - anchor);
+      if (op + 1 + (litlen / 255) + litlen > oend) return 0;
+      if (litlen >= 15) {
+         int l = litlen - 15;
+         *op++ = (unsigned char) (15 << 4);
+         for (; l >= 255; l -= 255) *op++ = 255;
+         *op++ = (unsigned char) l;
+      } else {
+         *op++ = (unsigned char) (litlen << 4);
+      }
+      memcpy(op, anchor, litlen);
+      op += litlen;
+   }
+
+   return (int) (op - (unsigned char *) dst);
+}
+
+/* Decompress an LZ4 block of srcsize bytes into dst (capacity dstcap).
+   Returns the decompressed size, or -1 on malformed input. */
+static int R__lz4_decompress_block(const unsigned char *src, int srcsize,
+                                   unsigned char *dst, int dstcap)
+{
+   const unsigned char *ip = src;
+   const unsigned char *const iend = src + srcsize;
+   unsigned char *op = dst;
+   unsigned char *const oend = dst + dstcap;
+
+   while (ip < iend) {
+      unsigned token = *ip++;
+      int litlen = (int) (token >> 4);
+      int mlen;
+      unsigned offset;
+
+      if (litlen == 15) {
+         unsigned s;
+         do {
+            if (ip >= iend) return -1;
+            s = *ip++;
+            litlen += (int) s;
+            /* no valid run exceeds the output capacity; without this bound a
+               long enough chain of 0xff extension bytes overflows litlen */
+            if (litlen > dstcap) return -1;
+         } while (s == 255);
+      }
+      if (ip + litlen > iend || op + litlen > oend) return -1;
+      memcpy(op, ip, litlen);
+      ip += litlen;
+      op += litlen;
+
+      if (ip >= iend) break;   /* last sequence carries only literals */
+
+      if (ip + 2 > iend) return -1;
+      offset = (unsigned) ip[0] | ((unsigned) ip[1] << 8);
+      ip += 2;
+      if (offset == 0 || op - offset < dst) return -1;
+
+      mlen = (int) (token & 15);
+      if (mlen == 15) {
+         unsigned s;
+         do {
+            if (ip >= iend) return -1;
+            s = *ip++;
+            mlen += (int) s;
+            if (mlen > dstcap) return -1;   /* same overflow bound as litlen */
+         } while (s == 255);
+      }
+      mlen += LZ4_MINMATCH;
+      if (op + mlen > oend) return -1;
+
+      /* The copy must be byte wise: the match may overlap the output */
+      while (mlen--) {
+         *op = *(op - offset);
+         op++;
+      }
+   }
+
+   return (int) (op - dst);
+}
+
+void R__zipLZ4(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+   int osize, stored;
+   int acceleration;
+   unsigned crc;
+
+   *irep = 0;
+
+   if (*tgtsize <= kHeaderSize + kChecksumSize) {
+      return;
+   }
+
+   if (*srcsize > 0xffffff || *srcsize < 0) {
+      return;
+   }
+
+   /* Below level 4 give up faster on incompressible stretches */
+   acceleration = (cxlevel < 4) ? (1 << (4 - cxlevel)) : 1;
+
+   osize = R__lz4_compress_block(src, *srcsize, &tgt[kHeaderSize + kChecksumSize],
+                                 *tgtsize - kHeaderSize - kChecksumSize, acceleration);
+   if (osize <= 0 || osize + kChecksumSize >= *srcsize) {
+      /* Not compressible; the caller stores the buffer uncompressed */
+      return;
+   }
+
+   stored = osize + kChecksumSize;
+
+   tgt[0] = 'L';
+   tgt[1] = '4';
+   tgt[2] = 2;                  /* block format version, 2 = with checksum */
+
+   tgt[3] = (char) (stored & 0xff);             /* compressed size */
+   tgt[4] = (char) ((stored >> 8) & 0xff);
+   tgt[5] = (char) ((stored >> 16) & 0xff);
+
+   tgt[6] = (char) (*srcsize & 0xff);           /* decompressed size */
+   tgt[7] = (char) ((*srcsize >> 8) & 0xff);
+   tgt[8] = (char) ((*srcsize >> 16) & 0xff);
+
+   crc = R__crc32c((unsigned char *) &tgt[kHeaderSize + kChecksumSize], osize);
+   tgt[kHeaderSize + 0] = (char) (crc & 0xff);
+   tgt[kHeaderSize + 1] = (char) ((crc >> 8) & 0xff);
+   tgt[kHeaderSize + 2] = (char) ((crc >> 16) & 0xff);
+   tgt[kHeaderSize + 3] = (char) ((crc >> 24) & 0xff);
+
+   *irep = stored + kHeaderSize;
+}
+
+void R__unzipLZ4(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+   int ibufcnt, isize;
+   int osize;
+   int datastart = kHeaderSize;
+
+   *irep = 0;
+
+   if (*srcsize < kHeaderSize) {
+      fprintf(stderr, "R__unzipLZ4: too small source\n");
+      return;
+   }
+
+   if (src[0] != 'L' || src[1] != '4') {
+      fprintf(stderr, "R__unzipLZ4: error in header\n");
+      return;
+   }
+
+   ibufcnt = (int) src[3] | ((int) src[4] << 8) | ((int) src[5] << 16);
+   isize   = (int) src[6] | ((int) src[7] << 8) | ((int) src[8] << 16);
+
+   if (ibufcnt + kHeaderSize != *srcsize) {
+      fprintf(stderr, "R__unzipLZ4: discrepancy in source length\n");
+      return;
+   }
+   if (*tgtsize < isize) {
+      fprintf(stderr, "R__unzipLZ4: too small target\n");
+      return;
+   }
+
+   if (src[2] >= 2) {
+      /* Version 2: validate the checksum of the compressed data before
+         decompressing, so corruption from the storage layer is reported
+         here instead of surfacing later during deserialization */
+      unsigned stored, actual;
+      if (ibufcnt < kChecksumSize) {
+         fprintf(stderr, "R__unzipLZ4: discrepancy in source length\n");
+         return;
+      }
+      stored = (unsigned) src[kHeaderSize] |
+               ((unsigned) src[kHeaderSize + 1] << 8) |
+               ((unsigned) src[kHeaderSize + 2] << 16) |
+               ((unsigned) src[kHeaderSize + 3] << 24);
+      actual = R__crc32c(src + kHeaderSize + kChecksumSize, ibufcnt - kChecksumSize);
+      if (stored != actual) {
+         fprintf(stderr, "R__unzipLZ4: checksum mismatch in %d byte block, "
+                 "the data is corrupted (expected %08x, got %08x)\n",
+                 ibufcnt - kChecksumSize, stored, actual);
+         return;
+      }
+      datastart += kChecksumSize;
+      ibufcnt   -= kChecksumSize;
+   }
+
+   osize = R__lz4_decompress_block(src + datastart, ibufcnt, tgt, *tgtsize);
+   if (osize != isize) {
+      fprintf(stderr, "R__unzipLZ4: error during decompression\n");
+      return;
+   }
+
+   *irep = osize;
+}
+
+int R__lz4VerifyBlock(const unsigned char *src, int srcsize)
+{
+   int ibufcnt;
+   unsigned stored, actual;
+
+   if (srcsize < kHeaderSize) return -1;
+   if (src[0] != 'L' || src[1] != '4') return -1;
+
+   ibufcnt = (int) src[3] | ((int) src[4] << 8) | ((int) src[5] << 16);
+   if (ibufcnt + kHeaderSize > srcsize) return -1;
+
+   if (src[2] < 2) return 0;           /* version 1 carries no checksum */
+   if (ibufcnt < kChecksumSize) return -1;
+
+   stored = (unsigned) src[kHeaderSize] |
+            ((unsigned) src[kHeaderSize + 1] << 8) |
+            ((unsigned) src[kHeaderSize + 2] << 16) |
+            ((unsigned) src[kHeaderSize + 3] << 24);
+   actual = R__crc32c(src + kHeaderSize + kChecksumSize, ibufcnt - kChecksumSize);
+   return (stored == actual) ? 1 : -2;
+}
@@ -40,15 +40,22 @@ void R__zipLZMA(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
 
    if (cxlevel > 9) cxlevel = 9;
 
-   if (lzma_lzma_preset(&opt_lzma2, cxlevel)) {
+   if (lzma_lzma_preset(&opt_lzma2,
+                        cxlevel == 9 ? (9 | LZMA_PRESET_EXTREME) : (uint32_t)cxlevel)) {
       return;
    }
 
+   if (cxlevel >= 8) {
+      /* archival tier: let the dictionary cover the whole stream, so a
+         cluster-sized basket exploits all of its cross-entry redundancy
+       */
+      dict_size_est = in_size;
+   }
    if (LZMA_DICT_SIZE_MIN > dict_size_est) {
       dict_size_est = LZMA_DICT_SIZE_MIN;
    }
    if (opt_lzma2.dict_size > dict_size_est) {
-      /* reduce the dictionary size if larger than 1/4 the input size, preset
+      /* reduce the dictionary size if larger than the estimate above, preset
          dictionaries size can be expensively large
        */
       opt_lzma2.dict_size = dict_size_est;
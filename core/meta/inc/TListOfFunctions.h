@@ -28,6 +28,9 @@
 
 #include "TDictionary.h"
 
+#include <atomic>
+#include <vector>
+
 class TExMap;
 class TFunction;
 
@@ -41,12 +44,18 @@ private:
    THashTable fOverloads; // TLists of overloads.
    ULong64_t  fLastLoadMarker; // Represent interpreter state when we last did a full load.
 
+   // Immutable snapshot of fIds published for lock-free read-side lookups;
+   // null whenever the list has been mutated since the last publication.
+   mutable std::atomic<TExMap*> fPublishedIds; //! Published snapshot of fIds.
+   mutable std::vector<TExMap*> fRetiredIds;   //! Invalidated snapshots, freed in the destructor.
+
    TListOfFunctions(const TListOfFunctions&);              // not implemented
    TListOfFunctions& operator=(const TListOfFunctions&);   // not implemented
    TList     *GetListForObjectNonConst(const char* name);
 
    void       MapObject(TObject *obj);
    void       UnmapObject(TObject *obj);
+   void       InvalidateSnapshot();
 
 public:
    typedef TDictionary::DeclId_t DeclId_t;
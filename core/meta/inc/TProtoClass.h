@@ -79,10 +79,13 @@ private:
    Long_t   fProperty;       // Class properties, see EProperties
    Long_t   fClassProperty;  // Class C++ properties, see EClassProperties
    Long_t   fOffsetStreamer; // Offset to streamer function
+   TString  fPCMFile;        //! PCM holding the payload of a lazy shell; empty once materialized
 
    TProtoClass(const TProtoClass &) = delete;
    TProtoClass &operator=(const TProtoClass &) = delete;
 
+   Bool_t Materialize();
+
    const char * GetClassName(Int_t index) const { return (index >= 0) ? fDepClasses[index].Data() : 0; }
 
    // compute index of data member in the list
@@ -99,23 +102,33 @@ public:
 
    TProtoClass(TProtoClass *pc);
    TProtoClass(TClass *cl);
+   TProtoClass(const char *clname, const char *pcmFileName);
    virtual ~TProtoClass();
 
+   // Reads the payload of one protoclass from a split PCM; installed by
+   // the code that knows how to open the PCM (see TCling::LoadPCM).
+   typedef TProtoClass *(*PayloadReaderFunc_t)(const char *pcmFileName, const char *className);
+   static void SetPayloadReader(PayloadReaderFunc_t reader);
+
    Bool_t FillTClass(TClass *pcl);
    const TList *GetListOfEnums() {
+      if (fPCMFile.Length()) Materialize();
       return fEnums;
    };
    void Delete(Option_t *opt = "");
 
-   int GetSize() { return fSizeof; }
-   TList * GetBaseList() { return fBase; }
+   int GetSize() { if (fPCMFile.Length()) Materialize(); return fSizeof; }
+   TList * GetBaseList() { if (fPCMFile.Length()) Materialize(); return fBase; }
    //TList * GetDataList() { return fData; }
-   TList * GetEnumList() { return fEnums; }
-   std::vector<TProtoRealData> & GetPRDList() { return fPRealData; }
-   std::vector<TDataMember *> & GetData() { return fData; }
-   std::vector<TString> & GetDepClasses() { return fDepClasses; }
+   TList * GetEnumList() { if (fPCMFile.Length()) Materialize(); return fEnums; }
+   std::vector<TProtoRealData> & GetPRDList() { if (fPCMFile.Length()) Materialize(); return fPRealData; }
+   std::vector<TDataMember *> & GetData() { if (fPCMFile.Length()) Materialize(); return fData; }
+   std::vector<TString> & GetDepClasses() { if (fPCMFile.Length()) Materialize(); return fDepClasses; }
 
+private:
+   static PayloadReaderFunc_t fgPayloadReader; //! Reads protoclass payloads from split PCMs
 
+public:
    ClassDef(TProtoClass, 2); //Persistent TClass
 };
 
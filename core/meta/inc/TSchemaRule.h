@@ -83,6 +83,7 @@ namespace ROOT {
          ReadFuncPtr_t    GetReadFunctionPointer() const;
          void             SetReadRawFunctionPointer( ReadRawFuncPtr_t ptr );
          ReadRawFuncPtr_t GetReadRawFunctionPointer() const;
+         Bool_t           CompileReadFunction();
          void             SetInclude( const TString& include );
          const TObjArray* GetInclude() const;
          void             SetRuleType( RuleType_t type );
@@ -117,6 +118,7 @@ namespace ROOT {
          Bool_t                       fEmbed;          //  Value determining if the rule should be embedded
          ReadFuncPtr_t                fReadFuncPtr;    //! Conversion function pointer for read rule
          ReadRawFuncPtr_t             fReadRawFuncPtr; //! Conversion function pointer for readraw rule
+         Bool_t                       fCompiled;       //! True after an attempt to compile the code snippet
          RuleType_t                   fRuleType;       //  Type of the rule
          TString                      fAttributes;     //  Attributes to be applied to the member (like Owner/NotOwner)
    };
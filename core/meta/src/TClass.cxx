@@ -69,6 +69,8 @@ a 'using namespace std;' has been applied to and with:
 #include "TVirtualIsAProxy.h"
 #include "TVirtualRefProxy.h"
 #include "TVirtualMutex.h"
+#include "TTrace.h"
+#include "TStringInterner.h"
 #include "TVirtualPad.h"
 #include "THashTable.h"
 #include "TSchemaRuleSet.h"
@@ -78,8 +80,10 @@ a 'using namespace std;' has been applied to and with:
 #include "TSystem.h"
 #include "TThreadSlots.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cctype>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -87,6 +91,7 @@ a 'using namespace std;' has been applied to and with:
 #include <typeinfo>
 #include <cmath>
 #include <assert.h>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -433,6 +438,81 @@ namespace ROOT {
    };
 }
 
+namespace {
+   class TClassLookupCache {
+   // Cache of resolved, loaded name -> TClass lookups that can be read
+   // without taking any lock. The cache is sharded by the hash of the
+   // looked-up name; each shard publishes an immutable map snapshot through
+   // an atomic pointer. Readers only dereference the current snapshot; the
+   // (rare) writers build a new snapshot under a private mutex and publish
+   // it atomically. Replaced snapshots are retired but never deleted, since
+   // a reader may still be traversing them; the shard count keeps both the
+   // snapshots and the memory spent on retired ones small.
+   public:
+      typedef std::unordered_map<std::string, TClass*> Map_t;
+
+      enum { kNumShards = 256 };
+
+   private:
+      static std::atomic<const Map_t*> *Shards()
+      {
+         static std::atomic<const Map_t*> shards[kNumShards] = {};
+         return shards;
+      }
+      static std::mutex &WriteMutex()
+      {
+         static std::mutex mutex;
+         return mutex;
+      }
+      static std::vector<const Map_t*> &Retired()
+      {
+         static std::vector<const Map_t*> retired;
+         return retired;
+      }
+      static size_t Shard(const std::string &name)
+      {
+         return std::hash<std::string>()(name) % (size_t) kNumShards;
+      }
+
+   public:
+      static TClass *Find(const char *name)
+      {
+         // Return the cached TClass for 'name', or 0 if not cached.
+         std::string key(name);
+         const Map_t *map = Shards()[Shard(key)].load(std::memory_order_acquire);
+         if (!map) return 0;
+         Map_t::const_iterator iter = map->find(key);
+         if (iter == map->end()) return 0;
+         return iter->second;
+      }
+      static void Add(const char *name, TClass *cl)
+      {
+         // Record that looking up 'name' resolved to 'cl'.
+         std::string key(name);
+         std::atomic<const Map_t*> &shard = Shards()[Shard(key)];
+         std::lock_guard<std::mutex> guard(WriteMutex());
+         const Map_t *current = shard.load(std::memory_order_relaxed);
+         Map_t *updated = current ? new Map_t(*current) : new Map_t;
+         (*updated)[key] = cl;
+         shard.store(updated, std::memory_order_release);
+         if (current) Retired().push_back(current);
+      }
+      static void Clear()
+      {
+         // Drop all cached lookups, because a class is being removed or
+         // unloaded and must not be returned anymore.
+         std::lock_guard<std::mutex> guard(WriteMutex());
+         for (size_t i = 0; i < (size_t) kNumShards; ++i) {
+            const Map_t *current = Shards()[i].load(std::memory_order_relaxed);
+            if (current) {
+               Shards()[i].store(0, std::memory_order_release);
+               Retired().push_back(current);
+            }
+         }
+      }
+   };
+}
+
 IdMap_t *TClass::GetIdMap() {
 
 #ifdef R__COMPLETE_MEM_TERMINATION
@@ -488,6 +568,9 @@ void TClass::RemoveClass(TClass *oldcl)
 {
    if (!oldcl) return;
 
+   // The class must no longer be found without taking the lock.
+   TClassLookupCache::Clear();
+
    R__LOCKGUARD2(gInterpreterMutex);
    gROOT->GetListOfClasses()->Remove(oldcl);
    if (oldcl->GetTypeInfo()) {
@@ -2890,6 +2973,16 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
    if (strncmp(name,"class ",6)==0) name += 6;
    if (strncmp(name,"struct ",7)==0) name += 7;
 
+   // Common case: the name was already resolved to a loaded class; look it
+   // up in the lock-free cache before serializing on the interpreter lock.
+   if (TClass *cached = TClassLookupCache::Find(name)) {
+      return cached;
+   }
+
+   // From here on the lookup is expensive (interpreter lock, normalization,
+   // possibly autoloading); the interned copy keeps the label valid.
+   R__TRACE(kTraceClassGet, 0, TStringInterner::Intern(name));
+
    R__LOCKGUARD(gInterpreterMutex);
 
    if (!gROOT->GetListOfClasses())  return 0;
@@ -2899,7 +2992,14 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
    // Early return to release the lock without having to execute the
    // long-ish normalization.
    if (cl) {
-      if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+      if (cl->IsLoaded() || cl->TestBit(kUnloading)) {
+         // Only cache loaded classes: an emulated or interpreted TClass may
+         // still be upgraded or replaced, the cache is only flushed when a
+         // class is removed or unloaded.
+         if (cl->IsLoaded() && !cl->TestBit(kUnloading))
+            TClassLookupCache::Add(name, cl);
+         return cl;
+      }
 
       // We could speed-up some of the search by adding (the equivalent of)
       //
@@ -2932,6 +3032,8 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
       TClass *loadedcl = (dict)();
       if (loadedcl) {
          loadedcl->PostLoadCheck();
+         if (loadedcl->IsLoaded() && !loadedcl->TestBit(kUnloading))
+            TClassLookupCache::Add(name, loadedcl);
          return loadedcl;
       }
 
@@ -2951,7 +3053,11 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
          cl = (TClass*)gROOT->GetListOfClasses()->FindObject(normalizedName.c_str());
 
          if (cl) {
-            if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+            if (cl->IsLoaded() || cl->TestBit(kUnloading)) {
+               if (cl->IsLoaded() && !cl->TestBit(kUnloading))
+                  TClassLookupCache::Add(name, cl);
+               return cl;
+            }
 
             //we may pass here in case of a dummy class created by TVirtualStreamerInfo
             load = kTRUE;
@@ -5875,6 +5981,10 @@ void TClass::SetUnloaded()
    }
    SetBit(kUnloading);
 
+   // The class stays registered but is no longer loaded: it must no longer
+   // be returned by the lock-free lookup cache.
+   TClassLookupCache::Clear();
+
    //R__ASSERT(fState == kLoaded);
    if (fState != kLoaded) {
       Fatal("SetUnloaded","The TClass for %s is being unloaded when in state %d\n",
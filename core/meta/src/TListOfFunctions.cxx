@@ -13,6 +13,14 @@
 A collection of TFunction objects designed for fast access given a
 DeclId_t and for keep track of TFunction that were described
 unloaded function.
+
+Lookups by DeclId_t are served from an immutable snapshot of the
+id-to-function map that is published (read-copy-update style) the first
+time a lookup takes the slow path; subsequent lookups read the snapshot
+without taking the interpreter lock. Any mutation of the list retires
+the snapshot, so the lock is only taken again on actual dictionary
+changes. Retired snapshots are kept until the list is destructed since
+a reader may still be probing them.
 */
 
 #include "TListOfFunctions.h"
@@ -28,7 +36,8 @@ ClassImp(TListOfFunctions)
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor.
 
-TListOfFunctions::TListOfFunctions(TClass *cl) : fClass(cl),fIds(0),fUnloaded(0),fLastLoadMarker(0)
+TListOfFunctions::TListOfFunctions(TClass *cl) : fClass(cl),fIds(0),fUnloaded(0),fLastLoadMarker(0),
+   fPublishedIds(0)
 {
    fIds = new TExMap;
    fUnloaded = new THashList;
@@ -43,6 +52,8 @@ TListOfFunctions::~TListOfFunctions()
    delete fIds;
    fUnloaded->Delete();
    delete fUnloaded;
+   delete fPublishedIds.load();
+   for (auto retired : fRetiredIds) delete retired;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -52,10 +63,23 @@ void TListOfFunctions::MapObject(TObject *obj)
 {
    TFunction *f = dynamic_cast<TFunction*>(obj);
    if (f) {
+      InvalidateSnapshot();
       fIds->Add((Long64_t)f->GetDeclId(),(Long64_t)f);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Retire the published snapshot of the id map. Must be called, with the
+/// interpreter lock held, before any mutation of fIds; lock-free readers
+/// that already loaded the old snapshot keep using it (it still describes
+/// a consistent past state), so it is only deleted in the destructor.
+
+void TListOfFunctions::InvalidateSnapshot()
+{
+   TExMap *old = fPublishedIds.exchange(0, std::memory_order_acq_rel);
+   if (old) fRetiredIds.push_back(old);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add object at the beginning of the list.
 
@@ -152,6 +176,7 @@ void TListOfFunctions::AddBefore(TObjLink *before, TObject *obj)
 void TListOfFunctions::Clear(Option_t *option)
 {
    fUnloaded->Clear(option);
+   InvalidateSnapshot();
    fIds->Clear();
    THashList::Clear(option);
 }
@@ -162,6 +187,7 @@ void TListOfFunctions::Clear(Option_t *option)
 void TListOfFunctions::Delete(Option_t *option /* ="" */)
 {
    fUnloaded->Delete(option);
+   InvalidateSnapshot();
    fIds->Clear();
    THashList::Delete(option);
 }
@@ -251,8 +277,18 @@ TFunction *TListOfFunctions::Find(DeclId_t id) const
 {
    if (!id) return 0;
 
+   // Fast path: the published snapshot holds exactly the content fIds had
+   // when it was published and is retired on any mutation, so both hits
+   // and misses in it are authoritative and need no lock.
+   if (TExMap *snapshot = fPublishedIds.load(std::memory_order_acquire))
+      return (TFunction*)snapshot->GetValue((Long64_t)id);
+
    R__LOCKGUARD(gInterpreterMutex);
-   return (TFunction*)fIds->GetValue((Long64_t)id);
+   TFunction *f = (TFunction*)fIds->GetValue((Long64_t)id);
+   // Publish a snapshot for subsequent lock-free lookups.
+   if (!fPublishedIds.load(std::memory_order_relaxed))
+      fPublishedIds.store(new TExMap(*fIds), std::memory_order_release);
+   return f;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -263,9 +299,17 @@ TFunction *TListOfFunctions::Get(DeclId_t id)
 {
    if (!id) return 0;
 
+   // Fast path: a hit in the published snapshot needs no lock; a miss
+   // means the function really is not there yet and we have to take the
+   // slow path below to create it.
+   if (TExMap *snapshot = fPublishedIds.load(std::memory_order_acquire)) {
+      if (Long64_t found = snapshot->GetValue((Long64_t)id))
+         return (TFunction*)found;
+   }
+
    R__LOCKGUARD(gInterpreterMutex);
    //need the Find and possible Add to be one atomic operation
-   TFunction *f = Find(id);
+   TFunction *f = (TFunction*)fIds->GetValue((Long64_t)id);
    if (f) return f;
 
    if (fClass) {
@@ -300,6 +344,7 @@ TFunction *TListOfFunctions::Get(DeclId_t id)
    // Calling 'just' THahList::Add would turn around and call
    // TListOfFunctions::AddLast which should *also* do the fIds->Add.
    THashList::AddLast(f);
+   InvalidateSnapshot();
    fIds->Add((Long64_t)id,(Long64_t)f);
 
    return f;
@@ -312,6 +357,7 @@ void TListOfFunctions::UnmapObject(TObject *obj)
 {
    TFunction *f = dynamic_cast<TFunction*>(obj);
    if (f) {
+      InvalidateSnapshot();
       fIds->Remove((Long64_t)f->GetDeclId());
    }
 }
@@ -409,6 +455,7 @@ void TListOfFunctions::Load()
 void TListOfFunctions::Unload()
 {
    TObjLink *lnk = FirstLink();
+   InvalidateSnapshot();
    while (lnk) {
       TFunction *func = (TFunction*)lnk->GetObject();
 
@@ -433,6 +480,7 @@ void TListOfFunctions::Unload(TFunction *func)
       // We contains the object, let remove it from the other internal
       // list and move it to the list of unloaded objects.
 
+      InvalidateSnapshot();
       fIds->Remove((Long64_t)func->GetDeclId());
       fUnloaded->Add(func);
    }
@@ -11,6 +11,13 @@
 
 /** \class TProtoClass
 Persistent version of a TClass.
+
+A TProtoClass can also be a lazy shell: created with only the class name
+and the path of a split PCM, it registers the class in the TClassTable
+without any payload and reads its base classes, data members, enums and
+real data from the PCM the first time they are needed (see Materialize).
+This keeps the cost of loading a library with thousands of dictionary
+entries proportional to the classes actually used.
 */
 
 #include "TProtoClass.h"
@@ -29,6 +36,8 @@ Persistent version of a TClass.
 
 #include <cassert>
 
+TProtoClass::PayloadReaderFunc_t TProtoClass::fgPayloadReader = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize a TProtoClass from a TClass.
 
@@ -174,6 +183,66 @@ TProtoClass::TProtoClass(TClass* cl):
 //    }
 // }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Create a lazy shell: only the (normalized) class name is known, the
+/// payload is read from the split PCM pcmFileName the first time it is
+/// accessed.
+
+TProtoClass::TProtoClass(const char *clname, const char *pcmFileName):
+   TNamed(clname, ""), fBase(0), fEnums(0), fSizeof(0), fCheckSum(0),
+   fCanSplit(0), fStreamerType(0), fProperty(0), fClassProperty(0),
+   fOffsetStreamer(0), fPCMFile(pcmFileName)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Install the function used to read one protoclass payload from a split
+/// PCM. Called by the PCM loading code, which knows how to open the file.
+
+void TProtoClass::SetPayloadReader(PayloadReaderFunc_t reader)
+{
+   fgPayloadReader = reader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the payload of a lazy shell from its PCM and adopt it. Only one
+/// attempt is made; returns kTRUE when this protoclass has its payload.
+
+Bool_t TProtoClass::Materialize()
+{
+   if (fPCMFile.Length() == 0) return kTRUE;
+
+   TString pcmFile(fPCMFile);
+   fPCMFile.Clear();
+
+   if (!fgPayloadReader) {
+      Error("Materialize", "no payload reader installed, cannot read %s", GetName());
+      return kFALSE;
+   }
+   TProtoClass *full = fgPayloadReader(pcmFile.Data(), GetName());
+   if (!full) {
+      Error("Materialize", "cannot read the payload of %s from %s",
+            GetName(), pcmFile.Data());
+      return kFALSE;
+   }
+
+   // Steal the payload; full is left empty and can be deleted safely.
+   fBase = full->fBase;   full->fBase = 0;
+   fEnums = full->fEnums; full->fEnums = 0;
+   fPRealData.swap(full->fPRealData);
+   fData.swap(full->fData);
+   fDepClasses.swap(full->fDepClasses);
+   fSizeof         = full->fSizeof;
+   fCheckSum       = full->fCheckSum;
+   fCanSplit       = full->fCanSplit;
+   fStreamerType   = full->fStreamerType;
+   fProperty       = full->fProperty;
+   fClassProperty  = full->fClassProperty;
+   fOffsetStreamer = full->fOffsetStreamer;
+   delete full;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Destructor.
 
@@ -208,6 +277,8 @@ void TProtoClass::Delete(Option_t* opt /*= ""*/) {
 /// duplicate dictionary is acceptable for namespace or STL collections.
 
 Bool_t TProtoClass::FillTClass(TClass* cl) {
+   if (fPCMFile.Length() && !Materialize()) return kFALSE;
+
    if (cl->fRealData || cl->fBase || cl->fData || cl->fEnums.load()
        || cl->fSizeof != -1 || cl->fCanSplit >= 0
        || cl->fProperty != (-1) ) {
@@ -9,6 +9,11 @@
 #include "TObjArray.h"
 #include "TObjString.h"
 #include "TNamed.h"
+#include "TClass.h"
+#include "TDataMember.h"
+#include "TInterpreter.h"
+#include <atomic>
+#include <sstream>
 #include <utility>
 #include <iostream>
 #include <vector>
@@ -89,7 +94,7 @@ TSchemaRule::TSchemaRule(): fVersionVect( 0 ), fChecksumVect( 0 ),
                             fTargetVect( 0 ), fSourceVect( 0 ),
                             fIncludeVect( 0 ), fEmbed( kTRUE ),
                             fReadFuncPtr( 0 ), fReadRawFuncPtr( 0 ),
-                            fRuleType( kNone )
+                            fCompiled( kFALSE ), fRuleType( kNone )
 {
 }
 
@@ -113,7 +118,7 @@ TSchemaRule::TSchemaRule( const TSchemaRule& rhs ): TObject( rhs ),
                             fTargetVect( 0 ), fSourceVect( 0 ),
                             fIncludeVect( 0 ), fEmbed( kTRUE ),
                             fReadFuncPtr( 0 ), fReadRawFuncPtr( 0 ),
-                            fRuleType( kNone )
+                            fCompiled( kFALSE ), fRuleType( kNone )
 {
    *this = rhs;
 }
@@ -134,6 +139,7 @@ TSchemaRule& TSchemaRule::operator = ( const TSchemaRule& rhs )
       fEmbed          = rhs.fEmbed;
       fReadFuncPtr    = rhs.fReadFuncPtr;
       fReadRawFuncPtr = rhs.fReadRawFuncPtr;
+      fCompiled       = rhs.fCompiled;
       fRuleType       = rhs.fRuleType;
       fAttributes     = rhs.fAttributes;
    }
@@ -961,31 +967,118 @@ void TSchemaRule::ProcessDeclaration( TObjArray* array, const TString& list )
    }
 }
 
-#if 0
 ////////////////////////////////////////////////////////////////////////////////
-/// Generate the actual function for the rule.
-
-Bool_t TSchemaRule::GenerateFor( TStreamerInfo *info )
+/// Generate and compile the conversion function of this rule with the
+/// interpreter's just-in-time compiler.
+///
+/// Rules coming from dictionaries already carry a compiled function; this
+/// is for rules registered at run time with only a code snippet, which
+/// would otherwise never be executed. The function source is produced by
+/// the same generator the dictionaries use (ROOT::WriteReadRuleFunc), so
+/// the snippet sees the usual 'onfile', 'newObj' and target member
+/// variables, and the member offsets are resolved once per class layout
+/// inside the generated function. The result is cached in fReadFuncPtr;
+/// only the first call does any work. Returns kTRUE when a compiled
+/// function is available.
+
+Bool_t TSchemaRule::CompileReadFunction()
 {
-   String funcname = fSourceClass + "_to_" + fTargetClass;
-   if (info) funcname += "_v" + info->GetClassVersion();
-   TString names = fSource + "_" + fTarget;
-   name.ReplaceAll(',','_');
-   name.ReplaceAll(':','_');
-   funcname += "_" + name;
+   if( fReadFuncPtr || fReadRawFuncPtr )
+      return kTRUE;
+   if( fCompiled )
+      return kFALSE;
+   fCompiled = kTRUE;
+
+   if( fCode.IsNull() || fRuleType != kReadRule )
+      return kFALSE;
 
-   String filename = funcname + ".C";
-   if (!false) {
-      filename += '+';
+   TClass *targetClass = TClass::GetClass( fTargetClass );
+   if( !targetClass ) {
+      Error( "CompileReadFunction", "Unknown target class %s for the rule of %s",
+             fTargetClass.Data(), fSourceClass.Data() );
+      return kFALSE;
    }
 
-   std::ofstream fileout(filename);
+   //---------------------------------------------------------------------------
+   // Build the attribute map and the target member type map the generator
+   // expects (the dictionaries get them from the parsed headers)
+   /////////////////////////////////////////////////////////////////////////////
 
+   SchemaRuleMap_t attr;
+   attr["targetClass"] = fTargetClass.Data();
+   attr["sourceClass"] = fSourceClass.Data();
+   attr["source"]      = fSource.Data();
+   attr["target"]      = fTarget.Data();
+   attr["code"]        = fCode.Data();
+
+   MembersTypeMap_t members;
+   TIter targets( GetTarget() );
+   TObjString *targetName;
+   while( (targetName = (TObjString*)targets()) ) {
+      TDataMember *dm = targetClass->GetDataMember( targetName->GetString() );
+      if( !dm ) {
+         Error( "CompileReadFunction", "Class %s has no data member %s targeted by the rule of %s",
+                fTargetClass.Data(), targetName->GetString().Data(), fSourceClass.Data() );
+         return kFALSE;
+      }
+      std::string dims;
+      for( Int_t d = 0; d < dm->GetArrayDim(); ++d ) {
+         dims += '[';
+         dims += std::to_string( (long long)dm->GetMaxIndex( d ) );
+         dims += ']';
+      }
+      members[ targetName->GetString().Data() ] =
+         Internal::TSchemaType( dm->GetTypeName(), dims.c_str() );
+   }
 
-      ROOT::WriteReadRawRuleFunc( *rIt, 0, mappedname, nameTypeMap, fileout );
-      ROOT::WriteReadRuleFunc( *rIt, 0, mappedname, nameTypeMap, fileout );
+   //---------------------------------------------------------------------------
+   // Generate the function source with a unique name
+   /////////////////////////////////////////////////////////////////////////////
 
-   gROOT->LoadMacro(filename);
-}
+   static std::atomic<Int_t> gRuleSerial( 0 );
+   std::string mappedName = fTargetClass.Data();
+   for( std::string::size_type c = 0; c < mappedName.size(); ++c ) {
+      if( !isalnum( mappedName[c] ) )
+         mappedName[c] = '_';
+   }
+
+   std::ostringstream func;
+   WriteReadRuleFunc( attr, gRuleSerial++, mappedName, members, func );
+
+   std::string decl = func.str();
+   // The generator declares the function static for dictionary files; here
+   // it needs external linkage so its address can be looked up afterwards.
+   std::string::size_type pos = decl.find( "static void read_" );
+   if( pos != std::string::npos )
+      decl.erase( pos, 7 );
+
+   std::string prelude = "#include \"TVirtualObject.h\"\n#include \"TClassRef.h\"\n";
+   TIter includes( GetInclude() );
+   TObjString *inc;
+   while( (inc = (TObjString*)includes()) ) {
+      prelude += "#include \"";
+      prelude += inc->GetString().Data();
+      prelude += "\"\n";
+   }
 
-#endif
+   //---------------------------------------------------------------------------
+   // Compile it and cache the entry point
+   /////////////////////////////////////////////////////////////////////////////
+
+   if( !gInterpreter->Declare( (prelude + decl).c_str() ) ) {
+      Error( "CompileReadFunction", "Failed to compile the code of the rule of %s for %s:\n%s",
+             fSourceClass.Data(), fTargetClass.Data(), fCode.Data() );
+      return kFALSE;
+   }
+
+   TString getaddr;
+   getaddr.Form( "(Long_t)(void (*)(char*,TVirtualObject*))&%s", attr["funcname"].c_str() );
+   Long_t addr = gInterpreter->Calc( getaddr );
+   if( !addr ) {
+      Error( "CompileReadFunction", "Could not find the compiled rule function %s",
+             attr["funcname"].c_str() );
+      return kFALSE;
+   }
+   fReadFuncPtr = (ReadFuncPtr_t)addr;
+   return kTRUE;
+}
@@ -68,7 +68,9 @@ clang/LLVM technology.
 #include "TListOfFunctions.h"
 #include "TListOfFunctionTemplates.h"
 #include "TProtoClass.h"
-#include "TStreamerInfo.h" // This is here to avoid to use the plugin manager
+#include "TStreamerInfo.h"
+#include "TStringInterner.h"
+#include "TTrace.h" // This is here to avoid to use the plugin manager
 #include "ThreadLocalStorage.h"
 #include "TFile.h"
 #include "TKey.h"
@@ -133,6 +135,7 @@ clang/LLVM technology.
 #endif
 #include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #ifdef __APPLE__
 #include <dlfcn.h>
@@ -1049,6 +1052,23 @@ TCling::TCling(const char *name, const char *title)
    // rootcling also uses TCling for generating the dictionary ROOT files.
    bool fromRootCling = dlsym(RTLD_DEFAULT, "usedToIdentifyRootClingByDlSym");
 
+   // Production jobs can run with autoparse disabled for the whole session
+   // by setting the Interpreter.AutoParse rootrc variable or the
+   // ROOT_AUTOPARSE environment variable to 0. Dictionary payloads are then
+   // parsed eagerly when their library is loaded (RegisterModule), so all
+   // parsing happens at a deterministic point instead of at first use; with
+   // dictionaries built with rootcling -inlineInputHeader no header files
+   // are needed at run time at all.
+   if (!fromRootCling) {
+      if (gEnv && !gEnv->GetValue("Interpreter.AutoParse", 1)) {
+         fHeaderParsingOnDemand = false;
+      }
+      const char *envAutoParse = gSystem->Getenv("ROOT_AUTOPARSE");
+      if (envAutoParse && !atoi(envAutoParse)) {
+         fHeaderParsingOnDemand = false;
+      }
+   }
+
    llvm::install_fatal_error_handler(&exceptionErrorHandler);
 
    fTemporaries = new std::vector<cling::Value>();
@@ -1076,6 +1096,15 @@ TCling::TCling(const char *name, const char *title)
       // TCling::AddIncludePath(".");
 
       std::string pchFilename = interpInclude + "/allDict.cxx.pch";
+      // A custom PCH, e.g. one extended with the user's analysis headers by
+      // TInterpreter::GeneratePCH(), can be selected with the Interpreter.PCH
+      // rootrc variable or the ROOT_PCH environment variable.
+      if (gEnv) {
+         const char *userPch = gEnv->GetValue("Interpreter.PCH", "");
+         if (userPch && userPch[0]) {
+            pchFilename = userPch;
+         }
+      }
       if (gSystem->Getenv("ROOT_PCH")) {
          pchFilename = gSystem->Getenv("ROOT_PCH");
       }
@@ -1273,6 +1302,22 @@ static bool R__InitStreamerInfoFactory()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the payload of one protoclass from a split ROOT PCM. Installed
+/// as the TProtoClass payload reader when the first split PCM is seen:
+/// the shells registered by LoadPCM call it back when a class is used.
+
+static TProtoClass *ReadProtoClassPayload(const char *pcmFileName, const char *className)
+{
+   R__InitStreamerInfoFactory();
+   TDirectory::TContext ctxt;
+   TFile pcmFile(TString::Format("%s?filetype=pcm", pcmFileName), "READ");
+   if (pcmFile.IsZombie()) return nullptr;
+   TProtoClass *proto = nullptr;
+   pcmFile.GetObject(TString::Format("__ProtoClassesSplit/%s", className), proto);
+   return proto;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Tries to load a PCM; returns true on success.
 
@@ -1337,6 +1382,37 @@ bool TCling::LoadPCM(TString pcmFileName,
          return kTRUE;
       }
 
+      // Split layout: one key per protoclass. Register lazy shells so
+      // that only the payloads of the classes actually used are ever
+      // deserialized from the PCM.
+      if (TDirectory *splitDir = pcmFile->GetDirectory("__ProtoClassesSplit")) {
+         if (gDebug > 1)
+            ::Info("TCling::LoadPCM","registering lazy protoclasses for %s \n",pcmFileName.Data());
+         TProtoClass::SetPayloadReader(ReadProtoClassPayload);
+         TIter nextProtoKey(splitDir->GetListOfKeys());
+         while (TKey *protoKey = (TKey*)nextProtoKey()) {
+            TClassTable::Add(new TProtoClass(protoKey->GetName(), pcmFileName.Data()));
+         }
+         // Same update of pre-existing TClasses as in the eager branch
+         // below; the shells provide the name without any payload read.
+         nextProtoKey.Reset();
+         while (TKey *protoKey = (TKey*)nextProtoKey()) {
+            if (TClass* existingCl
+                = (TClass*)gROOT->GetListOfClasses()->FindObject(protoKey->GetName())) {
+               if (existingCl->GetState() != TClass::kHasTClassInit) {
+                  DictFuncPtr_t dict = gClassTable->GetDict(protoKey->GetName());
+                  if (!dict) {
+                     ::Error("TCling::LoadPCM", "Inconsistent TClassTable for %s",
+                             protoKey->GetName());
+                  } else {
+                     TClass *ncl = (*dict)();
+                     if (ncl) ncl->PostLoadCheck();
+                  }
+               }
+            }
+         }
+      }
+
       TObjArray *protoClasses;
       if (gDebug > 1)
             ::Info("TCling::LoadPCM","reading protoclasses for %s \n",pcmFileName.Data());
@@ -3922,6 +3998,36 @@ Int_t TCling::GenerateDictionary(const char* classes, const char* includes /* =
       std::vector<std::string>(), std::vector<std::string>());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate a precompiled header containing, on top of the content of the
+/// ROOT PCH, the headers listed in the second argument (in a semi-colon
+/// separated list). 'options' may contain additional compiler flags (e.g.
+/// -I or -D directives) needed to parse them.
+/// For example:
+/// ~~~ {.cpp}
+///    gInterpreter->GeneratePCH("myAnalysis.pch","MyEvent.h;MyTracks.h","-I$HOME/analysis/include");
+/// ~~~
+/// The generated file can be used instead of the default PCH by pointing
+/// the Interpreter.PCH rootrc variable or the ROOT_PCH environment variable
+/// to it: subsequent sessions then deserialize the declarations of the user
+/// headers lazily, instead of reparsing the headers at startup.
+/// Returns 0 on success (the exit code of the underlying rootcling call).
+
+Int_t TCling::GeneratePCH(const char* pchFileName, const char* headers, const char* options /* = "" */)
+{
+   if (pchFileName == 0 || pchFileName[0] == 0 || headers == 0 || headers[0] == 0) {
+      Error("GeneratePCH", "file name and header list must be specified");
+      return 1;
+   }
+   TString headerList(headers);
+   headerList.ReplaceAll(";", " ");
+   TString cmd;
+   cmd.Form("python \"%s/dictpch/makepch.py\" \"%s\" \"%s\" %s",
+            TROOT::GetEtcDir().Data(), pchFileName,
+            options ? options : "", headerList.Data());
+   return gSystem->Exec(cmd);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to cling Decl of global/static variable that is located
 /// at the address given by addr.
@@ -5482,6 +5588,8 @@ UInt_t TCling::AutoParseImplRecurse(const char *cls, bool topLevel)
 
 Int_t TCling::AutoParse(const char *cls)
 {
+   R__TRACE(kTraceAutoParse, 0, TStringInterner::Intern(cls));
+
    R__LOCKGUARD(gInterpreterMutex);
 
    if (!fHeaderParsingOnDemand || fIsAutoParsingSuspended) {
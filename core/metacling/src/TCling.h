@@ -175,6 +175,7 @@ public: // Public Interface
    TClass *GenerateTClass(const char *classname, Bool_t emulation, Bool_t silent = kFALSE);
    TClass *GenerateTClass(ClassInfo_t *classinfo, Bool_t silent = kFALSE);
    Int_t   GenerateDictionary(const char* classes, const char* includes = 0, const char* options = 0);
+   Int_t   GeneratePCH(const char* pchFileName, const char* headers, const char* options = "");
    char*   GetPrompt() { return fPrompt; }
    const char* GetSharedLibs();
    const char* GetClassSharedLibs(const char* cls);
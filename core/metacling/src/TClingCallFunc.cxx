@@ -1441,12 +1441,178 @@ public:
    } u;
 };
 
+// Per-parameter conversion kinds compiled once from the function signature
+// by TClingCallFunc::compile_arg_convs(), so that repeated calls do not
+// have to walk the function declaration again (see TClingCallFunc::exec()).
+enum EArgConv {
+   kConvBool,
+   kConvCharU,
+   kConvUChar,
+   kConvWCharU,
+   kConvUShort,
+   kConvUInt,
+   kConvULong,
+   kConvULongLong,
+   kConvCharS,
+   kConvSChar,
+   kConvWCharS,
+   kConvShort,
+   kConvInt,
+   kConvLong,
+   kConvLongLong,
+   kConvFloat,
+   kConvDouble,
+   kConvLongDouble,
+   kConvNullPtr,
+   kConvPointer,
+   kConvEnum,
+   kConvDirect
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the conversion of each declared parameter from a cling::Value to
+/// the slot expected by the wrapper function into a table of EArgConv kinds.
+/// The table depends only on the function signature, so it is derived once;
+/// exec() then marshals the arguments through it without inspecting the
+/// declaration again on every call. A signature with a parameter type that
+/// has no compiled conversion is flagged and keeps using the generic path.
+
+void TClingCallFunc::compile_arg_convs()
+{
+   R__LOCKGUARD(gInterpreterMutex);
+
+   if (fArgConvStatus) {
+      return;
+   }
+
+   const FunctionDecl *FD = GetDecl();
+   unsigned num_params = FD->getNumParams();
+
+   fArgConvs.clear();
+   fArgConvs.reserve(num_params);
+   fRequiresObject = dyn_cast<CXXMethodDecl>(FD)
+      && !(dyn_cast<CXXMethodDecl>(FD))->isStatic()
+      && !dyn_cast<CXXConstructorDecl>(FD);
+   // Make sure the cached minimum is computed while we hold the lock.
+   GetMinRequiredArguments();
+
+   fArgConvStatus = -1;
+   for (unsigned i = 0U; i < num_params; ++i) {
+      const ParmVarDecl *PVD = FD->getParamDecl(i);
+      QualType QT = PVD->getType().getCanonicalType();
+      signed char conv = -1;
+      if (const BuiltinType *BT = dyn_cast<BuiltinType>(&*QT)) {
+         switch (BT->getKind()) {
+            case BuiltinType::Bool:       conv = kConvBool;      break;
+            case BuiltinType::Char_U:     conv = kConvCharU;     break;
+            case BuiltinType::UChar:      conv = kConvUChar;     break;
+            case BuiltinType::WChar_U:    conv = kConvWCharU;    break;
+            case BuiltinType::UShort:     conv = kConvUShort;    break;
+            case BuiltinType::UInt:       conv = kConvUInt;      break;
+            case BuiltinType::ULong:      conv = kConvULong;     break;
+            case BuiltinType::ULongLong:  conv = kConvULongLong; break;
+            case BuiltinType::Char_S:     conv = kConvCharS;     break;
+            case BuiltinType::SChar:      conv = kConvSChar;     break;
+            case BuiltinType::WChar_S:    conv = kConvWCharS;    break;
+            case BuiltinType::Short:      conv = kConvShort;     break;
+            case BuiltinType::Int:        conv = kConvInt;       break;
+            case BuiltinType::Long:       conv = kConvLong;      break;
+            case BuiltinType::LongLong:   conv = kConvLongLong;  break;
+            case BuiltinType::Float:      conv = kConvFloat;     break;
+            case BuiltinType::Double:     conv = kConvDouble;    break;
+            case BuiltinType::LongDouble: conv = kConvLongDouble; break;
+            case BuiltinType::NullPtr:    conv = kConvNullPtr;   break;
+            default:
+               // Void, Char16, Char32, Int128, UInt128, Half, ... are
+               // handled (or diagnosed) by the generic path only.
+               break;
+         }
+      } else if (QT->isReferenceType() || QT->isRecordType()) {
+         conv = kConvDirect;
+      } else if (QT->isPointerType() || QT->isArrayType() ||
+                 QT->isMemberPointerType()) {
+         conv = kConvPointer;
+      } else if (dyn_cast<EnumType>(&*QT)) {
+         conv = kConvEnum;
+      }
+      if (conv == -1) {
+         // Unsupported parameter type: keep using the generic path.
+         return;
+      }
+      fArgConvs.push_back(conv);
+   }
+   fArgConvStatus = 1;
+}
+
 void TClingCallFunc::exec(void *address, void *ret)
 {
    SmallVector<ValHolder, 8> vh_ary;
    SmallVector<void *, 8> vp_ary;
 
    unsigned num_args = fArgVals.size();
+
+   if (!fArgConvStatus) {
+      compile_arg_convs();
+   }
+   if (fArgConvStatus == 1 && num_args <= fArgConvs.size()) {
+      // Fast path: marshal the arguments through the conversion table
+      // compiled from the signature, without walking the declaration.
+      if (num_args < GetMinRequiredArguments()) {
+         ::Error("TClingCallFunc::exec",
+               "Not enough arguments provided (%d instead of the minimum %d)",
+               num_args, (int)GetMinRequiredArguments());
+         return;
+      }
+      if (address == 0 && fRequiresObject) {
+         ::Error("TClingCallFunc::exec",
+               "The method is called without an object.");
+         return;
+      }
+      vh_ary.reserve(num_args);
+      vp_ary.reserve(num_args);
+      {
+         // The conversions still read the types of the stored values.
+         R__LOCKGUARD(gInterpreterMutex);
+         for (unsigned i = 0U; i < num_args; ++i) {
+            ValHolder vh;
+            switch (fArgConvs[i]) {
+               case kConvBool:      vh.u.b = (bool) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvCharU:     vh.u.c = (char) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvUChar:     vh.u.uc = (unsigned char) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvWCharU:    vh.u.wc = (wchar_t) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvUShort:    vh.u.us = (unsigned short) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvUInt:      vh.u.ui = (unsigned int) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvULong:     vh.u.ul = (unsigned long) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvULongLong: vh.u.ull = (unsigned long long) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvCharS:     vh.u.c = (char) sv_to_long_long(fArgVals[i]); break;
+               case kConvSChar:     vh.u.sc = (signed char) sv_to_long_long(fArgVals[i]); break;
+               case kConvWCharS:    vh.u.wc = (wchar_t) sv_to_long_long(fArgVals[i]); break;
+               case kConvShort:     vh.u.s = (short) sv_to_long_long(fArgVals[i]); break;
+               case kConvInt:       vh.u.i = (int) sv_to_long_long(fArgVals[i]); break;
+               case kConvLong:      vh.u.l = (long) sv_to_long_long(fArgVals[i]); break;
+               case kConvLongLong:  vh.u.ll = (long long) sv_to_long_long(fArgVals[i]); break;
+               case kConvFloat:     vh.u.flt = sv_to<float>(fArgVals[i]); break;
+               case kConvDouble:    vh.u.dbl = sv_to<double>(fArgVals[i]); break;
+               case kConvLongDouble: vh.u.ldbl = sv_to<long double>(fArgVals[i]); break;
+               case kConvNullPtr:   vh.u.vp = fArgVals[i].getPtr(); break;
+               case kConvPointer:   vh.u.vp = (void *) sv_to_ulong_long(fArgVals[i]); break;
+               case kConvEnum:      vh.u.i = (int) sv_to_long_long(fArgVals[i]); break;
+               case kConvDirect:
+                  // Reference, or object passed by value: the argument is
+                  // already a pointer to the right storage.
+                  vp_ary.push_back((void *) sv_to_ulong_long(fArgVals[i]));
+                  continue;
+            }
+            vh_ary.push_back(vh);
+            vp_ary.push_back(&vh_ary.back());
+         }
+      }
+      (*fWrapper)(address, (int)num_args, (void **)vp_ary.data(), ret);
+      return;
+   }
+
+   // Generic path; also used when more arguments than declared parameters
+   // are passed (see IgnoreExtraArgs()).
    {
       R__LOCKGUARD(gInterpreterMutex);
 
@@ -2161,6 +2327,8 @@ void TClingCallFunc::Init()
    fWrapper = 0;
    fDecl = nullptr;
    fMinRequiredArguments = -1;
+   fArgConvs.clear();
+   fArgConvStatus = 0;
    ResetArg();
 }
 
@@ -71,6 +71,16 @@ private:
    tcling_callfunc_Wrapper_t fWrapper;
    /// Stored function arguments, we own.
    mutable llvm::SmallVector<cling::Value, 8> fArgVals;
+   /// Per-parameter argument conversions, compiled once from the function
+   /// signature (see EArgConv in the source file); only valid when
+   /// fArgConvStatus == 1.
+   llvm::SmallVector<signed char, 8> fArgConvs;
+   /// State of fArgConvs: 0 not yet compiled, 1 usable, -1 the signature
+   /// contains a parameter type the compiled conversions do not support.
+   int fArgConvStatus = 0;
+   /// True if the function is a non-static member function, i.e. needs an
+   /// object address; only valid when fArgConvStatus == 1.
+   bool fRequiresObject = false;
    /// If true, do not limit number of function arguments to declared number.
    bool fIgnoreExtraArgs : 1;
    bool fReturnIsRecordType : 1;
@@ -115,6 +125,7 @@ private:
    // Implemented in source file.
    template <typename T>
    void execWithULL(void* address, cling::Value* val);
+   void compile_arg_convs();
    void exec(void* address, void* ret);
    void exec_with_valref_return(void* address,
                                 cling::Value* ret);
@@ -155,6 +166,7 @@ public:
 
    TClingCallFunc(const TClingCallFunc &rhs)
       : fInterp(rhs.fInterp), fNormCtxt(rhs.fNormCtxt), fWrapper(rhs.fWrapper), fArgVals(rhs.fArgVals),
+        fArgConvs(rhs.fArgConvs), fArgConvStatus(rhs.fArgConvStatus), fRequiresObject(rhs.fRequiresObject),
         fIgnoreExtraArgs(rhs.fIgnoreExtraArgs), fReturnIsRecordType(rhs.fReturnIsRecordType)
    {
       fMethod = new TClingMethodInfo(*rhs.fMethod);
@@ -14,12 +14,15 @@
 
 #include "TBufferFile.h"
 #include "TClass.h"
+#include "TEnv.h"
 #include "TError.h"
 #include "TSocket.h"
+#include "TSystem.h"
 #include <memory> //unique_ptr
 #include <type_traits> //enable_if
 #include <typeinfo> //typeid
 #include <utility> //pair
+#include <vector>
 
 //////////////////////////////////////////////////////////////////////////
 /// An std::pair that wraps the code and optional object contained in a message.
@@ -30,6 +33,22 @@
 /// retrieve the object from the TBufferFile.
 using MPCodeBufPair = std::pair<unsigned, std::unique_ptr<TBufferFile>>;
 
+namespace ROOT {
+namespace Internal {
+//////////////////////////////////////////////////////////////////////////
+/// Compile-time check for vectors of arithmetic types (except
+/// std::vector<bool>, which is not contiguous). Messages carrying these
+/// bypass the TBuffer class-streaming machinery, see MPSend.
+template<class T> struct IsPodVector : std::false_type {};
+template<class T> struct IsPodVector<std::vector<T>> :
+   std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> {};
+} // namespace Internal
+} // namespace ROOT
+
+// Return the per-thread reusable write buffer used by the MPSend family,
+// already reset: pooling it avoids a fresh allocation per message.
+TBufferFile &MPGetSendBuffer();
+
 
 /************ FUNCTIONS' DECLARATIONS *************/
 
@@ -38,9 +57,12 @@ using MPCodeBufPair = std::pair<unsigned, std::unique_ptr<TBufferFile>>;
 // to send a code and an object of any non-pointer type.
 int MPSend(TSocket *s, unsigned code);
 
-template<class T, typename std::enable_if<std::is_class<T>::value>::type * = nullptr>
+template < class T, typename std::enable_if < std::is_class<T>::value  &&!ROOT::Internal::IsPodVector<T>::value >::type * = nullptr >
 int MPSend(TSocket *s, unsigned code, T obj);
 
+template<class T, typename std::enable_if<ROOT::Internal::IsPodVector<T>::value>::type * = nullptr>
+int MPSend(TSocket *s, unsigned code, const T &obj);
+
 template < class T, typename std::enable_if < !std::is_class<T>::value  &&!std::is_pointer<T>::value >::type * = nullptr >
 int MPSend(TSocket *s, unsigned code, T obj);
 
@@ -52,9 +74,24 @@ int MPSend(TSocket *s, unsigned code, T obj);
 
 MPCodeBufPair MPRecv(TSocket *s);
 
+// Shared memory variant of the result exchange: the object is written
+// into a named POSIX shared memory segment (TSharedMemFile) and only the
+// segment name travels over the socket, so the receiver deserializes
+// directly from the mapped pages instead of going through a
+// serialize-send-deserialize round trip. Enabled per job with the
+// MultiProc.SharedMemory resource (rootrc). Unsupported on Windows, in
+// which case MPSendShm returns -1 and the caller should fall back to a
+// plain MPSend.
+int MPSendShm(TSocket *s, unsigned code, const TObject *obj, const char *shmName);
+TObject *MPReadShm(TBufferFile *msgBuf);
+
 
 //this version reads classes from the message
-template<class T, typename std::enable_if<std::is_class<T>::value>::type * = nullptr>
+template < class T, typename std::enable_if < std::is_class<T>::value  &&!ROOT::Internal::IsPodVector<T>::value >::type * = nullptr >
+T ReadBuffer(TBufferFile *buf);
+
+//this version reads vectors of arithmetic types sent through the fast path
+template<class T, typename std::enable_if<ROOT::Internal::IsPodVector<T>::value>::type * = nullptr>
 T ReadBuffer(TBufferFile *buf);
 
 //this version reads built-in types from the message
@@ -69,6 +106,21 @@ T ReadBuffer(TBufferFile *buf);
 template < class T, typename std::enable_if < std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value >::type * = nullptr >
 T ReadBuffer(TBufferFile *buf);
 
+//send a result object, through shared memory when the result is a TObject*
+//and the MultiProc.SharedMemory resource is set (see MPSendShm)
+template < class T, typename std::enable_if < std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value >::type * = nullptr >
+int MPSendResult(TSocket *s, unsigned code, unsigned shmCode, T obj);
+
+template < class T, typename std::enable_if < !(std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value) >::type * = nullptr >
+int MPSendResult(TSocket *s, unsigned code, unsigned shmCode, T obj);
+
+//read a result sent with code shmCode by MPSendResult (see MPReadShm)
+template < class T, typename std::enable_if < std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value >::type * = nullptr >
+T ReadShmResult(TBufferFile *buf);
+
+template < class T, typename std::enable_if < !(std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value) >::type * = nullptr >
+T ReadShmResult(TBufferFile *buf);
+
 
 /************ TEMPLATE FUNCTIONS' IMPLEMENTATIONS *******************/
 
@@ -87,7 +139,7 @@ T ReadBuffer(TBufferFile *buf);
 /// \param code the code to be sent
 /// \param obj the object to be sent
 /// \return the number of bytes sent, as per TSocket::SendRaw
-template<class T, typename std::enable_if<std::is_class<T>::value>::type *>
+template < class T, typename std::enable_if < std::is_class<T>::value  &&!ROOT::Internal::IsPodVector<T>::value >::type * >
 int MPSend(TSocket *s, unsigned code, T obj)
 {
    TClass *c = TClass::GetClass(typeid(T));
@@ -95,12 +147,37 @@ int MPSend(TSocket *s, unsigned code, T obj)
       Error("MPSend", "[E] Could not find cling definition for class %s\n", typeid(T).name());
       return -1;
    }
-   TBufferFile objBuf(TBuffer::kWrite);
-   objBuf.WriteObjectAny(&obj, c);
-   TBufferFile wBuf(TBuffer::kWrite);
+   // stream code, a placeholder for the object length and the object into
+   // the pooled buffer, then patch the length: this avoids the extra
+   // buffer and copy of the historical two-buffer implementation
+   TBufferFile &wBuf = MPGetSendBuffer();
+   wBuf.WriteUInt(code);
+   wBuf.WriteULong(0);
+   const Int_t headerLen = wBuf.Length();
+   wBuf.WriteObjectAny(&obj, c);
+   const Int_t msgLen = wBuf.Length();
+   wBuf.SetBufferOffset(sizeof(UInt_t));
+   wBuf.WriteULong(msgLen - headerLen);
+   wBuf.SetBufferOffset(msgLen);
+   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Fast path for vectors of arithmetic types: the elements are written
+/// with WriteFastArray, bypassing TClass lookup and the class-streaming
+/// machinery entirely. ReadBuffer uses the matching fast path on the
+/// receiving side.
+template<class T, typename std::enable_if<ROOT::Internal::IsPodVector<T>::value>::type *>
+int MPSend(TSocket *s, unsigned code, const T &obj)
+{
+   using elemType = typename T::value_type;
+   TBufferFile &wBuf = MPGetSendBuffer();
+   ULong_t size = sizeof(ULong_t) + obj.size()*sizeof(elemType);
    wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
+   wBuf.WriteULong(size);
+   wBuf.WriteULong(obj.size());
+   if (!obj.empty())
+      wBuf.WriteFastArray(&obj.front(), obj.size());
    return s->SendRaw(wBuf.Buffer(), wBuf.Length());
 }
 
@@ -110,7 +187,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
 template < class T, typename std::enable_if < !std::is_class<T>::value  &&!std::is_pointer<T>::value >::type * >
 int MPSend(TSocket *s, unsigned code, T obj)
 {
-   TBufferFile wBuf(TBuffer::kWrite);
+   TBufferFile &wBuf = MPGetSendBuffer();
    ULong_t size = sizeof(T);
    wBuf << code << size << obj;
    return s->SendRaw(wBuf.Buffer(), wBuf.Length());
@@ -121,7 +198,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
 template<class T, typename std::enable_if<std::is_same<const char *, T>::value>::type *>
 int MPSend(TSocket *s, unsigned code, T obj)
 {
-   TBufferFile wBuf(TBuffer::kWrite);
+   TBufferFile &wBuf = MPGetSendBuffer();
    wBuf.WriteUInt(code);
    wBuf.WriteULong(strlen(obj) + 1); //strlen does not count the trailing \0
    wBuf.WriteString(obj);
@@ -132,17 +209,19 @@ int MPSend(TSocket *s, unsigned code, T obj)
 template < class T, typename std::enable_if < std::is_pointer<T>::value && std::is_constructible<TObject *, T>::value >::type * >
 int MPSend(TSocket *s, unsigned code, T obj)
 {
-   //find out the size of the object
-   TBufferFile objBuf(TBuffer::kWrite);
-   if(obj != nullptr)
-      objBuf.WriteObjectAny(obj, obj->IsA());
-
-   //write everything together in a buffer
-   TBufferFile wBuf(TBuffer::kWrite);
+   //stream the object (if any) into the pooled buffer and patch the length
+   TBufferFile &wBuf = MPGetSendBuffer();
    wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   if(objBuf.Length())
-      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
+   wBuf.WriteULong(0);
+   const Int_t headerLen = wBuf.Length();
+   if(obj != nullptr)
+      wBuf.WriteObjectAny(obj, obj->IsA());
+   const Int_t msgLen = wBuf.Length();
+   if(msgLen != headerLen) {
+      wBuf.SetBufferOffset(sizeof(UInt_t));
+      wBuf.WriteULong(msgLen - headerLen);
+      wBuf.SetBufferOffset(msgLen);
+   }
    return s->SendRaw(wBuf.Buffer(), wBuf.Length());
 }
 
@@ -153,7 +232,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
 /// Different implementations are provided for different types of objects:
 /// classes, non-pointer built-ins and const char*. Reading pointers is
 /// not implemented (at the time of writing, sending pointers is not either).
-template<class T, typename std::enable_if<std::is_class<T>::value>::type *>
+template < class T, typename std::enable_if < std::is_class<T>::value  &&!ROOT::Internal::IsPodVector<T>::value >::type * >
 T ReadBuffer(TBufferFile *buf)
 {
    TClass *c = TClass::GetClass(typeid(T));
@@ -164,6 +243,18 @@ T ReadBuffer(TBufferFile *buf)
 }
 
 /// \cond
+//read a vector of arithmetic types written by the MPSend fast path
+template<class T, typename std::enable_if<ROOT::Internal::IsPodVector<T>::value>::type *>
+T ReadBuffer(TBufferFile *buf)
+{
+   ULong_t n;
+   buf->ReadULong(n);
+   T vec(n);
+   if (n)
+      buf->ReadFastArray(&vec.front(), n);
+   return vec;
+}
+
 template < class T, typename std::enable_if < !std::is_class<T>::value  &&!std::is_pointer<T>::value >::type * >
 T ReadBuffer(TBufferFile *buf)
 {
@@ -189,6 +280,53 @@ T ReadBuffer(TBufferFile *buf)
    using objType = typename std::remove_pointer<T>::type;
    return (T)buf->ReadObjectAny(objType::Class());
 }
+
+//////////////////////////////////////////////////////////////////////////
+/// Send a result object to the client, through a shared memory segment
+/// when possible. The TObject* version writes the object into a segment
+/// named after the worker pid and sends only the segment name with code
+/// shmCode; if shared memory is disabled (or fails) the object is
+/// streamed through the socket with code as for a plain MPSend.
+template < class T, typename std::enable_if < std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value >::type * >
+int MPSendResult(TSocket *s, unsigned code, unsigned shmCode, T obj)
+{
+   if (obj != nullptr && gEnv->GetValue("MultiProc.SharedMemory", 0)) {
+      TString shmName = TString::Format("/root-mp-%d", gSystem->GetPid());
+      int nBytes = MPSendShm(s, shmCode, obj, shmName.Data());
+      if (nBytes >= 0)
+         return nBytes;
+      //shared memory not available: fall through to the socket path
+   }
+   return MPSend(s, code, obj);
+}
+
+/// \cond
+// results that are not TObject pointers always travel through the socket
+template < class T, typename std::enable_if < !(std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value) >::type * >
+int MPSendResult(TSocket *s, unsigned code, unsigned /*shmCode*/, T obj)
+{
+   return MPSend(s, code, obj);
+}
+/// \endcond
+
+//////////////////////////////////////////////////////////////////////////
+/// Read a result that was sent through shared memory by MPSendResult.
+/// The message buffer contains only the segment name; the object is
+/// deserialized from the mapped segment, which is then unlinked.
+template < class T, typename std::enable_if < std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value >::type * >
+T ReadShmResult(TBufferFile *buf)
+{
+   return dynamic_cast<T>(MPReadShm(buf));
+}
+
+/// \cond
+// this should never be reached: only TObject pointers are sent through shared memory
+template < class T, typename std::enable_if < !(std::is_pointer<T>::value  &&std::is_constructible<TObject *, T>::value) >::type * >
+T ReadShmResult(TBufferFile *)
+{
+   Error("ReadShmResult", "[E] received a shared memory result for a non-TObject type");
+   return T();
+}
 /// \endcond
 
 #endif
@@ -203,6 +203,10 @@ void TProcessExecutor::HandlePoolCode(MPCodeBufPair &msg, TSocket *s, std::vecto
    if (code == MPCode::kFuncResult) {
       reslist.push_back(std::move(ReadBuffer<T>(msg.second.get())));
       ReplyToFuncResult(s);
+   } else if (code == MPCode::kShmFuncResult) {
+      //the result was left in a shared memory segment, see MPSendResult
+      reslist.push_back(std::move(ReadShmResult<T>(msg.second.get())));
+      ReplyToFuncResult(s);
    } else if (code == MPCode::kIdling) {
       ReplyToIdle(s);
    } else if(code == MPCode::kProcResult) {
@@ -107,7 +107,8 @@ public:
             fReducedResult = res;
          }
       } else if (code == MPCode::kSendResult) {
-         MPSend(s, MPCode::kFuncResult, fReducedResult);
+         // the final reduced result can go through shared memory, see MPSendResult
+         MPSendResult(s, MPCode::kFuncResult, MPCode::kShmFuncResult, fReducedResult);
       } else {
          reply += ": unknown code received: " + std::to_string(code);
          MPSend(s, MPCode::kError, reply.data());
@@ -150,7 +151,8 @@ public:
             fReducedResult = res;
          }
       } else if (code == MPCode::kSendResult) {
-         MPSend(s, MPCode::kFuncResult, fReducedResult);
+         // the final reduced result can go through shared memory, see MPSendResult
+         MPSendResult(s, MPCode::kFuncResult, MPCode::kShmFuncResult, fReducedResult);
       } else {
          reply += ": unknown code received: " + std::to_string(code);
          MPSend(s, MPCode::kError, reply.data());
@@ -11,6 +11,9 @@
  
 #include "MPSendRecv.h"
 #include "TBufferFile.h"
+#include "TClass.h"
+#include "TList.h"
+#include "TSharedMemFile.h"
 #include "MPCode.h"
 #include <memory> //unique_ptr
 
@@ -31,12 +34,25 @@
 /// \return the number of bytes sent, as per TSocket::SendRaw
 int MPSend(TSocket *s, unsigned code)
 {
-   TBufferFile wBuf(TBuffer::kWrite);
+   TBufferFile &wBuf = MPGetSendBuffer();
    wBuf.WriteUInt(code);
    wBuf.WriteULong(0);
    return s->SendRaw(wBuf.Buffer(), wBuf.Length());
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// Return the reusable per-thread write buffer used by the MPSend
+/// family, reset and ready for writing. Reusing one buffer avoids a
+/// fresh heap allocation and buffer growth for every message, which
+/// dominates the cost of the many small messages exchanged during
+/// result collection.
+TBufferFile &MPGetSendBuffer()
+{
+   static thread_local TBufferFile wBuf(TBuffer::kWrite, 1024*1024);
+   wBuf.Reset();
+   return wBuf;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 /// Receive message from a socket.
@@ -53,7 +69,7 @@ int MPSend(TSocket *s, unsigned code)
 /// \return ::MPCodeBufPair, i.e. an std::pair containing message code and (possibly) object
 MPCodeBufPair MPRecv(TSocket *s)
 {
-   char *rawbuf = new char[sizeof(UInt_t)];
+   char rawbuf[8];
    //receive message code
    unsigned nBytes = s->RecvRaw(rawbuf, sizeof(UInt_t));
    if (nBytes == 0) {
@@ -63,16 +79,13 @@ MPCodeBufPair MPRecv(TSocket *s)
    TBufferFile bufReader(TBuffer::kRead, sizeof(UInt_t), rawbuf, false);
    unsigned code;
    bufReader.ReadUInt(code);
-   delete [] rawbuf;
 
    //receive object size
    //ULong_t is sent as 8 bytes irrespective of the size of the type
-   rawbuf = new char[8];
    s->RecvRaw(rawbuf, 8);
    bufReader.SetBuffer(rawbuf, 8, false);
    ULong_t classBufSize;
    bufReader.ReadULong(classBufSize);
-   delete [] rawbuf;
 
    //receive object if needed
    std::unique_ptr<TBufferFile> objBuf; //defaults to nullptr
@@ -84,3 +97,56 @@ MPCodeBufPair MPRecv(TSocket *s)
 
    return std::make_pair(code, std::move(objBuf));
 }
+
+//////////////////////////////////////////////////////////////////////////
+/// Write obj into the shared memory segment shmName and send only the
+/// segment name on the socket, with the given message code. Returns the
+/// number of bytes sent on the socket, or -1 when the segment could not
+/// be created (no shared memory support, or the segment is too small for
+/// the object); in that case nothing was sent and the caller should fall
+/// back to streaming the object with a plain MPSend.
+int MPSendShm(TSocket *s, unsigned code, const TObject *obj, const char *shmName)
+{
+   // a segment with this name may be left over from a previous (crashed) run
+   TSharedMemFile::Unlink(shmName);
+   TSharedMemFile f(shmName, "RECREATE");
+   if (f.IsZombie())
+      return -1;
+   if (f.WriteTObject(obj, "result") <= 0) {
+      f.Close();
+      TSharedMemFile::Unlink(shmName);
+      return -1;
+   }
+   f.Close();
+   return MPSend(s, code, (const char *)f.GetShmName());
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Counterpart of MPSendShm: read the segment name from the message
+/// buffer, deserialize the object directly from the mapped segment and
+/// unlink the segment. Returns the object (owned by the caller) or
+/// nullptr on failure.
+TObject *MPReadShm(TBufferFile *msgBuf)
+{
+   const char *shmName = ReadBuffer<const char *>(msgBuf);
+   TObject *obj = nullptr;
+   {
+      TSharedMemFile f(shmName, "READ");
+      if (!f.IsZombie()) {
+         obj = f.Get("result");
+         if (obj) {
+            // detach the object from the file so it survives the close;
+            // histograms, trees etc. register themselves in the file
+            // directory when read back
+            if (obj->IsA()->GetMethodWithPrototype("SetDirectory", "TDirectory*")) {
+               Int_t error = 0;
+               obj->Execute("SetDirectory", "0", &error);
+            }
+            f.GetList()->Remove(obj);
+         }
+      }
+   }
+   TSharedMemFile::Unlink(shmName);
+   delete [] shmName;
+   return obj;
+}
@@ -0,0 +1,62 @@
+// @(#)root/new:$Id$
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TAllocSampler
+#define ROOT_TAllocSampler
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TAllocSampler                                                        //
+//                                                                      //
+// Sampling allocation profiler for the custom operators new/delete    //
+// in libNew. Unlike the Root.ObjectStat/TObjectTable machinery, which //
+// counts every TObject and slows the job down considerably, the       //
+// sampler looks at roughly one allocation per fgPeriod bytes          //
+// allocated, records a short stack of call sites for it and           //
+// aggregates size/count per unique stack in fixed size tables. The    //
+// cost is a thread local counter decrement on the fast path, cheap    //
+// enough to stay enabled in long running production servers.          //
+//                                                                      //
+// Enable by linking with libNew and either calling                     //
+// TAllocSampler::Enable() or setting the environment variable          //
+// ROOT_ALLOC_SAMPLER_PERIOD to the sampling period in bytes before     //
+// starting the job. TAllocSampler::Print() reports the call sites      //
+// with the largest sampled live heap at any moment during the run.     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <stdlib.h>
+
+class TAllocSampler {
+
+private:
+   static Bool_t    fgEnabled;    //true when sampling is active
+   static Long_t    fgPeriod;     //mean number of allocated bytes between two samples
+
+   TAllocSampler() { }
+
+public:
+   static void      Enable(Long_t period = 524288);
+   static void      Disable();
+   static Bool_t    IsEnabled() { return fgEnabled; }
+   static Long_t    GetPeriod() { return fgPeriod; }
+
+   static void      Sample(size_t size, void *p);
+   static void      Remove(void *p);
+
+   static ULong64_t GetSampledBytes();
+   static ULong64_t GetSampledLiveBytes();
+   static void      Print(Int_t nsites = 25);
+};
+
+#endif
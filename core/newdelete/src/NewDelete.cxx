@@ -61,6 +61,7 @@
 #include <errno.h>
 
 #include "MemCheck.h"
+#include "TAllocSampler.h"
 #include "TObjectTable.h"
 #include "TError.h"
 #include "TStorage.h" // for ROOT::Internal::gFreeIfTMapFile
@@ -154,15 +155,17 @@ static TReAllocInit gReallocInit;
 #ifdef MEM_STAT
 
 #define EnterStat(s, p) \
-   TStorage::EnterStat(s, p)
+   { TStorage::EnterStat(s, p); TAllocSampler::Sample(s, p); }
 #define RemoveStat(p) \
-   TStorage::RemoveStat(p)
+   { TStorage::RemoveStat(p); TAllocSampler::Remove(p); }
 
 #else
 
 #define EnterStat(s, p) \
-   TStorage::SetMaxBlockSize(TMath::Max(TStorage::GetMaxBlockSize(), s))
-#define RemoveStat(p)
+   { TStorage::SetMaxBlockSize(TMath::Max(TStorage::GetMaxBlockSize(), s)); \
+     TAllocSampler::Sample(s, p); }
+#define RemoveStat(p) \
+   TAllocSampler::Remove(p)
 
 #endif
 
@@ -0,0 +1,273 @@
+// @(#)root/new:$Id$
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TAllocSampler                                                        //
+//                                                                      //
+// Sampling allocation profiler, see the class description in the      //
+// header. The implementation must be callable from inside operator    //
+// new/delete, therefore it allocates no memory itself: all state is   //
+// kept in fixed size static tables protected by a spin lock, and the  //
+// fast path is a single thread local countdown.                       //
+//                                                                      //
+// Every sampled allocation stands for about fgPeriod allocated bytes, //
+// so the per call site numbers are a uniform byte sample of the heap: //
+// the ratios between call sites are unbiased even though the absolute //
+// numbers are scaled down by the sampling.                            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TAllocSampler.h"
+
+#include "ThreadLocalStorage.h"
+
+#include <atomic>
+#include <string.h>
+#include <stdio.h>
+
+#if defined(R__LINUX) || defined(R__MACOSX)
+#include <execinfo.h>
+#define R__ALLOCSAMPLER_BACKTRACE
+#endif
+
+Bool_t TAllocSampler::fgEnabled = kFALSE;
+Long_t TAllocSampler::fgPeriod  = 524288;
+
+namespace {
+
+   const Int_t kMaxFrames = 8;     // stack depth kept per call site
+   const Int_t kSkipFrames = 2;    // skip Sample() and operator new itself
+   const Int_t kMaxSites  = 1024;  // call site table size, power of two
+   const Int_t kMaxLive   = 16384; // sampled live pointer table, power of two
+   const Int_t kMaxProbes = 8;     // linear probes before giving up a slot
+
+   struct SiteStat_t {
+      void      *fPC[kMaxFrames]; // call stack, fPC[0] innermost
+      Int_t      fDepth;          // number of valid frames
+      ULong64_t  fAllocBytes;     // sampled bytes allocated here
+      ULong64_t  fFreedBytes;     // sampled bytes already freed
+      ULong64_t  fAllocCount;     // number of sampled allocations
+      ULong64_t  fFreedCount;     // how many of them were freed
+   };
+
+   struct LivePtr_t {
+      void      *fPtr;            // sampled pointer still alive
+      size_t     fSize;           // its allocation size
+      Int_t      fSite;           // index in the call site table
+   };
+
+   SiteStat_t gSites[kMaxSites];
+   LivePtr_t  gLive[kMaxLive];
+   std::atomic_flag gLock = ATOMIC_FLAG_INIT;
+   std::atomic<ULong64_t> gSampledBytes(0);
+   std::atomic<ULong64_t> gSampledFreed(0);
+   Bool_t gEnvChecked = kFALSE;
+
+   ULong64_t HashStack(void *const *pc, Int_t depth)
+   {
+      ULong64_t h = 1125899906842597ULL;
+      for (Int_t i = 0; i < depth; i++)
+         h = 31*h + (ULong64_t)(size_t)pc[i];
+      return h;
+   }
+
+   ULong64_t HashPtr(void *p)
+   {
+      ULong64_t h = (ULong64_t)(size_t)p;
+      return (h >> 4) * 2654435761ULL;
+   }
+
+   // find or create the call site entry for this stack, -1 if the table is full
+   Int_t FindSite(void *const *pc, Int_t depth)
+   {
+      Int_t slot = (Int_t)(HashStack(pc, depth) & (kMaxSites-1));
+      for (Int_t probe = 0; probe < kMaxProbes; probe++) {
+         SiteStat_t &s = gSites[(slot+probe) & (kMaxSites-1)];
+         if (!s.fDepth) {
+            s.fDepth = depth;
+            memcpy(s.fPC, pc, depth*sizeof(void*));
+            return (slot+probe) & (kMaxSites-1);
+         }
+         if (s.fDepth == depth && !memcmp(s.fPC, pc, depth*sizeof(void*)))
+            return (slot+probe) & (kMaxSites-1);
+      }
+      return -1;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start sampling, looking at about one allocation per period allocated
+/// bytes. The default period of 512 KB keeps the overhead well below a
+/// percent for typical allocation rates; lower it for finer resolution.
+/// Called automatically at the first allocation when the environment
+/// variable ROOT_ALLOC_SAMPLER_PERIOD is set.
+
+void TAllocSampler::Enable(Long_t period)
+{
+   if (period > 0) fgPeriod = period;
+   fgEnabled = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop sampling. The tables are kept, so Print() still reports
+/// everything sampled up to this point.
+
+void TAllocSampler::Disable()
+{
+   fgEnabled = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called from the custom operator new for every allocation.
+/// Fast path: decrement a thread local byte countdown and return.
+/// Once the countdown expires capture the call stack and record the
+/// allocation in the site and live pointer tables.
+
+void TAllocSampler::Sample(size_t size, void *p)
+{
+   if (!gEnvChecked) {
+      gEnvChecked = kTRUE;
+      const char *env = getenv("ROOT_ALLOC_SAMPLER_PERIOD");
+      if (env && atol(env) > 0) Enable(atol(env));
+   }
+   if (!fgEnabled) return;
+
+   TTHREAD_TLS(Long_t) tlsLeft = 0;
+   TTHREAD_TLS(Bool_t) tlsInside = kFALSE;
+   if (tlsInside) return;   // allocation made by the sampler itself
+   tlsLeft -= (Long_t)size;
+   if (tlsLeft > 0) return;
+   tlsLeft = fgPeriod;
+
+   tlsInside = kTRUE;
+   void *pc[kMaxFrames+kSkipFrames];
+   Int_t depth = 0;
+#ifdef R__ALLOCSAMPLER_BACKTRACE
+   depth = backtrace(pc, kMaxFrames+kSkipFrames);
+#endif
+   void **frames = pc;
+   if (depth > kSkipFrames) {
+      frames = pc + kSkipFrames;
+      depth -= kSkipFrames;
+   }
+   if (depth <= 0) {
+      pc[0]  = 0;
+      frames = pc;
+      depth  = 1;
+   }
+
+   while (gLock.test_and_set(std::memory_order_acquire)) { }
+   Int_t site = FindSite(frames, depth);
+   if (site >= 0) {
+      gSites[site].fAllocBytes += size;
+      gSites[site].fAllocCount++;
+      Int_t slot = (Int_t)(HashPtr(p) & (kMaxLive-1));
+      for (Int_t probe = 0; probe < kMaxProbes; probe++) {
+         LivePtr_t &l = gLive[(slot+probe) & (kMaxLive-1)];
+         if (!l.fPtr) {
+            l.fPtr  = p;
+            l.fSize = size;
+            l.fSite = site;
+            break;
+         }
+      }
+   }
+   gLock.clear(std::memory_order_release);
+   gSampledBytes += size;
+   tlsInside = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called from the custom operator delete for every deallocation.
+/// Only pointers that were sampled at allocation time are looked up;
+/// everything else costs a few probes in the live pointer table.
+
+void TAllocSampler::Remove(void *p)
+{
+   if (!p) return;
+   if (!gSampledBytes.load()) return;   // nothing was ever sampled
+
+   Int_t slot = (Int_t)(HashPtr(p) & (kMaxLive-1));
+   for (Int_t probe = 0; probe < kMaxProbes; probe++) {
+      LivePtr_t &l = gLive[(slot+probe) & (kMaxLive-1)];
+      if (l.fPtr == p) {
+         while (gLock.test_and_set(std::memory_order_acquire)) { }
+         if (l.fPtr == p) {
+            gSites[l.fSite].fFreedBytes += l.fSize;
+            gSites[l.fSite].fFreedCount++;
+            gSampledFreed += l.fSize;
+            l.fPtr  = 0;
+            l.fSize = 0;
+         }
+         gLock.clear(std::memory_order_release);
+         return;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Total number of bytes in the sampled allocations so far.
+
+ULong64_t TAllocSampler::GetSampledBytes()
+{
+   return gSampledBytes.load();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sampled bytes allocated and not yet freed. A steadily growing value
+/// while the job is in a steady state points at a leak; Print() shows
+/// which call sites it comes from.
+
+ULong64_t TAllocSampler::GetSampledLiveBytes()
+{
+   return gSampledBytes.load() - gSampledFreed.load();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the nsites call sites with the most sampled live bytes.
+/// All numbers are sampled values: multiply mentally by the ratio of the
+/// real allocation rate to the sampling period for absolute estimates;
+/// the ranking between call sites is unbiased.
+
+void TAllocSampler::Print(Int_t nsites)
+{
+   printf("TAllocSampler: period=%ld bytes, sampled total=%llu bytes, sampled live=%llu bytes\n",
+          fgPeriod, GetSampledBytes(), GetSampledLiveBytes());
+
+   // rank on a scratch copy of the live bytes so the stats stay intact
+   static ULong64_t live[kMaxSites];
+   for (Int_t i = 0; i < kMaxSites; i++)
+      live[i] = gSites[i].fDepth ? gSites[i].fAllocBytes - gSites[i].fFreedBytes : 0;
+
+   for (Int_t n = 0; n < nsites; n++) {
+      Int_t best = -1;
+      ULong64_t bestLive = 0;
+      for (Int_t i = 0; i < kMaxSites; i++) {
+         if (live[i] > bestLive) { best = i; bestLive = live[i]; }
+      }
+      if (best < 0) break;
+      live[best] = 0;
+      SiteStat_t &s = gSites[best];
+      printf(" site %2d: live %10llu bytes in %llu blocks (allocated %llu bytes, %llu blocks)\n",
+             n+1, bestLive, s.fAllocCount - s.fFreedCount,
+             s.fAllocBytes, s.fAllocCount);
+#ifdef R__ALLOCSAMPLER_BACKTRACE
+      char **symbols = backtrace_symbols(s.fPC, s.fDepth);
+      for (Int_t f = 0; f < s.fDepth; f++)
+         printf("          %s\n", symbols ? symbols[f] : "?");
+      free(symbols);
+#else
+      for (Int_t f = 0; f < s.fDepth; f++)
+         printf("          %p\n", s.fPC[f]);
+#endif
+   }
+}
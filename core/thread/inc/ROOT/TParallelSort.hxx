@@ -0,0 +1,144 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2006, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TParallelSort
+#define ROOT_TParallelSort
+
+#include "RConfigure.h"
+
+// exclude in case ROOT does not have IMT support
+#ifndef R__USE_IMT
+// No need to error out for dictionaries.
+# if !defined(__ROOTCLING__) && !defined(G__DICTIONARY)
+#  error "Cannot use ROOT/TParallelSort.hxx without defining R__USE_IMT."
+# endif
+#else
+
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace ROOT {
+
+namespace Internal {
+
+/// Below this size the parallel sorts fall back to std::sort: for small
+/// ranges the scheduling overhead dominates the sorting work.
+constexpr unsigned long long kParallelSortMinSize = 131072ULL;
+
+} // namespace Internal
+
+//////////////////////////////////////////////////////////////////////////
+/// Sort the range [first, last) in parallel according to comp, using the
+/// implicit multi-threading pool.
+///
+/// The range is split in one contiguous chunk per pool thread, the chunks
+/// are std::sort-ed in parallel and then combined with rounds of pairwise
+/// std::inplace_merge, the first rounds again running in parallel. Like
+/// std::sort this is not a stable sort: the relative order of equivalent
+/// elements is unspecified, so comparators that want a reproducible result
+/// must break ties themselves. If implicit multi-threading is not enabled
+/// (see ROOT::EnableImplicitMT) or the range is small the call degrades to
+/// a plain std::sort.
+///
+/// \param first iterator to the first element of the range to sort
+/// \param last iterator past the last element of the range to sort
+/// \param comp strict weak ordering, as for std::sort
+template <class RandomIt, class Compare>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp)
+{
+   const unsigned long long n = last - first;
+   if (!ROOT::IsImplicitMTEnabled() || n < 2 * Internal::kParallelSortMinSize) {
+      std::sort(first, last, comp);
+      return;
+   }
+
+   // one chunk per pool thread, rounded up to a power of two so that the
+   // merge rounds below pair chunks evenly; capped so that every chunk
+   // keeps at least kParallelSortMinSize elements
+   unsigned nChunks = 1;
+   while (2 * nChunks <= ROOT::GetImplicitMTPoolSize() && n / (2 * nChunks) >= Internal::kParallelSortMinSize)
+      nChunks *= 2;
+   if (nChunks == 1) {
+      std::sort(first, last, comp);
+      return;
+   }
+
+   std::vector<RandomIt> bounds(nChunks + 1);
+   for (unsigned c = 0; c <= nChunks; ++c)
+      bounds[c] = first + n * c / nChunks;
+   bounds[nChunks] = last;
+
+   ROOT::TThreadExecutor pool;
+   auto sortChunk = [&](unsigned c) {
+      std::sort(bounds[c], bounds[c + 1], comp);
+      return c;
+   };
+   pool.Map(sortChunk, ROOT::TSeqU(nChunks));
+
+   // pairwise merge rounds: after round r the chunks of width 2^(r+1) are
+   // sorted; the merges of one round are independent and run in parallel
+   for (unsigned width = 1; width < nChunks; width *= 2) {
+      auto mergePair = [&](unsigned m) {
+         const unsigned lo = 2 * width * m;
+         std::inplace_merge(bounds[lo], bounds[lo + width], bounds[lo + 2 * width], comp);
+         return m;
+      };
+      pool.Map(mergePair, ROOT::TSeqU(nChunks / (2 * width)));
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Sort the range [first, last) in parallel with operator<.
+template <class RandomIt>
+void ParallelSort(RandomIt first, RandomIt last)
+{
+   ParallelSort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Parallel counterpart of TMath::Sort: fill index such that a[index[0]],
+/// a[index[1]], ... is the array a in decreasing (down=kTRUE, the default)
+/// or increasing (down=kFALSE) order.
+///
+/// The array a is not modified. Sorting is delegated to ROOT::ParallelSort,
+/// so the call degrades to the serial index sort when implicit
+/// multi-threading is not enabled or n is small. Ties are broken by the
+/// original element position, so unlike TMath::Sort the resulting index
+/// permutation is reproducible.
+///
+/// \param n number of elements of a to sort
+/// \param a array of values to sort; left untouched
+/// \param index output array of n indices into a
+/// \param down sort in decreasing (kTRUE) or increasing (kFALSE) order
+template <typename Element, typename Index>
+void ParallelSortIndex(Index n, const Element *a, Index *index, Bool_t down = kTRUE)
+{
+   for (Index i = 0; i < n; i++)
+      index[i] = i;
+   if (down)
+      ParallelSort(index, index + n, [a](Index i1, Index i2) {
+         return a[i1] != a[i2] ? a[i1] > a[i2] : i1 < i2;
+      });
+   else
+      ParallelSort(index, index + n, [a](Index i1, Index i2) {
+         return a[i1] != a[i2] ? a[i1] < a[i2] : i1 < i2;
+      });
+}
+
+} // namespace ROOT
+
+#endif   // R__USE_IMT
+#endif   // ROOT_TParallelSort
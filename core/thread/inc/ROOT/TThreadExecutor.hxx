@@ -29,17 +29,48 @@
 #include <memory>
 #include <numeric>
 
+namespace tbb {
+   class affinity_partitioner;
+}
+
 namespace ROOT {
 
    class TThreadExecutor: public TExecutor<TThreadExecutor> {
    public:
+      ////////////////////////////////////////////////////////////////////////
+      /// How the iteration space of a Map call is split over the threads:
+      /// * kAuto: adaptive splitting, good default for uniform work (tbb auto partitioner)
+      /// * kStatic: one contiguous chunk per thread, lowest scheduling overhead
+      /// * kAffinity: like kAuto, but successive Map calls on this executor replay
+      ///   the same iteration-to-thread assignment, keeping data hot in the caches
+      /// * kGuided: many small equal chunks balanced by work stealing, for
+      ///   iteration spaces with a skewed work distribution
+      enum class EPartition : unsigned char { kAuto, kStatic, kAffinity, kGuided };
+
       explicit TThreadExecutor();
 
       explicit TThreadExecutor(UInt_t nThreads);
 
+      ~TThreadExecutor();
+
       TThreadExecutor(TThreadExecutor &) = delete;
       TThreadExecutor &operator=(TThreadExecutor &) = delete;
 
+      void SetPartition(EPartition partition) { fPartition = partition; }
+      EPartition GetPartition() const { return fPartition; }
+
+      /// By default a Map call issued from inside another Map (e.g. an
+      /// ImplicitMT inner loop running within an outer task framework) is
+      /// executed sequentially in the calling thread, so nesting composes
+      /// without oversubscribing the machine. Nested parallelism can be
+      /// turned back on globally with this switch.
+      static void EnableNestedParallelism(Bool_t enable = kTRUE);
+      static Bool_t NestedParallelismEnabled();
+
+      /// Pin the pool threads to cpus (round robin over the logical cpus)
+      /// so the scheduler cannot migrate them across cores or NUMA nodes.
+      static void SetThreadAffinity(Bool_t pin = kTRUE);
+
       template<class F, class Cond = noReferenceCond<F>>
       auto Map(F func, unsigned nTimes) -> std::vector<typename std::result_of<F()>::type>;
       template<class F, class INTEGER, class Cond = noReferenceCond<F, INTEGER>>
@@ -79,12 +110,15 @@ namespace ROOT {
 
    private:
       void   ParallelFor(unsigned start, unsigned end, unsigned step, const std::function<void(unsigned int i)> &f);
+      void   ParallelForImpl(unsigned nsteps, const std::function<void(unsigned int k)> &chunk);
       double ParallelReduce(const std::vector<double> &objs, const std::function<double(double a, double b)> &redfunc);
       float  ParallelReduce(const std::vector<float> &objs, const std::function<float(float a, float b)> &redfunc);
       template<class T, class R>
       auto SeqReduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
 
       std::shared_ptr<ROOT::Internal::TPoolManager> fSched = nullptr;
+      EPartition fPartition = EPartition::kAuto;
+      std::unique_ptr<tbb::affinity_partitioner> fAffinityPartitioner; ///< lives across Map calls, see kAffinity
    };
 
    /************ TEMPLATE METHODS IMPLEMENTATION ******************/
@@ -21,7 +21,9 @@
 #include "TError.h"
 #include "TThread.h"
 #include "ROOT/TPoolManager.hxx"
+#include "ROOT/TThreadExecutor.hxx"
 #include <atomic>
+#include <stdlib.h>
 
 static std::shared_ptr<ROOT::Internal::TPoolManager> &R__GetPoolManagerMT()
 {
@@ -55,6 +57,12 @@ extern "C" void ROOT_TImplicitMT_EnableImplicitMT(UInt_t numthreads)
       }
       R__GetPoolManagerMT() = ROOT::Internal::GetPoolManager(numthreads);
       GetImplicitMTFlag() = true;
+      // Production jobs on NUMA machines can ask for the pool threads to be
+      // pinned and partitioned over the sockets (see
+      // TThreadExecutor::SetThreadAffinity).
+      const char *affinity = getenv("ROOT_THREAD_AFFINITY");
+      if (affinity && atoi(affinity))
+         ROOT::TThreadExecutor::SetThreadAffinity();
    } else {
       ::Warning("ROOT_TImplicitMT_EnableImplicitMT", "Implicit multi-threading is already enabled");
    }
@@ -1,6 +1,16 @@
 #include "ROOT/TThreadExecutor.hxx"
 #include "tbb/tbb.h"
 
+#include <atomic>
+#include <thread>
+
+#if defined(R__LINUX)
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <vector>
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 ///
 /// \class ROOT::TThreadExecutor
@@ -65,8 +75,109 @@
 /// root[] ROOT::TThreadExecutor pool; auto hist = pool.MapReduce(CreateAndFillHists, 10, PoolUtils::ReduceObjects);
 /// ~~~
 ///
+/// ###Partitioning and nesting
+/// SetPartition selects how the iteration space is split over the pool
+/// threads (see TThreadExecutor::EPartition); the default adaptive
+/// splitting is right for uniform work, kAffinity pays off when the same
+/// Map is replayed over the same data and kGuided when the work per
+/// element is very uneven. A Map call issued from inside another Map runs
+/// sequentially in the calling thread unless nested parallelism is
+/// explicitly re-enabled with EnableNestedParallelism, so inner parallel
+/// loops (e.g. the ImplicitMT helpers) compose with an outer task
+/// framework instead of oversubscribing the machine. SetThreadAffinity
+/// pins the pool threads to logical cpus so they are not migrated across
+/// cores or NUMA nodes; on multi-socket machines the workers are
+/// partitioned over the NUMA nodes, so buffers allocated and first
+/// touched by a worker (e.g. the TTreeCacheUnzip output chunks) stay on
+/// the socket that uses them instead of saturating the inter-socket
+/// link. Pinning can also be requested for implicit multi-threading by
+/// setting the ROOT_THREAD_AFFINITY environment variable to 1.
+///
 //////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+   // Number of parallel regions the current thread is executing in:
+   // used to detect (and by default serialize) nested parallelism.
+   thread_local unsigned gParallelDepth = 0;
+   std::atomic<bool> gNestedParallelism(false);
+
+   struct NestingRegion {
+      NestingRegion() { ++gParallelDepth; }
+      ~NestingRegion() { --gParallelDepth; }
+   };
+
+#if defined(R__LINUX)
+   // Parse a /sys cpulist file ("0-7,16-23") into the list of cpu ids.
+   // Returns false when the file cannot be read (no such node).
+   bool ReadCpuList(const char *path, std::vector<unsigned> &cpus)
+   {
+      FILE *f = fopen(path, "r");
+      if (!f) return false;
+      int lo, hi, c;
+      while (fscanf(f, "%d", &lo) == 1) {
+         hi = lo;
+         c = fgetc(f);
+         if (c == '-') {
+            if (fscanf(f, "%d", &hi) != 1) hi = lo;
+            c = fgetc(f);
+         }
+         for (int cpu = lo; cpu <= hi; cpu++)
+            cpus.push_back(cpu);
+         if (c != ',') break;
+      }
+      fclose(f);
+      return !cpus.empty();
+   }
+#endif
+
+   // Observer pinning every pool thread to a logical cpu, round robin.
+   // On machines with several NUMA nodes consecutive workers are assigned
+   // to alternating nodes, so every socket gets its share of the pool even
+   // when the pool is smaller than the machine; once pinned a thread is
+   // never migrated, hence the buffers it first touches stay on its node.
+   class PoolThreadPinner : public tbb::task_scheduler_observer {
+   public:
+      PoolThreadPinner()
+      {
+#if defined(R__LINUX)
+         char path[64];
+         for (int node = 0;; node++) {
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+            std::vector<unsigned> cpus;
+            if (!ReadCpuList(path, cpus)) break;
+            fNodeCpus.push_back(cpus);
+         }
+#endif
+         observe(true);
+      }
+      ~PoolThreadPinner() { observe(false); }
+      void on_scheduler_entry(bool) override
+      {
+#if defined(R__LINUX)
+         unsigned seq = fNextCpu++;
+         cpu_set_t cpuset;
+         CPU_ZERO(&cpuset);
+         if (fNodeCpus.size() > 1) {
+            const std::vector<unsigned> &cpus = fNodeCpus[seq % fNodeCpus.size()];
+            CPU_SET(cpus[(seq / fNodeCpus.size()) % cpus.size()], &cpuset);
+         } else {
+            // Topology unavailable: fall back to consecutive cpu ids.
+            unsigned ncpus = std::thread::hardware_concurrency();
+            if (ncpus == 0) return;
+            CPU_SET(seq % ncpus, &cpuset);
+         }
+         pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#endif
+      }
+   private:
+      std::atomic<unsigned> fNextCpu{0};
+      std::vector<std::vector<unsigned>> fNodeCpus; // cpu ids of each NUMA node
+   };
+
+   std::unique_ptr<PoolThreadPinner> gPinner;
+}
+
 
 namespace ROOT {
 
@@ -84,23 +195,101 @@ namespace ROOT {
       fSched = ROOT::Internal::GetPoolManager(nThreads);
    }
 
+   TThreadExecutor::~TThreadExecutor() = default;
+
+   //////////////////////////////////////////////////////////////////////////
+   /// See EnableNestedParallelism in the class description.
+   void TThreadExecutor::EnableNestedParallelism(Bool_t enable)
+   {
+      gNestedParallelism = enable;
+   }
+
+   Bool_t TThreadExecutor::NestedParallelismEnabled()
+   {
+      return gNestedParallelism;
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Pin (or, with pin=kFALSE, stop pinning) the pool threads to logical
+   /// cpus. Threads are pinned as they enter the scheduler.
+   void TThreadExecutor::SetThreadAffinity(Bool_t pin)
+   {
+      if (pin && !gPinner)
+         gPinner.reset(new PoolThreadPinner());
+      else if (!pin)
+         gPinner.reset();
+   }
+
    void TThreadExecutor::ParallelFor(unsigned int start, unsigned int end, unsigned step, const std::function<void(unsigned int i)> &f)
    {
-      tbb::parallel_for(start, end, step, f);
+      if (end <= start || step == 0)
+         return;
+      unsigned nsteps = (end - start + step - 1) / step;
+      if (gParallelDepth > 0 && !gNestedParallelism) {
+         // nested call from inside another parallel region: run in place
+         for (unsigned k = 0; k < nsteps; ++k)
+            f(start + k * step);
+         return;
+      }
+      ParallelForImpl(nsteps, [&](unsigned int k) { f(start + k * step); });
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Run chunk(k) for k in [0, nsteps) in parallel, splitting the range
+   /// according to the selected partition (see EPartition).
+   void TThreadExecutor::ParallelForImpl(unsigned nsteps, const std::function<void(unsigned int k)> &chunk)
+   {
+      auto body = [&](const tbb::blocked_range<unsigned> &r) {
+         NestingRegion region;
+         for (unsigned k = r.begin(); k != r.end(); ++k)
+            chunk(k);
+      };
+      unsigned nthreads = ROOT::Internal::TPoolManager::GetPoolSize();
+      if (nthreads == 0) nthreads = 1;
+      switch (fPartition) {
+      case EPartition::kStatic: {
+         // one contiguous chunk per pool thread
+         unsigned grain = (nsteps + nthreads - 1) / nthreads;
+         tbb::parallel_for(tbb::blocked_range<unsigned>(0, nsteps, grain), body, tbb::simple_partitioner());
+         break;
+      }
+      case EPartition::kAffinity:
+         // the partitioner object remembers the chunk-to-thread mapping
+         // of previous executions and replays it
+         if (!fAffinityPartitioner)
+            fAffinityPartitioner.reset(new tbb::affinity_partitioner());
+         tbb::parallel_for(tbb::blocked_range<unsigned>(0, nsteps), body, *fAffinityPartitioner);
+         break;
+      case EPartition::kGuided: {
+         // many small equal chunks, balanced by work stealing
+         unsigned grain = nsteps / (8 * nthreads);
+         if (grain == 0) grain = 1;
+         tbb::parallel_for(tbb::blocked_range<unsigned>(0, nsteps, grain), body, tbb::simple_partitioner());
+         break;
+      }
+      default:
+         tbb::parallel_for(tbb::blocked_range<unsigned>(0, nsteps), body, tbb::auto_partitioner());
+      }
    }
 
    double TThreadExecutor::ParallelReduce(const std::vector<double> &objs, const std::function<double(double a, double b)> &redfunc)
    {
+      if (gParallelDepth > 0 && !gNestedParallelism)
+         return std::accumulate(objs.begin(), objs.end(), double{}, redfunc);
       return tbb::parallel_reduce(tbb::blocked_range<decltype(objs.begin())>(objs.begin(), objs.end()), double{},
       [redfunc](tbb::blocked_range<decltype(objs.begin())> const & range, double init) {
+         NestingRegion region;
          return std::accumulate(range.begin(), range.end(), init, redfunc);
       }, redfunc);
    }
 
    float TThreadExecutor::ParallelReduce(const std::vector<float> &objs, const std::function<float(float a, float b)> &redfunc)
    {
+      if (gParallelDepth > 0 && !gNestedParallelism)
+         return std::accumulate(objs.begin(), objs.end(), float{}, redfunc);
       return tbb::parallel_reduce(tbb::blocked_range<decltype(objs.begin())>(objs.begin(), objs.end()), float{},
       [redfunc](tbb::blocked_range<decltype(objs.begin())> const & range, float init) {
+         NestingRegion region;
          return std::accumulate(range.begin(), range.end(), init, redfunc);
       }, redfunc);
    }
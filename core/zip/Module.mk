@@ -17,10 +17,12 @@ ZIPL         := $(MODDIRI)/LinkDef.h
 ZIPDICTH     := $(MODDIRI)/Compression.h
 
 ZIPOLDH      := $(MODDIRI)/RZip.h     \
-                $(MODDIRI)/Compression.h
+                $(MODDIRI)/Compression.h \
+                $(MODDIRI)/ZipInteger.h
 
 ZIPOLDS      := $(MODDIRS)/ZDeflate.c   \
-                $(MODDIRS)/ZInflate.c
+                $(MODDIRS)/ZInflate.c   \
+                $(MODDIRS)/ZipInteger.c
 
 ZIPNEWH      := $(MODDIRI)/zlib.h \
                 $(MODDIRI)/zconf.h
@@ -0,0 +1,32 @@
+// @(#)root/zip:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_ZipInteger
+#define ROOT_ZipInteger
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Encode a buffer of big-endian 32 bit integers with the lightweight
+   integer codec (ROOT 9 byte envelope, 'I','E' signature): run-length,
+   dictionary+bitpack or delta+bitpack, whichever is predicted smallest
+   for this buffer. srcsize must be a multiple of 4. irep is the encoded
+   size, or 0 when no encoding beats the raw buffer (the caller then
+   falls back to the generic compression path). */
+void R__zipInteger(int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
+
+void R__unzipInteger(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,369 @@
+// @(#)root/zip:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/*
+  Lightweight per-block encodings for buffers of big-endian 32 bit
+  integers, with the ROOT 9 byte envelope ('I','E' signature).  Branches
+  holding flags, categories and repeated run numbers compress far better
+  with a structural encoding than with a byte oriented compressor, and
+  decode at memory bandwidth with no entropy coding stage:
+
+    method 1  run-length      runs of identical values, (value, count)
+    method 2  dictionary      table of distinct values (up to 256),
+                              indices bitpacked at the needed width
+    method 3  delta+bitpack   first value raw, then wrap-around deltas
+                              zigzag mapped and bitpacked at the width
+                              of the largest delta
+
+  R__zipInteger makes one analysis pass over the values (number of runs,
+  number of distinct values, largest delta), predicts the exact encoded
+  size of each method and emits only the smallest - or reports failure
+  when none beats the raw buffer, in which case the caller falls back to
+  the generic compression path.  All multi-byte quantities inside the
+  block are big-endian, like the input; bitpacked fields are MSB first.
+*/
+
+#include "ZipInteger.h"
+#include <stdio.h>
+#include <string.h>
+
+static const int kHeaderSize = 9;
+
+/* distinct-value probe: open addressing, capped at kMaxDict entries */
+#define R__INT_HASHSIZE 2048 /* power of two, > 4*kMaxDict */
+#define R__INT_MAXDICT 256
+
+static unsigned R__int_get(const unsigned char *p)
+{
+   return ((unsigned)p[0] << 24) | ((unsigned)p[1] << 16) | ((unsigned)p[2] << 8) | (unsigned)p[3];
+}
+
+static void R__int_put(unsigned char *p, unsigned v)
+{
+   p[0] = (unsigned char)(v >> 24);
+   p[1] = (unsigned char)(v >> 16);
+   p[2] = (unsigned char)(v >> 8);
+   p[3] = (unsigned char)v;
+}
+
+/* number of bits needed to represent v (0 for v == 0) */
+static int R__int_bitwidth(unsigned v)
+{
+   int w = 0;
+   while (v) {
+      w++;
+      v >>= 1;
+   }
+   return w;
+}
+
+/* map a wrap-around delta to an unsigned with small values for small
+   magnitudes (zigzag); exactly reversed by R__int_unzigzag */
+static unsigned R__int_zigzag(unsigned d)
+{
+   return (d << 1) ^ (unsigned)(-(int)(d >> 31));
+}
+
+static unsigned R__int_unzigzag(unsigned z)
+{
+   return (z >> 1) ^ (unsigned)(-(int)(z & 1));
+}
+
+/* MSB-first bit writer / reader */
+typedef struct {
+   unsigned char *buf;
+   unsigned long long acc;
+   int nbits;
+} R__int_bitstate;
+
+static void R__int_bitput(R__int_bitstate *bs, unsigned v, int w)
+{
+   bs->acc = (bs->acc << w) | (unsigned long long)(w == 32 ? v : (v & ((1U << w) - 1)));
+   bs->nbits += w;
+   while (bs->nbits >= 8) {
+      bs->nbits -= 8;
+      *bs->buf++ = (unsigned char)(bs->acc >> bs->nbits);
+   }
+}
+
+static void R__int_bitflush(R__int_bitstate *bs)
+{
+   if (bs->nbits > 0) {
+      *bs->buf++ = (unsigned char)(bs->acc << (8 - bs->nbits));
+      bs->nbits = 0;
+   }
+}
+
+static unsigned R__int_bitget(R__int_bitstate *bs, const unsigned char **src, const unsigned char *end, int w)
+{
+   while (bs->nbits < w) {
+      /* the callers verify up front that the bitpacked payload fits inside
+         the block, so running into 'end' only happens on corrupt input;
+         pad with zero bytes rather than read past the buffer */
+      bs->acc = (bs->acc << 8) | (unsigned long long)(*src < end ? *(*src)++ : 0);
+      bs->nbits += 8;
+   }
+   bs->nbits -= w;
+   return (unsigned)((bs->acc >> bs->nbits) & (w == 32 ? 0xffffffffULL : ((1ULL << w) - 1)));
+}
+
+void R__zipInteger(int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+   const unsigned char *in = (const unsigned char *)src;
+   unsigned char *out = (unsigned char *)tgt;
+   long n, i, out_size;
+   long nruns, ndict, size_rle, size_dict, size_delta, best;
+   int method, widx, wdelta;
+   unsigned prev, maxzig;
+   unsigned dict[R__INT_MAXDICT];
+   unsigned hashval[R__INT_HASHSIZE];
+   short hashidx[R__INT_HASHSIZE];
+
+   *irep = 0;
+   if (*srcsize < 8 || (*srcsize & 3) || *srcsize > 0xffffff) return;
+   n = *srcsize / 4;
+
+   /*   A N A L Y S I S   P A S S   */
+
+   memset(hashidx, -1, sizeof(hashidx));
+   nruns = 1;
+   ndict = 0;
+   maxzig = 0;
+   prev = R__int_get(in);
+   for (i = 0; i < n; i++) {
+      unsigned v = R__int_get(in + 4 * i);
+      if (i > 0) {
+         unsigned z = R__int_zigzag(v - prev);
+         if (v != prev) nruns++;
+         if (z > maxzig) maxzig = z;
+         prev = v;
+      }
+      if (ndict <= R__INT_MAXDICT) {
+         unsigned h = (v * 2654435761U) & (R__INT_HASHSIZE - 1);
+         while (hashidx[h] >= 0 && hashval[h] != v)
+            h = (h + 1) & (R__INT_HASHSIZE - 1);
+         if (hashidx[h] < 0) {
+            if (ndict < R__INT_MAXDICT) {
+               hashval[h] = v;
+               hashidx[h] = (short)ndict;
+               dict[ndict] = v;
+            }
+            ndict++; /* past R__INT_MAXDICT only marks the method unusable */
+         }
+      }
+   }
+
+   /*   M E T H O D   S E L E C T I O N   */
+
+   widx = R__int_bitwidth((unsigned)(ndict > 0 ? ndict - 1 : 0));
+   wdelta = R__int_bitwidth(maxzig);
+   size_rle = 8 * nruns;
+   size_dict = (ndict <= R__INT_MAXDICT) ? 2 + 4 * ndict + 1 + (n * widx + 7) / 8 : 0x7fffffff;
+   size_delta = 4 + 1 + ((n - 1) * wdelta + 7) / 8;
+
+   best = size_rle;
+   method = 1;
+   if (size_dict < best) {
+      best = size_dict;
+      method = 2;
+   }
+   if (size_delta < best) {
+      best = size_delta;
+      method = 3;
+   }
+   if (best + kHeaderSize >= *srcsize || best + kHeaderSize > *tgtsize) return;
+
+   /*   E N C O D E   */
+
+   out += kHeaderSize;
+   if (method == 1) {
+      unsigned run = 1;
+      prev = R__int_get(in);
+      for (i = 1; i < n; i++) {
+         unsigned v = R__int_get(in + 4 * i);
+         if (v == prev) {
+            run++;
+         } else {
+            R__int_put(out, prev);
+            R__int_put(out + 4, run);
+            out += 8;
+            prev = v;
+            run = 1;
+         }
+      }
+      R__int_put(out, prev);
+      R__int_put(out + 4, run);
+      out += 8;
+   } else if (method == 2) {
+      R__int_bitstate bs;
+      out[0] = (unsigned char)(ndict >> 8);
+      out[1] = (unsigned char)ndict;
+      out += 2;
+      for (i = 0; i < ndict; i++) {
+         R__int_put(out, dict[i]);
+         out += 4;
+      }
+      *out++ = (unsigned char)widx;
+      bs.buf = out;
+      bs.acc = 0;
+      bs.nbits = 0;
+      for (i = 0; i < n; i++) {
+         unsigned v = R__int_get(in + 4 * i);
+         unsigned h = (v * 2654435761U) & (R__INT_HASHSIZE - 1);
+         while (hashidx[h] < 0 || hashval[h] != v)
+            h = (h + 1) & (R__INT_HASHSIZE - 1);
+         R__int_bitput(&bs, (unsigned)hashidx[h], widx);
+      }
+      R__int_bitflush(&bs);
+      out = bs.buf;
+   } else {
+      R__int_bitstate bs;
+      prev = R__int_get(in);
+      R__int_put(out, prev);
+      out += 4;
+      *out++ = (unsigned char)wdelta;
+      bs.buf = out;
+      bs.acc = 0;
+      bs.nbits = 0;
+      for (i = 1; i < n; i++) {
+         unsigned v = R__int_get(in + 4 * i);
+         R__int_bitput(&bs, R__int_zigzag(v - prev), wdelta);
+         prev = v;
+      }
+      R__int_bitflush(&bs);
+      out = bs.buf;
+   }
+
+   /*   E N V E L O P E   */
+
+   out_size = out - (unsigned char *)tgt - kHeaderSize;
+   tgt[0] = 'I';
+   tgt[1] = 'E';
+   tgt[2] = (char)method;
+   tgt[3] = (char)(out_size & 0xff);
+   tgt[4] = (char)((out_size >> 8) & 0xff);
+   tgt[5] = (char)((out_size >> 16) & 0xff);
+   tgt[6] = (char)(*srcsize & 0xff);
+   tgt[7] = (char)((*srcsize >> 8) & 0xff);
+   tgt[8] = (char)((*srcsize >> 16) & 0xff);
+   *irep = (int)(out_size + kHeaderSize);
+}
+
+void R__unzipInteger(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+   const unsigned char *in, *end;
+   unsigned char *out = tgt;
+   long in_size, out_size, n, i;
+   int method;
+
+   *irep = 0;
+   if (*srcsize < kHeaderSize || src[0] != 'I' || src[1] != 'E') {
+      fprintf(stderr, "R__unzipInteger: error in header\n");
+      return;
+   }
+   method = src[2];
+   in_size = (long)src[3] | ((long)src[4] << 8) | ((long)src[5] << 16);
+   out_size = (long)src[6] | ((long)src[7] << 8) | ((long)src[8] << 16);
+   if (in_size + kHeaderSize > *srcsize || out_size > *tgtsize || (out_size & 3)) {
+      fprintf(stderr, "R__unzipInteger: inconsistent sizes\n");
+      return;
+   }
+   in = src + kHeaderSize;
+   end = in + in_size;
+   n = out_size / 4;
+
+   if (method == 1) {
+      long left = n;
+      while (left > 0) {
+         unsigned v, run;
+         if (in + 8 > src + kHeaderSize + in_size) {
+            fprintf(stderr, "R__unzipInteger: truncated run-length data\n");
+            return;
+         }
+         v = R__int_get(in);
+         run = R__int_get(in + 4);
+         in += 8;
+         if ((long)run > left) {
+            fprintf(stderr, "R__unzipInteger: run too long\n");
+            return;
+         }
+         left -= run;
+         while (run--) {
+            R__int_put(out, v);
+            out += 4;
+         }
+      }
+   } else if (method == 2) {
+      R__int_bitstate bs;
+      unsigned dict[R__INT_MAXDICT];
+      long ndict;
+      int widx;
+      if (in_size < 3) {
+         fprintf(stderr, "R__unzipInteger: truncated dictionary header\n");
+         return;
+      }
+      ndict = ((long)in[0] << 8) | (long)in[1];
+      in += 2;
+      if (ndict < 1 || ndict > R__INT_MAXDICT || 2 + 4 * ndict + 1 > in_size) {
+         fprintf(stderr, "R__unzipInteger: bad dictionary size\n");
+         return;
+      }
+      for (i = 0; i < ndict; i++) {
+         dict[i] = R__int_get(in);
+         in += 4;
+      }
+      widx = *in++;
+      if (widx > 32 || (n * widx + 7) / 8 > in_size - (2 + 4 * ndict + 1)) {
+         fprintf(stderr, "R__unzipInteger: truncated dictionary data\n");
+         return;
+      }
+      bs.acc = 0;
+      bs.nbits = 0;
+      for (i = 0; i < n; i++) {
+         unsigned idx = widx ? R__int_bitget(&bs, &in, end, widx) : 0;
+         if ((long)idx >= ndict) {
+            fprintf(stderr, "R__unzipInteger: index out of dictionary\n");
+            return;
+         }
+         R__int_put(out, dict[idx]);
+         out += 4;
+      }
+   } else if (method == 3) {
+      R__int_bitstate bs;
+      unsigned prev;
+      int wdelta;
+      if (out_size < 4 || in_size < 5) {
+         fprintf(stderr, "R__unzipInteger: truncated delta data\n");
+         return;
+      }
+      prev = R__int_get(in);
+      in += 4;
+      wdelta = *in++;
+      if (wdelta > 32 || ((n - 1) * wdelta + 7) / 8 > in_size - 5) {
+         fprintf(stderr, "R__unzipInteger: truncated delta data\n");
+         return;
+      }
+      R__int_put(out, prev);
+      out += 4;
+      bs.acc = 0;
+      bs.nbits = 0;
+      for (i = 1; i < n; i++) {
+         unsigned z = wdelta ? R__int_bitget(&bs, &in, end, wdelta) : 0;
+         prev += R__int_unzigzag(z);
+         R__int_put(out, prev);
+         out += 4;
+      }
+   } else {
+      fprintf(stderr, "R__unzipInteger: unknown method %d\n", method);
+      return;
+   }
+
+   *irep = (int)out_size;
+}
@@ -175,17 +175,77 @@ struct static_tree_desc_s {int dummy;}; /* for buggy compilers */
  *    (except for the last MIN_MATCH-1 bytes of the input file).
  */
 #ifdef FASTEST
-#define INSERT_STRING(s, str, match_head) \
+#define INSERT_STRING_CLASSIC(s, str, match_head) \
    (UPDATE_HASH(s, s->ins_h, s->window[(str) + (MIN_MATCH-1)]), \
     match_head = s->head[s->ins_h], \
     s->head[s->ins_h] = (Pos)(str))
 #else
-#define INSERT_STRING(s, str, match_head) \
+#define INSERT_STRING_CLASSIC(s, str, match_head) \
    (UPDATE_HASH(s, s->ins_h, s->window[(str) + (MIN_MATCH-1)]), \
     match_head = s->prev[(str) & s->w_mask] = s->head[s->ins_h], \
     s->head[s->ins_h] = (Pos)(str))
 #endif
 
+/* ===========================================================================
+ * Hardware accelerated match-finder hash in the style of the cloudflare
+ * zlib fork: instead of the rolling 3-byte hash, hash 4 window bytes at a
+ * time with the SSE4.2 crc32 instruction.  The hash only steers which
+ * positions the match finder probes - every candidate is still verified by
+ * comparing the actual window bytes - so the emitted stream is an ordinary
+ * deflate stream and remains readable by unmodified inflaters.  Selected at
+ * runtime (cpu support and compression level range), with the classic hash
+ * kept as the fallback.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    ((defined(__GNUC__) && __GNUC__ >= 5) || defined(__clang__)) && \
+    !defined(NO_CRC_HASH)
+#define CRC_HASH 1
+
+local int crc_hash_max_level = -1;  /* highest level using the crc hash, or
+                                       0 when unsupported; lazily set */
+
+__attribute__((target("sse4.2")))
+local uInt crc_hash_insert(s, str)
+    deflate_state *s;
+    uInt str;
+{
+    uInt h, head;
+    unsigned val;
+    zmemcpy(&val, &s->window[str], sizeof(val));
+    h = __builtin_ia32_crc32si(0, val) & s->hash_mask;
+    head = s->head[h];
+#ifndef FASTEST
+    s->prev[str & s->w_mask] = (Pos)head;
+#endif
+    s->head[h] = (Pos)str;
+    return head;
+}
+
+/* ===========================================================================
+ * Determine up to which compression level the crc hash is used.  At the
+ * high levels the longer hash chains of the classic hash pay off in ratio,
+ * so the default range is 1..6; the Z_CRC_HASH_MAX_LEVEL environment
+ * variable overrides the range (0 disables the crc hash entirely).
+ */
+local int crc_hash_level_range()
+{
+    if (crc_hash_max_level < 0) {
+        const char *limit = getenv("Z_CRC_HASH_MAX_LEVEL");
+        int max_level = limit != Z_NULL ? atoi(limit) : 6;
+        if (max_level < 0 || max_level > 9) max_level = 6;
+        if (!__builtin_cpu_supports("sse4.2")) max_level = 0;
+        crc_hash_max_level = max_level;
+    }
+    return crc_hash_max_level;
+}
+
+#define INSERT_STRING(s, str, match_head) \
+   ((s)->crc_hash ? (match_head = crc_hash_insert(s, str)) \
+                  : INSERT_STRING_CLASSIC(s, str, match_head))
+#else
+#define INSERT_STRING(s, str, match_head) INSERT_STRING_CLASSIC(s, str, match_head)
+#endif
+
 /* ===========================================================================
  * Initialize the hash table (avoiding 64K overflow for 16 bit systems).
  * prev[] will be initialized on the fly.
@@ -278,7 +338,17 @@ int ZEXPORT deflateInit2_(strm, level, method, windowBits, memLevel, strategy,
     s->hash_mask = s->hash_size - 1;
     s->hash_shift =  ((s->hash_bits+MIN_MATCH-1)/MIN_MATCH);
 
+#ifdef CRC_HASH
+    s->crc_hash = level >= 1 && level <= crc_hash_level_range();
+    /* The crc hash reads 4 window bytes per insert; the last insert of a
+     * stream may thus peek one byte past the filled part of the window
+     * (the value only perturbs the hash), so pad the allocation.
+     */
+    s->window = (Bytef *) ZALLOC(strm, s->w_size + 2, 2*sizeof(Byte));
+#else
+    s->crc_hash = 0;
     s->window = (Bytef *) ZALLOC(strm, s->w_size, 2*sizeof(Byte));
+#endif
     s->prev   = (Posf *)  ZALLOC(strm, s->w_size, sizeof(Pos));
     s->head   = (Posf *)  ZALLOC(strm, s->hash_size, sizeof(Pos));
 
@@ -442,6 +512,13 @@ int ZEXPORT deflateParams(strm, level, strategy)
         s->good_match       = configuration_table[level].good_length;
         s->nice_match       = configuration_table[level].nice_length;
         s->max_chain_length = configuration_table[level].max_chain;
+#ifdef CRC_HASH
+        /* Switching the hash mid-stream is safe: chain entries inserted
+         * under the other hash are just unlikely match candidates, and
+         * every candidate is verified against the window bytes.
+         */
+        s->crc_hash = level >= 1 && level <= crc_hash_level_range();
+#endif
     }
     s->strategy = strategy;
     return err;
@@ -134,6 +134,8 @@ typedef struct internal_state {
     Posf *head; /* Heads of the hash chains or NIL. */
 
     uInt  ins_h;          /* hash index of string to be inserted */
+    int   crc_hash;       /* use the hardware CRC32 match-finder hash; the
+                           * rolling ins_h hash is then left unused */
     uInt  hash_size;      /* number of elements in hash table */
     uInt  hash_bits;      /* log2(hash_size) */
     uInt  hash_mask;      /* hash_size-1 */
@@ -28,6 +28,7 @@ class TGeoNode;
 class TGeoVolume;
 class TGeoMatrix;
 class TGeoHMatrix;
+class TGeoBranchArray;
 
 
 class TGeoNavigator : public TObject
@@ -41,6 +42,7 @@ protected:
                                            Int_t ncheck, Int_t *result);
    TGeoNode             *CrossDivisionCell();
    void                  SafetyOverlaps();
+   Long64_t              RegionCellId(const Double_t *point) const;
 
 private :
    Double_t              fStep;             //! step to be done from current point and direction
@@ -82,6 +84,11 @@ private :
    TGeoHMatrix          *fCurrentMatrix;    //! current stored global matrix
    TGeoHMatrix          *fGlobalMatrix;     //! current pointer to cached global matrix
    TGeoHMatrix          *fDivMatrix;        //! current local matrix of the selected division cell
+   Int_t                 fRegionCacheSize;  //! number of slots in the region cache (0 if disabled)
+   Int_t                 fRegionMaxLevel;   //! maximum depth of the cached states
+   Double_t              fRegionInvCell;    //! inverse of the region cache cell size
+   Long64_t             *fRegionCells;      //! cell id stored in each region cache slot
+   TGeoBranchArray     **fRegionStates;     //! cached navigation state per region cache slot
    TString               fPath;             //! path to current node
 
 public :
@@ -107,6 +114,8 @@ public :
    TGeoNode              *FindNextBoundary(Double_t stepmax=TGeoShape::Big(),const char *path="", Bool_t frombdr=kFALSE);
    TGeoNode              *FindNextDaughterBoundary(Double_t *point, Double_t *dir, Int_t &idaughter, Bool_t compmatrix=kFALSE);
    TGeoNode              *FindNextBoundaryAndStep(Double_t stepmax=TGeoShape::Big(), Bool_t compsafe=kFALSE);
+   Bool_t                 FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs,
+                                             const Double_t *steps, Double_t *dists, Int_t *daughters);
    TGeoNode              *FindNode(Bool_t safe_start=kTRUE);
    TGeoNode              *FindNode(Double_t x, Double_t y, Double_t z);
    Double_t              *FindNormal(Bool_t forward=kTRUE);
@@ -128,6 +137,9 @@ public :
    Int_t                  GetThreadId() const          {return fThreadId;}
    void                   InspectState() const;
    Bool_t                 IsSafeStep(Double_t proposed, Double_t &newsafety) const;
+   void                   EnableRegionCache(Int_t nslots=1024, Double_t cellsize=0.);
+   void                   ClearRegionCache();
+   Bool_t                 IsRegionCacheEnabled() const {return fRegionCacheSize>0;}
    Bool_t                 IsSameLocation(Double_t x, Double_t y, Double_t z, Bool_t change=kFALSE);
    Bool_t                 IsSameLocation() const {return fIsSameLocation;}
    Bool_t                 IsSamePoint(Double_t x, Double_t y, Double_t z) const;
@@ -282,6 +282,10 @@ in order to enhance rays.
 #include "TEnv.h"
 #include "TGeoParallelWorld.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 // statics and globals
 
 TGeoManager *gGeoManager = 0;
@@ -2890,6 +2894,12 @@ void TGeoManager::RestoreMasterVolume()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Voxelize all non-divided volumes.
+///
+/// The per-volume voxelization and overlap search are independent, so when
+/// multithreading was requested via SetMaxThreads the work is distributed
+/// over a pool of that many threads. Sorting of the nodes and computation of
+/// the assembly bounding boxes (which are shared between mother volumes) are
+/// done serially beforehand.
 
 void TGeoManager::Voxelize(Option_t *option)
 {
@@ -2897,9 +2907,37 @@ void TGeoManager::Voxelize(Option_t *option)
 //   TGeoVoxelFinder *vox = 0;
    if (!fStreamVoxels && fgVerboseLevel>0) Info("Voxelize","Voxelizing...");
 //   Int_t nentries = fVolumes->GetSize();
+   std::vector<TGeoVolume*> volumes;
+   volumes.reserve(fVolumes->GetEntriesFast());
    TIter next(fVolumes);
    while ((vol = (TGeoVolume*)next())) {
       if (!fIsGeomReading) vol->SortNodes();
+      // Assembly bounding boxes are cached once computed, making the
+      // calls during the voxelization of the mother volumes no-ops.
+      if (vol->IsAssembly()) vol->GetShape()->ComputeBBox();
+      volumes.push_back(vol);
+   }
+   Int_t nthreads = fMaxThreads - 1;
+   Int_t nvol = (Int_t)volumes.size();
+   if (nthreads > nvol) nthreads = nvol;
+   if (nthreads > 1) {
+      std::atomic<Int_t> current(0);
+      auto workFunc = [&]() {
+         Int_t ivol;
+         while ((ivol = current.fetch_add(1)) < nvol) {
+            TGeoVolume *v = volumes[ivol];
+            if (!fStreamVoxels) v->Voxelize(option);
+            if (!fIsGeomReading) v->FindOverlaps();
+         }
+      };
+      std::vector<std::thread> pool;
+      pool.reserve(nthreads);
+      for (Int_t i=0; i<nthreads; i++) pool.emplace_back(workFunc);
+      for (auto &t : pool) t.join();
+      return;
+   }
+   for (Int_t ivol=0; ivol<nvol; ivol++) {
+      vol = volumes[ivol];
       if (!fStreamVoxels) {
          vol->Voxelize(option);
       }
@@ -3811,10 +3849,16 @@ void TGeoManager::SetVerboseLevel(Int_t vl)
 ///    Import in memory from filename the geometry with key=name.
 ///    if name="" (default), the first TGeoManager object in the file is returned.
 ///
+/// When importing a gdml file with option "cache", a binary snapshot of the
+/// closed geometry (including the voxelization) is maintained next to it in
+/// \<filename\>.root: the snapshot is written after the first parse and
+/// reloaded with bulk reads on subsequent imports as long as it is not older
+/// than the gdml file, which remains the source of truth.
+///
 /// Note that this function deletes the current gGeoManager (if one)
 /// before importing the new object.
 
-TGeoManager *TGeoManager::Import(const char *filename, const char *name, Option_t * /*option*/)
+TGeoManager *TGeoManager::Import(const char *filename, const char *name, Option_t *option)
 {
    if (fgLock) {
       ::Warning("TGeoManager::Import", "TGeoMananager in lock mode. NOT IMPORTING new geometry");
@@ -3828,6 +3872,20 @@ TGeoManager *TGeoManager::Import(const char *filename, const char *name, Option_
 
    if (strstr(filename,".gdml")) {
       // import from a gdml file
+      TString opt = option;
+      opt.ToLower();
+      Bool_t usecache = opt.Contains("cache");
+      TString snapname = TString::Format("%s.root", filename);
+      if (usecache) {
+         // Use the binary snapshot of a previous parse if it is still up to date.
+         Long_t id, size, flags, gdmltime, snaptime;
+         if (!gSystem->GetPathInfo(filename, &id, &size, &flags, &gdmltime) &&
+             !gSystem->GetPathInfo(snapname, &id, &size, &flags, &snaptime) &&
+             snaptime >= gdmltime) {
+            if (fgVerboseLevel>0) ::Info("TGeoManager::Import","Using geometry snapshot: %s",snapname.Data());
+            return Import(snapname, name);
+         }
+      }
       new TGeoManager("GDMLImport", "Geometry imported from GDML");
       TString cmd = TString::Format("TGDMLParse::StartGDML(\"%s\")", filename);
       TGeoVolume* world = (TGeoVolume*)gROOT->ProcessLineFast(cmd);
@@ -3839,6 +3897,8 @@ TGeoManager *TGeoManager::Import(const char *filename, const char *name, Option_
          gGeoManager->SetTopVolume(world);
          gGeoManager->CloseGeometry();
          gGeoManager->DefaultColors();
+         // Write the snapshot for the next import, voxelization included.
+         if (usecache) gGeoManager->Export(snapname, "", "v");
       }
    } else {
       // import from a root file
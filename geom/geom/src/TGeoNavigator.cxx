@@ -33,6 +33,8 @@ gGeoManager->SetCurrentNavigator(0);
 
 #include "TGeoNavigator.h"
 
+#include "TGeoBBox.h"
+#include "TGeoBranchArray.h"
 #include "TGeoManager.h"
 #include "TGeoMatrix.h"
 #include "TGeoNode.h"
@@ -86,6 +88,11 @@ TGeoNavigator::TGeoNavigator()
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
+               fRegionCacheSize(0),
+               fRegionMaxLevel(0),
+               fRegionInvCell(0.),
+               fRegionCells(0),
+               fRegionStates(0),
                fPath()
 
 {
@@ -137,6 +144,11 @@ TGeoNavigator::TGeoNavigator(TGeoManager* geom)
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
+               fRegionCacheSize(0),
+               fRegionMaxLevel(0),
+               fRegionInvCell(0.),
+               fRegionCells(0),
+               fRegionStates(0),
                fPath()
 
 {
@@ -196,6 +208,11 @@ TGeoNavigator::TGeoNavigator(const TGeoNavigator& gm)
                fBackupState(gm.fBackupState),
                fCurrentMatrix(gm.fCurrentMatrix),
                fGlobalMatrix(gm.fGlobalMatrix),
+               fRegionCacheSize(0),
+               fRegionMaxLevel(0),
+               fRegionInvCell(0.),
+               fRegionCells(0),
+               fRegionStates(0),
                fPath(gm.fPath)
 {
    fThreadId = TGeoManager::ThreadId();
@@ -250,6 +267,8 @@ TGeoNavigator& TGeoNavigator::operator=(const TGeoNavigator& gm)
       fBackupState = gm.fBackupState;
       fCurrentMatrix = gm.fCurrentMatrix;
       fGlobalMatrix = gm.fGlobalMatrix;
+      // the region cache is not copied: it is local to each navigator
+      ClearRegionCache();
       fPath = gm.fPath;
       for (Int_t i=0; i<3; i++) {
          fNormal[i] = gm.fNormal[i];
@@ -270,6 +289,7 @@ TGeoNavigator& TGeoNavigator::operator=(const TGeoNavigator& gm)
 
 TGeoNavigator::~TGeoNavigator()
 {
+   ClearRegionCache();
    if (fCache) delete fCache;
    if (fBackupState) delete fBackupState;
    if (fOverlapClusters) delete [] fOverlapClusters;
@@ -1615,7 +1635,24 @@ TGeoNode *TGeoNavigator::FindNode(Double_t x, Double_t y, Double_t z)
    fStartSafe = kTRUE;
    fIsSameLocation = kTRUE;
    TGeoNode *last = fCurrentNode;
+   Int_t slot = -1;
+   Long64_t cell = 0;
+   if (fRegionCacheSize) {
+      // Seed the search with the state cached for the spatial cell containing
+      // the point, if any. A stale or colliding state is harmless: SearchNode
+      // relocates upwards until the current volume contains the point.
+      cell = RegionCellId(fPoint);
+      slot = Int_t((ULong64_t)cell & (ULong64_t)(fRegionCacheSize-1));
+      if (fRegionStates[slot] && fRegionCells[slot] == cell)
+         fRegionStates[slot]->UpdateNavigator(this);
+   }
    TGeoNode *found = SearchNode();
+   if (slot >= 0 && found && !fIsOutside) {
+      if (!fRegionStates[slot])
+         fRegionStates[slot] = TGeoBranchArray::MakeInstance(fRegionMaxLevel);
+      fRegionStates[slot]->InitFromNavigator(this);
+      fRegionCells[slot] = cell;
+   }
    if (found != last) {
       fIsSameLocation = kFALSE;
    } else {
@@ -1624,6 +1661,148 @@ TGeoNode *TGeoNavigator::FindNode(Double_t x, Double_t y, Double_t z)
    return found;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distance to the next boundary for a whole bundle of tracks
+/// located in the current node, using the vectorized shape interfaces.
+///
+/// All tracks must have been located in the current node beforehand, e.g. by
+/// grouping a basket of tracks per volume. points and dirs hold ntracks
+/// point/direction triplets in MARS; steps holds the proposed step per track
+/// (if null, no step limit is applied). On output dists[i] is the distance to
+/// the next crossed boundary, limited to the proposed step, and daughters[i]
+/// is the index of the daughter that will be entered, or -1 when the current
+/// volume is exited first (or no boundary is reached within the step).
+///
+/// Returns kFALSE without computing anything if the current volume is an
+/// assembly or a division, in which case the caller should fall back to the
+/// scalar FindNextBoundary for each track. The navigator state is not
+/// modified.
+
+Bool_t TGeoNavigator::FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs,
+                                         const Double_t *steps, Double_t *dists, Int_t *daughters)
+{
+   if (ntracks <= 0) return kTRUE;
+   if (fIsOutside) return kFALSE;
+   TGeoVolume *vol = fCurrentNode->GetVolume();
+   if (vol->IsAssembly() || vol->GetFinder()) return kFALSE;
+   Double_t *lpoints = new Double_t[3*ntracks];
+   Double_t *ldirs   = new Double_t[3*ntracks];
+   Double_t *stepmax = new Double_t[ntracks];
+   Int_t i;
+   for (i=0; i<ntracks; i++) {
+      fGlobalMatrix->MasterToLocal(&points[3*i], &lpoints[3*i]);
+      fGlobalMatrix->MasterToLocalVect(&dirs[3*i], &ldirs[3*i]);
+      stepmax[i] = steps ? steps[i] : TGeoShape::Big();
+      daughters[i] = -1;
+   }
+   // Distance to exit the current volume.
+   vol->GetShape()->DistFromInside_v(lpoints, ldirs, dists, ntracks, stepmax);
+   for (i=0; i<ntracks; i++)
+      if (dists[i] > stepmax[i]) dists[i] = stepmax[i];
+   // Distance to enter each daughter, keeping the closest crossing.
+   Int_t nd = vol->GetNdaughters();
+   if (nd) {
+      Double_t *dpoints = new Double_t[3*ntracks];
+      Double_t *ddirs   = new Double_t[3*ntracks];
+      Double_t *ddists  = new Double_t[ntracks];
+      for (Int_t id=0; id<nd; id++) {
+         TGeoNode *daughter = vol->GetNode(id);
+         TGeoMatrix *matrix = daughter->GetMatrix();
+         for (i=0; i<ntracks; i++) {
+            matrix->MasterToLocal(&lpoints[3*i], &dpoints[3*i]);
+            matrix->MasterToLocalVect(&ldirs[3*i], &ddirs[3*i]);
+            // only crossings closer than the current best are interesting
+            stepmax[i] = dists[i];
+         }
+         daughter->GetVolume()->GetShape()->DistFromOutside_v(dpoints, ddirs, ddists, ntracks, stepmax);
+         for (i=0; i<ntracks; i++) {
+            if (ddists[i] < dists[i]) {
+               dists[i] = ddists[i];
+               daughters[i] = id;
+            }
+         }
+      }
+      delete [] ddists;
+      delete [] ddirs;
+      delete [] dpoints;
+   }
+   delete [] stepmax;
+   delete [] ldirs;
+   delete [] lpoints;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the id of the spatial cell containing a point, in MARS.
+
+Long64_t TGeoNavigator::RegionCellId(const Double_t *point) const
+{
+   Long64_t ix = (Long64_t)TMath::Floor(point[0]*fRegionInvCell);
+   Long64_t iy = (Long64_t)TMath::Floor(point[1]*fRegionInvCell);
+   Long64_t iz = (Long64_t)TMath::Floor(point[2]*fRegionInvCell);
+   return ix*73856093LL ^ iy*19349663LL ^ iz*83492791LL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the navigation region cache used by FindNode(x,y,z).
+///
+/// The cache is a direct-mapped table of nslots navigation states keyed by a
+/// spatial hash of the query point: a lookup in a cell visited before starts
+/// the search from the cached path instead of descending from the top node.
+/// This complements the per-volume voxels and pays off when many interleaved
+/// tracks revisit the same regions of a deep geometry. The cache belongs to
+/// this navigator, hence it is local to the thread owning it.
+///
+/// nslots is rounded up to the next power of two. cellsize is the edge of the
+/// cubic hash cells in MARS units; if not specified, 1/32 of the largest
+/// half-length of the top volume bounding box is used. The geometry must be
+/// closed. Cached states do not survive a change of the geometry: call
+/// ClearRegionCache in that case.
+
+void TGeoNavigator::EnableRegionCache(Int_t nslots, Double_t cellsize)
+{
+   if (!fGeometry || !fGeometry->IsClosed() || !fGeometry->GetTopVolume()) {
+      Error("EnableRegionCache", "geometry must be closed");
+      return;
+   }
+   ClearRegionCache();
+   if (nslots < 2) nslots = 2;
+   Int_t size = 2;
+   while (size < nslots) size <<= 1;
+   if (cellsize <= 0) {
+      TGeoBBox *box = (TGeoBBox*)fGeometry->GetTopVolume()->GetShape();
+      cellsize = TMath::Max(box->GetDX(), TMath::Max(box->GetDY(), box->GetDZ()))/32.;
+   }
+   if (cellsize <= 0) {
+      Error("EnableRegionCache", "cannot compute a cell size");
+      return;
+   }
+   fRegionMaxLevel = fGeometry->GetMaxLevel();
+   if (fRegionMaxLevel <= 0) fRegionMaxLevel = 100;
+   fRegionMaxLevel++;
+   fRegionCacheSize = size;
+   fRegionInvCell = 1./cellsize;
+   fRegionCells = new Long64_t[size];
+   fRegionStates = new TGeoBranchArray*[size];
+   memset(fRegionStates, 0, size*sizeof(TGeoBranchArray*));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop all cached navigation states and disable the region cache.
+
+void TGeoNavigator::ClearRegionCache()
+{
+   if (!fRegionCacheSize) return;
+   for (Int_t i=0; i<fRegionCacheSize; i++)
+      if (fRegionStates[i]) TGeoBranchArray::ReleaseInstance(fRegionStates[i]);
+   delete [] fRegionStates;
+   delete [] fRegionCells;
+   fRegionStates = 0;
+   fRegionCells = 0;
+   fRegionCacheSize = 0;
+   fRegionInvCell = 0.;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Computes fast normal to next crossed boundary, assuming that the current point
 /// is close enough to the boundary. Works only after calling FindNextBoundary.
@@ -742,3 +742,48 @@ void TGeoShape::Paint(Option_t *option)
       painter->PaintShape(this, gEnv->GetValue("Viewer3D.DefaultDrawOption",""));
    }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check the inside status for each of the points in the array.
+/// Generic scalar loop, to be overridden by shapes with vectorized kernels.
+
+void TGeoShape::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
+{
+   for (Int_t i=0; i<vecsize; i++) inside[i] = Contains(&points[3*i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the normal for an array of points so that norm.dot.dir is positive.
+/// Generic scalar loop, to be overridden by shapes with vectorized kernels.
+
+void TGeoShape::ComputeNormal_v(const Double_t *points, const Double_t *dirs, Double_t *norms, Int_t vecsize)
+{
+   for (Int_t i=0; i<vecsize; i++) ComputeNormal(&points[3*i], &dirs[3*i], &norms[3*i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute distance from inside the shape for an array of points and directions.
+/// Generic scalar loop, to be overridden by shapes with vectorized kernels.
+
+void TGeoShape::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t *step) const
+{
+   for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromInside(&points[3*i], &dirs[3*i], 3, step[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute distance from outside the shape for an array of points and directions.
+/// Generic scalar loop, to be overridden by shapes with vectorized kernels.
+
+void TGeoShape::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t *step) const
+{
+   for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromOutside(&points[3*i], &dirs[3*i], 3, step[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute safe distance for each of the points in the input array.
+/// Generic scalar loop, to be overridden by shapes with vectorized kernels.
+
+void TGeoShape::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
+{
+   for (Int_t i=0; i<vecsize; i++) safe[i] = Safety(&points[3*i], inside[i]);
+}
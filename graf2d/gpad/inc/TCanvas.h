@@ -27,6 +27,7 @@
 class TContextMenu;
 class TControlBar;
 class TBrowser;
+class TCollection;
 
 class TCanvas : public TPad {
 
@@ -229,6 +230,7 @@ public:
 
    static TCanvas   *MakeDefCanvas();
    static Bool_t     SupportAlpha();
+   static Int_t      BatchSaveAs(TCollection *canvases, const char *format = ".png", Int_t nWorkers = 0);
 
    ClassDef(TCanvas,8)  //Graphics canvas
 };
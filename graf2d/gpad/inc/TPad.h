@@ -96,6 +96,8 @@ protected:
    Short_t       fBorderSize;       ///<  pad bordersize in pixels
    Short_t       fBorderMode;       ///<  Bordermode (-1=down, 0 = no border, 1=up)
    Bool_t        fModified;         ///<  Set to true when pad is modified
+   Bool_t        fPixmapModified;   ///<! Pixmap content changed since last copy to canvas
+   Bool_t        fPixmapBlitted;    ///<! Pixmap was copied to canvas in current flush
    Bool_t        fGridx;            ///<  Set to true if grid along X
    Bool_t        fGridy;            ///<  Set to true if grid along Y
    Bool_t        fAbsCoord;         ///<  Use absolute coordinates
@@ -39,6 +39,8 @@
 #include "TView.h"
 
 #include "TVirtualMutex.h"
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
 
 class TCanvasInit {
 public:
@@ -2173,6 +2175,75 @@ Bool_t TCanvas::SupportAlpha()
                    gPad->GetGLDevice() != -1);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Save all canvases in the collection to image files, optionally in
+/// parallel worker processes.
+///
+/// Every canvas is saved as `<canvasname><format>`, where format is any
+/// extension understood by SaveAs (".png", ".jpg", ".gif", ".pdf", ...).
+/// With nWorkers > 1 the canvases are distributed over that many
+/// fork-based worker processes; each worker switches to batch mode, so
+/// the pads are rasterized off-screen through the image driver and the
+/// encoded file is written directly, without the on-screen pixmap
+/// round trip. With nWorkers <= 1 the canvases are saved serially in
+/// the calling process.
+///
+/// Returns the number of files written.
+
+Int_t TCanvas::BatchSaveAs(TCollection *canvases, const char *format, Int_t nWorkers)
+{
+   if (!canvases) return 0;
+
+   TString ext(format);
+   if (!ext.BeginsWith(".")) ext.Prepend(".");
+
+   std::vector<TCanvas*> cvec;
+   TIter next(canvases);
+   TObject *obj;
+   while ((obj = next())) {
+      TCanvas *c = dynamic_cast<TCanvas*>(obj);
+      if (c) {
+         cvec.push_back(c);
+      } else {
+         ::Warning("TCanvas::BatchSaveAs", "object %s is not a TCanvas - skipped",
+                   obj->GetName());
+      }
+   }
+   if (cvec.empty()) return 0;
+
+   if (nWorkers > (Int_t) cvec.size()) nWorkers = cvec.size();
+
+   auto saveRange = [&](int workerId) -> int {
+      int nok = 0;
+      for (size_t i = workerId; i < cvec.size(); i += nWorkers) {
+         TString fname;
+         fname.Form("%s%s", cvec[i]->GetName(), ext.Data());
+         cvec[i]->SaveAs(fname);
+         if (!gSystem->AccessPathName(fname)) ++nok;
+      }
+      return nok;
+   };
+
+   if (nWorkers <= 1) {
+      nWorkers = 1;
+      return saveRange(0);
+   }
+
+   ROOT::TProcessExecutor executor(nWorkers);
+   auto saveWorker = [&](int workerId) -> int {
+      // Render off-screen in the worker: the forked process gets its
+      // own copies of the canvases and must not touch the shared
+      // window-system connection of the parent.
+      gROOT->SetBatch(kTRUE);
+      return saveRange(workerId);
+   };
+   std::vector<int> counts = executor.Map(saveWorker, ROOT::TSeqI(nWorkers));
+
+   Int_t total = 0;
+   for (size_t i = 0; i < counts.size(); ++i) total += counts[i];
+   return total;
+}
+
 extern "C" void ROOT_TCanvas_Update(void* TheCanvas) {
    static_cast<TCanvas*>(TheCanvas)->Update();
 }
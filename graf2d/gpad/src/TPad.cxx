@@ -128,6 +128,8 @@ The transformation coefficients are explained in TPad::ResizePad.
 TPad::TPad()
 {
    fModified   = kTRUE;
+   fPixmapModified = kTRUE;
+   fPixmapBlitted  = kFALSE;
    fTip        = 0;
    fPadPointer = 0;
    fPrimitives = 0;
@@ -243,6 +245,8 @@ TPad::TPad(const char *name, const char *title, Double_t xlow,
           : TVirtualPad(name,title,xlow,ylow,xup,yup,color,bordersize,bordermode)
 {
    fModified   = kTRUE;
+   fPixmapModified = kTRUE;
+   fPixmapBlitted  = kFALSE;
    fTip        = 0;
    fBorderSize = bordersize;
    fBorderMode = bordermode;
@@ -973,12 +977,23 @@ void TPad::Close(Option_t *)
 
 void TPad::CopyPixmap()
 {
+   // Skip the copy if the pixmap content did not change since the last
+   // copy: the canvas buffer then already holds the identical raster.
+   // The current pad is always copied as its highlight must stay on top.
+   if (!fPixmapModified && this != gPad) {
+      fPixmapBlitted = kFALSE;
+      return;
+   }
+
    int px, py;
    XYtoAbsPixel(fX1, fY2, px, py);
 
    if (fPixmapID != -1)
       GetPainter()->CopyDrawable(fPixmapID, px, py);
 
+   fPixmapModified = kFALSE;
+   fPixmapBlitted  = kTRUE;
+
    if (this == gPad) HighLight(gPad->GetHighLightColor());
 }
 
@@ -992,8 +1007,13 @@ void TPad::CopyPixmaps()
    TIter    next(GetListOfPrimitives());
    while ((obj = next())) {
       if (obj->InheritsFrom(TPad::Class())) {
-         ((TPad*)obj)->CopyPixmap();
-         ((TPad*)obj)->CopyPixmaps();
+         TPad *pad = (TPad*)obj;
+         // A copied mother overwrites the sub-pad area with her own
+         // raster, so the sub-pad must be copied on top again even if
+         // its pixmap did not change.
+         if (fPixmapBlitted) pad->fPixmapModified = kTRUE;
+         pad->CopyPixmap();
+         pad->CopyPixmaps();
       }
    }
 }
@@ -2969,6 +2989,7 @@ Double_t TPad::YtoPad(Double_t y) const
 void TPad::Paint(Option_t * /*option*/)
 {
    if (!fPrimitives) fPrimitives = new TList;
+   fPixmapModified = kTRUE;
    if (fViewer3D && fViewer3D->CanLoopOnPrimitives()) {
       fViewer3D->PadPaint(this);
       Modified(kFALSE);
@@ -3150,6 +3171,7 @@ void TPad::PaintDate()
          //use ISO format like 2002-09-25 17:10:35
          dates = dt.AsSQLString();
       }
+      fPixmapModified = kTRUE;
       TText tdate(gStyle->GetDateX(),gStyle->GetDateY(),dates);
       tdate.SetTextSize( gStyle->GetAttDate()->GetTextSize());
       tdate.SetTextFont( gStyle->GetAttDate()->GetTextFont());
@@ -3187,6 +3209,7 @@ void TPad::PaintModified()
 {
    if (fViewer3D && fViewer3D->CanLoopOnPrimitives()) {
       if (IsModified()) {
+         fPixmapModified = kTRUE;
          fViewer3D->PadPaint(this);
          Modified(kFALSE);
       }
@@ -3213,6 +3236,7 @@ void TPad::PaintModified()
    fPadPaint = 1;
    cd();
    if (IsModified() || IsTransparent()) {
+      fPixmapModified = kTRUE;
       if ((fFillStyle < 3026) && (fFillStyle > 3000)) {
          if (!gPad->IsBatch()) GetPainter()->ClearDrawable();
       }
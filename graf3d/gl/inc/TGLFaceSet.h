@@ -26,6 +26,9 @@ private:
    std::vector<Int_t>    fPolyDesc;
    UInt_t                fNbPols;
 
+   mutable std::vector<Double_t> fTriangleData;        //! interleaved normal / position data of triangle polygons
+   mutable Bool_t                fTriangleDataRebuild; //! triangle array must be rebuilt before next draw
+
    static Bool_t fgEnforceTriangles;
 
 public:
@@ -47,6 +50,7 @@ public:
 
 private:
    void  GLDrawPolys() const;
+   void  BuildTriangleData() const;
    Int_t CheckPoints(const Int_t *source, Int_t *dest) const;
 
    static Bool_t Eq(const Double_t *p1, const Double_t *p2);
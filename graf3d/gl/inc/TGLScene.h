@@ -89,6 +89,27 @@ public:
    public:
       ShapeVec_t          fShapesOfInterest;
 
+      // Node of the cached bounding-box hierarchy over fShapesOfInterest:
+      // each node holds the merged bounding box of a fixed-size run of
+      // consecutive shapes. Rebuilt together with fShapesOfInterest and
+      // used during scene-info update to accept or reject whole groups
+      // of shapes against the clip and frustum planes with a single
+      // box-plane test.
+      struct BBoxGroup_t
+      {
+         TGLBoundingBox fBBox;  // merged bounding box of the group
+         UInt_t         fBegin; // index of first shape in fShapesOfInterest
+         UInt_t         fEnd;   // index one past the last shape
+
+         BBoxGroup_t(UInt_t b=0, UInt_t e=0) : fBegin(b), fEnd(e) {}
+      };
+      typedef std::vector<BBoxGroup_t>           BBoxGroupVec_t;
+      typedef std::vector<BBoxGroup_t>::iterator BBoxGroupVec_i;
+
+      BBoxGroupVec_t      fBBoxGroups;
+
+      void RebuildBBoxGroups();
+
       DrawElementVec_t    fVisibleElements;
 
       UInt_t              fMinorStamp;
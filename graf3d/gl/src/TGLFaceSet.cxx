@@ -58,7 +58,8 @@ Bool_t TGLFaceSet::fgEnforceTriangles = kFALSE;
 TGLFaceSet::TGLFaceSet(const TBuffer3D & buffer) :
    TGLLogicalShape(buffer),
    fVertices(buffer.fPnts, buffer.fPnts + 3 * buffer.NbPnts()),
-   fNormals(0)
+   fNormals(0),
+   fTriangleDataRebuild(kTRUE)
 {
    fNbPols = buffer.NbPols();
 
@@ -304,6 +305,35 @@ void TGLFaceSet::EnforceTriangles()
 
    fPolyDesc.swap(tc.RefPolyDesc());
    fNbPols = tc.GetNTrianlges();
+   fTriangleDataRebuild = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Rebuild the cached vertex array holding all triangle polygons of the
+/// set as interleaved flat-normal / position records, so that they can
+/// be drawn with a single glDrawArrays call instead of one
+/// glBegin/glEnd pair per polygon.
+
+void TGLFaceSet::BuildTriangleData() const
+{
+   fTriangleData.clear();
+
+   const Double_t *pnts = &fVertices[0];
+   const Double_t *normals = &fNormals[0];
+   const Int_t *pols = &fPolyDesc[0];
+
+   for (UInt_t i = 0, j = 0; i < fNbPols; ++i) {
+      Int_t npoints = pols[j++];
+      if (npoints == 3) {
+         for (Int_t k = 0; k < 3; ++k) {
+            fTriangleData.insert(fTriangleData.end(), normals + i * 3, normals + i * 3 + 3);
+            fTriangleData.insert(fTriangleData.end(), pnts + pols[j + k] * 3, pnts + pols[j + k] * 3 + 3);
+         }
+      }
+      j += npoints;
+   }
+
+   fTriangleDataRebuild = kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -317,6 +347,22 @@ void TGLFaceSet::DirectDraw(TGLRnrCtx & rnrCtx) const
 
    if (fNbPols == 0) return;
 
+   // Triangles, by far the most common polygons in detector geometries,
+   // are drawn from a cached vertex array in one call; only larger
+   // polygons go through the per-polygon paths below.
+   if (fTriangleDataRebuild) BuildTriangleData();
+
+   UInt_t nTriVerts = fTriangleData.size() / 6;
+   if (nTriVerts > 0) {
+      glEnableClientState(GL_NORMAL_ARRAY);
+      glEnableClientState(GL_VERTEX_ARRAY);
+      glNormalPointer(GL_DOUBLE, 6*sizeof(Double_t), &fTriangleData[0]);
+      glVertexPointer(3, GL_DOUBLE, 6*sizeof(Double_t), &fTriangleData[3]);
+      glDrawArrays(GL_TRIANGLES, 0, nTriVerts);
+      glDisableClientState(GL_VERTEX_ARRAY);
+      glDisableClientState(GL_NORMAL_ARRAY);
+   }
+
    GLUtesselator  *tessObj = TGLUtil::GetDrawTesselator3dv();
    const Double_t *pnts = &fVertices[0];
    const Double_t *normals = &fNormals[0];
@@ -325,7 +371,10 @@ void TGLFaceSet::DirectDraw(TGLRnrCtx & rnrCtx) const
    for (UInt_t i = 0, j = 0; i < fNbPols; ++i) {
       Int_t npoints = pols[j++];
 
-      if (tessObj && npoints > 4) {
+      if (npoints == 3) {
+         // already drawn from the triangle vertex array
+         j += npoints;
+      } else if (tessObj && npoints > 4) {
          gluBeginPolygon(tessObj);
          gluNextContour(tessObj, (GLenum)GLU_UNKNOWN);
          glNormal3dv(normals + i * 3);
@@ -395,6 +444,7 @@ Bool_t TGLFaceSet::Eq(const Double_t *p1, const Double_t *p2)
 
 void TGLFaceSet::CalculateNormals()
 {
+   fTriangleDataRebuild = kTRUE;
    fNormals.resize(3 *fNbPols);
    if (fNbPols == 0) return;
    Double_t *pnts = &fVertices[0];
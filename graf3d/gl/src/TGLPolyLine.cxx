@@ -61,12 +61,13 @@ void TGLPolyLine::DirectDraw(TGLRnrCtx & rnrCtx) const
 
    TGLUtil::LineWidth(fLineWidth);
 
-   glBegin(GL_LINE_STRIP);
-
-   for (UInt_t i = 0; i < fVertices.size(); i += 3)
-      glVertex3d(fVertices[i], fVertices[i + 1], fVertices[i + 2]);
-
-   glEnd();
+   // draw the whole strip from the vertex array in one call
+   if (!fVertices.empty()) {
+      glEnableClientState(GL_VERTEX_ARRAY);
+      glVertexPointer(3, GL_DOUBLE, 0, &fVertices[0]);
+      glDrawArrays(GL_LINE_STRIP, 0, fVertices.size() / 3);
+      glDisableClientState(GL_VERTEX_ARRAY);
+   }
 
    glLineWidth(oldWidth);
 }
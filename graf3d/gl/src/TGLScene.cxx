@@ -105,6 +105,31 @@ void TGLScene::TSceneInfo::ClearAfterRebuild()
    ClearDrawElementVec(fVisibleElements, maxSize);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Rebuild the cached bounding-box hierarchy over fShapesOfInterest.
+/// Consecutive shapes are grouped into runs of fixed size and the
+/// bounding boxes of each run are merged into one node, so that the
+/// scene-info update can accept or reject a whole group of shapes
+/// against a clip or frustum plane with a single box-plane test.
+/// Must be called whenever fShapesOfInterest is rebuilt.
+
+void TGLScene::TSceneInfo::RebuildBBoxGroups()
+{
+   static const UInt_t kGroupSize = 64;
+
+   fBBoxGroups.clear();
+
+   UInt_t nShapes = (UInt_t) fShapesOfInterest.size();
+   for (UInt_t i = 0; i < nShapes; i += kGroupSize)
+   {
+      BBoxGroup_t grp(i, std::min(i + kGroupSize, nShapes));
+      grp.fBBox = fShapesOfInterest[i]->BoundingBox();
+      for (UInt_t j = i + 1; j < grp.fEnd; ++j)
+         grp.fBBox.MergeAligned(fShapesOfInterest[j]->BoundingBox());
+      fBBoxGroups.push_back(grp);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Clear DrawElementPtrVectors and optionally resize them so that
 /// they don't take more space then required by all the elements in
@@ -410,6 +435,8 @@ void TGLScene::RebuildSceneInfo(TGLRnrCtx& rnrCtx)
    std::sort(sinfo->fShapesOfInterest.begin(), sinfo->fShapesOfInterest.end(),
              TGLScene::ComparePhysicalDiagonals);
 
+   sinfo->RebuildBBoxGroups();
+
    sinfo->ClearAfterRebuild();
 }
 
@@ -443,87 +470,170 @@ void TGLScene::UpdateSceneInfo(TGLRnrCtx& rnrCtx)
    Bool_t timerp     = rnrCtx.IsStopwatchRunning();
    sinfo->ResetUpdateTimeouted();
 
-   for (ShapeVec_i phys=sinfo->fShapesOfInterest.begin();
-        phys!=sinfo->fShapesOfInterest.end();
-        ++phys, ++checkCount)
+   for (TSceneInfo::BBoxGroupVec_i grp = sinfo->fBBoxGroups.begin();
+        grp != sinfo->fBBoxGroups.end() && ! sinfo->HasUpdateTimeouted();
+        ++grp)
    {
-      const TGLPhysicalShape * drawShape = *phys;
-
-      // TODO: Do small skipping first? Probably cheaper than frustum check
-      // Profile relative costs? The frustum check could be done implicitly
-      // from the LOD as we project all 8 vertices of the BB onto viewport
+      // Classify the merged bounding box of the group first. A group
+      // that is rejected as a whole is skipped without touching its
+      // shapes; a group that is fully accepted by a set of planes does
+      // not require the per-shape tests against those planes, as every
+      // shape box is contained in the group box.
+      Bool_t groupCulled  = kFALSE;
+      Bool_t testClip     = kFALSE;
+      Bool_t testFrustum  = kFALSE;
 
-      // Work out if we need to draw this shape - assume we do first
-      Bool_t drawNeeded = kTRUE;
-
-      // Draw test against passed clipping planes.
-      // Do before camera clipping on assumption clip planes remove
-      // more objects.
       if (sinfo->ClipMode() == TGLSceneInfo::kClipOutside)
       {
-         // Draw not needed if outside any of the planes.
+         // Whole group not needed if outside any of the planes.
          std::vector<TGLPlane>::iterator pi = sinfo->ClipPlanes().begin();
          while (pi != sinfo->ClipPlanes().end())
          {
-            if (drawShape->BoundingBox().Overlap(*pi) == Rgl::kOutside)
+            Rgl::EOverlap ovlp = grp->fBBox.Overlap(*pi);
+            if (ovlp == Rgl::kOutside)
             {
-               drawNeeded = kFALSE;
+               groupCulled = kTRUE;
                break;
             }
+            if (ovlp != Rgl::kInside)
+               testClip = kTRUE;
             ++pi;
          }
       }
       else if (sinfo->ClipMode() == TGLSceneInfo::kClipInside)
       {
-         // Draw not needed if inside all the planes.
+         // Whole group not needed if inside all the planes; if the
+         // group is outside some plane no shape can be inside all of
+         // them and the per-shape test can be skipped.
          std::vector<TGLPlane>::iterator pi = sinfo->ClipPlanes().begin();
          size_t cnt = 0;
+         Bool_t outside = kFALSE;
          while (pi != sinfo->ClipPlanes().end())
          {
-            Rgl::EOverlap ovlp = drawShape->BoundingBox().Overlap(*pi);
+            Rgl::EOverlap ovlp = grp->fBBox.Overlap(*pi);
             if (ovlp == Rgl::kOutside)
+            {
+               outside = kTRUE;
                break;
+            }
             else if (ovlp == Rgl::kInside)
                ++cnt;
             ++pi;
          }
-         if (cnt == sinfo->ClipPlanes().size())
-            drawNeeded = kFALSE;
+         if (!outside)
+         {
+            if (cnt == sinfo->ClipPlanes().size())
+               groupCulled = kTRUE;
+            else
+               testClip = kTRUE;
+         }
       }
 
-      // Test against camera frustum planes (here mode is Outside
+      // Group test against camera frustum planes (here mode is Outside
       // implicitly).
-      if (drawNeeded)
+      if (!groupCulled)
       {
          std::vector<TGLPlane>::iterator pi = sinfo->FrustumPlanes().begin();
          while (pi != sinfo->FrustumPlanes().end())
          {
-            if (drawShape->BoundingBox().Overlap(*pi) == Rgl::kOutside)
+            Rgl::EOverlap ovlp = grp->fBBox.Overlap(*pi);
+            if (ovlp == Rgl::kOutside)
             {
-               drawNeeded = kFALSE;
+               groupCulled = kTRUE;
                break;
             }
+            if (ovlp != Rgl::kInside)
+               testFrustum = kTRUE;
             ++pi;
          }
       }
 
-      // Draw? Then calculate lod and store ...
-      if (drawNeeded)
+      if (groupCulled)
       {
-         DrawElement_t de(drawShape);
-         drawShape->CalculateShapeLOD(rnrCtx, de.fPixelSize, de.fPixelLOD);
-         sinfo->fVisibleElements.push_back(de);
+         checkCount += grp->fEnd - grp->fBegin;
+         continue;
       }
 
-      // Terminate the traversal if over scene rendering limit.
-      // Only test every 5000 objects as this is somewhat costly.
-      if (timerp && (checkCount % 5000) == 0 && rnrCtx.HasStopwatchTimedOut())
+      for (UInt_t idx = grp->fBegin; idx < grp->fEnd; ++idx, ++checkCount)
       {
-         sinfo->UpdateTimeouted();
-         if (rnrCtx.ViewerLOD() == TGLRnrCtx::kLODHigh)
-            Warning("TGLScene::UpdateSceneInfo",
-                    "Timeout reached, not all elements processed.");
-         break;
+         const TGLPhysicalShape * drawShape = sinfo->fShapesOfInterest[idx];
+
+         // TODO: Do small skipping first? Probably cheaper than frustum check
+         // Profile relative costs? The frustum check could be done implicitly
+         // from the LOD as we project all 8 vertices of the BB onto viewport
+
+         // Work out if we need to draw this shape - assume we do first
+         Bool_t drawNeeded = kTRUE;
+
+         // Draw test against passed clipping planes.
+         // Do before camera clipping on assumption clip planes remove
+         // more objects.
+         if (testClip && sinfo->ClipMode() == TGLSceneInfo::kClipOutside)
+         {
+            // Draw not needed if outside any of the planes.
+            std::vector<TGLPlane>::iterator pi = sinfo->ClipPlanes().begin();
+            while (pi != sinfo->ClipPlanes().end())
+            {
+               if (drawShape->BoundingBox().Overlap(*pi) == Rgl::kOutside)
+               {
+                  drawNeeded = kFALSE;
+                  break;
+               }
+               ++pi;
+            }
+         }
+         else if (testClip && sinfo->ClipMode() == TGLSceneInfo::kClipInside)
+         {
+            // Draw not needed if inside all the planes.
+            std::vector<TGLPlane>::iterator pi = sinfo->ClipPlanes().begin();
+            size_t cnt = 0;
+            while (pi != sinfo->ClipPlanes().end())
+            {
+               Rgl::EOverlap ovlp = drawShape->BoundingBox().Overlap(*pi);
+               if (ovlp == Rgl::kOutside)
+                  break;
+               else if (ovlp == Rgl::kInside)
+                  ++cnt;
+               ++pi;
+            }
+            if (cnt == sinfo->ClipPlanes().size())
+               drawNeeded = kFALSE;
+         }
+
+         // Test against camera frustum planes (here mode is Outside
+         // implicitly).
+         if (drawNeeded && testFrustum)
+         {
+            std::vector<TGLPlane>::iterator pi = sinfo->FrustumPlanes().begin();
+            while (pi != sinfo->FrustumPlanes().end())
+            {
+               if (drawShape->BoundingBox().Overlap(*pi) == Rgl::kOutside)
+               {
+                  drawNeeded = kFALSE;
+                  break;
+               }
+               ++pi;
+            }
+         }
+
+         // Draw? Then calculate lod and store ...
+         if (drawNeeded)
+         {
+            DrawElement_t de(drawShape);
+            drawShape->CalculateShapeLOD(rnrCtx, de.fPixelSize, de.fPixelLOD);
+            sinfo->fVisibleElements.push_back(de);
+         }
+
+         // Terminate the traversal if over scene rendering limit.
+         // Only test every 5000 objects as this is somewhat costly.
+         if (timerp && (checkCount % 5000) == 0 && rnrCtx.HasStopwatchTimedOut())
+         {
+            sinfo->UpdateTimeouted();
+            if (rnrCtx.ViewerLOD() == TGLRnrCtx::kLODHigh)
+               Warning("TGLScene::UpdateSceneInfo",
+                       "Timeout reached, not all elements processed.");
+            break;
+         }
       }
    }
 
@@ -79,6 +79,9 @@ public:
    virtual Bool_t          IsOpen()    const { return fOpen; }
    virtual void            SetOpen(Bool_t o) { fOpen = o; }
 
+   virtual Bool_t          HasUnfetchedChildren() const { return kFALSE; }
+   virtual void            SetUnfetchedChildren(Bool_t) {}
+
    virtual Bool_t          IsActive() const = 0;
    virtual Pixel_t         GetActiveColor() const = 0;
    virtual void            SetActive(Bool_t) {}
@@ -144,6 +147,7 @@ private:
    Bool_t           fActive;       // true if item is active
    Bool_t           fCheckBox;     // true if checkbox is visible
    Bool_t           fChecked;      // true if item is checked
+   Bool_t           fUnfetched;    // true if children exist but have not been added yet
    Bool_t           fOwnsData;     // true if user data has to be deleted
    TString          fText;         // item text
    TString          fTipText;      // tooltip text
@@ -169,6 +173,9 @@ public:
    virtual Bool_t          IsActive()       const { return fActive; }
    virtual void            SetActive(Bool_t a)    { fActive = a; }
 
+   virtual Bool_t          HasUnfetchedChildren() const { return fUnfetched; }
+   virtual void            SetUnfetchedChildren(Bool_t unfetched) { fUnfetched = unfetched; }
+
    virtual const char     *GetText()             const { return fText.Data(); }
    virtual Int_t           GetTextLength()       const { return fText.Length(); }
    virtual const char     *GetTipText()          const { return fTipText.Data(); }
@@ -288,6 +295,7 @@ protected:
    virtual void UpdateChecked(TGListTreeItem *item, Bool_t redraw = kFALSE);
 
    void  SaveChildren(std::ostream &out, TGListTreeItem *item, Int_t &n);
+   void  EnsureChildrenFetched(TGListTreeItem *item);
    void  RemoveReference(TGListTreeItem *item);
    void  PDeleteItem(TGListTreeItem *item);
    void  PDeleteChildren(TGListTreeItem *item);
@@ -360,6 +368,7 @@ public:
    Int_t RecursiveDeleteItem(TGListTreeItem *item, void *userData);
 
    Int_t DeleteChildren(TGListTreeItem *item);
+   Int_t ReleaseChildren(TGListTreeItem *item);
    Int_t Reparent(TGListTreeItem *item, TGListTreeItem *newparent);
    Int_t ReparentChildren(TGListTreeItem *item, TGListTreeItem *newparent);
    void  SetToolTipItem(TGListTreeItem *item, const char *string);
@@ -419,6 +428,7 @@ public:
    virtual void DoubleClicked(TGListTreeItem *entry, Int_t btn);  //*SIGNAL*
    virtual void DoubleClicked(TGListTreeItem *entry, Int_t btn, Int_t x, Int_t y);  //*SIGNAL*
    virtual void Checked(TObject *obj, Bool_t check);  //*SIGNAL*
+   virtual void FetchChildren(TGListTreeItem *entry);  //*SIGNAL*
    virtual void DataDropped(TGListTreeItem *item, TDNDData *data);  //*SIGNAL*
 
    // Utility functions
@@ -75,6 +75,7 @@ protected:
    Long_t       fRowCount;       // number of rows
    Long_t       fColCount;       // number of columns in current line
    Long_t       fLongestLine;    // length of longest line
+   Long_t       fRevision;       // revision number, bumped by every text modification
 
    TGText(const TGText&);
    TGText& operator=(const TGText&);
@@ -118,6 +119,7 @@ public:
 
    Long_t  GetLineLength(Long_t row);
    Long_t  GetLongestLine() const { return fLongestLine; }
+   Long_t  GetRevision() const { return fRevision; }
 
    void    ReTab(Long_t row);
 
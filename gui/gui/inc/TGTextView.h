@@ -48,6 +48,8 @@ protected:
    Bool_t          fIsMarking;    // true if in marking mode
    Bool_t          fIsSaved;      // true is content is saved
    Bool_t          fReadOnly;     // text cannot be editted
+   Long_t          fCacheLineWidth; // cached pixel width of longest line
+   Long_t          fCacheRevision;  // fText revision the width cache was computed for, -1 if invalid
    TGLongPosition  fMarkedStart;  // start position of marked text
    TGLongPosition  fMarkedEnd;    // end position of marked text
    TViewTimer     *fScrollTimer;  // scrollbar timer
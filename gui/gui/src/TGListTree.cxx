@@ -35,6 +35,12 @@
 // kC_LISTTREE, kCT_ITEMCLICK, which button, location (y<<16|x).        //
 // kC_LISTTREE, kCT_ITEMDBLCLICK, which button, location (y<<16|x).     //
 //                                                                      //
+// Children of an item can be materialized on demand: mark the item     //
+// with SetUnfetchedChildren(kTRUE) instead of adding its children and  //
+// connect to the FetchChildren() signal, which is emitted the first    //
+// time such an item is opened. Together with ReleaseChildren() this    //
+// keeps memory usage proportional to the expanded part of the tree.    //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 #include <stdlib.h>
@@ -119,6 +125,7 @@ TGListTreeItemStd::TGListTreeItemStd(TGClient *client, const char *name,
    fText = name;
    fCheckBox = checkbox;
    fChecked = kTRUE;
+   fUnfetched = kFALSE;
 
    if (!opened)
       opened = TGListTree::GetOpenPic();
@@ -619,6 +626,7 @@ Bool_t TGListTree::HandleButton(Event_t *event)
                return kTRUE;
             }
             if ((event->fX < maxx) && (event->fX > minx)) {
+               if (!item->IsOpen()) EnsureChildrenFetched(item);
                item->SetOpen(!item->IsOpen());
                ClearViewPort();
                return kTRUE;
@@ -678,6 +686,7 @@ Bool_t TGListTree::HandleDoubleClick(Event_t *event)
    // Otherwise, just use default behaviour (open item).
    if (event->fCode == kButton1 && item) {
       ClearViewPort();
+      if (!item->IsOpen()) EnsureChildrenFetched(item);
       item->SetOpen(!item->IsOpen());
       if (!fUserControlled) {
          if (item != fSelected) { // huh?!
@@ -962,6 +971,7 @@ Bool_t TGListTree::HandleKey(Event_t *event)
             if (fSelected == item) {
                // treat 'Enter' and 'Return' as a double click
                ClearViewPort();
+               if (!item->IsOpen()) EnsureChildrenFetched(item);
                item->SetOpen(!item->IsOpen());
                DoubleClicked(item, 1);
             } else {
@@ -1002,6 +1012,7 @@ Bool_t TGListTree::HandleKey(Event_t *event)
             break;
          case kKey_Right:
             ClearViewPort();
+            EnsureChildrenFetched(item);
             item->SetOpen(kTRUE);
             break;
          case kKey_Up:
@@ -1110,6 +1121,17 @@ void TGListTree::Checked(TObject *entry, Bool_t on)
    Emit("Checked(TObject*,Bool_t)", args);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Emit FetchChildren() signal. It is emitted the first time an item that
+/// was marked with SetUnfetchedChildren(kTRUE) is opened, so the connected
+/// slot can add the child items on demand instead of populating the whole
+/// tree up front.
+
+void TGListTree::FetchChildren(TGListTreeItem *entry)
+{
+   Emit("FetchChildren(TGListTreeItem*)", (Long_t)entry);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Emit Clicked() signal.
 
@@ -1683,7 +1705,7 @@ void TGListTree::DrawNode(Handle_t id, TGListTreeItem *item, Int_t x, Int_t y)
    TGPosition pos = GetPagePosition();
    Int_t yp = y - pos.fY;
 
-   if (item->fFirstchild) {
+   if (item->fFirstchild || item->HasUnfetchedChildren()) {
       gVirtualX->DrawLine(id, fHighlightGC, x, yp-2, x, yp+2);
       gVirtualX->SetForeground(fHighlightGC, fgBlackPixel);
       gVirtualX->DrawLine(id, fHighlightGC, x-2, yp, x+2, yp);
@@ -2033,12 +2055,26 @@ Int_t TGListTree::DeleteItem(TGListTreeItem *item)
    return 1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// If item is marked as having unfetched children and none have been added
+/// yet, clear the mark and emit FetchChildren() so the owner of the tree
+/// can materialize them. Called whenever an item is about to be opened.
+
+void TGListTree::EnsureChildrenFetched(TGListTreeItem *item)
+{
+   if (item && item->HasUnfetchedChildren() && !item->fFirstchild) {
+      item->SetUnfetchedChildren(kFALSE);
+      FetchChildren(item);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Open item in list tree (i.e. show child items).
 
 void TGListTree::OpenItem(TGListTreeItem *item)
 {
    if (item) {
+      EnsureChildrenFetched(item);
       item->SetOpen(kTRUE);
       DoRedraw(); // force layout
       AdjustPosition(item);
@@ -2103,6 +2139,22 @@ Int_t TGListTree::DeleteChildren(TGListTreeItem *item)
    return 1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Delete children of item and mark the item as having unfetched children,
+/// so they are requested again via FetchChildren() on the next open. Call
+/// this when an item is closed to keep memory usage proportional to the
+/// expanded part of the tree.
+
+Int_t TGListTree::ReleaseChildren(TGListTreeItem *item)
+{
+   if (!item || !item->fFirstchild) return 0;
+
+   Int_t ret = DeleteChildren(item);
+   item->SetUnfetchedChildren(kTRUE);
+
+   return ret;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Make newparent the new parent of item.
 
@@ -320,7 +320,8 @@ TGText::TGText(const TGText& gt) :
   fCurrentRow(gt.fCurrentRow),
   fRowCount(gt.fRowCount),
   fColCount(gt.fColCount),
-  fLongestLine(gt.fLongestLine)
+  fLongestLine(gt.fLongestLine),
+  fRevision(gt.fRevision)
 {
 }
 
@@ -338,6 +339,7 @@ TGText& TGText::operator=(const TGText& gt)
       fRowCount=gt.fRowCount;
       fColCount=gt.fColCount;
       fLongestLine=gt.fLongestLine;
+      fRevision++;
    }
    return *this;
 }
@@ -353,6 +355,7 @@ void TGText::Init()
    fColCount    = 0;
    fRowCount    = 1;
    fLongestLine = 0;
+   fRevision    = 0;
    fIsSaved     = kTRUE;
 }
 
@@ -418,6 +421,7 @@ void TGText::Clear()
    fColCount     = 0;
    fRowCount     = 1;
    fLongestLine  = 0;
+   fRevision++;
    fIsSaved      = kTRUE;
    fFilename     = "";
 }
@@ -500,6 +504,7 @@ Bool_t TGText::Load(const char *fn, Long_t startpos, Long_t length)
    if (fRowCount == 0)
       fRowCount++;
    fIsSaved  = kTRUE;
+   fRevision++;
    fFilename = fn;
    LongestLine();
 
@@ -597,6 +602,7 @@ next:
    if (fRowCount == 0)
       fRowCount++;
    fIsSaved  = kTRUE;
+   fRevision++;
    fFilename = "";
    LongestLine();
 
@@ -696,6 +702,7 @@ Bool_t TGText::DelChar(TGLongPosition pos)
    fCurrent->DelChar(pos.fX);
 
    fIsSaved = kFALSE;
+   fRevision++;
    LongestLine();
    return kTRUE;
 }
@@ -712,6 +719,7 @@ Bool_t TGText::InsChar(TGLongPosition pos, char c)
    fCurrent->InsChar(pos.fX, c);
 
    fIsSaved = kFALSE;
+   fRevision++;
    LongestLine();
    return kTRUE;
 }
@@ -772,6 +780,7 @@ Bool_t TGText::DelText(TGLongPosition start, TGLongPosition end)
    }
 
    fIsSaved = kFALSE;
+   fRevision++;
    LongestLine();
    return kTRUE;
 }
@@ -877,6 +886,7 @@ Bool_t TGText::InsText(TGLongPosition ins_pos, TGText *src,
 
    LongestLine();
    fIsSaved = kFALSE;
+   fRevision++;
    return kTRUE;
 }
 
@@ -901,6 +911,7 @@ Bool_t TGText::InsText(TGLongPosition pos, const char *buffer)
    }
    LongestLine();
    fIsSaved = kFALSE;
+   fRevision++;
    return kTRUE;
 }
 
@@ -954,6 +965,7 @@ Bool_t TGText::InsLine(ULong_t pos, const char *string)
 
    LongestLine();
    fIsSaved = kFALSE;
+   fRevision++;
    return kTRUE;
 }
 
@@ -984,6 +996,7 @@ Bool_t TGText::DelLine(ULong_t pos)
 
    fRowCount--;
    fIsSaved = kFALSE;
+   fRevision++;
    LongestLine();
 
    return kTRUE;
@@ -1029,6 +1042,7 @@ Bool_t TGText::BreakLine(TGLongPosition pos)
    }
 
    fIsSaved = kFALSE;
+   fRevision++;
    fRowCount++;
    fCurrentRow++;
    fCurrent = fCurrent->fNext;
@@ -1130,6 +1144,7 @@ void TGText::ReTab(Long_t row)
 
    fCurrent->fString = buf2;
    fCurrent->fLength = strlen(buf2);
+   fRevision++;
 
    delete [] buffer;
 }
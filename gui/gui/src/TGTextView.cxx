@@ -86,6 +86,9 @@ void TGTextView::Init(ULong_t back)
    fReadOnly    = kFALSE;
    fIsMarked    = kFALSE;
 
+   fCacheLineWidth = 0;
+   fCacheRevision  = -1;
+
    fText = new TGText();
    TGView::Clear();
 
@@ -197,6 +200,7 @@ void TGTextView::SetText(TGText *text)
    Clear();
    delete fText;
    fText = text;
+   fCacheRevision = -1;
    Layout();
 }
 
@@ -206,8 +210,20 @@ void TGTextView::SetText(TGText *text)
 void TGTextView::AddText(TGText *text)
 {
    UInt_t h1 = (UInt_t)ToScrYCoord(fText->RowCount());
+   Long_t rows = fText->RowCount();
+   Bool_t cacheOk = (fCacheRevision == fText->GetRevision());
 
    fText->AddText(text);
+   if (cacheOk) {
+      // only the appended lines can enlarge the longest line
+      for (Long_t row = rows - 1; row < fText->RowCount(); row++) {
+         Long_t width = ToScrXCoord(fText->GetLineLength(row), row) + fVisible.fX;
+         if (width > fCacheLineWidth) {
+            fCacheLineWidth = width;
+         }
+      }
+      fCacheRevision = fText->GetRevision();
+   }
    Layout();
 
    UInt_t h2 = (UInt_t)ToScrYCoord(fText->RowCount());
@@ -251,7 +267,16 @@ void TGTextView::AddLineFast(const char *string)
    TGLongPosition pos;
    pos.fX = 0;
    pos.fY = fText->RowCount();
+   Bool_t cacheOk = (fCacheRevision == fText->GetRevision());
    fText->InsText(pos, string);
+   if (cacheOk) {
+      // only the new line can enlarge the longest line
+      Long_t width = ToScrXCoord(fText->GetLineLength(pos.fY), pos.fY) + fVisible.fX;
+      if (width > fCacheLineWidth) {
+         fCacheLineWidth = width;
+      }
+      fCacheRevision = fText->GetRevision();
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -265,10 +290,17 @@ void TGTextView::Update()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return width of longest line.
+/// Return width of longest line. The width is measured only when the text
+/// has been modified since the last call (the cache is keyed on the TGText
+/// revision number), so repeated layouts during scrolling and resizing do
+/// not re-measure the whole document.
 
 Long_t TGTextView::ReturnLongestLineWidth()
 {
+   if (fCacheRevision == fText->GetRevision()) {
+      return fCacheLineWidth;
+   }
+
    Long_t count = 0, longest = 0, width;
    Long_t rows = fText->RowCount();
    while (count < rows) {
@@ -278,6 +310,8 @@ Long_t TGTextView::ReturnLongestLineWidth()
       }
       count++;
    }
+   fCacheLineWidth = longest;
+   fCacheRevision  = fText->GetRevision();
    return longest;
 }
 
@@ -334,6 +368,7 @@ void TGTextView::SetFont(FontStruct_t font)
       fFont = font;
       fNormGC.SetFont(gVirtualX->GetFontHandle(fFont));
       fSelGC.SetFont(gVirtualX->GetFontHandle(fFont));
+      fCacheRevision = -1;
       fClient->NeedRedraw(this);
    }
 }
@@ -437,6 +472,7 @@ void TGTextView::Clear(Option_t *)
    delete fText;
    fText = new TGText();
    fText->Clear();
+   fCacheRevision = -1;
    SendMessage(fMsgWindow, MK_MSG(kC_TEXTVIEW, kTXT_ISMARKED), fWidgetId, kFALSE);
    Marked(kFALSE);
    gVirtualX->ClearWindow(fCanvas->GetId());
@@ -23,6 +23,8 @@ HISTMH       := $(filter-out $(MODDIRI)/LinkDef%,$(wildcard $(MODDIRI)/*.h)) \
 		$(filter-out $(MODDIRI)/v5/LinkDef%,$(wildcard $(MODDIRI)/v5/*.h))
 #HISTHMAT     += mathcore/inc/Math/WrappedFunction.h
 
+HISTRH       := $(wildcard $(MODDIRI)/ROOT/*.hxx)
+
 HISTS        := $(filter-out $(MODDIRS)/G__%,$(wildcard $(MODDIRS)/*.cxx))
 HISTO        := $(call stripsrc,$(HISTS:.cxx=.o))
 
@@ -34,6 +36,7 @@ HISTMAP      := $(HISTLIB:.$(SOEXT)=.rootmap)
 # used in the main Makefile
 HISTMH_REL  := $(patsubst $(MODDIRI)/%,include/%,$(HISTMH))
 ALLHDRS     += $(HISTMH_REL)
+ALLHDRS     += $(patsubst $(MODDIRI)/%,include/%,$(HISTRH))
 ALLLIBS     += $(HISTLIB)
 ALLMAPS     += $(HISTMAP)
 ifeq ($(CXXMODULES),yes)
@@ -63,6 +66,12 @@ include/v5/%.h: $(HISTDIRI)/v5/%.h
 		fi)
 		cp $< $@
 
+include/ROOT/%.hxx: $(HISTDIRI)/ROOT/%.hxx
+		@(if [ ! -d "include/ROOT" ]; then     \
+		   mkdir -p include/ROOT;              \
+		fi)
+		cp $< $@
+
 include/%.h:    $(HISTDIRI)/%.h
 		cp $< $@
 
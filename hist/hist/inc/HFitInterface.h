@@ -29,6 +29,8 @@ struct Foption_t;
 
 #include "TFitResultPtr.h"
 
+#include <vector>
+
 namespace ROOT {
 
    namespace Math {
@@ -84,6 +86,24 @@ namespace ROOT {
       TFitResultPtr FitObject(THnBase * s1, TF1 *f1, Foption_t & option, const ROOT::Math::MinimizerOptions & moption, const char *goption, ROOT::Fit::DataRange & range);
 
 
+      /**
+         fit the same function to a set of histograms (e.g. calibration channels)
+         re-using a single fitter, fit configuration and wrapped model function
+         across all the fits instead of re-creating them for every channel as
+         TH1::Fit does. The function parameters present in f1 when calling are
+         used as the seed values for every histogram and one TFitResultPtr per
+         histogram is returned (holding always a TFitResult, as with option "S").
+         The option string is interpreted as in TH1::Fit; graphics options do not
+         apply and the fitted functions are never drawn.
+         If nthreads > 1 the channel fits are distributed on that many threads,
+         each one using its own clone of the model and its own minimizer
+         instance. In that case the caller must have enabled the thread safety
+         of ROOT (ROOT::EnableThreadSafety()) and the fitted functions are not
+         stored in the histogram lists of functions.
+       */
+      std::vector<TFitResultPtr> BatchFit(const std::vector<TH1 *> & hists, TF1 * f1, Option_t * option = "",
+                                          Double_t xmin = 0, Double_t xmax = 0, UInt_t nthreads = 0);
+
       /**
           fit an unbin data set (from tree or from histogram buffer)
           using a TF1 pointer and fit options.
@@ -64,13 +64,17 @@
 #pragma link C++ class TH2Poly+;
 #pragma link C++ class TH2PolyBin+;
 #pragma link C++ class TH2S-;
+#pragma link C++ class TH2Sparse+;
 #pragma link C++ class TH2I+;
 #pragma link C++ class TH3-;
 #pragma link C++ class TH3C-;
 #pragma link C++ class TH3D-;
 #pragma link C++ class TH3F-;
 #pragma link C++ class TH3S-;
+#pragma link C++ class TH3Sparse+;
 #pragma link C++ class TH3I+;
+#pragma link C++ class THistFillGroup+;
+#pragma link C++ class THSparseStore+;
 #pragma link C++ class THLimitsFinder+;
 #pragma link C++ class THnBase+;
 #pragma link C++ class THnIter+;
@@ -0,0 +1,124 @@
+/// \file ROOT/TConcurrentHistFill.hxx
+/// \ingroup Hist
+/// \author Rene Brun
+/// \date 2017-08
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TConcurrentHistFill
+#define ROOT_TConcurrentHistFill
+
+#include "RtypesCore.h"
+
+#include <array>
+#include <mutex>
+
+namespace ROOT {
+
+template <class HIST, Int_t SIZE = 1024>
+class TConcurrentHistFillManager;
+
+/**
+ \class TConcurrentHistFiller
+ Buffers one thread's Fill() calls and submits them in batches to the
+ TConcurrentHistFillManager owning the histogram.
+
+ Each filling thread obtains its own TConcurrentHistFiller from the manager
+ via TConcurrentHistFillManager::MakeFiller(). Fill() only appends to the
+ thread-local buffer; when the buffer is full (or on Flush() / destruction)
+ the whole batch is forwarded to the shared histogram as a single FillN()
+ call under the manager's lock. Compared to cloning the histogram per
+ thread this needs only 2*SIZE doubles per thread and no merge step, and
+ the per-fill synchronization cost is amortized over SIZE entries.
+ **/
+
+template <class HIST, Int_t SIZE>
+class TConcurrentHistFiller {
+   TConcurrentHistFillManager<HIST, SIZE> &fManager;
+   std::array<Double_t, SIZE> fXBuf;
+   std::array<Double_t, SIZE> fWBuf;
+   Int_t fCursor = 0;
+
+public:
+   TConcurrentHistFiller(TConcurrentHistFillManager<HIST, SIZE> &manager) : fManager(manager) {}
+
+   ~TConcurrentHistFiller() { Flush(); }
+
+   /// Thread-specific Fill(): buffer the value and weight, handing the full
+   /// buffer to the manager when SIZE entries have accumulated.
+   void Fill(Double_t x, Double_t w = 1.)
+   {
+      fXBuf[fCursor] = x;
+      fWBuf[fCursor++] = w;
+      if (fCursor == SIZE)
+         Flush();
+   }
+
+   /// Submit the buffered values to the histogram and reset the buffer.
+   void Flush()
+   {
+      if (fCursor) {
+         fManager.FillN(fXBuf.data(), fWBuf.data(), fCursor);
+         fCursor = 0;
+      }
+   }
+
+   HIST &GetHist() { return fManager.GetHist(); }
+};
+
+/**
+ \class TConcurrentHistFillManager
+ Allows multiple threads to fill one (not cloned) v6 histogram concurrently.
+
+ The HIST template argument can be any class with the one dimensional
+ TH1::FillN(Int_t, const Double_t*, const Double_t*, Int_t) interface.
+ The manager hands out TConcurrentHistFiller objects which buffer the
+ Fill() calls of one thread each; the batches are applied to the shared
+ histogram with FillN() serialized by a mutex. For histograms with fixed
+ bin width axes FillN() takes its vectorized bulk path, so the time spent
+ inside the lock is small.
+
+ ~~~{.cpp}
+ TH1D h("h", "h", 100, 0., 1.);
+ ROOT::TConcurrentHistFillManager<TH1D> mgr(h);
+ auto work = [&]() {
+    auto filler = mgr.MakeFiller();
+    for (...) filler.Fill(x);
+ }; // filler flushes its remainder when going out of scope
+ ~~~
+ **/
+
+template <class HIST, Int_t SIZE>
+class TConcurrentHistFillManager {
+   HIST &fHist;
+   std::mutex fFillMutex;
+
+public:
+   TConcurrentHistFillManager(HIST &hist) : fHist(hist) {}
+
+   TConcurrentHistFillManager(const TConcurrentHistFillManager &) = delete;
+   TConcurrentHistFillManager &operator=(const TConcurrentHistFillManager &) = delete;
+
+   /// Create a buffered filler for the calling thread.
+   TConcurrentHistFiller<HIST, SIZE> MakeFiller() { return TConcurrentHistFiller<HIST, SIZE>(*this); }
+
+   /// Apply a batch of values and weights to the histogram, serialized
+   /// with respect to the other fillers.
+   void FillN(const Double_t *x, const Double_t *w, Int_t n)
+   {
+      std::lock_guard<std::mutex> lockGuard(fFillMutex);
+      fHist.FillN(n, x, w, 1);
+   }
+
+   HIST &GetHist() { return fHist; }
+};
+
+} // namespace ROOT
+
+#endif
@@ -388,6 +388,7 @@ public:
    virtual void     DrawF1(Double_t xmin, Double_t xmax, Option_t *option = "");
    virtual Double_t Eval(Double_t x, Double_t y = 0, Double_t z = 0, Double_t t = 0) const;
    virtual Double_t EvalPar(const Double_t *x, const Double_t *params = 0);
+   virtual void     EvalBatch(Int_t n, const Double_t *x, Double_t *out, const Double_t *params = 0);
    template<class T> T EvalPar(const T *x, const Double_t *params = 0);
    template<class T> T EvalParVec(const T *data, const Double_t *params = 0);
    virtual Double_t operator()(Double_t x, Double_t y = 0, Double_t z = 0, Double_t t = 0) const;
@@ -22,6 +22,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <string>
 
 class TFormulaFunction
 {
@@ -98,6 +99,16 @@ private:
    TInterpreter::CallFuncIFacePtr_t::Generic_t fFuncPtr;   //!  function pointer
    void *   fLambdaPtr;                                    //!  pointer to the lambda function
 
+   typedef void (*BatchFunc_t)(Int_t, const Double_t *, Double_t *, const Double_t *);
+   mutable BatchFunc_t fBatchFuncPtr = nullptr;            //!  batch version of the jitted function, see EvalBatch
+   mutable TString     fBatchFuncName;                     //!  cling name fBatchFuncPtr was compiled for
+
+   std::vector<TFormula*>           fGradFormulas;  //! analytic parameter derivatives (null entry = identically zero)
+   std::vector<std::vector<Int_t> > fGradParMap;    //! index in this formula of each derivative formula parameter
+   Int_t                            fGradState = -1; //! -1 derivatives not yet generated, 0 not differentiable, 1 ready
+
+   Bool_t   GenerateGradientPar();
+   void     ClearGradientFormulas();
    void     InputFormulaIntoCling();
    Bool_t   PrepareEvalMethod();
    void     FillDefaults();
@@ -126,6 +137,7 @@ protected:
    static Bool_t IsScientificNotation(const TString & formula, int ipos);
    static Bool_t IsHexadecimal(const TString & formula, int ipos);
    static Bool_t IsAParameterName(const TString & formula, int ipos);
+   static void   OptimizeClingInput(std::string &expr, std::string &prelude);
    void   ExtractFunctors(TString &formula);
    void   PreProcessFormula(TString &formula);
    void   ProcessFormula(TString &formula);
@@ -164,6 +176,7 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalBatch(Int_t n, const Double_t *x, Double_t *out, const Double_t *params=0) const;
    TString        GetExpFormula(Option_t *option="") const;
    const TObject *GetLinearPart(Int_t i) const;
    Int_t          GetNdim() const {return fNdim;}
@@ -178,6 +191,8 @@ public:
    Double_t       GetVariable(const char *name) const;
    Int_t          GetVarNumber(const char *name) const;
    TString        GetVarName(Int_t ivar) const;
+   Double_t       GradientPar(Int_t ipar, const Double_t *x);
+   Bool_t         HasGradientPar();
    Bool_t         IsValid() const { return fReadyToExecute && fClingInitialized; }
    Bool_t         IsLinear() const { return TestBit(kLinear); }
    void           Print(Option_t *option = "") const;
@@ -151,6 +151,7 @@ public:
    void                  SetNpx(Int_t npx=40); // *MENU*
    void                  SetNpy(Int_t npx=40); // *MENU*
    virtual void          SetPoint(Int_t point, Double_t x, Double_t y, Double_t z); // *MENU*
+   virtual void          SetPoints(Int_t n, const Double_t *x, const Double_t *y, const Double_t *z);
    virtual void          SetTitle(const char *title=""); // *MENU*
 
 
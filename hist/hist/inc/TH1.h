@@ -99,12 +99,15 @@ protected:
     TDirectory   *fDirectory;       ///<!Pointer to directory holding this histogram
     Int_t         fDimension;       ///<!Histogram dimension (1, 2 or 3 dim)
     Double_t     *fIntegral;        ///<!Integral of bins used by GetRandom
+    mutable TArrayD fStatPrefix;    ///<!Per-bin prefix sums of (w,err^2,w*x,w*x^2) for range-restricted GetStats; rebuilt lazily from const GetStats, so unsynchronized concurrent queries race (as for fBuffer)
+    mutable Double_t fStatPrefixKey[8]; ///<!fEntries, fTsumw* and the x axis identity at the time fStatPrefix was built
     TVirtualHistPainter *fPainter;  ///<!pointer to histogram painter
     EBinErrorOpt  fBinStatErrOpt;   ///< option for bin statistical errors
     static Int_t  fgBufferSize;     ///<!default buffer size for automatic histograms
     static Bool_t fgAddDirectory;   ///<!flag to add histograms to the directory
     static Bool_t fgStatOverflows;  ///<!flag to use under/overflows in statistics
     static Bool_t fgDefaultSumw2;   ///<!flag to call TH1::Sumw2 automatically at histogram creation time
+    static Bool_t fgDeferredSumw2;  ///<!flag to defer the allocation of the sum of squares of weights until needed
 
 public:
    static Int_t FitOptionsMake(Option_t *option, Foption_t &Foption);
@@ -124,6 +127,7 @@ protected:
    TH1(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins);
    virtual Int_t    BufferFill(Double_t x, Double_t w);
    virtual Bool_t   FindNewAxisLimits(const TAxis* axis, const Double_t point, Double_t& newMin, Double_t &newMax);
+           void     UpdateStatPrefix() const;
    virtual void     SavePrimitiveHelp(std::ostream &out, const char *hname, Option_t *option = "");
    static Bool_t    RecomputeAxisLimits(TAxis& destAxis, const TAxis& anAxis);
    static Bool_t    SameLimitsAndNBins(const TAxis& axis1, const TAxis& axis2);
@@ -152,7 +156,8 @@ public:
       kIsZoomed    = BIT(16), ///< bit set when zooming on Y axis
       kNoTitle     = BIT(17), ///< don't draw the histogram title
       kIsAverage   = BIT(18), ///< Bin contents are average (used by Add)
-      kIsNotW      = BIT(19)  ///< Histogram is forced to be not weighted even when the histogram is filled with weighted different than 1.
+      kIsNotW      = BIT(19), ///< Histogram is forced to be not weighted even when the histogram is filled with weighted different than 1.
+      kDeferSumw2  = BIT(20)  ///< Sum of squares of weights requested but its storage deferred until needed (see TH1::SetDeferredSumw2)
    };
    // size of statistics data (size of  array used in GetStats()/ PutStats )
    // s[0]  = sumw       s[1]  = sumw2
@@ -256,6 +261,7 @@ public:
    virtual Double_t GetBinWithContent(Double_t c, Int_t &binx, Int_t firstx=0, Int_t lastx=0,Double_t maxdiff=0) const;
    virtual void     GetCenter(Double_t *center) const;
    static  Bool_t   GetDefaultSumw2();
+   static  Bool_t   GetDeferredSumw2();
    TDirectory      *GetDirectory() const {return fDirectory;}
    virtual Double_t GetEntries() const;
    virtual Double_t GetEffectiveEntries() const;
@@ -359,6 +365,7 @@ public:
    virtual void     SetContourLevel(Int_t level, Double_t value);
    static  void     SetDefaultBufferSize(Int_t buffersize=1000);
    static  void     SetDefaultSumw2(Bool_t sumw2=kTRUE);
+   static  void     SetDeferredSumw2(Bool_t defer=kTRUE);
    virtual void     SetDirectory(TDirectory *dir);
    virtual void     SetEntries(Double_t n) {fEntries = n;};
    virtual void     SetError(const Double_t *error);
@@ -0,0 +1,50 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH2Sparse
+#define ROOT_TH2Sparse
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TH2Sparse                                                            //
+//                                                                      //
+// 2-Dim histogram with chunked sparse bin storage                      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TH2.h"
+#include "THSparseStore.h"
+
+class TH2Sparse : public TH2, public THSparseStore {
+
+public:
+   TH2Sparse();
+   TH2Sparse(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+                                               ,Int_t nbinsy,Double_t ylow,Double_t yup);
+   TH2Sparse(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+                                               ,Int_t nbinsy,const Double_t *ybins);
+   TH2Sparse(const TH2Sparse &h2s);
+   virtual ~TH2Sparse();
+   virtual void     AddBinContent(Int_t bin) { AddBinValue(bin, 1); }
+   virtual void     AddBinContent(Int_t bin, Double_t w) { AddBinValue(bin, w); }
+   virtual void     Copy(TObject &hnew) const;
+   virtual void     Reset(Option_t *option="");
+   virtual void     SetBinsLength(Int_t n=-1);
+           TH2Sparse& operator=(const TH2Sparse &h1);
+
+protected:
+   virtual Double_t RetrieveBinContent(Int_t bin) const { return GetBinValue(bin); }
+   virtual void     UpdateBinContent(Int_t bin, Double_t content) { SetBinValue(bin, content); }
+
+   ClassDef(TH2Sparse,1)  //2-Dim histograms with chunked sparse bin storage
+};
+
+#endif
@@ -0,0 +1,52 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH3Sparse
+#define ROOT_TH3Sparse
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TH3Sparse                                                            //
+//                                                                      //
+// 3-Dim histogram with chunked sparse bin storage                      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TH3.h"
+#include "THSparseStore.h"
+
+class TH3Sparse : public TH3, public THSparseStore {
+
+public:
+   TH3Sparse();
+   TH3Sparse(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+                                               ,Int_t nbinsy,Double_t ylow,Double_t yup
+                                               ,Int_t nbinsz,Double_t zlow,Double_t zup);
+   TH3Sparse(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+                                               ,Int_t nbinsy,const Double_t *ybins
+                                               ,Int_t nbinsz,const Double_t *zbins);
+   TH3Sparse(const TH3Sparse &h3s);
+   virtual ~TH3Sparse();
+   virtual void     AddBinContent(Int_t bin) { AddBinValue(bin, 1); }
+   virtual void     AddBinContent(Int_t bin, Double_t w) { AddBinValue(bin, w); }
+   virtual void     Copy(TObject &hnew) const;
+   virtual void     Reset(Option_t *option="");
+   virtual void     SetBinsLength(Int_t n=-1);
+           TH3Sparse& operator=(const TH3Sparse &h1);
+
+protected:
+   virtual Double_t RetrieveBinContent(Int_t bin) const { return GetBinValue(bin); }
+   virtual void     UpdateBinContent(Int_t bin, Double_t content) { SetBinValue(bin, content); }
+
+   ClassDef(TH3Sparse,1)  //3-Dim histograms with chunked sparse bin storage
+};
+
+#endif
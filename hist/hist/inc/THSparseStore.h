@@ -0,0 +1,61 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THSparseStore
+#define ROOT_THSparseStore
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// THSparseStore                                                        //
+//                                                                      //
+// Chunked sparse bin content store with single precision accumulation  //
+// and double precision spill, mixed into TH2Sparse and TH3Sparse the   //
+// same way TArrayD is mixed into TH2D and TH3D.                        //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class THSparseStore {
+
+protected:
+   Int_t                 fStoreSize;  //  Total number of addressable cells
+   Int_t                 fChunkSize;  //  Number of cells per chunk
+   std::vector<Int_t>    fChunkMap;   //  Chunk -> slot: -1 empty, s >= 0 single precision slot s, s <= -2 double precision slot -(s+2)
+   std::vector<Float_t>  fChunksF;    //  Payloads of the single precision chunks
+   std::vector<Double_t> fChunksD;    //  Payloads of the double precision (spilled) chunks
+   std::vector<Int_t>    fFreeF;      //  Single precision slots freed by chunk promotion, reused first
+
+   Float_t  *AllocateChunk(Int_t chunk);
+   Double_t *PromoteChunk(Int_t chunk);
+
+public:
+   THSparseStore(Int_t chunkSize = 512);
+   virtual ~THSparseStore();
+
+   void      AddBinValue(Int_t bin, Double_t w);
+   Double_t  GetBinValue(Int_t bin) const;
+   void      SetBinValue(Int_t bin, Double_t content);
+
+   Int_t     GetChunkSize() const { return fChunkSize; }
+   Int_t     GetNchunks() const;
+   ULong64_t GetStoreBytes() const;
+   Double_t  GetStoreOccupancy() const;
+   Int_t     GetStoreSize() const { return fStoreSize; }
+   void      ResetStore();
+   void      SetStoreSize(Int_t n);
+
+   ClassDef(THSparseStore,1)  //Chunked sparse bin store with single precision accumulation
+};
+
+#endif
@@ -0,0 +1,65 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+#ifndef ROOT_THistFillGroup
+#define ROOT_THistFillGroup
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// THistFillGroup                                                       //
+//                                                                      //
+// Fill a group of 1-d histograms that share the same binning with one  //
+// bin-index computation per value: the bin is searched once on the     //
+// shared axis and the increment is applied to every member, instead of //
+// every histogram repeating FindBin on an identical axis.              //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "TAxis.h"
+
+#include <vector>
+
+class TH1;
+
+class THistFillGroup : public TObject {
+
+protected:
+   struct Member_t {
+      TH1      *fHist;     // member histogram (not owned)
+      Double_t  fEntries;  // entries filled through the group
+      Double_t  fTsumw;    // accumulated sum of weights
+      Double_t  fTsumw2;   // accumulated sum of weights squared
+      Double_t  fTsumwx;   // accumulated sum of weight*x
+      Double_t  fTsumwx2;  // accumulated sum of weight*x*x
+   };
+
+   TAxis                 fAxis;     // shared axis, copied from the first member
+   std::vector<Member_t> fMembers;  //! member histograms and their statistics
+
+   void FillMember(Member_t &member, Int_t bin, Double_t x, Double_t w);
+
+public:
+   THistFillGroup();
+   virtual ~THistFillGroup();
+
+   Bool_t   AddHistogram(TH1 *h);
+   Int_t    GetN() const { return (Int_t)fMembers.size(); }
+
+   void     Fill(Double_t x, Double_t w = 1);
+   void     Fill(Double_t x, const Double_t *weights);
+   void     FillN(Int_t ntimes, const Double_t *x, const Double_t *w = 0, Int_t stride = 1);
+
+   void     Flush();
+
+   ClassDef(THistFillGroup,1)  //Shared bin search for histograms with identical binning
+};
+
+#endif
@@ -104,6 +104,14 @@ private:
                    const TObjArray* axes, Bool_t keepTargetAxis) const;
    TObject* ProjectionAny(Int_t ndim, const Int_t* dim,
                           Bool_t wantNDim, Option_t* option = "") const;
+   // Hook for derived classes that can fill the projection target faster than
+   // the generic bin iteration in ProjectionAny (e.g. in parallel over their
+   // storage chunks); return kTRUE when hist has been filled.
+   virtual Bool_t FillProjectionHist(TH1* /*hist*/, Int_t /*ndim*/, const Int_t* /*dim*/,
+                                     Bool_t /*keepTargetAxis*/, Bool_t /*wantErrors*/,
+                                     Bool_t /*haveErrors*/, Bool_t& /*haveSkippedBin*/) const {
+      return kFALSE;
+   }
    Bool_t PrintBin(Long64_t idx, Int_t* coord, Option_t* options) const;
    void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
    THnBase* RebinBase(Int_t group) const;
@@ -58,6 +58,9 @@ class THnSparse: public THnBase {
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins);
    void FillExMap();
+   virtual Bool_t FillProjectionHist(TH1* hist, Int_t ndim, const Int_t* dim,
+                                     Bool_t keepTargetAxis, Bool_t wantErrors,
+                                     Bool_t haveErrors, Bool_t& haveSkippedBin) const;
    virtual TArray* GenerateArray() const = 0;
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
    void FillBin(Long64_t bin, Double_t w) {
@@ -40,6 +40,8 @@
 #include <cmath>
 #include <memory>
 #include <limits>
+#include <thread>
+#include <vector>
 
 //#define DEBUG
 
@@ -77,6 +79,10 @@ namespace HFit {
    template <class FitObject>
    void StoreAndDrawFitFunction(FitObject * h1, TF1 * f1, const ROOT::Fit::DataRange & range, bool, bool, const char *goption);
 
+   void FitBatchRange(const std::vector<TH1 *> & hists, unsigned int first, unsigned int last,
+                      TF1 * f1, Foption_t & fitOption, const ROOT::Math::MinimizerOptions & minOption,
+                      const ROOT::Fit::DataRange & prange, std::vector<TFitResultPtr> & results);
+
    template <class FitObject>
    double ComputeChi2(const FitObject & h1, TF1 &f1, bool useRange, bool usePL );
 
@@ -978,6 +984,230 @@ TFitResultPtr ROOT::Fit::FitObject(THnBase * s1, TF1 *f1 , Foption_t & foption ,
    return HFit::Fit(s1,f1,foption,moption,goption,range);
 }
 
+void HFit::FitBatchRange(const std::vector<TH1 *> & hists, unsigned int first, unsigned int last,
+                         TF1 * f1, Foption_t & fitOption, const ROOT::Math::MinimizerOptions & minOption,
+                         const ROOT::Fit::DataRange & prange, std::vector<TFitResultPtr> & results)
+{
+   // fit the histograms in [first,last) with the same function, re-using a
+   // single fitter, fit configuration and wrapped model for all of them.
+   // Used by ROOT::Fit::BatchFit both for the serial case and for one chunk
+   // of a parallel batch (each thread works on its own clone of the model
+   // and writes only in its own slots of the result vector).
+
+   Int_t special = f1->GetNumber();
+   int npar = f1->GetNpar();
+
+   // snapshot the seed parameters: every channel fit starts from the same values
+   std::vector<double> initPar(f1->GetParameters(), f1->GetParameters() + npar);
+
+   // create the data options once (same logic as in HFit::Fit)
+   ROOT::Fit::DataOptions opt;
+   opt.fIntegral = fitOption.Integral;
+   opt.fUseRange = fitOption.Range;
+   opt.fExpErrors = fitOption.PChi2;
+   if (fitOption.Like || fitOption.PChi2) opt.fUseEmpty = true;
+   if (special==300) opt.fCoordErrors = false;
+   if (fitOption.NoErrX) opt.fCoordErrors = false;
+   if (fitOption.W1 ) opt.fErrors1 = true;
+   if (fitOption.W1 > 1) opt.fUseEmpty = true;
+   if (fitOption.BinVolume) {
+      opt.fBinVolume = true;
+      if (fitOption.BinVolume == 2) opt.fNormBinVolume = true;
+   }
+
+   ROOT::Fit::DataRange range(prange);
+   if (opt.fUseRange) HFit::GetFunctionRange(*f1,range);
+
+   // single fitter, minimizer configuration and wrapped model shared by all
+   // the channel fits
+   ROOT::Fit::Fitter fitter;
+   ROOT::Fit::FitConfig & fitConfig = fitter.Config();
+   if (fitOption.Gradient)
+      fitter.SetFunction(ROOT::Math::WrappedMultiTF1(*f1) );
+   else
+      fitter.SetFunction(static_cast<const ROOT::Math::IParamMultiFunction &>(ROOT::Math::WrappedMultiTF1(*f1) ) );
+
+   fitConfig.SetMinimizerOptions(minOption);
+   if (fitOption.Verbose) fitConfig.MinimizerOptions().SetPrintLevel(3);
+   if (fitOption.Quiet)   fitConfig.MinimizerOptions().SetPrintLevel(0);
+   if (fitOption.More) fitConfig.SetMinimizer("Minuit","MigradImproved");
+   if (fitOption.Errors) {
+      // run Hesse and Minos
+      fitConfig.SetParabErrors(true);
+      fitConfig.SetMinosErrors(true);
+   }
+
+   for (unsigned int ih = first; ih < last; ++ih) {
+      TH1 * h1 = hists[ih];
+      if (!h1) continue;
+
+      // re-fill the fit data for this channel
+      ROOT::Fit::BinData fitdata(opt,range);
+      ROOT::Fit::FillData(fitdata, h1, f1);
+      if (fitdata.Size() == 0 ) {
+         Warning("BatchFit","Fit data is empty for histogram %s",h1->GetName());
+         continue;
+      }
+
+      // error normalization in case of zero error in the data
+      fitConfig.SetNormErrors(fitdata.GetErrorType() == ROOT::Fit::BinData::kNoError);
+
+      // re-seed the function and apply the data dependent initialization of the
+      // special functions (gaus, expo, landau)
+      f1->SetParameters(&initPar.front());
+      if (special != 0 && !fitOption.Bound) {
+         if      (special == 100 || special == 400) ROOT::Fit::InitGaus  (fitdata,f1);
+         else if (special == 110 || special == 112 || special == 410) ROOT::Fit::Init2DGaus(fitdata,f1);
+         else if (special == 200) ROOT::Fit::InitExpo  (fitdata,f1);
+      }
+      fitConfig.SetParamsSettings(npar, f1->GetParameters());
+
+      // transfer the parameter limits and step sizes from the function
+      // (same logic as in HFit::Fit)
+      for (int i = 0; i < npar; ++i) {
+         ROOT::Fit::ParameterSettings & parSettings = fitConfig.ParSettings(i);
+         double plow,pup;
+         f1->GetParLimits(i,plow,pup);
+         if (plow*pup != 0 && plow >= pup) { // this is a limitation - cannot fix a parameter to zero value
+            parSettings.Fix();
+         }
+         else if (plow < pup ) {
+            if (!TMath::Finite(pup) && TMath::Finite(plow) )
+               parSettings.SetLowerLimit(plow);
+            else if (!TMath::Finite(plow) && TMath::Finite(pup) )
+               parSettings.SetUpperLimit(pup);
+            else
+               parSettings.SetLimits(plow,pup);
+         }
+         double err = f1->GetParError(i);
+         if ( err > 0)
+            parSettings.SetStepSize(err);
+         else if (plow < pup && TMath::Finite(plow) && TMath::Finite(pup) ) {
+            double step = 0.1 * (pup - plow);
+            if (  parSettings.Value() < pup && pup - parSettings.Value() < 2 * step  )
+               step = (pup - parSettings.Value() ) / 2;
+            else if ( parSettings.Value() > plow && parSettings.Value() - plow < 2 * step )
+               step = (parSettings.Value() - plow ) / 2;
+            parSettings.SetStepSize(step);
+         }
+      }
+
+      bool fitok = false;
+      if (fitOption.Like)  { // likelihood fit
+         // perform a weighted likelihood fit by applying weight correction to errors
+         bool weight = ((fitOption.Like & 2) == 2) && h1->GetSumw2N() != 0;
+         fitConfig.SetWeightCorrection(weight);
+         bool extended = ((fitOption.Like & 4 ) != 4 );
+         fitok = fitter.LikelihoodFit(fitdata, extended);
+      }
+      else // standard least square fit
+         fitok = fitter.Fit(fitdata);
+
+      if ( !fitok  && !fitOption.Quiet )
+         Warning("BatchFit","Abnormal termination of minimization for histogram %s",h1->GetName());
+
+      const ROOT::Fit::FitResult & fitResult = fitter.Result();
+      std::shared_ptr<TFitResult> tfr(new TFitResult(fitResult) );
+      TString name = "TFitResult-";
+      name = name + h1->GetName() + "-" + f1->GetName();
+      TString title = "TFitResult-";
+      title += h1->GetTitle();
+      tfr->SetName(name);
+      tfr->SetTitle(title);
+
+      if (!fitResult.IsEmpty() ) {
+         // set in f1 the result of this channel fit and optionally store a copy
+         // of the function in the histogram list of functions
+         f1->SetChisquare(fitResult.Chi2() );
+         f1->SetNDF(fitResult.Ndf() );
+         f1->SetNumberFitPoints(fitdata.Size() );
+         f1->SetParameters( const_cast<double*>(&(fitResult.Parameters().front())));
+         if ( int( fitResult.Errors().size()) >= npar )
+            f1->SetParErrors( &(fitResult.Errors().front()) );
+         if (!fitOption.Nostore) {
+            ROOT::Fit::DataRange drange(range);
+            HFit::GetDrawingRange(h1, drange);
+            HFit::StoreAndDrawFitFunction(h1, f1, drange, !fitOption.Plus, false, "");
+         }
+      }
+      results[ih] = TFitResultPtr(tfr);
+   }
+
+   // leave the model function with the seed parameters, so that it can be
+   // re-used for another batch
+   f1->SetParameters(&initPar.front());
+}
+
+std::vector<TFitResultPtr> ROOT::Fit::BatchFit(const std::vector<TH1 *> & hists, TF1 * f1, Option_t * option,
+                                               Double_t xmin, Double_t xmax, UInt_t nthreads)
+{
+   // fit the same function to a set of histograms re-using the fit machinery;
+   // see the description in HFitInterface.h
+
+   std::vector<TFitResultPtr> results(hists.size(), TFitResultPtr(-1) );
+   if (hists.empty() ) return results;
+
+   // check the function against the dimension of the first valid histogram;
+   // all the histograms of the batch must have the same dimension
+   TH1 * href = 0;
+   for (unsigned int ih = 0; ih < hists.size() && !href; ++ih) href = hists[ih];
+   if (!href) return results;
+   int hdim = HFit::GetDimension(href);
+   if (HFit::CheckFitFunction(f1, hdim) != 0) return results;
+
+   Foption_t fitOption;
+   ROOT::Fit::FitOptionsMake(ROOT::Fit::kHistogram, option, fitOption);
+   if (f1->GetNdim() < hdim ) {
+      if (fitOption.Integral) Info("BatchFit","Ignore Integral option. Model function dimension is less than the data object dimension");
+      if (fitOption.Like) Info("BatchFit","Ignore Likelihood option. Model function dimension is less than the data object dimension");
+      fitOption.Integral = 0;
+      fitOption.Like = 0;
+   }
+   // the batch fits always return a TFitResult per channel and never draw
+   fitOption.StoreResult = 1;
+   fitOption.Nograph = 1;
+
+   ROOT::Fit::DataRange range(xmin,xmax);
+   ROOT::Math::MinimizerOptions minOption;
+
+   if (nthreads <= 1 || hists.size() < 2) {
+      HFit::FitBatchRange(hists, 0, hists.size(), f1, fitOption, minOption, range, results);
+      return results;
+   }
+
+   // parallel channel fits: each worker thread gets its own clone of the model
+   // (sharing the already jitted formula) and its own fitter and thus its own
+   // minimizer instance. The clones are created serially since the TF1 copy
+   // touches global state. Storing the fitted functions in the histograms is
+   // not thread safe, so it is disabled here.
+   if (nthreads > hists.size() ) nthreads = hists.size();
+   std::vector<TF1 *> fclones(nthreads, (TF1*)0);
+   for (UInt_t it = 0; it < nthreads; ++it)
+      fclones[it] = (TF1*) f1->Clone(TString::Format("%s_batchfit_%u",f1->GetName(),it) );
+
+   std::vector<Foption_t> toptions(nthreads, fitOption);
+   for (UInt_t it = 0; it < nthreads; ++it) toptions[it].Nostore = 1;
+
+   std::vector<std::thread> workers;
+   unsigned int nh = hists.size();
+   unsigned int chunk = nh / nthreads;
+   unsigned int rem   = nh % nthreads;
+   unsigned int first = 0;
+   for (UInt_t it = 0; it < nthreads; ++it) {
+      unsigned int last = first + chunk + (it < rem ? 1 : 0);
+      TF1 * fthr = fclones[it];
+      Foption_t & fopt = toptions[it];
+      workers.emplace_back([&hists, first, last, fthr, &fopt, &minOption, &range, &results]() {
+         HFit::FitBatchRange(hists, first, last, fthr, fopt, minOption, range, results);
+      });
+      first = last;
+   }
+   for (UInt_t it = 0; it < nthreads; ++it) workers[it].join();
+   for (UInt_t it = 0; it < nthreads; ++it) delete fclones[it];
+
+   return results;
+}
+
 
 
 // Int_t TGraph2D::DoFit(TF2 *f2 ,Option_t *option ,Option_t *goption) {
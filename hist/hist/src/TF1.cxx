@@ -1260,6 +1260,29 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function for a whole array of one-dimensional points.
+///
+/// The n values x[0]...x[n-1] are evaluated into out[0]...out[n-1], using
+/// the parameter values of params, or the current parameters when params is
+/// null. For formula-based functions this forwards to the batched
+/// TFormula::EvalBatch, whose evaluation loop is compiled once by cling so
+/// the per-point interpreter call overhead disappears; other function types
+/// are evaluated point by point through EvalPar.
+
+void TF1::EvalBatch(Int_t n, const Double_t *x, Double_t *out, const Double_t *params)
+{
+   if (n <= 0 || !x || !out) return;
+
+   if (fType == 0 && fFormula && !(fNormalized && fNormIntegral != 0)) {
+      fFormula->EvalBatch(n, x, out, params);
+      return;
+   }
+   for (Int_t i = 0; i < n; ++i)
+      out[i] = EvalPar(&x[i], params);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2172,6 +2195,18 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 {
    if (GetNpar() == 0) return 0;
 
+   // use the analytic derivative when the formula can be differentiated
+   // symbolically (see TFormula::HasGradientPar)
+   if (fFormula && fFormula->HasGradientPar()) {
+      Double_t al0, bl0;
+      GetParLimits(ipar, al0, bl0);
+      if (al0 * bl0 != 0 && al0 >= bl0) {
+         //this parameter is fixed
+         return 0;
+      }
+      return fFormula->GradientPar(ipar, x);
+   }
+
    if (eps < 1e-10 || eps > 1) {
       Warning("Derivative", "parameter esp=%g out of allowed range[1e-10,1], reset to 0.01", eps);
       eps = 0.01;
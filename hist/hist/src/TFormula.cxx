@@ -27,6 +27,10 @@
 #include <iostream>
 #include <unordered_map>
 #include <functional>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 using namespace std;
 
@@ -136,6 +140,8 @@ static const TString gNamePrefix = "TFormula__";
 // static map of function pointers and expressions
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
+// batch (array-at-a-time) wrappers of the jitted functions, see TFormula::EvalBatch
+static std::unordered_map<std::string,  void *> gClingBatchFunctions = std::unordered_map<std::string,  void * >();
 
 ////////////////////////////////////////////////////////////////////////////////
 Bool_t TFormula::IsOperator(const char c)
@@ -225,7 +231,258 @@ Bool_t TFormula::IsAParameterName(const TString & formula, int pos) {
    for (int i = pos+1; i < formula.Length(); i++) {
       if (formula[i] == ']' ) return true;
    }
-   return false; 
+   return false;
+}
+
+// BEGIN OptimizeClingInput helpers
+namespace {
+
+   // helpers of TFormula::OptimizeClingInput, operating on the processed
+   // expression handed to Cling (variables are x[i], parameters p[i])
+
+   bool OptIsIdentChar(char c)
+   {
+      return isalnum(c) || c == '_' || c == ':';
+   }
+
+   // return the position of the ')' matching the '(' at pos, or npos
+   std::string::size_type OptMatchParen(const std::string &s, std::string::size_type pos)
+   {
+      int depth = 0;
+      for (std::string::size_type i = pos; i < s.size(); ++i) {
+         if (s[i] == '(') depth++;
+         else if (s[i] == ')') {
+            depth--;
+            if (depth == 0) return i;
+         }
+      }
+      return std::string::npos;
+   }
+
+   bool OptParseSum(const char *&c, double &value);
+
+   // literal, parenthesized sub-expression or unary sign
+   bool OptParseFactor(const char *&c, double &value)
+   {
+      while (*c == ' ') ++c;
+      if (*c == '-') {
+         ++c;
+         if (!OptParseFactor(c, value)) return false;
+         value = -value;
+         return true;
+      }
+      if (*c == '+') {
+         ++c;
+         return OptParseFactor(c, value);
+      }
+      if (*c == '(') {
+         ++c;
+         if (!OptParseSum(c, value)) return false;
+         while (*c == ' ') ++c;
+         if (*c != ')') return false;
+         ++c;
+         return true;
+      }
+      if (!isdigit(*c) && *c != '.') return false;
+      char *end = 0;
+      value = strtod(c, &end);
+      if (end == c) return false;
+      c = end;
+      return true;
+   }
+
+   bool OptParseProduct(const char *&c, double &value)
+   {
+      if (!OptParseFactor(c, value)) return false;
+      while (true) {
+         while (*c == ' ') ++c;
+         char op = *c;
+         if (op != '*' && op != '/') return true;
+         ++c;
+         double rhs = 0;
+         if (!OptParseFactor(c, rhs)) return false;
+         value = (op == '*') ? value * rhs : value / rhs;
+      }
+   }
+
+   bool OptParseSum(const char *&c, double &value)
+   {
+      if (!OptParseProduct(c, value)) return false;
+      while (true) {
+         while (*c == ' ') ++c;
+         char op = *c;
+         if (op != '+' && op != '-') return true;
+         ++c;
+         double rhs = 0;
+         if (!OptParseProduct(c, rhs)) return false;
+         value = (op == '+') ? value + rhs : value - rhs;
+      }
+   }
+
+   // evaluate text if it is a pure numeric expression (+,-,*,/, parentheses,
+   // literals including scientific notation); no variables, calls or commas
+   bool OptEvalConstant(const std::string &text, double &value)
+   {
+      const char *c = text.c_str();
+      if (!OptParseSum(c, value)) return false;
+      while (*c == ' ') ++c;
+      return *c == 0;
+   }
+
+   // fold parenthesized constant sub-expressions, e.g. (2*3.5+1) -> (8), in
+   // place; a group is only folded when it contains an operator and its value
+   // is finite, so plain literals and overflowing expressions are left alone
+   void OptFoldConstants(std::string &expr)
+   {
+      bool changed = true;
+      while (changed) {
+         changed = false;
+         for (std::string::size_type i = 0; i < expr.size(); ++i) {
+            if (expr[i] != '(') continue;
+            std::string::size_type j = OptMatchParen(expr, i);
+            if (j == std::string::npos) return;   // unbalanced, leave it to Cling
+            std::string content = expr.substr(i + 1, j - i - 1);
+            if (content.find_first_of("+-*/") == std::string::npos) continue;
+            double value = 0;
+            if (!OptEvalConstant(content, value)) continue;
+            if (!TMath::Finite(value)) continue;
+            TString folded = TString::Format("(%.17g)", value);
+            expr.replace(i, j - i + 1, folded.Data());
+            changed = true;
+            break;
+         }
+      }
+      // the whole expression may be constant, without outer parentheses
+      double value = 0;
+      if (expr.find_first_of("+-*/") != std::string::npos && OptEvalConstant(expr, value)
+          && TMath::Finite(value)) {
+         expr = TString::Format("%.17g", value).Data();
+      }
+   }
+
+   // strength reduction: TMath::Power(A,2) costs a libm call, rewrite it as
+   // a product; the duplicated base is shared again by the CSE pass below
+   void OptReducePower(std::string &expr)
+   {
+      static const char *power = "TMath::Power(";
+      std::string::size_type start = 0;
+      while (true) {
+         std::string::size_type i = expr.find(power, start);
+         if (i == std::string::npos) return;
+         if (i > 0 && OptIsIdentChar(expr[i - 1])) {
+            start = i + 1;
+            continue;
+         }
+         std::string::size_type open = i + strlen(power) - 1;
+         std::string::size_type close = OptMatchParen(expr, open);
+         if (close == std::string::npos) return;
+         // top-level comma separating base and exponent
+         std::string::size_type comma = std::string::npos;
+         int depth = 0;
+         for (std::string::size_type k = open + 1; k < close; ++k) {
+            if (expr[k] == '(') depth++;
+            else if (expr[k] == ')') depth--;
+            else if (expr[k] == ',' && depth == 0) {
+               comma = k;
+               break;
+            }
+         }
+         if (comma == std::string::npos) {
+            start = i + 1;
+            continue;
+         }
+         std::string exponent = expr.substr(comma + 1, close - comma - 1);
+         std::string::size_type b = exponent.find_first_not_of(' ');
+         std::string::size_type e = exponent.find_last_not_of(' ');
+         exponent = (b == std::string::npos) ? std::string() : exponent.substr(b, e - b + 1);
+         if (exponent != "2" && exponent != "2." && exponent != "2.0") {
+            start = i + 1;
+            continue;
+         }
+         std::string base = expr.substr(open + 1, comma - open - 1);
+         expr.replace(i, close - i + 1, "((" + base + ")*(" + base + "))");
+         // rescan from the same position: the base may hold further powers
+      }
+   }
+
+   // count the occurrences of a complete sub-expression, or replace them all
+   // with an identifier; matches starting inside an identifier are skipped so
+   // the bare group (u) is not clipped out of a call f(u)
+   int OptCountOrReplace(std::string &s, const std::string &what, const char *with)
+   {
+      int n = 0;
+      std::string::size_type i = 0;
+      while ((i = s.find(what, i)) != std::string::npos) {
+         if (i > 0 && OptIsIdentChar(s[i - 1])) {
+            ++i;
+            continue;
+         }
+         ++n;
+         if (with) {
+            s.replace(i, what.size(), with);
+            i += strlen(with);
+         } else {
+            i += what.size();
+         }
+      }
+      return n;
+   }
+
+}
+// END OptimizeClingInput helpers
+
+////////////////////////////////////////////////////////////////////////////////
+/// Optimize the processed expression before it is given to Cling: fold
+/// constant sub-expressions, reduce TMath::Power(u,2) to a product and
+/// assign repeated sub-expressions once to local temporaries (common
+/// sub-expression elimination), so that (x[0]-p[0])/p[1] appearing five
+/// times in a resolution model is computed once per call. The definitions
+/// of the temporaries are returned in prelude, to be emitted in the
+/// generated function body before the return statement. The formula
+/// operations are pure IEEE arithmetic without side effects, hence sharing
+/// them cannot change the result. The user-visible formula string and the
+/// key used for the static map of jitted functions are not affected.
+
+void TFormula::OptimizeClingInput(std::string &expr, std::string &prelude)
+{
+   prelude.clear();
+   if (expr.find('"') != std::string::npos) return;   // play safe with string arguments
+
+   OptFoldConstants(expr);
+   OptReducePower(expr);
+
+   // collect complete sub-expressions: every balanced group together with
+   // the name of the function it is an argument list of, if any
+   std::vector<std::string> candidates;
+   for (std::string::size_type i = 0; i < expr.size(); ++i) {
+      if (expr[i] != '(') continue;
+      std::string::size_type j = OptMatchParen(expr, i);
+      if (j == std::string::npos) return;
+      std::string::size_type b = i;
+      while (b > 0 && OptIsIdentChar(expr[b - 1])) --b;
+      std::string cand = expr.substr(b, j - b + 1);
+      // worth a temporary only if it depends on a variable or parameter
+      // and is more expensive than the extra load
+      if (cand.size() < 8 || cand.find('[') == std::string::npos) continue;
+      candidates.push_back(cand);
+   }
+
+   // longest first, so an outer repeated expression is extracted before its
+   // pieces and the temporaries may refer to previously defined ones
+   std::sort(candidates.begin(), candidates.end(),
+             [](const std::string &a, const std::string &b) { return a.size() > b.size(); });
+
+   int ntemp = 0;
+   for (std::vector<std::string>::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+      if (OptCountOrReplace(expr, *it, 0) < 2) continue;
+      TString name = TString::Format("__tf_cse%d", ntemp++);
+      OptCountOrReplace(expr, *it, name.Data());
+      prelude += "const Double_t ";
+      prelude += name.Data();
+      prelude += " = ";
+      prelude += *it;
+      prelude += "; ";
+   }
 }
 
 
@@ -307,6 +564,8 @@ TFormula::~TFormula()
    if (nLinParts > 0) {
       for (int i = 0; i < nLinParts; ++i) delete fLinearParts[i];
    }
+
+   ClearGradientFormulas();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -587,6 +846,9 @@ void TFormula::Copy(TObject &obj) const
    fnew.fAllParametersSetted = fAllParametersSetted;
    fnew.fClingName = fClingName;
 
+   // the analytic derivatives are transient; regenerate them lazily in the copy
+   fnew.ClearGradientFormulas();
+
       // case of function based on a C++  expression (lambda's) which is ready to be compiled
    if (fLambdaPtr && TestBit(TFormula::kLambda)) {
 
@@ -645,6 +907,7 @@ void TFormula::Clear(Option_t * )
    }
    fLinearParts.clear();
 
+   ClearGradientFormulas();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1870,6 +2133,13 @@ void TFormula::ProcessFormula(TString &formula)
          // and also formula is same as FClingInput typically and it will be modified
          std::string inputFormula = std::string(formula);
 
+         // optimize the expression before code generation: constant folding,
+         // strength reduction and elimination of common sub-expressions, which
+         // become local temporaries declared in the prelude of the function body
+         std::string bodyFormula = inputFormula;
+         std::string bodyPrelude;
+         OptimizeClingInput(bodyFormula, bodyPrelude);
+
 
          // valid input formula - try to put into Cling
          TString argumentsPrototype =
@@ -1895,7 +2165,7 @@ void TFormula::ProcessFormula(TString &formula)
          auto hasher = gClingFunctions.hash_function();
          fClingName = TString::Format("%s__id%zu",gNamePrefix.Data(), hasher(inputFormula) );
 
-         fClingInput = TString::Format("Double_t %s(%s){ return %s ; }", fClingName.Data(),argumentsPrototype.Data(),inputFormula.c_str());
+         fClingInput = TString::Format("Double_t %s(%s){ %sreturn %s ; }", fClingName.Data(),argumentsPrototype.Data(),bodyPrelude.c_str(),bodyFormula.c_str());
 
          // this is not needed (maybe can be re-added in case of recompilation of identical expressions
          // // check in case of a change if need to re-initialize
@@ -2700,6 +2970,418 @@ Double_t TFormula::DoEval(const double * x, const double * params) const
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula for a whole array of one-dimensional points.
+///
+/// The n values x[0]...x[n-1] are evaluated into out[0]...out[n-1] with the
+/// parameter values of params (or the stored parameters if params is null).
+/// The evaluation loop itself is compiled by cling the first time it is
+/// needed, so the per-point overhead of marshalling the arguments through
+/// the interpreter's call interface is paid once per batch instead of once
+/// per point. For formulas where the batch wrapper cannot be used (more
+/// than one dimension, lambda-based formulas, formula not initialized) this
+/// falls back to evaluating point by point.
+
+void TFormula::EvalBatch(Int_t n, const Double_t *x, Double_t *out, const Double_t *params) const
+{
+   if (n <= 0 || !x || !out) return;
+
+   if (fNdim != 1 || TestBit(TFormula::kLambda) || !fClingInitialized || fClingName.IsNull()) {
+      for (Int_t i = 0; i < n; ++i)
+         out[i] = DoEval(&x[i], params);
+      return;
+   }
+
+   TString batchName = fClingName + "_batch";
+   if (!fBatchFuncPtr || fBatchFuncName != batchName) {
+      fBatchFuncPtr = nullptr;
+      R__LOCKGUARD2(gROOTMutex);
+      auto funcit = gClingBatchFunctions.find(std::string(batchName.Data()));
+      if (funcit != gClingBatchFunctions.end()) {
+         fBatchFuncPtr = (BatchFunc_t)funcit->second;
+      } else {
+         // The wrapper calls the already jitted function in a plain compiled
+         // loop; the signature of the inner call depends on whether the
+         // formula has parameters (see the prototype built in PreProcessFormula).
+         TString innerCall = (fNpar > 0) ? TString::Format("%s(&xx, const_cast<Double_t*>(p))", fClingName.Data())
+                                         : TString::Format("%s(&xx)", fClingName.Data());
+         TString decl = TString::Format(
+            "void %s(Int_t n, const Double_t* x, Double_t* out, const Double_t* p) {\n"
+            "   (void)p;\n"
+            "   for (Int_t i = 0; i < n; ++i) { Double_t xx = x[i]; out[i] = %s; }\n"
+            "}\n", batchName.Data(), innerCall.Data());
+         if (gCling->Declare(decl)) {
+            fBatchFuncPtr = (BatchFunc_t)gInterpreter->ProcessLine(TString::Format("(void*)::%s;", batchName.Data()));
+            if (fBatchFuncPtr)
+               gClingBatchFunctions.insert(std::make_pair(std::string(batchName.Data()), (void*)fBatchFuncPtr));
+         }
+      }
+      fBatchFuncName = batchName;
+      if (!fBatchFuncPtr) {
+         // could not compile the wrapper; evaluate point by point
+         for (Int_t i = 0; i < n; ++i)
+            out[i] = DoEval(&x[i], params);
+         return;
+      }
+   }
+
+   const Double_t *p = params ? params : fClingParameters.data();
+   (*fBatchFuncPtr)(n, x, out, p);
+}
+
+namespace {
+
+   // Helpers assembling derivative expressions for TFormula::GenerateGradientPar.
+   // Terms that are identically zero (or factors equal to one) are dropped so
+   // that the generated formulas stay reasonably small.
+
+   TString GradSum(const TString &a, const TString &b)
+   {
+      if (a == "0") return b;
+      if (b == "0") return a;
+      return "(" + a + "+" + b + ")";
+   }
+   TString GradSub(const TString &a, const TString &b)
+   {
+      if (b == "0") return a;
+      if (a == "0") return "(-" + b + ")";
+      return "(" + a + "-" + b + ")";
+   }
+   TString GradMul(const TString &a, const TString &b)
+   {
+      if (a == "0" || b == "0") return "0";
+      if (a == "1") return b;
+      if (b == "1") return a;
+      return "(" + a + "*" + b + ")";
+   }
+   TString GradDiv(const TString &a, const TString &b)
+   {
+      if (a == "0") return "0";
+      if (b == "1") return a;
+      return "(" + a + "/" + b + ")";
+   }
+
+   // Recursive-descent parser differentiating the Cling form of a formula
+   // (numbers, variables x[i], parameters p[i], the arithmetic operators and
+   // TMath function calls) with respect to the parameter p[ipar]. Each parse
+   // function returns both the value sub-expression (re-parenthesized) and its
+   // derivative; the ok flag is cleared when a construct is found whose
+   // derivative cannot be built, in which case the caller falls back to
+   // numerical differentiation.
+
+   class TFormulaGradientParser {
+   public:
+      struct Term_t {
+         TString fVal;
+         TString fDer;
+      };
+
+      TFormulaGradientParser(const TString &expr, Int_t ipar) :
+         fExpr(expr), fPos(0), fIpar(ipar), fOk(kTRUE) {}
+
+      Term_t Parse()
+      {
+         Term_t t = Expression();
+         SkipSpace();
+         if (fPos != fExpr.Length()) fOk = kFALSE;
+         return t;
+      }
+      Bool_t IsOk() const { return fOk; }
+
+   private:
+      TString fExpr;
+      Ssiz_t  fPos;
+      Int_t   fIpar;
+      Bool_t  fOk;
+
+      void SkipSpace() { while (fPos < fExpr.Length() && isspace(fExpr[fPos])) fPos++; }
+      char Peek() { SkipSpace(); return (fPos < fExpr.Length()) ? fExpr[fPos] : '\0'; }
+
+      Term_t Expression()
+      {
+         Term_t left = Term();
+         while (fOk) {
+            char c = Peek();
+            if (c != '+' && c != '-') break;
+            fPos++;
+            Term_t right = Term();
+            left.fVal = "(" + left.fVal + c + right.fVal + ")";
+            left.fDer = (c == '+') ? GradSum(left.fDer, right.fDer) : GradSub(left.fDer, right.fDer);
+         }
+         return left;
+      }
+
+      Term_t Term()
+      {
+         Term_t left = Unary();
+         while (fOk) {
+            char c = Peek();
+            if (c != '*' && c != '/') break;
+            fPos++;
+            Term_t right = Unary();
+            Term_t res;
+            res.fVal = "(" + left.fVal + c + right.fVal + ")";
+            if (c == '*') {
+               res.fDer = GradSum(GradMul(left.fDer, right.fVal), GradMul(left.fVal, right.fDer));
+            } else if (right.fDer == "0") {
+               res.fDer = GradDiv(left.fDer, right.fVal);
+            } else {
+               res.fDer = GradDiv(GradSub(GradMul(left.fDer, right.fVal), GradMul(left.fVal, right.fDer)),
+                                  "(" + right.fVal + "*" + right.fVal + ")");
+            }
+            left = res;
+         }
+         return left;
+      }
+
+      Term_t Unary()
+      {
+         char c = Peek();
+         if (c == '+') {
+            fPos++;
+            return Unary();
+         }
+         if (c == '-') {
+            fPos++;
+            Term_t t = Unary();
+            t.fVal = "(-" + t.fVal + ")";
+            if (t.fDer != "0") t.fDer = "(-" + t.fDer + ")";
+            return t;
+         }
+         return Primary();
+      }
+
+      Term_t Primary()
+      {
+         Term_t t;
+         t.fDer = "0";
+         char c = Peek();
+         if (c == '(') {
+            fPos++;
+            t = Expression();
+            if (Peek() != ')') { fOk = kFALSE; return t; }
+            fPos++;
+            return t;
+         }
+         if (isdigit(c) || c == '.') {
+            Ssiz_t start = fPos;
+            while (fPos < fExpr.Length() && (isdigit(fExpr[fPos]) || fExpr[fPos] == '.')) fPos++;
+            if (fPos < fExpr.Length() && (fExpr[fPos] == 'e' || fExpr[fPos] == 'E')) {
+               Ssiz_t expPos = fPos+1;
+               if (expPos < fExpr.Length() && (fExpr[expPos] == '+' || fExpr[expPos] == '-')) expPos++;
+               if (expPos < fExpr.Length() && isdigit(fExpr[expPos])) {
+                  fPos = expPos;
+                  while (fPos < fExpr.Length() && isdigit(fExpr[fPos])) fPos++;
+               }
+            }
+            t.fVal = fExpr(start, fPos-start);
+            return t;
+         }
+         if (isalpha(c) || c == '_') {
+            Ssiz_t start = fPos;
+            while (fPos < fExpr.Length() &&
+                   (isalnum(fExpr[fPos]) || fExpr[fPos] == '_' || fExpr[fPos] == ':')) fPos++;
+            TString name = fExpr(start, fPos-start);
+            if (Peek() == '[') {
+               // indexed token: a variable x[i] or a parameter p[i]
+               fPos++;
+               Ssiz_t istart = fPos;
+               while (fPos < fExpr.Length() && isdigit(fExpr[fPos])) fPos++;
+               if (Peek() != ']' || fPos == istart) { fOk = kFALSE; return t; }
+               TString index = fExpr(istart, fPos-istart);
+               fPos++;
+               t.fVal = name + "[" + index + "]";
+               if (name == "p" && index.Atoi() == fIpar) t.fDer = "1";
+               return t;
+            }
+            if (Peek() == '(') {
+               fPos++;
+               std::vector<Term_t> args;
+               if (Peek() != ')') {
+                  args.push_back(Expression());
+                  while (fOk && Peek() == ',') {
+                     fPos++;
+                     args.push_back(Expression());
+                  }
+               }
+               if (Peek() != ')') { fOk = kFALSE; return t; }
+               fPos++;
+               return Function(name, args);
+            }
+            // bare identifier (a constant like true); treat as parameter independent
+            t.fVal = name;
+            return t;
+         }
+         fOk = kFALSE;
+         return t;
+      }
+
+      Term_t Function(const TString &name, const std::vector<Term_t> &args)
+      {
+         Term_t t;
+         t.fVal = name + "(";
+         for (size_t i = 0; i < args.size(); ++i) {
+            if (i > 0) t.fVal += ",";
+            t.fVal += args[i].fVal;
+         }
+         t.fVal += ")";
+         t.fDer = "0";
+
+         TString fn = name;
+         if (fn.BeginsWith("TMath::")) fn.Remove(0, 7);
+         fn.ToLower();
+
+         if (fn == "power" || fn == "pow") {
+            if (args.size() != 2) { fOk = kFALSE; return t; }
+            const TString &a = args[0].fVal, &da = args[0].fDer;
+            const TString &b = args[1].fVal, &db = args[1].fDer;
+            if (da == "0" && db == "0") return t;
+            if (db == "0") {
+               // d/dp a^b = b * a^(b-1) * da   (b independent of p)
+               t.fDer = GradMul(GradMul(b, "TMath::Power(" + a + "," + b + "-1)"), da);
+            } else {
+               // general case: a^b * (db*log(a) + b*da/a)
+               t.fDer = GradMul(t.fVal, GradSum(GradMul(db, "TMath::Log(" + a + ")"),
+                                                GradDiv(GradMul(b, da), a)));
+            }
+            return t;
+         }
+
+         if (args.size() != 1) { fOk = kFALSE; return t; }
+         const TString &u = args[0].fVal, &du = args[0].fDer;
+         if (du == "0") return t;
+
+         if      (fn == "sin")   t.fDer = GradMul(du, "TMath::Cos(" + u + ")");
+         else if (fn == "cos")   t.fDer = GradMul(du, "(-TMath::Sin(" + u + "))");
+         else if (fn == "tan")   t.fDer = GradDiv(du, "(TMath::Cos(" + u + ")*TMath::Cos(" + u + "))");
+         else if (fn == "exp")   t.fDer = GradMul(du, "TMath::Exp(" + u + ")");
+         else if (fn == "log")   t.fDer = GradDiv(du, u);
+         else if (fn == "log10") t.fDer = GradDiv(du, GradMul(u, "2.302585092994046"));
+         else if (fn == "sqrt")  t.fDer = GradDiv(du, "(2*TMath::Sqrt(" + u + "))");
+         else if (fn == "sinh")  t.fDer = GradMul(du, "TMath::CosH(" + u + ")");
+         else if (fn == "cosh")  t.fDer = GradMul(du, "TMath::SinH(" + u + ")");
+         else if (fn == "tanh")  t.fDer = GradDiv(du, "(TMath::CosH(" + u + ")*TMath::CosH(" + u + "))");
+         else if (fn == "asin")  t.fDer = GradDiv(du, "TMath::Sqrt(1-" + GradMul(u, u) + ")");
+         else if (fn == "acos")  t.fDer = GradSub("0", GradDiv(du, "TMath::Sqrt(1-" + GradMul(u, u) + ")"));
+         else if (fn == "atan")  t.fDer = GradDiv(du, "(1+" + GradMul(u, u) + ")");
+         else fOk = kFALSE;   // derivative rule not known, use numerical differentiation
+
+         return t;
+      }
+   };
+
+}  // unnamed namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the generated analytic derivative formulas and force their
+/// regeneration at the next use.
+
+void TFormula::ClearGradientFormulas()
+{
+   for (auto grad : fGradFormulas) delete grad;
+   fGradFormulas.clear();
+   fGradParMap.clear();
+   fGradState = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the analytic parameter derivatives by symbolically differentiating
+/// the Cling form of the formula. Each non-trivial derivative is itself a
+/// TFormula compiled by Cling. Return false (and remember the failure) when
+/// the expression contains a construct that cannot be differentiated.
+
+Bool_t TFormula::GenerateGradientPar()
+{
+   fGradState = 0;
+   if (TestBit(TFormula::kLambda) || !IsValid() || fNpar <= 0) return kFALSE;
+
+   // Cling form of the expression: variables are x[i], parameters p[i] and
+   // the function shortcuts are already resolved to their TMath equivalents
+   TString cexpr = GetExpFormula("CLING");
+   if (cexpr.IsNull()) return kFALSE;
+
+   std::vector<TFormula*> grads(fNpar, nullptr);
+   std::vector<std::vector<Int_t> > parmaps(fNpar);
+   bool ok = true;
+   for (Int_t ipar = 0; ipar < fNpar && ok; ++ipar) {
+      TFormulaGradientParser parser(cexpr, ipar);
+      TFormulaGradientParser::Term_t term = parser.Parse();
+      if (!parser.IsOk()) { ok = false; break; }
+      TString der = term.fDer;
+      if (der == "0") continue;   // formula does not depend on this parameter
+
+      // translate the derivative back into formula syntax: parameters appear
+      // in the Cling expression as p[i] with i the index in this formula
+      Ssiz_t ipos = 0;
+      while ((ipos = der.Index("p[", ipos)) != kNPOS) {
+         Ssiz_t iend = der.Index("]", ipos+2);
+         if (iend == kNPOS) { ok = false; break; }
+         Int_t iorig = TString(der(ipos+2, iend-ipos-2)).Atoi();
+         TString repl = TString("[") + GetParName(iorig) + "]";
+         der.Replace(ipos, iend-ipos+1, repl);
+         ipos += repl.Length();
+      }
+      if (!ok) break;
+
+      TFormula *df = new TFormula(TString::Format("%s_dpar%d", GetName(), ipar), der, false);
+      if (!df->IsValid()) {
+         Warning("GenerateGradientPar", "invalid derivative expression %s", der.Data());
+         delete df;
+         ok = false;
+         break;
+      }
+      // map the parameters of the derivative formula onto the indices here
+      parmaps[ipar].resize(df->GetNpar());
+      for (Int_t j = 0; j < df->GetNpar() && ok; ++j) {
+         Int_t iorig = GetParNumber(df->GetParName(j));
+         if (iorig < 0 || iorig >= fNpar) ok = false;
+         else parmaps[ipar][j] = iorig;
+      }
+      grads[ipar] = df;
+   }
+
+   if (!ok) {
+      for (auto grad : grads) delete grad;
+      return kFALSE;
+   }
+   fGradFormulas.swap(grads);
+   fGradParMap.swap(parmaps);
+   fGradState = 1;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true when analytic parameter derivatives are available for this
+/// formula; they are generated by symbolic differentiation at the first call.
+/// When false is returned the caller should differentiate numerically.
+
+Bool_t TFormula::HasGradientPar()
+{
+   if (fGradState < 0) GenerateGradientPar();
+   return fGradState == 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the analytic derivative of the formula with respect to parameter
+/// ipar at the point x, using the current parameter values. Returns zero when
+/// the derivatives are not available (see HasGradientPar) or the formula does
+/// not depend on the parameter.
+
+Double_t TFormula::GradientPar(Int_t ipar, const Double_t *x)
+{
+   if (!HasGradientPar()) return 0;
+   if (ipar < 0 || ipar >= (Int_t)fGradFormulas.size()) return 0;
+   TFormula *df = fGradFormulas[ipar];
+   if (!df) return 0;
+
+   const std::vector<Int_t> &parmap = fGradParMap[ipar];
+   if (parmap.empty()) return df->EvalPar(x);
+   std::vector<Double_t> dpar(parmap.size());
+   for (size_t j = 0; j < parmap.size(); ++j)
+      dpar[j] = GetParameter(parmap[j]);
+   return df->EvalPar(x, dpar.data());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the expression formula.
 ///
@@ -2173,6 +2173,33 @@ void TGraph::SetPoint(Int_t i, Double_t x, Double_t y)
    if (gPad) gPad->Modified();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the graph to the n points given in the x and y arrays, replacing the
+/// current content. The storage is reallocated at most once (to exactly n
+/// points, since the final size is known) and both coordinate arrays are
+/// copied in bulk, which is much faster than a SetPoint loop when loading
+/// large graphs from buffered data.
+
+void TGraph::SetPoints(Int_t n, const Double_t *x, const Double_t *y)
+{
+   if (n < 0 || !x || !y) return;
+   if (fHistogram) SetBit(kResetHisto);
+
+   if (n > fMaxSize) {
+      Expand(n, 1);
+   }
+   if (n > fNpoints) {
+      // initialize the additional arrays of the descendant classes
+      FillZero(fNpoints, n);
+   }
+   if (n > 0) {
+      memcpy(fX, x, n * sizeof(Double_t));
+      memcpy(fY, y, n * sizeof(Double_t));
+   }
+   fNpoints = n;
+   if (gPad) gPad->Modified();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set graph title.
 
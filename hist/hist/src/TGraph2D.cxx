@@ -1725,6 +1725,48 @@ void TGraph2D::SetPoint(Int_t n, Double_t x, Double_t y, Double_t z)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sets the graph to the n points given in the x, y and z arrays, replacing
+/// the current content. The storage is reallocated at most once (to exactly
+/// n points, since the final size is known), the three coordinate arrays are
+/// copied in bulk, and the internal histogram with its Delaunay
+/// triangulation is invalidated once at the end instead of per point.
+
+void TGraph2D::SetPoints(Int_t n, const Double_t *x, const Double_t *y, const Double_t *z)
+{
+   if (n < 0 || !x || !y || !z) return;
+
+   if (n > fSize) {
+      // re-allocate the object in one step, the final size is known
+      delete [] fX;
+      delete [] fY;
+      delete [] fZ;
+      fSize = n;
+      fX = new Double_t[fSize];
+      fY = new Double_t[fSize];
+      fZ = new Double_t[fSize];
+   }
+   if (n > 0) {
+      memcpy(fX, x, n * sizeof(Double_t));
+      memcpy(fY, y, n * sizeof(Double_t));
+      memcpy(fZ, z, n * sizeof(Double_t));
+   }
+   fNpoints = n;
+
+   // The histogram and the Delaunay triangulation (owned by the histogram's
+   // list of functions) describe the old points: rebuild them on demand.
+   if (fHistogram && !fUserHisto) {
+      delete fHistogram;
+      fHistogram = 0;
+   } else if (fHistogram && fDelaunay) {
+      // keep the user histogram but drop the stale triangulation
+      fHistogram->GetListOfFunctions()->Remove(fDelaunay);
+      delete fDelaunay;
+   }
+   fDelaunay = nullptr;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets graph title
 
@@ -524,6 +524,7 @@ TF1 *gF1=0;  //left for back compatibility (use TVirtualFitter::GetUserFunc inst
 Int_t  TH1::fgBufferSize   = 1000;
 Bool_t TH1::fgAddDirectory = kTRUE;
 Bool_t TH1::fgDefaultSumw2 = kFALSE;
+Bool_t TH1::fgDeferredSumw2 = kFALSE;
 Bool_t TH1::fgStatOverflows= kFALSE;
 
 extern void H1InitGaus();
@@ -898,6 +899,9 @@ Bool_t TH1::Add(const TH1 *h1, Double_t c1)
       return (iret >= 0);
    }
 
+   // materialize a deferred sum of squares of weights: after this
+   // operation the errors can no longer be recovered from the contents
+   if (TestBit(kDeferSumw2) && !fSumw2.fN) Sumw2();
    //    Create Sumw2 if h1 has Sumw2 set
    if (fSumw2.fN == 0 && h1->GetSumw2N() != 0) Sumw2();
 
@@ -1070,6 +1074,9 @@ Bool_t TH1::Add(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2)
       }
    }
 
+   // materialize a deferred sum of squares of weights: after this
+   // operation the errors can no longer be recovered from the contents
+   if (TestBit(kDeferSumw2) && !fSumw2.fN) Sumw2();
    //    Create Sumw2 if h1 or h2 have Sumw2 set
    if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0)) Sumw2();
 
@@ -2608,6 +2615,10 @@ Bool_t TH1::Divide(TF1 *f1, Double_t c1)
       return kFALSE;
    }
 
+   // materialize a deferred sum of squares of weights: after this
+   // operation the errors can no longer be recovered from the contents
+   if (TestBit(kDeferSumw2) && !fSumw2.fN) Sumw2();
+
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
 
@@ -2692,6 +2703,9 @@ Bool_t TH1::Divide(const TH1 *h1)
       Warning("Divide","Dividing histograms with different labels");
    }
 
+   // materialize a deferred sum of squares of weights: after this
+   // operation the errors can no longer be recovered from the contents
+   if (TestBit(kDeferSumw2) && !fSumw2.fN) Sumw2();
    //    Create Sumw2 if h1 has Sumw2 set
    if (fSumw2.fN == 0 && h1->GetSumw2N() != 0) Sumw2();
 
@@ -2771,6 +2785,9 @@ Bool_t TH1::Divide(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2, Optio
       return kFALSE;
    }
 
+   // materialize a deferred sum of squares of weights: after this
+   // operation the errors can no longer be recovered from the contents
+   if (TestBit(kDeferSumw2) && !fSumw2.fN) Sumw2();
    //    Create Sumw2 if h1 or h2 have Sumw2 set
    if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0)) Sumw2();
 
@@ -3256,6 +3273,44 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
    ntimes *= stride;
+
+   if (!fXaxis.CanExtend() && !fXaxis.GetXbins()->fN) {
+      // Fast path for a fixed-bin-width axis: the bin index is computed with
+      // plain arithmetic instead of a virtual FindBin call per value, and the
+      // loop is simple enough for the compiler to vectorize the index and
+      // statistics computations.
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         // Decide once on the Sumw2 storage instead of testing per entry.
+         for (i=0;i<ntimes;i+=stride) {
+            if (w[i] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Double_t xmin = fXaxis.GetXmin();
+      const Double_t xmax = fXaxis.GetXmax();
+      Double_t tsumw = 0, tsumw2 = 0, tsumwx = 0, tsumwx2 = 0;
+      for (i=0;i<ntimes;i+=stride) {
+         // Same binning formula as TAxis::FindFixBin.
+         if (x[i] < xmin)         bin = 0;
+         else if (!(x[i] < xmax)) bin = nbins+1;
+         else                     bin = 1 + Int_t(nbins*(x[i]-xmin)/(xmax-xmin));
+         if (w) ww = w[i];
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if (bin == 0 || bin > nbins) {
+            if (!fgStatOverflows) continue;
+         }
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*x[i];
+         tsumwx2 += ww*x[i]*x[i];
+      }
+      fTsumw   += tsumw;
+      fTsumw2  += tsumw2;
+      fTsumwx  += tsumwx;
+      fTsumwx2 += tsumwx2;
+      return;
+   }
+
    for (i=0;i<ntimes;i+=stride) {
       bin =fXaxis.FindBin(x[i]);
       if (bin <0) continue;
@@ -4046,6 +4101,15 @@ Bool_t TH1::GetDefaultSumw2()
    return fgDefaultSumw2;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the allocation of the sum of squares of weights is
+/// deferred until it is really needed. See TH1::SetDeferredSumw2.
+
+Bool_t TH1::GetDeferredSumw2()
+{
+   return fgDeferredSumw2;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the current number of entries.
 
@@ -5366,6 +5430,10 @@ Bool_t TH1::Multiply(TF1 *f1, Double_t c1)
       return kFALSE;
    }
 
+   // materialize a deferred sum of squares of weights: after this
+   // operation the errors can no longer be recovered from the contents
+   if (TestBit(kDeferSumw2) && !fSumw2.fN) Sumw2();
+
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
 
@@ -5444,6 +5512,9 @@ Bool_t TH1::Multiply(const TH1 *h1)
       Warning("Multiply","Attempt to multiply histograms with different labels");
    }
 
+   // materialize a deferred sum of squares of weights: after this
+   // operation the errors can no longer be recovered from the contents
+   if (TestBit(kDeferSumw2) && !fSumw2.fN) Sumw2();
    //    Create Sumw2 if h1 has Sumw2 set
    if (fSumw2.fN == 0 && h1->GetSumw2N() != 0) Sumw2();
 
@@ -5507,6 +5578,9 @@ Bool_t TH1::Multiply(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2, Opt
       Warning("Multiply","Attempt to multiply histograms with different labels");
    }
 
+   // materialize a deferred sum of squares of weights: after this
+   // operation the errors can no longer be recovered from the contents
+   if (TestBit(kDeferSumw2) && !fSumw2.fN) Sumw2();
    //    Create Sumw2 if h1 or h2 have Sumw2 set
    if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0)) Sumw2();
 
@@ -6013,6 +6087,23 @@ void TH1::SetDefaultSumw2(Bool_t sumw2)
    fgDefaultSumw2 = sumw2;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// When this static function is called with `defer=kTRUE`, TH1::Sumw2 on an
+/// empty histogram does not allocate the array: it only sets the
+/// TH1::kDeferSumw2 bit. While every fill has weight one the array would be
+/// identical to the bin contents and GetBinError returns the same values
+/// without it, so unweighted jobs booking many histograms with
+/// SetDefaultSumw2 active save half the memory and a store per fill. The
+/// array is synthesized from the contents at the first fill with a non-unit
+/// weight or by the first operation that has to propagate errors
+/// (Add, Divide, Multiply, Scale, SetBinError). Profile histograms keep
+/// their own, always eager, Sumw2 semantics.
+
+void TH1::SetDeferredSumw2(Bool_t defer)
+{
+   fgDeferredSumw2 = defer;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change (i.e. set) the title
 ///
@@ -7039,6 +7130,17 @@ void TH1::GetStats(Double_t *stats) const
          if (firstBinX == 1) firstBinX = 0;
          if (lastBinX ==  fXaxis.GetNbins() ) lastBinX += 1;
       }
+      if (fDimension == 1) {
+         // Answer the query from the per-bin prefix sums, rebuilt only when
+         // the filled statistics changed: repeated range-restricted queries
+         // (e.g. a GUI refreshing a zoomed view) cost O(1) instead of a
+         // loop over all bins.
+         UpdateStatPrefix();
+         const Double_t *prefix = fStatPrefix.GetArray();
+         for (bin = 0; bin < 4; bin++)
+            stats[bin] = prefix[4*(lastBinX+1) + bin] - prefix[4*firstBinX + bin];
+         return;
+      }
       for (binx = firstBinX; binx <= lastBinX; binx++) {
          x   = fXaxis.GetBinCenter(binx);
          //w   = TMath::Abs(RetrieveBinContent(binx));
@@ -7062,6 +7164,58 @@ void TH1::GetStats(Double_t *stats) const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Rebuild, if the filled statistics or the axis changed since the last
+/// call, the transient per-bin prefix sums of (w, err^2, w*x, w*x^2) that
+/// GetStats uses to answer axis-range-restricted queries in O(1).
+/// Only used for 1-D histograms. Every content change (Fill, SetBinContent,
+/// Add, ...) updates fEntries or the fTsumw sums and so triggers a rebuild
+/// at the next query; the validity key also covers the axis limits and the
+/// number of variable bin edges, since a SetBins with an unchanged number
+/// of bins moves every bin center without touching the filled sums (and
+/// SetBins drops the cache outright, which also covers a relimit to
+/// identical axis parameters with different variable edges). Like fTsumw2
+/// itself, the cache does not notice a bare SetBinError.
+/// Being rebuilt lazily from const GetStats, the cache makes concurrent
+/// unsynchronized read-only queries on the same histogram a data race, as
+/// for the fBuffer flush in GetBinContent; guard such access externally.
+
+void TH1::UpdateStatPrefix() const
+{
+   Int_t nbins = fXaxis.GetNbins();
+   Int_t np = 4*(nbins + 3);
+   if (fStatPrefix.fN == np &&
+       fStatPrefixKey[0] == fEntries && fStatPrefixKey[1] == fTsumw &&
+       fStatPrefixKey[2] == fTsumw2  && fStatPrefixKey[3] == fTsumwx &&
+       fStatPrefixKey[4] == fTsumwx2 &&
+       fStatPrefixKey[5] == fXaxis.GetXmin() &&
+       fStatPrefixKey[6] == fXaxis.GetXmax() &&
+       fStatPrefixKey[7] == (Double_t)fXaxis.GetXbins()->fN) {
+      return;
+   }
+
+   fStatPrefix.Set(np);
+   Double_t *prefix = fStatPrefix.GetArray();
+   prefix[0] = prefix[1] = prefix[2] = prefix[3] = 0;
+   for (Int_t binx = 0; binx <= nbins+1; binx++) {
+      Double_t x   = fXaxis.GetBinCenter(binx);
+      Double_t w   = RetrieveBinContent(binx);
+      Double_t err = TMath::Abs(GetBinError(binx));
+      prefix[4*(binx+1)    ] = prefix[4*binx    ] + w;
+      prefix[4*(binx+1) + 1] = prefix[4*binx + 1] + err*err;
+      prefix[4*(binx+1) + 2] = prefix[4*binx + 2] + w*x;
+      prefix[4*(binx+1) + 3] = prefix[4*binx + 3] + w*x*x;
+   }
+   fStatPrefixKey[0] = fEntries;
+   fStatPrefixKey[1] = fTsumw;
+   fStatPrefixKey[2] = fTsumw2;
+   fStatPrefixKey[3] = fTsumwx;
+   fStatPrefixKey[4] = fTsumwx2;
+   fStatPrefixKey[5] = fXaxis.GetXmin();
+   fStatPrefixKey[6] = fXaxis.GetXmax();
+   fStatPrefixKey[7] = (Double_t)fXaxis.GetXbins()->fN;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Replace current statistics with the values in array stats
 
@@ -7887,6 +8041,7 @@ void TH1::SetBins(Int_t nx, Double_t xmin, Double_t xmax)
    fZaxis.Set(1,0,1);
    fNcells = nx+2;
    SetBinsLength(fNcells);
+   fStatPrefix.Set(0);   // the bin centers changed, drop the stat prefix sums
    if (fSumw2.fN) {
       fSumw2.Set(fNcells);
    }
@@ -7914,6 +8069,7 @@ void TH1::SetBins(Int_t nx, const Double_t *xBins)
    fZaxis.Set(1,0,1);
    fNcells = nx+2;
    SetBinsLength(fNcells);
+   fStatPrefix.Set(0);   // the bin centers changed, drop the stat prefix sums
    if (fSumw2.fN) {
       fSumw2.Set(fNcells);
    }
@@ -8129,8 +8285,21 @@ void TH1::Sumw2(Bool_t flag)
    if (!flag) {
       // clear the array if existing - do nothing otherwise
       if (fSumw2.fN > 0 ) fSumw2.Set(0);
+      ResetBit(kDeferSumw2);
+      return;
+   }
+
+   // In deferred mode (see SetDeferredSumw2) a first call on a pristine
+   // histogram only records that error storage was requested: as long as
+   // every fill has weight one, the per-bin sum of squares equals the bin
+   // content and GetBinError computes the same sqrt. A later call - from
+   // the weighted-fill path or from an operation that needs the errors -
+   // synthesizes the array from the contents as below.
+   if (fgDeferredSumw2 && !fSumw2.fN && !fEntries && !TestBit(kDeferSumw2)) {
+      SetBit(kDeferSumw2);
       return;
    }
+   ResetBit(kDeferSumw2);
 
    if (fSumw2.fN == fNcells) {
       if (!fgDefaultSumw2 )
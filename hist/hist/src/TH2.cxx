@@ -24,6 +24,11 @@
 #include "TMath.h"
 #include "TObjString.h"
 #include "TVirtualHistPainter.h"
+#include <vector>
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 
 ClassImp(TH2)
@@ -552,6 +557,64 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
+
+   if (!fXaxis.CanExtend() && !fXaxis.GetXbins()->fN &&
+       !fYaxis.CanExtend() && !fYaxis.GetXbins()->fN) {
+      // Fast path when both axes have fixed bin widths: the bin indices are
+      // computed with plain arithmetic instead of a virtual FindBin call per
+      // value, which also lets the compiler vectorize the index and
+      // statistics computations.
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         // Decide once on the Sumw2 storage instead of testing per entry.
+         for (i=ifirst;i<ntimes;i+=stride) {
+            if (w[i] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Int_t nbinsx = fXaxis.GetNbins();
+      const Int_t nbinsy = fYaxis.GetNbins();
+      const Double_t xmin = fXaxis.GetXmin();
+      const Double_t xmax = fXaxis.GetXmax();
+      const Double_t ymin = fYaxis.GetXmin();
+      const Double_t ymax = fYaxis.GetXmax();
+      Double_t tsumw = 0, tsumw2 = 0, tsumwx = 0, tsumwx2 = 0;
+      Double_t tsumwy = 0, tsumwy2 = 0, tsumwxy = 0;
+      for (i=ifirst;i<ntimes;i+=stride) {
+         fEntries++;
+         // Same binning formula as TAxis::FindFixBin.
+         if (x[i] < xmin)         binx = 0;
+         else if (!(x[i] < xmax)) binx = nbinsx+1;
+         else                     binx = 1 + Int_t(nbinsx*(x[i]-xmin)/(xmax-xmin));
+         if (y[i] < ymin)         biny = 0;
+         else if (!(y[i] < ymax)) biny = nbinsy+1;
+         else                     biny = 1 + Int_t(nbinsy*(y[i]-ymin)/(ymax-ymin));
+         bin = biny*(nbinsx+2) + binx;
+         if (w) ww = w[i];
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > nbinsx) {
+            if (!fgStatOverflows) continue;
+         }
+         if (biny == 0 || biny > nbinsy) {
+            if (!fgStatOverflows) continue;
+         }
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*x[i];
+         tsumwx2 += ww*x[i]*x[i];
+         tsumwy  += ww*y[i];
+         tsumwy2 += ww*y[i]*y[i];
+         tsumwxy += ww*x[i]*y[i];
+      }
+      fTsumw   += tsumw;
+      fTsumw2  += tsumw2;
+      fTsumwx  += tsumwx;
+      fTsumwx2 += tsumwx2;
+      fTsumwy  += tsumwy;
+      fTsumwy2 += tsumwy2;
+      fTsumwxy += tsumwxy;
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
@@ -2157,39 +2220,89 @@ TH1D *TH2::DoProjection(bool onX, const char *name, Int_t firstbin, Int_t lastbi
    h1->SetMarkerStyle(this->GetMarkerStyle());
 
    // Fill the projected histogram
-   Double_t cont,err2;
    Double_t totcont = 0;
    Bool_t  computeErrors = h1->GetSumw2N();
 
+   // flush the fill buffer here; the generic loop below did it implicitly
+   // through the first GetBinContent call
+   if (fBuffer) const_cast<TH2*>(this)->BufferEmpty();
+
    // implement filling of projected histogram
    // outbin is bin number of outAxis (the projected axis). Loop is done on all bin of TH2 histograms
    // inbin is the axis being integrated. Loop is done only on the selected bins
-   for ( Int_t outbin = 0; outbin <= outAxis->GetNbins() + 1;  ++outbin) {
-      err2 = 0;
-      cont = 0;
-      if (outAxis->TestBit(TAxis::kAxisRange) && ( outbin < firstOutBin || outbin > lastOutBin )) continue;
-
-      for (Int_t inbin = firstbin ; inbin <= lastbin ; ++inbin) {
-         Int_t binx, biny;
-         if (onX) { binx = outbin; biny=inbin; }
-         else     { binx = inbin;  biny=outbin; }
-
-         if (ncuts) {
-            if (!fPainter->IsInside(binx,biny)) continue;
+   Int_t loOut = 0, hiOut = outAxis->GetNbins() + 1;
+   if (outAxis->TestBit(TAxis::kAxisRange)) { loOut = firstOutBin; hiOut = lastOutBin; }
+
+   std::vector<Double_t> contv(outAxis->GetNbins()+2, 0.);
+   std::vector<Double_t> errv(outAxis->GetNbins()+2, 0.);
+
+   // for the common concrete types walk the bin array directly: the
+   // generic loop pays a virtual call (and a square root, when errors
+   // are computed) for every cell
+   const Float_t  *farr = (!ncuts && IsA() == TH2F::Class()) ? ((const TH2F*)this)->fArray : 0;
+   const Double_t *darr = (!ncuts && IsA() == TH2D::Class()) ? ((const TH2D*)this)->fArray : 0;
+   const Double_t *sw2  = fSumw2.fN ? fSumw2.fArray : 0;
+   const Int_t nx2 = fXaxis.GetNbins() + 2;
+   const Int_t stride = onX ? nx2 : 1;
+
+   auto sumOutBin = [&](Int_t outbin) {
+      Double_t cont = 0, err2 = 0;
+      if (farr || darr) {
+         Int_t idx = onX ? outbin + nx2*firstbin : firstbin + nx2*outbin;
+         for (Int_t inbin = firstbin ; inbin <= lastbin ; ++inbin, idx += stride) {
+            Double_t cu = farr ? (Double_t)farr[idx] : darr[idx];
+            cont += cu;
+            // without Sumw2 the bin error is sqrt(|content|)
+            if (computeErrors) err2 += sw2 ? sw2[idx] : TMath::Abs(cu);
          }
-         // sum bin content and error if needed
-         cont  += GetBinContent(binx,biny);
-         if (computeErrors) {
-            Double_t exy = GetBinError(binx,biny);
-            err2  += exy*exy;
+      } else {
+         for (Int_t inbin = firstbin ; inbin <= lastbin ; ++inbin) {
+            Int_t binx, biny;
+            if (onX) { binx = outbin; biny=inbin; }
+            else     { binx = inbin;  biny=outbin; }
+
+            if (ncuts) {
+               if (!fPainter->IsInside(binx,biny)) continue;
+            }
+            // sum bin content and error if needed
+            cont  += GetBinContent(binx,biny);
+            if (computeErrors) {
+               Double_t exy = GetBinError(binx,biny);
+               err2  += exy*exy;
+            }
          }
       }
+      contv[outbin] = cont;
+      errv[outbin] = err2;
+   };
+
+#ifdef R__USE_IMT
+   // every output bin sums an independent row (column) of cells, so the
+   // sums can be computed in parallel; the write back into h1 below stays
+   // serial because SetBinContent updates shared statistics
+   if ((farr || darr) && ROOT::IsImplicitMTEnabled() &&
+       (Long64_t)(hiOut-loOut+1)*(lastbin-firstbin+1) > 65536) {
+      const Int_t rowGrain = 16;
+      const Int_t nchunks = (hiOut - loOut) / rowGrain + 1;
+      auto sumChunk = [&](Int_t ichunk) {
+         Int_t lo = loOut + ichunk*rowGrain;
+         Int_t hi = TMath::Min(lo + rowGrain - 1, hiOut);
+         for (Int_t outbin = lo; outbin <= hi; ++outbin) sumOutBin(outbin);
+         return 0;
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Map(sumChunk, ROOT::TSeqI(nchunks));
+   } else
+#endif
+   for (Int_t outbin = loOut; outbin <= hiOut; ++outbin) sumOutBin(outbin);
+
+   for (Int_t outbin = loOut; outbin <= hiOut; ++outbin) {
       // find corresponding bin number in h1 for outbin
       Int_t binOut = h1->GetXaxis()->FindBin( outAxis->GetBinCenter(outbin) );
-      h1->SetBinContent(binOut ,cont);
-      if (computeErrors) h1->SetBinError(binOut,TMath::Sqrt(err2));
+      h1->SetBinContent(binOut, contv[outbin]);
+      if (computeErrors) h1->SetBinError(binOut, TMath::Sqrt(errv[outbin]));
       // sum  all content
-      totcont += cont;
+      totcont += contv[outbin];
    }
 
    // check if we can re-use the original statistics from  the previous histogram
@@ -2608,53 +2721,85 @@ void TH2::Smooth(Int_t ntimes, Option_t *option)
    Double_t *ebuf = 0;
    if (fSumw2.fN) ebuf = new Double_t[bufSize];
 
-   // Copy all the data to the temporary buffers
-   Int_t i,j,bin;
-   for (i=ifirst; i<=ilast; i++){
-      for (j=jfirst; j<=jlast; j++){
-         bin = GetBin(i,j);
-         buf[bin] = RetrieveBinContent(bin);
-         if (ebuf) ebuf[bin]=GetBinError(bin);
-      }
+   // Copy all the data to the temporary buffers.
+   // The complete histogram area is copied (not only the smoothed range):
+   // the kernel reaches up to one kernel tail outside of the range and the
+   // bins there were read uninitialized before.
+   if (fBuffer) BufferEmpty();
+   for (Int_t bin = 0; bin < bufSize; ++bin) {
+      buf[bin] = RetrieveBinContent(bin);
+      if (ebuf) ebuf[bin] = GetBinError(bin);
    }
 
    // Kernel tail sizes (kernel sizes must be odd for this to work!)
    Int_t x_push = (ksize_x-1)/2;
    Int_t y_push = (ksize_y-1)/2;
 
-   // main work loop
-   for (i=ifirst; i<=ilast; i++){
-      for (j=jfirst; j<=jlast; j++) {
-         Double_t content = 0.0;
-         Double_t error = 0.0;
-         Double_t norm = 0.0;
-
-         for (Int_t n=0; n<ksize_x; n++) {
-            for (Int_t m=0; m<ksize_y; m++) {
-               Int_t xb = i+(n-x_push);
-               Int_t yb = j+(m-y_push);
-               if ( (xb >= 1) && (xb <= nx) && (yb >= 1) && (yb <= ny) ) {
-                  bin = GetBin(xb,yb);
-                  Double_t k = kernel[n*ksize_y +m];
-                  //if ( (k != 0.0 ) && (buf[bin] != 0.0) ) { // General version probably does not want the second condition
-                  if ( k != 0.0 ) {
-                     norm    += k;
-                     content += k*buf[bin];
-                     if (ebuf) error   += k*k*ebuf[bin]*ebuf[bin];
-                  }
+   const Int_t ncol = ilast - ifirst + 1;
+
+   // Convolve one output row. The kernel element is kept in the outer
+   // loops, so the inner loop walks source and accumulators contiguously
+   // and can be vectorized by the compiler.
+   auto smoothRow = [&](Int_t j) {
+      std::vector<Double_t> cont(ncol, 0.), norm(ncol, 0.), err;
+      if (ebuf) err.resize(ncol, 0.);
+
+      for (Int_t n=0; n<ksize_x; n++) {
+         Int_t dx = n - x_push;
+         // clip the kernel column against the histogram x range
+         Int_t ilo = TMath::Max(ifirst, 1 - dx);
+         Int_t ihi = TMath::Min(ilast, nx - dx);
+         if (ilo > ihi) continue;
+         for (Int_t m=0; m<ksize_y; m++) {
+            Double_t k = kernel[n*ksize_y +m];
+            if (k == 0.0) continue;
+            Int_t yb = j + (m - y_push);
+            if ((yb < 1) || (yb > ny)) continue;
+
+            const Double_t *src = buf + GetBin(ilo + dx, yb);
+            Double_t *ctgt = &cont[ilo - ifirst];
+            Double_t *ntgt = &norm[ilo - ifirst];
+            if (ebuf) {
+               const Double_t *esrc = ebuf + GetBin(ilo + dx, yb);
+               Double_t *etgt = &err[ilo - ifirst];
+               Double_t k2 = k*k;
+               for (Int_t i = 0; i <= ihi - ilo; i++) {
+                  ctgt[i] += k*src[i];
+                  ntgt[i] += k;
+                  etgt[i] += k2*esrc[i]*esrc[i];
+               }
+            } else {
+               for (Int_t i = 0; i <= ihi - ilo; i++) {
+                  ctgt[i] += k*src[i];
+                  ntgt[i] += k;
                }
             }
          }
+      }
 
-         if ( norm != 0.0 ) {
-            SetBinContent(i,j,content/norm);
-            if (ebuf) {
-               error /= (norm*norm);
-               SetBinError(i,j,sqrt(error));
-            }
-         }
+      for (Int_t i = ifirst; i <= ilast; i++) {
+         Double_t nrm = norm[i - ifirst];
+         if (nrm == 0.0) continue;
+         Int_t obin = GetBin(i, j);
+         UpdateBinContent(obin, cont[i - ifirst]/nrm);
+         if (ebuf) fSumw2.fArray[obin] = err[i - ifirst]/(nrm*nrm);
       }
-   }
+   };
+
+#ifdef R__USE_IMT
+   // rows only read the buffers and write their own bins, so they can be
+   // distributed when the histogram is big enough for the task overhead
+   if (ROOT::IsImplicitMTEnabled() && (Long64_t)(jlast-jfirst+1)*ncol > 65536) {
+      auto smoothRowTask = [&](Int_t j) { smoothRow(j); return 0; };
+      ROOT::TThreadExecutor pool;
+      pool.Map(smoothRowTask, ROOT::TSeqI(jfirst, jlast+1));
+   } else
+#endif
+   for (Int_t j=jfirst; j<=jlast; j++) smoothRow(j);
+
+   // writing through UpdateBinContent left the statistics untouched;
+   // invalidate them like the SetBinContent calls of the per-bin loop did
+   fTsumw = 0;
    fEntries = nentries;
 
    delete [] buf;
@@ -0,0 +1,131 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TH2Sparse.h"
+
+/** \class TH2Sparse
+    \ingroup Hist
+2-Dim histogram with chunked sparse bin storage.
+
+TH2Sparse has the full TH2 interface of a TH2D but does not allocate a
+dense content array: bin contents live in a THSparseStore, which
+allocates fixed size chunks (like the chunks of THnSparse) only for the
+regions of the histogram that are actually hit, accumulates in single
+precision and spills a chunk to double precision when float rounding
+would lose an increment. A mostly empty histogram therefore costs a few
+kB instead of 8 bytes per bin, while heavily filled regions keep full
+double precision counts.
+
+Fill, Add, Scale, Divide, Merge, projections, fitting, drawing and I/O
+all go through the common TH1 bin content interface and work
+transparently; the storage is written to and read back from ROOT files
+by the automatic schema. Use it as a drop-in storage policy choice at
+creation time, where a TH2D would waste memory:
+~~~~{.cpp}
+  TH2Sparse *map = new TH2Sparse("map","acceptance",2000,-5,5,2000,-3.2,3.2);
+~~~~
+GetStoreBytes() and GetStoreOccupancy() report the memory actually used
+and the fraction of chunks allocated.
+
+Note that the error array filled by Sumw2() remains dense: enable it
+only when weighted errors are really needed, or the error array will
+cost what the content array saved.
+*/
+
+ClassImp(TH2Sparse)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH2Sparse::TH2Sparse(): TH2(), THSparseStore()
+{
+   SetBinsLength(9);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TH2Sparse::~TH2Sparse()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for fix bin size 2-D histograms.
+
+TH2Sparse::TH2Sparse(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+                     ,Int_t nbinsy,Double_t ylow,Double_t yup)
+                     :TH2(name,title,nbinsx,xlow,xup,nbinsy,ylow,yup)
+{
+   SetStoreSize(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+
+   if (xlow >= xup || ylow >= yup) SetBuffer(fgBufferSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for variable bin size 2-D histograms.
+
+TH2Sparse::TH2Sparse(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+                     ,Int_t nbinsy,const Double_t *ybins)
+                     :TH2(name,title,nbinsx,xbins,nbinsy,ybins)
+{
+   SetStoreSize(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor.
+
+TH2Sparse::TH2Sparse(const TH2Sparse &h2s) : TH2(), THSparseStore()
+{
+   ((TH2Sparse&)h2s).Copy(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy this 2-D histogram structure to newth2.
+
+void TH2Sparse::Copy(TObject &newth2) const
+{
+   // size and clear the target store up front: TH1::Copy transfers the
+   // contents cell by cell through UpdateBinContent
+   ((TH2Sparse&)newth2).SetStoreSize(fNcells);
+   ((TH2Sparse&)newth2).ResetStore();
+   TH2::Copy((TH2Sparse&)newth2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset this histogram: contents, errors, etc.
+
+void TH2Sparse::Reset(Option_t *option)
+{
+   TH2::Reset(option);
+   ResetStore();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set total number of bins including under/overflow.
+/// Resize the chunk map of the sparse store accordingly.
+
+void TH2Sparse::SetBinsLength(Int_t n)
+{
+   if (n < 0) n = (fXaxis.GetNbins()+2)*(fYaxis.GetNbins()+2);
+   fNcells = n;
+   SetStoreSize(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Operator =
+
+TH2Sparse& TH2Sparse::operator=(const TH2Sparse &h1)
+{
+   if (this != &h1)  ((TH2Sparse&)h1).Copy(*this);
+   return *this;
+}
@@ -641,6 +641,158 @@ Int_t TH3::Fill(Double_t x, Double_t y, const char *namez, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y and z (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+///
+/// NB: function only valid for a TH3x object
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z,
+                const Double_t *w, Int_t stride)
+{
+   Int_t binx, biny, binz, bin, i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   // (note that this function must not be called from TH3::BufferEmpty)
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         if (w) BufferFill(x[i],y[i],z[i],w[i]);
+         else BufferFill(x[i], y[i], z[i], 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   Double_t ww = 1;
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+   const Int_t nbinsz = fZaxis.GetNbins();
+
+   if (!fXaxis.CanExtend() && !fXaxis.GetXbins()->fN &&
+       !fYaxis.CanExtend() && !fYaxis.GetXbins()->fN &&
+       !fZaxis.CanExtend() && !fZaxis.GetXbins()->fN) {
+      // Fast path when all axes have fixed bin widths: the bin indices are
+      // computed with plain arithmetic instead of a virtual FindBin call per
+      // value, which also lets the compiler vectorize the index and
+      // statistics computations.
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         // Decide once on the Sumw2 storage instead of testing per entry.
+         for (i=ifirst;i<ntimes;i+=stride) {
+            if (w[i] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Double_t xmin = fXaxis.GetXmin();
+      const Double_t xmax = fXaxis.GetXmax();
+      const Double_t ymin = fYaxis.GetXmin();
+      const Double_t ymax = fYaxis.GetXmax();
+      const Double_t zmin = fZaxis.GetXmin();
+      const Double_t zmax = fZaxis.GetXmax();
+      Double_t tsumw = 0, tsumw2 = 0, tsumwx = 0, tsumwx2 = 0;
+      Double_t tsumwy = 0, tsumwy2 = 0, tsumwxy = 0;
+      Double_t tsumwz = 0, tsumwz2 = 0, tsumwxz = 0, tsumwyz = 0;
+      for (i=ifirst;i<ntimes;i+=stride) {
+         fEntries++;
+         // Same binning formula as TAxis::FindFixBin.
+         if (x[i] < xmin)         binx = 0;
+         else if (!(x[i] < xmax)) binx = nbinsx+1;
+         else                     binx = 1 + Int_t(nbinsx*(x[i]-xmin)/(xmax-xmin));
+         if (y[i] < ymin)         biny = 0;
+         else if (!(y[i] < ymax)) biny = nbinsy+1;
+         else                     biny = 1 + Int_t(nbinsy*(y[i]-ymin)/(ymax-ymin));
+         if (z[i] < zmin)         binz = 0;
+         else if (!(z[i] < zmax)) binz = nbinsz+1;
+         else                     binz = 1 + Int_t(nbinsz*(z[i]-zmin)/(zmax-zmin));
+         bin = binx + (nbinsx+2)*(biny + (nbinsy+2)*binz);
+         if (w) ww = w[i];
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > nbinsx) {
+            if (!fgStatOverflows) continue;
+         }
+         if (biny == 0 || biny > nbinsy) {
+            if (!fgStatOverflows) continue;
+         }
+         if (binz == 0 || binz > nbinsz) {
+            if (!fgStatOverflows) continue;
+         }
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*x[i];
+         tsumwx2 += ww*x[i]*x[i];
+         tsumwy  += ww*y[i];
+         tsumwy2 += ww*y[i]*y[i];
+         tsumwxy += ww*x[i]*y[i];
+         tsumwz  += ww*z[i];
+         tsumwz2 += ww*z[i]*z[i];
+         tsumwxz += ww*x[i]*z[i];
+         tsumwyz += ww*y[i]*z[i];
+      }
+      fTsumw   += tsumw;
+      fTsumw2  += tsumw2;
+      fTsumwx  += tsumwx;
+      fTsumwx2 += tsumwx2;
+      fTsumwy  += tsumwy;
+      fTsumwy2 += tsumwy2;
+      fTsumwxy += tsumwxy;
+      fTsumwz  += tsumwz;
+      fTsumwz2 += tsumwz2;
+      fTsumwxz += tsumwxz;
+      fTsumwyz += tsumwyz;
+      return;
+   }
+
+   for (i=ifirst;i<ntimes;i+=stride) {
+      fEntries++;
+      binx = fXaxis.FindBin(x[i]);
+      biny = fYaxis.FindBin(y[i]);
+      binz = fZaxis.FindBin(z[i]);
+      if (binx <0 || biny <0 || binz <0) continue;
+      bin = binx + (nbinsx+2)*(biny + (nbinsy+2)*binz);
+      if (w) ww = w[i];
+      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+      AddBinContent(bin,ww);
+      if (binx == 0 || binx > nbinsx) {
+         if (!fgStatOverflows) continue;
+      }
+      if (biny == 0 || biny > nbinsy) {
+         if (!fgStatOverflows) continue;
+      }
+      if (binz == 0 || binz > nbinsz) {
+         if (!fgStatOverflows) continue;
+      }
+      fTsumw   += ww;
+      fTsumw2  += ww*ww;
+      fTsumwx  += ww*x[i];
+      fTsumwx2 += ww*x[i]*x[i];
+      fTsumwy  += ww*y[i];
+      fTsumwy2 += ww*y[i]*y[i];
+      fTsumwxy += ww*x[i]*y[i];
+      fTsumwz  += ww*z[i];
+      fTsumwz2 += ww*z[i]*z[i];
+      fTsumwxz += ww*x[i]*z[i];
+      fTsumwyz += ww*y[i]*z[i];
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill histogram following distribution in function fname.
 ///
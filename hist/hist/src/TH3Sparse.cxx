@@ -0,0 +1,123 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TH3Sparse.h"
+
+/** \class TH3Sparse
+    \ingroup Hist
+3-Dim histogram with chunked sparse bin storage.
+
+TH3Sparse is to TH3D what TH2Sparse is to TH2D: the full TH3 interface
+backed by a THSparseStore instead of a dense TArrayD, so that only the
+chunks of bins that are actually hit are allocated. Contents accumulate
+in single precision and a chunk spills to double precision as soon as
+float rounding would lose an increment, so large counts stay exact. A
+fine 3-D acceptance map where well below 1% of the bins are populated
+shrinks from gigabytes to the size of its populated chunks.
+
+Fill, Add, Scale, Divide, Merge, Project3D, fitting, drawing and I/O go
+through the common TH1 bin content interface and need no special
+handling. GetStoreBytes() and GetStoreOccupancy() report the memory in
+use and the fraction of chunks allocated. As for TH2Sparse, the Sumw2()
+error array remains dense and should only be enabled when needed.
+*/
+
+ClassImp(TH3Sparse)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor.
+
+TH3Sparse::TH3Sparse(): TH3(), THSparseStore()
+{
+   SetBinsLength(27);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TH3Sparse::~TH3Sparse()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for fix bin size 3-D histograms.
+
+TH3Sparse::TH3Sparse(const char *name,const char *title,Int_t nbinsx,Double_t xlow,Double_t xup
+                     ,Int_t nbinsy,Double_t ylow,Double_t yup
+                     ,Int_t nbinsz,Double_t zlow,Double_t zup)
+                     :TH3(name,title,nbinsx,xlow,xup,nbinsy,ylow,yup,nbinsz,zlow,zup)
+{
+   SetStoreSize(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+
+   if (xlow >= xup || ylow >= yup || zlow >= zup) SetBuffer(fgBufferSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for variable bin size 3-D histograms.
+
+TH3Sparse::TH3Sparse(const char *name,const char *title,Int_t nbinsx,const Double_t *xbins
+                     ,Int_t nbinsy,const Double_t *ybins
+                     ,Int_t nbinsz,const Double_t *zbins)
+                     :TH3(name,title,nbinsx,xbins,nbinsy,ybins,nbinsz,zbins)
+{
+   SetStoreSize(fNcells);
+   if (fgDefaultSumw2) Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor.
+
+TH3Sparse::TH3Sparse(const TH3Sparse &h3s) : TH3(), THSparseStore()
+{
+   ((TH3Sparse&)h3s).Copy(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy this 3-D histogram structure to newth3.
+
+void TH3Sparse::Copy(TObject &newth3) const
+{
+   // size and clear the target store up front: TH1::Copy transfers the
+   // contents cell by cell through UpdateBinContent
+   ((TH3Sparse&)newth3).SetStoreSize(fNcells);
+   ((TH3Sparse&)newth3).ResetStore();
+   TH3::Copy((TH3Sparse&)newth3);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset this histogram: contents, errors, etc.
+
+void TH3Sparse::Reset(Option_t *option)
+{
+   TH3::Reset(option);
+   ResetStore();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set total number of bins including under/overflow.
+/// Resize the chunk map of the sparse store accordingly.
+
+void TH3Sparse::SetBinsLength(Int_t n)
+{
+   if (n < 0) n = (fXaxis.GetNbins()+2)*(fYaxis.GetNbins()+2)*(fZaxis.GetNbins()+2);
+   fNcells = n;
+   SetStoreSize(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Operator =
+
+TH3Sparse& TH3Sparse::operator=(const TH3Sparse &h1)
+{
+   if (this != &h1)  ((TH3Sparse&)h1).Copy(*this);
+   return *this;
+}
@@ -0,0 +1,215 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "THSparseStore.h"
+#include "TMath.h"
+
+#include <algorithm>
+
+/** \class THSparseStore
+    \ingroup Hist
+Chunked sparse bin content store used by TH2Sparse and TH3Sparse.
+
+The global cell range (the fNcells of the histogram) is divided into
+fixed size chunks, like the chunks of THnSparse. Chunks whose cells are
+all zero are not allocated at all; a chunk map holds one Int_t per chunk
+telling where its payload lives, if anywhere. Payloads start out in
+single precision and are promoted ("spilled") to double precision when a
+cell would lose an increment to float rounding or when its magnitude
+reaches 2^24, beyond which consecutive integer counts are no longer
+representable in a float. Cells of unallocated chunks read as zero.
+
+The store is a plain mixin, not a TObject: TH2Sparse and TH3Sparse
+inherit it alongside their TH2/TH3 base exactly like TH2D inherits
+TArrayD, and its data members are streamed by the automatic schema as
+part of the histogram.
+*/
+
+ClassImp(THSparseStore)
+
+namespace {
+   // Largest magnitude up to which consecutive integer counts are exactly
+   // representable in single precision (2^24); contents at or beyond it
+   // are kept in double precision chunks.
+   const Double_t kSinglePrecisionLimit = 16777216.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct an empty store. chunkSize is the number of cells per chunk;
+/// the default of 512 cells caps the overhead of a single hit in an
+/// otherwise empty region at 2 kB.
+
+THSparseStore::THSparseStore(Int_t chunkSize)
+{
+   fStoreSize = 0;
+   fChunkSize = chunkSize > 0 ? chunkSize : 512;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+THSparseStore::~THSparseStore()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the single precision payload of the given chunk, zero filled,
+/// reusing a slot freed by an earlier promotion when one is available.
+
+Float_t *THSparseStore::AllocateChunk(Int_t chunk)
+{
+   Int_t slot;
+   if (!fFreeF.empty()) {
+      slot = fFreeF.back();
+      fFreeF.pop_back();
+      std::fill_n(&fChunksF[(size_t)slot * fChunkSize], fChunkSize, 0.f);
+   } else {
+      slot = (Int_t)(fChunksF.size() / fChunkSize);
+      fChunksF.resize(fChunksF.size() + fChunkSize, 0.f);
+   }
+   fChunkMap[chunk] = slot;
+   return &fChunksF[(size_t)slot * fChunkSize];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the given chunk to a double precision payload, copying its current
+/// single precision contents if it has any, and return the new payload.
+/// The vacated single precision slot is remembered for reuse.
+
+Double_t *THSparseStore::PromoteChunk(Int_t chunk)
+{
+   Int_t dslot = (Int_t)(fChunksD.size() / fChunkSize);
+   fChunksD.resize(fChunksD.size() + fChunkSize, 0.);
+   Double_t *d = &fChunksD[(size_t)dslot * fChunkSize];
+   Int_t fslot = fChunkMap[chunk];
+   if (fslot >= 0) {
+      const Float_t *f = &fChunksF[(size_t)fslot * fChunkSize];
+      for (Int_t i = 0; i < fChunkSize; ++i) d[i] = f[i];
+      fFreeF.push_back(fslot);
+   }
+   fChunkMap[chunk] = -(dslot + 2);
+   return d;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add w to the content of the given cell. The cell's chunk is allocated on
+/// first use and spilled to double precision when the addition would be lost
+/// to float rounding or drives the content past the single precision limit.
+
+void THSparseStore::AddBinValue(Int_t bin, Double_t w)
+{
+   if (bin < 0 || bin >= fStoreSize || w == 0) return;
+   Int_t chunk = bin / fChunkSize;
+   Int_t off   = bin - chunk * fChunkSize;
+   Int_t slot  = fChunkMap[chunk];
+   if (slot <= -2) {
+      fChunksD[(size_t)(-(slot + 2)) * fChunkSize + off] += w;
+      return;
+   }
+   Float_t *f = (slot == -1) ? AllocateChunk(chunk) : &fChunksF[(size_t)slot * fChunkSize];
+   Double_t updated = (Double_t)f[off] + w;
+   if (TMath::Abs(updated) < kSinglePrecisionLimit && (Float_t)updated != f[off]) {
+      f[off] = (Float_t)updated;
+      return;
+   }
+   PromoteChunk(chunk)[off] = updated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the content of the given cell; cells of unallocated chunks are 0.
+
+Double_t THSparseStore::GetBinValue(Int_t bin) const
+{
+   if (bin < 0 || bin >= fStoreSize) return 0;
+   Int_t slot = fChunkMap[bin / fChunkSize];
+   if (slot == -1) return 0;
+   Int_t off = bin % fChunkSize;
+   if (slot >= 0) return fChunksF[(size_t)slot * fChunkSize + off];
+   return fChunksD[(size_t)(-(slot + 2)) * fChunkSize + off];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the content of the given cell. Contents below the single precision
+/// limit are stored rounded to float, like in a TH2F/TH3F; larger contents
+/// spill the cell's chunk to double precision.
+
+void THSparseStore::SetBinValue(Int_t bin, Double_t content)
+{
+   if (bin < 0 || bin >= fStoreSize) return;
+   Int_t chunk = bin / fChunkSize;
+   Int_t off   = bin - chunk * fChunkSize;
+   Int_t slot  = fChunkMap[chunk];
+   if (slot == -1 && content == 0) return;
+   if (slot <= -2) {
+      fChunksD[(size_t)(-(slot + 2)) * fChunkSize + off] = content;
+      return;
+   }
+   if (TMath::Abs(content) >= kSinglePrecisionLimit) {
+      PromoteChunk(chunk)[off] = content;
+      return;
+   }
+   Float_t *f = (slot == -1) ? AllocateChunk(chunk) : &fChunksF[(size_t)slot * fChunkSize];
+   f[off] = (Float_t)content;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of allocated chunks.
+
+Int_t THSparseStore::GetNchunks() const
+{
+   Int_t n = 0;
+   for (size_t i = 0; i < fChunkMap.size(); ++i)
+      if (fChunkMap[i] != -1) n++;
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the memory used by the backing store, in bytes.
+
+ULong64_t THSparseStore::GetStoreBytes() const
+{
+   return (ULong64_t)fChunkMap.size() * sizeof(Int_t)
+        + (ULong64_t)fChunksF.size() * sizeof(Float_t)
+        + (ULong64_t)fChunksD.size() * sizeof(Double_t)
+        + (ULong64_t)fFreeF.size()   * sizeof(Int_t);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the fraction of chunks that are allocated (0 for an empty store).
+
+Double_t THSparseStore::GetStoreOccupancy() const
+{
+   if (fChunkMap.empty()) return 0;
+   return (Double_t)GetNchunks() / (Double_t)fChunkMap.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop all chunks, resetting every cell to zero; the store size is kept.
+
+void THSparseStore::ResetStore()
+{
+   std::fill(fChunkMap.begin(), fChunkMap.end(), -1);
+   fChunksF.clear();
+   fChunksD.clear();
+   fFreeF.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the total number of addressable cells. Chunks fully inside the new
+/// range keep their contents; when the range shrinks the payloads of the
+/// dropped chunks are only reclaimed by the next ResetStore.
+
+void THSparseStore::SetStoreSize(Int_t n)
+{
+   if (n < 0) n = 0;
+   fStoreSize = n;
+   Int_t nchunks = fChunkSize ? (n + fChunkSize - 1) / fChunkSize : 0;
+   fChunkMap.resize(nchunks, -1);
+}
@@ -0,0 +1,196 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "THistFillGroup.h"
+#include "TH1.h"
+#include "TMath.h"
+
+ClassImp(THistFillGroup)
+
+/** \class THistFillGroup
+    \ingroup Hist
+Fill a set of 1-d histograms sharing the same binning with a single
+bin search per value.
+
+A typical use case is the booking of many systematic variations of the
+same quantity: dozens of histograms with identical axes, filled with the
+same values but different per-variation weights. Filling each histogram
+individually repeats the `FindBin` computation on identical axes; with a
+fill group the bin index is computed once on a shared axis copy and the
+increment is applied to all members.
+
+Example:
+~~~ {.cpp}
+   THistFillGroup group;
+   for (Int_t ivar = 0; ivar < nvar; ivar++) group.AddHistogram(hvar[ivar]);
+   for (Long64_t i = 0; i < nevents; i++)
+      group.Fill(value[i], variationWeights[i]);  // one weight per member
+   group.Flush();                                 // write back the statistics
+~~~
+
+Member histograms must be one dimensional and have axes identical to the
+first histogram added (same number of bins and same bin edges). The group
+updates the bin contents and the per-bin sum of squares of weights
+directly; the global statistics (number of entries and moment sums) are
+accumulated internally and written back to the members by Flush(), which
+must be called before the histograms are used. The axes are never
+extended: values outside the range go into the underflow/overflow bins,
+as for a histogram with a frozen range.
+
+The group does not own its members and holds no reference to them beyond
+the raw pointer: do not delete a member histogram while the group is in
+use.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor.
+
+THistFillGroup::THistFillGroup()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor. The member histograms are not owned and are not deleted.
+
+THistFillGroup::~THistFillGroup()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a histogram to the group.
+///
+/// The first histogram defines the shared axis; subsequent histograms
+/// must be binned identically (same number of bins, same limits and, for
+/// variable binning, the same bin edges). Only 1-d histograms are
+/// supported. Returns kTRUE if the histogram was added.
+
+Bool_t THistFillGroup::AddHistogram(TH1 *h)
+{
+   if (!h) {
+      Error("AddHistogram", "pointer to histogram is null");
+      return kFALSE;
+   }
+   if (h->GetDimension() != 1) {
+      Error("AddHistogram", "histogram %s is not 1-d", h->GetName());
+      return kFALSE;
+   }
+
+   const TAxis *axis = h->GetXaxis();
+   if (fMembers.empty()) {
+      axis->Copy(fAxis);
+   } else {
+      Bool_t compatible = (axis->GetNbins() == fAxis.GetNbins())
+                       && (axis->GetXmin()  == fAxis.GetXmin())
+                       && (axis->GetXmax()  == fAxis.GetXmax());
+      if (compatible && fAxis.GetXbins()->fN) {
+         if (axis->GetXbins()->fN != fAxis.GetXbins()->fN) {
+            compatible = kFALSE;
+         } else {
+            for (Int_t i = 0; i < fAxis.GetXbins()->fN; i++) {
+               if (axis->GetXbins()->fArray[i] != fAxis.GetXbins()->fArray[i]) {
+                  compatible = kFALSE;
+                  break;
+               }
+            }
+         }
+      }
+      if (!compatible) {
+         Error("AddHistogram", "histogram %s is not binned like the group axis", h->GetName());
+         return kFALSE;
+      }
+   }
+
+   Member_t member;
+   member.fHist = h;
+   member.fEntries = h->GetEntries();
+   Double_t stats[TH1::kNstat];
+   h->GetStats(stats);
+   member.fTsumw   = stats[0];
+   member.fTsumw2  = stats[1];
+   member.fTsumwx  = stats[2];
+   member.fTsumwx2 = stats[3];
+   fMembers.push_back(member);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Apply one increment to a member: bin content, per-bin error and the
+/// accumulated statistics. Underflow and overflow entries are counted but
+/// excluded from the moment sums, as in TH1::Fill with a frozen axis.
+
+void THistFillGroup::FillMember(Member_t &member, Int_t bin, Double_t x, Double_t w)
+{
+   member.fHist->AddBinContent(bin, w);
+   TArrayD *sumw2 = member.fHist->GetSumw2();
+   if (sumw2->fN) sumw2->fArray[bin] += w*w;
+   member.fEntries += 1;
+   if (bin == 0 || bin > fAxis.GetNbins()) return;
+   member.fTsumw   += w;
+   member.fTsumw2  += w*w;
+   member.fTsumwx  += w*x;
+   member.fTsumwx2 += w*x*x;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill all member histograms with the value x and the common weight w.
+/// The bin index is computed once on the shared axis.
+
+void THistFillGroup::Fill(Double_t x, Double_t w)
+{
+   Int_t bin = fAxis.FindFixBin(x);
+   for (std::vector<Member_t>::iterator it = fMembers.begin(); it != fMembers.end(); ++it)
+      FillMember(*it, bin, x, w);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill all member histograms with the value x, each with its own weight:
+/// weights must point to GetN() values, one per member in the order the
+/// histograms were added. This is the entry point for systematics
+/// variations, where the same value enters every histogram with a
+/// different weight.
+
+void THistFillGroup::Fill(Double_t x, const Double_t *weights)
+{
+   Int_t bin = fAxis.FindFixBin(x);
+   Int_t imem = 0;
+   for (std::vector<Member_t>::iterator it = fMembers.begin(); it != fMembers.end(); ++it, ++imem)
+      FillMember(*it, bin, x, weights[imem]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill all member histograms with an array of ntimes values, with the
+/// common weights w (all weights equal 1 if w is null). The arrays are
+/// walked with the given stride, as in TH1::FillN.
+
+void THistFillGroup::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
+{
+   ntimes *= stride;
+   for (Int_t i = 0; i < ntimes; i += stride)
+      Fill(x[i], w ? w[i] : 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the accumulated statistics (number of entries and moment sums)
+/// back to the member histograms. Must be called after filling, before
+/// the histograms are drawn, fitted or stored.
+
+void THistFillGroup::Flush()
+{
+   Double_t stats[TH1::kNstat];
+   for (std::vector<Member_t>::iterator it = fMembers.begin(); it != fMembers.end(); ++it) {
+      for (Int_t i = 0; i < TH1::kNstat; i++) stats[i] = 0;
+      stats[0] = it->fTsumw;
+      stats[1] = it->fTsumw2;
+      stats[2] = it->fTsumwx;
+      stats[3] = it->fTsumwx2;
+      it->fHist->PutStats(stats);
+      it->fHist->SetEntries(it->fEntries);
+   }
+}
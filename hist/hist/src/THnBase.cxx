@@ -523,9 +523,17 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    Int_t* bins  = new Int_t[ndim];
    Long64_t myLinBin = 0;
 
+   // let the derived class fill the target histogram directly when it can do
+   // so faster than the generic bin iteration below
+   Bool_t filledBySubclass = kFALSE;
+   Bool_t subclassSkippedBin = kFALSE;
+   if (!wantNDim)
+      filledBySubclass = FillProjectionHist(hist, ndim, dim, keepTargetAxis,
+                                            wantErrors, haveErrors, subclassSkippedBin);
+
    THnIter iter(this, kTRUE /*use axis range*/);
 
-   while ((myLinBin = iter.Next()) >= 0) {
+   while (!filledBySubclass && (myLinBin = iter.Next()) >= 0) {
       Double_t v = GetBinContent(myLinBin);
 
       for (Int_t d = 0; d < ndim; ++d) {
@@ -574,7 +582,7 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    if (wantNDim) {
       hn->SetEntries(fEntries);
    } else {
-      if (!iter.HaveSkippedBin()) {
+      if (filledBySubclass ? !subclassSkippedBin : !iter.HaveSkippedBin()) {
          hist->SetEntries(fEntries);
       } else {
          // re-compute the entries
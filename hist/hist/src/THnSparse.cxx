@@ -16,6 +16,13 @@
 #include "TClass.h"
 #include "TDataMember.h"
 #include "TDataType.h"
+#include "TH1.h"
+#include "TMath.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 namespace {
 //______________________________________________________________________________
@@ -782,6 +789,118 @@ Double_t THnSparse::GetBinError2(Long64_t linidx) const {
    return chunk->fSumw2->GetAt(linidx);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the 1,2 or 3 dimensional projection target hist directly from the
+/// storage chunks, decoding the compact bin coordinates chunk by chunk and,
+/// when implicit multi-threading is enabled, processing the chunks in
+/// parallel. Each task accumulates into its own buffer of target bins which
+/// are merged serially at the end, so the per-bin loop needs no
+/// synchronization. Return kFALSE when the generic bin iteration of
+/// THnBase::ProjectionAny should be used instead.
+
+Bool_t THnSparse::FillProjectionHist(TH1* hist, Int_t ndim, const Int_t* dim,
+                                     Bool_t keepTargetAxis, Bool_t wantErrors,
+                                     Bool_t haveErrors, Bool_t& haveSkippedBin) const
+{
+#ifdef R__USE_IMT
+   const Int_t nchunks = GetNChunks();
+   if (!ROOT::IsImplicitMTEnabled() || nchunks < 2 || ndim > 3)
+      return kFALSE;
+
+   // precompute the per-axis selection limits (see THnBase::IsInRange) and
+   // the per-target-axis bin offsets instead of re-deriving them per bin
+   std::vector<char>  axisHasRange(fNdimensions, 0);
+   std::vector<Int_t> rangeMin(fNdimensions, 0);
+   std::vector<Int_t> rangeMax(fNdimensions, 0);
+   Bool_t haveRange = kFALSE;
+   for (Int_t i = 0; i < fNdimensions; ++i) {
+      TAxis *axis = GetAxis(i);
+      if (!axis->TestBit(TAxis::kAxisRange)) continue;
+      axisHasRange[i] = 1;
+      rangeMin[i] = axis->GetFirst();
+      rangeMax[i] = axis->GetLast();
+      haveRange = kTRUE;
+   }
+   std::vector<Int_t> binOffset(ndim, 0);
+   for (Int_t d = 0; d < ndim; ++d) {
+      if (!keepTargetAxis && GetAxis(dim[d])->TestBit(TAxis::kAxisRange)) {
+         Int_t offset = GetAxis(dim[d])->GetFirst();
+         // Don't subtract even more if underflow is already included:
+         if (offset > 0) --offset;
+         binOffset[d] = offset;
+      }
+   }
+
+   const THnSparseCompactBinCoord *cc = GetCompactCoord();
+   const Int_t sizeCompact = GetCompactCoord()->GetBufferSize();
+   const Int_t ncells = hist->GetNcells();
+
+   struct ChunkProj_t {
+      std::vector<Double_t> fContent;
+      std::vector<Double_t> fErr2;
+      Long64_t fSkipped;
+   };
+
+   auto projectChunk = [&](Int_t ichunk) {
+      ChunkProj_t res;
+      res.fContent.resize(ncells);
+      if (wantErrors) res.fErr2.resize(ncells);
+      res.fSkipped = 0;
+      THnSparseArrayChunk *chunk = GetChunk(ichunk);
+      const Int_t nentries = chunk->GetEntries();
+      std::vector<Int_t> coord(fNdimensions);
+      Int_t bins[3] = {0, 0, 0};
+      for (Int_t idx = 0; idx < nentries; ++idx) {
+         cc->SetCoordFromBuffer(chunk->fCoordinates + idx * sizeCompact, &coord[0]);
+         if (haveRange) {
+            Bool_t inRange = kTRUE;
+            for (Int_t i = 0; i < fNdimensions && inRange; ++i)
+               if (axisHasRange[i] && (coord[i] < rangeMin[i] || coord[i] > rangeMax[i]))
+                  inRange = kFALSE;
+            if (!inRange) {
+               ++res.fSkipped;
+               continue;
+            }
+         }
+         for (Int_t d = 0; d < ndim; ++d)
+            bins[d] = coord[dim[d]] - binOffset[d];
+         Long64_t target = -1;
+         if (ndim == 1)      target = bins[0];
+         else if (ndim == 2) target = hist->GetBin(bins[0], bins[1]);
+         else                target = hist->GetBin(bins[0], bins[1], bins[2]);
+         if (target < 0 || target >= ncells) continue;
+         const Double_t v = chunk->fContent->GetAt(idx);
+         res.fContent[target] += v;
+         if (wantErrors)
+            res.fErr2[target] += haveErrors ? chunk->fSumw2->GetAt(idx) : v;
+      }
+      return res;
+   };
+
+   ROOT::TThreadExecutor pool;
+   std::vector<ChunkProj_t> parts = pool.Map(projectChunk, ROOT::TSeqI(nchunks));
+
+   Long64_t nSkipped = 0;
+   for (const ChunkProj_t &part : parts) {
+      nSkipped += part.fSkipped;
+      for (Int_t cell = 0; cell < ncells; ++cell) {
+         if (wantErrors && part.fErr2[cell] != 0.) {
+            const Double_t preverr = hist->GetBinError(cell);
+            hist->SetBinError(cell, TMath::Sqrt(preverr * preverr + part.fErr2[cell]));
+         }
+         if (part.fContent[cell] != 0.)
+            hist->AddBinContent(cell, part.fContent[cell]);
+      }
+   }
+   haveSkippedBin = (nSkipped > 0);
+   return kTRUE;
+#else
+   (void) hist; (void) ndim; (void) dim; (void) keepTargetAxis;
+   (void) wantErrors; (void) haveErrors; (void) haveSkippedBin;
+   return kFALSE;
+#endif
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the index for fCurrentBinIndex.
@@ -770,6 +770,53 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
          return;
    }
 
+   // fast path for the common case of a fixed bin size axis: the bin number
+   // is then one multiplication instead of a TAxis::FindBin call per entry,
+   // the four bin arrays are updated in one fused pass and the statistics
+   // are accumulated in local variables, folded into the data members once
+   if (stride == 1 && !fXaxis.CanExtend() && !fXaxis.GetLabels() &&
+       fXaxis.GetXbins()->fN == 0) {
+      const Int_t    nbins  = fXaxis.GetNbins();
+      const Double_t xlo    = fXaxis.GetXmin();
+      const Double_t xup    = fXaxis.GetXmax();
+      const Double_t binfac = nbins/(xup-xlo);
+      const Bool_t   checky = (fYmin != fYmax);
+      const Bool_t   statov = fgStatOverflows;
+      Double_t tsw = 0, tsw2 = 0, tswx = 0, tswx2 = 0, tswy = 0, tswy2 = 0;
+      Int_t nent = 0;
+      for (i=ifirst;i<ntimes;i++) {
+         Double_t yv = y[i];
+         if (checky && (yv < fYmin || yv > fYmax || TMath::IsNaN(yv))) continue;
+         Double_t u = (w) ? w[i] : 1;
+         if (u != 1.0 && !fBinSumw2.fN && !TestBit(TH1::kIsNotW)) Sumw2(); // must be called before accumulating the entries
+         Double_t xv = x[i];
+         if (xv < xlo)            bin = 0;
+         else if (!(xv < xup))    bin = nbins+1;   // catches NaN as well
+         else                     bin = 1 + Int_t(binfac*(xv-xlo));
+         nent++;
+         Double_t uy = u*yv;
+         fArray[bin]             += uy;
+         fSumw2.fArray[bin]      += uy*yv;
+         fBinEntries.fArray[bin] += u;
+         if (fBinSumw2.fN) fBinSumw2.fArray[bin] += u*u;
+         if ((bin == 0 || bin > nbins) && !statov) continue;
+         tsw   += u;
+         tsw2  += u*u;
+         tswx  += u*xv;
+         tswx2 += u*xv*xv;
+         tswy  += uy;
+         tswy2 += uy*yv;
+      }
+      fEntries += nent;
+      fTsumw   += tsw;
+      fTsumw2  += tsw2;
+      fTsumwx  += tswx;
+      fTsumwx2 += tswx2;
+      fTsumwy  += tswy;
+      fTsumwy2 += tswy2;
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       if (fYmin != fYmax) {
          if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
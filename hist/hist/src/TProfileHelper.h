@@ -372,6 +372,30 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
             totstats[i] += stats[i];
          nentries += h->GetEntries();
 
+         if (allSameLimits) {
+            // identical binning: the source bin is the target bin, so the
+            // four moment arrays add element by element - plain loops the
+            // compiler can vectorize, without the per-bin branches below
+            const Double_t *hw  = h->GetW();
+            const Double_t *hw2 = h->GetW2();
+            const Double_t *hb  = h->GetB();
+            Double_t *pw  = p->fArray;
+            Double_t *pw2 = p->fSumw2.fArray;
+            Double_t *pb  = p->fBinEntries.fArray;
+            for ( Int_t hbin = 0; hbin < h->fN; ++hbin ) {
+               pw[hbin]  += hw[hbin];
+               pw2[hbin] += hw2[hbin];
+               pb[hbin]  += hb[hbin];
+            }
+            if (p->fBinSumw2.fN) {
+               const Double_t *hb2 = h->GetB2() ? h->GetB2() : hb;
+               Double_t *pb2 = p->fBinSumw2.fArray;
+               for ( Int_t hbin = 0; hbin < h->fN; ++hbin )
+                  pb2[hbin] += hb2[hbin];
+            }
+            continue;
+         }
+
          for ( Int_t hbin = 0; hbin < h->fN; ++hbin ) {
             Int_t pbin = hbin;
             if (!allSameLimits) {
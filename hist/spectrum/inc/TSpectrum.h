@@ -13,6 +13,8 @@
 
 #include "TNamed.h"
 
+#include <vector>
+
 class TH1;
 
 class TSpectrum : public TNamed {
@@ -29,6 +31,9 @@ protected:
    Double_t      *fPositionY;        ///< [fNPeaks] Y position of peaks
    Double_t       fResolution;       ///< *NOT USED* resolution of the neighboring peaks
    TH1           *fHistogram;        ///< resulting histogram
+   std::vector<Double_t> fLastSource;    ///<! snapshot of the source of the last incremental search
+   std::vector<Double_t> fLastDecon;     ///<! deconvolved spectrum of the last incremental search
+   std::vector<Double_t> fLastPositions; ///<! peak positions of the last incremental search
 static Int_t      fgAverageWindow;   ///< Average window of searched peaks
 static Int_t      fgIterations;      ///< Maximum number of decon iterations (default=3)
 
@@ -70,6 +75,8 @@ public:
    const char         *DeconvolutionRL(Double_t *source, const Double_t *response,Int_t ssize, Int_t numberIterations,Int_t numberRepetitions, Double_t boost );
    const char         *Unfolding(Double_t *source,const Double_t **respMatrix,Int_t ssizex, Int_t ssizey,Int_t numberIterations,Int_t numberRepetitions, Double_t boost);
    Int_t               SearchHighRes(Double_t *source,Double_t *destVector, Int_t ssize,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow);
+   Int_t               SearchHighResROI(Double_t *source,Double_t *destVector, Int_t ssize,Int_t roiFirst,Int_t roiLast,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow);
+   Int_t               SearchHighResIncremental(Double_t *source,Double_t *destVector, Int_t ssize,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow);
    Int_t               Search1HighRes(Double_t *source,Double_t *destVector, Int_t ssize,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow);
 
    static Int_t        StaticSearch(const TH1 *hist, Double_t sigma=2, Option_t *option="goff", Double_t threshold=0.05);
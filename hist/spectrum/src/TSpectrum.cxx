@@ -7,6 +7,7 @@
 #include "TList.h"
 #include "TH1.h"
 #include "TMath.h"
+#include <algorithm>
 
 /** \class TSpectrum
     \ingroup Spectrum
@@ -2423,14 +2424,19 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
    imin = -i,imax = size_ext + i - 1;
    for(i = imin; i <= imax; i++){
       lda = 0;
-      for(j = 0; j <= (lh_gold - 1); j++){
-         ldb = working_space[j];
-         k = i + j;
-         if(k >= 0 && k < size_ext){
-            ldc = working_space[2 * size_ext + k];
-            lda = lda + ldb * ldc;
-         }
-
+      // clip the response range up front so the inner loop is a plain
+      // contiguous dot product the compiler can vectorize
+      jmin = 0;
+      if(i < 0)
+         jmin = -i;
+      jmax = lh_gold - 1;
+      if(jmax > (size_ext - 1 - i))
+         jmax = size_ext - 1 - i;
+      {
+         const Double_t *resp = working_space;
+         const Double_t *vec = working_space + 2 * size_ext + i;
+         for(j = jmin; j <= jmax; j++)
+            lda += resp[j] * vec[j];
       }
       working_space[4 * size_ext + i - imin] = lda;
    }
@@ -2454,10 +2460,14 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
             if(jmax > (size_ext - 1 - i))
                jmax=size_ext-1-i;
 
-            for(j = jmin; j <= jmax; j++){
-               ldb = working_space[j + lh_gold - 1 + size_ext];
-               ldc = working_space[i + j];
-               lda = lda + ldb * ldc;
+            {
+               // contiguous dot product with the symmetric response; keeping
+               // it branch-free lets the compiler vectorize the hot loop of
+               // the deconvolution iterations
+               const Double_t *resp = working_space + lh_gold - 1 + size_ext;
+               const Double_t *vec = working_space + i;
+               for(j = jmin; j <= jmax; j++)
+                  lda += resp[j] * vec[j];
             }
             ldb = working_space[2 * size_ext + i];
             if(lda != 0)
@@ -2557,6 +2567,130 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
    return fNPeaks;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// One-dimensional high-resolution peak search restricted to the region of
+/// interest [roiFirst, roiLast] of the spectrum.
+///
+/// The region is padded on both sides with enough channels (the clipping
+/// window of the background removal, the averaging window and the
+/// deconvolution response) so the channels inside the region see the same
+/// neighbourhood as in a full search, and SearchHighRes is run on that
+/// window only. Channels of destVector outside the padded window are left
+/// untouched. The found peak positions are returned in full-spectrum
+/// coordinates and peaks located in the padding are dropped.
+///
+/// Note that the threshold is applied relative to the highest peak of the
+/// window, not of the full spectrum.
+
+Int_t TSpectrum::SearchHighResROI(Double_t *source,Double_t *destVector, Int_t ssize,
+                                     Int_t roiFirst, Int_t roiLast,
+                                     Double_t sigma, Double_t threshold,
+                                     bool backgroundRemove,int deconIterations,
+                                     bool markov, int averWindow)
+{
+   if (roiFirst < 0 || roiLast >= ssize || roiFirst > roiLast) {
+      Error("SearchHighResROI", "Invalid region of interest [%d, %d]", roiFirst, roiLast);
+      return 0;
+   }
+   Int_t numberIterations = (Int_t)(7 * sigma + 0.5);
+   Int_t margin = numberIterations + averWindow + 1;
+   Int_t first = TMath::Max(roiFirst - margin, 0);
+   Int_t last  = TMath::Min(roiLast + margin, ssize - 1);
+   // the clipping window of the background removal needs a minimum size
+   while (last - first + 1 < 2 * numberIterations + 2) {
+      if (first > 0) first--;
+      else if (last < ssize - 1) last++;
+      else break;
+   }
+   Int_t wsize = last - first + 1;
+
+   std::vector<Double_t> dest(wsize);
+   Int_t npeaks = SearchHighRes(source + first, &dest[0], wsize, sigma, threshold,
+                                backgroundRemove, deconIterations, markov, averWindow);
+   for (Int_t i = 0; i < wsize; i++)
+      destVector[first + i] = dest[i];
+
+   // shift to full-spectrum coordinates, dropping peaks in the padding
+   Int_t kept = 0;
+   for (Int_t i = 0; i < npeaks; i++) {
+      Double_t pos = fPositionX[i] + first;
+      if (pos >= roiFirst && pos <= roiLast)
+         fPositionX[kept++] = pos;
+   }
+   fNPeaks = kept;
+   return kept;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// One-dimensional high-resolution peak search that only reprocesses the
+/// channels whose content changed since the previous call.
+///
+/// The function keeps a snapshot of the source spectrum. On the next call
+/// it locates the changed channel range and re-runs the search on that
+/// region only (see SearchHighResROI), re-delivering the previous
+/// deconvolution and peaks for the untouched part; when nothing changed
+/// the previous result is returned outright. The first call, a change of
+/// the spectrum length, or a change spanning more than half the spectrum
+/// fall back to a full SearchHighRes.
+///
+/// Intended for online monitoring where a spectrum accumulates counts in
+/// a few channels between searches. Unlike SearchHighRes, the peak
+/// positions are ordered by channel, not by amplitude, and for a
+/// reprocessed region the threshold is window-local.
+
+Int_t TSpectrum::SearchHighResIncremental(Double_t *source,Double_t *destVector, Int_t ssize,
+                                     Double_t sigma, Double_t threshold,
+                                     bool backgroundRemove,int deconIterations,
+                                     bool markov, int averWindow)
+{
+   Bool_t full = ((Int_t)fLastSource.size() != ssize);
+   Int_t lo = 0, hi = ssize - 1;
+   if (!full) {
+      while (lo < ssize && source[lo] == fLastSource[lo]) lo++;
+      if (lo == ssize) {
+         // nothing changed: re-deliver the previous result
+         for (Int_t i = 0; i < ssize; i++) destVector[i] = fLastDecon[i];
+         fNPeaks = (Int_t)fLastPositions.size();
+         for (Int_t i = 0; i < fNPeaks && i < fMaxPeaks; i++) fPositionX[i] = fLastPositions[i];
+         return fNPeaks;
+      }
+      while (hi > lo && source[hi] == fLastSource[hi]) hi--;
+      if (hi - lo + 1 > ssize / 2) full = kTRUE;
+   }
+
+   Int_t npeaks;
+   if (full) {
+      npeaks = SearchHighRes(source, destVector, ssize, sigma, threshold,
+                             backgroundRemove, deconIterations, markov, averWindow);
+      // order by channel for a stable incremental peak list
+      std::sort(fPositionX, fPositionX + npeaks);
+   } else {
+      // start from the previous deconvolution and redo the changed region
+      for (Int_t i = 0; i < ssize; i++) destVector[i] = fLastDecon[i];
+      Int_t nnew = SearchHighResROI(source, destVector, ssize, lo, hi, sigma, threshold,
+                                    backgroundRemove, deconIterations, markov, averWindow);
+      // merge: previous peaks outside the changed region, new ones inside
+      std::vector<Double_t> merged;
+      for (size_t i = 0; i < fLastPositions.size(); i++) {
+         if (fLastPositions[i] < lo || fLastPositions[i] > hi)
+            merged.push_back(fLastPositions[i]);
+      }
+      for (Int_t i = 0; i < nnew; i++)
+         merged.push_back(fPositionX[i]);
+      std::sort(merged.begin(), merged.end());
+      npeaks = TMath::Min((Int_t)merged.size(), fMaxPeaks);
+      for (Int_t i = 0; i < npeaks; i++) fPositionX[i] = merged[i];
+      fNPeaks = npeaks;
+      if ((Int_t)merged.size() > fMaxPeaks)
+         Warning("SearchHighResIncremental", "Peak buffer full");
+   }
+
+   fLastSource.assign(source, source + ssize);
+   fLastDecon.assign(destVector, destVector + ssize);
+   fLastPositions.assign(fPositionX, fPositionX + npeaks);
+   return npeaks;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Old name of SearcHighRes introduced for back compatibility.
 /// This function will be removed after the June 2006 release
@@ -208,10 +208,19 @@ class TUnfold : public TObject {
    TMatrixDSparse *fEinv;
    /// matrix E
    TMatrixDSparse *fE;
+   /// cached matrix A# Vyy^(-1), does not depend on tau
+   TMatrixDSparse *fAtVyyinv; //!
+   /// cached matrix A# Vyy^(-1) A, does not depend on tau
+   TMatrixDSparse *fAtVyyinvA; //!
+   /// cached vector A# Vyy^(-1) y, does not depend on tau
+   TMatrixDSparse *fAtVyyinvY; //!
+   /// cached matrix L# L, does not depend on tau
+   TMatrixDSparse *fLsquared; //!
  protected:
    // Int_t IsNotSymmetric(TMatrixDSparse const &m) const;
    virtual Double_t DoUnfold(void);     // the unfolding algorithm
    virtual void ClearResults(void);     // clear all results
+   void ClearCaches(void);     // clear cached tau-independent matrix products
    void ClearHistogram(TH1 *h,Double_t x=0.) const;
    virtual TString GetOutputBinName(Int_t iBinX) const; // name a bin
    TMatrixDSparse *MultiplyMSparseM(const TMatrixDSparse *a,const TMatrixD *b) const; // multiply sparse and non-sparse matrix
@@ -140,6 +140,7 @@ TUnfold::~TUnfold(void)
    DeleteMatrix(&fX0);
    DeleteMatrix(&fVyyInv);
 
+   ClearCaches();
    ClearResults();
 }
 
@@ -180,6 +181,10 @@ void TUnfold::InitTUnfold(void)
    fDXDY = 0;
    fEinv = 0;
    fE = 0;
+   fAtVyyinv = 0;
+   fAtVyyinvA = 0;
+   fAtVyyinvY = 0;
+   fLsquared = 0;
    fEpsMatrix=1.E-13;
    fIgnoredBins=0;
 }
@@ -242,6 +247,25 @@ void TUnfold::ClearResults(void)
    fRhoAvg = -1.0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Clear the cached matrix products which do not depend on tau.
+///
+/// The products A<sup>T</sup>Vyy<sup>-1</sup>,
+/// A<sup>T</sup>Vyy<sup>-1</sup>A, A<sup>T</sup>Vyy<sup>-1</sup>y and
+/// L<sup>T</sup>L are independent of the regularisation strength and
+/// are kept across calls to DoUnfold(), such that a tau-scan only
+/// repeats the tau-dependent part of the algorithm. This method has
+/// to be called whenever fA, fL, fY or fVyy (and thus fVyyInv) are
+/// modified.
+
+void TUnfold::ClearCaches(void)
+{
+   DeleteMatrix(&fAtVyyinv);
+   DeleteMatrix(&fAtVyyinvA);
+   DeleteMatrix(&fAtVyyinvY);
+   DeleteMatrix(&fLsquared);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Only for use by root streamer or derived classes.
 
@@ -303,14 +327,25 @@ Double_t TUnfold::DoUnfold(void)
    //              T
    //            fA fV  = mAt_V
    //
-   TMatrixDSparse *AtVyyinv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+   // this product and the other tau-independent products below are
+   // cached, so a scan over tau repeats only the tau-dependent part
+   if(!fAtVyyinv) {
+      fAtVyyinv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+   }
+   const TMatrixDSparse *AtVyyinv=fAtVyyinv;
    //
    // get
    //       T
    //     fA fVyyinv fY + fTauSquared fBiasScale Lsquared fX0 = rhs
    //
-   TMatrixDSparse *rhs=MultiplyMSparseM(AtVyyinv,fY);
-   TMatrixDSparse *lSquared=MultiplyMSparseTranspMSparse(fL,fL);
+   if(!fAtVyyinvY) {
+      fAtVyyinvY=MultiplyMSparseM(AtVyyinv,fY);
+   }
+   TMatrixDSparse *rhs=new TMatrixDSparse(*fAtVyyinvY);
+   if(!fLsquared) {
+      fLsquared=MultiplyMSparseTranspMSparse(fL,fL);
+   }
+   const TMatrixDSparse *lSquared=fLsquared;
    if (fBiasScale != 0.0) {
      TMatrixDSparse *rhs2=MultiplyMSparseM(lSquared,fX0);
       AddMSparse(rhs, fTauSquared * fBiasScale ,rhs2);
@@ -321,7 +356,10 @@ Double_t TUnfold::DoUnfold(void)
    // get matrix
    //              T
    //           (fA fV)fA + fTauSquared*fLsquared  = fEinv
-   fEinv=MultiplyMSparseMSparse(AtVyyinv,fA);
+   if(!fAtVyyinvA) {
+      fAtVyyinvA=MultiplyMSparseMSparse(AtVyyinv,fA);
+   }
+   fEinv=new TMatrixDSparse(*fAtVyyinvA);
    AddMSparse(fEinv,fTauSquared,lSquared);
 
    //
@@ -427,7 +465,7 @@ Double_t TUnfold::DoUnfold(void)
       DeleteMatrix(&corr);
    }
 
-   DeleteMatrix(&AtVyyinv);
+   // AtVyyinv is cached in fAtVyyinv, do not delete it here
 
    //
    // get error matrix on x
@@ -491,7 +529,7 @@ Double_t TUnfold::DoUnfold(void)
    DeleteMatrix(&epsilon);
 
    DeleteMatrix(&LsquaredDx);
-   DeleteMatrix(&lSquared);
+   // lSquared is cached in fLsquared, do not delete it here
 
    // calculate/store matrices defining the derivatives dx/dA
    fDXDAM[0]=new TMatrixDSparse(*fE);
@@ -2017,6 +2055,7 @@ Bool_t TUnfold::AddRegularisationCondition
    // replace the old matrix fL
    if(r) {
       DeleteMatrix(&fL);
+      DeleteMatrix(&fLsquared);
       fL=CreateSparseMatrix(rowMax+1,GetNx(),nF,l_row,l_col,l_data);
    }
    delete [] l_row;
@@ -2304,6 +2343,7 @@ Int_t TUnfold::SetInput(const TH1 *input, Double_t scaleBias,
                         const TH2 *hist_vyy_inv)
 {
   DeleteMatrix(&fVyyInv);
+  ClearCaches();
   fNdf=0;
 
   fBiasScale = scaleBias;
@@ -340,6 +340,7 @@ void TUnfoldSys::DoBackgroundSubtraction(void)
    if(fYData) {
       DeleteMatrix(&fY);
       DeleteMatrix(&fVyy);
+      ClearCaches();
       if(fBgrIn->GetEntries()<=0) {
          // simple copy
          fY=new TMatrixD(*fYData);
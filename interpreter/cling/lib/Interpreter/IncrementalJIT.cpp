@@ -10,11 +10,14 @@
 #include "IncrementalJIT.h"
 
 #include "IncrementalExecutor.h"
+#include "IncrementalObjectCache.h"
 #include "cling/Utils/Platform.h"
 
 #include "llvm/ExecutionEngine/Orc/LambdaResolver.h"
 #include "llvm/Support/DynamicLibrary.h"
 
+#include <cstdlib>
+
 #ifdef __APPLE__
 // Apple adds an extra '_'
 # define MANGLE_PREFIX "_"
@@ -244,6 +247,22 @@ IncrementalJIT::IncrementalJIT(IncrementalExecutor& exe,
   // Enable JIT symbol resolution from the binary.
   llvm::sys::DynamicLibrary::LoadLibraryPermanently(0, 0);
 
+  // Reuse object code compiled by previous sessions: when the user names
+  // a cache directory through CLING_CACHE_DIR, plug an on-disk object
+  // cache into the compile layer. Modules whose IR hashes to an existing
+  // entry skip code generation entirely.
+  if (const char* cacheDir = std::getenv("CLING_CACHE_DIR")) {
+    if (cacheDir[0]) {
+      std::string targetId = m_TM->getTargetTriple().str();
+      targetId += '|';
+      targetId += m_TM->getTargetCPU().str();
+      targetId += '|';
+      targetId += m_TM->getTargetFeatureString().str();
+      m_ObjectCache.reset(new IncrementalObjectCache(cacheDir, targetId));
+      m_CompileLayer.setObjectCache(m_ObjectCache.get());
+    }
+  }
+
   // Make debug symbols available.
   m_GDBListener = 0; // JITEventListener::createGDBRegistrationListener();
 
@@ -270,6 +289,7 @@ IncrementalJIT::IncrementalJIT(IncrementalExecutor& exe,
 // #endif
 }
 
+IncrementalJIT::~IncrementalJIT() {}
 
 llvm::orc::JITSymbol
 IncrementalJIT::getInjectedSymbols(const std::string& Name) const {
@@ -36,6 +36,7 @@ class RTDyldMemoryManager;
 namespace cling {
 class Azog;
 class IncrementalExecutor;
+class IncrementalObjectCache;
 
 class IncrementalJIT {
 public:
@@ -154,6 +155,11 @@ private:
   CompileLayerT m_CompileLayer;
   LazyEmitLayerT m_LazyEmitLayer;
 
+  ///\brief On-disk cache of compiled objects, shared across sessions.
+  /// Only set when the user configured a cache directory through the
+  /// CLING_CACHE_DIR environment variable.
+  std::unique_ptr<IncrementalObjectCache> m_ObjectCache;
+
   // We need to store ObjLayerT::ObjSetHandles for each of the object sets
   // that have been emitted but not yet finalized so that we can forward the
   // mapSectionAddress calls appropriately.
@@ -184,6 +190,8 @@ private:
 public:
   IncrementalJIT(IncrementalExecutor& exe,
                  std::unique_ptr<llvm::TargetMachine> TM);
+  // Out of line; IncrementalObjectCache is incomplete here.
+  ~IncrementalJIT();
 
   ///\brief Get the address of a symbol from the JIT or the memory manager,
   /// mangling the name as needed. Use this to resolve symbols as coming
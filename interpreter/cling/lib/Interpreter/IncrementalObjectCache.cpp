@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+// CLING - the C++ LLVM-based InterpreterG :)
+// author:  Axel Naumann <axel@cern.ch>
+//
+// This file is dual-licensed: you can choose to license it under the University
+// of Illinois Open Source License or the GNU Lesser General Public License. See
+// LICENSE.TXT for details.
+//------------------------------------------------------------------------------
+
+#include "IncrementalObjectCache.h"
+
+#include "cling/Utils/Output.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+namespace cling {
+
+IncrementalObjectCache::IncrementalObjectCache(llvm::StringRef cacheDir,
+                                               llvm::StringRef targetId):
+  m_CacheDir(cacheDir), m_TargetId(targetId) {
+  if (std::error_code EC = sys::fs::create_directories(m_CacheDir)) {
+    cling::errs() << "IncrementalObjectCache: cannot create cache directory '"
+                  << m_CacheDir << "': " << EC.message()
+                  << "; object caching is disabled.\n";
+    m_CacheDir.clear();
+  }
+}
+
+std::string IncrementalObjectCache::getCachePath(const llvm::Module* M) const {
+  if (m_CacheDir.empty())
+    return std::string();
+
+  // The printed IR is a stable, complete description of what the compile
+  // layer will see; together with the target configuration it uniquely
+  // identifies the object file that codegen would produce.
+  std::string ir;
+  {
+    raw_string_ostream os(ir);
+    M->print(os, /*AssemblyAnnotationWriter*/ nullptr);
+  }
+
+  MD5 hash;
+  hash.update(m_TargetId);
+  hash.update(ir);
+  MD5::MD5Result result;
+  hash.final(result);
+  SmallString<32> hexDigest;
+  MD5::stringifyResult(result, hexDigest);
+
+  SmallString<512> path(m_CacheDir);
+  sys::path::append(path, Twine("cling-") + hexDigest + ".o");
+  return path.str().str();
+}
+
+void IncrementalObjectCache::notifyObjectCompiled(const llvm::Module* M,
+                                                  llvm::MemoryBufferRef Obj) {
+  std::string path = getCachePath(M);
+  if (path.empty())
+    return;
+
+  // Write to a unique temporary and rename into place, so concurrent
+  // sessions sharing the cache directory never see a partial entry.
+  SmallString<512> tmpPath;
+  int tmpFD;
+  if (sys::fs::createUniqueFile(path + ".tmp%%%%%%", tmpFD, tmpPath))
+    return;
+  {
+    raw_fd_ostream os(tmpFD, /*shouldClose*/ true);
+    os.write(Obj.getBufferStart(), Obj.getBufferSize());
+    if (os.has_error()) {
+      os.clear_error();
+      sys::fs::remove(tmpPath);
+      return;
+    }
+  }
+  if (sys::fs::rename(tmpPath, path))
+    sys::fs::remove(tmpPath);
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+IncrementalObjectCache::getObject(const llvm::Module* M) {
+  std::string path = getCachePath(M);
+  if (path.empty())
+    return nullptr;
+
+  auto bufOrErr = MemoryBuffer::getFile(path, /*FileSize*/ -1,
+                                        /*RequiresNullTerminator*/ false);
+  if (!bufOrErr)
+    return nullptr;
+  return std::move(*bufOrErr);
+}
+
+} // end namespace cling
@@ -0,0 +1,60 @@
+//------------------------------------------------------------------------------
+// CLING - the C++ LLVM-based InterpreterG :)
+// author:  Axel Naumann <axel@cern.ch>
+//
+// This file is dual-licensed: you can choose to license it under the University
+// of Illinois Open Source License or the GNU Lesser General Public License. See
+// LICENSE.TXT for details.
+//------------------------------------------------------------------------------
+
+#ifndef CLING_INCREMENTAL_OBJECT_CACHE_H
+#define CLING_INCREMENTAL_OBJECT_CACHE_H
+
+#include "llvm/ExecutionEngine/ObjectCache.h"
+
+#include <string>
+
+namespace llvm {
+  class Module;
+  class StringRef;
+}
+
+namespace cling {
+
+  ///\brief On-disk cache of JITed object files, shared across sessions.
+  ///
+  /// Entries are keyed by an MD5 hash of the module's printed IR plus the
+  /// target configuration, so a macro or template instantiation that
+  /// produces the same IR as in a previous session skips code generation
+  /// and reuses the stored object file. Plugged into the IRCompileLayer
+  /// of the IncrementalJIT when a cache directory is configured.
+  class IncrementalObjectCache: public llvm::ObjectCache {
+    ///\brief Directory holding the cached object files; empty when the
+    /// cache could not be set up and the cache is disabled.
+    std::string m_CacheDir;
+
+    ///\brief Target triple, CPU and features; part of the cache key so
+    /// object files are not reused across incompatible targets.
+    std::string m_TargetId;
+
+    ///\brief Path of the cache entry for the given module, or an empty
+    /// string when the cache is disabled.
+    std::string getCachePath(const llvm::Module* M) const;
+
+  public:
+    IncrementalObjectCache(llvm::StringRef cacheDir,
+                           llvm::StringRef targetId);
+
+    ///\brief Store the object file compiled from module M in the cache.
+    void notifyObjectCompiled(const llvm::Module* M,
+                              llvm::MemoryBufferRef Obj) override;
+
+    ///\brief Return the cached object file for module M, or null when the
+    /// module was not seen before (it will then be compiled).
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* M)
+      override;
+  };
+
+} // end namespace cling
+
+#endif // CLING_INCREMENTAL_OBJECT_CACHE_H
@@ -27,6 +27,9 @@
 #pragma link C++ class TMapFile;
 #pragma link C++ class TMapRec;
 #pragma link C++ class TMemFile;
+#pragma link C++ class TBufferMergerFile;
+#pragma link C++ class TMmapFile;
+#pragma link C++ class TSharedMemFile;
 #pragma link C++ class TArchiveFile+;
 #pragma link C++ class TArchiveMember+;
 #pragma link C++ class TZIPFile+;
@@ -40,6 +40,9 @@ public:
    static TString   ConvertToJSON(const void *obj, const TClass *cl, Int_t compact = 0, const char *member_name = 0);
    static TString   ConvertToJSON(const void *obj, TDataMember *member, Int_t compact = 0, Int_t arraylen = -1);
 
+   static void      ConvertToJSON(const TObject *obj, TString &json, Int_t compact = 0, const char *member_name = 0);
+   static void      ConvertToJSON(const void *obj, const TClass *cl, TString &json, Int_t compact = 0, const char *member_name = 0);
+
    static Int_t     ExportToFile(const char* filename, const TObject *obj, const char* option = 0);
    static Int_t     ExportToFile(const char* filename, const void *obj, const TClass *cl, const char* option = 0);
 
@@ -0,0 +1,81 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBufferMerger
+#define ROOT_TBufferMerger
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TBufferMerger                                                        //
+//                                                                      //
+// Merge the content of TMemFile based staging files, written           //
+// concurrently by several threads, into a single output TFile. Each    //
+// thread obtains its own TBufferMergerFile via GetFile(), fills and    //
+// compresses its objects there without any lock, and a call to Write() //
+// on the staging file merges its content into the output file; only    //
+// that final merge (extent allocation and key writes) is serialized.   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TFileMerger.h"
+#include "TMemFile.h"
+
+#include <atomic>
+#include <mutex>
+
+class TBufferMergerFile;
+
+class TBufferMerger {
+
+private:
+   TFileMerger          fMerger;     // Merger owning the output file
+   std::mutex           fMergeMutex; // Serializes the merges into the output file
+   std::atomic<Int_t>   fNFiles;     // Number of attached staging files
+   Int_t                fCompress;   // Compression settings of the staging files
+
+   TBufferMerger(const TBufferMerger&);            // Not implemented
+   TBufferMerger& operator=(const TBufferMerger&); // Not implemented
+
+   Bool_t Merge(TMemFile *file);
+   void   Detach() { fNFiles--; }
+
+   friend class TBufferMergerFile;
+
+public:
+   TBufferMerger(const char *name, Option_t *option = "RECREATE", Int_t compress = 1);
+   virtual ~TBufferMerger();
+
+   TBufferMergerFile *GetFile();
+   const char        *GetOutputFileName() const { return fMerger.GetOutputFileName(); }
+   Int_t              GetNFiles() const { return fNFiles; }
+};
+
+class TBufferMergerFile : public TMemFile {
+
+private:
+   TBufferMerger *fMerger; // Merger this staging file is attached to
+
+   TBufferMergerFile(TBufferMerger &merger, Int_t compress);
+   TBufferMergerFile(const TBufferMergerFile&);            // Not implemented
+   TBufferMergerFile& operator=(const TBufferMergerFile&); // Not implemented
+
+   friend class TBufferMerger;
+
+public:
+   ~TBufferMergerFile();
+
+   virtual Int_t Write(const char *name=0, Int_t opt=0, Int_t bufsiz=0);
+   virtual Int_t Write(const char *name=0, Int_t opt=0, Int_t bufsiz=0) const;
+
+   ClassDef(TBufferMergerFile, 0);  // TMemFile specialization merging its content into a shared output file on Write
+};
+
+#endif
@@ -44,9 +44,16 @@ protected:
    TFile      *fFile;            ///< Pointer to current file in memory
    TList      *fKeys;            ///< Pointer to keys list in memory
 
+   class TKeyIndex;
+   TKeyIndex  *fKeyIndex;        ///<! Compact key index, TKey objects are decoded lazily
+
    virtual void         CleanTargets();
    void Init(TClass *cl = 0);
 
+   void        MaterializeKeys() const;
+   TKey       *SearchKeyIndex(const char *name, Short_t cycle, Bool_t exactCycle) const;
+   Int_t       CountKeysOfClass(const char *classname) const;
+
 private:
    TDirectoryFile(const TDirectoryFile &directory);  //Directories cannot be copied
    void operator=(const TDirectoryFile &); //Directories cannot be copied
@@ -86,10 +93,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
    virtual TFile      *GetFile() const { return fFile; }
    virtual TKey       *GetKey(const char *name, Short_t cycle=9999) const;
-   virtual TList      *GetListOfKeys() const { return fKeys; }
+   virtual TList      *GetListOfKeys() const { MaterializeKeys(); return fKeys; }
    const TDatime      &GetModificationDate() const { return fDatimeM; }
    virtual Int_t       GetNbytesKeys() const { return fNbytesKeys; }
-   virtual Int_t       GetNkeys() const { return fKeys->GetSize(); }
+   virtual Int_t       GetNkeys() const;
    virtual Long64_t    GetSeekDir() const { return fSeekDir; }
    virtual Long64_t    GetSeekParent() const { return fSeekParent; }
    virtual Long64_t    GetSeekKeys() const { return fSeekKeys; }
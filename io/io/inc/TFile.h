@@ -35,6 +35,8 @@
 
 class TFree;
 class TArrayC;
+class THashList;
+class TStreamerInfo;
 class TArchiveFile;
 class TFileOpenHandle;
 class TFileCacheRead;
@@ -103,6 +105,7 @@ protected:
    TUrl             fUrl;            ///<!URL of file
 
    TList           *fInfoCache;      ///<!Cached list of the streamer infos in this file
+   THashList       *fPendingInfos;   ///<!Streamer infos read but not yet activated (lazy mode)
    TList           *fOpenPhases;     ///<!Time info about open phases
 
 #ifdef R__USE_IMT
@@ -124,9 +127,12 @@ protected:
    static std::atomic<Int_t>     fgReadCalls;             ///<Number of bytes read from all TFile objects
    static Int_t     fgReadaheadSize;         ///<Readahead buffer size
    static Bool_t    fgReadInfo;              ///<if true (default) ReadStreamerInfo is called when opening a file
+   static Bool_t    fgLazyInfo;              ///<if true the streamer infos are activated per class at first use
    virtual EAsyncOpenStatus GetAsyncOpenStatus() { return fAsyncOpenStatus; }
    virtual void  Init(Bool_t create);
    Bool_t        FlushWriteCache();
+   void          BuildStreamerInfo(TStreamerInfo *info);
+   void          ActivateStreamerInfoImpl(const char *clname);
    Int_t         ReadBufferViaCache(char *buf, Int_t len);
    Int_t         WriteBufferViaCache(const char *buf, Int_t len);
 
@@ -176,6 +182,7 @@ public:
    TFile();
    TFile(const char *fname, Option_t *option="", const char *ftitle="", Int_t compress=1);
    virtual ~TFile();
+           void        ActivateStreamerInfo(const char *clname);
    virtual void        Close(Option_t *option=""); // *MENU*
    virtual void        Copy(TObject &) const { MayNotUse("Copy(TObject &)"); }
    virtual Bool_t      Cp(const char *dst, Bool_t progressbar = kTRUE,UInt_t buffersize = 1000000);
@@ -261,6 +268,7 @@ public:
    virtual void        ShowStreamerInfo();
    virtual Int_t       Sizeof() const;
    void                SumBuffer(Int_t bufsize);
+   virtual Int_t       Verify(Option_t *option=""); // *MENU*
    virtual Bool_t      WriteBuffer(const char *buf, Int_t len);
    virtual Int_t       Write(const char *name=0, Int_t opt=0, Int_t bufsiz=0);
    virtual Int_t       Write(const char *name=0, Int_t opt=0, Int_t bufsiz=0) const;
@@ -295,6 +303,8 @@ public:
    static void         SetReadaheadSize(Int_t bufsize = 256000);
    static void         SetReadStreamerInfo(Bool_t readinfo=kTRUE);
    static Bool_t       GetReadStreamerInfo();
+   static void         SetLazyStreamerInfo(Bool_t lazy=kTRUE);
+   static Bool_t       GetLazyStreamerInfo();
 
    static Long64_t     GetFileCounter();
    static void         IncrementFileCounter();
@@ -35,6 +35,8 @@ protected:
    Bool_t         fNoTrees;          ///< True if Trees should not be merged (default is kFALSE)
    Bool_t         fExplicitCompLevel;///< True if the user explicitly requested a compressio level change (default kFALSE)
    Bool_t         fCompressionChange;///< True if the output and input have different compression level (default kFALSE)
+   Bool_t         fKeepCompressedBaskets; ///< True to splice tree baskets with their original compression even if the output compression differs (default kFALSE)
+   Bool_t         fAllInMemorySources;    ///<! True while every source added so far is an in-process TMemFile
    Int_t          fPrintLevel;       ///< How much information to print out at run time
    TString        fMergeOptions;     ///< Options (in string format) to be passed down to the Merge functions
    TString        fMsgPrefix;        ///< Prefix to be used when printing informational message (default TFileMerger)
@@ -101,6 +103,7 @@ public:
    virtual Bool_t Merge(Bool_t = kTRUE);
    virtual Bool_t PartialMerge(Int_t type = kAll | kIncremental);
    virtual void   SetFastMethod(Bool_t fast=kTRUE)  {fFastMethod = fast;}
+   virtual void   SetKeepCompressedBaskets(Bool_t keep=kTRUE) {fKeepCompressedBaskets = keep;}
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
    virtual void        RecursiveRemove(TObject *obj);
 
@@ -26,6 +26,11 @@ protected:
    void WriteObjects(int nElements, TBuffer &b);
    void WritePrimitives(int nElements, TBuffer &b);
 
+   StreamHelper *GetStagingArea(size_t len);
+
+   char  *fStagingArea;   //! staging memory for feed-based containers, recycled across entries
+   size_t fStagingLen;    //! current length of fStagingArea
+
 //   typedef void (TGenCollectionStreamer::*ReadBufferConv_t)(TBuffer &b, void *obj, const TClass *onFileClass);
 //   ReadBufferConv_t fReadBufferConvFunc;
 
@@ -0,0 +1,44 @@
+// @(#)root/io:$Id$
+// Author: Philippe Canal, August 2017
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMmapFile
+#define ROOT_TMmapFile
+
+#include "TFile.h"
+
+class TMmapFile : public TFile {
+
+private:
+   void     *fMmapBase;  ///< Base address of the read-only mapping (0 if not mapped)
+   Long64_t  fMmapSize;  ///< Size of the mapping in bytes
+   Long64_t  fSysOffset; ///< Current read offset within the mapping
+
+   // Overload TFile interfaces.
+   Int_t    SysOpen(const char *pathname, Int_t flags, UInt_t mode);
+   Int_t    SysClose(Int_t fd);
+   Int_t    SysRead(Int_t fd, void *buf, Int_t len);
+   Int_t    SysWrite(Int_t fd, const void *buf, Int_t len);
+   Long64_t SysSeek(Int_t fd, Long64_t offset, Int_t whence);
+   Int_t    SysSync(Int_t fd);
+
+   TMmapFile(const TMmapFile&);            // Not implemented.
+   TMmapFile &operator=(const TMmapFile&); // Not implemented.
+
+public:
+   TMmapFile(const char *name, Option_t *option="READ", const char *ftitle="", Int_t compress=1);
+   virtual ~TMmapFile();
+
+   Bool_t IsMapped() const { return fMmapBase != 0; }
+
+   ClassDef(TMmapFile, 0) // A local ROOT file read via a memory mapping
+};
+
+#endif
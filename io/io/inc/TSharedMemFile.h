@@ -0,0 +1,56 @@
+// @(#)root/io:$Id$
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TSharedMemFile
+#define ROOT_TSharedMemFile
+
+#include "TFile.h"
+
+class TSharedMemFile : public TFile {
+
+private:
+   UChar_t     *fMapAddr;     ///<! Base address of the shared memory mapping
+   Long64_t     fMapSize;     ///<! Size of the segment, ie the maximum file size
+   Long64_t     fSize;        ///<! Highest offset written so far (current file size)
+   Long64_t     fSysOffset;   ///<! Seek offset in the file
+   TString      fShmName;     ///<  Name of the POSIX shared memory segment
+   Bool_t       fCreator;     ///<! True if this process created the segment
+
+   static Long64_t fgDefaultSegmentSize;
+
+   // Overload TFile interfaces.
+   Int_t    SysOpen(const char *pathname, Int_t flags, UInt_t mode);
+   Int_t    SysClose(Int_t fd);
+   Int_t    SysRead(Int_t fd, void *buf, Int_t len);
+   Int_t    SysWrite(Int_t fd, const void *buf, Int_t len);
+   Long64_t SysSeek(Int_t fd, Long64_t offset, Int_t whence);
+   Int_t    SysStat(Int_t fd, Long_t *id, Long64_t *size, Long_t *flags, Long_t *modtime);
+   Int_t    SysSync(Int_t fd);
+
+   TSharedMemFile(const TSharedMemFile&);            // Not implemented
+   TSharedMemFile &operator=(const TSharedMemFile&); // Not implemented.
+
+public:
+   TSharedMemFile(const char *shmname, Option_t *option="READ", const char *ftitle="",
+                  Int_t compress=1, Long64_t segmentSize=0);
+   virtual ~TSharedMemFile();
+
+   const char      *GetShmName() const { return fShmName.Data(); }
+   virtual Long64_t GetSize() const;
+
+   static Long64_t  GetDefaultSegmentSize();
+   static void      SetDefaultSegmentSize(Long64_t size);
+   static Int_t     Unlink(const char *shmname);
+
+   ClassDef(TSharedMemFile, 0) // A ROOT file in a POSIX shared memory segment
+};
+
+#endif
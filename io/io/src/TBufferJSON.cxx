@@ -365,6 +365,55 @@ TString TBufferJSON::ConvertToJSON(const TObject *obj, Int_t compact, const char
    return ConvertToJSON(ptr, clActual, compact, member_name);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Converts object into JSON, writing directly into the caller-supplied
+/// string. The string is cleared first but keeps its capacity, therefore a
+/// buffer reused across many conversions (like in a THttpServer monitoring
+/// loop) is grown once to the size of the largest object and the per-call
+/// reallocations and result copy are avoided.
+/// See ConvertToJSON(const TObject*, Int_t, const char*) for the meaning
+/// of the compact and member_name parameters.
+
+void TBufferJSON::ConvertToJSON(const TObject *obj, TString &json, Int_t compact,
+                                const char *member_name)
+{
+   TClass *clActual = 0;
+   void *ptr = (void *) obj;
+
+   if (obj!=0) {
+      clActual = TObject::Class()->GetActualClass(obj);
+      if (!clActual) clActual = TObject::Class(); else
+      if (clActual != TObject::Class())
+         ptr = (void *) ((Long_t) obj - clActual->GetBaseClassOffset(TObject::Class()));
+   }
+
+   ConvertToJSON(ptr, clActual, json, compact, member_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts any type of object into JSON, writing directly into the
+/// caller-supplied string.
+/// See ConvertToJSON(const TObject*, TString&, Int_t, const char*).
+
+void TBufferJSON::ConvertToJSON(const void *obj, const TClass *cl, TString &json,
+                                Int_t compact, const char *member_name)
+{
+   if (member_name != 0) {
+      // the member conversion assembles its result in internal buffers anyway
+      json = ConvertToJSON(obj, cl, compact, member_name);
+      return;
+   }
+
+   json.Clear();
+
+   TBufferJSON buf;
+   buf.SetCompact(compact);
+   buf.fOutput = &json;
+   buf.JsonWriteObject(obj, cl);
+
+   if (json.Length() == 0) json = buf.fValue;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Set level of space/newline/array compression
 // Lower digit of compact parameter define formatting rules
@@ -3087,13 +3136,41 @@ void TBufferJSON::WriteCharStar(char *s)
    JsonWriteConstChar(s);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// format unsigned integer into buf, several times faster than snprintf;
+/// this is called for every numeric member and every histogram bin
+
+static void FormatUnsignedJSON(char *buf, ULong64_t value)
+{
+   char tmp[24], *p = tmp;
+   do {
+      *p++ = char('0' + value % 10);
+      value /= 10;
+   } while (value);
+   while (p != tmp) *buf++ = *--p;
+   *buf = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// format signed integer into buf, see FormatUnsignedJSON
+
+static void FormatSignedJSON(char *buf, Long64_t value)
+{
+   ULong64_t uvalue = (ULong64_t) value;
+   if (value < 0) {
+      *buf++ = '-';
+      uvalue = 0 - uvalue;
+   }
+   FormatUnsignedJSON(buf, uvalue);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// converts Char_t to string and add to json value buffer
 
 void TBufferJSON::JsonWriteBasic(Char_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
+   FormatSignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3103,7 +3180,7 @@ void TBufferJSON::JsonWriteBasic(Char_t value)
 void TBufferJSON::JsonWriteBasic(Short_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%hd", value);
+   FormatSignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3113,7 +3190,7 @@ void TBufferJSON::JsonWriteBasic(Short_t value)
 void TBufferJSON::JsonWriteBasic(Int_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
+   FormatSignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3123,7 +3200,7 @@ void TBufferJSON::JsonWriteBasic(Int_t value)
 void TBufferJSON::JsonWriteBasic(Long_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%ld", value);
+   FormatSignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3133,7 +3210,7 @@ void TBufferJSON::JsonWriteBasic(Long_t value)
 void TBufferJSON::JsonWriteBasic(Long64_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), FLong64, value);
+   FormatSignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3223,7 +3300,9 @@ void TBufferJSON::CompactFloatString(char* sbuf, unsigned len)
 void TBufferJSON::JsonWriteBasic(Float_t value)
 {
    char buf[200];
-   if (value == floor(value)) {
+   if ((value == floor(value)) && (fabs(value) < 1e15)) {
+      FormatSignedJSON(buf, (Long64_t) value);
+   } else if (value == floor(value)) {
       snprintf(buf, sizeof(buf), "%1.0f", value);
    } else {
       snprintf(buf, sizeof(buf), fgFloatFmt, value);
@@ -3238,7 +3317,9 @@ void TBufferJSON::JsonWriteBasic(Float_t value)
 void TBufferJSON::JsonWriteBasic(Double_t value)
 {
    char buf[200];
-   if (value == floor(value)) {
+   if ((value == floor(value)) && (fabs(value) < 1e15)) {
+      FormatSignedJSON(buf, (Long64_t) value);
+   } else if (value == floor(value)) {
       snprintf(buf, sizeof(buf), "%1.0f", value);
    } else {
       snprintf(buf, sizeof(buf), fgDoubleFmt, value);
@@ -3261,7 +3342,7 @@ void TBufferJSON::JsonWriteBasic(Bool_t value)
 void TBufferJSON::JsonWriteBasic(UChar_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
+   FormatUnsignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3271,7 +3352,7 @@ void TBufferJSON::JsonWriteBasic(UChar_t value)
 void TBufferJSON::JsonWriteBasic(UShort_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%hu", value);
+   FormatUnsignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3281,7 +3362,7 @@ void TBufferJSON::JsonWriteBasic(UShort_t value)
 void TBufferJSON::JsonWriteBasic(UInt_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
+   FormatUnsignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3291,7 +3372,7 @@ void TBufferJSON::JsonWriteBasic(UInt_t value)
 void TBufferJSON::JsonWriteBasic(ULong_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%lu", value);
+   FormatUnsignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -3301,7 +3382,7 @@ void TBufferJSON::JsonWriteBasic(ULong_t value)
 void TBufferJSON::JsonWriteBasic(ULong64_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), FULong64, value);
+   FormatUnsignedJSON(buf, value);
    fValue.Append(buf);
 }
 
@@ -0,0 +1,143 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TBufferMerger                                                        //
+//                                                                      //
+// Write-side parallelism for a single output TFile. Each worker       //
+// thread asks the merger for its own TBufferMergerFile, a TMemFile    //
+// specialization, and produces its directory subtree there: object    //
+// streaming and basket compression happen concurrently and without    //
+// locks, since every thread owns its staging file. A call to Write()  //
+// on the staging file merges what was accumulated into the output     //
+// file and resets the resetable objects (those with a ResetAfterMerge //
+// function, like TTree); only this merge step, i.e. the extent        //
+// allocation and key writes in the output file, is serialized by a    //
+// mutex inside the merger.                                            //
+//                                                                      //
+// ROOT::EnableThreadSafety() must be called before staging files are  //
+// used from several threads.                                          //
+//                                                                      //
+// Example:                                                            //
+//    TBufferMerger merger("out.root");                                //
+//    // in each worker thread:                                        //
+//    TBufferMergerFile *f = merger.GetFile();                         //
+//    f->mkdir("module1")->cd();                                       //
+//    ... produce objects ...                                          //
+//    f->Write();   // merge into out.root, keep f for the next batch  //
+//    delete f;     // when the worker is done                         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TBufferMerger.h"
+#include "TError.h"
+#include "TROOT.h"
+
+ClassImp(TBufferMergerFile)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the merger and open its output file with the given option and
+/// compression settings. The staging files handed out by GetFile() use the
+/// same compression, so merged baskets are not recompressed.
+
+TBufferMerger::TBufferMerger(const char *name, Option_t *option /* = "RECREATE" */,
+                             Int_t compress /* = 1 */)
+   : fMerger(kFALSE, kFALSE), fNFiles(0), fCompress(compress)
+{
+   // fMerger is not local: the staging files are in memory and must not be
+   // unlinked after each partial merge.
+   fMerger.OutputFile(name, option, compress);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor. Closes the output file. Staging files still attached at this
+/// point can no longer merge their content.
+
+TBufferMerger::~TBufferMerger()
+{
+   if (fNFiles > 0)
+      ::Warning("TBufferMerger::~TBufferMerger",
+              "%d staging file(s) still attached, their unmerged content is lost",
+              (Int_t)fNFiles);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new staging file attached to this merger. The caller (usually a
+/// worker thread) owns the file and deletes it when done producing.
+
+TBufferMergerFile *TBufferMerger::GetFile()
+{
+   TBufferMergerFile *file = new TBufferMergerFile(*this, fCompress);
+   fNFiles++;
+   return file;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the content of the given staging file into the output file.
+/// Called by TBufferMergerFile::Write; this is the only serialized step.
+
+Bool_t TBufferMerger::Merge(TMemFile *file)
+{
+   std::lock_guard<std::mutex> lock(fMergeMutex);
+   fMerger.AddFile(file, kFALSE);
+   Bool_t result = fMerger.PartialMerge(TFileMerger::kAll | TFileMerger::kIncremental);
+   fMerger.Reset();
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a staging file attached to the given merger, named after the
+/// merger's output file so gDirectory based code sees the expected name.
+
+TBufferMergerFile::TBufferMergerFile(TBufferMerger &merger, Int_t compress)
+   : TMemFile(merger.GetOutputFileName(), "RECREATE", "", compress), fMerger(&merger)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor. Detach from the merger; content written since the last call
+/// to Write() is not merged.
+
+TBufferMergerFile::~TBufferMergerFile()
+{
+   if (fMerger)
+      fMerger->Detach();
+   fMerger = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the objects of this staging file, merge them into the output file
+/// of the merger and reset the resetable objects (those with a
+/// ResetAfterMerge function, like TTree) so the file can accumulate the
+/// next batch. For values of opt see TObject::Write().
+
+Int_t TBufferMergerFile::Write(const char *, Int_t opt, Int_t bufsiz)
+{
+   Int_t nbytes = TMemFile::Write(0, opt, bufsiz);
+   if (nbytes && fMerger) {
+      if (!fMerger->Merge(this)) {
+         Error("Write", "could not merge into the output file %s",
+               fMerger->GetOutputFileName());
+         return 0;
+      }
+      ResetAfterMerge(0);
+   }
+   return nbytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// One can not save a const TDirectory object.
+
+Int_t TBufferMergerFile::Write(const char *n, Int_t opt, Int_t bufsize) const
+{
+   Error("Write const", "A const TFile object should not be saved. We try to proceed anyway.");
+   return const_cast<TBufferMergerFile*>(this)->Write(n, opt, bufsize);
+}
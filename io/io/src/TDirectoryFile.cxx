@@ -48,9 +48,158 @@ End_Macro
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
 
+#include <algorithm>
+#include <vector>
+
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compact index over the raw keys record of a directory. It keeps the
+/// record buffer plus, per key, the offset of the serialized key header and
+/// the hashes of its name and class name. TKey objects are decoded only
+/// when a key is actually requested; accessing the key list itself (via
+/// GetListOfKeys()) decodes the full list and deletes the index.
+
+class TDirectoryFile::TKeyIndex {
+public:
+   struct Slot_t {
+      Int_t  fOffset;     ///< Offset of the serialized key header in fBuffer
+      UInt_t fNameHash;   ///< Hash of the key name
+      UInt_t fClassHash;  ///< Hash of the key class name
+      TKey  *fKey;        ///< Key decoded on demand, owned until handed to fKeys
+
+      Slot_t(Int_t offset, UInt_t namehash, UInt_t classhash)
+         : fOffset(offset), fNameHash(namehash), fClassHash(classhash), fKey(0) {}
+   };
+
+   char               *fBuffer;   ///< Raw keys record, starting at the first key
+   std::vector<Slot_t> fSlots;    ///< One slot per key in the record
+   std::vector<Int_t>  fSorted;   ///< Slot indices ordered by name hash, built on first search
+
+   TKeyIndex(char *buffer) : fBuffer(buffer) {}
+
+   ~TKeyIndex()
+   {
+      for (size_t i = 0; i < fSlots.size(); i++)
+         delete fSlots[i].fKey;
+      delete [] fBuffer;
+   }
+
+   Int_t GetN() const { return (Int_t)fSlots.size(); }
+
+   /// Parse the key headers and fill the slots, without creating any TKey
+   /// or TString. Keys with an illegal seek address are rejected like in
+   /// the eager decoding; the number of accepted keys is returned.
+   Int_t Build(Int_t nkeys, Long64_t fsize)
+   {
+      // Same layout as TKey::ReadKeyBuffer(), see also kPidOffsetMask there.
+      const ULong64_t pidOffsetMask = 0xffffffffffffULL;
+      fSlots.reserve(nkeys);
+      char *buf = fBuffer;
+      for (Int_t i = 0; i < nkeys; i++) {
+         Int_t offset = Int_t(buf - fBuffer);
+         Int_t nbytes, objlen;
+         Version_t version;
+         UInt_t datime;
+         Short_t keylen, cycle;
+         Long64_t seekkey, seekpdir;
+         frombuf(buf, &nbytes);
+         frombuf(buf, &version);
+         frombuf(buf, &objlen);
+         frombuf(buf, &datime);
+         frombuf(buf, &keylen);
+         frombuf(buf, &cycle);
+         if (version > 1000) {
+            frombuf(buf, &seekkey);
+            Long64_t pdir;
+            frombuf(buf, &pdir);
+            seekpdir = pdir & pidOffsetMask;
+         } else {
+            UInt_t sk, sd;
+            frombuf(buf, &sk); seekkey  = (Long64_t)sk;
+            frombuf(buf, &sd); seekpdir = (Long64_t)sd;
+         }
+         if (seekkey < 64 || seekkey > fsize) {
+            ::Error("TDirectoryFile::ReadKeys","reading illegal key, exiting after %d keys",i);
+            return i;
+         }
+         if (seekpdir < 64 || seekpdir > fsize) {
+            ::Error("TDirectoryFile::ReadKeys","reading illegal key, exiting after %d keys",i);
+            return i;
+         }
+         UInt_t classhash = HashString(buf);
+         UInt_t namehash  = HashString(buf);
+         SkipString(buf);  // title
+         fSlots.push_back(Slot_t(offset, namehash, classhash));
+      }
+      return nkeys;
+   }
+
+   /// Return the position in the sorted ordering of the first slot with the
+   /// given name hash, or GetN() when no slot has it. The ordering is built
+   /// on first use; the slots never change once Build() has run, so it
+   /// stays valid for the lifetime of the index. Among slots with the same
+   /// hash the record order is preserved, which is what the cycle
+   /// resolution of GetKey() relies on.
+   Int_t FirstForHash(UInt_t hash)
+   {
+      if (fSorted.size() != fSlots.size()) {
+         fSorted.resize(fSlots.size());
+         for (size_t i = 0; i < fSlots.size(); i++) fSorted[i] = (Int_t)i;
+         const std::vector<Slot_t> &slots = fSlots;
+         std::sort(fSorted.begin(), fSorted.end(), [&slots](Int_t a, Int_t b) {
+            if (slots[a].fNameHash != slots[b].fNameHash)
+               return slots[a].fNameHash < slots[b].fNameHash;
+            return a < b;
+         });
+      }
+      const std::vector<Slot_t> &slots = fSlots;
+      std::vector<Int_t>::const_iterator it =
+         std::lower_bound(fSorted.begin(), fSorted.end(), hash,
+                          [&slots](Int_t a, UInt_t h) { return slots[a].fNameHash < h; });
+      return Int_t(it - fSorted.begin());
+   }
+
+   /// Return the key in the given slot, decoding it on first use.
+   TKey *GetKey(Int_t i, TDirectoryFile *dir)
+   {
+      Slot_t &slot = fSlots[i];
+      if (!slot.fKey) {
+         char *buf = fBuffer + slot.fOffset;
+         slot.fKey = new TKey(dir);
+         slot.fKey->ReadKeyBuffer(buf);
+      }
+      return slot.fKey;
+   }
+
+private:
+   static Int_t StringLength(char *&buf)
+   {
+      UChar_t nwh;
+      Int_t nchars;
+      frombuf(buf, &nwh);
+      if (nwh == 255)
+         frombuf(buf, &nchars);
+      else
+         nchars = nwh;
+      return nchars;
+   }
+
+   static UInt_t HashString(char *&buf)
+   {
+      Int_t nchars = StringLength(buf);
+      UInt_t hash = TString::Hash(buf, nchars);
+      buf += nchars;
+      return hash;
+   }
+
+   static void SkipString(char *&buf)
+   {
+      buf += StringLength(buf);
+   }
+};
+
 ClassImp(TDirectoryFile)
 
 
@@ -60,7 +209,7 @@ ClassImp(TDirectoryFile)
 TDirectoryFile::TDirectoryFile() : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeyIndex(0)
 {
 }
 
@@ -80,7 +229,7 @@ TDirectoryFile::TDirectoryFile(const char *name, const char *title, Option_t *cl
            : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeyIndex(0)
 {
    fName = name;
    fTitle = title;
@@ -168,7 +317,7 @@ void TDirectoryFile::Init(TClass *cl)
 TDirectoryFile::TDirectoryFile(const TDirectoryFile & directory) : TDirectory(directory)
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeyIndex(0)
 {
    ((TDirectoryFile&)directory).Copy(*this);
 }
@@ -178,6 +327,8 @@ TDirectoryFile::TDirectoryFile(const TDirectoryFile & directory) : TDirectory(di
 
 TDirectoryFile::~TDirectoryFile()
 {
+   SafeDelete(fKeyIndex);
+
    if (fKeys) {
       fKeys->Delete("slow");
       SafeDelete(fKeys);
@@ -230,6 +381,8 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
 
    key->SetMotherDir(this);
 
+   MaterializeKeys();
+
    // This is a fast hash lookup in case the key does not already exist
    TKey *oldkey = (TKey*)fKeys->FindObject(key->GetName());
    if (!oldkey) {
@@ -262,6 +415,7 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = 0;
       TIter nextin(fList);
       TKey *key = 0, *keyo = 0;
+      MaterializeKeys();
       TIter next(fKeys);
 
       cd();
@@ -559,6 +713,7 @@ void TDirectoryFile::Close(Option_t *)
    }
 
    // Delete keys from key list (but don't delete the list header)
+   SafeDelete(fKeyIndex);
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -922,6 +1077,14 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 //*-*---------------------Case of Key---------------------
 //                        ===========
    TKey *key;
+   if (fKeyIndex) {
+      // Materialize only the matching key.
+      if ((key = SearchKeyIndex(namobj, cycle, kTRUE))) {
+         TDirectory::TContext ctxt(this);
+         idcur = key->ReadObj();
+      }
+      return idcur;
+   }
    TIter nextkey(GetListOfKeys());
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
@@ -1036,6 +1199,14 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //                        ===========
    void *idcur = 0;
    TKey *key;
+   if (fKeyIndex) {
+      // Materialize only the matching key.
+      if ((key = SearchKeyIndex(namobj, cycle, kTRUE))) {
+         TDirectory::TContext ctxt(this);
+         idcur = key->ReadObjectAny(expectedClass);
+      }
+      return idcur;
+   }
    TIter nextkey(GetListOfKeys());
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
@@ -1070,6 +1241,9 @@ Int_t TDirectoryFile::GetBufferSize() const
 
 TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
+   if (fKeyIndex)
+      return SearchKeyIndex(name, cycle, kFALSE);
+
    // TIter::TIter() already checks for null pointers
    TIter next( ((THashList *)(GetListOfKeys()))->GetListForObject(name) );
 
@@ -1084,6 +1258,95 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys in this directory.
+
+Int_t TDirectoryFile::GetNkeys() const
+{
+   if (fKeyIndex) return fKeyIndex->GetN();
+
+   return fKeys->GetSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode the remaining entries of the compact key index into fKeys.
+///
+/// This keeps the contract that GetListOfKeys() returns the complete list
+/// of keys: any access to the list itself materializes all TKey objects,
+/// in record order, and deletes the index. Keys already decoded through the
+/// index keep their identity, so TKey pointers handed out earlier by e.g.
+/// GetKey() stay valid.
+
+void TDirectoryFile::MaterializeKeys() const
+{
+   if (!fKeyIndex) return;
+
+   TDirectoryFile *self = const_cast<TDirectoryFile*>(this);
+   TKeyIndex *index = self->fKeyIndex;
+   self->fKeyIndex = 0;
+   for (Int_t i = 0; i < index->GetN(); i++) {
+      TKey *key = index->GetKey(i, self);
+      index->fSlots[i].fKey = 0;    // ownership goes to fKeys
+      self->fKeys->Add(key);
+   }
+   delete index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up a key by name in the compact key index, materializing only the
+/// keys whose name hash matches. The lookup binary searches a hash-sorted
+/// ordering of the slots, so it is logarithmic in the number of keys even
+/// before any of them is decoded. With exactCycle the cycle must match the
+/// key's cycle, otherwise the GetKey() semantics (first key with a cycle
+/// not above the requested one, 9999 meaning highest cycle) apply.
+/// Returns 0 when there is no index or no match.
+
+TKey *TDirectoryFile::SearchKeyIndex(const char *name, Short_t cycle, Bool_t exactCycle) const
+{
+   if (!fKeyIndex) return 0;
+
+   UInt_t hash = TString::Hash(name, strlen(name));
+   Int_t n = fKeyIndex->GetN();
+   for (Int_t pos = fKeyIndex->FirstForHash(hash); pos < n; pos++) {
+      Int_t i = fKeyIndex->fSorted[pos];
+      if (fKeyIndex->fSlots[i].fNameHash != hash) break;
+      TKey *key = fKeyIndex->GetKey(i, const_cast<TDirectoryFile*>(this));
+      if (strcmp(name, key->GetName())) continue;
+      if (cycle == 9999) return key;
+      if (exactCycle ? (cycle == key->GetCycle()) : (cycle >= key->GetCycle()))
+         return key;
+   }
+
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of the given class, materializing only the
+/// keys whose class name hash matches when the compact key index is still
+/// present. Note: the index hashes the class name as stored on file, so
+/// keys written as "TDirectory" are not counted as "TDirectoryFile".
+
+Int_t TDirectoryFile::CountKeysOfClass(const char *classname) const
+{
+   Int_t count = 0;
+   if (fKeyIndex) {
+      UInt_t hash = TString::Hash(classname, strlen(classname));
+      for (Int_t i = 0; i < fKeyIndex->GetN(); i++) {
+         if (fKeyIndex->fSlots[i].fClassHash != hash) continue;
+         TKey *key = fKeyIndex->GetKey(i, const_cast<TDirectoryFile*>(this));
+         if (!strcmp(key->GetClassName(), classname)) count++;
+      }
+   } else {
+      TIter next(fKeys);
+      TKey *key;
+      while ((key = (TKey*)next())) {
+         if (!strcmp(key->GetClassName(), classname)) count++;
+      }
+   }
+
+   return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// List Directory contents
 ///
@@ -1301,6 +1564,7 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
    char *buffer;
    if (forceRead) {
+      SafeDelete(fKeyIndex);
       fKeys->Delete();
       //In case directory was updated by another process, read new
       //position for the keys
@@ -1341,24 +1605,20 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
       buffer = headerkey->GetBuffer();
       headerkey->ReadKeyBuffer(buffer);
 
-      TKey *key;
       frombuf(buffer, &nkeys);
-      for (Int_t i = 0; i < nkeys; i++) {
-         key = new TKey(this);
-         key->ReadKeyBuffer(buffer);
-         if (key->GetSeekKey() < 64 || key->GetSeekKey() > fsize) {
-            Error("ReadKeys","reading illegal key, exiting after %d keys",i);
-            fKeys->Remove(key);
-            nkeys = i;
-            break;
-         }
-         if (key->GetSeekPdir() < 64 || key->GetSeekPdir() > fsize) {
-            Error("ReadKeys","reading illegal key, exiting after %d keys",i);
-            fKeys->Remove(key);
-            nkeys = i;
-            break;
-         }
-         fKeys->Add(key);
+
+      // Defer the decoding of the key headers: only a compact index of
+      // offsets and name hashes is built here, the TKey objects are
+      // materialized when the keys are actually accessed.
+      Int_t nbytes = fNbytesKeys - Int_t(buffer - headerkey->GetBuffer());
+      if (nkeys > 0 && nbytes > 0) {
+         char *rawkeys = new char[nbytes];
+         memcpy(rawkeys, buffer, nbytes);
+         SafeDelete(fKeyIndex);
+         fKeyIndex = new TKeyIndex(rawkeys);
+         nkeys = fKeyIndex->Build(nkeys, fsize);
+      } else {
+         nkeys = 0;
       }
       delete headerkey;
    }
@@ -1413,6 +1673,7 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
    // Does not change: fFile
+   MaterializeKeys();
    TKey *key = (TKey*)fKeys->FindObject(fName);
    TClass *cl = IsA();
    if (key) {
@@ -2078,6 +2339,8 @@ void TDirectoryFile::WriteKeys()
       return;
    }
 
+   MaterializeKeys();
+
 //*-* Delete the old keys structure if it exists
    if (fSeekKeys != 0) {
       f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
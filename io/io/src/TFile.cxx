@@ -115,6 +115,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TROOT.h"
 #include "TStreamerInfo.h"
 #include "TStreamerElement.h"
+#include "THashList.h"
 #include "TSystem.h"
 #include "TTimeStamp.h"
 #include "TVirtualPerfStats.h"
@@ -132,6 +133,186 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TSchemaRuleSet.h"
 #include "TThreadSlots.h"
 #include "TGlobal.h"
+#include "ZipLZ4.h"
+
+#if defined(R__LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define R__USE_IOURING
+#endif
+#endif
+
+#ifdef R__USE_IOURING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <cstring>
+#include <vector>
+#include "ThreadLocalStorage.h"
+#if !defined(__NR_io_uring_setup) || !defined(__NR_io_uring_enter)
+#undef R__USE_IOURING
+#endif
+#endif
+
+#ifdef R__USE_IOURING
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Minimal io_uring wrapper used by TFile::ReadBuffers to submit all blocks
+/// of a vectored read as a single batch of asynchronous kernel requests.
+/// It talks to the kernel directly via the io_uring syscalls so no external
+/// library is needed. One ring is kept per thread and reused across calls.
+/// If the ring cannot be created (old kernel, seccomp filter), IsValid()
+/// stays false and the caller uses the synchronous read path.
+
+class RIoUring {
+
+private:
+   int           fRingFd;    // io_uring file descriptor, -1 if unavailable
+   UInt_t        fDepth;     // number of submission queue entries
+   void         *fSqRing;    // submission queue ring mapping
+   size_t        fSqRingLen; // length of the submission queue ring mapping
+   void         *fCqRing;    // completion queue ring mapping
+   size_t        fCqRingLen; // length of the completion queue ring mapping
+   void         *fSqes;      // submission entry array mapping
+   size_t        fSqesLen;   // length of the submission entry array mapping
+   UInt_t       *fSqTail;    // submission queue tail index
+   UInt_t       *fSqMask;    // submission queue ring mask
+   UInt_t       *fSqArray;   // submission queue index array
+   UInt_t       *fCqHead;    // completion queue head index
+   UInt_t       *fCqTail;    // completion queue tail index
+   UInt_t       *fCqMask;    // completion queue ring mask
+   io_uring_cqe *fCqes;      // completion entry array
+
+   void Cleanup()
+   {
+      if (fSqes   != MAP_FAILED) munmap(fSqes, fSqesLen);
+      if (fSqRing != MAP_FAILED) munmap(fSqRing, fSqRingLen);
+      if (fCqRing != MAP_FAILED) munmap(fCqRing, fCqRingLen);
+      fSqes = fSqRing = fCqRing = MAP_FAILED;
+      if (fRingFd >= 0) close(fRingFd);
+      fRingFd = -1;
+   }
+
+public:
+   RIoUring() : fRingFd(-1), fDepth(0), fSqRing(MAP_FAILED), fSqRingLen(0),
+                fCqRing(MAP_FAILED), fCqRingLen(0), fSqes(MAP_FAILED), fSqesLen(0),
+                fSqTail(0), fSqMask(0), fSqArray(0), fCqHead(0), fCqTail(0),
+                fCqMask(0), fCqes(0)
+   {
+      io_uring_params params;
+      memset(&params, 0, sizeof(params));
+      int fd = syscall(__NR_io_uring_setup, 64, &params);
+      if (fd < 0) return;
+      fSqRingLen = params.sq_off.array + params.sq_entries*sizeof(UInt_t);
+      fCqRingLen = params.cq_off.cqes  + params.cq_entries*sizeof(io_uring_cqe);
+      fSqesLen   = params.sq_entries*sizeof(io_uring_sqe);
+      fSqRing = mmap(0, fSqRingLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                     fd, IORING_OFF_SQ_RING);
+      fCqRing = mmap(0, fCqRingLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                     fd, IORING_OFF_CQ_RING);
+      fSqes   = mmap(0, fSqesLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                     fd, IORING_OFF_SQES);
+      if (fSqRing == MAP_FAILED || fCqRing == MAP_FAILED || fSqes == MAP_FAILED) {
+         fRingFd = fd;
+         Cleanup();
+         return;
+      }
+      char *sq = (char*)fSqRing;
+      char *cq = (char*)fCqRing;
+      fSqTail  = (UInt_t*)(sq + params.sq_off.tail);
+      fSqMask  = (UInt_t*)(sq + params.sq_off.ring_mask);
+      fSqArray = (UInt_t*)(sq + params.sq_off.array);
+      fCqHead  = (UInt_t*)(cq + params.cq_off.head);
+      fCqTail  = (UInt_t*)(cq + params.cq_off.tail);
+      fCqMask  = (UInt_t*)(cq + params.cq_off.ring_mask);
+      fCqes    = (io_uring_cqe*)(cq + params.cq_off.cqes);
+      fDepth   = params.sq_entries;
+      fRingFd  = fd;
+   }
+
+   ~RIoUring() { Cleanup(); }
+
+   Bool_t IsValid() const { return fRingFd >= 0; }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Read the nbuf blocks (pos[i], len[i]) into consecutive sections of buf,
+   /// submitting up to the ring depth of requests per io_uring_enter call.
+   /// The base offset is added to every block position; the caller passes its
+   /// fArchiveOffset so members of an archive read from the right place, just
+   /// as TFile::Seek does for the synchronous path.
+   /// Returns kTRUE when every block was read completely; on any failure
+   /// (including a short read) the caller falls back to the synchronous path.
+
+   Bool_t ReadBuffers(int fd, char *buf, Long64_t *pos, Int_t *len, Int_t nbuf, Long64_t baseoff)
+   {
+      std::vector<iovec> iov(nbuf);
+      Long64_t offset = 0;
+      for (Int_t i = 0; i < nbuf; i++) {
+         iov[i].iov_base = buf + offset;
+         iov[i].iov_len  = len[i];
+         offset += len[i];
+      }
+
+      Bool_t ok = kTRUE;
+      Int_t done = 0;
+      while (done < nbuf) {
+         UInt_t n = UInt_t(nbuf - done);
+         if (n > fDepth) n = fDepth;
+         UInt_t tail = *fSqTail;
+         for (UInt_t j = 0; j < n; j++) {
+            UInt_t idx = (tail + j) & *fSqMask;
+            io_uring_sqe &sqe = ((io_uring_sqe*)fSqes)[idx];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode    = IORING_OP_READV;
+            sqe.fd        = fd;
+            sqe.off       = baseoff + pos[done + j];
+            sqe.addr      = (ULong64_t)(ULong_t)&iov[done + j];
+            sqe.len       = 1;
+            sqe.user_data = done + j;
+            fSqArray[idx] = idx;
+         }
+         __atomic_store_n(fSqTail, tail + n, __ATOMIC_RELEASE);
+
+         UInt_t tosubmit = n;
+         while (tosubmit > 0) {
+            long ret = syscall(__NR_io_uring_enter, fRingFd, tosubmit, 0, 0,
+                               (void*)0, 0);
+            if (ret < 0) {
+               if (errno == EINTR) continue;
+               return kFALSE;
+            }
+            tosubmit -= ret;
+         }
+
+         // Reap all completions of this batch, even after a failed block,
+         // so the ring is drained before the synchronous fallback runs.
+         UInt_t reaped = 0;
+         while (reaped < n) {
+            UInt_t head  = *fCqHead;
+            UInt_t ctail = __atomic_load_n(fCqTail, __ATOMIC_ACQUIRE);
+            if (head == ctail) {
+               long ret = syscall(__NR_io_uring_enter, fRingFd, 0, 1,
+                                  IORING_ENTER_GETEVENTS, (void*)0, 0);
+               if (ret < 0 && errno != EINTR) return kFALSE;
+               continue;
+            }
+            while (head != ctail && reaped < n) {
+               io_uring_cqe &cqe = fCqes[head & *fCqMask];
+               if (cqe.res != (Int_t)iov[cqe.user_data].iov_len) ok = kFALSE;
+               head++;
+               reaped++;
+            }
+            __atomic_store_n(fCqHead, head, __ATOMIC_RELEASE);
+         }
+         done += n;
+      }
+      return ok;
+   }
+};
+
+} // unnamed namespace
+#endif // R__USE_IOURING
 
 using std::sqrt;
 
@@ -141,6 +322,7 @@ std::atomic<Long64_t> TFile::fgFileCounter{0};
 std::atomic<Int_t>    TFile::fgReadCalls{0};
 Int_t    TFile::fgReadaheadSize = 256000;
 Bool_t   TFile::fgReadInfo = kTRUE;
+Bool_t   TFile::fgLazyInfo = kFALSE;
 TList   *TFile::fgAsyncOpenRequests = 0;
 TString  TFile::fgCacheFileDir;
 Bool_t   TFile::fgCacheFileForce = kFALSE;
@@ -170,7 +352,7 @@ AddPseudoGlobals() {
 ////////////////////////////////////////////////////////////////////////////////
 /// File default Constructor.
 
-TFile::TFile() : TDirectoryFile(), fInfoCache(0)
+TFile::TFile() : TDirectoryFile(), fInfoCache(0), fPendingInfos(0)
 {
    fD               = -1;
    fFree            = 0;
@@ -189,6 +371,7 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
    fArchiveOffset   = 0;
    fReadCalls       = 0;
    fInfoCache       = 0;
+   fPendingInfos    = 0;
    fOpenPhases      = 0;
    fNoAnchorInName  = kFALSE;
    fIsRootFile      = kTRUE;
@@ -320,7 +503,8 @@ TFile::TFile() : TDirectoryFile(), fInfoCache(0)
 ///
 
 TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t compress)
-           : TDirectoryFile(), fUrl(fname1,kTRUE), fInfoCache(0), fOpenPhases(0)
+           : TDirectoryFile(), fUrl(fname1,kTRUE), fInfoCache(0), fPendingInfos(0),
+             fOpenPhases(0)
 {
    if (!gROOT)
       ::Fatal("TFile::TFile", "ROOT system not initialized");
@@ -533,7 +717,7 @@ zombie:
 ////////////////////////////////////////////////////////////////////////////////
 /// TFile objects can not be copied.
 
-TFile::TFile(const TFile &) : TDirectoryFile(), fInfoCache(0)
+TFile::TFile(const TFile &) : TDirectoryFile(), fInfoCache(0), fPendingInfos(0)
 {
    MayNotUse("TFile::TFile(const TFile &)");
 }
@@ -553,6 +737,7 @@ TFile::~TFile()
    SafeDelete(fFree);
    SafeDelete(fArchive);
    SafeDelete(fInfoCache);
+   SafeDelete(fPendingInfos);
    SafeDelete(fOpenPhases);
 
    {
@@ -859,20 +1044,16 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file.",GetName());
             }
          }
       }
    }
 
-   // Count number of TProcessIDs in this file
+   // Count number of TProcessIDs in this file without materializing the keys
    {
-      TIter next(fKeys);
-      TKey *key;
-      while ((key = (TKey*)next())) {
-         if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
-      }
+      fNProcessIDs += CountKeysOfClass("TProcessID");
       fProcessIDs = new TObjArray(fNProcessIDs+1);
    }
    return;
@@ -1527,6 +1708,153 @@ void TFile::Map()
    Printf("%d/%06d  At:%lld  N=%-8d  %-14s",date,time,idcur,1,"END");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Scan all records of this file and check the consistency of their
+/// compressed payloads without deserializing anything.
+///
+/// The envelope of every compression block is validated (signature and
+/// sizes) and, for blocks that carry one (LZ4 format version 2), the
+/// checksum of the compressed bytes is recomputed and compared. Corrupted
+/// records are reported with their address, size and class name, so a
+/// damaged basket or object can be identified immediately instead of
+/// surfacing later as a crash deep inside deserialization.
+///
+/// If option contains "map", every scanned record is also printed as in
+/// Map(). Returns the number of corrupted records found.
+
+Int_t TFile::Verify(Option_t *option)
+{
+   TString opt = option;
+   opt.ToLower();
+   Bool_t printall = opt.Contains("map");
+
+   Short_t  keylen,cycle;
+   UInt_t   datime;
+   Int_t    nbytes,date,time,objlen,nwheader;
+   date = 0;
+   time = 0;
+   Long64_t seekkey,seekpdir;
+   char    *buffer;
+   char     nwhc;
+   Long64_t idcur = fBEGIN;
+   Int_t    nerrors = 0;
+
+   nwheader = 64;
+   Int_t nread = nwheader;
+
+   char header[kBEGIN];
+   char classname[512];
+   char *payload = 0;
+   Int_t payloadsize = 0;
+
+   while (idcur < fEND) {
+      Seek(idcur);
+      if (idcur+nread >= fEND) nread = fEND-idcur-1;
+      if (ReadBuffer(header, nread)) {
+         // ReadBuffer returns kTRUE in case of failure.
+         Warning("Verify","%s: failed to read the key data from disk at %lld.",
+                 GetName(),idcur);
+         nerrors++;
+         break;
+      }
+
+      buffer=header;
+      frombuf(buffer, &nbytes);
+      if (!nbytes) {
+         Printf("Address = %lld\tNbytes = %d\t=====E R R O R=======", idcur, nbytes);
+         nerrors++;
+         break;
+      }
+      if (nbytes < 0) {
+         // A gap between records, not an error.
+         idcur -= nbytes;
+         continue;
+      }
+      Version_t versionkey;
+      frombuf(buffer, &versionkey);
+      frombuf(buffer, &objlen);
+      frombuf(buffer, &datime);
+      frombuf(buffer, &keylen);
+      frombuf(buffer, &cycle);
+      if (versionkey > 1000) {
+         frombuf(buffer, &seekkey);
+         frombuf(buffer, &seekpdir);
+      } else {
+         Int_t skey,sdir;
+         frombuf(buffer, &skey);  seekkey  = (Long64_t)skey;
+         frombuf(buffer, &sdir);  seekpdir = (Long64_t)sdir;
+      }
+      frombuf(buffer, &nwhc);
+      for (int i = 0;i < nwhc; i++) frombuf(buffer, &classname[i]);
+      classname[(int)nwhc] = '\0';
+      if (idcur == fSeekFree) strlcpy(classname,"FreeSegments",512);
+      if (idcur == fSeekInfo) strlcpy(classname,"StreamerInfo",512);
+      if (idcur == fSeekKeys) strlcpy(classname,"KeysList",512);
+      TDatime::GetDateTime(datime, date, time);
+
+      if (printall)
+         Printf("%d/%06d  At:%lld  N=%-8d  %-14s",date,time,idcur,nbytes,classname);
+
+      // Only records with a compressed payload need to be checked.
+      if (objlen != nbytes-keylen && keylen > 0 && nbytes > keylen &&
+          idcur != fSeekFree && idcur != fSeekKeys) {
+         Int_t datalen = nbytes-keylen;
+         if (datalen > payloadsize) {
+            delete [] payload;
+            payload = new char[datalen];
+            payloadsize = datalen;
+         }
+         Seek(idcur+keylen);
+         if (ReadBuffer(payload, datalen)) {
+            Warning("Verify","%s: failed to read the record payload from disk at %lld.",
+                    GetName(),idcur);
+            nerrors++;
+            idcur += nbytes;
+            continue;
+         }
+
+         // The payload is a sequence of compression blocks, each with a
+         // 9 byte envelope carrying the compressed and uncompressed sizes.
+         const Int_t hdrsize = 9;
+         Int_t nin = 0, nout = 0, bad = 0;
+         while (nin <= datalen-hdrsize) {
+            unsigned char *blk = (unsigned char*)payload + nin;
+            Int_t csize = (Int_t)blk[3] | ((Int_t)blk[4] << 8) | ((Int_t)blk[5] << 16);
+            Int_t usize = (Int_t)blk[6] | ((Int_t)blk[7] << 8) | ((Int_t)blk[8] << 16);
+            Bool_t knownmagic =
+               (blk[0] == 'Z' && blk[1] == 'L') || (blk[0] == 'C' && blk[1] == 'S') ||
+               (blk[0] == 'X' && blk[1] == 'Z') || (blk[0] == 'L' && blk[1] == '4') ||
+               (blk[0] == 'I' && blk[1] == 'E');
+            if (!knownmagic || csize <= 0 || usize <= 0 || nin+hdrsize+csize > datalen) {
+               bad = 1;
+               break;
+            }
+            if (blk[0] == 'L' && blk[1] == '4' &&
+                R__lz4VerifyBlock(blk, hdrsize+csize) < 0) {
+               bad = 2;
+               break;
+            }
+            nin  += hdrsize+csize;
+            nout += usize;
+         }
+         if (!bad && (nin != datalen || nout != objlen)) bad = 1;
+         if (bad) {
+            nerrors++;
+            Printf("%d/%06d  At:%lld  N=%-8d  %-14s ===== corrupted (%s)",
+                   date,time,idcur,nbytes,classname,
+                   bad == 2 ? "checksum mismatch" : "broken compression envelope");
+         }
+      }
+      idcur += nbytes;
+   }
+   delete [] payload;
+   if (nerrors)
+      Printf("%s: %d corrupted record(s) found",GetName(),nerrors);
+   else
+      Printf("%s: no corrupted records found",GetName());
+   return nerrors;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Paint all objects in the file.
 
@@ -1665,6 +1993,38 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+#ifdef R__USE_IOURING
+   // When enabled via the TFile.IoUringReads resource, submit all blocks of
+   // the vectored read as one batch of asynchronous kernel requests. Only
+   // plain local files qualify: derived classes (TMemFile, TSQLFile, remote
+   // protocols) redefine the Sys* primitives and must keep going through them.
+   if (nbuf > 1 && IsA() == TFile::Class()) {
+      static const Bool_t useuring = gEnv->GetValue("TFile.IoUringReads", 0) != 0;
+      if (useuring) {
+         TTHREAD_TLS_DECL(RIoUring, ring);
+         if (ring.IsValid()) {
+            Double_t start = 0;
+            if (gPerfStats != 0) start = TTimeStamp();
+            if (ring.ReadBuffers(fD, buf, pos, len, nbuf, fArchiveOffset)) {
+               Int_t total = 0;
+               for (Int_t j = 0; j < nbuf; j++) total += len[j];
+               fBytesRead  += total;
+               fgBytesRead += total;
+               fReadCalls++;
+               fgReadCalls++;
+               if (gMonitoringWriter)
+                  gMonitoringWriter->SendFileReadProgress(this);
+               if (gPerfStats != 0)
+                  gPerfStats->FileReadEvent(this, total, start);
+               return kFALSE;
+            }
+            // The batch could not be completed (e.g. a short read): fall
+            // through to the synchronous path which reports any real error.
+         }
+      }
+   }
+#endif
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -3473,6 +3833,40 @@ void TFile::ReadStreamerInfo()
       }
    }
 
+   if (fgLazyInfo && !IsWritable()) {
+      // Defer the BuildCheck of each TStreamerInfo until the first read of an
+      // object of that class (see ActivateStreamerInfo), so that opening a
+      // file with a large event model does not pay for the classes that are
+      // never touched. Only for files opened in read mode: in update mode
+      // the class index must reflect all infos present in the file.
+      delete fPendingInfos;
+      fPendingInfos = new THashList();
+      fPendingInfos->SetOwner();
+      TObjLink *lnk = list->FirstLink();
+      while (lnk) {
+         info = (TStreamerInfo*)lnk->GetObject();
+         lnk = lnk->Next();
+         if (info == 0) continue;
+         if (info->IsA() != TStreamerInfo::Class()) {
+            TObject *obj = (TObject*)info;
+            if (strcmp(obj->GetName(),"listOfRules") != 0)
+               Warning("ReadStreamerInfo","%s has a %s in the list of TStreamerInfo.", GetName(), info->IsA()->GetName());
+            info->SetBit(kCanDelete);
+            continue;
+         }
+         if (info->GetElements()==0) {
+            Warning("ReadStreamerInfo","The StreamerInfo for %s does not have a list of elements.",info->GetName());
+            continue;
+         }
+         list->Remove(info);
+         fPendingInfos->Add(info);
+      }
+      fClassIndex->fArray[0] = 0;
+      list->Clear();  //this will delete all TStreamerInfo objects with kCanDelete bit set
+      delete list;
+      return;
+   }
+
    // loop on all TStreamerInfo classes
    for (int mode=0;mode<2; ++mode) {
       // In order for the collection proxy to be initialized properly, we need
@@ -3519,15 +3913,7 @@ void TFile::ReadStreamerInfo()
          if ( (!isstl && mode ==0) || (isstl && mode ==1) ) {
                // Skip the STL container the first time around
                // Skip the regular classes the second time around;
-            info->BuildCheck(this);
-            Int_t uid = info->GetNumber();
-            Int_t asize = fClassIndex->GetSize();
-            if (uid >= asize && uid <100000) fClassIndex->Set(2*asize);
-            if (uid >= 0 && uid < fClassIndex->GetSize()) fClassIndex->fArray[uid] = 1;
-            else {
-               printf("ReadStreamerInfo, class:%s, illegal uid=%d\n",info->GetName(),uid);
-            }
-            if (gDebug > 0) printf(" -class: %s version: %d info read at slot %d\n",info->GetName(), info->GetClassVersion(),uid);
+            BuildStreamerInfo(info);
          }
          lnk = lnk->Next();
       }
@@ -3537,6 +3923,86 @@ void TFile::ReadStreamerInfo()
    delete list;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Register one TStreamerInfo read from this file with its class and record
+/// it in the class index.
+
+void TFile::BuildStreamerInfo(TStreamerInfo *info)
+{
+   info->BuildCheck(this);
+   Int_t uid = info->GetNumber();
+   Int_t asize = fClassIndex->GetSize();
+   if (uid >= asize && uid <100000) fClassIndex->Set(2*asize);
+   if (uid >= 0 && uid < fClassIndex->GetSize()) fClassIndex->fArray[uid] = 1;
+   else {
+      printf("ReadStreamerInfo, class:%s, illegal uid=%d\n",info->GetName(),uid);
+   }
+   if (gDebug > 0) printf(" -class: %s version: %d info read at slot %d\n",info->GetName(), info->GetClassVersion(),uid);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If the file was opened with lazy streamer info activation (see
+/// SetLazyStreamerInfo), register the streamer infos describing the
+/// specified class and, recursively, the classes it references. Called
+/// before an object of that class is read from the file; a no-op when
+/// there are no pending infos.
+
+void TFile::ActivateStreamerInfo(const char *clname)
+{
+   if (!fPendingInfos || !clname || !clname[0]) return;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   if (!fPendingInfos) return;
+   ActivateStreamerInfoImpl(clname);
+   if (fPendingInfos->GetSize() == 0)
+      SafeDelete(fPendingInfos);
+   fClassIndex->fArray[0] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the pending streamer info for the specified class, after the
+/// infos of the classes referenced by its elements (bases, object data
+/// members and the template arguments of STL containers), so that the
+/// collection proxies see their contained classes, as in the eager case
+/// where all non-STL infos are built before the STL ones.
+
+void TFile::ActivateStreamerInfoImpl(const char *clname)
+{
+   TStreamerInfo *info = (TStreamerInfo*)fPendingInfos->FindObject(clname);
+   if (!info) {
+      // An STL container has no pending info of its own element classes;
+      // activate the infos of its template arguments.
+      if (TClassEdit::IsSTLCont(clname)) {
+         std::vector<std::string> splitName;
+         Int_t nestedLoc = 0;
+         TClassEdit::GetSplit(clname, splitName, nestedLoc);
+         for (size_t i = 1; i < splitName.size(); ++i) {
+            if (!splitName[i].empty())
+               ActivateStreamerInfoImpl(splitName[i].c_str());
+         }
+      }
+      return;
+   }
+   // Remove before recursing so that reference cycles terminate.
+   fPendingInfos->Remove(info);
+
+   TIter next(info->GetElements());
+   TStreamerElement *element;
+   while ((element = (TStreamerElement*)next())) {
+      if (element->IsBase()) {
+         ActivateStreamerInfoImpl(element->GetName());
+      } else {
+         TString tname = element->GetTypeName();
+         tname.ReplaceAll("*", "");
+         tname.ReplaceAll("const ", "");
+         tname = tname.Strip(TString::kBoth);
+         if (tname.Length() && tname != info->GetName())
+            ActivateStreamerInfoImpl(tname);
+      }
+   }
+   BuildStreamerInfo(info);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Specify if the streamerinfos must be read at file opening.
 ///
@@ -3563,6 +4029,31 @@ Bool_t TFile::GetReadStreamerInfo()
    return fgReadInfo;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Specify if the streamerinfos of files opened for reading must be
+/// activated lazily.
+///
+/// If fgLazyInfo is true, ReadStreamerInfo defers the registration of each
+/// TStreamerInfo with its class until the first object of that class is
+/// read from the file (see ActivateStreamerInfo). This speeds up opening
+/// files that describe many more classes than the job actually reads.
+/// Files opened in update mode always register all infos at open time.
+
+void TFile::SetLazyStreamerInfo(Bool_t lazy)
+{
+   fgLazyInfo = lazy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If the streamerinfos are to be activated lazily.
+///
+/// See TFile::SetLazyStreamerInfo for more documentation.
+
+Bool_t TFile::GetLazyStreamerInfo()
+{
+   return fgLazyInfo;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Show the StreamerInfo of all classes written to this file.
 
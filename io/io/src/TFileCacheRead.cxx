@@ -29,6 +29,7 @@
 #include "TFile.h"
 #include "TFileCacheRead.h"
 #include "TFileCacheWrite.h"
+#include "TMemoryGovernor.h"
 #include "TFilePrefetch.h"
 #include "TMath.h"
 
@@ -96,6 +97,9 @@ TFileCacheRead::TFileCacheRead(TFile *file, Int_t buffersize, TObject *tree)
    else fBufferSize = buffersize;
 
    fBufferSizeMin = fBufferSize;
+   // report the cache size to the memory governor; under a memory budget
+   // this shrinks the other registered caches first
+   TMemoryGovernor::RequestMemory("TFileCacheRead", fBufferSize);
    fBufferLen   = 0;
    fBytesRead   = 0;
    fNoCacheBytesRead = 0;
@@ -158,6 +162,7 @@ TFileCacheRead::TFileCacheRead(TFile *file, Int_t buffersize, TObject *tree)
 
 TFileCacheRead::~TFileCacheRead()
 {
+   TMemoryGovernor::Accumulate("TFileCacheRead", -(Long64_t)fBufferSize);
    SafeDelete(fPrefetch);
    delete [] fSeek;
    delete [] fSeekIndex;
@@ -566,7 +571,8 @@ void TFileCacheRead::SetFile(TFile *file, TFile::ECacheAction action)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Sort buffers to be prefetched in increasing order of positions.
-/// Merge consecutive blocks if necessary.
+/// Duplicate, adjacent and overlapping blocks are merged so every byte
+/// is transferred only once.
 
 void TFileCacheRead::Sort()
 {
@@ -602,19 +608,26 @@ void TFileCacheRead::Sort()
    fPos[0]  = fSeekSort[0];
    fLen[0]  = fSeekSortLen[0];
    fSeekPos[0] = 0;
+   Int_t blockPos = 0;  // position of the current block in fBuffer
    for (i=1;i<fNseek;i++) {
-      fSeekPos[i] = fSeekPos[i-1] + fSeekSortLen[i-1];
       //in the test below 16 MBytes is pure empirirical and may depend on the file system.
       //increasing this number must be done with care, as it may increase
       //the job real time (mismatch with OS buffers)
-      if ((fSeekSort[i] != fSeekSort[i-1]+fSeekSortLen[i-1]) ||
+      if ((fSeekSort[i] > fPos[nb]+fLen[nb]) ||
           (fLen[nb] > 16000000)) {
+         blockPos += fLen[nb];
          nb++;
          fPos[nb] = fSeekSort[i];
          fLen[nb] = fSeekSortLen[i];
       } else {
-         fLen[nb] += fSeekSortLen[i];
+         // the block is adjacent to or overlaps the current one: extend it,
+         // bytes shared by several blocks are transferred only once
+         Long64_t blockEnd = fPos[nb] + fLen[nb];
+         Long64_t thisEnd  = fSeekSort[i] + fSeekSortLen[i];
+         if (thisEnd > blockEnd)
+            fLen[nb] += Int_t(thisEnd - blockEnd);
       }
+      fSeekPos[i] = blockPos + Int_t(fSeekSort[i] - fPos[nb]);
    }
    fNb = nb+1;
    fIsSorted = kTRUE;
@@ -624,7 +637,8 @@ void TFileCacheRead::Sort()
 ////////////////////////////////////////////////////////////////////////////////
 /// Sort buffers to be prefetched in increasing order of positions.
 ///
-/// Merge consecutive blocks if necessary.
+/// Duplicate, adjacent and overlapping blocks are merged so every byte
+/// is transferred only once.
 
 void TFileCacheRead::SecondSort()
 {
@@ -660,19 +674,26 @@ void TFileCacheRead::SecondSort()
    fBPos[0]  = fBSeekSort[0];
    fBLen[0]  = fBSeekSortLen[0];
    fBSeekPos[0] = 0;
+   Int_t blockPos = 0;  // position of the current block in fBuffer
    for (i=1;i<fBNseek;i++) {
-      fBSeekPos[i] = fBSeekPos[i-1] + fBSeekSortLen[i-1];
       //in the test below 16 MBytes is pure empirirical and may depend on the file system.
       //increasing this number must be done with care, as it may increase
       //the job real time (mismatch with OS buffers)
-      if ((fBSeekSort[i] != fBSeekSort[i-1]+fBSeekSortLen[i-1]) ||
+      if ((fBSeekSort[i] > fBPos[nb]+fBLen[nb]) ||
          (fBLen[nb] > 16000000)) {
+         blockPos += fBLen[nb];
          nb++;
          fBPos[nb] = fBSeekSort[i];
          fBLen[nb] = fBSeekSortLen[i];
       } else {
-         fBLen[nb] += fBSeekSortLen[i];
+         // the block is adjacent to or overlaps the current one: extend it,
+         // bytes shared by several blocks are transferred only once
+         Long64_t blockEnd = fBPos[nb] + fBLen[nb];
+         Long64_t thisEnd  = fBSeekSort[i] + fBSeekSortLen[i];
+         if (thisEnd > blockEnd)
+            fBLen[nb] += Int_t(thisEnd - blockEnd);
       }
+      fBSeekPos[i] = blockPos + Int_t(fBSeekSort[i] - fBPos[nb]);
    }
    fBNb = nb+1;
    fBIsSorted = kTRUE;
@@ -747,6 +768,10 @@ Int_t TFileCacheRead::SetBufferSize(Int_t buffersize)
 
    delete [] fBuffer;
    fBuffer = np;
+   if (buffersize > fBufferSize)
+      TMemoryGovernor::RequestMemory("TFileCacheRead", (Long64_t)buffersize - fBufferSize);
+   else
+      TMemoryGovernor::Accumulate("TFileCacheRead", (Long64_t)buffersize - fBufferSize);
    fBufferSizeMin = buffersize;
    fBufferSize = buffersize;
 
@@ -28,6 +28,7 @@ The write cache is automatically created when writing a remote file
 
 #include "TFile.h"
 #include "TFileCacheWrite.h"
+#include "TMemoryGovernor.h"
 
 ClassImp(TFileCacheWrite)
 
@@ -59,6 +60,9 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
    fNtot        = 0;
    fFile        = file;
    fRecursive   = kFALSE;
+   // report the buffer to the memory governor; under a memory budget this
+   // shrinks the registered read caches first
+   TMemoryGovernor::RequestMemory("TFileCacheWrite", fBufferSize);
    fBuffer      = new char[fBufferSize];
    if (file) file->SetCacheWrite(this);
    if (gDebug > 0) Info("TFileCacheWrite","Creating a write cache with buffersize=%d bytes",buffersize);
@@ -69,6 +73,7 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
 
 TFileCacheWrite::~TFileCacheWrite()
 {
+   TMemoryGovernor::Accumulate("TFileCacheWrite", -(Long64_t)fBufferSize);
    delete [] fBuffer;
 }
 
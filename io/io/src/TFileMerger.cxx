@@ -88,6 +88,7 @@ static Int_t R__GetSystemMaxOpenedFiles()
 
 TFileMerger::TFileMerger(Bool_t isLocal, Bool_t histoOneGo)
             : fOutputFile(0), fFastMethod(kTRUE), fNoTrees(kFALSE), fExplicitCompLevel(kFALSE), fCompressionChange(kFALSE),
+              fKeepCompressedBaskets(kFALSE), fAllInMemorySources(kTRUE),
               fPrintLevel(0), fMsgPrefix("TFileMerger"), fMaxOpenedFiles( R__GetSystemMaxOpenedFiles() ),
               fLocal(isLocal), fHistoOneGo(histoOneGo), fObjectNames()
 {
@@ -121,6 +122,7 @@ void TFileMerger::Reset()
 {
    fFileList->Clear();
    fMergeList->Clear();
+   fAllInMemorySources = kTRUE;
    fExcessFiles->Clear();
    fObjectNames.Clear();
 }
@@ -130,6 +132,7 @@ void TFileMerger::Reset()
 
 Bool_t TFileMerger::AddFile(const char *url, Bool_t cpProgress)
 {
+   fAllInMemorySources = kFALSE;
    if (fPrintLevel > 0) {
       Printf("%s Source file %d: %s",fMsgPrefix.Data(),fFileList->GetEntries()+fExcessFiles->GetEntries()+1,url);
    }
@@ -222,6 +225,7 @@ Bool_t TFileMerger::AddFile(TFile *source, Bool_t own, Bool_t cpProgress)
    if (source == 0) {
       return kFALSE;
    }
+   if (!source->InheritsFrom(TMemFile::Class())) fAllInMemorySources = kFALSE;
 
    if (fPrintLevel > 0) {
       Printf("%s Source file %d: %s",fMsgPrefix.Data(),fFileList->GetEntries()+1,source->GetName());
@@ -391,7 +395,15 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
 
    TFileMergeInfo info(target);
    info.fOptions = fMergeOptions;
-   if (fFastMethod && ((type&kKeepCompression) || !fCompressionChange) ) {
+   // Keeping the original basket compression makes the fast path usable
+   // even when the output compression level differs: TTreeCloner splices
+   // the already-compressed baskets as-is (after validating that the tree
+   // schemas match). This is forced for in-process TMemFile sources, whose
+   // writer threads already paid for the compression, unless the user
+   // explicitly requested a compression change.
+   Bool_t keepCompression = (type&kKeepCompression) || fKeepCompressedBaskets ||
+                            (fAllInMemorySources && !fExplicitCompLevel);
+   if (fFastMethod && (keepCompression || !fCompressionChange) ) {
       info.fOptions.Append(" fast");
    }
 
@@ -32,19 +32,22 @@ size(), clear(), resize(). resize() may be a void operation.
 #include "TVirtualCollectionIterators.h"
 
 TGenCollectionStreamer::TGenCollectionStreamer(const TGenCollectionStreamer& copy)
-      : TGenCollectionProxy(copy), fReadBufferFunc(&TGenCollectionStreamer::ReadBufferDefault)
+      : TGenCollectionProxy(copy), fReadBufferFunc(&TGenCollectionStreamer::ReadBufferDefault),
+        fStagingArea(0), fStagingLen(0)
 {
    // Build a Streamer for an emulated vector whose type is 'name'.
 }
 
 TGenCollectionStreamer::TGenCollectionStreamer(Info_t info, size_t iter_size)
-      : TGenCollectionProxy(info, iter_size), fReadBufferFunc(&TGenCollectionStreamer::ReadBufferDefault)
+      : TGenCollectionProxy(info, iter_size), fReadBufferFunc(&TGenCollectionStreamer::ReadBufferDefault),
+        fStagingArea(0), fStagingLen(0)
 {
    // Build a Streamer for a collection whose type is described by 'collectionClass'.
 }
 
 TGenCollectionStreamer::TGenCollectionStreamer(const ::ROOT::TCollectionProxyInfo &info, TClass *cl)
-      : TGenCollectionProxy(info, cl), fReadBufferFunc(&TGenCollectionStreamer::ReadBufferDefault)
+      : TGenCollectionProxy(info, cl), fReadBufferFunc(&TGenCollectionStreamer::ReadBufferDefault),
+        fStagingArea(0), fStagingLen(0)
 {
    // Build a Streamer for a collection whose type is described by 'collectionClass'.
 }
@@ -52,6 +55,21 @@ TGenCollectionStreamer::TGenCollectionStreamer(const ::ROOT::TCollectionProxyInf
 TGenCollectionStreamer::~TGenCollectionStreamer()
 {
    // Standard destructor.
+   delete [] fStagingArea;
+}
+
+TGenCollectionProxy::StreamHelper *TGenCollectionStreamer::GetStagingArea(size_t len)
+{
+   // Return a staging area of at least len bytes. The area is kept across
+   // entries, growing monotonically like the capacity of a TClonesArray, so
+   // that feed-based containers do not pay for a heap allocation at every
+   // entry.
+   if (len > fStagingLen) {
+      delete [] fStagingArea;
+      fStagingArea = new char[len];
+      fStagingLen = len;
+   }
+   return (TGenCollectionProxy::StreamHelper*)fStagingArea;
 }
 
 TVirtualCollectionProxy* TGenCollectionStreamer::Generate() const
@@ -213,9 +231,7 @@ void TGenCollectionStreamer::ReadPrimitives(int nElements, TBuffer &b, const TCl
 {
    // Primitive input streamer.
    size_t len = fValDiff * nElements;
-   char   buffer[8096];
    Bool_t   feed = false;
-   void*  memory = 0;
    StreamHelper* itmstore = 0;
    StreamHelper* itmconv = 0;
    fEnv->fSize = nElements;
@@ -233,7 +249,7 @@ void TGenCollectionStreamer::ReadPrimitives(int nElements, TBuffer &b, const TCl
          }
       default:
          feed = true;
-         itmstore = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
+         itmstore = GetStagingArea(len);
          break;
    }
    fEnv->fStart = itmstore;
@@ -355,9 +371,6 @@ void TGenCollectionStreamer::ReadPrimitives(int nElements, TBuffer &b, const TCl
    }
    if (feed)  {      // need to feed in data...
       fEnv->fStart = fFeed(itmstore,fEnv->fObject,fEnv->fSize);
-      if (memory)  {
-         ::operator delete(memory);
-      }
    }
 }
 
@@ -367,8 +380,6 @@ void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass
    Bool_t vsn3 = b.GetInfo() && b.GetInfo()->GetOldVersion() <= 3;
    size_t len = fValDiff * nElements;
    StreamHelper* itm = 0;
-   char   buffer[8096];
-   void*  memory = 0;
 
    TClass* onFileValClass = (onFileClass ? onFileClass->GetCollectionProxy()->GetValueClass() : 0);
 
@@ -432,7 +443,7 @@ void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass
       case ROOT::kSTLunorderedset:
       case ROOT::kSTLunorderedmultiset:
 #define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)(((char*)itm) + fValDiff*idx); { x ;} ++idx;}}
-         fEnv->fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
+         fEnv->fStart = itm = GetStagingArea(len);
          fConstruct(itm,nElements);
          switch (fVal->fCase) {
             case kIsClass:
@@ -463,9 +474,6 @@ void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass
       default:
          break;
    }
-   if (memory) {
-      ::operator delete(memory);
-   }
 }
 
 void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
@@ -475,8 +483,6 @@ void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
    Bool_t vsn3 = b.GetInfo() && b.GetInfo()->GetOldVersion() <= 3;
    size_t len = fValDiff * nElements;
    StreamHelper* itm = 0;
-   char   buffer[8096];
-   void*  memory = 0;
 
    TStreamerInfo *pinfo = (TStreamerInfo*)fVal->fType->GetStreamerInfo();
    R__ASSERT(pinfo);
@@ -543,7 +549,7 @@ void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
       case ROOT::kSTLunorderedset:
       case ROOT::kSTLunorderedmultiset:
 #define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)(((char*)itm) + fValDiff*idx); { x ;} ++idx;}}
-         fEnv->fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
+         fEnv->fStart = itm = GetStagingArea(len);
          fConstruct(itm,nElements);
          switch (fVal->fCase) {
             case kIsClass:
@@ -560,9 +566,6 @@ void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
       default:
          break;
    }
-   if (memory) {
-      ::operator delete(memory);
-   }
 }
 
 
@@ -730,12 +733,11 @@ void TGenCollectionStreamer::ReadMap(int nElements, TBuffer &b, const TClass *on
    Bool_t vsn3 = b.GetInfo() && b.GetInfo()->GetOldVersion() <= 3;
    size_t len = fValDiff * nElements;
    Value  *v;
-   char buffer[8096], *addr, *temp;
-   void* memory = 0;
+   char *addr, *temp;
    StreamHelper* i;
    float f;
    fEnv->fSize  = nElements;
-   fEnv->fStart = (len < sizeof(buffer) ? buffer : memory =::operator new(len));
+   fEnv->fStart = GetStagingArea(len);
    addr = temp = (char*)fEnv->fStart;
    fConstruct(addr,nElements);
 
@@ -885,17 +887,12 @@ void TGenCollectionStreamer::ReadMap(int nElements, TBuffer &b, const TClass *on
    }
    fFeed(fEnv->fStart,fEnv->fObject,fEnv->fSize);
    fDestruct(fEnv->fStart,fEnv->fSize);
-   if (memory) {
-      ::operator delete(memory);
-   }
 }
 
 void TGenCollectionStreamer::WritePrimitives(int nElements, TBuffer &b)
 {
    // Primitive output streamer.
    size_t len = fValDiff * nElements;
-   char   buffer[8192];
-   void*  memory  = 0;
    StreamHelper* itm = 0;
    switch (fSTL_type)  {
       case ROOT::kSTLvector:
@@ -904,7 +901,7 @@ void TGenCollectionStreamer::WritePrimitives(int nElements, TBuffer &b)
             break;
          }
       default:
-         fEnv->fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
+         fEnv->fStart = itm = GetStagingArea(len);
          fCollect(fEnv->fObject,itm);
          break;
    }
@@ -959,9 +956,6 @@ void TGenCollectionStreamer::WritePrimitives(int nElements, TBuffer &b)
       case kOther_t:
          Error("TGenCollectionStreamer", "fType %d is not supported yet!\n", fVal->fKind);
    }
-   if (memory)  {
-      ::operator delete(memory);
-   }
 }
 
 void TGenCollectionStreamer::WriteObjects(int nElements, TBuffer &b)
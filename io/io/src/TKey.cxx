@@ -729,6 +729,12 @@ void TKey::Print(Option_t *) const
 
 TObject *TKey::ReadObj()
 {
+   // In case the file was opened with lazy streamer info activation, the
+   // infos for this class must be registered before the class is looked up
+   // (they may describe an emulated class).
+   if (TFile *f = GetFile())
+      f->ActivateStreamerInfo(fClassName);
+
    TClass *cl = TClass::GetClass(fClassName.Data());
    if (!cl) {
       Error("ReadObj", "Unknown class %s", fClassName.Data());
@@ -871,6 +877,8 @@ CLEAR:
 
 TObject *TKey::ReadObjWithBuffer(char *bufferRead)
 {
+   if (TFile *f = GetFile())
+      f->ActivateStreamerInfo(fClassName);
 
    TClass *cl = TClass::GetClass(fClassName.Data());
    if (!cl) {
@@ -1007,6 +1015,9 @@ CLEAR:
 
 void *TKey::ReadObjectAny(const TClass* expectedClass)
 {
+   if (TFile *f = GetFile())
+      f->ActivateStreamerInfo(fClassName);
+
    fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
    if (!fBufferRef) {
       Error("ReadObj", "Cannot allocate buffer: fObjlen = %d", fObjlen);
@@ -0,0 +1,204 @@
+// @(#)root/io:$Id$
+// Author: Philippe Canal, August 2017
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\class TMmapFile TMmapFile.cxx
+\ingroup IO
+
+A TMmapFile is a local ROOT file opened in read-only mode whose content
+is memory mapped instead of being accessed through read() system calls.
+Basket and key reads are served by copying directly out of the mapping,
+which avoids one kernel/user copy per read and lets the operating system
+page cache be shared between processes reading the same file.
+
+A TMmapFile can be created via the plugin manager with
+~~~{.cpp}
+   TFile *f = TFile::Open("mmap:/data/h1big.root");
+~~~
+or by constructing it directly. If the mapping cannot be established
+(e.g. on platforms without mmap support) the file transparently falls
+back to the regular read() based access of TFile.
+*/
+
+#include "TMmapFile.h"
+#include "TSystem.h"
+#include "TError.h"
+
+#ifndef WIN32
+#   include <unistd.h>
+#   include <sys/mman.h>
+#endif
+
+ClassImp(TMmapFile)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open a local ROOT file in read-only mode and map it into memory.
+/// Only option "READ" is supported; any attempt to open a TMmapFile for
+/// writing makes the object a zombie.
+
+TMmapFile::TMmapFile(const char *name, Option_t *option, const char *ftitle, Int_t compress) :
+   TFile(name, "WEB", ftitle, compress), fMmapBase(0), fMmapSize(0), fSysOffset(0)
+{
+   fOption = option;
+   fOption.ToUpper();
+   if (fOption != "READ" && fOption != "") {
+      Error("TMmapFile", "file %s can only be opened in \"READ\" mode", name);
+      goto zombie;
+   }
+   fOption = "READ";
+   fWritable = kFALSE;
+
+   // The base class constructor returned early because of the "WEB"
+   // option, so expand the local path ourselves.
+   {
+      const char *fname = gSystem->ExpandPathName(fUrl.GetFile());
+      if (fname) {
+         SetName(fname);
+         delete [] fname;
+         fRealName = GetName();
+      } else {
+         Error("TMmapFile", "error expanding path %s", fUrl.GetFile());
+         goto zombie;
+      }
+   }
+
+   fD = SysOpen(fRealName, O_RDONLY, 0644);
+   if (fD == -1) {
+      SysError("TMmapFile", "file %s can not be opened for reading", name);
+      goto zombie;
+   }
+
+   Init(kFALSE);
+
+   return;
+
+zombie:
+   // Error in opening file; make this object a zombie
+   MakeZombie();
+   gDirectory = gROOT;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Close the file releasing the mapping.
+
+TMmapFile::~TMmapFile()
+{
+   Close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open the underlying file and establish the read-only mapping.
+/// If mmap() is not available or fails the descriptor is still usable and
+/// reads fall back to the TFile implementation.
+
+Int_t TMmapFile::SysOpen(const char *pathname, Int_t flags, UInt_t mode)
+{
+   Int_t fd = TFile::SysOpen(pathname, flags, mode);
+#ifndef WIN32
+   if (fd >= 0) {
+      Long64_t size = 0;
+      Long_t id = 0, fileflags = 0, modtime = 0;
+      if (gSystem->GetPathInfo(pathname, &id, &size, &fileflags, &modtime) == 0 && size > 0) {
+         void *base = mmap(0, (size_t) size, PROT_READ, MAP_SHARED, fd, 0);
+         if (base != MAP_FAILED) {
+            fMmapBase = base;
+            fMmapSize = size;
+#ifdef MADV_WILLNEED
+            madvise(base, (size_t) size, MADV_WILLNEED);
+#endif
+         } else {
+            Warning("SysOpen", "cannot mmap file %s (errno: %d), falling back to read()",
+                    pathname, TSystem::GetErrno());
+         }
+      }
+   }
+#endif
+   return fd;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unmap the file and close the underlying descriptor.
+
+Int_t TMmapFile::SysClose(Int_t fd)
+{
+#ifndef WIN32
+   if (fMmapBase) {
+      munmap(fMmapBase, (size_t) fMmapSize);
+      fMmapBase = 0;
+      fMmapSize = 0;
+   }
+#endif
+   fSysOffset = 0;
+   return TFile::SysClose(fd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read specified number of bytes from the current offset of the mapping.
+/// See documentation for TFile::SysRead().
+
+Int_t TMmapFile::SysRead(Int_t fd, void *buf, Int_t len)
+{
+   if (!fMmapBase)
+      return TFile::SysRead(fd, buf, len);
+
+   if (fSysOffset >= fMmapSize)
+      return 0;
+   if (len > (fMmapSize - fSysOffset))
+      len = (Int_t) (fMmapSize - fSysOffset);
+   if (len > 0) {
+      memcpy(buf, ((const char *) fMmapBase) + fSysOffset, len);
+      fSysOffset += len;
+   }
+   return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// A TMmapFile is read-only; writing is not supported.
+
+Int_t TMmapFile::SysWrite(Int_t, const void *, Int_t)
+{
+   Error("SysWrite", "A TMmapFile is read-only");
+   gSystem->SetErrorStr("A TMmapFile is read-only");
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Seek to a specified position in the mapping. See TFile::SysSeek().
+
+Long64_t TMmapFile::SysSeek(Int_t fd, Long64_t offset, Int_t whence)
+{
+   if (!fMmapBase)
+      return TFile::SysSeek(fd, offset, whence);
+
+   if (whence == SEEK_SET) {
+      fSysOffset = offset;
+   } else if (whence == SEEK_CUR) {
+      fSysOffset += offset;
+   } else if (whence == SEEK_END) {
+      if (offset > 0) {
+         Error("SysSeek", "cannot seek past end of file");
+         return -1;
+      }
+      fSysOffset = fMmapSize + offset;
+   } else {
+      Error("SysSeek", "unknown seek option (%d)", whence);
+      return -1;
+   }
+   return fSysOffset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// No sync is needed for a read-only file.
+
+Int_t TMmapFile::SysSync(Int_t)
+{
+   return 0;
+}
@@ -0,0 +1,320 @@
+// @(#)root/io:$Id$
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\class TSharedMemFile TSharedMemFile.cxx
+\ingroup IO
+
+A TSharedMemFile is like a TMemFile except that its buffer lives in a
+named POSIX shared memory segment (shm_open/mmap) instead of private
+heap, so several processes can exchange ROOT objects without streaming
+them through sockets or the file system: a worker process writes its
+results into the segment, the parent opens the same segment read-only
+and deserializes directly from the mapped pages.
+
+The name must be a valid shm name, ie start with a '/' and contain no
+further slashes (a missing leading '/' is added). The segment is created
+with a fixed maximum size (segmentSize argument, default 256 MB); since
+the pages are only committed when touched, reserving a generous maximum
+is cheap. The segment outlives the TSharedMemFile object: remove it with
+TSharedMemFile::Unlink() once the consumer is done with it.
+
+Example (worker/parent exchange after a fork):
+~~~{.cpp}
+  // worker
+  TSharedMemFile f("/shared-result","RECREATE");
+  f.WriteTObject(hist,"hist");
+  f.Close();
+  // parent, after the worker signalled completion
+  TSharedMemFile g("/shared-result");
+  TH1 *h = (TH1*)g.Get("hist");
+  TSharedMemFile::Unlink("/shared-result");
+~~~
+Shared memory segments are only available on POSIX systems; on Windows
+the constructor makes the object a zombie.
+*/
+
+#include "TSharedMemFile.h"
+#include "TError.h"
+#include "TSystem.h"
+#include "TROOT.h"
+#include <errno.h>
+#include <string.h>
+
+#ifndef R__WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+ClassImp(TSharedMemFile)
+
+Long64_t TSharedMemFile::fgDefaultSegmentSize = 256*1024*1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Usual Constructor. shmname is the name of the shared memory segment
+/// (leading '/' added when missing); for the other arguments see the
+/// TFile constructor. segmentSize is the maximum size the file can grow
+/// to when creating a segment; 0 means the current default (see
+/// SetDefaultSegmentSize). When reading, the size of the existing
+/// segment is used.
+
+TSharedMemFile::TSharedMemFile(const char *shmname, Option_t *option,
+                               const char *ftitle, Int_t compress,
+                               Long64_t segmentSize) :
+   TFile(shmname, "WEB", ftitle, compress),
+   fMapAddr(0), fMapSize(segmentSize > 0 ? segmentSize : fgDefaultSegmentSize),
+   fSize(0), fSysOffset(0), fCreator(kFALSE)
+{
+   fShmName = shmname;
+   if (!fShmName.BeginsWith("/")) fShmName.Prepend("/");
+
+   fOption = option;
+   fOption.ToUpper();
+   if (fOption == "NEW")  fOption = "CREATE";
+   Bool_t create   = (fOption == "CREATE") ? kTRUE : kFALSE;
+   Bool_t recreate = (fOption == "RECREATE") ? kTRUE : kFALSE;
+   Bool_t update   = (fOption == "UPDATE") ? kTRUE : kFALSE;
+   Bool_t read     = (fOption == "READ") ? kTRUE : kFALSE;
+   if (!create && !recreate && !update && !read) {
+      read    = kTRUE;
+      fOption = "READ";
+   }
+
+#ifdef R__WIN32
+   Error("TSharedMemFile","POSIX shared memory is not available on this platform");
+   goto zombie;
+#else
+   if (create || update || recreate) {
+      fD = SysOpen(fShmName.Data(), O_RDWR | O_CREAT | (recreate ? O_TRUNC : 0), 0600);
+      if (fD == -1) {
+         SysError("TSharedMemFile", "segment %s can not be opened", fShmName.Data());
+         goto zombie;
+      }
+      fWritable = kTRUE;
+   } else {
+      fD = SysOpen(fShmName.Data(), O_RDONLY, 0600);
+      if (fD == -1) {
+         SysError("TSharedMemFile", "segment %s can not be opened for reading", fShmName.Data());
+         goto zombie;
+      }
+      fWritable = kFALSE;
+   }
+
+   Init(create || recreate);
+   return;
+#endif
+
+zombie:
+   // Error in opening file; make this a zombie
+   MakeZombie();
+   gDirectory = gROOT;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Close the file and release the mapping. The shared memory segment
+/// itself is kept, so that other processes can still open it; remove it
+/// with Unlink() when nobody needs it anymore.
+
+TSharedMemFile::~TSharedMemFile()
+{
+   // Need to call Close now, as it needs both our virtual table
+   // and the mapping
+   Close();
+#ifndef R__WIN32
+   if (fMapAddr) munmap(fMapAddr, fMapSize);
+#endif
+   fMapAddr = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the current size of the shared memory file (the highest
+/// offset written, not the size of the underlying segment).
+
+Long64_t TSharedMemFile::GetSize() const
+{
+   return fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static method returning the default maximum segment size.
+
+Long64_t TSharedMemFile::GetDefaultSegmentSize()
+{
+   return fgDefaultSegmentSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static method to set the default maximum segment size used when
+/// creating segments without an explicit size.
+
+void TSharedMemFile::SetDefaultSegmentSize(Long64_t size)
+{
+   if (size > 0) fgDefaultSegmentSize = size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static method removing the name of a shared memory segment; the
+/// segment itself disappears once the last process unmaps it.
+/// Returns 0 on success, -1 on failure (as per shm_unlink).
+
+Int_t TSharedMemFile::Unlink(const char *shmname)
+{
+#ifndef R__WIN32
+   TString sname = shmname;
+   if (!sname.BeginsWith("/")) sname.Prepend("/");
+   return shm_unlink(sname.Data());
+#else
+   return -1;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open the shared memory segment and map it. See TFile::SysOpen().
+
+Int_t TSharedMemFile::SysOpen(const char *pathname, Int_t flags, UInt_t mode)
+{
+#ifndef R__WIN32
+   Int_t fd = shm_open(pathname, flags, (mode_t) mode);
+   if (fd == -1) return -1;
+
+   if (flags & O_CREAT) {
+      // creating (or recreating) the segment: reserve the maximum size
+      fCreator = kTRUE;
+      if (ftruncate(fd, fMapSize) == -1) {
+         close(fd);
+         return -1;
+      }
+      fSize = 0;
+   } else {
+      // opening an existing segment: its size is the maximum file size
+      struct stat st;
+      if (fstat(fd, &st) == -1 || st.st_size == 0) {
+         close(fd);
+         return -1;
+      }
+      fMapSize = st.st_size;
+      fSize = fMapSize;
+   }
+
+   Int_t prot = PROT_READ;
+   if ((flags & O_RDWR) || (flags & O_WRONLY)) prot |= PROT_WRITE;
+   void *addr = mmap(0, fMapSize, prot, MAP_SHARED, fd, 0);
+   // the mapping keeps its own reference to the segment
+   close(fd);
+   if (addr == MAP_FAILED) return -1;
+   fMapAddr = (UChar_t*)addr;
+   return 0;
+#else
+   (void) pathname; (void) flags; (void) mode;
+   return -1;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Close the shared memory file; the mapping is released in the
+/// destructor since Close() may still trigger reads.
+
+Int_t TSharedMemFile::SysClose(Int_t /* fd */)
+{
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read specified number of bytes from the current offset.
+/// See documentation for TFile::SysRead().
+
+Int_t TSharedMemFile::SysRead(Int_t, void *buf, Int_t len)
+{
+   if (!fMapAddr) {
+      errno = EBADF;
+      gSystem->SetErrorStr("The shared memory file is not open.");
+      return 0;
+   }
+   if (fSysOffset + len > fMapSize) {
+      len = fMapSize - fSysOffset;
+      if (len < 0) len = 0;
+   }
+   memcpy(buf, fMapAddr + fSysOffset, len);
+   fSysOffset += len;
+   return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write a buffer into the file at the current offset.
+/// See documentation for TFile::SysWrite().
+
+Int_t TSharedMemFile::SysWrite(Int_t, const void *buf, Int_t len)
+{
+   if (!fMapAddr) {
+      errno = EBADF;
+      gSystem->SetErrorStr("The shared memory file is not open.");
+      return 0;
+   }
+   if (fSysOffset + len > fMapSize) {
+      SysError("TSharedMemFile",
+               "segment %s is full (%lld bytes); increase the segment size",
+               fShmName.Data(), fMapSize);
+      return -1;
+   }
+   memcpy(fMapAddr + fSysOffset, buf, len);
+   fSysOffset += len;
+   if (fSysOffset > fSize) fSize = fSysOffset;
+   return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Seek to a specified position in the file.  See TFile::SysSeek().
+
+Long64_t TSharedMemFile::SysSeek(Int_t, Long64_t offset, Int_t whence)
+{
+   if (whence == SEEK_SET) {
+      fSysOffset = offset;
+   } else if (whence == SEEK_CUR) {
+      fSysOffset += offset;
+   } else if (whence == SEEK_END) {
+      if (offset > 0) {
+         SysError("TSharedMemFile", "Unable to seek past end of file");
+         return -1;
+      }
+      fSysOffset = fSize + offset;
+   } else {
+      SysError("TSharedMemFile", "Unknown whence!");
+      return -1;
+   }
+   if (fSysOffset < 0) {
+      SysError("TSharedMemFile", "Unable to seek past the beginning of file");
+      fSysOffset = 0;
+      return -1;
+   }
+   return fSysOffset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Perform a stat on the shared memory file; see TFile::SysStat().
+
+Int_t TSharedMemFile::SysStat(Int_t, Long_t* /* id */, Long64_t* /* size */, Long_t* /* flags */, Long_t* /* modtime */)
+{
+   MayNotUse("SysStat");
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sync the written range to the segment, making it visible to readers.
+
+Int_t TSharedMemFile::SysSync(Int_t)
+{
+#ifndef R__WIN32
+   if (fMapAddr && fSize > 0) msync(fMapAddr, fSize, MS_ASYNC);
+#endif
+   return 0;
+}
@@ -4418,6 +4418,14 @@ void TStreamerInfo::InsertArtificialElements(std::vector<const ROOT::TSchemaRule
 
       if (!rule) continue;
 
+      if ( rule->GetReadFunctionPointer() == 0 && rule->GetReadRawFunctionPointer() == 0 &&
+           rule->GetCode() && rule->GetCode()[0] ) {
+         // Rule registered at run time with only a code snippet: compile it
+         // with the interpreter's JIT so it runs as a native function inside
+         // the action sequence, like the dictionary provided rules.
+         const_cast<ROOT::TSchemaRule*>(rule)->CompileReadFunction();
+      }
+
       TStreamerArtificial *newel;
       typedef std::vector<TStreamerArtificial*> vec_t;
       vec_t toAdd;
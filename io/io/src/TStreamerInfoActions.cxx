@@ -24,6 +24,9 @@
 #include "TVirtualCollectionIterators.h"
 #include "TProcessID.h"
 
+#include <map>
+#include <mutex>
+
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
 // More possible optimizations:
@@ -2887,6 +2890,65 @@ void TStreamerInfo::AddWriteMemberWiseVecPtrAction(TStreamerInfoActions::TAction
 
 }
 
+namespace {
+   // Process-wide cache of member-wise action sequences. Rebuilding a
+   // sequence re-runs the per-element action selection below; for files with
+   // wide event models this used to be paid again by every branch being set
+   // up. The key is the class, its on-file layout (checksum) and the
+   // collection class; only sequences with a proxy-independent loop
+   // configuration are cached, since a TGenericLoopConfig embeds the proxy
+   // instance and has to be rebuilt for each caller. The cached masters
+   // reference the TStreamerInfo they were built from, which stays registered
+   // with its TClass for the lifetime of the process.
+   struct TSequenceCacheKey {
+      TClass *fClass;
+      UInt_t  fCheckSum;
+      TClass *fCollectionClass;
+      Bool_t  fForReading;
+
+      bool operator<(const TSequenceCacheKey &rhs) const {
+         if (fClass != rhs.fClass) return fClass < rhs.fClass;
+         if (fCheckSum != rhs.fCheckSum) return fCheckSum < rhs.fCheckSum;
+         if (fCollectionClass != rhs.fCollectionClass) return fCollectionClass < rhs.fCollectionClass;
+         return fForReading < rhs.fForReading;
+      }
+   };
+   std::map<TSequenceCacheKey, TStreamerInfoActions::TActionSequence*> gSequenceCache;
+   std::mutex gSequenceCacheMutex;
+
+   // True if the sequence built for this proxy can be shared across proxy
+   // instances (see the comment on the cache above).
+   Bool_t IsShareableSequence(TVirtualCollectionProxy &proxy)
+   {
+      Int_t collType = proxy.GetCollectionType();
+      if ( (collType == ROOT::kSTLvector) || (proxy.GetProperties() & TVirtualCollectionProxy::kIsEmulated) )
+         return !proxy.HasPointers();
+      return collType == ROOT::kSTLset || collType == ROOT::kSTLunorderedset
+          || collType == ROOT::kSTLmultiset || collType == ROOT::kSTLunorderedmultiset
+          || collType == ROOT::kSTLmap || collType == ROOT::kSTLmultimap
+          || collType == ROOT::kSTLunorderedmap || collType == ROOT::kSTLunorderedmultimap;
+   }
+
+   TStreamerInfoActions::TActionSequence *LookupSequenceCache(const TSequenceCacheKey &key)
+   {
+      std::lock_guard<std::mutex> guard(gSequenceCacheMutex);
+      auto iter = gSequenceCache.find(key);
+      return (iter != gSequenceCache.end()) ? iter->second : 0;
+   }
+
+   void StoreSequenceCache(const TSequenceCacheKey &key, TStreamerInfoActions::TActionSequence *master)
+   {
+      std::lock_guard<std::mutex> guard(gSequenceCacheMutex);
+      TStreamerInfoActions::TActionSequence *&slot = gSequenceCache[key];
+      if (slot) {
+         // Lost the race against another thread; keep the first master.
+         delete master;
+      } else {
+         slot = master;
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create the bundle of the actions necessary for the streaming memberwise of the content described by 'info' into the collection described by 'proxy'
 
@@ -2898,6 +2960,13 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
 
    TStreamerInfo *sinfo = static_cast<TStreamerInfo*>(info);
 
+   const Bool_t shareable = IsShareableSequence(proxy);
+   TSequenceCacheKey cacheKey = { info->GetClass(), info->GetCheckSum(), proxy.GetCollectionClass(), kTRUE };
+   if (shareable) {
+      if (TStreamerInfoActions::TActionSequence *cached = LookupSequenceCache(cacheKey))
+         return cached->CreateCopy();
+   }
+
    UInt_t ndata = info->GetElements()->GetEntries();
    TStreamerInfoActions::TActionSequence *sequence = new TStreamerInfoActions::TActionSequence(info,ndata);
    if ( (proxy.GetCollectionType() == ROOT::kSTLvector) || (proxy.GetProperties() & TVirtualCollectionProxy::kIsEmulated) )
@@ -3000,6 +3069,9 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
          break;
       }
    }
+   if (shareable) {
+      StoreSequenceCache(cacheKey, sequence->CreateCopy());
+   }
    return sequence;
 }
 
@@ -3014,6 +3086,14 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
 
       UInt_t ndata = info->GetElements()->GetEntries();
       TStreamerInfo *sinfo = static_cast<TStreamerInfo*>(info);
+
+      const Bool_t shareable = IsShareableSequence(proxy);
+      TSequenceCacheKey cacheKey = { info->GetClass(), info->GetCheckSum(), proxy.GetCollectionClass(), kFALSE };
+      if (shareable) {
+         if (TStreamerInfoActions::TActionSequence *cached = LookupSequenceCache(cacheKey))
+            return cached->CreateCopy();
+      }
+
       TStreamerInfoActions::TActionSequence *sequence = new TStreamerInfoActions::TActionSequence(info,ndata);
 
       if ( (proxy.GetCollectionType() == ROOT::kSTLvector) || (proxy.GetProperties() & TVirtualCollectionProxy::kIsEmulated) )
@@ -3166,6 +3246,9 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
          }
 #endif
       }
+      if (shareable) {
+         StoreSequenceCache(cacheKey, sequence->CreateCopy());
+      }
       return sequence;
 }
 void TStreamerInfoActions::TActionSequence::AddToOffset(Int_t delta)
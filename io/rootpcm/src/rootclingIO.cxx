@@ -20,6 +20,8 @@
 #include "TROOT.h"
 #include "TStreamerInfo.h"
 #include "TClassEdit.h"
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
 std::string gPCMFilename;
@@ -247,7 +249,16 @@ bool CloseStreamerInfoROOTFile(bool writeEmptyRootPCM)
    if (dictFile.IsZombie())
       return false;
 // Instead of plugins:
-   protoClasses.Write("__ProtoClasses", TObject::kSingleKey);
+   const char *splitPCM = getenv("ROOTCLING_SPLIT_PCM");
+   if (splitPCM && splitPCM[0] && strcmp(splitPCM, "0") != 0) {
+      // One key per protoclass: readers register lazy shells and only
+      // deserialize the payloads of the classes actually used.
+      TDirectory *splitDir = dictFile.mkdir("__ProtoClassesSplit");
+      for (auto protoObj : protoClasses)
+         splitDir->WriteTObject(protoObj, protoObj->GetName());
+   } else {
+      protoClasses.Write("__ProtoClasses", TObject::kSingleKey);
+   }
    protoClasses.Delete();
    typedefs.Write("__Typedefs", TObject::kSingleKey);
    enums.Write("__Enums", TObject::kSingleKey);
@@ -35,7 +35,7 @@ protected:
    void              UnpackSpecialCharacters(char* target, const char* source, int srclen);
    void              OutputValue(char* value, TXMLOutputStream* out);
    void              SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream* out, Int_t layout, Int_t level);
-   XMLNodePointer_t  ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream* inp, Int_t& resvalue);
+   XMLNodePointer_t  ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream* inp, Int_t& resvalue, Bool_t readchilds = kTRUE);
    void              DisplayError(Int_t error, Int_t linenumber);
    XMLDocPointer_t   ParseStream(TXMLInputStream* input);
 
@@ -115,6 +115,8 @@ public:
    Bool_t            ValidateDocument(XMLDocPointer_t, Bool_t = kFALSE) { return kFALSE; } // obsolete
    void              SaveSingleNode(XMLNodePointer_t xmlnode, TString* res, Int_t layout = 1);
    XMLNodePointer_t  ReadSingleNode(const char* src);
+   XMLDocPointer_t   BeginStreamParse(const char* filename, Int_t maxbuf = 100000);
+   XMLNodePointer_t  StreamParseNext(XMLDocPointer_t xmldoc);
 
    ClassDef(TXMLEngine,1);   // ROOT XML I/O parser, user by TXMLFile to read/write xml files
 };
@@ -62,6 +62,11 @@ struct SXmlDoc_t {
    SXmlNode_t  *fRootNode;
    char        *fDtdName;
    char        *fDtdRoot;
+   // following members are used only in streaming (pull) parse mode,
+   // created by TXMLEngine::BeginStreamParse
+   TXMLInputStream *fInpStream;  // input stream, owned by the document
+   SXmlNode_t      *fStreamElem; // top element, which children are pulled one by one
+   Bool_t           fStreamDone; // true when closing tag of top element was read
 };
 
 class TXMLOutputStream {
@@ -1109,6 +1114,9 @@ XMLDocPointer_t TXMLEngine::NewDoc(const char* version)
 
    doc->fDtdName = 0;
    doc->fDtdRoot = 0;
+   doc->fInpStream = 0;
+   doc->fStreamElem = 0;
+   doc->fStreamDone = kFALSE;
    return (XMLDocPointer_t) doc;
 }
 
@@ -1135,6 +1143,7 @@ void TXMLEngine::FreeDoc(XMLDocPointer_t xmldoc)
    FreeNode((XMLNodePointer_t) doc->fRootNode);
    delete[] doc->fDtdName;
    delete[] doc->fDtdRoot;
+   delete doc->fInpStream;
    delete doc;
 }
 
@@ -1305,6 +1314,100 @@ XMLNodePointer_t TXMLEngine::ReadSingleNode(const char* src)
    return xmlnode;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Opens file for streaming (pull mode) parsing.
+/// Unlike ParseFile, which builds nodes structure for the complete file,
+/// here only document prologue and open tag of the top element are read.
+/// Each call of StreamParseNext then delivers next direct child of the
+/// top element, while only window of the file (maxbuf bytes at least)
+/// is kept in memory. Therefore arbitrary big documents can be processed
+/// with the memory of their biggest child element.
+/// Top element itself (with its attributes) can be accessed via
+/// DocGetRootElement. Document should be released with FreeDoc,
+/// which also closes the file.
+
+XMLDocPointer_t TXMLEngine::BeginStreamParse(const char* filename, Int_t maxbuf)
+{
+   if ((filename==0) || (strlen(filename)==0)) return 0;
+   if (maxbuf < 100000) maxbuf = 100000;
+
+   TXMLInputStream* inp = new TXMLInputStream(true, filename, maxbuf);
+
+   SXmlDoc_t* doc = (SXmlDoc_t*) NewDoc(0);
+
+   Int_t resvalue = 0;
+
+   do {
+      XMLNodePointer_t node = ReadNode((XMLNodePointer_t) doc->fRootNode, inp, resvalue, kFALSE);
+
+      if (resvalue==3) {
+         // open tag of top element was read, streaming can begin
+         doc->fStreamElem = (SXmlNode_t*) node;
+         doc->fInpStream = inp;
+         return (XMLDocPointer_t) doc;
+      }
+
+      if (resvalue!=2) break;
+
+      if ((node!=0) && (((SXmlNode_t*)node)->fType==kXML_NODE)) {
+         // top element was short node like <node/>, nothing to stream
+         doc->fStreamElem = (SXmlNode_t*) node;
+         doc->fStreamDone = kTRUE;
+         delete inp;
+         return (XMLDocPointer_t) doc;
+      }
+
+      // xml declaration, comment or dtd in document prologue, continue
+
+   } while (!inp->EndOfStream());
+
+   DisplayError(resvalue, inp->CurrentLine());
+   delete inp;
+   FreeDoc((XMLDocPointer_t) doc);
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delivers next direct child of the top element of document, opened with
+/// BeginStreamParse. Child is read completely (including all its children)
+/// and unlinked from the document, so caller can analyze it with normal
+/// access methods and must release it with FreeNode - before or after
+/// pulling the next child. Content and (when not skipped) comment nodes
+/// in between of elements are delivered as well.
+/// Returns 0 when closing tag of the top element is reached or in case
+/// of parse error, which is reported like in ParseFile.
+
+XMLNodePointer_t TXMLEngine::StreamParseNext(XMLDocPointer_t xmldoc)
+{
+   if (xmldoc==0) return 0;
+   SXmlDoc_t* doc = (SXmlDoc_t*) xmldoc;
+   if ((doc->fInpStream==0) || doc->fStreamDone) return 0;
+
+   Int_t resvalue = 0;
+
+   do {
+      XMLNodePointer_t node = ReadNode((XMLNodePointer_t) doc->fStreamElem, doc->fInpStream, resvalue);
+
+      if (resvalue==2) {
+         if (node==0) continue; // skipped comment
+         UnlinkNode(node);
+         return node;
+      }
+
+      if (resvalue==1) {
+         // closing tag of top element
+         doc->fStreamDone = kTRUE;
+         return 0;
+      }
+
+      break;
+   } while (true);
+
+   DisplayError(resvalue, doc->fInpStream->CurrentLine());
+   doc->fStreamDone = kTRUE;
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// creates char* variable with copy of provided string
 
@@ -1563,8 +1666,12 @@ void TXMLEngine::SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream* out, Int_t
 /// resvalue <= 0 if error
 /// resvalue == 1 if this is endnode of parent
 /// resvalue == 2 if this is child
+/// When readchilds is false, reading stops right after the open tag of an
+/// element node - attributes are analyzed, but children are left in the
+/// stream. In that case resvalue == 3 and the caller should pull the
+/// children itself (used in streaming parse mode).
 
-XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream* inp, Int_t& resvalue)
+XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream* inp, Int_t& resvalue, Bool_t readchilds)
 {
    resvalue = 0;
 
@@ -1840,6 +1947,12 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
 
          if (!inp->ShiftCurrent()) return 0;
 
+         if (!readchilds) {
+            // streaming parse mode - open tag is read, children stay in the stream
+            resvalue = 3;
+            return node;
+         }
+
          do {
             ReadNode(node, inp, resvalue);
          } while (resvalue==2);
@@ -199,7 +199,7 @@ $(ROOTSSH):     $(call stripsrc,$(MAINDIRS)/roots.sh)
 
 $(HADD):        $(HADDO) $(ROOTLIBSDEP)
 		$(LD) $(LDFLAGS) -o $@ $(HADDO) $(ROOTULIBS) \
-		   $(RPATH) $(ROOTLIBS) $(SYSLIBS)
+		   $(RPATH) $(ROOTLIBS) -lMultiProc $(SYSLIBS)
 
 $(SSH2RPD):     $(SSH2RPDO) $(SNPRINTFO) $(STRLCPYO)
 		$(LD) $(LDFLAGS) -o $@ $(SSH2RPDO) $(SNPRINTFO) $(STRLCPYO) \
@@ -51,6 +51,19 @@
   If the option -cachedsize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
+  With the option -watch, hadd runs as a daemon watching a directory:
+
+       hadd -watch incomingdir targetfile
+
+  Every ROOT file appearing in the directory is merged into the target as it
+  arrives, using the incremental merge of TFileMerger::PartialMerge (trees
+  appended to the output trees, histograms added), so the cost of each pass is
+  proportional to the new data only. The names of the merged files are
+  checkpointed in <targetfile>.haddstate: a restarted daemon skips them and
+  continues where it stopped. On Linux the directory is watched with inotify;
+  elsewhere it is polled (see -watchinterval) and a file is merged once its
+  size is stable between two scans.
+
   For options that takes a size as argument, a decimal number of bytes is expected.
   If the number ends with a ``k'', ``m'', ``g'', etc., the number is multiplied
   by 1000 (1K), 1000000 (1MB), 1000000000 (1G), etc.
@@ -82,8 +95,223 @@
 #include "ROOT/StringConv.hxx"
 #include <stdlib.h>
 #include <climits>
+#include <csignal>
+#include <fstream>
+#include <map>
+#include <set>
+#include <vector>
 
 #include "TFileMerger.h"
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+#ifdef R__LINUX
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+static volatile std::sig_atomic_t gWatchStop = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Termination request for the watch loop: finish the batch in progress,
+/// record it in the state file and exit cleanly.
+
+static void WatchSignalHandler(int)
+{
+   gWatchStop = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the checkpoint file of a previous watch run: one already-merged
+/// source file per line. A missing file simply means a fresh start.
+
+static std::set<std::string> LoadWatchState(const char *statefile)
+{
+   std::set<std::string> merged;
+   std::ifstream state(statefile);
+   std::string line;
+   while (state && std::getline(state, line)) {
+      if (line.length()) merged.insert(line);
+   }
+   return merged;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the files of a completed batch to the checkpoint, flushing so a
+/// crash right after the merge does not re-merge them on restart.
+
+static void AppendWatchState(const char *statefile, const std::vector<std::string> &batch)
+{
+   std::ofstream state(statefile, std::ios::app);
+   for (std::vector<std::string>::const_iterator it = batch.begin(); it != batch.end(); ++it) {
+      state << *it << '\n';
+   }
+   state.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Watch a directory and merge every ROOT file that appears in it into the
+/// accumulating target, using TFileMerger::PartialMerge in the incremental
+/// mode the -a option uses: trees are appended to the existing output tree
+/// and histograms are added, so each pass costs the size of the new files
+/// only instead of a full re-merge of everything seen so far. On Linux the
+/// wait between passes is an inotify watch on close-after-write and
+/// move-into-the-directory events; elsewhere (or if inotify fails) the
+/// directory is polled and a file is taken only after its size has been
+/// stable over two scans. Merged files are checkpointed in statefile so a
+/// restarted daemon continues where it stopped.
+
+static int RunWatchMode(const char *watchdir, const char *targetname, const char *statefile,
+                        Int_t newcomp, Bool_t noTrees, Bool_t reoptimize, Bool_t skip_errors,
+                        Int_t maxopenedfiles, const TString &cacheSize, Int_t verbosity,
+                        Int_t intervalSec)
+{
+   std::set<std::string> merged = LoadWatchState(statefile);
+   if (verbosity > 1 && !merged.empty()) {
+      std::cout << "hadd watch state " << statefile << ": " << merged.size()
+                << " files already merged, skipping them" << std::endl;
+   }
+
+   std::signal(SIGINT, WatchSignalHandler);
+#ifndef R__WIN32
+   std::signal(SIGTERM, WatchSignalHandler);
+#endif
+
+#ifdef R__LINUX
+   int inotifyFd = inotify_init();
+   if (inotifyFd >= 0) {
+      if (inotify_add_watch(inotifyFd, watchdir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+         close(inotifyFd);
+         inotifyFd = -1;
+      }
+   }
+   if (inotifyFd < 0 && verbosity > 1) {
+      std::cout << "hadd inotify not available on " << watchdir << ", polling instead" << std::endl;
+   }
+#endif
+
+   // size seen at the previous scan; a file is stable once its size repeats
+   std::map<std::string, Long64_t> pending;
+   // files announced complete by inotify, mergeable without the stability wait
+   std::set<std::string> closed;
+
+   while (true) {
+      // scan the directory for new ROOT files
+      std::vector<std::string> batch;
+      void *dirp = gSystem->OpenDirectory(watchdir);
+      if (!dirp) {
+         std::cerr << "hadd cannot open watched directory " << watchdir << std::endl;
+         return 1;
+      }
+      const char *entry = 0;
+      while ((entry = gSystem->GetDirEntry(dirp))) {
+         if (entry[0] == '.') continue;
+         size_t len = strlen(entry);
+         if (len < 5 || strcmp(entry + len - 5, ".root") != 0) continue;
+         std::string path = std::string(watchdir) + "/" + entry;
+         if (path == targetname || path == statefile) continue;
+         if (merged.find(path) != merged.end()) continue;
+         Long64_t size = 0;
+         Long_t id, flags, modtime;
+         if (gSystem->GetPathInfo(path.c_str(), &id, &size, &flags, &modtime) != 0) continue;
+         if (closed.find(entry) != closed.end()) {
+            batch.push_back(path);
+            continue;
+         }
+         std::map<std::string, Long64_t>::iterator seen = pending.find(path);
+         if (seen != pending.end() && seen->second == size) {
+            batch.push_back(path);      // size stable since the last scan
+         } else {
+            pending[path] = size;       // first sight or still growing
+         }
+      }
+      gSystem->FreeDirectory(dirp);
+
+      if (!batch.empty()) {
+         // one incremental pass, exactly as `hadd -a target batch...`
+         TFileMerger merger(kFALSE, kFALSE);
+         merger.SetMsgPrefix("hadd");
+         merger.SetPrintLevel(verbosity - 1);
+         if (maxopenedfiles > 0) {
+            merger.SetMaxOpenedFiles(maxopenedfiles);
+         }
+         if (!merger.OutputFile(targetname, "UPDATE", newcomp)) {
+            std::cerr << "hadd error opening target file for update :" << targetname << "." << std::endl;
+            return 2;
+         }
+         std::vector<std::string> added;
+         for (std::vector<std::string>::const_iterator it = batch.begin(); it != batch.end(); ++it) {
+            if (merger.AddFile(it->c_str())) {
+               added.push_back(*it);
+            } else if (skip_errors) {
+               std::cerr << "hadd skipping file with error: " << *it << std::endl;
+               added.push_back(*it);    // checkpoint it, do not retry forever
+            } else {
+               std::cerr << "hadd exiting due to error in " << *it << std::endl;
+               return 1;
+            }
+         }
+         if (reoptimize) {
+            merger.SetFastMethod(kFALSE);
+         }
+         merger.SetNotrees(noTrees);
+         merger.SetMergeOptions(cacheSize);
+         if (!merger.PartialMerge(TFileMerger::kIncremental | TFileMerger::kAll)) {
+            std::cerr << "hadd failure during the incremental merge in " << targetname << "." << std::endl;
+            return 1;
+         }
+         AppendWatchState(statefile, added);
+         for (std::vector<std::string>::const_iterator it = added.begin(); it != added.end(); ++it) {
+            merged.insert(*it);
+            pending.erase(*it);
+            closed.erase(std::string(gSystem->BaseName(it->c_str())));
+         }
+         if (verbosity > 1) {
+            std::cout << "hadd merged " << added.size() << " new files in " << targetname
+                      << " (" << merged.size() << " in total)" << std::endl;
+         }
+      }
+
+      if (gWatchStop) break;
+
+      // wait for the next arrival
+#ifdef R__LINUX
+      if (inotifyFd >= 0) {
+         struct pollfd pfd;
+         pfd.fd = inotifyFd;
+         pfd.events = POLLIN;
+         int ready = poll(&pfd, 1, intervalSec * 1000);
+         if (ready > 0) {
+            alignas(struct inotify_event) char buf[4096];
+            ssize_t nread = read(inotifyFd, buf, sizeof(buf));
+            ssize_t pos = 0;
+            while (nread > 0 && pos + (ssize_t)sizeof(struct inotify_event) <= nread) {
+               struct inotify_event *event = (struct inotify_event *)(buf + pos);
+               if (event->len > 0) {
+                  closed.insert(std::string(event->name));
+               }
+               pos += sizeof(struct inotify_event) + event->len;
+            }
+         }
+      } else {
+         gSystem->Sleep(intervalSec * 1000);
+      }
+#else
+      gSystem->Sleep(intervalSec * 1000);
+#endif
+      if (gWatchStop) break;
+   }
+
+#ifdef R__LINUX
+   if (inotifyFd >= 0) close(inotifyFd);
+#endif
+   if (verbosity > 1) {
+      std::cout << "hadd watch mode stopping, " << merged.size() << " files merged in "
+                << targetname << "." << std::endl;
+   }
+   return 0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -91,7 +319,7 @@ int main( int argc, char **argv )
 {
    if ( argc < 3 || "-h" == std::string(argv[1]) || "--help" == std::string(argv[1]) ) {
       std::cout << "Usage: " << argv[0] << " [-f[fk][0-9]] [-k] [-T] [-O] [-a] \n"
-      "            [-n maxopenedfiles] [-cachesize size] [-v [verbosity]] \n"
+      "            [-n maxopenedfiles] [-cachesize size] [-j [ncpus]] [-v [verbosity]] \n"
       "            targetfile source1 [source2 source3 ...]\n" << std::endl;
       std::cout << "This program will add histograms from a list of root files and write them" << std::endl;
       std::cout << "   to a target root file. The target file is newly created and must not" << std::endl;
@@ -106,8 +334,25 @@ int main( int argc, char **argv )
                    "   0 request no output, 99 is the default" <<std::endl;
       std::cout << "If the option -n is used, hadd will open at most 'maxopenedfiles' at once, use 0\n"
                    "   to request to use the system maximum." << std::endl;
+      std::cout << "If the option -j is used, hadd will parallelize the merge in 'ncpus' processes,\n"
+                   "   each merging a subset of the input files into an intermediate file; the\n"
+                   "   intermediate files are then merged into the target. If 'ncpus' is not given,\n"
+                   "   the number of cpus of the machine is used." << std::endl;
       std::cout << "If the option -cachedsize is used, hadd will resize (or disable if 0) the\n"
                    "   prefetching cache use to speed up I/O operations." << std::endl;
+      std::cout << "If the option -watch is used, hadd runs as a daemon: it watches the given\n"
+                   "   directory and merges every ROOT file appearing in it incrementally into the\n"
+                   "   target (trees are appended, histograms added), instead of re-merging\n"
+                   "   everything in periodic full passes. Already merged files are checkpointed in\n"
+                   "   <targetfile>.haddstate so a restarted daemon does not merge them again; the\n"
+                   "   daemon stops on SIGINT/SIGTERM after completing the batch in progress.\n"
+                   "   -watchinterval sets the fallback poll interval in seconds (default 5);\n"
+                   "   on Linux arrivals are picked up through inotify as soon as the producer\n"
+                   "   closes the file." << std::endl;
+      std::cout << "If the option -memlimit is used, hadd will keep its memory use below the given\n"
+                   "   budget by limiting the number of simultaneously opened source files and\n"
+                   "   merging them in incremental batches, flushing the completed objects to the\n"
+                   "   target between batches. An explicit -n overrides the derived limit." << std::endl;
       std::cout << "When -the -f option is specified, one can also specify the compression level of\n"
                    "   the target file.  By default the compression level is 1." <<std::endl;
       std::cout << "If \"-fk\" is specified, the target file contain the baskets with the same\n"
@@ -141,7 +386,13 @@ int main( int argc, char **argv )
    Bool_t useFirstInputCompression = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
+   Bool_t multiproc = kFALSE;
+   Int_t nProcesses = 0;
+   Long64_t memLimit = 0;
+   Long64_t cacheSizeBytes = 30000000; // the default TTreeCache size
    TString cacheSize;
+   TString watchDir;
+   Int_t watchInterval = 5;
 
    int outputPlace = 0;
    int ffirst = 2;
@@ -177,6 +428,7 @@ int main( int argc, char **argv )
                       << argv[a + 1] << " is greater than " << m << munit
                       << ". We will use the default value.\n";
          } else {
+            cacheSizeBytes = size;
             cacheSize = "cachesize=";
             cacheSize.Append(argv[a]+1);
          }
@@ -200,6 +452,7 @@ int main( int argc, char **argv )
                ++a;
                ++ffirst;
             } else {
+               cacheSizeBytes = size;
                cacheSize = "cachesize=";
                cacheSize.Append(argv[a+1]);
                ++a;
@@ -207,6 +460,44 @@ int main( int argc, char **argv )
             }
          }
          ++ffirst;
+      } else if ( strcmp(argv[a],"-watch") == 0 ) {
+         if (a+1 >= argc) {
+            std::cerr << "Error: no directory was provided after -watch.\n";
+         } else {
+            watchDir = argv[a+1];
+            ++a;
+            ++ffirst;
+         }
+         ++ffirst;
+      } else if ( strcmp(argv[a],"-watchinterval") == 0 ) {
+         if (a+1 >= argc) {
+            std::cerr << "Error: no number of seconds was provided after -watchinterval.\n";
+         } else {
+            Long_t request = strtol(argv[a+1], 0, 10);
+            if (request > 0 && request < kMaxInt) {
+               watchInterval = (Int_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the poll interval passed after -watchinterval: "
+                         << argv[a+1] << ". We will use the default (5 seconds).\n";
+            }
+         }
+         ++ffirst;
+      } else if ( strcmp(argv[a],"-memlimit") == 0 ) {
+         if (a+1 >= argc) {
+            std::cerr << "Error: no memory budget was provided after -memlimit.\n";
+         } else {
+            auto parseResult = ROOT::FromHumanReadableSize(argv[a+1],memLimit);
+            if (parseResult != ROOT::EFromHumanReadableSize::kSuccess) {
+               std::cerr << "Error: could not parse the memory budget passed after -memlimit: "
+                         << argv[a + 1] << ". The memory use will not be limited.\n";
+               memLimit = 0;
+            }
+            ++a;
+            ++ffirst;
+         }
+         ++ffirst;
       } else if ( strcmp(argv[a],"-n") == 0 ) {
          if (a+1 >= argc) {
             std::cerr << "Error: no maximum number of opened was provided after -n.\n";
@@ -221,6 +512,20 @@ int main( int argc, char **argv )
             }
          }
          ++ffirst;
+      } else if ( strcmp(argv[a],"-j") == 0 ) {
+         // The number of processes is optional; if not given use the number of cpus.
+         if (a+1 != argc && argv[a+1][0] != '-') {
+            Long_t request = strtol(argv[a+1], 0, 10);
+            if (request < kMaxLong && request > 0) {
+               nProcesses = (Int_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of processes to use passed after -j: " << argv[a+1] << ". We will use the number of cpus.\n";
+            }
+         }
+         multiproc = kTRUE;
+         ++ffirst;
       } else if ( strcmp(argv[a],"-v") == 0 ) {
          if (a+1 == argc || argv[a+1][0] == '-') {
             // Verbosity level was not specified use the default:
@@ -308,6 +613,38 @@ int main( int argc, char **argv )
       std::cout << "hadd Target file: " << targetname << std::endl;
    }
 
+   if (memLimit > 0 && maxopenedfiles <= 0) {
+      // Translate the memory budget into the number of simultaneously
+      // opened source files: each open source costs roughly its read cache
+      // plus streaming overhead; half the budget is kept for the merger's
+      // own working set (the object being merged, the output tree's
+      // baskets). The merge then proceeds in incremental batches of that
+      // many files, flushing the completed objects to the target between
+      // batches (see TFileMerger::PartialMerge).
+      Long64_t perFile = cacheSizeBytes + 10000000;
+      Long64_t nfiles = (memLimit/2) / perFile;
+      if (nfiles < 2) nfiles = 2;
+      if (nfiles < kMaxInt) {
+         maxopenedfiles = (Int_t)nfiles + 1; // +1 for the output file
+         if (verbosity > 1) {
+            std::cout << "hadd memory budget limits the merge to " << maxopenedfiles
+                      << " simultaneously opened files" << std::endl;
+         }
+      }
+   }
+
+   if (watchDir.Length()) {
+      // daemon mode: the command line names the directory and the target
+      // only; arrivals are merged incrementally as they appear. The
+      // compression of the accumulating file is fixed at its creation, so
+      // the -ff/-fk variants do not apply here.
+      if (newcomp == -1) newcomp = 1; // default compression level.
+      TString statefile = TString::Format("%s.haddstate", targetname);
+      return RunWatchMode(watchDir.Data(), targetname, statefile.Data(), newcomp, noTrees,
+                          reoptimize, skip_errors, maxopenedfiles, cacheSize, verbosity,
+                          watchInterval);
+   }
+
    TFileMerger merger(kFALSE,kFALSE);
    merger.SetMsgPrefix("hadd");
    merger.SetPrintLevel(verbosity - 1);
@@ -359,6 +696,9 @@ int main( int argc, char **argv )
    }
 
 
+   // Resolve the command line (including indirect files) into the full list
+   // of inputs before deciding how to distribute them over the processes.
+   std::vector<std::string> allSubfiles;
    for ( int i = ffirst; i < argc; i++ ) {
       if (argv[i] && argv[i][0]=='@') {
          std::ifstream indirect_file(argv[i]+1);
@@ -368,15 +708,97 @@ int main( int argc, char **argv )
          }
          while( indirect_file ){
             std::string line;
-            if( std::getline(indirect_file, line) && line.length() &&  !merger.AddFile(line.c_str()) ) {
-               return 1;
+            if( std::getline(indirect_file, line) && line.length() ) {
+               allSubfiles.push_back(line);
+            }
+         }
+      } else {
+         allSubfiles.push_back(argv[i]);
+      }
+   }
+
+#ifdef R__WIN32
+   if (multiproc) {
+      std::cerr << "hadd the -j option is not supported on this platform, merging serially." << std::endl;
+      multiproc = kFALSE;
+   }
+#else
+   if (multiproc && nProcesses <= 0) {
+      SysInfo_t info;
+      gSystem->GetSysInfo(&info);
+      nProcesses = info.fCpus;
+   }
+   if (multiproc && nProcesses < 2) {
+      // Nothing to parallelize.
+      multiproc = kFALSE;
+   }
+   if (multiproc && (Int_t)allSubfiles.size() < 2*nProcesses) {
+      nProcesses = allSubfiles.size()/2;
+      if (nProcesses < 2) multiproc = kFALSE;
+   }
+
+   std::vector<std::string> partialFiles;
+   if (multiproc) {
+      if (verbosity > 1) {
+         std::cout << "hadd parallelizing the merge in " << nProcesses << " processes." << std::endl;
+      }
+      // Each process merges a contiguous slice of the inputs into an
+      // intermediate file; the intermediate files are then merged serially
+      // into the target. The read/decompress/merge/write work of the slices
+      // thus proceeds concurrently.
+      for (Int_t i = 0; i < nProcesses; i++) {
+         partialFiles.push_back(std::string(gSystem->TempDirectory()) + "/" +
+                                gSystem->BaseName(targetname) + ".partial" + std::to_string(i));
+      }
+      auto mergeSlice = [&](Int_t i) {
+         TFileMerger sliceMerger(kFALSE, kFALSE);
+         sliceMerger.SetMsgPrefix("hadd");
+         sliceMerger.SetPrintLevel(verbosity - 1);
+         if (maxopenedfiles > 0) {
+            sliceMerger.SetMaxOpenedFiles(maxopenedfiles/nProcesses);
+         }
+         if (!sliceMerger.OutputFile(partialFiles[i].c_str(), kTRUE, newcomp)) {
+            return 1;
+         }
+         const size_t first = (allSubfiles.size()*i)/nProcesses;
+         const size_t last = (allSubfiles.size()*(i+1))/nProcesses;
+         for (size_t f = first; f < last; f++) {
+            if (!sliceMerger.AddFile(allSubfiles[f].c_str())) {
+               if (skip_errors) {
+                  std::cerr << "hadd skipping file with error: " << allSubfiles[f] << std::endl;
+               } else {
+                  std::cerr << "hadd exiting due to error in " << allSubfiles[f] << std::endl;
+                  return 1;
+               }
             }
          }
-      } else if( ! merger.AddFile(argv[i]) ) {
+         if (reoptimize) {
+            sliceMerger.SetFastMethod(kFALSE);
+         }
+         sliceMerger.SetNotrees(noTrees);
+         sliceMerger.SetMergeOptions(cacheSize);
+         return sliceMerger.Merge() ? 0 : 1;
+      };
+      ROOT::TProcessExecutor executor(nProcesses);
+      auto sliceResults = executor.Map(mergeSlice, ROOT::TSeqI(nProcesses));
+      for (auto &res : sliceResults) {
+         if (res != 0) {
+            for (const auto &partial : partialFiles) gSystem->Unlink(partial.c_str());
+            std::cerr << "hadd failure during the parallel merge." << std::endl;
+            return 1;
+         }
+      }
+      // From here on merge the intermediate files only.
+      allSubfiles = partialFiles;
+   }
+#endif
+
+   for (const auto &subfile : allSubfiles) {
+      if( ! merger.AddFile(subfile.c_str()) ) {
          if ( skip_errors ) {
-            std::cerr << "hadd skipping file with error: " << argv[i] << std::endl;
+            std::cerr << "hadd skipping file with error: " << subfile << std::endl;
          } else {
-            std::cerr << "hadd exiting due to error in " << argv[i] << std::endl;
+            std::cerr << "hadd exiting due to error in " << subfile << std::endl;
             return 1;
          }
       }
@@ -396,6 +818,12 @@ int main( int argc, char **argv )
    if (append) status = merger.PartialMerge(TFileMerger::kIncremental | TFileMerger::kAll);
    else status = merger.Merge();
 
+#ifndef R__WIN32
+   for (const auto &partial : partialFiles) {
+      gSystem->Unlink(partial.c_str());
+   }
+#endif
+
    if (status) {
       if (verbosity == 1) {
          std::cout << "hadd merged " << merger.GetMergeList()->GetEntries() << " input files in " << targetname << ".\n";
@@ -56,6 +56,7 @@ class TFFTRealComplex: public TVirtualFFT {
    Int_t     fNdim;      //number of dimensions
    Int_t     fTotalSize; //total size of the transform
    Int_t    *fN;         //transform sizes in each dimension
+   Int_t     fNBatch;    //number of transforms computed at once by a batched plan
    Option_t *fFlags;     //transform flags
 
    UInt_t MapFlag(Option_t *flag);
@@ -67,6 +68,8 @@ class TFFTRealComplex: public TVirtualFFT {
    virtual ~TFFTRealComplex();
 
    virtual void       Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*/);
+   virtual void       InitBatch(Option_t *flags, Int_t nbatch);
+   Int_t              GetNBatch() const {return fNBatch;}
 
    virtual Int_t      GetSize() const {return fTotalSize;}
    virtual Int_t     *GetN()    const {return fN;}
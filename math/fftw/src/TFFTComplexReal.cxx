@@ -44,6 +44,24 @@
 #include "TFFTComplexReal.h"
 #include "fftw3.h"
 #include "TComplex.h"
+#ifdef R__FFTW_THREADS
+#include "TEnv.h"
+#endif
+
+namespace {
+   // use a multi-threaded plan when ROOT is built against fftw3_threads;
+   // the number of threads is configured in the rootrc (FFTW.Threads,
+   // default single threaded)
+   void R__PlanWithThreads()
+   {
+#ifdef R__FFTW_THREADS
+      static Bool_t initialized = fftw_init_threads();
+      Int_t nthreads = gEnv->GetValue("FFTW.Threads", 0);
+      if (initialized && nthreads > 1)
+         fftw_plan_with_nthreads(nthreads);
+#endif
+   }
+}
 
 
 ClassImp(TFFTComplexReal)
@@ -57,6 +75,7 @@ TFFTComplexReal::TFFTComplexReal()
    fOut  = 0;
    fPlan = 0;
    fN    = 0;
+   fNBatch = 1;
    fTotalSize = 0;
    fFlags = 0;
    fNdim = 0;
@@ -79,6 +98,7 @@ TFFTComplexReal::TFFTComplexReal(Int_t n, Bool_t inPlace)
    fNdim = 1;
    fN = new Int_t[1];
    fN[0] = n;
+   fNBatch = 1;
    fPlan = 0;
    fTotalSize = n;
    fFlags = 0;
@@ -105,6 +125,7 @@ TFFTComplexReal::TFFTComplexReal(Int_t ndim, Int_t *n, Bool_t inPlace)
       fIn = fftw_malloc(sizeof(fftw_complex)*sizein);
       fOut = 0;
    }
+   fNBatch = 1;
    fPlan = 0;
    fFlags = 0;
 }
@@ -148,18 +169,68 @@ TFFTComplexReal::~TFFTComplexReal()
 
 void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*/)
 {
+   if (fPlan && fNBatch==1 && fFlags && flags && !strcmp(flags, fFlags)) {
+      //a single-transform plan with the same flags already exists - reuse it
+      return;
+   }
    fFlags = flags;
+   fNBatch = 1;
 
    if (fPlan)
       fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
 
+   R__PlanWithThreads();
    if (fOut)
       fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN,(fftw_complex*)fIn,(Double_t*)fOut, MapFlag(flags));
    else
       fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN, (fftw_complex*)fIn, (Double_t*)fIn, MapFlag(flags));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Creates a batched fftw-plan computing nbatch transforms of the size given
+///at construction time in a single Transform() call. The input (half) spectra
+///are set one after the other, the real output of transform #i is returned at
+///indexes [i*GetSize(), (i+1)*GetSize()). The input and output arrays are
+///reallocated to hold the whole batch, so as for Init() no points may be set
+///before calling this function. Only out-of-place transforms are supported in
+///batch mode.
+
+void TFFTComplexReal::InitBatch(Option_t *flags, Int_t nbatch)
+{
+   if (nbatch < 1) {
+      Error("InitBatch", "illegal number of transforms %d", nbatch);
+      return;
+   }
+   if (!fOut) {
+      Error("InitBatch", "batched transforms are only supported out-of-place");
+      return;
+   }
+   if (fPlan && fNBatch==nbatch && fFlags && flags && !strcmp(flags, fFlags)) {
+      //a batched plan of the same shape and flags already exists - reuse it
+      return;
+   }
+   fFlags = flags;
+
+   if (fPlan)
+      fftw_destroy_plan((fftw_plan)fPlan);
+   fPlan = 0;
+
+   Int_t sizein = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1]);
+   if (nbatch != fNBatch) {
+      fftw_free((fftw_complex*)fIn);
+      fftw_free(fOut);
+      fIn  = fftw_malloc(sizeof(fftw_complex)*sizein*nbatch);
+      fOut = fftw_malloc(sizeof(Double_t)*fTotalSize*nbatch);
+      fNBatch = nbatch;
+   }
+   R__PlanWithThreads();
+   fPlan = (void*)fftw_plan_many_dft_c2r(fNdim, fN, fNBatch,
+                                         (fftw_complex*)fIn, 0, 1, sizein,
+                                         (Double_t*)fOut, 0, 1, fTotalSize,
+                                         MapFlag(flags));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Computes the transform, specified in Init() function
 
@@ -184,7 +255,7 @@ void TFFTComplexReal::GetPoints(Double_t *data, Bool_t fromInput) const
       return;
    }
    const Double_t * array =  (const Double_t*) ( (fOut) ?  fOut :  fIn );
-   std::copy(array,array+fTotalSize, data);
+   std::copy(array,array+fTotalSize*fNBatch, data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -281,7 +352,7 @@ void TFFTComplexReal::GetPointsComplex(Double_t *re, Double_t *im, Bool_t fromIn
       return;
    }
    const Double_t * array =  (const Double_t*) ( (fOut) ?  fOut :  fIn );
-   for (Int_t i=0; i<fTotalSize; i++){
+   for (Int_t i=0; i<fTotalSize*fNBatch; i++){
       re[i] = array[i];
       im[i] = 0;
    }
@@ -298,7 +369,7 @@ void TFFTComplexReal::GetPointsComplex(Double_t *data, Bool_t fromInput) const
       return;
    }
    const Double_t * array =  (const Double_t*) ( (fOut) ?  fOut :  fIn );
-   for (Int_t i=0; i<fTotalSize; i+=2){
+   for (Int_t i=0; i<fTotalSize*fNBatch; i+=2){
       data[i] = array[i/2];
       data[i+1]=0;
    }
@@ -361,7 +432,7 @@ void TFFTComplexReal::SetPointComplex(Int_t ipoint, TComplex &c)
 
 void TFFTComplexReal::SetPoints(const Double_t *data)
 {
-   Int_t sizein = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1]);
+   Int_t sizein = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1])*fNBatch;
 
    for (Int_t i=0; i<2*(sizein); i+=2){
       ((fftw_complex*)fIn)[i/2][0]=data[i];
@@ -374,7 +445,7 @@ void TFFTComplexReal::SetPoints(const Double_t *data)
 
 void TFFTComplexReal::SetPointsComplex(const Double_t *re, const Double_t *im)
 {
-   Int_t sizein = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1]);
+   Int_t sizein = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1])*fNBatch;
    for (Int_t i=0; i<sizein; i++){
       ((fftw_complex*)fIn)[i][0]=re[i];
       ((fftw_complex*)fIn)[i][1]=im[i];
@@ -44,6 +44,24 @@
 #include "TFFTRealComplex.h"
 #include "fftw3.h"
 #include "TComplex.h"
+#ifdef R__FFTW_THREADS
+#include "TEnv.h"
+#endif
+
+namespace {
+   // enable multi-threaded plan execution when ROOT is built against
+   // fftw3_threads; the number of threads is taken from the rootrc
+   // (FFTW.Threads, default single threaded)
+   void R__PlanWithThreads()
+   {
+#ifdef R__FFTW_THREADS
+      static Bool_t initialized = fftw_init_threads();
+      Int_t nthreads = gEnv->GetValue("FFTW.Threads", 0);
+      if (initialized && nthreads > 1)
+         fftw_plan_with_nthreads(nthreads);
+#endif
+   }
+}
 
 
 ClassImp(TFFTRealComplex)
@@ -57,6 +75,7 @@ TFFTRealComplex::TFFTRealComplex()
    fOut  = 0;
    fPlan = 0;
    fN    = 0;
+   fNBatch = 1;
    fFlags = 0;
    fNdim = 0;
    fTotalSize = 0;
@@ -80,6 +99,7 @@ TFFTRealComplex::TFFTRealComplex(Int_t n, Bool_t inPlace)
    fN[0] = n;
    fTotalSize = n;
    fNdim = 1;
+   fNBatch = 1;
    fPlan = 0;
    fFlags = 0;
 }
@@ -109,6 +129,7 @@ TFFTRealComplex::TFFTRealComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
       fIn = fftw_malloc(sizeof(Double_t)*(2*sizeout));
       fOut = 0;
    }
+   fNBatch = 1;
    fPlan = 0;
    fFlags = 0;
 }
@@ -151,18 +172,68 @@ TFFTRealComplex::~TFFTRealComplex()
 
 void TFFTRealComplex::Init(Option_t *flags,Int_t /*sign*/, const Int_t* /*kind*/)
 {
+   if (fPlan && fNBatch==1 && fFlags && flags && !strcmp(flags, fFlags)) {
+      //a single-transform plan with the same flags already exists - reuse it
+      return;
+   }
    fFlags = flags;
+   fNBatch = 1;
 
    if (fPlan)
       fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
 
+   R__PlanWithThreads();
    if (fOut)
       fPlan = (void*)fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, (fftw_complex*)fOut,MapFlag(flags));
    else
       fPlan = (void*)fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, (fftw_complex*)fIn, MapFlag(flags));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Creates a batched fftw-plan computing nbatch transforms of the size given
+///at construction time in a single Transform() call. The input points of
+///transform #i are set at indexes [i*GetSize(), (i+1)*GetSize()) and the
+///halves of the computed transforms are returned one after the other by
+///GetPointsComplex(). The input and output arrays are reallocated to hold the
+///whole batch, so as for Init() no points may be set before calling this
+///function. Only out-of-place transforms are supported in batch mode.
+
+void TFFTRealComplex::InitBatch(Option_t *flags, Int_t nbatch)
+{
+   if (nbatch < 1) {
+      Error("InitBatch", "illegal number of transforms %d", nbatch);
+      return;
+   }
+   if (!fOut) {
+      Error("InitBatch", "batched transforms are only supported out-of-place");
+      return;
+   }
+   if (fPlan && fNBatch==nbatch && fFlags && flags && !strcmp(flags, fFlags)) {
+      //a batched plan of the same shape and flags already exists - reuse it
+      return;
+   }
+   fFlags = flags;
+
+   if (fPlan)
+      fftw_destroy_plan((fftw_plan)fPlan);
+   fPlan = 0;
+
+   Int_t sizeout = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1]);
+   if (nbatch != fNBatch) {
+      fftw_free(fIn);
+      fftw_free((fftw_complex*)fOut);
+      fIn  = fftw_malloc(sizeof(Double_t)*fTotalSize*nbatch);
+      fOut = fftw_malloc(sizeof(fftw_complex)*sizeout*nbatch);
+      fNBatch = nbatch;
+   }
+   R__PlanWithThreads();
+   fPlan = (void*)fftw_plan_many_dft_r2c(fNdim, fN, fNBatch,
+                                         (Double_t*)fIn, 0, 1, fTotalSize,
+                                         (fftw_complex*)fOut, 0, 1, sizeout,
+                                         MapFlag(flags));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Computes the transform, specified in Init() function
 
@@ -186,10 +257,10 @@ void TFFTRealComplex::Transform()
 void TFFTRealComplex::GetPoints(Double_t *data, Bool_t fromInput) const
 {
    if (fromInput){
-      for (Int_t i=0; i<fTotalSize; i++)
+      for (Int_t i=0; i<fTotalSize*fNBatch; i++)
          data[i] = ((Double_t*)fIn)[i];
    } else {
-      Int_t realN = 2*Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1]);
+      Int_t realN = 2*Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1])*fNBatch;
       if (fOut){
          for (Int_t i=0; i<realN; i+=2){
             data[i] = ((fftw_complex*)fOut)[i/2][0];
@@ -383,13 +454,13 @@ void TFFTRealComplex::GetPointsComplex(Double_t *re, Double_t *im, Bool_t fromIn
 {
    Int_t nreal;
    if (fOut && !fromInput){
-      nreal = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1]);
+      nreal = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1])*fNBatch;
       for (Int_t i=0; i<nreal; i++){
          re[i] = ((fftw_complex*)fOut)[i][0];
          im[i] = ((fftw_complex*)fOut)[i][1];
       }
    } else if (fromInput) {
-      for (Int_t i=0; i<fTotalSize; i++){
+      for (Int_t i=0; i<fTotalSize*fNBatch; i++){
          re[i] = ((Double_t *)fIn)[i];
          im[i] = 0;
       }
@@ -413,14 +484,14 @@ void TFFTRealComplex::GetPointsComplex(Double_t *data, Bool_t fromInput) const
    Int_t nreal;
 
    if (fOut && !fromInput){
-      nreal = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1]);
+      nreal = Int_t(Double_t(fTotalSize)*(fN[fNdim-1]/2+1)/fN[fNdim-1])*fNBatch;
 
       for (Int_t i=0; i<nreal; i+=2){
          data[i] = ((fftw_complex*)fOut)[i/2][0];
          data[i+1] = ((fftw_complex*)fOut)[i/2][1];
       }
    } else if (fromInput){
-      for (Int_t i=0; i<fTotalSize; i+=2){
+      for (Int_t i=0; i<fTotalSize*fNBatch; i+=2){
          data[i] = ((Double_t*)fIn)[i/2];
          data[i+1] = 0;
       }
@@ -457,7 +528,7 @@ void TFFTRealComplex::SetPoint(const Int_t *ipoint, Double_t re, Double_t /*im*/
 
 void TFFTRealComplex::SetPoints(const Double_t *data)
 {
-   for (Int_t i=0; i<fTotalSize; i++){
+   for (Int_t i=0; i<fTotalSize*fNBatch; i++){
       ((Double_t*)fIn)[i]=data[i];
    }
 }
@@ -475,7 +546,7 @@ void TFFTRealComplex::SetPointComplex(Int_t ipoint, TComplex &c)
 
 void TFFTRealComplex::SetPointsComplex(const Double_t *re, const Double_t* /*im*/)
 {
-   for (Int_t i=0; i<fTotalSize; i++)
+   for (Int_t i=0; i<fTotalSize*fNBatch; i++)
       ((Double_t *)fIn)[i] = re[i];
 }
 
@@ -56,6 +56,11 @@ protected:
    Double_t   fMaxWtRej;      // Maximum weight in rejection for getting wt=1 events
    TRefArray *fCellsAct;      // Array of pointers to active cells, constructed at the end of foam build-up
    Double_t  *fPrimAcu;       // [fNoAct] Array of cumulative probability of all active cells
+   //------------------ Flattened tables of the active cells, rebuilt by MakeActiveList
+   Double_t  *fCellPosi;      //! [fNoAct*fDim] Positions of the active-cell hyperrectangles
+   Double_t  *fCellSize;      //! [fNoAct*fDim] Sizes of the active-cell hyperrectangles
+   Double_t  *fCellPrim;      //! [fNoAct] Primary integral of each active cell
+   Double_t  *fCellVolu;      //! [fNoAct] Cartesian volume of each active cell
    TObjArray *fHistEdg;       // Histograms of wt, one for each cell edge
    TObjArray *fHistDbg;       // Histograms of wt, for debug
    TH1D      *fHistWt;        // Histogram of the MC wt
@@ -100,6 +105,7 @@ public:
    virtual Long_t PeekMax();                 // Choose one active cell, used by Grow and also in MC generation
    virtual Int_t  Divide(TFoamCell *);       // Divide iCell into two daughters; iCell retained, taged as inactive
    virtual void MakeActiveList();            // Creates table of active cells
+   virtual void MakeCellTables();            // Flattens active cells into index-based tables for generation
    virtual void GenerCel2(TFoamCell *&);     // Chose an active cell the with probability ~ Primary integral
    // Generation
    virtual Double_t Eval(Double_t *);        // Evaluates value of the distribution function
@@ -108,6 +114,7 @@ public:
    virtual void     GetMCwt(Double_t &);     // Provides generated MC weight
    virtual Double_t GetMCwt();               // Provides generates MC weight
    virtual Double_t MCgenerate(Double_t *MCvect);// All three above function in one
+   virtual void     GenerateEvents(Int_t nevents, TRandom *pseRan, Double_t *mcVect, Double_t *mcWt) const; // Generates weighted events in an independent stream
    // Finalization
    virtual void GetIntegMC(Double_t&, Double_t&);// Provides Integrand and abs. error from MC run
    virtual void GetIntNorm(Double_t&, Double_t&);// Provides normalization Inegrand
@@ -147,8 +154,9 @@ public:
    // Inline
 private:
    Double_t Sqr(Double_t x) const { return x*x;}      // Square function
+   Long_t GenerCelIdx(TRandom *pseRan) const;         // Interpolation search for an active cell index
    //////////////////////////////////////////////////////////////////////////////////////////////
-   ClassDef(TFoam,1);   // General purpose self-adapting Monte Carlo event generator
+   ClassDef(TFoam,2);   // General purpose self-adapting Monte Carlo event generator
 };
 
 #endif
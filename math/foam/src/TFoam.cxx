@@ -123,6 +123,7 @@
 #include "TRandom.h"
 #include "TMath.h"
 #include "TInterpreter.h"
+#include <vector>
 
 ClassImp(TFoam);
 
@@ -182,6 +183,7 @@ TFoam::TFoam() :
    fMaskDiv(0), fInhiDiv(0), fOptPRD(0), fXdivPRD(0),
    fNoAct(0), fLastCe(0), fCells(0),
    fMCMonit(0), fMaxWtRej(0), fCellsAct(0), fPrimAcu(0),
+   fCellPosi(0), fCellSize(0), fCellPrim(0), fCellVolu(0),
    fHistEdg(0), fHistDbg(0), fHistWt(0),
    fMCvect(0), fMCwt(0), fRvec(0),
    fRho(0), fMethodCall(0), fPseRan(0),
@@ -203,6 +205,7 @@ TFoam::TFoam(const Char_t* Name) :
    fMaskDiv(0), fInhiDiv(0), fOptPRD(0), fXdivPRD(0),
    fNoAct(0), fLastCe(0), fCells(0),
    fMCMonit(0), fMaxWtRej(0), fCellsAct(0), fPrimAcu(0),
+   fCellPosi(0), fCellSize(0), fCellPrim(0), fCellVolu(0),
    fHistEdg(0), fHistDbg(0), fHistWt(0),
    fMCvect(0), fMCwt(0), fRvec(0),
    fRho(0), fMethodCall(0), fPseRan(0),
@@ -273,6 +276,10 @@ TFoam::~TFoam()
    if (fAlpha)   delete [] fAlpha;   //double[]
    if (fMCvect)  delete [] fMCvect;  //double[]
    if (fPrimAcu) delete [] fPrimAcu; //double[]
+   if (fCellPosi) delete [] fCellPosi; //double[]
+   if (fCellSize) delete [] fCellSize; //double[]
+   if (fCellPrim) delete [] fCellPrim; //double[]
+   if (fCellVolu) delete [] fCellVolu; //double[]
    if (fMaskDiv) delete [] fMaskDiv; //int[]
    if (fInhiDiv) delete [] fInhiDiv; //int[]
 
@@ -1026,8 +1033,47 @@ void TFoam::MakeActiveList()
       fPrimAcu[iCell]=sum;
    }
 
+   MakeCellTables();
+
 } //MakeActiveList
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal subprogram used by MakeActiveList.
+/// It flattens the geometry and normalization of the active cells into plain
+/// index-based tables (position, size, primary integral and volume per cell).
+/// The cell tree is walked through the TRef links once here, so that the MC
+/// generation can address the cells by index with no pointer chasing; the
+/// tables are read-only during generation and therefore shared between
+/// concurrent generation streams, see GenerateEvents.
+
+void TFoam::MakeCellTables()
+{
+   Long_t iCell;
+   Int_t  j;
+
+   if (fCellPosi) delete [] fCellPosi;
+   if (fCellSize) delete [] fCellSize;
+   if (fCellPrim) delete [] fCellPrim;
+   if (fCellVolu) delete [] fCellVolu;
+   fCellPosi = new Double_t[fNoAct*fDim];
+   fCellSize = new Double_t[fNoAct*fDim];
+   fCellPrim = new Double_t[fNoAct];
+   fCellVolu = new Double_t[fNoAct];
+
+   TFoamVect cellPosi(fDim), cellSize(fDim);
+   for(iCell=0; iCell<fNoAct; iCell++) {
+      TFoamCell *cell = (TFoamCell *) fCellsAct->At(iCell);
+      cell->GetHcub(cellPosi,cellSize);
+      cell->CalcVolume();
+      for(j=0; j<fDim; j++) {
+         fCellPosi[iCell*fDim+j] = cellPosi[j];
+         fCellSize[iCell*fDim+j] = cellSize[j];
+      }
+      fCellPrim[iCell] = cell->GetPrim();
+      fCellVolu[iCell] = cell->GetVolume();
+   }
+} //MakeCellTables
+
 ////////////////////////////////////////////////////////////////////////////////
 /// User may optionally reset random number generator using this method
 /// Usually it is done when FOAM object is restored from the disk.
@@ -1112,12 +1158,25 @@ Double_t TFoam::Eval(Double_t *xRand)
 /// contribution into total driver integral using interpolation search.
 
 void TFoam::GenerCel2(TFoamCell *&pCell)
+{
+   pCell = (TFoamCell *) fCellsAct->At( GenerCelIdx(fPseRan) );
+}       // TFoam::GenerCel2
+
+////////////////////////////////////////////////////////////////////////////////
+/// Internal subprogram.
+/// Return the index of a randomly chosen active cell with probability equal
+/// to its contribution into total driver integral using interpolation search.
+/// Only the (read-only) cumulative table fPrimAcu and the provided random
+/// number generator are used, so the method may be called concurrently from
+/// several generation streams, each with its own generator.
+
+Long_t TFoam::GenerCelIdx(TRandom *pseRan) const
 {
    Long_t  lo, hi, hit;
    Double_t fhit, flo, fhi;
    Double_t random;
 
-   random=fPseRan->Rndm();
+   random=pseRan->Rndm();
    lo  = 0;              hi =fNoAct-1;
    flo = fPrimAcu[lo];  fhi=fPrimAcu[hi];
    while(lo+1<hi) {
@@ -1136,10 +1195,9 @@ void TFoam::GenerCel2(TFoamCell *&pCell)
       }
    }
    if (fPrimAcu[lo]>random)
-      pCell = (TFoamCell *) fCellsAct->At(lo);
-   else
-      pCell = (TFoamCell *) fCellsAct->At(hi);
-}       // TFoam::GenerCel2
+      return lo;
+   return hi;
+}       // TFoam::GenerCelIdx
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1153,24 +1211,24 @@ void TFoam::MakeEvent(void)
 {
    Int_t      j;
    Double_t   wt,dx,mcwt;
-   TFoamCell *rCell;
+   Long_t     iCell;
    //
    //********************** MC LOOP STARS HERE **********************
 ee0:
-   GenerCel2(rCell);   // choose randomly one cell
+   iCell = GenerCelIdx(fPseRan);   // choose randomly one cell
 
    MakeAlpha();
 
-   TFoamVect  cellPosi(fDim); TFoamVect  cellSize(fDim);
-   rCell->GetHcub(cellPosi,cellSize);
+   const Double_t *cellPosi = fCellPosi +iCell*fDim;  // flattened cell tables,
+   const Double_t *cellSize = fCellSize +iCell*fDim;  // see MakeCellTables
    for(j=0; j<fDim; j++)
       fMCvect[j]= cellPosi[j] +fAlpha[j]*cellSize[j];
-   dx = rCell->GetVolume();      // Cartesian volume of the Cell
+   dx = fCellVolu[iCell];        // Cartesian volume of the Cell
    //  weight average normalized to PRIMARY integral over the cell
 
    wt=dx*Eval(fMCvect);
 
-   mcwt = wt / rCell->GetPrim();  // PRIMARY controls normalization
+   mcwt = wt / fCellPrim[iCell];  // PRIMARY controls normalization
    fNCalls++;
    fMCwt   =  mcwt;
    // accumulation of statistics for the main MC weight
@@ -1229,6 +1287,46 @@ Double_t TFoam::MCgenerate(Double_t *MCvect)
    return(fMCwt);
 }//MCgenerate
 
+////////////////////////////////////////////////////////////////////////////////
+/// User subprogram.
+/// It generates nevents weighted MC events in one call, writing point iev into
+/// mcVect[iev*fDim]...mcVect[iev*fDim+fDim-1] and its weight into mcWt[iev].
+///
+/// Unlike MakeEvent, this method does not touch any mutable state of the FOAM
+/// object: it reads only the flattened cell tables built by MakeActiveList and
+/// uses the provided random number generator. Several generation streams may
+/// therefore run concurrently on the same initialized FOAM object, each with
+/// its own independent TRandom instance (and thus its own random state),
+/// provided the density function itself is thread safe. The internal weight
+/// bookkeeping (GetIntegMC, weight monitoring) and the wt=1 rejection are not
+/// performed; the caller receives plain weighted events. Works only with a
+/// distribution set in compiled mode (TFoamIntegrand), not with an
+/// interpreted global function.
+
+void TFoam::GenerateEvents(Int_t nevents, TRandom *pseRan, Double_t *mcVect, Double_t *mcWt) const
+{
+   if(fRho==0) {
+      Error("GenerateEvents", "Works only in compiled mode (SetRho) \n");
+      return;
+   }
+   if(fCellPrim==0) {
+      Error("GenerateEvents", "No cell tables, Initialize() not called \n");
+      return;
+   }
+   std::vector<Double_t> alpha(fDim);
+   for(Int_t iev=0; iev<nevents; iev++) {
+      Long_t iCell = GenerCelIdx(pseRan);
+      if(fDim>0) pseRan->RndmArray(fDim, &alpha[0]);
+      Double_t *x = mcVect +iev*fDim;
+      const Double_t *cellPosi = fCellPosi +iCell*fDim;
+      const Double_t *cellSize = fCellSize +iCell*fDim;
+      for(Int_t j=0; j<fDim; j++)
+         x[j] = cellPosi[j] +alpha[j]*cellSize[j];
+      Double_t wt = fCellVolu[iCell]*fRho->Density(fDim,x);
+      mcWt[iev] = wt / fCellPrim[iCell];   // PRIMARY controls normalization
+   }
+} // GenerateEvents
+
 ////////////////////////////////////////////////////////////////////////////////
 /// User subprogram.
 /// It provides the value of the integral calculated from the averages of the MC run
@@ -248,6 +248,25 @@ public:
     return Foreign4Vector ( r_xyzt.X(), r_xyzt.Y(), r_xyzt.Z(), r_xyzt.T() );
   }
 
+  /**
+     Apply the boost to n 4-vectors stored in structure-of-arrays form
+     (separate x/y/z/t component arrays). The symmetric 4x4 kernel is
+     fully unrolled for each vector and the loop over the span can be
+     vectorized by the compiler. In-place operation (xout == x etc.)
+     is allowed.
+   */
+  void ApplyToVectors(unsigned int n,
+                      const Scalar *x, const Scalar *y, const Scalar *z, const Scalar *t,
+                      Scalar *xout, Scalar *yout, Scalar *zout, Scalar *tout) const {
+    for (unsigned int i = 0; i < n; ++i) {
+      const Scalar xx = x[i], yy = y[i], zz = z[i], tt = t[i];
+      xout[i] = fM[kXX]*xx + fM[kXY]*yy + fM[kXZ]*zz + fM[kXT]*tt;
+      yout[i] = fM[kXY]*xx + fM[kYY]*yy + fM[kYZ]*zz + fM[kYT]*tt;
+      zout[i] = fM[kXZ]*xx + fM[kYZ]*yy + fM[kZZ]*zz + fM[kZT]*tt;
+      tout[i] = fM[kXT]*xx + fM[kYT]*yy + fM[kZT]*zz + fM[kTT]*tt;
+    }
+  }
+
   /**
      Overload operator * for boost on a vector
    */
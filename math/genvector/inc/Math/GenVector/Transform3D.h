@@ -531,6 +531,62 @@ public:
    */
    Plane3D operator() (const Plane3D & plane) const;
 
+   /**
+      Apply the transformation to n points stored in structure-of-arrays
+      form (separate coordinate arrays). The rotation and the translation
+      are fused in a single fully unrolled 3x4 kernel per point, and the
+      loop is free of branches and aliasing on the matrix elements, so it
+      can be vectorized by the compiler. In-place operation
+      (xout == x etc.) is allowed.
+   */
+   void ApplyToPoints(unsigned int n,
+                      const double *x, const double *y, const double *z,
+                      double *xout, double *yout, double *zout) const {
+      for (unsigned int i = 0; i < n; ++i) {
+         const double xx = x[i], yy = y[i], zz = z[i];
+         xout[i] = fM[kXX]*xx + fM[kXY]*yy + fM[kXZ]*zz + fM[kDX];
+         yout[i] = fM[kYX]*xx + fM[kYY]*yy + fM[kYZ]*zz + fM[kDY];
+         zout[i] = fM[kZX]*xx + fM[kZY]*yy + fM[kZZ]*zz + fM[kDZ];
+      }
+   }
+
+   /**
+      Apply the transformation to n displacement vectors stored in
+      structure-of-arrays form: as for the scalar operator() only the
+      rotation is applied, not the translation.
+      In-place operation is allowed.
+   */
+   void ApplyToVectors(unsigned int n,
+                       const double *x, const double *y, const double *z,
+                       double *xout, double *yout, double *zout) const {
+      for (unsigned int i = 0; i < n; ++i) {
+         const double xx = x[i], yy = y[i], zz = z[i];
+         xout[i] = fM[kXX]*xx + fM[kXY]*yy + fM[kXZ]*zz;
+         yout[i] = fM[kYX]*xx + fM[kYY]*yy + fM[kYZ]*zz;
+         zout[i] = fM[kZX]*xx + fM[kZY]*yy + fM[kZZ]*zz;
+      }
+   }
+
+   /**
+      Apply an array of transformations to n points stored in
+      structure-of-arrays form: point i is transformed (rotation plus
+      translation) with t[i]. This is the alignment use case where every
+      point carries its own transformation; the per-point kernel is the
+      same fully unrolled one as in ApplyToPoints.
+      In-place operation is allowed.
+   */
+   static void ApplyToPoints(const Transform3D *t, unsigned int n,
+                             const double *x, const double *y, const double *z,
+                             double *xout, double *yout, double *zout) {
+      for (unsigned int i = 0; i < n; ++i) {
+         const double *m = t[i].fM;
+         const double xx = x[i], yy = y[i], zz = z[i];
+         xout[i] = m[kXX]*xx + m[kXY]*yy + m[kXZ]*zz + m[kDX];
+         yout[i] = m[kYX]*xx + m[kYY]*yy + m[kYZ]*zz + m[kDY];
+         zout[i] = m[kZX]*xx + m[kZY]*yy + m[kZZ]*zz + m[kDZ];
+      }
+   }
+
 
    // skip transformation for arbitrary vectors - not really defined if point or displacement vectors
 
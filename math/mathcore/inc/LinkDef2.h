@@ -31,8 +31,6 @@
 #pragma link C++ operators std::vector<Double_t>::reverse_iterator;
 #endif
 
-#pragma link C++ global gRandom;
-
 #pragma link C++ class TRandom+;
 #pragma link C++ class TRandom1+;
 #pragma link C++ class TRandom2+;
@@ -41,6 +39,7 @@
 #pragma link C++ class ROOT::Math::TRandomEngine+;
 #pragma link C++ class ROOT::Math::LCGEngine+;
 #pragma link C++ class ROOT::Math::MersenneTwisterEngine+;
+#pragma link C++ class ROOT::Math::PhiloxEngine+;
 #pragma link C++ class ROOT::Math::MixMaxEngine<240,0>+;
 #pragma link C++ class ROOT::Math::MixMaxEngine<256,2>+;
 #pragma link C++ class ROOT::Math::MixMaxEngine<17,1>+;
@@ -71,6 +70,7 @@
 #pragma link C++ class TRandomGen<ROOT::Math::MixMaxEngine<17,1>>+;
 #pragma link C++ class TRandomGen<ROOT::Math::StdEngine<std::mt19937_64>>+;
 #pragma link C++ class TRandomGen<ROOT::Math::StdEngine<std::ranlux48>>+;
+#pragma link C++ class TRandomGen<ROOT::Math::PhiloxEngine>+;
 
 
 #pragma link C++ class ROOT::Math::StdRandomEngine+;
@@ -154,6 +154,9 @@
 #pragma link C++ namespace ROOT::Math::IntegrationOneDim;
 #pragma link C++ enum ROOT::Math::IntegrationOneDim::Type;
 #pragma link C++ namespace ROOT::Math::IntegrationMultiDim;
+
+#pragma link C++ namespace ROOT::Math::FastMath;
+#pragma link C++ enum ROOT::Math::FastMath::EAccuracy;
 // #pragma link C++ typedef ROOT::Math::IntegratorOneDim::Type;
 // #pragma link C++ typedef ROOT::Math::IntegratorMultiDim::Type;
 
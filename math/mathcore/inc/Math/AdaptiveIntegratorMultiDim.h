@@ -18,6 +18,9 @@
 
 #include "Math/VirtualIntegrator.h"
 
+#include <functional>
+#include <vector>
+
 namespace ROOT {
 namespace Math {
 
@@ -127,6 +130,18 @@ public:
    /// set the integration function (must implement multi-dim function interface: IBaseFunctionMultiDim)
    void SetFunction(const IMultiGenFunction &f);
 
+   /// Type of an optional batch integrand: evaluates npts points of the
+   /// integrand in one call. The coordinates are laid out point-major in x
+   /// (x[i*dim+j] is coordinate j of point i) and the function values are
+   /// to be stored in vals.
+   typedef std::function<void(unsigned int npts, const double *x, double *vals)> BatchFunction;
+
+   /// set an optional batch integrand, evaluating all rule points of a
+   /// sub-region in one call. The batch function is free to vectorize or
+   /// parallelize over the points; it must describe the same integrand as
+   /// the function set with SetFunction. Pass an empty function to unset.
+   void SetBatchFunction(const BatchFunction &f) { fBatchFun = f; }
+
    /// return result of integration
    double Result() const { return fResult; }
 
@@ -177,6 +192,12 @@ protected:
    // internal function to compute the integral (if absVal is true compute abs value of function integral
    double DoIntegral(const double* xmin, const double * xmax, bool absVal = false);
 
+   // apply the integration rule to one sub-region: generate all rule nodes,
+   // evaluate them in one batch and form the weighted sums
+   void EvalRule(unsigned int n, const double *ctr, const double *wth, double rgnvol,
+                 bool absVal, double *sums, double &rgnval, double &rgnerr,
+                 unsigned int &idvaxn);
+
  private:
 
    unsigned int fDim;     // dimensionality of integrand
@@ -193,6 +214,10 @@ protected:
    int fStatus;           // status of algorithm (error if not zero)
 
    const IMultiGenFunction* fFun;   // pointer to integrand function
+   BatchFunction fBatchFun;         // optional batch integrand
+
+   std::vector<double> fRulePoints; //! buffer for the rule node coordinates of one sub-region
+   std::vector<double> fRuleValues; //! buffer for the integrand values at the rule nodes
 
 };
 
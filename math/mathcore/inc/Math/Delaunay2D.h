@@ -25,7 +25,6 @@
 
 #include <map>
 #include <vector>
-#include <set>
 #include <functional>
 
 #ifdef HAS_CGAL
@@ -92,6 +91,16 @@ public:
    /// set the input points for building the graph
    void SetInputPoints(int n, const double *x, const double * y, const double * z, double xmin=0, double xmax=0, double ymin=0, double ymax=0);
 
+   /// append the points [NPoints, n) of the given arrays to the triangulation;
+   /// the arrays must contain the previous points as well (the caller may have
+   /// reallocated them). Points falling inside the current convex hull are
+   /// inserted incrementally by splitting their containing triangle, points
+   /// outside trigger a full re-triangulation on the next use.
+   void AppendPoints(int n, const double *x, const double * y, const double * z);
+
+   /// return the number of input points
+   Int_t     NPoints() const {return fNpoints;}
+
    /// Return the Interpolated z value corresponding to the (x,y) point
    double  Interpolate(double x, double y);
 
@@ -263,13 +272,22 @@ protected:
 
    /* To speed up localisation of points a grid is layed over normalized space
     *
-    * A reference to triangle ABC is added to _all_ grid cells that include ABC's bounding box
+    * A reference to triangle ABC is added to _all_ grid cells that include ABC's bounding box.
+    * The number of cells scales with the number of points, so that the cells
+    * stay sparsely populated and the containing triangle is found in roughly
+    * constant time.
     */
 
-   static const int fNCells = 25; //! number of cells to divide the normalized space
+   int fNCells = 25; //! number of cells per dimension to divide the normalized space
    double fXCellStep; //! inverse denominator to calculate X cell = fNCells / (fXNmax - fXNmin)
    double fYCellStep; //! inverse denominator to calculate X cell = fNCells / (fYNmax - fYNmin)
-   std::set<UInt_t> fCells[(fNCells+1)*(fNCells+1)]; //! grid cells with containing triangles
+   std::vector<std::vector<UInt_t> > fCells; //! grid cells with containing triangles
+
+   /// insert the (already appended) point with index ip into the existing
+   /// triangulation by splitting its containing triangle; returns false when
+   /// the point is outside the current grid or convex hull and a full
+   /// re-triangulation is needed
+   bool DoInsertPoint(UInt_t ip);
 
    inline unsigned int Cell(UInt_t x, UInt_t y) const {
 	   return x*(fNCells+1) + y;
@@ -0,0 +1,67 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Batch evaluation of transcendental functions with selectable accuracy
+
+#ifndef ROOT_Math_FastMathBatch
+#define ROOT_Math_FastMathBatch
+
+namespace ROOT {
+
+   namespace Math {
+
+/**
+   namespace with batch (array-at-a-time) transcendental functions.
+
+   TMath and std:: evaluate one value per call; analysis loops computing
+   masses and angles over millions of four-vectors pay a libm call per
+   element and give the compiler no chance to vectorize. The functions
+   here evaluate a whole span per call in loops written to vectorize,
+   with the accuracy selectable per call:
+
+   - kExact:  libm, results identical to TMath / std::;
+   - kFast:   the inlined vdt implementations when ROOT is built with
+              vdt (the default tier, a few ulp from libm), otherwise
+              equivalent to kExact;
+   - kApprox: single-precision-grade polynomial approximations, about
+              six significant digits, the cheapest tier.
+
+   On x86-64 ELF platforms with gcc the kernels are cloned for avx2 and
+   avx512f and the best variant for the running CPU is selected at load
+   time.
+
+   EtaFromRhoZ evaluates the pseudorapidity formula the GenVector
+   classes and TLorentzVector use (ROOT::Math::Impl::Eta_FromRhoZ) over
+   a span; Atan2 over (y,x) spans is the batch form of Phi().
+*/
+namespace FastMath {
+
+   enum EAccuracy {
+      kExact  = 0,   // libm, identical to the TMath / std:: results
+      kFast   = 1,   // inlined vdt implementations when available
+      kApprox = 2    // polynomial approximations, ~ 1e-6 relative accuracy
+   };
+
+   void Exp (const double *x, double *out, int n, EAccuracy tier = kFast);
+   void Log (const double *x, double *out, int n, EAccuracy tier = kFast);
+   void Sin (const double *x, double *out, int n, EAccuracy tier = kFast);
+   void Atan2(const double *y, const double *x, double *out, int n, EAccuracy tier = kFast);
+
+   /// pseudorapidity from cylindrical rho and z over spans, evaluating the
+   /// same formula as ROOT::Math::Impl::Eta_FromRhoZ (used by the GenVector
+   /// coordinate classes and by TLorentzVector::PseudoRapidity)
+   void EtaFromRhoZ(const double *rho, const double *z, double *out, int n, EAccuracy tier = kFast);
+
+}  // end namespace FastMath
+
+   } // end namespace Math
+
+} // end namespace ROOT
+
+#endif /* ROOT_Math_FastMathBatch */
@@ -172,6 +172,22 @@ public:
    // Compute The 2-Sample Anderson Darling test for binned data
    static void  AndersonDarling2SamplesTest(const ROOT::Fit::BinData & data1, const ROOT::Fit::BinData & data2, Double_t& pvalue, Double_t& testStat);
 
+/*
+  Configure the automatic switch-over to a binned approximation of the tests.
+  When the total number of observations is >= sampleSizeThreshold the samples
+  are not stored and sorted in full at construction time:
+  they are reduced in a single pass to nbins equal-width bins
+  keeping the bin contents as sufficient statistics. The tests then run on the
+  bins in O(nbins) instead of O(n log n), treating each bin content as identical
+  observations at the bin centre (as in the binned 2-samples Anderson-Darling
+  test above). The error on the test statistics is bounded by the variation of
+  the cumulative distribution across a single bin.
+  A threshold of 0 (the default) disables the binned mode.
+*/ static void SetAutoBinning(UInt_t sampleSizeThreshold, UInt_t nbins = 1000);
+
+   /* Returns kTRUE when the samples have been reduced to the binned approximation */
+   Bool_t IsBinned() const { return fBinned; }
+
 private:
 
    GoFTest();                       // Disallowed default constructor
@@ -189,8 +205,13 @@ private:
    std::vector<Double_t> fCombinedSamples;
 
    std::vector<std::vector<Double_t> > fSamples;
+   std::vector<std::vector<Double_t> > fSampleWeights; // bin contents when fBinned (parallel to fSamples)
 
    Bool_t fTestSampleFromH0;
+   Bool_t fBinned;                    // true when the samples have been reduced to bins
+
+   static UInt_t fgAutoBinThreshold;  // sample size triggering the binned approximation (0 = disabled)
+   static UInt_t fgAutoBinBins;       // number of bins used by the binned approximation
 
    void SetCDF();
    void SetDistributionFunction(const IGenFunction& cdf, Bool_t isPDF, Double_t xmin, Double_t xmax);
@@ -0,0 +1,181 @@
+// @(#)root/mathcore:$Id$
+// Author: L. Moneta Tue Aug 4 2015
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2015  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// random engines based on ROOT
+
+#ifndef ROOT_Math_PhiloxEngine
+#define ROOT_Math_PhiloxEngine
+
+#include "Math/TRandomEngine.h"
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+   namespace Math {
+
+      /**
+         Counter-based random number generator implementing the
+         Philox-4x32-10 algorithm of
+
+         J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+         Parallel Random Numbers: As Easy as 1, 2, 3,
+         Proceedings of SC'11, http://dx.doi.org/10.1145/2063384.2063405
+
+         A counter-based generator has no recurrence: block i of four 32-bit
+         values is a fixed bijection of the 128-bit counter i and the 64-bit
+         key (the seed). Blocks can therefore be computed independently and
+         in any order, which makes the generator trivial to vectorize and to
+         use from several threads or for batched generation - see
+         RndmArray() and the TRandom array methods. The period is 2**130
+         per key.
+
+         @ingroup Random
+      */
+
+      class PhiloxEngine : public TRandomEngine {
+
+      public:
+
+         typedef  TRandomEngine BaseType;
+         typedef  uint32_t Result_t;
+         typedef  uint32_t StateInt_t;
+
+         PhiloxEngine(uint64_t seed = 4357) {
+            SetSeed(seed);
+         }
+
+         virtual ~PhiloxEngine() {}
+
+         void SetSeed(uint64_t seed) {
+            fKey[0] = (uint32_t)seed;
+            fKey[1] = (uint32_t)(seed >> 32);
+            for (int i = 0; i < 4; ++i) fCounter[i] = 0;
+            fCount4 = 4;   // force the computation of a new block
+         }
+
+         virtual double Rndm() {
+            return Rndm_impl();
+         }
+         inline double operator() () { return Rndm_impl(); }
+
+         uint32_t IntRndm() {
+            if (fCount4 == 4) NextBlock();
+            return fBuffer[fCount4++];
+         }
+
+         /// Fill the array with n uniform deviates in ]0,1].
+         /// The blocks are generated back to back without going through the
+         /// internal buffer, in a loop free of cross-iteration dependencies.
+         void RndmArray(int n, double *array) {
+            int i = 0;
+            while (i < n && fCount4 < 4)     // flush the buffered values first
+               FillValue(fBuffer[fCount4++], array, i, n);
+            while (i < n) {
+               NextBlock();
+               while (i < n && fCount4 < 4)
+                  FillValue(fBuffer[fCount4++], array, i, n);
+            }
+         }
+
+         /// minimum integer that can be generated
+         static unsigned int MinInt() { return 0; }
+         /// maximum integer that can be generated
+         static unsigned int MaxInt() { return 0xffffffff; }  //  2^32 -1
+         /// Size of the generator state (counter + key)
+         static int Size() { return 6; }
+         /// Name of the generator
+         static std::string Name() { return "PhiloxEngine"; }
+
+      protected:
+         // for testing all generators
+         void SetState(const std::vector<uint32_t> & state) {
+            assert(state.size() >= 6);
+            for (int i = 0; i < 4; ++i) fCounter[i] = state[i];
+            fKey[0] = state[4];
+            fKey[1] = state[5];
+            fCount4 = 4;   // to make sure we re-iterate on the new state
+         }
+
+         void GetState(std::vector<uint32_t> & state) {
+            state.resize(6);
+            for (int i = 0; i < 4; ++i) state[i] = fCounter[i];
+            state[4] = fKey[0];
+            state[5] = fKey[1];
+         }
+         int Counter() const { return fCount4; }
+
+      private:
+
+         static void MulHiLo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo) {
+            uint64_t p = (uint64_t)a * b;
+            hi = (uint32_t)(p >> 32);
+            lo = (uint32_t)p;
+         }
+
+         /// Compute the block of the current counter value into the buffer
+         /// and advance the counter.
+         void NextBlock() {
+            const uint32_t kM0 = 0xD2511F53;
+            const uint32_t kM1 = 0xCD9E8D57;
+            const uint32_t kW0 = 0x9E3779B9;   // golden ratio
+            const uint32_t kW1 = 0xBB67AE85;   // sqrt(3)-1
+            uint32_t x0 = fCounter[0], x1 = fCounter[1];
+            uint32_t x2 = fCounter[2], x3 = fCounter[3];
+            uint32_t k0 = fKey[0], k1 = fKey[1];
+            for (int round = 0; round < 10; ++round) {
+               uint32_t hi0, lo0, hi1, lo1;
+               MulHiLo(kM0, x0, hi0, lo0);
+               MulHiLo(kM1, x2, hi1, lo1);
+               x0 = hi1 ^ x1 ^ k0;
+               x1 = lo1;
+               x2 = hi0 ^ x3 ^ k1;
+               x3 = lo0;
+               k0 += kW0;
+               k1 += kW1;
+            }
+            fBuffer[0] = x0; fBuffer[1] = x1;
+            fBuffer[2] = x2; fBuffer[3] = x3;
+            // increment the 128 bit counter
+            if (++fCounter[0] == 0)
+               if (++fCounter[1] == 0)
+                  if (++fCounter[2] == 0)
+                     ++fCounter[3];
+            fCount4 = 0;
+         }
+
+         static void FillValue(uint32_t rndm, double *array, int &i, int n) {
+            const double kCONS = 2.3283064365386963E-10; // (1/pow(2,32))
+            if (rndm != 0 && i < n) array[i++] = kCONS * rndm;
+         }
+
+         double Rndm_impl() {
+            const double kCONS = 2.3283064365386963E-10; // (1/pow(2,32))
+            uint32_t rndm = IntRndm(); // generate integer number
+            if (rndm != 0) return  kCONS * rndm;
+            return Rndm_impl();
+         }
+
+         uint32_t fCounter[4];  // 128 bit block counter
+         uint32_t fKey[2];      // 64 bit key (the seed)
+         uint32_t fBuffer[4];   // values of the current block
+         int      fCount4;      // number of values of the block already returned
+      };
+
+
+   } // end namespace Math
+
+} // end namespace ROOT
+
+
+#endif /* ROOT_Math_PhiloxEngine */
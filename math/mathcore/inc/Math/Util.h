@@ -19,6 +19,15 @@
 #include <cmath>
 #include <limits>
 
+#include "RConfigure.h"
+
+// use the vdt fast inlined transcendental functions when available :
+// log/exp dominate the likelihood evaluation hot loops in Fit/FitUtil
+#ifdef R__HAS_VDT
+#include "vdt/log.h"
+#include "vdt/exp.h"
+#endif
+
 
 // for defining unused variables in the interfaces
 //  and have still them in the documentation
@@ -62,7 +71,22 @@ inline double EvalLog(double x) {
    if(x<= epsilon)
       return x/epsilon + std::log(epsilon) - 1;
    else
+#ifdef R__HAS_VDT
+      return vdt::fast_log(x);
+#else
       return std::log(x);
+#endif
+}
+
+/// evaluation of exp(x) using the fast vdt implementation when available.
+/// To be used in the evaluation of the model functions inside the fitting hot
+/// loops, where the small accuracy loss of the fast version is acceptable
+inline double EvalExp(double x) {
+#ifdef R__HAS_VDT
+   return vdt::fast_exp(x);
+#else
+   return std::exp(x);
+#endif
 }
 
 }  // end namespace Util
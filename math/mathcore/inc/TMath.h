@@ -295,6 +295,10 @@ namespace TMath {
 
    //Mean, Geometric Mean, Median, RMS(sigma)
 
+   template <typename T> Double_t PairwiseSum(Long64_t n, const T *a);
+   template <typename T> void MeanVarMinMax(Long64_t n, const T *a, Double_t &mean, Double_t &var,
+                                            Double_t &amin, Double_t &amax);
+
    template <typename T> Double_t Mean(Long64_t n, const T *a, const Double_t *w=0);
    template <typename Iterator> Double_t Mean(Iterator first, Iterator last);
    template <typename Iterator, typename WeightIterator> Double_t Mean(Iterator first, Iterator last, WeightIterator wfirst);
@@ -840,6 +844,82 @@ Double_t TMath::Mean(Iterator first, Iterator last, WeightIterator w)
    return sum/sumw;
 }
 
+template <typename T>
+Double_t TMath::PairwiseSum(Long64_t n, const T *a)
+{
+   // Return the sum of an array a with length n, accumulated pairwise.
+   // Pairwise summation keeps the rounding error at O(log n) instead of
+   // the O(n) of a running sum, and the unrolled base case gives the
+   // compiler independent accumulators to vectorize.
+
+   if (n <= 0) return 0;
+   if (n <= 128) {
+      Double_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+      Long64_t i = 0;
+      for (; i + 4 <= n; i += 4) {
+         s0 += a[i];
+         s1 += a[i+1];
+         s2 += a[i+2];
+         s3 += a[i+3];
+      }
+      for (; i < n; ++i)
+         s0 += a[i];
+      return (s0 + s1) + (s2 + s3);
+   }
+   Long64_t half = n/2;
+   return TMath::PairwiseSum(half, a) + TMath::PairwiseSum(n - half, a + half);
+}
+
+template <typename T>
+void TMath::MeanVarMinMax(Long64_t n, const T *a, Double_t &mean, Double_t &var,
+                          Double_t &amin, Double_t &amax)
+{
+   // Compute the mean, the unbiased variance (sigma^2, the square of what
+   // RMS returns) and the minimum and maximum of an array a with length n
+   // in a single pass over the data. The array is processed in
+   // cache-resident blocks whose plain accumulators vectorize; the block
+   // results are merged with the update formulae of Chan et al., which
+   // keeps the precision of the two pass algorithm without reading the
+   // data twice.
+
+   mean = var = amin = amax = 0;
+   if (n <= 0) return;
+   amin = amax = a[0];
+
+   Double_t m  = 0;  // running mean
+   Double_t m2 = 0;  // running sum of squared deviations from the mean
+   Long64_t nacc = 0;
+   const Long64_t kBlockSize = 256;
+   for (Long64_t start = 0; start < n; start += kBlockSize) {
+      Long64_t len = TMath::Min(kBlockSize, n - start);
+      const T *b = a + start;
+      Double_t sum = 0;
+      Double_t bmin = b[0];
+      Double_t bmax = b[0];
+      for (Long64_t i = 0; i < len; ++i) {
+         Double_t x = b[i];
+         sum += x;
+         if (x < bmin) bmin = x;
+         if (x > bmax) bmax = x;
+      }
+      Double_t bmean = sum/len;
+      Double_t bm2 = 0;
+      for (Long64_t i = 0; i < len; ++i) {
+         Double_t d = Double_t(b[i]) - bmean;
+         bm2 += d*d;
+      }
+      Long64_t ntot = nacc + len;
+      Double_t delta = bmean - m;
+      m2 += bm2 + delta*delta*(Double_t(nacc)*len/ntot);
+      m  += delta*(Double_t(len)/ntot);
+      nacc = ntot;
+      if (bmin < amin) amin = bmin;
+      if (bmax > amax) amax = bmax;
+   }
+   mean = m;
+   var = (n > 1) ? m2/(n - 1) : 0.0;
+}
+
 template <typename T>
 Double_t TMath::Mean(Long64_t n, const T *a, const Double_t *w)
 {
@@ -848,7 +928,10 @@ Double_t TMath::Mean(Long64_t n, const T *a, const Double_t *w)
    if (w) {
       return TMath::Mean(a, a+n, w);
    } else {
-      return TMath::Mean(a, a+n);
+      // Contiguous unweighted data: sum pairwise instead of through the
+      // iterator loop, for precision and vectorization.
+      if (n <= 0) return 0;
+      return TMath::PairwiseSum(n, a)/n;
    }
 }
 
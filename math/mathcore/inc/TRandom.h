@@ -36,11 +36,14 @@ public:
    virtual  Double_t BreitWigner(Double_t mean=0, Double_t gamma=1);
    virtual  void     Circle(Double_t &x, Double_t &y, Double_t r);
    virtual  Double_t Exp(Double_t tau);
+   virtual  void     ExpArray(Int_t n, Double_t *array, Double_t tau);
    virtual  Double_t Gaus(Double_t mean=0, Double_t sigma=1);
+   virtual  void     GausArray(Int_t n, Double_t *array, Double_t mean=0, Double_t sigma=1);
    virtual  UInt_t   GetSeed() const {return fSeed;}
    virtual  UInt_t   Integer(UInt_t imax);
    virtual  Double_t Landau(Double_t mean=0, Double_t sigma=1);
    virtual  Int_t    Poisson(Double_t mean);
+   virtual  void     PoissonArray(Int_t n, Int_t *array, Double_t mean);
    virtual  Double_t PoissonD(Double_t mean);
    virtual  void     Rannor(Float_t &a, Float_t &b);
    virtual  void     Rannor(Double_t &a, Double_t &b);
@@ -56,9 +59,19 @@ public:
    virtual  Double_t Uniform(Double_t x1, Double_t x2);
    virtual  void     WriteRandom(const char *filename) const;
 
+   static TRandom *&CurrentEngine();
+   static ULong_t   GetMasterSeed();
+   static void      SetMasterSeed(ULong_t seed);
+
    ClassDef(TRandom,3)  //Simple Random number generator (periodicity = 10**9)
 };
 
+#ifndef __CINT__
+#define gRandom (TRandom::CurrentEngine())
+
+#elif defined(__MAKECINT__)
+// To properly handle the use of gRandom in header files (in static declarations)
 R__EXTERN TRandom *gRandom;
+#endif
 
 #endif
@@ -68,6 +68,4 @@ public:
    ClassDef(TRandom1,1)  //Ranlux Random number generators with periodicity > 10**14
 };
 
-R__EXTERN TRandom *gRandom;
-
 #endif
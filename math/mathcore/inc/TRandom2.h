@@ -42,6 +42,4 @@ public:
    ClassDef(TRandom2,1)  //Random number generator with periodicity of 10**26
 };
 
-R__EXTERN TRandom *gRandom;
-
 #endif
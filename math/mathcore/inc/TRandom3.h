@@ -44,6 +44,4 @@ public:
    ClassDef(TRandom3,2)  //Random number generator: Mersenne Twister
 };
 
-R__EXTERN TRandom *gRandom;
-
 #endif
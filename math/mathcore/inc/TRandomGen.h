@@ -57,6 +57,7 @@ public:
 // some useful typedef
 #include "Math/StdEngine.h"
 #include "Math/MixMaxEngine.h"
+#include "Math/PhiloxEngine.h"
 
 // not working wight now for this classes
 //#define  DEFINE_TEMPL_INSTANCE
@@ -78,6 +79,7 @@ typedef TRandomGen<ROOT::Math::MixMaxEngine<256,2>> TRandomMixMax256;
 typedef TRandomGen<ROOT::Math::MixMaxEngine<17,0>> TRandomMixMax17;
 typedef TRandomGen<ROOT::Math::StdEngine<std::mt19937_64> > TRandomMT64;
 typedef TRandomGen<ROOT::Math::StdEngine<std::ranlux48> > TRandomRanlux48;
+typedef TRandomGen<ROOT::Math::PhiloxEngine> TRandomPhilox;
 
 
 #endif
@@ -69,34 +69,17 @@ void AdaptiveIntegratorMultiDim::SetFunction(const IMultiGenFunction &f)
 
 void AdaptiveIntegratorMultiDim::SetRelTolerance(double relTol){ this->fRelTol = relTol; }
 
-
-void AdaptiveIntegratorMultiDim::SetAbsTolerance(double absTol){ this->fAbsTol = absTol; }
-
-
-double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double * xmax, bool absValue)
+void AdaptiveIntegratorMultiDim::EvalRule(unsigned int n, const double *ctr, const double *wth, double rgnvol,
+                                          bool absVal, double *sums, double &rgnval, double &rgnerr,
+                                          unsigned int &idvaxn)
 {
-   // References:
-   //
-   //   1.A.C. Genz and A.A. Malik, Remarks on algorithm 006:
-   //     An adaptive algorithm for numerical integration over
-   //     an N-dimensional rectangular region, J. Comput. Appl. Math. 6 (1980) 295-302.
-   //   2.A. van Doren and L. de Ridder, An adaptive algorithm for numerical
-   //     integration over an n-dimensional cube, J.Comput. Appl. Math. 2 (1976) 207-217.
-
-   //to be changed later
-   unsigned int n=fDim;
-   bool kFALSE = false;
-   bool kTRUE = true;
-
-   double epsrel = fRelTol; //specified relative accuracy
-   double epsabs = fAbsTol; //specified relative accuracy
-   //output parameters
-   fStatus = 0; //report status
-   unsigned int nfnevl; //nr of function evaluations
-   double relerr; //an estimation of the relative accuracy of the result
-
-
-   double ctr[15], wth[15], wthl[15], z[15];
+   // Apply the degree seven integration rule to the sub-region with center ctr
+   // and half-widths wth: generate the coordinates of all rule nodes in the
+   // same order the serial algorithm visits them, evaluate the integrand on
+   // all nodes in one batch (via the batch function if one is set) and build
+   // the weighted sums. Returns the five partial sums in sums[0..4], the rule
+   // value and error estimate of the region and the coordinate with the
+   // largest fourth difference (idvaxn, 1-based).
 
    static const double xl2 = 0.358568582800318073;//lambda_2
    static const double xl4 = 0.948683298050513796;//lambda_4
@@ -136,6 +119,142 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
                                         -0.504115226337448555,  -0.572702331961591218,  -0.641289437585733882,
                                         -0.709876543209876532,  -0.778463648834019195,  -0.847050754458161859};
 
+   double wthl[15], z[15];
+   unsigned int j, j1, k, l, m;
+
+   unsigned int npts = (unsigned int)std::pow(2.0,static_cast<int>(n)) + 2*n*(n+1) + 1;
+   fRulePoints.resize(npts*n);
+   fRuleValues.resize(npts);
+
+   // generate the node coordinates in the order of the serial algorithm:
+   // the region center first
+   double *p = &fRulePoints[0];
+   for (j=0; j<n; j++) z[j] = ctr[j];
+   std::copy(z, z+n, p); p += n;
+
+   // the four axial nodes per coordinate (lambda_2 and lambda_4)
+   for (j=0; j<n; j++) {
+      z[j]    = ctr[j] - xl2*wth[j];
+      std::copy(z, z+n, p); p += n;
+      z[j]    = ctr[j] + xl2*wth[j];
+      std::copy(z, z+n, p); p += n;
+      wthl[j] = xl4*wth[j];
+      z[j]    = ctr[j] - wthl[j];
+      std::copy(z, z+n, p); p += n;
+      z[j]    = ctr[j] + wthl[j];
+      std::copy(z, z+n, p); p += n;
+      z[j]    = ctr[j];
+   }
+
+   // the 2n(n-1) diagonal nodes (all sign combinations of coordinate pairs)
+   for (j=1; j<n; j++) {
+      j1 = j-1;
+      for (k=j; k<n; k++) {
+         for (l=0; l<2; l++) {
+            wthl[j1] = -wthl[j1];
+            z[j1]    = ctr[j1] + wthl[j1];
+            for (m=0; m<2; m++) {
+               wthl[k] = -wthl[k];
+               z[k]    = ctr[k] + wthl[k];
+               std::copy(z, z+n, p); p += n;
+            }
+         }
+         z[k] = ctr[k];
+      }
+      z[j1] = ctr[j1];
+   }
+
+   // the 2^n corner nodes (lambda_5), walked gray-code style
+   for (j=0; j<n; j++) {
+      wthl[j] = -xl5*wth[j];
+      z[j] = ctr[j] + wthl[j];
+   }
+   for (;;) {
+      std::copy(z, z+n, p); p += n;
+      bool more = false;
+      for (j=0; j<n; j++) {
+         wthl[j] = -wthl[j];
+         z[j] = ctr[j] + wthl[j];
+         if (wthl[j] > 0) { more = true; break; }
+      }
+      if (!more) break;
+   }
+
+   // evaluate the integrand on all nodes in a single batch call
+   unsigned int i;
+   if (fBatchFun)
+      fBatchFun(npts, &fRulePoints[0], &fRuleValues[0]);
+   else
+      for (i=0; i<npts; i++) fRuleValues[i] = (*fFun)(&fRulePoints[i*n]);
+   // the serial algorithm takes the absolute value of every node except the
+   // center - keep that behaviour
+   if (absVal)
+      for (i=1; i<npts; i++) fRuleValues[i] = std::abs(fRuleValues[i]);
+
+   // build the weighted sums from the node values
+   const double *v = &fRuleValues[0];
+   double sum1 = v[0];
+   double sum2 = 0, sum3 = 0, difmax = 0;
+   unsigned int idx = 1;
+   for (j=0; j<n; j++) {
+      double f2 = v[idx] + v[idx+1];
+      double f3 = v[idx+2] + v[idx+3];
+      idx += 4;
+      sum2 += f2;//sum func eval with different weights separately
+      sum3 += f3;//for a given region
+      double dif = std::abs(7*f2-f3-12*sum1);
+      //storing dimension with biggest error/difference (?)
+      if (dif >= difmax) {
+         difmax = dif;
+         idvaxn = j+1;
+      }
+   }
+   double sum4 = 0;
+   for (i=0; i<2*n*(n-1); i++) sum4 += v[idx++];
+   double sum5 = 0;
+   while (idx < npts) sum5 += v[idx++];
+
+   double rgncmp = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
+   rgnval  = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
+   rgnval *= rgnvol;
+   rgnerr  = std::abs(rgnval-rgncmp);//compares estim error with expected error
+
+   sums[0] = sum1;
+   sums[1] = sum2;
+   sums[2] = sum3;
+   sums[3] = sum4;
+   sums[4] = sum5;
+}
+
+
+void AdaptiveIntegratorMultiDim::SetAbsTolerance(double absTol){ this->fAbsTol = absTol; }
+
+
+double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double * xmax, bool absValue)
+{
+   // References:
+   //
+   //   1.A.C. Genz and A.A. Malik, Remarks on algorithm 006:
+   //     An adaptive algorithm for numerical integration over
+   //     an N-dimensional rectangular region, J. Comput. Appl. Math. 6 (1980) 295-302.
+   //   2.A. van Doren and L. de Ridder, An adaptive algorithm for numerical
+   //     integration over an n-dimensional cube, J.Comput. Appl. Math. 2 (1976) 207-217.
+
+   //to be changed later
+   unsigned int n=fDim;
+   bool kFALSE = false;
+   bool kTRUE = true;
+
+   double epsrel = fRelTol; //specified relative accuracy
+   double epsabs = fAbsTol; //specified relative accuracy
+   //output parameters
+   fStatus = 0; //report status
+   unsigned int nfnevl; //nr of function evaluations
+   double relerr; //an estimation of the relative accuracy of the result
+
+
+   double ctr[15], wth[15];
+
    double result = 0;
    double abserr = 0;
    fStatus  = 3;
@@ -177,92 +296,24 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
       wth[j] = (xmax[j] - xmin[j])*0.5;//its width
    }
 
-   double rgnvol, sum1, sum2, sum3, sum4, sum5, difmax, f2, f3, dif, aresult;
-   double rgncmp=0, rgnval, rgnerr;
-
-   unsigned int j1, k, l, m, idvaxn=0, idvax0=0, isbtmp, isbtpp;
+   double rgnvol, sum1, sum2, sum3, sum4, sum5, aresult;
+   double rgnval, rgnerr;
+   double sums[5];
 
-   //InitArgs(z,fParams);
+   unsigned int k, idvaxn=0, idvax0=0, isbtmp, isbtpp;
 
 L20:
    rgnvol = twondm;//=2^n
    for (j=0; j<n; j++) {
       rgnvol *= wth[j]; //region volume
-      z[j]    = ctr[j]; //temporary node
-   }
-   sum1 = (*fFun)((const double*)z);//EvalPar(z,fParams); //evaluate function
-
-   difmax = 0;
-   sum2   = 0;
-   sum3   = 0;
-
-   //loop over coordinates
-   for (j=0; j<n; j++) {
-      z[j]    = ctr[j] - xl2*wth[j];
-      if (absValue) f2 = std::abs((*fFun)(z));
-      else          f2 = (*fFun)(z);
-      z[j]    = ctr[j] + xl2*wth[j];
-      if (absValue) f2 += std::abs((*fFun)(z));
-      else          f2 += (*fFun)(z);
-      wthl[j] = xl4*wth[j];
-      z[j]    = ctr[j] - wthl[j];
-      if (absValue) f3 = std::abs((*fFun)(z));
-      else          f3 = (*fFun)(z);
-      z[j]    = ctr[j] + wthl[j];
-      if (absValue) f3 += std::abs((*fFun)(z));
-      else          f3 += (*fFun)(z);
-      sum2   += f2;//sum func eval with different weights separately
-      sum3   += f3;//for a given region
-      dif     = std::abs(7*f2-f3-12*sum1);
-      //storing dimension with biggest error/difference (?)
-      if (dif >= difmax) {
-         difmax=dif;
-         idvaxn=j+1;
-      }
-      z[j]    = ctr[j];
-   }
-
-   sum4 = 0;
-   for (j=1;j<n;j++) {
-      j1 = j-1;
-      for (k=j;k<n;k++) {
-         for (l=0;l<2;l++) {
-            wthl[j1] = -wthl[j1];
-            z[j1]    = ctr[j1] + wthl[j1];
-            for (m=0;m<2;m++) {
-               wthl[k] = -wthl[k];
-               z[k]    = ctr[k] + wthl[k];
-               if (absValue) sum4 += std::abs((*fFun)(z));
-               else            sum4 += (*fFun)(z);
-            }
-         }
-         z[k] = ctr[k];
-      }
-      z[j1] = ctr[j1];
    }
-
-   sum5 = 0;
-
-   for (j=0;j<n;j++) {
-      wthl[j] = -xl5*wth[j];
-      z[j] = ctr[j] + wthl[j];
-   }
-L90: //sum over end nodes ~gray codes
-   if (absValue) sum5 += std::abs((*fFun)(z));
-   else          sum5 += (*fFun)(z);
-   for (j=0;j<n;j++) {
-      wthl[j] = -wthl[j];
-      z[j] = ctr[j] + wthl[j];
-      if (wthl[j] > 0) goto L90;
-   }
-
-   rgncmp  = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
-   rgnval  = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
-   rgnval *= rgnvol;
-   // avoid difference of too small numbers
-   //rgnval = 1.0E-30;
-   //rgnerr  = TMath::Max( std::abs(rgnval-rgncmp), TMath::Max(std::abs(rgncmp), std::abs(rgnval) )*4.0E-16 );
-   rgnerr  = std::abs(rgnval-rgncmp);//compares estim error with expected error
+   // evaluate the rule on all nodes of the region in one batch
+   EvalRule(n, ctr, wth, rgnvol, absValue, sums, rgnval, rgnerr, idvaxn);
+   sum1 = sums[0];
+   sum2 = sums[1];
+   sum3 = sums[2];
+   sum4 = sums[3];
+   sum5 = sums[4];
 
    result += rgnval;
    abserr += rgnerr;
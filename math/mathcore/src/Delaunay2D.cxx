@@ -23,6 +23,7 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <stdlib.h>
 
 namespace ROOT {
@@ -99,6 +100,45 @@ void Delaunay2D::SetInputPoints(int n, const double * x, const double * y, const
 #endif
 }
 
+/// append the points [NPoints, n) of the given arrays to the triangulation;
+/// the arrays must also contain the previous points, since the caller may
+/// have reallocated its storage
+void Delaunay2D::AppendPoints(int n, const double * x, const double * y, const double * z) {
+
+   if (n <= fNpoints || !x || !y || !z) {
+      // no new points; still adopt the (possibly reallocated) arrays
+      if (n == fNpoints && x && y && z) { fX = x; fY = y; fZ = z; }
+      return;
+   }
+
+#if defined(HAS_CGAL) || defined(THREAD_SAFE)
+   // incremental insertion is not implemented for these configurations
+   // (it would race with concurrent interpolation in the THREAD_SAFE case):
+   // re-triangulate everything on the next use
+   fX = x; fY = y; fZ = z;
+   fNpoints = n;
+   SetInputPoints(n, x, y, z);
+#else
+   const Int_t nold = fNpoints;
+   fX = x; fY = y; fZ = z;
+   fNpoints = n;
+
+   if (!fInit) return; // the new points are picked up by the initial build
+
+   bool inserted = true;
+   for (Int_t ip = nold; ip < n && inserted; ++ip) {
+      inserted = DoInsertPoint(ip);
+   }
+   if (inserted) {
+      fNdt = fTriangles.size();
+      return;
+   }
+   // a point fell outside the current grid or convex hull:
+   // re-triangulate everything (with a recomputed bounding box) on the next use
+   SetInputPoints(n, x, y, z);
+#endif
+}
+
 //______________________________________________________________________________
 double Delaunay2D::Interpolate(double x, double y)
 {
@@ -171,6 +211,7 @@ void Delaunay2D::FindAllTriangles()
 #ifdef HAS_CGAL
 /// CGAL implementation of normalize points
 void Delaunay2D::DonormalizePoints() {
+   fNormalizedPoints.clear();
    for (Int_t n = 0; n < fNpoints; n++) {
       //Point p(xTransformer(fX[n]), yTransformer(fY[n]));
       Point p(linear_transform(fX[n], fOffsetX, fScaleFactorX),
@@ -182,6 +223,8 @@ void Delaunay2D::DonormalizePoints() {
 
 /// CGAL implementation for finding triangles 
 void Delaunay2D::DoFindTriangles() {
+   fTriangles.clear();
+   fCGALdelaunay.clear();
    fCGALdelaunay.insert(fNormalizedPoints.begin(), fNormalizedPoints.end());
 
    std::transform(fCGALdelaunay.finite_faces_begin(),
@@ -241,11 +284,21 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
 
 /// Triangle implementation for normalizing the points
 void Delaunay2D::DoNormalizePoints() {
+   fXN.clear();
+   fYN.clear();
+   fXN.reserve(fNpoints);
+   fYN.reserve(fNpoints);
    for (Int_t n = 0; n < fNpoints; n++) {
       fXN.push_back(Linear_transform(fX[n], fOffsetX, fScaleFactorX));
       fYN.push_back(Linear_transform(fY[n], fOffsetY, fScaleFactorY));
    }
 
+   // size the localisation grid with the number of points: a triangulation of
+   // n points has about 2n triangles, so ~sqrt(n) cells per dimension keep
+   // the triangles-per-cell count roughly constant whatever the graph size
+   fNCells = std::max(25, std::min(1024, (int) std::sqrt((double) fNpoints)));
+   fCells.assign((fNCells + 1) * (fNCells + 1), std::vector<UInt_t>());
+
    //also initialize fXCellStep and FYCellStep
    fXCellStep = fNCells / (fXNmax - fXNmin);
    fYCellStep = fNCells / (fYNmax - fYNmin);
@@ -307,6 +360,8 @@ void Delaunay2D::DoFindTriangles() {
       if(s.normlist != nullptr) free(s.normlist);             /* Used only with Voronoi diagram; out only */
    };
 
+   fTriangles.clear();
+
    struct triangulateio in, out;
    initStruct(in); initStruct(out);
 
@@ -363,7 +418,8 @@ void Delaunay2D::DoFindTriangles() {
       for(unsigned int i = cellXmin; i <= cellXmax; ++i) {
          for(unsigned int j = cellYmin; j <= cellYmax; ++j) {
             //printf("(%u,%u) = %u\n", i, j, Cell(i,j));
-            fCells[Cell(i,j)].insert(t);
+            // each (triangle, cell) pair occurs only once, no need for a set
+            fCells[Cell(i,j)].push_back(t);
          }
       }
    }
@@ -371,6 +427,98 @@ void Delaunay2D::DoFindTriangles() {
    freeStruct(in); freeStruct(out);
 }
 
+/// Triangle implementation for inserting one appended point into the
+/// existing triangulation. The containing triangle is located through the
+/// cell grid and split into the (up to) three triangles formed by its edges
+/// and the new point. The result is a valid piecewise linear interpolation
+/// support that is exact at every input point, although the split triangles
+/// are not re-checked against the Delaunay criterion (no edge flips): for
+/// the live append use case this trades a slightly less regular mesh for
+/// not re-triangulating on every new point.
+bool Delaunay2D::DoInsertPoint(UInt_t ip) {
+
+   const double xx = Linear_transform(fX[ip], fOffsetX, fScaleFactorX);
+   const double yy = Linear_transform(fY[ip], fOffsetY, fScaleFactorY);
+
+   const int cX = CellX(xx);
+   const int cY = CellY(yy);
+   if (cX < 0 || cX > fNCells || cY < 0 || cY > fNCells)
+      return false; // outside the normalized bounding box
+
+   fXN.push_back(xx);
+   fYN.push_back(yy);
+
+   // locate the containing triangle, same barycentric test as the interpolation
+   int found = -1;
+   for (unsigned int t : fCells[Cell(cX, cY)]) {
+      const Triangle &tr = fTriangles[t];
+      double la = ( (tr.y[1] - tr.y[2])*(xx - tr.x[2])
+                   + (tr.x[2] - tr.x[1])*(yy - tr.y[2]) ) * tr.invDenom;
+      double lb = ( (tr.y[2] - tr.y[0])*(xx - tr.x[2])
+                   + (tr.x[0] - tr.x[2])*(yy - tr.y[2]) ) * tr.invDenom;
+      if (la >= 0 && lb >= 0 && (1 - la - lb) >= 0) {
+         found = t;
+         break;
+      }
+   }
+   if (found < 0)
+      return false; // outside the convex hull
+
+   const Triangle told = fTriangles[found];
+
+   auto addToCells = [&] (const Triangle & tr, UInt_t t) {
+      auto bx = std::minmax({tr.x[0], tr.x[1], tr.x[2]});
+      auto by = std::minmax({tr.y[0], tr.y[1], tr.y[2]});
+      for (int i = CellX(bx.first); i <= CellX(bx.second); ++i)
+         for (int j = CellY(by.first); j <= CellY(by.second); ++j)
+            fCells[Cell(i, j)].push_back(t);
+   };
+
+   // remove the split triangle from the cells covering its bounding box
+   {
+      auto bx = std::minmax({told.x[0], told.x[1], told.x[2]});
+      auto by = std::minmax({told.y[0], told.y[1], told.y[2]});
+      for (int i = CellX(bx.first); i <= CellX(bx.second); ++i) {
+         for (int j = CellY(by.first); j <= CellY(by.second); ++j) {
+            std::vector<UInt_t> &cell = fCells[Cell(i, j)];
+            cell.erase(std::remove(cell.begin(), cell.end(), (UInt_t)found), cell.end());
+         }
+      }
+   }
+
+   // build the sub-triangles (one edge of the old triangle plus the new
+   // point), skipping degenerate ones (the new point sitting exactly on an
+   // edge or on a vertex); the first one reuses the slot of the old triangle
+   bool replaced = false;
+   for (int e = 0; e < 3; ++e) {
+      Triangle tr;
+      tr.x[0] = told.x[e];           tr.y[0] = told.y[e];           tr.idx[0] = told.idx[e];
+      tr.x[1] = told.x[(e + 1) % 3]; tr.y[1] = told.y[(e + 1) % 3]; tr.idx[1] = told.idx[(e + 1) % 3];
+      tr.x[2] = xx;                  tr.y[2] = yy;                  tr.idx[2] = ip;
+
+      const double denom = (tr.y[1] - tr.y[2])*(tr.x[0] - tr.x[2])
+                         + (tr.x[2] - tr.x[1])*(tr.y[0] - tr.y[2]);
+      if (std::abs(denom) < 1e-14) continue; // degenerate sub-triangle
+      tr.invDenom = 1. / denom;
+
+      UInt_t tnew;
+      if (!replaced) {
+         tnew = found;
+         fTriangles[found] = tr;
+         replaced = true;
+      } else {
+         tnew = fTriangles.size();
+         fTriangles.push_back(tr);
+      }
+      addToCells(tr, tnew);
+   }
+   if (!replaced) {
+      // the new point coincides with a vertex of the triangle: keep it
+      addToCells(told, found);
+   }
+   return true;
+}
+
 /// Triangle implementation for interpolation
 /// Finds the Delaunay triangle that the point (xi,yi) sits in (if any) and
 /// calculate a z-value for it by linearly interpolating the z-values that
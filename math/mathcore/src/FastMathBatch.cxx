@@ -0,0 +1,318 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Implementation of the batch transcendental functions, see the header
+// for the accuracy tiers. The kernels are plain element loops: the fast
+// and approximate tiers are branch-free in their main path so that the
+// compiler vectorizes them, and on x86-64 ELF with gcc each kernel is
+// cloned for avx2/avx512f with the variant picked at load time.
+
+#include "Math/FastMathBatch.h"
+
+#include "RConfigure.h"
+
+#ifdef R__HAS_VDT
+#include "vdt/exp.h"
+#include "vdt/log.h"
+#include "vdt/sin.h"
+#include "vdt/atan2.h"
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// multi-versioned kernels: the dynamic loader resolves the best clone for
+// the running CPU through an ifunc, which needs gcc >= 6 on x86-64 ELF
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6 && defined(__x86_64__) && defined(__ELF__)
+#define ROOT_MATH_BATCH_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define ROOT_MATH_BATCH_CLONES
+#endif
+
+namespace {
+
+   inline double BitsToDouble(uint64_t bits)
+   {
+      double d;
+      std::memcpy(&d, &bits, sizeof(d));
+      return d;
+   }
+
+   inline uint64_t DoubleToBits(double d)
+   {
+      uint64_t bits;
+      std::memcpy(&bits, &d, sizeof(bits));
+      return bits;
+   }
+
+   // ~ 1e-6 relative: exp(x) = 2^k * e^r with r = x - k*ln2, |r| <= ln2/2,
+   // e^r from the degree-6 Taylor polynomial, 2^k assembled in the exponent
+   // bits. Out-of-range arguments overflow/underflow like libm.
+   inline double ApproxExp(double x)
+   {
+      if (!(x > -708.0)) return (x != x) ? x : 0.0;     // also catches NaN
+      if (x > 709.0) return std::numeric_limits<double>::infinity();
+      const double log2e  = 1.4426950408889634074;
+      const double ln2hi  = 6.93147180369123816490e-01;
+      const double ln2lo  = 1.90821492927058770002e-10;
+      double kd = std::floor(x*log2e + 0.5);
+      int64_t k = (int64_t)kd;
+      double r = (x - kd*ln2hi) - kd*ln2lo;
+      double p = 1.0 + r*(1.0 + r*(0.5 + r*(1.0/6.0 + r*(1.0/24.0 + r*(1.0/120.0 + r/720.0)))));
+      // scale by 2^k; |k| < 1075 here, split to stay inside the exponent range
+      int64_t k1 = k/2;
+      int64_t k2 = k - k1;
+      return p * BitsToDouble((uint64_t)(k1 + 1023) << 52) * BitsToDouble((uint64_t)(k2 + 1023) << 52);
+   }
+
+   // ~ 1e-7 relative: x = 2^e * m with m in [sqrt(1/2), sqrt(2)), log(m)
+   // from the atanh series in t = (m-1)/(m+1), |t| < 0.1716
+   inline double ApproxLog(double x)
+   {
+      if (!(x > 0.0) || x == std::numeric_limits<double>::infinity())
+         return std::log(x);                             // 0, negative, inf, NaN, like libm
+      uint64_t bits = DoubleToBits(x);
+      int64_t ebias = 0;
+      if (bits < ((uint64_t)1 << 52)) {                  // subnormal: rescale
+         bits = DoubleToBits(x * 9007199254740992.0);    // 2^53
+         ebias = 53;
+      }
+      int64_t e = (int64_t)(bits >> 52) - 1023 - ebias;
+      double m = BitsToDouble((bits & 0x000fffffffffffffULL) | ((uint64_t)1023 << 52));
+      if (m > 1.4142135623730951) { m *= 0.5; ++e; }
+      double t  = (m - 1.0)/(m + 1.0);
+      double t2 = t*t;
+      double lm = 2.0*t*(1.0 + t2*(1.0/3.0 + t2*(1.0/5.0 + t2*(1.0/7.0 + t2/9.0))));
+      return lm + (double)e*0.69314718055994530942;
+   }
+
+   // ~ 1e-7 absolute on each period: reduce to r = x - k*pi, |r| <= pi/2,
+   // odd Taylor polynomial to r^11, sign from the parity of k
+   inline double ApproxSin(double x)
+   {
+      // the two-part pi reduction holds the ~1e-6 accuracy up to ~1e6 only;
+      // huge arguments need the full payne-hanek reduction, leave them to libm
+      if (!(std::fabs(x) < 1.0e6)) return std::sin(x);   // also inf and NaN
+      const double invpi = 0.31830988618379067154;
+      const double pihi  = 3.14159265358979311600;
+      const double pilo  = 1.22464679914735320717e-16;
+      double kd = std::floor(x*invpi + 0.5);
+      double r  = (x - kd*pihi) - kd*pilo;
+      double r2 = r*r;
+      double p  = r*(1.0 + r2*(-1.0/6.0 + r2*(1.0/120.0 + r2*(-1.0/5040.0 + r2*(1.0/362880.0 - r2/39916800.0)))));
+      // kd is integral; odd multiples of pi flip the sign
+      double flip = kd - 2.0*std::floor(kd*0.5);         // 0 or 1
+      return (1.0 - 2.0*flip)*p;
+   }
+
+   // ~ 1e-6 absolute: octant reduction to |t| <= tan(pi/8), odd Taylor
+   // polynomial to t^11, then the usual atan2 quadrant fix-up
+   inline double ApproxAtan2(double y, double x)
+   {
+      if (x == 0.0 || y == 0.0 || y != y || x != x ||
+          std::fabs(y) == std::numeric_limits<double>::infinity() ||
+          std::fabs(x) == std::numeric_limits<double>::infinity())
+         return std::atan2(y, x);                        // axes and specials, like libm
+      const double pi     = 3.14159265358979323846;
+      const double pihalf = 1.57079632679489661923;
+      double ax = std::fabs(y/x);
+      double base = 0.0;
+      double z = ax;
+      if (ax > 1.0) { z = 1.0/ax; base = pihalf; }       // atan(ax) = pi/2 - atan(1/ax)
+      double extra = 0.0;
+      if (z > 0.41421356237309503) {                     // tan(pi/8)
+         z = (z - 1.0)/(z + 1.0);
+         extra = 0.78539816339744830962;                 // pi/4
+      }
+      double z2 = z*z;
+      double a = z*(1.0 + z2*(-1.0/3.0 + z2*(1.0/5.0 + z2*(-1.0/7.0 + z2*(1.0/9.0 - z2/11.0)))));
+      a += extra;
+      if (base != 0.0) a = base - a;
+      if (x < 0.0) a = pi - a;
+      return (y < 0.0) ? -a : a;
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void ExpExactKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = std::exp(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void LogExactKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = std::log(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void SinExactKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = std::sin(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void Atan2ExactKernel(const double *y, const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = std::atan2(y[i], x[i]);
+   }
+
+#ifdef R__HAS_VDT
+   ROOT_MATH_BATCH_CLONES
+   void ExpFastKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = vdt::fast_exp(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void LogFastKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = vdt::fast_log(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void SinFastKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = vdt::fast_sin(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void Atan2FastKernel(const double *y, const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = vdt::fast_atan2(y[i], x[i]);
+   }
+#endif
+
+   ROOT_MATH_BATCH_CLONES
+   void ExpApproxKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = ApproxExp(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void LogApproxKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = ApproxLog(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void SinApproxKernel(const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = ApproxSin(x[i]);
+   }
+
+   ROOT_MATH_BATCH_CLONES
+   void Atan2ApproxKernel(const double *y, const double *x, double *out, int n)
+   {
+      for (int i = 0; i < n; ++i) out[i] = ApproxAtan2(y[i], x[i]);
+   }
+
+}
+
+namespace ROOT {
+namespace Math {
+namespace FastMath {
+
+void Exp(const double *x, double *out, int n, EAccuracy tier)
+{
+   switch (tier) {
+   case kApprox: ExpApproxKernel(x, out, n); break;
+#ifdef R__HAS_VDT
+   case kFast:   ExpFastKernel(x, out, n); break;
+#else
+   case kFast:   // without vdt the fast tier is the exact one
+#endif
+   default:      ExpExactKernel(x, out, n); break;
+   }
+}
+
+void Log(const double *x, double *out, int n, EAccuracy tier)
+{
+   switch (tier) {
+   case kApprox: LogApproxKernel(x, out, n); break;
+#ifdef R__HAS_VDT
+   case kFast:   LogFastKernel(x, out, n); break;
+#else
+   case kFast:
+#endif
+   default:      LogExactKernel(x, out, n); break;
+   }
+}
+
+void Sin(const double *x, double *out, int n, EAccuracy tier)
+{
+   switch (tier) {
+   case kApprox: SinApproxKernel(x, out, n); break;
+#ifdef R__HAS_VDT
+   case kFast:   SinFastKernel(x, out, n); break;
+#else
+   case kFast:
+#endif
+   default:      SinExactKernel(x, out, n); break;
+   }
+}
+
+void Atan2(const double *y, const double *x, double *out, int n, EAccuracy tier)
+{
+   switch (tier) {
+   case kApprox: Atan2ApproxKernel(y, x, out, n); break;
+#ifdef R__HAS_VDT
+   case kFast:   Atan2FastKernel(y, x, out, n); break;
+#else
+   case kFast:
+#endif
+   default:      Atan2ExactKernel(y, x, out, n); break;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Pseudorapidity from cylindrical rho and z over spans. The element
+/// formula is the one of ROOT::Math::Impl::Eta_FromRhoZ, including the
+/// Taylor correction for |z/rho| beyond eps^-0.25 and the etaMax
+/// saturation at rho == 0; only the logarithm is evaluated through the
+/// selected tier, in one batch for the whole span.
+
+void EtaFromRhoZ(const double *rho, const double *z, double *out, int n, EAccuracy tier)
+{
+   // value to control the Taylor expansion of the sqrt, as in Eta_FromRhoZ
+   static const double big_z_scaled = std::pow(std::numeric_limits<double>::epsilon(), -0.25);
+   // the constant of GenVector/etaMax.h
+   static const double etaMax = 22756.0;
+
+   // eta = sign * log(arg) + add per element; the no-log cases use arg = 1
+   std::vector<double> arg((size_t)n), sign((size_t)n), add((size_t)n);
+   for (int i = 0; i < n; ++i) {
+      sign[i] = 1.0;
+      add[i]  = 0.0;
+      if (rho[i] > 0) {
+         double z_scaled = z[i]/rho[i];
+         if (std::fabs(z_scaled) < big_z_scaled) {
+            arg[i] = z_scaled + std::sqrt(z_scaled*z_scaled + 1.0);
+         } else if (z[i] > 0) {
+            arg[i] = 2.0*z_scaled + 0.5/z_scaled;
+         } else {
+            arg[i]  = -2.0*z_scaled;
+            sign[i] = -1.0;
+         }
+      } else {
+         arg[i]  = 1.0;
+         sign[i] = 0.0;
+         if (z[i] > 0)      add[i] = z[i] + etaMax;
+         else if (z[i] < 0) add[i] = z[i] - etaMax;
+      }
+   }
+   Log(&arg[0], &arg[0], n, tier);
+   for (int i = 0; i < n; ++i) out[i] = sign[i]*arg[i] + add[i];
+}
+
+}  // end namespace FastMath
+}  // end namespace Math
+}  // end namespace ROOT
@@ -34,6 +34,15 @@
 #include <algorithm>
 //#include <memory>
 
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include <array>
+#endif
+
 //#define DEBUG
 #ifdef DEBUG
 #define NSAMPLE 10
@@ -327,6 +336,36 @@ namespace ROOT {
 
 
 
+#ifdef R__USE_IMT
+         // Kahan compensated accumulator used for the per-chunk partial sums of the
+         // parallelized objective functions. Without the compensation the result of a
+         // multi-threaded evaluation would depend on the number of chunks (and would
+         // differ from the serial one by more than the double rounding error),
+         // confusing Minuit when the number of threads changes between calls.
+         class KahanSum {
+         public:
+            void Add(double x) {
+               double y = x - fCorrection;
+               double t = fSum + y;
+               fCorrection = (t - fSum) - y;
+               fSum = t;
+            }
+            double Sum() const { return fSum; }
+         private:
+            double fSum = 0;
+            double fCorrection = 0;
+         };
+
+         // number of chunks used to split the data range among the threads of the
+         // implicit MT pool; use several chunks per thread to even out the load
+         unsigned int NChunks(unsigned int ndata) {
+            unsigned int nchunks = 8 * ROOT::GetImplicitMTPoolSize();
+            if (nchunks > ndata) nchunks = ndata;
+            if (nchunks < 1) nchunks = 1;
+            return nchunks;
+         }
+#endif
+
       } // end namespace  FitUtil
 
 
@@ -381,6 +420,45 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
    }
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
+
+#ifdef R__USE_IMT
+   // Parallel evaluation of the residual sum. It is restricted to the simple (and by
+   // far most frequent) configuration where the per-point work only reads shared state:
+   // no bin integral or bin volume normalization (the cached integral evaluator is not
+   // thread safe) and data copied inside BinData (the external data wrapper fills a
+   // shared coordinate buffer on every access).
+   if (ROOT::IsImplicitMTEnabled() && n > 0 && data.DataSize() > 0 &&
+       !useBinIntegral && !useBinVolume && !useExpErrors) {
+
+      unsigned int nchunks = FitUtil::NChunks(n);
+      auto mapFunction = [&](unsigned int ichunk) {
+         FitUtil::KahanSum sum;
+         unsigned int istart = ichunk * n / nchunks;
+         unsigned int iend = (ichunk + 1) * n / nchunks;
+         for (unsigned int i = istart; i < iend; ++i) {
+            double y = 0, invError = 1.;
+            const double * x = data.GetPoint(i, y, invError);
+            double fval = func ( x );
+            if (invError > 0) {
+               double tmp = ( y - fval ) * invError;
+               double resval = tmp * tmp;
+               // avoid infinity or nan in chi2 values due to wrong function values
+               sum.Add( (resval < maxResValue) ? resval : maxResValue );
+            }
+         }
+         return sum.Sum();
+      };
+
+      ROOT::TThreadExecutor pool;
+      auto partialSums = pool.Map(mapFunction, ROOT::TSeqU(nchunks));
+      FitUtil::KahanSum total;
+      for (auto & partial : partialSums) total.Add(partial);
+
+      nPoints = n;
+      return total.Sum();
+   }
+#endif
+
    for (unsigned int i = 0; i < n; ++ i) {
 
       double y = 0, invError = 1.;
@@ -940,6 +1018,59 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
    double sumW = 0;
    double sumW2 = 0;
 
+#ifdef R__USE_IMT
+   // Parallel evaluation of the log-likelihood sum with per-chunk compensated partial
+   // sums. As for the chi2 case it requires the data to be copied inside UnBinData,
+   // since the external data wrapper fills a shared coordinate buffer on every access.
+   if (ROOT::IsImplicitMTEnabled() && n > 0 && data.DataSize() > 0 && !normalizeFunc) {
+
+      unsigned int nchunks = FitUtil::NChunks(n);
+      auto mapFunction = [&](unsigned int ichunk) {
+         // partial sums of the chunk : logl, sum of weights, sum of weight square
+         FitUtil::KahanSum sumL, sW, sW2;
+         unsigned int istart = ichunk * n / nchunks;
+         unsigned int iend = (ichunk + 1) * n / nchunks;
+         for (unsigned int i = istart; i < iend; ++i) {
+            const double * x = data.Coords(i);
+#ifdef USE_PARAMCACHE
+            double fval = func ( x );
+#else
+            double fval = func ( x, p );
+#endif
+            // function EvalLog protects against negative or too small values of fval
+            double logval =  ROOT::Math::Util::EvalLog( fval);
+            if (iWeight > 0) {
+               double weight = data.Weight(i);
+               logval *= weight;
+               if (iWeight ==2) {
+                  logval *= weight; // use square of weights in likelihood
+                  if (extended) {
+                     // needed sum of weights and sum of weight square if likelkihood is extended
+                     sW.Add(weight);
+                     sW2.Add(weight*weight);
+                  }
+               }
+            }
+            sumL.Add(logval);
+         }
+         return std::array<double,3>{{sumL.Sum(), sW.Sum(), sW2.Sum()}};
+      };
+
+      ROOT::TThreadExecutor pool;
+      auto partialSums = pool.Map(mapFunction, ROOT::TSeqU(nchunks));
+      FitUtil::KahanSum totL, totW, totW2;
+      for (auto & partial : partialSums) {
+         totL.Add(partial[0]);
+         totW.Add(partial[1]);
+         totW2.Add(partial[2]);
+      }
+      logl = totL.Sum();
+      sumW = totW.Sum();
+      sumW2 = totW2.Sum();
+   }
+   else
+#endif
+
    for (unsigned int i = 0; i < n; ++ i) {
       const double * x = data.Coords(i);
 #ifdef USE_PARAMCACHE
@@ -1265,6 +1396,62 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    // double wTot = 0; // sum of all weights
    // double w2Tot = 0; // sum of weight squared  (these are needed for useW2)
 
+#ifdef R__USE_IMT
+   // Parallel evaluation of the Poisson log-likelihood sum, with the same restrictions
+   // as for the chi2 case : no bin integral or bin volume normalization and data copied
+   // inside BinData (see EvaluateChi2).
+   if (ROOT::IsImplicitMTEnabled() && n > 0 && data.DataSize() > 0 &&
+       !useBinIntegral && !useBinVolume) {
+
+      unsigned int nchunks = FitUtil::NChunks(n);
+      auto mapFunction = [&](unsigned int ichunk) {
+         FitUtil::KahanSum sum;
+         unsigned int np = 0; // non-zero bins of the chunk
+         unsigned int istart = ichunk * n / nchunks;
+         unsigned int iend = (ichunk + 1) * n / nchunks;
+         for (unsigned int i = istart; i < iend; ++i) {
+            const double * x = data.Coords(i);
+            double y = data.Value(i);
+#ifdef USE_PARAMCACHE
+            double fval = func ( x );
+#else
+            double fval = func ( x, p );
+#endif
+            // EvalLog protects against 0 values of fval but don't want to add in the -log sum
+            // negative values of fval
+            fval = std::max(fval, 0.0);
+
+            double tmp = 0;
+            if (useW2) {
+               if (y != 0) {
+                  double error = data.Error(i);
+                  double weight = (error*error)/y;  // this is the bin effective weight
+                  if (extended) tmp = fval * weight;
+                  tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
+               }
+            }
+            else {
+               if (extended) tmp = fval -y ;
+               if (y >  0) {
+                  tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));
+                  np++;
+               }
+            }
+            sum.Add(tmp);
+         }
+         return std::make_pair(sum.Sum(), np);
+      };
+
+      ROOT::TThreadExecutor pool;
+      auto partialSums = pool.Map(mapFunction, ROOT::TSeqU(nchunks));
+      FitUtil::KahanSum total;
+      for (auto & partial : partialSums) {
+         total.Add(partial.first);
+         nPoints += partial.second;
+      }
+      return total.Sum();
+   }
+#endif
 
    for (unsigned int i = 0; i < n; ++ i) {
       const double * x1 = data.Coords(i);
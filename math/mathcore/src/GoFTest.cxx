@@ -16,6 +16,7 @@
 #include <numeric>
 #include <string.h>
 #include <cassert>
+#include <thread>
 
 #include "Math/Error.h"
 #include "Math/Math.h"
@@ -132,7 +133,8 @@ namespace Math {
    GoFTest::GoFTest( UInt_t sample1Size, const Double_t* sample1, UInt_t sample2Size, const Double_t* sample2 )
    : fDist(kUndefined),
      fSamples(std::vector<std::vector<Double_t> >(2)),
-     fTestSampleFromH0(kFALSE) {
+     fTestSampleFromH0(kFALSE),
+     fBinned(kFALSE) {
       Bool_t badSampleArg = sample1 == 0 || sample1Size == 0;
       if (badSampleArg) {
          std::string msg = "'sample1";
@@ -160,7 +162,8 @@ namespace Math {
    GoFTest::GoFTest(UInt_t sampleSize, const Double_t* sample, EDistribution dist)
    : fDist(dist),
      fSamples(std::vector<std::vector<Double_t> >(1)),
-     fTestSampleFromH0(kTRUE) {
+     fTestSampleFromH0(kTRUE),
+     fBinned(kFALSE) {
       Bool_t badSampleArg = sample == 0 || sampleSize == 0;
       if (badSampleArg) {
          std::string msg = "'sample";
@@ -177,18 +180,110 @@ namespace Math {
 
    GoFTest::~GoFTest() {}
 
+   UInt_t GoFTest::fgAutoBinThreshold = 0;
+   UInt_t GoFTest::fgAutoBinBins = 1000;
+
+   void GoFTest::SetAutoBinning(UInt_t sampleSizeThreshold, UInt_t nbins) {
+      if (sampleSizeThreshold > 0 && nbins < 2) {
+         MATH_ERROR_MSG("SetAutoBinning", "Number of bins must be at least 2 - binned mode not enabled");
+         return;
+      }
+      fgAutoBinThreshold = sampleSizeThreshold;
+      fgAutoBinBins = nbins;
+   }
+
+   // sort a sample in parallel chunks and merge them; std::sort is single
+   // threaded and dominates the set-up cost of the tests for multi-million
+   // point samples
+   static void SortSample(std::vector<Double_t> & v) {
+      static const std::size_t minSizeForThreads = 500000;
+      std::size_t nthreads = std::thread::hardware_concurrency();
+      if (v.size() < minSizeForThreads || nthreads < 2) {
+         std::sort(v.begin(), v.end());
+         return;
+      }
+      if (nthreads > 8) nthreads = 8;
+      std::vector<std::size_t> bounds(nthreads + 1);
+      for (std::size_t i = 0; i <= nthreads; ++i)
+         bounds[i] = (v.size() * i) / nthreads;
+      // sort the chunks in parallel
+      std::vector<std::thread> workers;
+      workers.reserve(nthreads);
+      for (std::size_t i = 0; i < nthreads; ++i)
+         workers.emplace_back([&v, &bounds, i]() {
+            std::sort(v.begin() + bounds[i], v.begin() + bounds[i+1]);
+         });
+      for (std::size_t i = 0; i < nthreads; ++i) workers[i].join();
+      // merge the sorted chunks pairwise, each level in parallel
+      for (std::size_t step = 1; step < nthreads; step *= 2) {
+         std::vector<std::thread> mergers;
+         for (std::size_t i = 0; i + step < nthreads; i += 2 * step) {
+            std::size_t iend = std::min(i + 2 * step, nthreads);
+            mergers.emplace_back([&v, &bounds, i, step, iend]() {
+               std::inplace_merge(v.begin() + bounds[i], v.begin() + bounds[i+step], v.begin() + bounds[iend]);
+            });
+         }
+         for (std::size_t i = 0; i < mergers.size(); ++i) mergers[i].join();
+      }
+   }
+
    void GoFTest::SetSamples(std::vector<const Double_t*> samples, const std::vector<UInt_t> samplesSizes) {
-      fCombinedSamples.assign(std::accumulate(samplesSizes.begin(), samplesSizes.end(), 0), 0.0);
+      UInt_t ntot = std::accumulate(samplesSizes.begin(), samplesSizes.end(), 0);
+      fBinned = fgAutoBinThreshold > 0 && ntot >= fgAutoBinThreshold;
+      if (fBinned) {
+         // reduce each sample in a single pass to equal-width bins keeping the
+         // bin contents; the tests then treat a bin as identical observations
+         // at the bin centre (as in the binned 2-samples Anderson-Darling test)
+         fSampleWeights.resize(samples.size());
+         Bool_t degenerateSamples = kTRUE;
+         for (UInt_t i = 0; i < samples.size(); ++i) {
+            const Double_t * x = samples[i];
+            UInt_t n = samplesSizes[i];
+            Double_t xmin = x[0];
+            Double_t xmax = x[0];
+            for (UInt_t j = 1; j < n; ++j) {
+               if (x[j] < xmin) xmin = x[j];
+               if (x[j] > xmax) xmax = x[j];
+            }
+            if (xmin < xmax) degenerateSamples = kFALSE;
+            UInt_t nbins = (xmin < xmax) ? fgAutoBinBins : 1;
+            Double_t binWidth = (xmax - xmin) / nbins;
+            std::vector<Double_t> counts(nbins, 0.0);
+            for (UInt_t j = 0; j < n; ++j) {
+               UInt_t bin = (xmin < xmax) ? static_cast<UInt_t>((x[j] - xmin) / binWidth) : 0;
+               if (bin >= nbins) bin = nbins - 1;
+               counts[bin] += 1.0;
+            }
+            // keep only the non-empty bins
+            fSamples[i].clear();
+            fSampleWeights[i].clear();
+            for (UInt_t bin = 0; bin < nbins; ++bin) {
+               if (counts[bin] > 0) {
+                  fSamples[i].push_back(xmin + (bin + 0.5) * binWidth);
+                  fSampleWeights[i].push_back(counts[bin]);
+               }
+            }
+         }
+         if (degenerateSamples) {
+            std::string msg = "Degenerate sample";
+            msg += samplesSizes.size() > 1 ? "s!" : "!";
+            msg += " Sampling values all identical.";
+            MATH_ERROR_MSG("SetSamples", msg.c_str());
+            assert(!degenerateSamples);
+         }
+         return;
+      }
+      fCombinedSamples.assign(ntot, 0.0);
       UInt_t combinedSamplesSize = 0;
       for (UInt_t i = 0; i < samples.size(); ++i) {
          fSamples[i].assign(samples[i], samples[i] + samplesSizes[i]);
-         std::sort(fSamples[i].begin(), fSamples[i].end());
+         SortSample(fSamples[i]);
          for (UInt_t j = 0; j < samplesSizes[i]; ++j) {
             fCombinedSamples[combinedSamplesSize + j] = samples[i][j];
          }
          combinedSamplesSize += samplesSizes[i];
       }
-      std::sort(fCombinedSamples.begin(), fCombinedSamples.end());
+      SortSample(fCombinedSamples);
 
       Bool_t degenerateSamples = *(fCombinedSamples.begin()) == *(fCombinedSamples.end() - 1);
       if (degenerateSamples) {
@@ -201,6 +296,20 @@ namespace Math {
    }
 
    void GoFTest::SetParameters() {
+      if (fBinned) {
+         // weighted moments from the bins
+         Double_t sumw = 0.0, sumwx = 0.0, sumwx2 = 0.0;
+         for (UInt_t j = 0; j < fSamples[0].size(); ++j) {
+            Double_t x = fSamples[0][j];
+            Double_t w = fSampleWeights[0][j];
+            sumw += w;
+            sumwx += w * x;
+            sumwx2 += w * x * x;
+         }
+         fMean = sumwx / sumw;
+         fSigma = TMath::Sqrt((sumwx2 - sumw * fMean * fMean) / (sumw - 1));
+         return;
+      }
       fMean = std::accumulate(fSamples[0].begin(), fSamples[0].end(), 0.0) / fSamples[0].size();
       fSigma = TMath::Sqrt(1. / (fSamples[0].size() - 1) * (std::inner_product(fSamples[0].begin(), fSamples[0].end(),     fSamples[0].begin(), 0.0) - fSamples[0].size() * TMath::Power(fMean, 2)));
    }
@@ -287,6 +396,7 @@ namespace Math {
       fSigma = 0;
       fSamples = std::vector<std::vector<Double_t> >(1);
       fTestSampleFromH0 = kTRUE;
+      fBinned = kFALSE;
       SetSamples(std::vector<const Double_t*>(1, sample), std::vector<UInt_t>(1, sampleSize));
    }
 
@@ -648,9 +758,47 @@ void GoFTest::AndersonDarling2SamplesTest(Double_t& pvalue, Double_t& testStat)
          MATH_ERROR_MSG("AndersonDarling2SamplesTest", "Only 1-sample tests can be issued with a 1-sample constructed GoFTest object!");
          return;
       }
+      if (fBinned) {
+         // binned approximation: merge-scan the two weighted bin sets applying
+         // the same formula used for the binned data sets (see the static
+         // AndersonDarling2SamplesTest below)
+         const std::vector<Double_t> & x1 = fSamples[0];
+         const std::vector<Double_t> & x2 = fSamples[1];
+         const std::vector<Double_t> & w1 = fSampleWeights[0];
+         const std::vector<Double_t> & w2 = fSampleWeights[1];
+         Double_t ntot1 = std::accumulate(w1.begin(), w1.end(), 0.0);
+         Double_t ntot2 = std::accumulate(w2.begin(), w2.end(), 0.0);
+         Double_t nall = ntot1 + ntot2;
+         Double_t sum1 = 0, sum2 = 0, sumAll = 0, adsum = 0;
+         UInt_t i1 = 0, i2 = 0;
+         while (i1 < x1.size() || i2 < x2.size()) {
+            // accumulate the weights of the bins with the same centre value
+            Double_t x = (i2 >= x2.size() || (i1 < x1.size() && x1[i1] <= x2[i2])) ? x1[i1] : x2[i2];
+            Double_t t = 0;
+            while (i1 < x1.size() && x1[i1] == x) { sum1 += w1[i1]; t += w1[i1]; ++i1; }
+            while (i2 < x2.size() && x2[i2] == x) { sum2 += w2[i2]; t += w2[i2]; ++i2; }
+            sumAll += t;
+            // skip last point
+            if (i1 < x1.size() || i2 < x2.size()) {
+               Double_t tmp1 = ( nall * sum1 - ntot1 * sumAll );
+               Double_t tmp2 = ( nall * sum2 - ntot2 * sumAll );
+               adsum += t * (tmp1*tmp1/ntot1 + tmp2*tmp2/ntot2) / ( sumAll * (nall - sumAll) );
+            }
+         }
+         Double_t A2binned = adsum / nall;
+         std::vector<UInt_t> nsb(2);
+         nsb[0] = (UInt_t) ntot1;
+         nsb[1] = (UInt_t) ntot2;
+         Double_t sigmaNb = GetSigmaN(nsb, (UInt_t) nall);
+         A2binned -= 1;
+         A2binned /= sigmaNb; // standartized test statistic
+         pvalue = PValueADKSamples(2, A2binned);
+         testStat = A2binned;
+         return;
+      }
       std::vector<Double_t> z(fCombinedSamples);
-      // unique removes all consecutives duplicates elements. This is exactly what we wants 
-      // for example unique of v={1,2,2,3,1,2,3,3} results in {1,2,3,1,2,3}  which is exactly what we wants 
+      // unique removes all consecutives duplicates elements. This is exactly what we wants
+      // for example unique of v={1,2,2,3,1,2,3,3} results in {1,2,3,1,2,3}  which is exactly what we wants
       std::vector<Double_t>::iterator endUnique = std::unique(z.begin(), z.end()); //z_j's in (1)
       z.erase(endUnique, z.end() ); 
       std::vector<UInt_t> h; // h_j's in (1)
@@ -867,6 +1015,27 @@ void GoFTest::AndersonDarling2SamplesTest(Double_t& pvalue, Double_t& testStat)
          return;
       }
       Double_t A2 = 0.0;
+      if (fBinned) {
+         // binned approximation: a bin content c at position x is treated as c
+         // identical consecutive order statistics; summing their (2i-1) and
+         // (2(n-i)+1) factors gives the exact expression for tied observations
+         Double_t n = std::accumulate(fSampleWeights[0].begin(), fSampleWeights[0].end(), 0.0);
+         Double_t m = 0.0; // cumulated weight of the preceding bins
+         for (UInt_t j = 0; j < fSamples[0].size(); ++j) {
+            Double_t c = fSampleWeights[0][j];
+            Double_t w1 = (*fCDF)(fSamples[0][j]);
+            A2 += (2 * c * m + c * c) * TMath::Log(w1) + (2 * c * (n - m) - c * c) * TMath::Log(1 - w1);
+            m += c;
+         }
+         (A2 /= -n) -= n;
+         if (A2 != A2) {
+            MATH_ERROR_MSG("AndersonDarlingTest", "Cannot compute p-value: data below or above the distribution's thresholds. Check sample consistency.");
+            return;
+         }
+         pvalue = PValueAD1Sample(A2);
+         testStat = A2;
+         return;
+      }
       Int_t n = fSamples[0].size();
       for (Int_t i = 0; i < n ; ++i) {
          Double_t x1 = fSamples[0][i];
@@ -896,6 +1065,30 @@ void GoFTest::AndersonDarling2SamplesTest(Double_t& pvalue, Double_t& testStat)
          MATH_ERROR_MSG("KolmogorovSmirnov2SamplesTest", "Only 1-sample tests can be issued with a 1-sample constructed GoFTest object!");
          return;
       }
+      if (fBinned) {
+         // binned approximation: maximum distance of the two weighted
+         // empirical distribution functions evaluated at the bin edges
+         const std::vector<Double_t> & x1 = fSamples[0];
+         const std::vector<Double_t> & x2 = fSamples[1];
+         const std::vector<Double_t> & w1 = fSampleWeights[0];
+         const std::vector<Double_t> & w2 = fSampleWeights[1];
+         Double_t ntot1 = std::accumulate(w1.begin(), w1.end(), 0.0);
+         Double_t ntot2 = std::accumulate(w2.begin(), w2.end(), 0.0);
+         Double_t sum1 = 0, sum2 = 0, Dn = 0;
+         UInt_t i1 = 0, i2 = 0;
+         while (i1 < x1.size() || i2 < x2.size()) {
+            Double_t x = (i2 >= x2.size() || (i1 < x1.size() && x1[i1] <= x2[i2])) ? x1[i1] : x2[i2];
+            while (i1 < x1.size() && x1[i1] == x) { sum1 += w1[i1]; ++i1; }
+            while (i2 < x2.size() && x2[i2] == x) { sum2 += w2[i2]; ++i2; }
+            Double_t d = TMath::Abs(sum1 / ntot1 - sum2 / ntot2);
+            if (d > Dn) Dn = d;
+         }
+         // same p-value computation as in TMath::KolmogorovTest
+         Double_t z = Dn * TMath::Sqrt(ntot1 * ntot2 / (ntot1 + ntot2));
+         pvalue = TMath::KolmogorovProb(z);
+         testStat = Dn;
+         return;
+      }
       const UInt_t na = fSamples[0].size();
       const UInt_t nb = fSamples[1].size();
       std::vector<Double_t> a(na);
@@ -926,6 +1119,23 @@ void GoFTest::AndersonDarling2SamplesTest(Double_t& pvalue, Double_t& testStat)
          return;
       }
       Double_t Fo = 0.0, Dn = 0.0;
+      if (fBinned) {
+         // binned approximation: compare the hypothesized CDF at the bin
+         // centre with the weighted empirical CDF before and after the bin
+         Double_t nw = std::accumulate(fSampleWeights[0].begin(), fSampleWeights[0].end(), 0.0);
+         Double_t m = 0.0;
+         for (UInt_t j = 0; j < fSamples[0].size(); ++j) {
+            m += fSampleWeights[0][j];
+            Double_t Fn = m / nw;
+            Double_t F = (*fCDF)(fSamples[0][j]);
+            Double_t result = std::max(TMath::Abs(Fn - F), TMath::Abs(Fo - F));
+            if (result > Dn) Dn = result;
+            Fo = Fn;
+         }
+         pvalue = TMath::KolmogorovProb(Dn * (TMath::Sqrt(nw) + 0.12 + 0.11 / TMath::Sqrt(nw)));
+         testStat = Dn;
+         return;
+      }
       UInt_t n = fSamples[0].size();
       for (UInt_t i = 0; i < n; ++i) {
          Double_t Fn = (i + 1.0) / n;
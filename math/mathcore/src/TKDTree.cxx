@@ -14,7 +14,9 @@
 
 #include "TString.h"
 #include <string.h>
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 templateClassImp(TKDTree)
 
@@ -561,6 +563,45 @@ void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the kNN nearest neighbors for each of the nqueries points of the first
+///argument, stored contiguously point after point (nqueries*ndim values).
+///The results for query i are returned in ind[i*kNN]..ind[i*kNN+kNN-1] and
+///dist[i*kNN]..dist[i*kNN+kNN-1]; both arrays must be allocated by the user
+///with at least nqueries*kNN elements.
+///The queries are processed in the order of the terminal node containing them,
+///so that consecutive searches traverse the same part of the tree and the
+///cache misses are amortized over the batch.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindNearestNeighbors(const Value *points, Index nqueries, const Int_t kNN, Index *ind, Value *dist)
+{
+   if (!ind || !dist) {
+      Error("FindNearestNeighbors", "Working arrays must be allocated by the user!");
+      return;
+   }
+   MakeBoundariesExact();
+   // sort the queries by the terminal node that contains them
+   std::vector<Index> order(nqueries);
+   std::vector<Index> qnode(nqueries);
+   for (Index i=0; i<nqueries; i++){
+      order[i] = i;
+      qnode[i] = FindNode(points + i*fNDim);
+   }
+   std::sort(order.begin(), order.end(), [&qnode](Index i1, Index i2) { return qnode[i1] < qnode[i2]; });
+
+   for (Index iq=0; iq<nqueries; iq++){
+      Index i = order[iq];
+      Index *qind  = ind  + i*kNN;
+      Value *qdist = dist + i*kNN;
+      for (Int_t j=0; j<kNN; j++){
+         qdist[j]=std::numeric_limits<Value>::max();
+         qind[j]=-1;
+      }
+      UpdateNearestNeighbors(0, points + i*fNDim, kNN, qind, qdist);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Update the nearest neighbors values by examining the node inode
 
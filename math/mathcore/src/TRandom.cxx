@@ -50,6 +50,13 @@ The following methods are provided to generate random numbers disctributed accor
 - `Poisson(mean)`
 - `Binomial(ntot,prob)`
 
+When many deviates of the same distribution are needed, the batched methods
+`RndmArray(n,array)`, `ExpArray(n,array,tau)`, `GausArray(n,array,mean,sigma)`
+and `PoissonArray(n,array,mean)` should be preferred to calling the scalar
+methods in a loop: they amortize the virtual call per deviate over a whole
+array and transform the uniform deviates in tight loops that the compiler
+can vectorize.
+
 Random numbers distributed according to 1-d, 2-d or 3-d distributions contained in TF1, TF2 or TF3 objects can also be generated. 
 For example, to get a random number distributed following abs(sin(x)/x)*sqrt(x)
 you can do :
@@ -128,6 +135,30 @@ A TRandom object may be written to a Root file
 - as part of another object
 - or with its own key (example: `gRandom->Write("Random")` )  ;
 
+### gRandom and multi-threading
+
+`gRandom` is a thread local facility: like `gPad` and `gDirectory` it is a
+macro resolving to TRandom::CurrentEngine(), which hands every thread its
+own TRandom3 instance. The per-thread engines are created lazily, on the
+first use of `gRandom` in a thread, and are seeded deterministically from a
+single master seed: the n-th engine created in the process uses the seed of
+stream n, obtained by mixing the master seed with the stream index (stream 0
+uses the master seed unchanged, preserving the historical single-threaded
+sequence). Threaded toy generation with ROOT::EnableImplicitMT therefore
+neither races nor serializes on a shared generator, and two runs with the
+same master seed draw from the same set of streams.
+
+Call TRandom::SetMasterSeed before spawning the parallel work to choose the
+master seed (0 picks a seed from a TUUID, as in SetSeed); it reseeds the
+calling thread with stream 0 and makes the engines subsequently created in
+the worker threads pick up streams 1, 2, ... Note that which worker ends up
+with which stream depends on the order in which the threads first touch
+`gRandom`, so per-stream reproducibility requires associating work items to
+streams explicitly (e.g. one explicit TRandom3 per item); the facility
+guarantees independent deterministic streams, not a fixed task-to-stream
+mapping. `gRandom = new TRandom2()` and `delete gRandom` keep working as
+before and affect only the calling thread's engine.
+
 */
 
 #include "TROOT.h"
@@ -136,9 +167,40 @@ A TRandom object may be written to a Root file
 #include "TRandom3.h"
 #include "TSystem.h"
 #include "TDirectory.h"
+#include "TThreadSlots.h"
 #include "Math/QuantFuncMathCore.h"
 #include "TUUID.h"
 
+#include <atomic>
+
+namespace {
+
+   // Master seed of the gRandom facility and index of the next stream to
+   // be handed out; see TRandom::SetMasterSeed and TRandom::CurrentEngine.
+   std::atomic<ULong_t> gRandomMasterSeed(4357);   // historical TRandom3 default seed
+   std::atomic<ULong_t> gRandomStreamCount(0);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Derive the seed of the given stream from the master seed. Stream 0 uses
+   /// the master seed unchanged, so that the first engine created (normally
+   /// the main thread's gRandom) reproduces the historical sequence; the
+   /// other streams mix the master seed with the stream index (finalizer of
+   /// the SplitMix64 generator), never returning 0 since a 0 seed would ask
+   /// TRandom3 for a non-deterministic TUUID based seeding.
+
+   UInt_t DeriveStreamSeed(ULong_t master, ULong_t stream)
+   {
+      if (stream == 0) return (UInt_t)master;
+      ULong64_t z = (ULong64_t)master + stream * 0x9e3779b97f4a7c15ULL;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      z ^= z >> 31;
+      UInt_t seed = (UInt_t)(z ^ (z >> 32));
+      if (!seed) seed = 4357;
+      return seed;
+   }
+}
+
 ClassImp(TRandom)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -158,6 +220,59 @@ TRandom::~TRandom()
    if (gRandom == this) gRandom = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the random number engine of the current thread; this is what the
+/// gRandom macro expands to. The engine is created on first use, as a
+/// TRandom3 seeded with the next unclaimed stream of the master seed (see
+/// SetMasterSeed), so each thread draws from its own deterministic sequence.
+/// Assigning through the returned reference (`gRandom = new TRandom2()`)
+/// replaces only the calling thread's engine.
+
+TRandom *&TRandom::CurrentEngine()
+{
+   static TRandom *mainEngine = 0;
+   TRandom **current = &mainEngine;
+   if (gThreadTsd)
+      current = (TRandom**)(*gThreadTsd)(&mainEngine, ROOT::kRandomThreadSlot);
+   if (!*current)
+      *current = new TRandom3(DeriveStreamSeed(gRandomMasterSeed, gRandomStreamCount++));
+   return *current;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning the master seed from which the per-thread
+/// gRandom engines derive their stream seeds. See SetMasterSeed.
+
+ULong_t TRandom::GetMasterSeed()
+{
+   return gRandomMasterSeed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function setting the master seed of the gRandom facility.
+/// The calling thread's engine is (re)seeded with stream 0 of the new master
+/// seed and engines created afterwards in other threads claim streams
+/// 1, 2, ... in the order in which the threads first use gRandom. Call it
+/// before spawning the parallel work so that the worker engines, created
+/// lazily inside the parallel region, derive from the new seed.
+/// If seed is 0 the master seed is taken from a TUUID, as in SetSeed: the
+/// streams then still split deterministically within the job, but differ
+/// from job to job.
+
+void TRandom::SetMasterSeed(ULong_t seed)
+{
+   if (seed == 0) {
+      TUUID u;
+      UChar_t uuid[16];
+      u.GetUUID(uuid);
+      seed = UInt_t(uuid[3])*16777216 + UInt_t(uuid[2])*65536 + UInt_t(uuid[1])*256 + UInt_t(uuid[0]);
+   }
+   TRandom *&current = CurrentEngine();
+   gRandomMasterSeed = seed;
+   gRandomStreamCount = 1;    // the calling thread takes stream 0
+   current->SetSeed(DeriveStreamSeed(seed, 0));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generates a random integer N according to the binomial law.
 /// Coded from Los Alamos report LA-5061-MS.
@@ -216,6 +331,20 @@ Double_t TRandom::Exp(Double_t tau)
    return t;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array with n exponential deviates exp(-t/tau).
+///
+/// The uniform deviates are generated with a single RndmArray call and
+/// transformed in place, avoiding one virtual function call per deviate
+/// and leaving a simple loop that the compiler can vectorize.
+
+void TRandom::ExpArray(Int_t n, Double_t *array, Double_t tau)
+{
+   RndmArray(n, array);
+   for (Int_t i = 0; i < n; i++)
+      array[i] = -tau * TMath::Log(array[i]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Samples a random number from the standard Normal (Gaussian) Distribution
 /// with the given mean and sigma.
@@ -314,6 +443,40 @@ Double_t TRandom::Gaus(Double_t mean, Double_t sigma)
    return mean + sigma * result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array with n gaussian deviates with the given mean and sigma.
+///
+/// Unlike Gaus(), which uses the acceptance-complement ratio method, the
+/// batched version uses the trigonometric Box-Muller transform (the same
+/// method as Rannor()): it consumes a predictable number of uniform deviates,
+/// which are generated in chunks with RndmArray, and the transform loop is
+/// free of data-dependent branches, so it can be vectorized.
+/// Note that as a consequence the generated sequence differs from the one
+/// obtained by calling Gaus() n times.
+
+void TRandom::GausArray(Int_t n, Double_t *array, Double_t mean, Double_t sigma)
+{
+   const Int_t kChunk = 512;  // even, the deviates are produced in pairs
+   Double_t u[kChunk];
+   Int_t i = 0;
+   while (i < n) {
+      Int_t m = TMath::Min(n - i, kChunk);
+      RndmArray(m + (m & 1), u);
+      for (Int_t j = 0; j < m / 2; j++) {
+         Double_t r   = TMath::Sqrt(-2 * TMath::Log(u[2*j]));
+         Double_t phi = TMath::TwoPi() * u[2*j + 1];
+         array[i + 2*j]     = mean + sigma * r * TMath::Cos(phi);
+         array[i + 2*j + 1] = mean + sigma * r * TMath::Sin(phi);
+      }
+      if (m & 1) {
+         Double_t r   = TMath::Sqrt(-2 * TMath::Log(u[m - 1]));
+         Double_t phi = TMath::TwoPi() * u[m];
+         array[i + m - 1] = mean + sigma * r * TMath::Cos(phi);
+      }
+      i += m;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns a random integer on [ 0, imax-1 ].
 
@@ -404,6 +567,44 @@ Int_t TRandom::Poisson(Double_t mean)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array with n Poisson deviates of the given mean.
+///
+/// For mean < 25 the multiplication method of Poisson() is applied to
+/// uniform deviates generated in chunks with RndmArray, which removes the
+/// virtual call per uniform deviate. For larger means each value is obtained
+/// with the scalar Poisson() rejection method, whose acceptance loop does not
+/// consume a predictable number of uniforms.
+
+void TRandom::PoissonArray(Int_t n, Int_t *array, Double_t mean)
+{
+   if (mean <= 0) {
+      for (Int_t i = 0; i < n; i++) array[i] = 0;
+      return;
+   }
+   if (mean >= 25) {
+      for (Int_t i = 0; i < n; i++) array[i] = Poisson(mean);
+      return;
+   }
+   const Int_t kChunk = 512;
+   Double_t u[kChunk];
+   Int_t ibuf = kChunk;
+   Double_t expmean = TMath::Exp(-mean);
+   for (Int_t i = 0; i < n; i++) {
+      Double_t pir = 1;
+      Int_t m = -1;
+      do {
+         if (ibuf == kChunk) {
+            RndmArray(kChunk, u);
+            ibuf = 0;
+         }
+         m++;
+         pir *= u[ibuf++];
+      } while (pir > expmean);
+      array[i] = m;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generates a random number according to a Poisson law.
 /// Prob(N) = exp(-mean)*mean^N/Factorial(N)
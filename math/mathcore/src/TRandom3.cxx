@@ -54,7 +54,10 @@ Drawback:  a relative large internal state of 624 integers
 #include "TClass.h"
 #include "TUUID.h"
 
-TRandom *gRandom = new TRandom3();
+// Note: gRandom is no longer a plain global instantiated here; it is a
+// macro resolving to TRandom::CurrentEngine() (see TRandom.h) which hands
+// each thread its own lazily created TRandom3, seeded deterministically
+// from the master seed (see TRandom::SetMasterSeed).
 #ifdef R__COMPLETE_MEM_TERMINATION
 namespace {
    struct TRandomCleanup {
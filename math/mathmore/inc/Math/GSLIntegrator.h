@@ -82,6 +82,13 @@ namespace Math {
    For detailed description on GSL integration algorithms see the
    <A HREF="http://www.gnu.org/software/gsl/manual/html_node/Numerical-Integration.html">GSL Manual</A>.
 
+   Thread safety: a GSLIntegrator instance holds a GSL workspace and must not
+   be shared between threads; use one instance per thread instead. Creating
+   an instance per thread (or per call) is cheap: released workspaces are
+   kept in a thread-local pool and reused by subsequent integrators of the
+   same size, so no GSL workspace allocation is performed after the first
+   integration in a thread. Distinct instances can be used concurrently from
+   different threads without locking.
 
    @ingroup Integration
    */
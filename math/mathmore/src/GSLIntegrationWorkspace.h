@@ -31,6 +31,9 @@
 #ifndef ROOT_Math_GSLIntegrationWorkspace
 #define ROOT_Math_GSLIntegrationWorkspace
 
+#include <cstddef>
+#include <utility>
+#include <vector>
 
 namespace ROOT {
 namespace Math {
@@ -45,17 +48,60 @@ namespace Math {
 
     public :
 
-      GSLIntegrationWorkspace(size_t n) {
-            fWs = gsl_integration_workspace_alloc( n);
+      GSLIntegrationWorkspace(size_t n) : fSize(n) {
+            fWs = GetPool().Acquire(n);
     }
     ~GSLIntegrationWorkspace() {
-            gsl_integration_workspace_free( fWs);
+            GetPool().Release(fWs, fSize);
     }
 
     gsl_integration_workspace * GetWS() { return fWs; }
 
   private:
+
+    // Per-thread pool of released GSL workspaces. Allocating a workspace
+    // for every integrator construction is expensive when integrators are
+    // created per call; returned workspaces are kept here and handed out
+    // again to the next workspace of the same size created by this thread.
+    // The pool is thread-local, so no locking is needed and each thread
+    // only ever touches workspaces it acquired itself.
+    class Pool {
+    public:
+      ~Pool() {
+        for (size_t i = 0; i < fFree.size(); ++i)
+          gsl_integration_workspace_free(fFree[i].second);
+      }
+      gsl_integration_workspace * Acquire(size_t n) {
+        for (size_t i = 0; i < fFree.size(); ++i) {
+          if (fFree[i].first == n) {
+            gsl_integration_workspace * ws = fFree[i].second;
+            fFree[i] = fFree.back();
+            fFree.pop_back();
+            return ws;
+          }
+        }
+        return gsl_integration_workspace_alloc(n);
+      }
+      void Release(gsl_integration_workspace * ws, size_t n) {
+        // bound the number of cached workspaces per thread
+        static const size_t kMaxFree = 8;
+        if (fFree.size() >= kMaxFree) {
+          gsl_integration_workspace_free(ws);
+          return;
+        }
+        fFree.push_back(std::make_pair(n, ws));
+      }
+    private:
+      std::vector<std::pair<size_t, gsl_integration_workspace *> > fFree;
+    };
+
+    static Pool & GetPool() {
+      static thread_local Pool gPool;
+      return gPool;
+    }
+
     gsl_integration_workspace * fWs;
+    size_t fSize;   // requested workspace size (number of sub-intervals)
 
   };
 
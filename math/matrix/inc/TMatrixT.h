@@ -97,6 +97,8 @@ public:
    void Mult (const TMatrixTSym<Element> &a,const TMatrixT   <Element> &b);
    void Mult (const TMatrixTSym<Element> &a,const TMatrixTSym<Element> &b);
 
+   void MultPlus(const TMatrixT<Element> &a,const TMatrixT<Element> &b,const TMatrixT<Element> &c);
+
    void TMult(const TMatrixT   <Element> &a,const TMatrixT   <Element> &b);
    void TMult(const TMatrixT   <Element> &a,const TMatrixTSym<Element> &b);
    void TMult(const TMatrixTSym<Element> &a,const TMatrixT   <Element> &b) { Mult(a,b); }
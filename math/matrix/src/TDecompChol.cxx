@@ -132,11 +132,15 @@ Bool_t TDecompChol::Decompose()
       pU[rowOff+icol] = ujj;
 
       if (icol < n-1) {
-         for (j = icol+1; j < n; j++) {
-            for (i = 0; i < icol; i++) {
-               const Int_t rowOff2 = i*n;
-               pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
-            }
+         // Loop over i in the outer loop so that the inner loop runs over
+         // contiguous elements of rows i and icol; for each j the terms are
+         // still subtracted in the same order, only with unit stride so the
+         // compiler can vectorize the update.
+         for (i = 0; i < icol; i++) {
+            const Int_t rowOff2 = i*n;
+            const Double_t ui = pU[rowOff2+icol];
+            for (j = icol+1; j < n; j++)
+               pU[rowOff+j] -= pU[rowOff2+j]*ui;
          }
          for (j = icol+1; j < n; j++)
             pU[rowOff+j] /= ujj;
@@ -29,9 +29,26 @@
 #include "TMatrixDEigen.h"
 #include "TClass.h"
 #include "TMath.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 templateClassImp(TMatrixT)
 
+// Matrix products above this number of multiply-add operations are evaluated
+// with the cache-blocked kernel (and, when implicit multi-threading is
+// enabled, in parallel row bands); below it the plain triple loop is faster.
+static const Long64_t kBlockedMultThreshold = 64*64*64;
+
+template<class Element> static void AMultBBand (const Element * const ap,Int_t ncolsa,
+                                                const Element * const bp,Int_t ncolsb,
+                                                Element *cp,Int_t rowMin,Int_t rowMax);
+template<class Element> static void AtMultBBand(const Element * const ap,Int_t nrowsa,Int_t ncolsa,
+                                                const Element * const bp,Int_t ncolsb,
+                                                Element *cp,Int_t rowMin,Int_t rowMax);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor for (nrows x ncols) matrix
 
@@ -685,10 +702,99 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
    const Element * const bp = b.GetMatrixArray();
          Element *       cp = this->GetMatrixArray();
 
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && Long64_t(na)*ncolsb >= kBlockedMultThreshold) {
+      const Int_t nrows    = fNrows;
+      const Int_t bandSize = TMath::Max(Int_t(kBlockedMultThreshold/(Long64_t(ncolsa)*ncolsb)),32);
+      const Int_t nBands   = (nrows+bandSize-1)/bandSize;
+      auto multBand = [=](Int_t iband) {
+         const Int_t rowMin = iband*bandSize;
+         const Int_t rowMax = TMath::Min(rowMin+bandSize,nrows);
+         AMultBBand(ap,ncolsa,bp,ncolsb,cp,rowMin,rowMax);
+         return 0;
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Map(multBand,ROOT::TSeqI(nBands));
+      return;
+   }
+#endif
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fused multiply-add. Set this matrix to A * B + C in a single pass, without
+/// creating a temporary for the product. C (and therefore this matrix) must
+/// already have the shape of A * B.
+
+template<class Element>
+void TMatrixT<Element>::MultPlus(const TMatrixT<Element> &a,const TMatrixT<Element> &b,
+                                 const TMatrixT<Element> &c)
+{
+   if (gMatrixCheck) {
+      if (a.GetNcols() != b.GetNrows() || a.GetColLwb() != b.GetRowLwb()) {
+         Error("MultPlus","A rows and B columns incompatible");
+         return;
+      }
+
+      if (c.GetNrows() != this->GetNrows()  || c.GetNcols() != this->GetNcols() ||
+          c.GetRowLwb() != this->GetRowLwb() || c.GetColLwb() != this->GetColLwb()) {
+         Error("MultPlus","C and this matrix incompatible");
+         return;
+      }
+
+      if (this->GetMatrixArray() == a.GetMatrixArray()) {
+         Error("MultPlus","this->GetMatrixArray() == a.GetMatrixArray()");
+         return;
+      }
+
+      if (this->GetMatrixArray() == b.GetMatrixArray()) {
+         Error("MultPlus","this->GetMatrixArray() == b.GetMatrixArray()");
+         return;
+      }
+   }
+
+#ifdef CBLAS
+   const Element *ap = a.GetMatrixArray();
+   const Element *bp = b.GetMatrixArray();
+         Element *cp = this->GetMatrixArray();
+   if (cp != c.GetMatrixArray())
+      memcpy(cp,c.GetMatrixArray(),this->GetNoElements()*sizeof(Element));
+   if (typeid(Element) == typeid(Double_t))
+      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
+                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
+   else if (typeid(Element) != typeid(Float_t))
+      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
+                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
+   else
+      Error("MultPlus","type %s not implemented in BLAS library",typeid(Element));
+#else
+   const Int_t na     = a.GetNoElements();
+   const Int_t nb     = b.GetNoElements();
+   const Int_t ncolsa = a.GetNcols();
+   const Int_t ncolsb = b.GetNcols();
+   const Element * const ap = a.GetMatrixArray();
+   const Element * const bp = b.GetMatrixArray();
+   const Element *       sp = c.GetMatrixArray();
+         Element *       cp = this->GetMatrixArray();
+
+   const Element *arp0 = ap;                     // Pointer to  A[i,0];
+   while (arp0 < ap+na) {
+      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
+         const Element *arp = arp0;                       // Pointer to the i-th row of A, reset to A[i,0]
+         Element cij = *sp++;                      // Seed with C[i,j]
+         while (bcp < bp+nb) {                     // Scan the i-th row of A and
+            cij += *arp++ * *bcp;                   // the j-th col of B
+            bcp += ncolsb;
+         }
+         *cp++ = cij;
+         bcp -= nb-1;                              // Set bcp to the (j+1)-th col
+      }
+      arp0 += ncolsa;                             // Set ap to the (i+1)-th row
+   }
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Matrix multiplication, with A symmetric and B general.
 /// Create a matrix C such that C = A * B.
@@ -890,6 +996,23 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
    const Element * const bp = b.GetMatrixArray();
          Element *       cp = this->GetMatrixArray();
 
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && Long64_t(nb)*ncolsa >= kBlockedMultThreshold) {
+      const Int_t nrowsa   = (ncolsb > 0) ? nb/ncolsb : 0;
+      const Int_t nrows    = fNrows;
+      const Int_t bandSize = TMath::Max(Int_t(kBlockedMultThreshold/(Long64_t(nrowsa)*ncolsb)),32);
+      const Int_t nBands   = (nrows+bandSize-1)/bandSize;
+      auto multBand = [=](Int_t iband) {
+         const Int_t rowMin = iband*bandSize;
+         const Int_t rowMax = TMath::Min(rowMin+bandSize,nrows);
+         AtMultBBand(ap,nrowsa,ncolsa,bp,ncolsb,cp,rowMin,rowMax);
+         return 0;
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Map(multBand,ROOT::TSeqI(nBands));
+      return;
+   }
+#endif
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
 #endif
 }
@@ -3070,6 +3193,71 @@ TMatrixT<Element> &ElementDiv(TMatrixT<Element> &target,const TMatrixTSym<Elemen
    return target;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Cache-blocked kernel calculating the rows [rowMin,rowMax) of C = A * B.
+/// The i-k-j loop order makes the innermost loop run over contiguous
+/// elements of B and C, so the compiler can vectorize it, while the blocking
+/// on the inner dimension keeps the accessed rows of B in cache.
+
+template<class Element>
+static void AMultBBand(const Element * const ap,Int_t ncolsa,
+                       const Element * const bp,Int_t ncolsb,
+                       Element *cp,Int_t rowMin,Int_t rowMax)
+{
+   const Int_t blockSize = 64;                  // rows of B accessed per pass
+
+   for (Int_t i = rowMin; i < rowMax; i++) {
+      Element * const crp = cp+i*ncolsb;
+      for (Int_t j = 0; j < ncolsb; j++)
+         crp[j] = 0;
+   }
+
+   for (Int_t kLow = 0; kLow < ncolsa; kLow += blockSize) {
+      const Int_t kUp = TMath::Min(kLow+blockSize,ncolsa);
+      for (Int_t i = rowMin; i < rowMax; i++) {
+         const Element * const arp = ap+i*ncolsa;
+               Element * const crp = cp+i*ncolsb;
+         for (Int_t k = kLow; k < kUp; k++) {
+            const Element aik = arp[k];
+            const Element * const brp = bp+k*ncolsb;
+            for (Int_t j = 0; j < ncolsb; j++)
+               crp[j] += aik*brp[j];
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache-blocked kernel calculating the rows [rowMin,rowMax) of C = A^T * B,
+/// organized like AMultBBand but with A accessed column-wise.
+
+template<class Element>
+static void AtMultBBand(const Element * const ap,Int_t nrowsa,Int_t ncolsa,
+                        const Element * const bp,Int_t ncolsb,
+                        Element *cp,Int_t rowMin,Int_t rowMax)
+{
+   const Int_t blockSize = 64;                  // rows of A and B accessed per pass
+
+   for (Int_t i = rowMin; i < rowMax; i++) {
+      Element * const crp = cp+i*ncolsb;
+      for (Int_t j = 0; j < ncolsb; j++)
+         crp[j] = 0;
+   }
+
+   for (Int_t kLow = 0; kLow < nrowsa; kLow += blockSize) {
+      const Int_t kUp = TMath::Min(kLow+blockSize,nrowsa);
+      for (Int_t i = rowMin; i < rowMax; i++) {
+         Element * const crp = cp+i*ncolsb;
+         for (Int_t k = kLow; k < kUp; k++) {
+            const Element aki = ap[k*ncolsa+i];
+            const Element * const brp = bp+k*ncolsb;
+            for (Int_t j = 0; j < ncolsb; j++)
+               crp[j] += aki*brp[j];
+         }
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
 
@@ -3077,6 +3265,11 @@ template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   if (ncolsa > 0 && Long64_t(na)*ncolsb >= kBlockedMultThreshold) {
+      AMultBBand(ap,ncolsa,bp,ncolsb,cp,0,na/ncolsa);
+      return;
+   }
+
    const Element *arp0 = ap;                     // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3100,6 +3293,11 @@ template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   if (ncolsb > 0 && Long64_t(nb)*ncolsa >= kBlockedMultThreshold) {
+      AtMultBBand(ap,nb/ncolsb,ncolsa,bp,ncolsb,cp,0,ncolsa);
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+ncolsa) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -113,6 +113,18 @@ public:
    */
    virtual void SetErrorDef(double ) {};
 
+   /**
+
+      Declare whether operator() may be invoked concurrently from several
+      threads on distinct parameter vectors. When this function returns true
+      the numerical gradient calculation evaluates the derivatives of the
+      different parameters in parallel. Re-implement it to return true only
+      if the function object has no mutable state (or protects it itself).
+
+   */
+
+   virtual bool IsThreadSafe() const {return false;}
+
 };
 
   }  // namespace Minuit2
@@ -13,6 +13,7 @@
 #include "Minuit2/MnConfig.h"
 #include "Minuit2/MnMatrix.h"
 
+#include <atomic>
 #include <vector>
 
 namespace ROOT {
@@ -56,7 +57,9 @@ private:
 
 protected:
 
-  mutable int fNumCall;
+  // atomic so that thread-safe FCNs (see FCNBase::IsThreadSafe) can be
+  // evaluated concurrently by the parallel numerical gradient calculation
+  mutable std::atomic<int> fNumCall;
 };
 
   }  // namespace Minuit2
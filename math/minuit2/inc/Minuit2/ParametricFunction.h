@@ -175,6 +175,40 @@ public:
 
 
 
+  /**
+
+  Evaluates the function Value and its Gradient for a whole block of
+  coordinate points in one call. The default implementation loops over
+  the points and makes the same per-point virtual calls (SetParameters,
+  operator() and GetGradient) as the non-batched code; model functions
+  whose evaluation vectorizes over the data points should override it
+  and fill the output arrays in bulk. Used by the Fumili FCN classes
+  (see FumiliStandardChi2FCN::EvaluateAll).
+
+  @param par vector containing the Parameter values
+
+  @param pos vector of coordinate points; the block consists of the
+  entries [first, first+n)
+
+  @param first Index of the first point of the block
+
+  @param n number of points in the block
+
+  @param values array of n doubles filled with the function Value at
+  each point of the block
+
+  @param gradients array of n*par.size() doubles filled, point by
+  point, with the Gradient at each point of the block
+
+  */
+
+  virtual void EvaluateBlock(const std::vector<double>& par,
+                             const std::vector<std::vector<double> >& pos,
+                             unsigned int first, unsigned int n,
+                             double* values, double* gradients) const;
+
+
+
 
  protected:
 
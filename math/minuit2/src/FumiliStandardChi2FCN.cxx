@@ -83,35 +83,43 @@ void  FumiliStandardChi2FCN::EvaluateAll( const std::vector<double> & par) {
 
    const ParametricFunction & modelFunc = *ModelFunction();
 
-   for (int i = 0; i < nmeas; ++i) {
+   // The model is evaluated a block of points at a time: vectorized model
+   // implementations override ParametricFunction::EvaluateBlock and fill
+   // the value and Jacobian arrays in bulk, the default falls back to the
+   // per-point virtual calls this loop used to make.
+   const int blockSize = 64;
+   std::vector<double> fval(blockSize);
+   std::vector<double> mfg(blockSize * npar);
 
-      // work for multi-dimensional points
-      const std::vector<double> & currentPosition = fPositions[i];
-      modelFunc.SetParameters( currentPosition );
-      double invError = fInvErrors[i];
-      double fval = modelFunc(par);
+   for (int first = 0; first < nmeas; first += blockSize) {
+
+      int nblock = std::min(blockSize, nmeas - first);
+      modelFunc.EvaluateBlock(par, fPositions, first, nblock, &fval[0], &mfg[0]);
+
+      for (int ib = 0; ib < nblock; ++ib) {
 
-      double element = ( fval - fMeasurements[i] )*invError;
-      chi2 += element*element;
+         int i = first + ib;
+         double invError = fInvErrors[i];
+         const double * mfgRow = &mfg[ib*npar];
 
-      // calc derivatives
+         double element = ( fval[ib] - fMeasurements[i] )*invError;
+         chi2 += element*element;
 
-      // this method should return a reference
-      std::vector<double> mfg = modelFunc.GetGradient(par);
+         // grad is derivative of chi2 w.r.t to parameters
+         for (int j = 0; j < npar ; ++j) {
+            double dfj = invError * mfgRow[j];
+            grad[j] += 2.0 * element * dfj;
 
-      // grad is derivative of chi2 w.r.t to parameters
-      for (int j = 0; j < npar ; ++j) {
-         double dfj = invError * mfg[j];
-         grad[j] += 2.0 * element * dfj;
+            // in second derivative use Fumili approximation neglecting the term containing the
+            // second derivatives of the model function
+            for (int k = j; k < npar; ++ k) {
+               int idx =  j + k*(k+1)/2;
+               h[idx] += 2.0 * dfj * invError * mfgRow[k];
+            }
 
-         // in second derivative use Fumili approximation neglecting the term containing the
-         // second derivatives of the model function
-         for (int k = j; k < npar; ++ k) {
-            int idx =  j + k*(k+1)/2;
-            h[idx] += 2.0 * dfj * invError * mfg[k];
-         }
+         } // end param loop
 
-      } // end param loop
+      } // end block loop
 
    } // end points loop
 
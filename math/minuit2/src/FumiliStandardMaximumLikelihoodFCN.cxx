@@ -85,75 +85,89 @@ void  FumiliStandardMaximumLikelihoodFCN::EvaluateAll( const std::vector<double>
 
    const ParametricFunction & modelFunc = *ModelFunction();
 
-   for (int i = 0; i < nmeas; ++i) {
-
-      // work for one-dimensional points
-      const std::vector<double> & currentPosition = fPositions[i];
-      modelFunc.SetParameters( currentPosition );
-      double fval = modelFunc(par);
-      if (fval < minDouble ) fval = minDouble;   // to avoid getting infinity and nan's
-      logLikelihood -= std::log( fval);
-      double invFval = 1.0/fval;
-      // this method should return a reference
-      std::vector<double> mfg = modelFunc.GetGradient(par);
-
-      // calc derivatives
-
-      for (int j = 0; j < npar; ++j) {
-         if ( std::fabs(mfg[j]) < minDouble ) {
-            //  std::cout << "SMALL values: grad =  " << mfg[j] << "  "  << minDouble << " f(x) = " << fval
-            //    << " params " << j << " p0 = " << par[0] << " p1 = " << par[1] <<  std::endl;
-            if (mfg[j] < 0)
-               mfg[j] =  -minDouble;
-            else
-               mfg[j] =  minDouble;
-         }
-
-         double dfj = invFval * mfg[j];
-         // to avoid summing infinite and nan later when calculating the Hessian
-         if ( std::fabs(dfj) > maxDouble2 ) {
-            if (dfj > 0)
-               dfj = maxDouble2;
-            else
-               dfj = -maxDouble2;
-         }
-
-         grad[j] -= dfj;
-         //       if ( ! ( dfj > 0) && ! ( dfj <= 0 ) )
-         // std::cout << " nan : dfj = " << dfj << " fval =  " << fval << " invF = " << invFval << " grad = " << mfg[j] << " par[j] = " << par[j] << std::endl;
-
-         //std::cout << " x = "  << currentPosition[0] <<  " par[j] = " << par[j] << " : dfj = " << dfj << " fval =  " << fval << " invF = " << invFval << " grad = " << mfg[j] << " deriv = " << grad[j] << std::endl;
-
-
-         // in second derivative use Fumili approximation neglecting the term containing the
-         // second derivatives of the model function
-         for (int k = j; k < npar; ++ k) {
-            int idx =  j + k*(k+1)/2;
-            if (std::fabs( mfg[k]) < minDouble ) {
-               if (mfg[k] < 0)
-                  mfg[k] =  -minDouble;
+   // The model is evaluated a block of points at a time: vectorized model
+   // implementations override ParametricFunction::EvaluateBlock and fill
+   // the value and Jacobian arrays in bulk, the default falls back to the
+   // per-point virtual calls this loop used to make.
+   const int blockSize = 64;
+   std::vector<double> fvals(blockSize);
+   std::vector<double> mfgBlock(blockSize * npar);
+
+   for (int first = 0; first < nmeas; first += blockSize) {
+
+      int nblock = std::min(blockSize, nmeas - first);
+      modelFunc.EvaluateBlock(par, fPositions, first, nblock, &fvals[0], &mfgBlock[0]);
+
+      for (int ib = 0; ib < nblock; ++ib) {
+
+         double fval = fvals[ib];
+         if (fval < minDouble ) fval = minDouble;   // to avoid getting infinity and nan's
+         logLikelihood -= std::log( fval);
+         double invFval = 1.0/fval;
+         // the clamping below modifies the Gradient values in place (the
+         // Hessian loop must see the values clamped by earlier iterations),
+         // so take a mutable view of this point's row of the block
+         double * mfg = &mfgBlock[ib*npar];
+
+         // calc derivatives
+
+         for (int j = 0; j < npar; ++j) {
+            if ( std::fabs(mfg[j]) < minDouble ) {
+               //  std::cout << "SMALL values: grad =  " << mfg[j] << "  "  << minDouble << " f(x) = " << fval
+               //    << " params " << j << " p0 = " << par[0] << " p1 = " << par[1] <<  std::endl;
+               if (mfg[j] < 0)
+                  mfg[j] =  -minDouble;
                else
-                  mfg[k] =  minDouble;
+                  mfg[j] =  minDouble;
             }
 
-            double dfk =  invFval * mfg[k];
-            // avoid that dfk*dfj are one small and one huge so I get a nan
+            double dfj = invFval * mfg[j];
             // to avoid summing infinite and nan later when calculating the Hessian
-            if ( std::fabs(dfk) > maxDouble2 ) {
-               if (dfk > 0)
-                  dfk = maxDouble2;
+            if ( std::fabs(dfj) > maxDouble2 ) {
+               if (dfj > 0)
+                  dfj = maxDouble2;
                else
-                  dfk = -maxDouble2;
+                  dfj = -maxDouble2;
             }
 
+            grad[j] -= dfj;
+            //       if ( ! ( dfj > 0) && ! ( dfj <= 0 ) )
+            // std::cout << " nan : dfj = " << dfj << " fval =  " << fval << " invF = " << invFval << " grad = " << mfg[j] << " par[j] = " << par[j] << std::endl;
+
+            //std::cout << " x = "  << currentPosition[0] <<  " par[j] = " << par[j] << " : dfj = " << dfj << " fval =  " << fval << " invF = " << invFval << " grad = " << mfg[j] << " deriv = " << grad[j] << std::endl;
+
+
+            // in second derivative use Fumili approximation neglecting the term containing the
+            // second derivatives of the model function
+            for (int k = j; k < npar; ++ k) {
+               int idx =  j + k*(k+1)/2;
+               if (std::fabs( mfg[k]) < minDouble ) {
+                  if (mfg[k] < 0)
+                     mfg[k] =  -minDouble;
+                  else
+                     mfg[k] =  minDouble;
+               }
+
+               double dfk =  invFval * mfg[k];
+               // avoid that dfk*dfj are one small and one huge so I get a nan
+               // to avoid summing infinite and nan later when calculating the Hessian
+               if ( std::fabs(dfk) > maxDouble2 ) {
+                  if (dfk > 0)
+                     dfk = maxDouble2;
+                  else
+                     dfk = -maxDouble2;
+               }
+
+
+               h[idx] += dfj * dfk;
+               // if ( ( ! ( h[idx] > 0) && ! ( h[idx] <= 0 ) ) )
+               //   std::cout << " nan : dfj = " << dfj << " fval =  " << fval << " invF = " << invFval << " gradj = " << mfg[j]
+               //     << " dfk = " << dfk << " gradk =  "<< mfg[k]  << " hess_jk = " << h[idx] << " par[k] = " << par[k] << std::endl;
+            }
 
-            h[idx] += dfj * dfk;
-            // if ( ( ! ( h[idx] > 0) && ! ( h[idx] <= 0 ) ) )
-            //   std::cout << " nan : dfj = " << dfj << " fval =  " << fval << " invF = " << invFval << " gradj = " << mfg[j]
-            //     << " dfk = " << dfk << " gradk =  "<< mfg[k]  << " hess_jk = " << h[idx] << " par[k] = " << par[k] << std::endl;
-         }
+         } // end param loop
 
-      } // end param loop
+      } // end block loop
 
    } // end points loop
 
@@ -30,6 +30,9 @@
 
 #include "Minuit2/MPIProcess.h"
 
+#include <thread>
+#include <vector>
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -249,6 +252,50 @@ L30:
    unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
    unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
+   // Each off-diagonal element needs a single FCN evaluation at
+   // x + d_i e_i + d_j e_j and writes its own matrix slot, so the elements
+   // of this process' range are independent of each other. When the FCN
+   // declares itself thread safe (see FCNBase::IsThreadSafe) they are
+   // distributed over a thread pool, mirroring the parallel loop of
+   // Numerical2PGradientCalculator; the result is identical to the serial
+   // one whatever the thread schedule.
+   unsigned int nthreads = 1;
+   if (mfcn.Fcn().IsThreadSafe() && endParIndexOffDiagonal > startParIndexOffDiagonal+1) {
+      nthreads = std::thread::hardware_concurrency();
+      if (nthreads > endParIndexOffDiagonal-startParIndexOffDiagonal)
+         nthreads = endParIndexOffDiagonal-startParIndexOffDiagonal;
+   }
+
+   if (nthreads > 1) {
+      std::vector<std::thread> pool;
+      pool.reserve(nthreads);
+      for (unsigned int ith = 0; ith < nthreads; ith++) {
+         pool.emplace_back([&,ith]() {
+            MnAlgebraicVector xt = st.Parameters().Vec();
+            for (unsigned int in = startParIndexOffDiagonal+ith;
+                 in < endParIndexOffDiagonal; in += nthreads) {
+               // recover (i,j), i < j, from the linear pair index
+               unsigned int k = in;
+               unsigned int i = 0;
+               unsigned int rowlen = n-1;
+               while (k >= rowlen) { k -= rowlen; i++; rowlen--; }
+               unsigned int j = i+1+k;
+
+               xt(i) += dirin(i);
+               xt(j) += dirin(j);
+
+               double fs1 = mfcn(xt);
+               vhmat(i,j) = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+
+               xt(i) -= dirin(i);
+               xt(j) -= dirin(j);
+            }
+         });
+      }
+      for (unsigned int ith = 0; ith < nthreads; ith++)
+         pool[ith].join();
+   } else {
+
    unsigned int offsetVect = 0;
    for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
       if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
@@ -276,6 +323,8 @@ L30:
 
    }
 
+   }
+
    mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
 
    //verify if matrix pos-def (still 2nd derivative)
@@ -9,6 +9,7 @@
 
 #include "Minuit2/Numerical2PGradientCalculator.h"
 #include "Minuit2/InitialGradientCalculator.h"
+#include "Minuit2/FCNBase.h"
 #include "Minuit2/MnFcn.h"
 #include "Minuit2/MnUserTransformation.h"
 #include "Minuit2/MnMachinePrecision.h"
@@ -30,6 +31,7 @@
 #endif
 
 #include <math.h>
+#include <thread>
 
 #include "Minuit2/MPIProcess.h"
 
@@ -111,37 +113,17 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
-#ifndef _OPENMP
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
- // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-//#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for(int i = 0; i < int(n); i++) {
-
-#endif
+   // derivative calculation for one parameter; every caller passes its own
+   // working copy of the parameter vector and distinct elements of
+   // grd/g2/gstep are written, so callers working on different parameters
+   // need no synchronization
+   auto derivParam = [&](unsigned int i, MnAlgebraicVector& x) {
 
 #ifdef DEBUG_MP
       int ith = omp_get_thread_num();
       //std::cout << "Thread number " << ith << "  " << i << std::endl;
 #endif
 
-#ifdef _OPENMP
-       // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
-
       double xtf = x(i);
       double epspri = eps2 + fabs(grd(i)*eps2);
       double stepb4 = 0.;
@@ -217,8 +199,57 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
       std::cout.precision(pr);
 #endif
+   };
+
+#ifdef _OPENMP
+
+ // parallelize this loop using OpenMP
+#pragma omp parallel
+   {
+      // each thread uses its own copy of the parameter vector
+      MnAlgebraicVector x = par.Vec();
+#pragma omp for
+      for(int i = 0; i < int(n); i++)
+         derivParam(i, x);
    }
 
+#else
+
+   // for serial execution this can be outside the loop
+   MnAlgebraicVector x = par.Vec();
+
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+   // evaluate the derivatives of the different parameters concurrently when
+   // the FCN declares itself thread safe (see FCNBase::IsThreadSafe); each
+   // thread processes a stride of the parameter indices
+   unsigned int nthreads = 1;
+   if (Fcn().Fcn().IsThreadSafe() && endElementIndex > startElementIndex+1) {
+      nthreads = std::thread::hardware_concurrency();
+      if (nthreads > endElementIndex-startElementIndex)
+         nthreads = endElementIndex-startElementIndex;
+   }
+
+   if (nthreads > 1) {
+      std::vector<std::thread> pool;
+      pool.reserve(nthreads);
+      for (unsigned int ith = 0; ith < nthreads; ith++) {
+         pool.emplace_back([&,ith]() {
+            MnAlgebraicVector xt = par.Vec();
+            for (unsigned int i = startElementIndex+ith; i < endElementIndex; i += nthreads)
+               derivParam(i, xt);
+         });
+      }
+      for (unsigned int ith = 0; ith < nthreads; ith++)
+         pool[ith].join();
+   } else {
+      for (unsigned int i = startElementIndex; i < endElementIndex; i++)
+         derivParam(i, x);
+   }
+
+#endif
+
 #ifndef _OPENMP
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(g2);
@@ -15,6 +15,8 @@
 #include "Minuit2/FunctionGradient.h"
 #include "Minuit2/MnVectorTransform.h"
 
+#include <algorithm>
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -46,6 +48,23 @@ std::vector<double>  ParametricFunction::GetGradient(const std::vector<double>&
    return vt( grad );
 }
 
+void ParametricFunction::EvaluateBlock(const std::vector<double>& par,
+                                       const std::vector<std::vector<double> >& pos,
+                                       unsigned int first, unsigned int n,
+                                       double* values, double* gradients) const {
+   // default per-point fallback: the same virtual calls the non-batched
+   // code made, so overriding implementations and the default give
+   // identical results
+
+   unsigned int npar = par.size();
+   for (unsigned int i = 0; i < n; ++i) {
+      SetParameters( pos[first+i] );
+      values[i] = operator()(par);
+      std::vector<double> g = GetGradient(par);
+      std::copy(g.begin(), g.end(), gradients + i*npar);
+   }
+}
+
    }  // namespace Minuit2
 
 }  // namespace ROOT
@@ -31,6 +31,7 @@ public:
 
    Bool_t          SetDecay(TLorentzVector &P, Int_t nt, const Double_t *mass, Option_t *opt="");
    Double_t        Generate();
+   void            GenerateN(Int_t nevents, Double_t *px, Double_t *py, Double_t *pz, Double_t *e, Double_t *wt);
    TLorentzVector *GetDecay(Int_t n);
 
    Int_t    GetNt()      const { return fNt;}
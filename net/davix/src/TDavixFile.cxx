@@ -812,6 +812,86 @@ Long64_t TDavixFile::DavixReadBuffers(Davix_fd *fd, char *buf, Long64_t *pos, In
 {
    DavixError *davixErr = NULL;
    Double_t start_time = eventStart();
+
+   // Coalesce ranges separated by less than Davix.GapTolerance bytes into a
+   // single range: when the server has no multi-range support davix issues
+   // one request per vector element, so fewer elements means fewer round
+   // trips, and reading a small gap twice is cheaper than the extra request.
+   static const Long64_t gap_tolerance = (gEnv) ? gEnv->GetValue("Davix.GapTolerance", 8192) : 8192;
+   std::vector<Long64_t> cpos;
+   std::vector<Int_t> clen;
+   if (nbuf > 1 && gap_tolerance > 0) {
+      bool sorted = true;
+      for (Int_t i = 1; i < nbuf; ++i) {
+         if (pos[i] < pos[i-1] + len[i-1]) {
+            sorted = false;
+            break;
+         }
+      }
+      if (sorted) {
+         cpos.push_back(pos[0]);
+         clen.push_back(len[0]);
+         for (Int_t i = 1; i < nbuf; ++i) {
+            Long64_t end = cpos.back() + clen.back();
+            Long64_t mergedlen = pos[i] + len[i] - cpos.back();
+            if (pos[i] - end <= gap_tolerance && mergedlen < kMaxInt) {
+               clen.back() = Int_t(mergedlen);
+            } else {
+               cpos.push_back(pos[i]);
+               clen.push_back(len[i]);
+            }
+         }
+         if ((Int_t)cpos.size() == nbuf) {
+            cpos.clear();
+            clen.clear();
+         }
+      }
+   }
+
+   if (!cpos.empty()) {
+      Int_t ncoal = (Int_t)cpos.size();
+      Long64_t tot = 0;
+      for (Int_t i = 0; i < ncoal; ++i) tot += clen[i];
+      std::vector<char> mbuf(tot);
+      std::vector<DavIOVecInput> in(ncoal);
+      std::vector<DavIOVecOuput> out(ncoal);
+
+      Long64_t lastPos = 0;
+      for (Int_t i = 0; i < ncoal; ++i) {
+         in[i].diov_buffer = &mbuf[lastPos];
+         in[i].diov_offset = cpos[i];
+         in[i].diov_size = clen[i];
+         lastPos += clen[i];
+      }
+
+      if (gDebug > 1)
+         Info("DavixReadBuffers", "coalesced %d ranges into %d (gap tolerance %lld)",
+              nbuf, ncoal, gap_tolerance);
+
+      Long64_t ret = d_ptr->davixPosix->preadVec(fd, &in[0], &out[0], ncoal, &davixErr);
+      if (ret < 0) {
+         Error("DavixReadBuffers", "can not read data with davix: %s (%d)",
+               davixErr->getErrMsg().c_str(), davixErr->getStatus());
+         DavixError::clearError(&davixErr);
+         return ret;
+      }
+
+      // scatter the requested blocks out of the coalesced ranges
+      Int_t iseg = 0;
+      Long64_t segoff = 0, curr = 0;
+      for (Int_t i = 0; i < nbuf; ++i) {
+         while (pos[i] >= cpos[iseg] + clen[iseg]) {
+            segoff += clen[iseg];
+            iseg++;
+         }
+         memcpy(&buf[curr], &mbuf[segoff + (pos[i] - cpos[iseg])], len[i]);
+         curr += len[i];
+      }
+
+      eventStop(start_time, curr);
+      return curr;
+   }
+
    DavIOVecInput in[nbuf];
    DavIOVecOuput out[nbuf];
 
@@ -9,6 +9,8 @@
 #include "TString.h"
 
 #include <condition_variable>
+#include <memory>
+#include <string>
 
 class THttpServer;
 class TNamed;
@@ -41,6 +43,8 @@ protected:
    void *fBinData;              //! binary data, assigned with http call
    Long_t fBinDataLength;       //! length of binary data
 
+   std::shared_ptr<const std::string> fSharedData; //! reference-counted content, shared with the producer
+
    Bool_t IsBinData() const
    {
       return fBinData && fBinDataLength > 0;
@@ -320,13 +324,23 @@ public:
 
    void SetBinData(void *data, Long_t length);
 
+   void SetSharedData(std::shared_ptr<const std::string> data)
+   {
+      // set reference-counted content, shared with the producer;
+      // the data is delivered without copying and kept alive while used
+
+      fSharedData = data;
+   }
+
    Long_t GetContentLength() const
    {
+      if (fSharedData) return (Long_t) fSharedData->length();
       return IsBinData() ? fBinDataLength : fContent.Length();
    }
 
    const void *GetContent() const
    {
+      if (fSharedData) return fSharedData->data();
       return IsBinData() ? fBinData : fContent.Data();
    }
 
@@ -13,6 +13,9 @@
 #include "THttpCallArg.h"
 
 #include <mutex>
+#include <memory>
+#include <map>
+#include <string>
 
 class THttpEngine;
 class THttpTimer;
@@ -42,9 +45,21 @@ protected:
    std::mutex   fMutex;       //! mutex to protect list with arguments
    TList        fCallArgs;    //! submitted arguments
 
+   struct Snapshot_t {
+      std::shared_ptr<const std::string> fData;  ///< pre-serialized content, shared with replies in flight
+      TString fContentType;                      ///< content type of the snapshot
+      UInt_t  fVersion;                          ///< incremented every time the snapshot is updated
+      Snapshot_t() : fData(), fContentType(), fVersion(0) {}
+   };
+
+   std::mutex   fSnapshotMutex;  //! mutex to protect snapshots map, locked from http threads
+   std::map<std::string, Snapshot_t> fSnapshots; //! pre-serialized content, served without entering main thread
+
    // Here any request can be processed
    virtual void ProcessRequest(THttpCallArg *arg);
 
+   Bool_t ServeSnapshot(THttpCallArg *arg);
+
    static Bool_t VerifyFilePath(const char *fname);
 
 public:
@@ -121,6 +136,13 @@ public:
 
    const char *GetItemField(const char *fullname, const char *name);
 
+   Bool_t RegisterSnapshot(const char *path, const char *filename, const void *data, Long_t length,
+                           const char *contenttype, const char *query = 0);
+
+   Bool_t CreateObjectSnapshot(const char *path);
+
+   void ClearSnapshots(const char *path = 0);
+
    /** Guess mime type base on file extension */
    static const char *GetMimeType(const char *path);
 
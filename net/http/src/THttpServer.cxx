@@ -442,6 +442,10 @@ Bool_t THttpServer::IsFileRequested(const char *uri, TString &res) const
 
 Bool_t THttpServer::ExecuteHttp(THttpCallArg *arg)
 {
+   // requests for items with a registered snapshot are served directly from
+   // the pre-serialized content, without entering the main ROOT thread
+   if (ServeSnapshot(arg)) return kTRUE;
+
    if ((fMainThrdId!=0) && (fMainThrdId == TThread::SelfId())) {
       // should not happen, but one could process requests directly without any signaling
 
@@ -828,6 +832,135 @@ const char *THttpServer::GetItemField(const char *fullname, const char *name)
    return fSniffer->GetItemField(fullname, name);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Try to serve the request from the snapshots map.
+/// Only the reference-counted pointer to the pre-serialized content is
+/// handed to the reply - neither the ROOT object nor the main thread is
+/// touched, therefore this can be (and is) called from the http threads.
+/// Returns kTRUE when the request was served.
+
+Bool_t THttpServer::ServeSnapshot(THttpCallArg *arg)
+{
+   if (!arg->fMethod.IsNull() && !arg->IsPostMethod() && (arg->fMethod != "GET")) return kFALSE;
+   if (arg->IsPostMethod() || (arg->GetPostData() != 0)) return kFALSE;
+
+   const char *pathname = arg->fPathName.Data();
+   while (*pathname == '/') pathname++;
+
+   std::string key = pathname;
+   key.append("/");
+   key.append(arg->fFileName.Data());
+   key.append("?");
+   key.append(arg->fQuery.Data());
+
+   std::unique_lock<std::mutex> lk(fSnapshotMutex);
+   std::map<std::string, Snapshot_t>::iterator iter = fSnapshots.find(key);
+   if (iter == fSnapshots.end()) return kFALSE;
+
+   arg->SetSharedData(iter->second.fData);
+   arg->SetContentType(iter->second.fContentType.Data());
+   TString etag = TString::Format("\"snap%u\"", iter->second.fVersion);
+   lk.unlock();
+
+   arg->AddHeader("ETag", etag.Data());
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register pre-serialized content for the item with path "path", served
+/// for requests of "filename" (like "root.json" or "root.bin") with the
+/// given query string (default - empty query).
+/// The data is copied once into a reference-counted buffer; subsequent
+/// requests receive the buffer by reference without any serialization or
+/// locking of the ROOT object. Calling the method again for the same
+/// path/filename/query replaces the content and increments the snapshot
+/// version, delivered to the clients in the ETag header. Replies still in
+/// flight keep the previous buffer alive.
+/// Can be called from any thread owning a consistent view of the data.
+
+Bool_t THttpServer::RegisterSnapshot(const char *path, const char *filename, const void *data,
+                                     Long_t length, const char *contenttype, const char *query)
+{
+   if ((path == 0) || (filename == 0) || (data == 0) || (length <= 0)) return kFALSE;
+
+   while (*path == '/') path++;
+
+   std::string key = path;
+   if (!key.empty() && (key[key.length()-1] == '/')) key.resize(key.length()-1);
+   key.append("/");
+   key.append(filename);
+   key.append("?");
+   if (query != 0) key.append(query);
+
+   std::shared_ptr<const std::string> blob(new std::string((const char *)data, (size_t)length));
+
+   std::unique_lock<std::mutex> lk(fSnapshotMutex);
+   Snapshot_t &snap = fSnapshots[key];
+   snap.fData = blob;
+   snap.fContentType = contenttype ? contenttype : "application/x-binary";
+   snap.fVersion++;
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce and register "root.bin" and "root.json" snapshots for the
+/// object with path "path", using the sniffer in the same way as a normal
+/// request would. Must be called from the main thread (where the object
+/// is modified), typically right after the object has changed; afterwards
+/// the http threads serve the item without touching the object.
+/// The json snapshot is registered for the plain and the "compact=3"
+/// query used by JSROOT. Returns kTRUE when both snapshots were produced.
+
+Bool_t THttpServer::CreateObjectSnapshot(const char *path)
+{
+   if ((path == 0) || (*path == 0)) return kFALSE;
+
+   void *bindata = 0;
+   Long_t bindatalen = 0;
+   TString str;
+
+   if (!fSniffer->Produce(path, "root.json", "compact=3", bindata, bindatalen, str)) return kFALSE;
+   RegisterSnapshot(path, "root.json", str.Data(), str.Length(), "application/json", 0);
+   RegisterSnapshot(path, "root.json", str.Data(), str.Length(), "application/json", "compact=3");
+
+   str.Clear();
+   if (!fSniffer->Produce(path, "root.bin", "", bindata, bindatalen, str)) return kFALSE;
+   Bool_t res = RegisterSnapshot(path, "root.bin", bindata, bindatalen, "application/x-binary", 0);
+   free(bindata);
+
+   return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove registered snapshots for the item with path "path", so requests
+/// are processed in the main thread again; when path==0 all snapshots are
+/// removed. Buffers still referenced by replies in flight stay alive.
+
+void THttpServer::ClearSnapshots(const char *path)
+{
+   std::unique_lock<std::mutex> lk(fSnapshotMutex);
+   if (path == 0) {
+      fSnapshots.clear();
+      return;
+   }
+
+   while (*path == '/') path++;
+
+   std::string prefix = path;
+   if (!prefix.empty() && (prefix[prefix.length()-1] == '/')) prefix.resize(prefix.length()-1);
+   prefix.append("/");
+
+   std::map<std::string, Snapshot_t>::iterator iter = fSnapshots.begin();
+   while (iter != fSnapshots.end()) {
+      if (iter->first.compare(0, prefix.length(), prefix) == 0)
+         fSnapshots.erase(iter++);
+      else
+         iter++;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns MIME type base on file extension
 
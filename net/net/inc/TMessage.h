@@ -46,9 +46,15 @@ private:
    char    *fBufComp;     //Compressed buffer
    char    *fBufCompCur;  //Current position in compressed buffer
    char    *fCompPos;     //Position of fBufCur when message was compressed
+   Int_t    fBufCompSize; //!Allocated size of fBufComp, needed to pool it across messages
    Bool_t   fEvolution;   //True if support for schema evolution required
 
    static Bool_t fgEvolution;  //True if global support for schema evolution required
+   static Int_t  fgCompressionThreads; //Number of threads compressing large messages, <=1: in-line
+
+   char    *AllocCompBuffer(Int_t size);
+   void     FreeCompBuffer();
+   Int_t    CompressParallel();
 
    // TMessage objects cannot be copied or assigned
    TMessage(const TMessage &);           // not implemented
@@ -92,6 +98,8 @@ public:
 
    static void   EnableSchemaEvolutionForAll(Bool_t enable = kTRUE);
    static Bool_t UsesSchemaEvolutionForAll();
+   static void   SetCompressionThreads(Int_t nthreads);
+   static Int_t  GetCompressionThreads();
 
    ClassDef(TMessage,0)  // Message buffer class
 };
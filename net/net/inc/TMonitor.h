@@ -46,10 +46,16 @@ private:
    TSocket  *fReady;      //socket which is ready to be read or written
    Bool_t    fMainLoop;   //true if monitoring sockets within the main event loop
    Bool_t    fInterrupt;  //flags an interrupt to Select
+   Int_t     fEpollFd;    //!epoll instance used by Select(TList*,TList*,Long_t) on Linux, -1 when unavailable
 
    void  SetReady(TSocket *sock);
    void *GetSender() { return this; }  // used to get gTQSender
 
+   void  EpollAdd(Int_t fd, Int_t interest, void *handler);
+   void  EpollMod(Int_t fd, Int_t interest, void *handler);
+   void  EpollDel(Int_t fd);
+   Int_t EpollWait(TList *rdready, TList *wrready, Long_t timeout);
+
 public:
    enum EInterest { kRead = 1, kWrite = 2 };
 
@@ -26,6 +26,8 @@
 
 #include "TObject.h"
 
+#include "TString.h"
+
 class  TSQLRow;
 
 
@@ -44,6 +46,8 @@ public:
    virtual const char *GetFieldName(Int_t field) = 0;
    virtual Int_t       GetRowCount() const { return fRowCount; }
    virtual TSQLRow    *Next() = 0;
+   virtual Int_t       FetchBatch(Int_t nrows, Int_t nfields, const char *coltypes,
+                                  Double_t **numdata, Long64_t **intdata, TString **txtdata);
 
    ClassDef(TSQLResult,0)  // SQL query result
 };
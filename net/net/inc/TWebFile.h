@@ -44,6 +44,7 @@ protected:
    TUrl              fProxy;            // proxy URL
    Bool_t            fHasModRoot;       // true if server has mod_root installed
    Bool_t            fHTTP11;           // true if server support HTTP/1.1
+   Bool_t            fHasMultiRange;    //! true until the server answers a multi-range request with a single range
    Bool_t            fNoProxy;          // don't use proxy
    TString           fMsgReadBuffer;    // cache ReadBuffer() msg
    TString           fMsgReadBuffer10;  // cache ReadBuffer10() msg
@@ -56,6 +57,7 @@ protected:
 
    static TUrl       fgProxy;           // globally set proxy URL
    static Long64_t   fgMaxFullCacheSize; // maximal size of full-cached content, 500 MB by default
+   static Long64_t   fgReadGapTolerance; // max gap between ranges coalesced into one range, 8 kB by default
 
    virtual void        Init(Bool_t readHeadOnly);
    virtual void        CheckProxy();
@@ -69,6 +71,8 @@ protected:
    virtual Int_t       GetFromCache(char *buf, Int_t len, Int_t nseg, Long64_t *seg_pos, Int_t *seg_len);
    virtual Bool_t      ReadBuffer10(char *buf, Int_t len);
    virtual Bool_t      ReadBuffers10(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
+   virtual Bool_t      ReadBuffersPipelined10(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
+   virtual Int_t       RecvSingleRange10(char *buf, Int_t len);
    virtual void        SetMsgReadBuffer10(const char *redirectLocation = 0, Bool_t tempRedirect = kFALSE);
    virtual void        ProcessHttpHeader(const TString& headerLine);
 
@@ -91,6 +95,9 @@ public:
    static Long64_t    GetMaxFullCacheSize();
    static void        SetMaxFullCacheSize(Long64_t sz);
 
+   static Long64_t    GetReadGapTolerance();
+   static void        SetReadGapTolerance(Long64_t gap);
+
    ClassDef(TWebFile,2)  //A ROOT file that reads via a http server
 };
 
@@ -27,7 +27,46 @@
 #include "TProcessID.h"
 #include "RZip.h"
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 Bool_t TMessage::fgEvolution = kFALSE;
+Int_t  TMessage::fgCompressionThreads = 0;
+
+namespace {
+
+   // Pool of compression buffers reused across messages: event-builder style
+   // traffic allocates and frees one large fBufComp per message, which is
+   // pure overhead once the message sizes have stabilized.
+   const Int_t kMaxPooledCompBuffers = 8;
+
+   // Block size of the parallel compression path.  Smaller than kMAXZIPBUF
+   // so that medium-sized messages split into enough blocks to keep the
+   // threads busy; every block carries its own 9 byte R__zip header, so the
+   // wire format is unchanged and TMessage::Uncompress reads it as is.
+   const Int_t kParallelZipBlock = 0x100000;
+
+   struct PooledCompBuffer_t {
+      char *fBuf;
+      Int_t fSize;
+   };
+
+   std::mutex &CompBufferPoolMutex()
+   {
+      static std::mutex mutex;
+      return mutex;
+   }
+
+   std::vector<PooledCompBuffer_t> &CompBufferPool()
+   {
+      static std::vector<PooledCompBuffer_t> pool;
+      return pool;
+   }
+
+}
 
 
 ClassImp(TMessage)
@@ -58,6 +97,7 @@ TMessage::TMessage(UInt_t what, Int_t bufsiz) :
    fBufComp    = 0;
    fBufCompCur = 0;
    fCompPos    = 0;
+   fBufCompSize = 0;
    fInfos      = 0;
    fEvolution  = kFALSE;
 
@@ -79,6 +119,7 @@ TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsi
    fBufComp    = 0;
    fBufCompCur = 0;
    fCompPos    = 0;
+   fBufCompSize = 0;
    fInfos      = 0;
    fEvolution  = kFALSE;
 
@@ -86,6 +127,7 @@ TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsi
       // if buffer has kMESS_ZIP set, move it to fBufComp and uncompress
       fBufComp    = fBuffer;
       fBufCompCur = fBuffer + bufsize;
+      fBufCompSize = bufsize;
       fBuffer     = 0;
       Uncompress();
    }
@@ -105,7 +147,7 @@ TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsi
 
 TMessage::~TMessage()
 {
-   delete [] fBufComp;
+   FreeCompBuffer();
    delete fInfos;
 }
 
@@ -174,10 +216,7 @@ void TMessage::Reset()
    ResetMap();
 
    if (fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = 0;
-      fBufCompCur = 0;
-      fCompPos    = 0;
+      FreeCompBuffer();
    }
 }
 
@@ -232,10 +271,7 @@ void TMessage::SetCompressionAlgorithm(Int_t algorithm)
       newCompress = 100 * algorithm + level;
    }
    if (newCompress != fCompress && fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = 0;
-      fBufCompCur = 0;
-      fCompPos    = 0;
+      FreeCompBuffer();
    }
    fCompress = newCompress;
 }
@@ -255,10 +291,7 @@ void TMessage::SetCompressionLevel(Int_t level)
       newCompress = 100 * algorithm + level;
    }
    if (newCompress != fCompress && fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = 0;
-      fBufCompCur = 0;
-      fCompPos    = 0;
+      FreeCompBuffer();
    }
    fCompress = newCompress;
 }
@@ -268,10 +301,7 @@ void TMessage::SetCompressionLevel(Int_t level)
 void TMessage::SetCompressionSettings(Int_t settings)
 {
    if (settings != fCompress && fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = 0;
-      fBufCompCur = 0;
-      fCompPos    = 0;
+      FreeCompBuffer();
    }
    fCompress = settings;
 }
@@ -290,10 +320,7 @@ Int_t TMessage::Compress()
    if (compressionLevel <= 0) {
       // no compression specified
       if (fBufComp) {
-         delete [] fBufComp;
-         fBufComp    = 0;
-         fBufCompCur = 0;
-         fCompPos    = 0;
+         FreeCompBuffer();
       }
       return 0;
    }
@@ -305,10 +332,7 @@ Int_t TMessage::Compress()
 
    // remove any existing compressed buffer before compressing modified message
    if (fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = 0;
-      fBufCompCur = 0;
-      fCompPos    = 0;
+      FreeCompBuffer();
    }
 
    if (Length() <= (Int_t)(256 + 2*sizeof(UInt_t))) {
@@ -316,12 +340,18 @@ Int_t TMessage::Compress()
       return 0;
    }
 
+   if (fgCompressionThreads > 1 &&
+       Length() - (Int_t)(2*sizeof(UInt_t)) > 2*kParallelZipBlock) {
+      // large message and a compression thread count was configured
+      return CompressParallel();
+   }
+
    Int_t hdrlen   = 2*sizeof(UInt_t);
    Int_t messlen  = Length() - hdrlen;
    Int_t nbuffers = 1 + (messlen - 1) / kMAXZIPBUF;
    Int_t chdrlen  = 3*sizeof(UInt_t);   // compressed buffer header length
    Int_t buflen   = std::max(512, chdrlen + messlen + 9*nbuffers);
-   fBufComp       = new char[buflen];
+   fBufComp       = AllocCompBuffer(buflen);
    char *messbuf  = Buffer() + hdrlen;
    char *bufcur   = fBufComp + chdrlen;
    Int_t noutot   = 0;
@@ -335,10 +365,7 @@ Int_t TMessage::Compress()
       R__zipMultipleAlgorithm(compressionLevel, &bufmax, messbuf, &bufmax, bufcur, &nout, compressionAlgorithm);
       if (nout == 0 || nout >= messlen) {
          //this happens when the buffer cannot be compressed
-         delete [] fBufComp;
-         fBufComp    = 0;
-         fBufCompCur = 0;
-         fCompPos    = 0;
+         FreeCompBuffer();
          return -1;
       }
       bufcur  += nout;
@@ -358,6 +385,153 @@ Int_t TMessage::Compress()
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the message using GetCompressionThreads() worker threads, each
+/// compressing blocks of kParallelZipBlock bytes.  Every block carries its
+/// own R__zip header, exactly as in the sequential case, so the receiving
+/// end uncompresses the message without knowing how it was produced.
+/// Returns -1 in case of error, 0 otherwise.  Only called by Compress().
+
+Int_t TMessage::CompressParallel()
+{
+   Int_t compressionLevel = GetCompressionLevel();
+   Int_t compressionAlgorithm = GetCompressionAlgorithm();
+   Int_t hdrlen   = 2*sizeof(UInt_t);
+   Int_t messlen  = Length() - hdrlen;
+   Int_t nbuffers = 1 + (messlen - 1) / kParallelZipBlock;
+   Int_t chdrlen  = 3*sizeof(UInt_t);   // compressed buffer header length
+   Int_t slotlen  = kParallelZipBlock + 9;   // worst case output of one block
+   Int_t buflen   = std::max(512, chdrlen + nbuffers*slotlen);
+   fBufComp       = AllocCompBuffer(buflen);
+   char *messbuf  = Buffer() + hdrlen;
+
+   Int_t nthreads = std::min(fgCompressionThreads, nbuffers);
+   std::vector<Int_t> nouts(nbuffers, 0);
+
+   // each block is compressed into its own slot of fBufComp; the slots are
+   // compacted afterwards, so the threads never write to overlapping memory
+   auto compressBlocks = [&](Int_t ithread) {
+      for (Int_t i = ithread; i < nbuffers; i += nthreads) {
+         Int_t srclen = (i == nbuffers - 1) ? messlen - i*kParallelZipBlock
+                                            : kParallelZipBlock;
+         Int_t tgtlen = srclen;   // larger output counts as incompressible
+         Int_t nout   = 0;
+         R__zipMultipleAlgorithm(compressionLevel, &srclen,
+                                 messbuf + (Long_t)i*kParallelZipBlock, &tgtlen,
+                                 fBufComp + chdrlen + (Long_t)i*slotlen, &nout,
+                                 compressionAlgorithm);
+         nouts[i] = nout;
+      }
+   };
+
+   std::vector<std::thread> team;
+   team.reserve(nthreads - 1);
+   for (Int_t ithread = 1; ithread < nthreads; ++ithread)
+      team.emplace_back(compressBlocks, ithread);
+   compressBlocks(0);
+   for (auto &worker : team)
+      worker.join();
+
+   // compact the blocks and add up the output length
+   char *bufcur = fBufComp + chdrlen;
+   Int_t noutot = 0;
+   for (Int_t i = 0; i < nbuffers; ++i) {
+      if (nouts[i] == 0) {
+         //this happens when the buffer cannot be compressed
+         FreeCompBuffer();
+         return -1;
+      }
+      char *slot = fBufComp + chdrlen + (Long_t)i*slotlen;
+      if (bufcur != slot)
+         memmove(bufcur, slot, nouts[i]);
+      bufcur += nouts[i];
+      noutot += nouts[i];
+   }
+   if (noutot >= messlen) {
+      FreeCompBuffer();
+      return -1;
+   }
+   fBufCompCur = bufcur;
+   fCompPos    = fBufCur;
+
+   bufcur = fBufComp;
+   tobuf(bufcur, (UInt_t)(CompLength() - sizeof(UInt_t)));
+   Int_t what = fWhat | kMESS_ZIP;
+   tobuf(bufcur, what);
+   tobuf(bufcur, Length());    // original uncompressed buffer length
+
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take a compression buffer of at least the requested size from the pool,
+/// or allocate a new one.  Also records the allocated size in fBufCompSize.
+
+char *TMessage::AllocCompBuffer(Int_t size)
+{
+   {
+      std::lock_guard<std::mutex> lock(CompBufferPoolMutex());
+      std::vector<PooledCompBuffer_t> &pool = CompBufferPool();
+      Int_t best = -1;
+      for (UInt_t i = 0; i < pool.size(); ++i) {
+         if (pool[i].fSize >= size && (best < 0 || pool[i].fSize < pool[best].fSize))
+            best = (Int_t)i;
+      }
+      if (best >= 0) {
+         char *buf    = pool[best].fBuf;
+         fBufCompSize = pool[best].fSize;
+         pool.erase(pool.begin() + best);
+         return buf;
+      }
+   }
+   fBufCompSize = size;
+   return new char[size];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the compression buffer to the pool (or free it when the pool is
+/// full) and clear the compression state of the message.
+
+void TMessage::FreeCompBuffer()
+{
+   if (fBufComp) {
+      std::lock_guard<std::mutex> lock(CompBufferPoolMutex());
+      std::vector<PooledCompBuffer_t> &pool = CompBufferPool();
+      if ((Int_t)pool.size() < kMaxPooledCompBuffers) {
+         PooledCompBuffer_t pooled;
+         pooled.fBuf  = fBufComp;
+         pooled.fSize = fBufCompSize;
+         pool.push_back(pooled);
+      } else {
+         delete [] fBufComp;
+      }
+   }
+   fBufComp     = 0;
+   fBufCompCur  = 0;
+   fCompPos     = 0;
+   fBufCompSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function setting the number of threads used to compress messages
+/// larger than 2 MBytes.  The default of 0 keeps the historical in-line
+/// compression; event builders pushing a multi-Gb/s stream of large
+/// messages typically set 2-4.
+
+void TMessage::SetCompressionThreads(Int_t nthreads)
+{
+   fgCompressionThreads = nthreads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning the number of threads used to compress large
+/// messages; <=1 means in-line compression.
+
+Int_t TMessage::GetCompressionThreads()
+{
+   return fgCompressionThreads;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Uncompress the message. The message will only be uncompressed when
 /// kMESS_ZIP is set. Returns -1 in case of error, 0 otherwise.
@@ -30,6 +30,13 @@
 #include "TTimer.h"
 #include "TError.h"
 
+#ifdef R__LINUX
+#include <cstring>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
 
 //---- Socket event handler ----------------------------------------------------
 //
@@ -43,6 +50,7 @@ private:
 
 public:
    TSocketHandler(TMonitor *m, TSocket *s, Int_t interest, Bool_t mainloop = kTRUE);
+   virtual ~TSocketHandler();
    Bool_t   Notify();
    Bool_t   ReadNotify() { return Notify(); }
    Bool_t   WriteNotify() { return Notify(); }
@@ -57,10 +65,18 @@ TSocketHandler::TSocketHandler(TMonitor *m, TSocket *s,
    fMonitor = m;
    fSocket  = s;
 
+   fMonitor->EpollAdd(s->GetDescriptor(), interest, this);
+
    if (mainloop)
       Add();
 }
 
+TSocketHandler::~TSocketHandler()
+{
+   //destructor
+   fMonitor->EpollDel(GetFd());
+}
+
 Bool_t TSocketHandler::Notify()
 {
    //notifier
@@ -110,6 +126,11 @@ TMonitor::TMonitor(Bool_t mainloop) : TObject() , TQObject()
 {
    R__ASSERT(gSystem);
 
+#ifdef R__LINUX
+   fEpollFd = epoll_create1(0);
+#else
+   fEpollFd = -1;
+#endif
    fActive    = new TList;
    fDeActive  = new TList;
    fMainLoop  = mainloop;
@@ -122,6 +143,11 @@ TMonitor::TMonitor(Bool_t mainloop) : TObject() , TQObject()
 
 TMonitor::TMonitor(const TMonitor &m) : TObject() , TQObject()
 {
+#ifdef R__LINUX
+   fEpollFd = epoll_create1(0);
+#else
+   fEpollFd = -1;
+#endif
    TSocketHandler *sh = 0;
    // Active list
    fActive   = new TList;
@@ -139,7 +165,9 @@ TMonitor::TMonitor(const TMonitor &m) : TObject() , TQObject()
       Int_t mask = 0;
       if (sh->HasReadInterest()) mask |= 0x1;
       if (sh->HasWriteInterest()) mask |= 0x2;
-      fDeActive->Add(new TSocketHandler(this, sh->GetSocket(), mask, m.fMainLoop));
+      TSocketHandler *nh = new TSocketHandler(this, sh->GetSocket(), mask, m.fMainLoop);
+      fDeActive->Add(nh);
+      EpollDel(nh->GetFd());   // deactivated sockets are not watched
    }
    // Other members
    fMainLoop = m.fMainLoop;
@@ -157,6 +185,13 @@ TMonitor::~TMonitor()
 
    fDeActive->Delete();
    SafeDelete(fDeActive);
+
+#ifdef R__LINUX
+   if (fEpollFd != -1) {
+      close(fEpollFd);
+      fEpollFd = -1;
+   }
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -189,6 +224,7 @@ void TMonitor::SetInterest(TSocket *sock, Int_t interest)
    while ((s = (TSocketHandler *) next())) {
       if (sock == s->GetSocket()) {
          s->SetInterest(interest);
+         EpollMod(s->GetFd(), interest, s);
          return;
       }
    }
@@ -200,6 +236,7 @@ void TMonitor::SetInterest(TSocket *sock, Int_t interest)
          fDeActive->Remove(s);
          fActive->Add(s);
          s->SetInterest(interest);
+         EpollMod(s->GetFd(), interest, s);
          return;
       }
    }
@@ -257,6 +294,10 @@ void TMonitor::Activate(TSocket *sock)
          fDeActive->Remove(s);
          fActive->Add(s);
          s->Add();
+         Int_t mask = 0;
+         if (s->HasReadInterest()) mask |= kRead;
+         if (s->HasWriteInterest()) mask |= kWrite;
+         EpollAdd(s->GetFd(), mask, s);
          return;
       }
    }
@@ -273,6 +314,10 @@ void TMonitor::ActivateAll()
    while ((s = (TSocketHandler *) next())) {
       fActive->Add(s);
       s->Add();
+      Int_t mask = 0;
+      if (s->HasReadInterest()) mask |= kRead;
+      if (s->HasWriteInterest()) mask |= kWrite;
+      EpollAdd(s->GetFd(), mask, s);
    }
    fDeActive->Clear();
    fInterrupt = kFALSE;
@@ -291,6 +336,7 @@ void TMonitor::DeActivate(TSocket *sock)
          fActive->Remove(s);
          fDeActive->Add(s);
          s->Remove();
+         EpollDel(s->GetFd());
          return;
       }
    }
@@ -307,6 +353,7 @@ void TMonitor::DeActivateAll()
    while ((s = (TSocketHandler *) next())) {
       fDeActive->Add(s);
       s->Remove();
+      EpollDel(s->GetFd());
    }
    fActive->Clear();
    fInterrupt = kFALSE;
@@ -380,6 +427,13 @@ Int_t TMonitor::Select(TList *rdready, TList *wrready, Long_t timeout)
 
    TSocketHandler *h = 0;
    Int_t ns = fActive->GetSize();
+#ifdef R__LINUX
+   if (fEpollFd != -1 && ns > 0) {
+      // O(ready) dispatch: the kernel hands back only the ready descriptors,
+      // no linear scan over the (possibly thousands of) monitored sockets
+      return EpollWait(rdready, wrready, timeout);
+   }
+#endif
    if (ns == 1) {
       // Avoid additional loops inside
       h = (TSocketHandler *)fActive->First();
@@ -414,6 +468,118 @@ Int_t TMonitor::Select(TList *rdready, TList *wrready, Long_t timeout)
    return nr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Register the descriptor of a monitored socket with the epoll instance.
+/// On a registration failure (e.g. a descriptor epoll cannot watch) the
+/// instance is closed and the monitor falls back to the select() path for
+/// its whole lifetime.  No-op on platforms without epoll.
+
+void TMonitor::EpollAdd(Int_t fd, Int_t interest, void *handler)
+{
+#ifdef R__LINUX
+   if (fEpollFd == -1 || fd < 0) return;
+   struct epoll_event ev;
+   memset(&ev, 0, sizeof(ev));
+   if (interest & kRead)  ev.events |= EPOLLIN;
+   if (interest & kWrite) ev.events |= EPOLLOUT;
+   ev.data.ptr = handler;
+   if (epoll_ctl(fEpollFd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+      if (errno == EEXIST) {
+         epoll_ctl(fEpollFd, EPOLL_CTL_MOD, fd, &ev);
+      } else {
+         close(fEpollFd);
+         fEpollFd = -1;
+      }
+   }
+#else
+   if (fd < 0 || interest < 0 || !handler) return;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update the interest mask of an already registered descriptor; registers
+/// it when it is not known to the epoll instance (e.g. the socket was
+/// deactivated in between).  No-op on platforms without epoll.
+
+void TMonitor::EpollMod(Int_t fd, Int_t interest, void *handler)
+{
+#ifdef R__LINUX
+   if (fEpollFd == -1 || fd < 0) return;
+   struct epoll_event ev;
+   memset(&ev, 0, sizeof(ev));
+   if (interest & kRead)  ev.events |= EPOLLIN;
+   if (interest & kWrite) ev.events |= EPOLLOUT;
+   ev.data.ptr = handler;
+   if (epoll_ctl(fEpollFd, EPOLL_CTL_MOD, fd, &ev) == -1 && errno == ENOENT)
+      epoll_ctl(fEpollFd, EPOLL_CTL_ADD, fd, &ev);
+#else
+   if (fd < 0 || interest < 0 || !handler) return;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop watching a descriptor.  No-op on platforms without epoll.
+
+void TMonitor::EpollDel(Int_t fd)
+{
+#ifdef R__LINUX
+   if (fEpollFd == -1 || fd < 0) return;
+   epoll_ctl(fEpollFd, EPOLL_CTL_DEL, fd, 0);
+#else
+   if (fd < 0) return;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for activity on the registered descriptors and fill the ready
+/// lists; only called by Select(TList*,TList*,Long_t) when the epoll
+/// instance is available.  Same return convention as TSystem::Select:
+/// the number of ready sockets, 0 on timeout, -2 on interrupt, -3 on
+/// a bad descriptor, -1 on any other error.
+
+Int_t TMonitor::EpollWait(TList *rdready, TList *wrready, Long_t timeout)
+{
+#ifdef R__LINUX
+   struct epoll_event events[64];
+   Int_t to = (timeout < 0) ? -1 : (Int_t)timeout;
+   Int_t nev = epoll_wait(fEpollFd, events, 64, to);
+   if (nev < 0) {
+      if (errno == EINTR) {
+         TSystem::ResetErrno();
+         return -2;
+      }
+      if (errno == EBADF)
+         return -3;
+      return -1;
+   }
+   if (nev == 0)
+      return 0;
+
+   if (rdready) rdready->Clear();
+   if (wrready) wrready->Clear();
+
+   Int_t nr = 0;
+   for (Int_t i = 0; i < nev; ++i) {
+      TSocketHandler *h = (TSocketHandler *) events[i].data.ptr;
+      Bool_t ready = kFALSE;
+      // errors and hang-ups are reported as read readiness, like select()
+      if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+         if (rdready) rdready->Add(h->GetSocket());
+         ready = kTRUE;
+      }
+      if (events[i].events & EPOLLOUT) {
+         if (wrready) wrready->Add(h->GetSocket());
+         ready = kTRUE;
+      }
+      if (ready) nr++;
+   }
+   return nr;
+#else
+   if (rdready || wrready || timeout) { }
+   return -1;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Called by TSocketHandler::Notify() to signal which socket is ready
 /// to be read or written. User should not call this routine. The ready
@@ -21,5 +21,71 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TSQLResult.h"
+#include "TSQLRow.h"
+
+#include <stdlib.h>
 
 ClassImp(TSQLResult)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fetch up to nrows rows of the result set into typed columnar buffers
+/// in one call.
+///
+/// coltypes[i] describes field i of the result set:
+/// -  'D' : the field is converted to Double_t and stored in numdata[i]
+/// -  'L' : the field is converted to Long64_t and stored in intdata[i]
+/// -  'C' : the field is copied as text into txtdata[i]
+///
+/// Each used buffer must have room for nrows elements; buffers of fields
+/// with other type letters are skipped. NULL fields are stored as 0
+/// resp. as empty string.
+///
+/// This generic implementation loops over Next() and converts every
+/// field from its string representation. Concrete result classes should
+/// override it and fill the buffers directly from the database client
+/// library, avoiding the TSQLRow allocation per row and the string
+/// conversion per field.
+///
+/// Returns the number of rows stored, 0 at the end of the result set
+/// and -1 in case of error.
+
+Int_t TSQLResult::FetchBatch(Int_t nrows, Int_t nfields, const char *coltypes,
+                             Double_t **numdata, Long64_t **intdata, TString **txtdata)
+{
+   if (nrows <= 0 || nfields <= 0 || !coltypes)
+      return -1;
+   if (nfields > GetFieldCount())
+      nfields = GetFieldCount();
+
+   Int_t nstored = 0;
+   while (nstored < nrows) {
+      TSQLRow *row = Next();
+      if (!row) break;
+      for (Int_t i = 0; i < nfields; i++) {
+         const char *field = row->GetField(i);
+         switch (coltypes[i]) {
+            case 'D':
+               if (numdata && numdata[i])
+                  numdata[i][nstored] = field ? atof(field) : 0;
+               break;
+            case 'L':
+               if (intdata && intdata[i])
+#ifdef R__WIN32
+                  intdata[i][nstored] = field ? _atoi64(field) : 0;
+#else
+                  intdata[i][nstored] = field ? atoll(field) : 0;
+#endif
+               break;
+            case 'C':
+               if (txtdata && txtdata[i])
+                  txtdata[i][nstored] = field ? field : "";
+               break;
+            default:
+               break;
+         }
+      }
+      delete row;
+      nstored++;
+   }
+   return nstored;
+}
@@ -33,6 +33,7 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 #ifdef WIN32
 # ifndef EADDRINUSE
@@ -49,6 +50,8 @@ TUrl TWebFile::fgProxy;
 
 Long64_t TWebFile::fgMaxFullCacheSize = 500000000;
 
+Long64_t TWebFile::fgReadGapTolerance = 8192;
+
 
 // Internal class used to manage the socket that may stay open between
 // calls when HTTP/1.1 protocol is used
@@ -216,6 +219,7 @@ void TWebFile::Init(Bool_t readHeadOnly)
    fSize       = -1;
    fHasModRoot = kFALSE;
    fHTTP11     = kFALSE;
+   fHasMultiRange = kTRUE;
    fFullCache  = 0;
    fFullCacheSize = 0;
    SetMsgReadBuffer10();
@@ -549,31 +553,265 @@ Bool_t TWebFile::ReadBuffers10(char *buf,  Long64_t *pos, Int_t *len, Int_t nbuf
 {
    SetMsgReadBuffer10();
 
-   TString msg = fMsgReadBuffer10;
+   // Coalesce ranges separated by less than fgReadGapTolerance bytes into
+   // a single range: reading a small gap twice is much cheaper than the
+   // extra range, which counts against server limits like Apache MaxRanges
+   // and costs a full round trip when ranges are fetched one by one.
+   std::vector<Long64_t> cpos;
+   std::vector<Int_t>    clen;
+   if (nbuf > 1 && fgReadGapTolerance > 0) {
+      Bool_t sorted = kTRUE;
+      for (Int_t i = 1; i < nbuf; i++) {
+         if (pos[i] < pos[i-1] + len[i-1]) {
+            sorted = kFALSE;
+            break;
+         }
+      }
+      if (sorted) {
+         cpos.push_back(pos[0]);
+         clen.push_back(len[0]);
+         for (Int_t i = 1; i < nbuf; i++) {
+            Long64_t end = cpos.back() + clen.back();
+            Long64_t mergedlen = pos[i] + len[i] - cpos.back();
+            if (pos[i] - end <= fgReadGapTolerance && mergedlen < kMaxInt)
+               clen.back() = Int_t(mergedlen);
+            else {
+               cpos.push_back(pos[i]);
+               clen.push_back(len[i]);
+            }
+         }
+         if ((Int_t)cpos.size() == nbuf) {
+            cpos.clear();
+            clen.clear();
+         }
+      }
+   }
+
+   char     *rbuf  = buf;
+   Long64_t *rpos  = pos;
+   Int_t    *rlen  = len;
+   Int_t     rnbuf = nbuf;
+   std::vector<char> merged;
+   if (!cpos.empty()) {
+      Long64_t tot = 0;
+      for (size_t i = 0; i < clen.size(); i++) tot += clen[i];
+      merged.resize(tot);
+      rbuf  = &merged[0];
+      rpos  = &cpos[0];
+      rlen  = &clen[0];
+      rnbuf = (Int_t)cpos.size();
+      if (gDebug > 0)
+         Info("ReadBuffers10", "coalesced %d ranges into %d (gap tolerance %lld)",
+              nbuf, rnbuf, fgReadGapTolerance);
+   }
+
+   Bool_t fail = kFALSE;
+
+   if (!fHasMultiRange && rnbuf > 1) {
+      fail = ReadBuffersPipelined10(rbuf, rpos, rlen, rnbuf);
+   } else {
+      TString msg = fMsgReadBuffer10;
+
+      Int_t k = 0, n = 0, r, cnt = 0;
+      for (Int_t i = 0; i < rnbuf; i++) {
+         if (n) msg += ",";
+         msg += rpos[i] + fArchiveOffset;
+         msg += "-";
+         msg += rpos[i] + fArchiveOffset + rlen[i] - 1;
+         n   += rlen[i];
+         cnt++;
+         if ((msg.Length() > 8000) || (cnt >= 200) || (i+1 == rnbuf)) {
+            msg += "\r\n\r\n";
+            r = GetFromWeb10(&rbuf[k], n, msg, cnt, rpos + (i+1-cnt), rlen + (i+1-cnt));
+            if (r == -3) {
+               // the server answered the multi-range request with a single
+               // range: remember it and re-issue the whole set as pipelined
+               // single-range requests
+               fHasMultiRange = kFALSE;
+               fail = ReadBuffersPipelined10(rbuf, rpos, rlen, rnbuf);
+               break;
+            }
+            if (r == -1) {
+               fail = kTRUE;
+               break;
+            }
+            msg = fMsgReadBuffer10;
+            k += n;
+            n = 0;
+            cnt = 0;
+         }
+      }
+   }
+
+   if (fail)
+      return kTRUE;
+
+   if (!merged.empty()) {
+      // scatter the requested blocks out of the coalesced ranges
+      Int_t iseg = 0, curr = 0;
+      Long64_t segoff = 0;
+      for (Int_t i = 0; i < nbuf; i++) {
+         while (pos[i] >= rpos[iseg] + rlen[iseg]) {
+            segoff += rlen[iseg];
+            iseg++;
+         }
+         memcpy(&buf[curr], &merged[segoff + (pos[i] - rpos[iseg])], len[i]);
+         curr += len[i];
+      }
+   }
+
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the specified byte ranges as pipelined single-range requests:
+/// a batch of requests is written back to back on the kept alive socket
+/// and the responses are collected in order, so the round trip latency is
+/// paid once per batch instead of once per range. This is used when the
+/// server does not honor multi-range requests; without HTTP/1.1 the
+/// connection closes after every response and the batch size drops to one.
+/// Returns kTRUE in case of failure.
+
+Bool_t TWebFile::ReadBuffersPipelined10(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+   Double_t start = 0;
+   if (gPerfStats) start = TTimeStamp();
 
-   Int_t k = 0, n = 0, r, cnt = 0;
+   // open fSocket and close it when going out of scope
+   TWebSocket ws(this);
+
+   if (!fSocket || !fSocket->IsValid()) {
+      Error("ReadBuffersPipelined10", "cannot connect to host %s", fUrl.GetHost());
+      return kTRUE;
+   }
+
+   // buffer offset of each block
+   std::vector<Int_t> boff(nbuf);
+   Int_t ntot = 0;
    for (Int_t i = 0; i < nbuf; i++) {
-      if (n) msg += ",";
-      msg += pos[i] + fArchiveOffset;
-      msg += "-";
-      msg += pos[i] + fArchiveOffset + len[i] - 1;
-      n   += len[i];
-      cnt++;
-      if ((msg.Length() > 8000) || (cnt >= 200) || (i+1 == nbuf)) {
-         msg += "\r\n\r\n";
-         r = GetFromWeb10(&buf[k], n, msg, cnt, pos + (i+1-cnt), len + (i+1-cnt));
-         if (r == -1)
+      boff[i] = ntot;
+      ntot += len[i];
+   }
+
+   const Int_t kDepth = fHTTP11 ? 8 : 1;
+
+   Int_t i = 0;          // next range whose response is expected
+   Int_t sent = 0;       // number of requests already written
+   Int_t lastReopen = -1;
+   while (i < nbuf) {
+      if (sent <= i) {
+         Int_t batch = nbuf - sent;
+         if (batch > kDepth) batch = kDepth;
+         TString msg;
+         for (Int_t j = 0; j < batch; j++) {
+            msg += fMsgReadBuffer10;
+            msg += pos[sent+j] + fArchiveOffset;
+            msg += "-";
+            msg += pos[sent+j] + fArchiveOffset + len[sent+j] - 1;
+            msg += "\r\n\r\n";
+         }
+         if (fSocket->SendRaw(msg.Data(), msg.Length()) == -1) {
+            Error("ReadBuffersPipelined10", "error sending command to host %s", fUrl.GetHost());
             return kTRUE;
-         msg = fMsgReadBuffer10;
-         k += n;
-         n = 0;
-         cnt = 0;
+         }
+         sent += batch;
+      }
+
+      Int_t r = RecvSingleRange10(&buf[boff[i]], len[i]);
+      if (r == -1)
+         return kTRUE;
+      if (r == -2) {
+         // connection was closed before the response arrived:
+         // reopen it and resend the not yet answered requests
+         if (lastReopen == i) {
+            Error("ReadBuffersPipelined10", "connection to host %s keeps closing", fUrl.GetHost());
+            return kTRUE;
+         }
+         lastReopen = i;
+         ws.ReOpen();
+         if (!fSocket || !fSocket->IsValid()) {
+            Error("ReadBuffersPipelined10", "cannot connect to host %s", fUrl.GetHost());
+            return kTRUE;
+         }
+         sent = i;
+         continue;
       }
+      i++;
    }
 
+   // collect statistics
+   fBytesRead += ntot;
+   fReadCalls++;
+#ifdef R__WIN32
+   SetFileBytesRead(GetFileBytesRead() + ntot);
+   SetFileReadCalls(GetFileReadCalls() + 1);
+#else
+   fgBytesRead += ntot;
+   fgReadCalls++;
+#endif
+
+   if (gPerfStats)
+      gPerfStats->FileReadEvent(this, ntot, start);
+
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Receive one single-range response from the open socket and store its
+/// payload, expected to be len bytes long, in buf.
+/// Returns 0 in case of success, -1 in case of error and -2 if the
+/// connection was closed by the server before the response arrived.
+
+Int_t TWebFile::RecvSingleRange10(char *buf, Int_t len)
+{
+   char line[8192];
+   Int_t n;
+   Long64_t first = -1, last = -1, tot;
+
+   while ((n = GetLine(fSocket, line, sizeof(line))) >= 0) {
+      if (n == 0)
+         break;
+
+      if (gDebug > 0)
+         Info("RecvSingleRange10", "header: %s", line);
+
+      TString res = line;
+      if (res.BeginsWith("HTTP/1.")) {
+         if (res.BeginsWith("HTTP/1.1"))
+            fHTTP11 = kTRUE;
+         TString scode = res(9, 3);
+         Int_t code = scode.Atoi();
+         if (code != 206) {
+            TString mess = res(13, 1000);
+            Error("RecvSingleRange10", "%s: %s (%d)", fBasicUrl.Data(), mess.Data(), code);
+            return -1;
+         }
+      } else if (res.BeginsWith("Content-range:") || res.BeginsWith("Content-Range:")) {
+#ifdef R__WIN32
+         sscanf(res.Data()+14, " bytes %I64d-%I64d/%I64d", &first, &last, &tot);
+#else
+         sscanf(res.Data()+14, " bytes %lld-%lld/%lld", &first, &last, &tot);
+#endif
+         if (fSize == -1) fSize = tot;
+      }
+   }
+
+   if (n < 0)
+      return -2;
+
+   if (first < 0 || Int_t(last - first) + 1 != len) {
+      Error("RecvSingleRange10", "expected %d bytes, server announced %lld", len, first < 0 ? -1 : last - first + 1);
+      return -1;
+   }
+
+   if (fSocket->RecvRaw(buf, len) != len) {
+      Error("RecvSingleRange10", "error receiving data from host %s", fUrl.GetHost());
+      return -1;
+   }
+
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Extract requested segments from the cached content.
 /// Such cache can be produced when server suddenly returns full data instead of segments
@@ -943,6 +1181,14 @@ Int_t TWebFile::GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nse
       return GetFromWeb10(buf, len, msg);
    }
 
+   if (nseg > 1 && boundary == "" && ret == 0 && fullsize == 0 && ltot > 0 && ltot < len) {
+      // the server answered a multi-range request with a single range only:
+      // let the caller switch to pipelined single-range requests
+      if (gDebug > 0)
+         Info("GetFromWeb10", "server %s does not support multi-range requests", fUrl.GetHost());
+      return -3;
+   }
+
    if (ltot != len) {
       Error("GetFromWeb10", "error receiving expected amount of data (got %d, expected %d) from host %s",
             ltot, len, fUrl.GetHost());
@@ -1437,6 +1683,24 @@ void TWebFile::SetMaxFullCacheSize(Long64_t sz)
    fgMaxFullCacheSize = sz;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static method returning the maximal gap between two requested byte
+/// ranges that is read as part of a single coalesced range
+
+Long64_t TWebFile::GetReadGapTolerance()
+{
+   return fgReadGapTolerance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static method, set the maximal gap between two requested byte ranges
+/// that is read as part of a single coalesced range; 0 disables coalescing
+
+void TWebFile::SetReadGapTolerance(Long64_t gap)
+{
+   fgReadGapTolerance = gap;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Create helper class that allows directory access via httpd.
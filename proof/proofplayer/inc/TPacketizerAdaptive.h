@@ -81,6 +81,8 @@ private:
                                        // It can be set with PROOF_PacketAsAFraction in input list.
    Int_t          fStrategy;           // 0 means the classic and 1 (default) - the adaptive strategy
    Int_t          fTryReassign;        // Controls attempts to reassign packets (0 == no reassignment)
+   Float_t        fRateDecay;          // decay factor of the exponentially-weighted per-worker rates
+   Float_t        fRemotePenalty;      // locality score penalty for files without workers on their server
 
    TPacketizerAdaptive();
    TPacketizerAdaptive(const TPacketizerAdaptive&);    // no implementation, will generate
@@ -88,6 +90,7 @@ private:
    void operator=(const TPacketizerAdaptive&);         // error on accidental usage
 
    TFileNode     *NextNode();
+   TFileNode     *NextNodeLocAware();
    void           RemoveUnAllocNode(TFileNode *);
 
    TFileNode     *NextActiveNode();
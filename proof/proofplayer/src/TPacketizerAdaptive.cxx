@@ -340,6 +340,7 @@ private:
    TDSetElement  *fCurElem;      // TDSetElement currently being processed
    Long64_t       fCurProcessed; // events processed in the current file
    Float_t        fCurProcTime;  // proc time spent on the current file
+   Float_t        fEwmaRate;     // exponentially-decayed processing rate
    TList         *fDSubSet;      // packets processed by this worker
 
 public:
@@ -350,8 +351,9 @@ public:
    Double_t    GetProcTime() const { return fStatus?fStatus->GetProcTime():-1; }
    TFileStat  *GetCurFile() { return fCurFile; }
    void        SetFileNode(TFileNode *node) { fFileNode = node; }
-   void        UpdateRates(TProofProgressStatus *st);
+   void        UpdateRates(TProofProgressStatus *st, Float_t decay);
    Float_t     GetAvgRate() { return fStatus->GetRate(); }
+   Float_t     GetEwmaRate() { return fEwmaRate; }
    Float_t     GetCurRate() {
       return (fCurProcTime?fCurProcessed/fCurProcTime:0); }
    Int_t       GetLocalEventsLeft() {
@@ -366,7 +368,7 @@ public:
 
 TPacketizerAdaptive::TSlaveStat::TSlaveStat(TSlave *slave)
    : fFileNode(0), fCurFile(0), fCurElem(0),
-     fCurProcessed(0), fCurProcTime(0)
+     fCurProcessed(0), fCurProcTime(0), fEwmaRate(0)
 {
    fDSubSet = new TList();
    fDSubSet->SetOwner();
@@ -397,12 +399,23 @@ TPacketizerAdaptive::TSlaveStat::~TSlaveStat()
 ////////////////////////////////////////////////////////////////////////////////
 /// Update packetizer rates
 
-void TPacketizerAdaptive::TSlaveStat::UpdateRates(TProofProgressStatus *st)
+void TPacketizerAdaptive::TSlaveStat::UpdateRates(TProofProgressStatus *st, Float_t decay)
 {
    if (!st) {
       Error("UpdateRates", "no status object!");
       return;
    }
+   // Continuous throughput feedback: fold the rate of the packet just
+   // reported into an exponentially-decayed average, so that on
+   // heterogeneous clusters the recent history dominates the estimate
+   // but single-packet fluctuations are smoothed out.
+   Double_t dt = st->GetProcTime() - GetProcTime();
+   Double_t dn = st->GetEntries() - GetEntriesProcessed();
+   if (dt > 0. && dn > 0.) {
+      Float_t instRate = dn / dt;
+      fEwmaRate = (fEwmaRate > 0.) ? decay * instRate + (1. - decay) * fEwmaRate
+                                   : instRate;
+   }
    if (fCurFile->IsDone()) {
       fCurProcTime = 0;
       fCurProcessed = 0;
@@ -559,6 +572,34 @@ TPacketizerAdaptive::TPacketizerAdaptive(TDSet *dset, TList *slaves,
          Info("TPacketizerAdaptive", "packetAsAFraction parameter must be higher than 0");
    }
 
+   // Decay factor of the exponentially-weighted per-worker rate estimates,
+   // in (0,1]: larger values make the packet sizing react faster to load
+   // changes on the worker, smaller values smooth more.
+   fRateDecay = 0.25;
+   Double_t rateDecay = 0.;
+   if (TProof::GetParameter(input, "PROOF_RateDecay", rateDecay) == 0) {
+      if (rateDecay > 0. && rateDecay <= 1.) {
+         fRateDecay = (Float_t)rateDecay;
+         Info("TPacketizerAdaptive",
+              "using alternate decay factor for worker rates: %f", rateDecay);
+      } else
+         Info("TPacketizerAdaptive", "PROOF_RateDecay must be in (0,1] !");
+   }
+
+   // Penalty applied in the locality score to file nodes which have no
+   // workers running on the file server itself, i.e. whose files can only
+   // be accessed remotely (e.g. via xrootd).
+   fRemotePenalty = 1.2;
+   Double_t remotePenalty = 0.;
+   if (TProof::GetParameter(input, "PROOF_RemotePenalty", remotePenalty) == 0) {
+      if (remotePenalty >= 1.) {
+         fRemotePenalty = (Float_t)remotePenalty;
+         Info("TPacketizerAdaptive",
+              "using alternate penalty for remote-only file nodes: %f", remotePenalty);
+      } else
+         Info("TPacketizerAdaptive", "PROOF_RemotePenalty must be >= 1 !");
+   }
+
    // Packet re-assignement
    fTryReassign = 0;
    Int_t tryReassign = 0;
@@ -576,6 +617,8 @@ TPacketizerAdaptive::TPacketizerAdaptive(TDSet *dset, TList *slaves,
    fConfigParams->Add(new TParameter<Int_t>("PROOF_MaxWorkersPerNode", (Int_t)fMaxSlaveCnt));
    fConfigParams->Add(new TParameter<Int_t>("PROOF_ForceLocal", (Int_t)fForceLocal));
    fConfigParams->Add(new TParameter<Int_t>("PROOF_PacketAsAFraction", fPacketAsAFraction));
+   fConfigParams->Add(new TParameter<Double_t>("PROOF_RateDecay", (Double_t)fRateDecay));
+   fConfigParams->Add(new TParameter<Double_t>("PROOF_RemotePenalty", (Double_t)fRemotePenalty));
 
    Double_t baseLocalPreference = 1.2;
    fBaseLocalPreference = (Float_t)baseLocalPreference;
@@ -985,7 +1028,7 @@ TPacketizerAdaptive::TFileStat *TPacketizerAdaptive::GetNextUnAlloc(TFileNode *n
       }
 
       if (node == 0) {
-         while (file == 0 && ((node = NextNode()) != 0)) {
+         while (file == 0 && ((node = NextNodeLocAware()) != 0)) {
             PDB(kPacketizer, 2)
                Info("GetNextUnAlloc", "looking for file on node %s", node->GetName());
             if ((file = node->GetNextUnAlloc()) == 0) RemoveUnAllocNode(node);
@@ -1033,6 +1076,41 @@ TPacketizerAdaptive::TFileNode *TPacketizerAdaptive::NextNode()
    return fn;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Score-based variant of NextNode, used when a worker has to be fed from a
+/// node other than its own. Each unallocated node is scored by the number of
+/// events left per worker; nodes which have no workers of their own - so
+/// their files can only be read remotely, e.g. over xrootd - have the score
+/// divided by fRemotePenalty. The node with the highest score is returned,
+/// skipping nodes which already reached the workers-per-node limit.
+
+TPacketizerAdaptive::TFileNode *TPacketizerAdaptive::NextNodeLocAware()
+{
+   TFileNode *best = 0;
+   Double_t bestScore = -1.;
+   TIter next(fUnAllocated);
+   TFileNode *fn = 0;
+   while ((fn = (TFileNode*) next())) {
+      if (fMaxSlaveCnt > 0 && fn->GetExtSlaveCnt() >= fMaxSlaveCnt) {
+         PDB(kPacketizer,1)
+            Info("NextNodeLocAware", "%s: reached Workers-per-Node Limit (%ld)",
+                                     fn->GetName(), fMaxSlaveCnt);
+         continue;
+      }
+      Double_t score = (Double_t) fn->GetEventsLeftPerSlave();
+      if (fn->GetMySlaveCnt() == 0 && fRemotePenalty > 1.)
+         score /= fRemotePenalty;
+      if (score > bestScore) {
+         bestScore = score;
+         best = fn;
+      }
+   }
+   PDB(kPacketizer,2)
+      if (best) Info("NextNodeLocAware", "chosen node: %s (score %f)",
+                     best->GetName(), bestScore);
+   return best;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove unallocated node.
 
@@ -1493,7 +1571,9 @@ Int_t TPacketizerAdaptive::CalculatePacketSize(TObject *slStatPtr, Long64_t cach
       // Calculates the packet size based on performance of this slave
       // and estimated time left until the end of the query.
       TSlaveStat* slstat = (TSlaveStat*)slStatPtr;
-      Float_t rate = slstat->GetCurRate();
+      Float_t rate = slstat->GetEwmaRate();
+      if (!rate)
+         rate = slstat->GetCurRate();
       if (!rate)
          rate = slstat->GetAvgRate();
       if (rate) {
@@ -1541,6 +1621,16 @@ Int_t TPacketizerAdaptive::CalculatePacketSize(TObject *slStatPtr, Long64_t cach
          // Translate the packet length in number of entries
          num = (Long64_t)(rate * packetTime);
 
+         // Shrink the packets in the tail of the query: once less than one
+         // full-size packet per worker is left, keep halving the assignments
+         // so that the remainder is re-balanced over the faster workers
+         // instead of having the end of the query decided by whoever got the
+         // last big packet.
+         Long64_t entriesLeft = fTotalEntries - GetEntriesProcessed();
+         Int_t nwrks = fSlaveStats->GetSize();
+         if (nwrks > 0 && num > entriesLeft / nwrks)
+            num = entriesLeft / (2 * nwrks);
+
          // Notify
          PDB(kPacketizer,2)
             Info("CalculatePacketSize","%s: avgr: %f, rate: %f, left: %lld, pacT: %f, sz: %f (csz: %f), num: %lld",
@@ -1599,7 +1689,7 @@ Int_t TPacketizerAdaptive::AddProcessed(TSlave *sl,
          if (progress) {
             (*fProgressStatus) += *progress;
             // update processing rate
-            slstat->UpdateRates(status);
+            slstat->UpdateRates(status, fRateDecay);
          }
       } else {
           progress = new TProofProgressStatus();
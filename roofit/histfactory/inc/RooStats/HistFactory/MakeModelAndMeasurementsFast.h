@@ -20,7 +20,12 @@ namespace RooStats{
 
     //void fastDriver(std::string input);
 
-    RooWorkspace* MakeModelAndMeasurementFast( RooStats::HistFactory::Measurement& measurement );
+    // nWorkers>1 builds the individual channel models in forked worker
+    // processes; a non-empty cacheDir reuses channel workspaces cached
+    // there from previous builds when the channel content is unchanged
+    RooWorkspace* MakeModelAndMeasurementFast( RooStats::HistFactory::Measurement& measurement,
+                                               Int_t nWorkers = 0,
+                                               const std::string& cacheDir = "" );
     //RooWorkspace* MakeModelFast( RooStats::HistFactory::Measurement& measurement );
 
     std::vector<RooStats::HistFactory::EstimateSummary> GetChannelEstimateSummaries(RooStats::HistFactory::Measurement& measurement, RooStats::HistFactory::Channel& channel);
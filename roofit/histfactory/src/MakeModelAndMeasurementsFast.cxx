@@ -82,6 +82,11 @@
 #include "TStyle.h"
 #include "TLine.h"
 #include "TSystem.h"
+#include "TBufferFile.h"
+#include "TMD5.h"
+#include "TKey.h"
+#include "TClass.h"
+#include "ROOT/TProcessExecutor.hxx"
 
 
 // from roofit
@@ -104,7 +109,50 @@ using namespace RooFit;
 
 
 
-RooWorkspace* RooStats::HistFactory::MakeModelAndMeasurementFast( RooStats::HistFactory::Measurement& measurement ) {
+namespace {
+
+  // Hash of everything a single-channel model depends on: the channel
+  // itself, including the histogram contents, plus the measurement-level
+  // configuration (lumi, POI, constant parameters, ...). Computed on
+  // the streamed single-channel measurement.
+  std::string ChannelContentHash( RooStats::HistFactory::Measurement& measurement,
+                                  RooStats::HistFactory::Channel& channel ) {
+    RooStats::HistFactory::Measurement meas_chan( measurement );
+    meas_chan.GetChannels().clear();
+    meas_chan.GetChannels().push_back( channel );
+    TBufferFile buffer( TBuffer::kWrite );
+    buffer.WriteObjectAny( &meas_chan, RooStats::HistFactory::Measurement::Class() );
+    TMD5 md5;
+    md5.Update( (UChar_t*) buffer.Buffer(), buffer.Length() );
+    md5.Final();
+    return std::string( md5.AsString() );
+  }
+
+  // Read back a channel workspace from a cache file written by a
+  // previous build. Returns NULL when the file is missing or unusable.
+  RooWorkspace* LoadCachedChannelWorkspace( const std::string& fileName ) {
+    if( gSystem->AccessPathName( fileName.c_str() ) ) return NULL;
+    TFile* cacheFile = TFile::Open( fileName.c_str() );
+    if( cacheFile == NULL ) return NULL;
+    RooWorkspace* ws = NULL;
+    TIter nextkey( cacheFile->GetListOfKeys() );
+    while( TKey* key = (TKey*) nextkey() ) {
+      TClass* cl = TClass::GetClass( key->GetClassName() );
+      if( cl && cl->InheritsFrom( RooWorkspace::Class() ) ) {
+        ws = (RooWorkspace*) key->ReadObj();
+        break;
+      }
+    }
+    cacheFile->Close();
+    delete cacheFile;
+    return ws;
+  }
+
+}
+
+RooWorkspace* RooStats::HistFactory::MakeModelAndMeasurementFast( RooStats::HistFactory::Measurement& measurement,
+                                                                  Int_t nWorkers,
+                                                                  const std::string& cacheDir ) {
 
   // This will be returned
   RooWorkspace* ws = NULL;
@@ -174,22 +222,94 @@ RooWorkspace* RooStats::HistFactory::MakeModelAndMeasurementFast( RooStats::Hist
     // for results tables
     fprintf(tableFile, " %s &", rowTitle.c_str() );
   
-    // First: Loop to make the individual channels
+    // First: Build the individual channel workspaces. The builds are
+    // independent of each other, so unchanged channels can be reused
+    // from the cache and the rest run in forked worker processes.
     for( unsigned int chanItr = 0; chanItr < measurement.GetChannels().size(); ++chanItr ) {
-    
+
       HistFactory::Channel& channel = measurement.GetChannels().at( chanItr );
       if( ! channel.CheckHistograms() ) {
 	std::cout << "MakeModelAndMeasurementsFast: Channel: " << channel.GetName()
 		  << " has uninitialized histogram pointers" << std::endl;
 	throw hf_exc();
       }
+      channel_names.push_back(channel.GetName());
+      channel_workspaces.push_back(NULL);
+    }
+
+    // Look up the channels in the cache
+    std::vector<std::string> channel_hashes( channel_names.size() );
+    if( !cacheDir.empty() ) {
+      if( gSystem->OpenDirectory( cacheDir.c_str() ) == 0 &&
+	  gSystem->MakeDirectory( cacheDir.c_str() ) != 0 ) {
+	std::cout << "Error: Failed to make cache directory: " << cacheDir << std::endl;
+	throw hf_exc();
+      }
+      for( unsigned int chanItr = 0; chanItr < channel_names.size(); ++chanItr ) {
+	channel_hashes[chanItr] =
+	  ChannelContentHash( measurement, measurement.GetChannels().at(chanItr) );
+	std::string cacheFileName = cacheDir + "/" + channel_names[chanItr]
+	  + "_" + channel_hashes[chanItr] + ".root";
+	RooWorkspace* ws_cached = LoadCachedChannelWorkspace( cacheFileName );
+	if( ws_cached ) {
+	  std::cout << "Reusing cached workspace for channel: " << channel_names[chanItr]
+		    << " from: " << cacheFileName << std::endl;
+	  channel_workspaces[chanItr] = ws_cached;
+	}
+      }
+    }
+
+    // Collect the channels which were not found in the cache
+    std::vector<unsigned int> channels_to_build;
+    for( unsigned int chanItr = 0; chanItr < channel_names.size(); ++chanItr ) {
+      if( channel_workspaces[chanItr] == NULL ) channels_to_build.push_back(chanItr);
+    }
 
-      // Make the workspace for this individual channel
-      std::string ch_name = channel.GetName();
-      std::cout << "Starting to process channel: " << ch_name << std::endl;
-      channel_names.push_back(ch_name);
-      RooWorkspace* ws_single = factory.MakeSingleChannelModel( measurement, channel );
-      channel_workspaces.push_back(ws_single);
+    if( nWorkers > 1 && channels_to_build.size() > 1 ) {
+      // Build the missing channels in forked worker processes. Each
+      // worker owns private copies of the factory and the measurement,
+      // the finished workspaces are streamed back to this process.
+      std::cout << "Building " << channels_to_build.size()
+		<< " channels with " << nWorkers << " workers" << std::endl;
+      ROOT::TProcessExecutor executor( nWorkers );
+      auto buildOneChannel = [&]( unsigned int chanItr ) -> RooWorkspace* {
+	return factory.MakeSingleChannelModel( measurement,
+					       measurement.GetChannels().at(chanItr) );
+      };
+      std::vector<RooWorkspace*> built = executor.Map( buildOneChannel, channels_to_build );
+      for( unsigned int i = 0; i < channels_to_build.size(); ++i ) {
+	if( built.at(i) == NULL ) {
+	  std::cout << "MakeModelAndMeasurementsFast: worker failed to build channel: "
+		    << channel_names[channels_to_build[i]] << std::endl;
+	  throw hf_exc();
+	}
+	channel_workspaces[channels_to_build[i]] = built.at(i);
+      }
+    } else {
+      for( unsigned int i = 0; i < channels_to_build.size(); ++i ) {
+	unsigned int chanItr = channels_to_build[i];
+	std::cout << "Starting to process channel: " << channel_names[chanItr] << std::endl;
+	channel_workspaces[chanItr] =
+	  factory.MakeSingleChannelModel( measurement, measurement.GetChannels().at(chanItr) );
+      }
+    }
+
+    // Save the freshly built channels in the cache
+    if( !cacheDir.empty() ) {
+      for( unsigned int i = 0; i < channels_to_build.size(); ++i ) {
+	unsigned int chanItr = channels_to_build[i];
+	std::string cacheFileName = cacheDir + "/" + channel_names[chanItr]
+	  + "_" + channel_hashes[chanItr] + ".root";
+	channel_workspaces[chanItr]->writeToFile( cacheFileName.c_str() );
+      }
+    }
+
+    // Second: Loop over the channels to write the outputs and do the fits
+    for( unsigned int chanItr = 0; chanItr < measurement.GetChannels().size(); ++chanItr ) {
+
+      HistFactory::Channel& channel = measurement.GetChannels().at( chanItr );
+      std::string ch_name = channel_names[chanItr];
+      RooWorkspace* ws_single = channel_workspaces[chanItr];
 
       // Make the output
       std::string ChannelFileName = measurement.GetOutputFilePrefix() + "_" 
@@ -21,6 +21,7 @@ END_HTML
 #include <string>
 #include <exception>
 #include <vector>
+#include <cstdlib>
 
 //void topDriver(string input); // in MakeModelAndMeasurements
 //void fastDriver(string input); // in MakeModelAndMeasurementsFast
@@ -34,7 +35,7 @@ END_HTML
 
 namespace RooStats {
   namespace HistFactory {
-    void fastDriver(std::string input) {
+    void fastDriver(std::string input, Int_t nWorkers = 0, std::string cacheDir = "") {
 
       // Create the initial list of measurements and channels
       std::vector< HistFactory::Measurement > measurement_list;
@@ -51,7 +52,7 @@ namespace RooStats {
       for(unsigned int i = 0; i < measurement_list.size(); ++i) {
 	HistFactory::Measurement measurement = measurement_list.at(i);
 	measurement.CollectHistograms();
-	MakeModelAndMeasurementFast( measurement );
+	MakeModelAndMeasurementFast( measurement, nWorkers, cacheDir );
       }
 
       return;
@@ -63,52 +64,17 @@ namespace RooStats {
 
 int main(int argc, char** argv) {
 
-  if( !(argc > 1) ) {
-    std::cerr << "need input file" << std::endl;
-    exit(1);
-  }
-  
-  if(argc==2){
-    std::string input(argv[1]);
-    try {
-      RooStats::HistFactory::fastDriver(input);
-    }
-    catch(std::string str) {
-      std::cerr << "hist2workspace - Caught exception: " << str << std::endl ;
-      exit(1);
-    }
-    catch( const std::exception& e ) {
-      std::cerr << "hist2workspace - Caught Exception: " << e.what() << std::endl;
-      exit(1);
-    }
-    catch(...) {
-      exit(1);
-    }
-  }
-  
-  if(argc==3){
-    std::string flag(argv[1]);
-    std::string input(argv[2]);
+  std::string input;
+  Int_t nWorkers = 0;
+  std::string cacheDir;
 
-    if(flag=="-standard_form") {
-      try {
-	RooStats::HistFactory::fastDriver(input);
-      }
-      catch(std::string str) {
-	std::cerr << "hist2workspace - Caught exception: " << str << std::endl ;
-	exit(1);
-      }
-      catch( const std::exception& e ) {
-	std::cerr << "hist2workspace - Caught Exception: " << e.what() << std::endl;
-	exit(1);
-      }
-      catch(...) {
-	std::cerr << "hist2workspace - Caught Exception" << std::endl;
-	exit(1);
-      }
+  for( int i = 1; i < argc; ++i ) {
+    std::string arg(argv[i]);
+
+    if(arg=="-standard_form") {
+      // this is the default form
     }
-      
-    else if(flag=="-number_counting_form") {
+    else if(arg=="-number_counting_form") {
       std::cout << "ERROR: 'number_counting_form' is now depricated." << std::endl;
       /*
       try {
@@ -123,11 +89,48 @@ int main(int argc, char** argv) {
       */
       return 255;
     }
-    
-    else {
+    else if(arg=="-j") {
+      if( ++i == argc ) {
+	std::cerr << "hist2workspace: -j requires the number of workers" << std::endl;
+	return 255;
+      }
+      nWorkers = atoi(argv[i]);
+    }
+    else if(arg=="-cache") {
+      if( ++i == argc ) {
+	std::cerr << "hist2workspace: -cache requires a directory name" << std::endl;
+	return 255;
+      }
+      cacheDir = argv[i];
+    }
+    else if(arg[0]=='-') {
       std::cerr << "Unrecognized flag.  " << std::endl;
       return 255;
     }
+    else {
+      input = arg;
+    }
+  }
+
+  if( input.empty() ) {
+    std::cerr << "need input file" << std::endl;
+    exit(1);
+  }
+
+  try {
+    RooStats::HistFactory::fastDriver(input, nWorkers, cacheDir);
+  }
+  catch(std::string str) {
+    std::cerr << "hist2workspace - Caught exception: " << str << std::endl ;
+    exit(1);
+  }
+  catch( const std::exception& e ) {
+    std::cerr << "hist2workspace - Caught Exception: " << e.what() << std::endl;
+    exit(1);
+  }
+  catch(...) {
+    std::cerr << "hist2workspace - Caught Exception" << std::endl;
+    exit(1);
   }
 
   return 0;
@@ -34,6 +34,8 @@ public:
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
 
+  virtual Bool_t evaluateBatch(const RooAbsData& data, Int_t firstEvent, Int_t lastEvent, Double_t* output) const ;
+
 protected:
   RooRealProxy x;
   RooRealProxy c;
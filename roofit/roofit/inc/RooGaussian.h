@@ -39,6 +39,8 @@ public:
 
   Double_t getLogVal(const RooArgSet* set) const ;
 
+  virtual Bool_t evaluateBatch(const RooAbsData& data, Int_t firstEvent, Int_t lastEvent, Double_t* output) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -28,6 +28,8 @@ Exponential p.d.f
 
 #include "RooExponential.h"
 #include "RooRealVar.h"
+#include "RooAbsData.h"
+#include "RooAbsDataStore.h"
 
 using namespace std;
 
@@ -57,6 +59,27 @@ Double_t RooExponential::evaluate() const{
   return exp(c*x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute unnormalized exponential values for a whole range of events in one
+/// vectorizable pass over the observable column of the dataset store. Batch
+/// evaluation requires x to be stored as a plain column and c to be
+/// event-independent (i.e. not stored in the dataset)
+
+Bool_t RooExponential::evaluateBatch(const RooAbsData& data, Int_t firstEvent, Int_t lastEvent, Double_t* output) const
+{
+  const Double_t* xData = data.store()->getBatchColumn(x.arg()) ;
+  if (!xData) return kFALSE ;
+  if (data.store()->getBatchColumn(c.arg())) return kFALSE ;
+
+  const Double_t cVal = c ;
+
+  for (Int_t i=firstEvent ; i<lastEvent ; i++) {
+    output[i-firstEvent] = exp(cVal*xData[i]) ;
+  }
+
+  return kTRUE ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
@@ -31,6 +31,8 @@ Plain Gaussian p.d.f
 #include "RooRealVar.h"
 #include "RooRandom.h"
 #include "RooMath.h"
+#include "RooAbsData.h"
+#include "RooAbsDataStore.h"
 
 using namespace std;
 
@@ -69,6 +71,29 @@ Double_t RooGaussian::evaluate() const
   return ret ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute unnormalized Gaussian values for a whole range of events in one
+/// vectorizable pass over the observable column of the dataset store. Batch
+/// evaluation requires x to be stored as a plain column and mean and sigma to
+/// be event-independent (i.e. not stored in the dataset)
+
+Bool_t RooGaussian::evaluateBatch(const RooAbsData& data, Int_t firstEvent, Int_t lastEvent, Double_t* output) const
+{
+  const Double_t* xData = data.store()->getBatchColumn(x.arg()) ;
+  if (!xData) return kFALSE ;
+  if (data.store()->getBatchColumn(mean.arg()) || data.store()->getBatchColumn(sigma.arg())) return kFALSE ;
+
+  const Double_t m = mean ;
+  const Double_t minusHalfOverSig2 = -0.5/(sigma*sigma) ;
+
+  for (Int_t i=firstEvent ; i<lastEvent ; i++) {
+    Double_t arg = xData[i] - m ;
+    output[i-firstEvent] = exp(minusHalfOverSig2*arg*arg) ;
+  }
+
+  return kTRUE ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate and return the negative log-likelihood of the Poisson
 
@@ -54,6 +54,11 @@ public:
 
   virtual Bool_t isWeighted() const = 0 ;
 
+  // Retrieve batch column data: pointer to the contiguous array of values of the
+  // given observable, or zero if this store implementation does not keep the
+  // values of that observable in a contiguous array
+  virtual const Double_t* getBatchColumn(const RooAbsArg& /*arg*/) const { return 0 ; }
+
   // Change observable name
   virtual Bool_t changeObservableName(const char* from, const char* to) =0 ;
   
@@ -24,6 +24,7 @@
 
 class RooDataSet;
 class RooDataHist ;
+class RooAbsData ;
 class RooArgSet ;
 class RooRealProxy ;
 class RooAbsGenContext ;
@@ -186,6 +187,7 @@ public:
   virtual Bool_t traceEvalHook(Double_t value) const ;  
   virtual Double_t getValV(const RooArgSet* set=0) const ;
   virtual Double_t getLogVal(const RooArgSet* set=0) const ;
+  virtual Bool_t evaluateBatch(const RooAbsData& data, Int_t firstEvent, Int_t lastEvent, Double_t* output) const ;
 
   Double_t getNorm(const RooArgSet& nset) const { 
     // Get p.d.f normalization term needed for observables 'nset'
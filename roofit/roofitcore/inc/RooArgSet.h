@@ -129,9 +129,6 @@ protected:
 
   Bool_t checkForDup(const RooAbsArg& arg, Bool_t silent) const ;
 
-  static char* _poolBegin ; //! Start of memory pool
-  static char* _poolCur ;   //! Next free slot in memory pool
-  static char* _poolEnd ;   //! End of memory pool  
   
   ClassDef(RooArgSet,1) // Set of RooAbsArg objects
 };
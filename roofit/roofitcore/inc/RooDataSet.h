@@ -106,6 +106,7 @@ public:
   virtual void add(const RooArgSet& row, Double_t weight, Double_t weightErrorLo, Double_t weightErrorHi);
 
   virtual void addFast(const RooArgSet& row, Double_t weight=1.0, Double_t weightError=0);
+  Int_t addBulk(const RooArgList& varList, const Double_t* const* data, Int_t nEvents, const Double_t* wgt=0) ;
 
   void append(RooDataSet& data) ;
   Bool_t merge(RooDataSet* data1, RooDataSet* data2=0, RooDataSet* data3=0,  
@@ -149,9 +150,6 @@ protected:
   RooRealVar* _wgtVar ;    // Pointer to weight variable (if set) 
 
   static void cleanup() ;
-  static char* _poolBegin ; //! Start of memory pool
-  static char* _poolCur ;   //! Next free slot in memory pool
-  static char* _poolEnd ;   //! End of memory pool  
 
   ClassDef(RooDataSet,2) // Unbinned data set
 };
@@ -70,6 +70,10 @@ public:
 
   static Int_t getCacheAllNumeric() ;
 
+  static void setNumIntMemoSize(Int_t nPoints) ;
+
+  static Int_t getNumIntMemoSize() ;
+
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const {
     // Forward plot sampling hint of integrand
     return _function.arg().plotSamplingHint(obs,xlo,xhi) ;
@@ -134,8 +138,14 @@ protected:
   
   mutable RooArgSet* _params ; //! cache for set of parameters
 
+  Bool_t fillMemoKey(std::vector<Double_t>& key) const ;
+  mutable std::vector<std::vector<Double_t> > _memoPoints ; //! recently evaluated parameter points of the numeric integral
+  mutable std::vector<Double_t> _memoValues ;               //! memoized numeric integral values at _memoPoints
+  mutable UInt_t _memoNext ;                                //! next memo slot to recycle
+
   Bool_t _cacheNum ;           // Cache integral if numeric
   static Int_t _cacheAllNDim ; //! Cache all integrals with given numeric dimension
+  static Int_t _memoSize ;     //! Number of recent parameter points memoized per integral
 
 
   virtual void operModeHook() ; // cache operation mode
@@ -22,7 +22,8 @@
 #include "RooArgList.h"
 #include "RooMPSentinel.h"
 #include "TStopwatch.h"
-#include <vector> 
+#include <vector>
+#include <cstddef>
 
 class RooArgSet ;
 namespace RooFit { class BidirMMapPipe; }
@@ -61,9 +62,10 @@ public:
   enum Message { SendReal=0, SendCat, Calculate, Retrieve, ReturnValue, Terminate, 
 		 ConstOpt, Verbose, LogEvalError, ApplyNLLW2, EnableOffset, CalculateNoOffset } ;
   
-  void initialize() ; 
+  void initialize() ;
   void initVars() ;
   void serverLoop() ;
+  void syncVarsFromShared() ;
 
   void doApplyNLLW2(Bool_t flag) ;
 
@@ -79,6 +81,9 @@ public:
 
   RooFit::BidirMMapPipe *_pipe; //! connection to child
 
+  void* _shmem ; //! shared-memory block for parameter/result exchange with server
+  std::size_t _shmemSize ; //! size of shared-memory block
+
   mutable std::vector<Bool_t> _valueChanged ; //! Flags if variable needs update on server-side
   mutable std::vector<Bool_t> _constChanged ; //! Flags if variable needs update on server-side
   RooRealMPFE* _updateMaster ; //! Update master
@@ -61,6 +61,7 @@ public:
 
   // Write current row
   virtual Int_t fill() ;
+  Int_t addBulkData(const RooArgList& varList, const Double_t* const* data, Int_t nEvents, const Double_t* wgt=0) ;
 
   // reserve storage for nEvt entries
   virtual void reserve(Int_t nEvt);
@@ -75,6 +76,8 @@ public:
   virtual Double_t weight(Int_t index) const ;
   virtual Bool_t isWeighted() const { return (_wgtVar!=0||_extWgtArray!=0) ; }
 
+  virtual const Double_t* getBatchColumn(const RooAbsArg& arg) const ;
+
   // Change observable name
   virtual Bool_t changeObservableName(const char* from, const char* to) ;
   
@@ -232,12 +235,15 @@ public:
       *_buf = *(_vec0+idx) ; 
     }
 
-    inline void getNative(Int_t idx) const { 
-      *_nativeBuf = *(_vec0+idx) ; 
+    inline void getNative(Int_t idx) const {
+      *_nativeBuf = *(_vec0+idx) ;
     }
 
     Int_t size() const { return _vec.size() ; }
 
+    // Direct access to the contiguous value array, for batch computations
+    const Double_t* dataVec() const { return _vec0 ; }
+
     void resize(Int_t siz) {
       if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
 	// do an expensive copy, if we save at least a factor 2 in size
@@ -259,6 +265,18 @@ public:
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
     }
 
+    // Append a contiguous block of values, for bulk import
+    void appendData(const Double_t* data, Int_t n) {
+      _vec.insert(_vec.end(), data, data+n);
+      _vec0 = &_vec.front();
+    }
+
+    // Append n copies of val, for bulk import
+    void appendData(Double_t val, Int_t n) {
+      _vec.insert(_vec.end(), n, val);
+      _vec0 = &_vec.front();
+    }
+
   protected:
     std::vector<Double_t> _vec ;
 
@@ -628,13 +628,32 @@ Double_t RooAbsPdf::getLogVal(const RooArgSet* nset) const
     logEvalError("getLogVal() top-level p.d.f evaluates to NaN") ;
 
     return log((double)0);
-    
+
   }
   return log(prob);
 }
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the unnormalized p.d.f value, as returned by evaluate(), for events
+/// firstEvent to lastEvent (exclusive) of the given dataset in a single pass,
+/// writing the results in output. Implementations read the observable columns
+/// directly from the contiguous arrays of the dataset store (see
+/// RooAbsDataStore::getBatchColumn()) so that the loop over events can be
+/// vectorized by the compiler. Return kFALSE if batch evaluation is not
+/// possible for this p.d.f/dataset combination, e.g. because an observable is
+/// not stored as a plain column or a parameter takes per-event values; the
+/// caller must then fall back to event-by-event evaluation through getVal().
+/// The default implementation always returns kFALSE.
+
+Bool_t RooAbsPdf::evaluateBatch(const RooAbsData& /*data*/, Int_t /*firstEvent*/, Int_t /*lastEvent*/, Double_t* /*output*/) const
+{
+  return kFALSE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returned the extended likelihood term (Nexpect - Nobserved*log(NExpected)
 /// of this PDF for the given number of observed events
@@ -55,6 +55,7 @@
 #include "RooArgList.h"
 #include "RooSentinel.h"
 #include "RooMsgService.h"
+#include "RooSetMemPool.h"
 
 using namespace std ;
 
@@ -65,30 +66,20 @@ char* operator+( streampos&, char* );
 ClassImp(RooArgSet)
   ;
 
-char* RooArgSet::_poolBegin = 0 ;
-char* RooArgSet::_poolCur = 0 ;
-char* RooArgSet::_poolEnd = 0 ;
-#define POOLSIZE 1048576
-
-struct POOLDATA 
+// Function-local static so that concurrent first use from several threads is
+// safe, and so that the pool outlives all statically allocated RooArgSets
+static RooSetMemPool* memPool()
 {
-  void* _base ;
-} ;
-
-static std::list<POOLDATA> _memPoolList ;
+  static RooSetMemPool pool("RooArgSet_pool") ;
+  return &pool ;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Clear memoery pool on exit to avoid reported memory leaks
 
 void RooArgSet::cleanup()
 {
-  std::list<POOLDATA>::iterator iter = _memPoolList.begin() ;
-  while(iter!=_memPoolList.end()) {
-    free(iter->_base) ;
-    iter->_base=0 ;
-    iter++ ;
-  }
-  _memPoolList.clear() ;
+  memPool()->cleanup() ;
 }
 
 
@@ -97,7 +88,7 @@ void RooArgSet::cleanup()
 ////////////////////////////////////////////////////////////////////////////////
 /// Overloaded new operator guarantees that all RooArgSets allocated with new
 /// have a unique address, a property that is exploited in several places
-/// in roofit to quickly index contents on normalization set pointers. 
+/// in roofit to quickly index contents on normalization set pointers.
 /// The memory pool only allocates space for the class itself. The elements
 /// stored in the set are stored outside the pool.
 
@@ -105,61 +96,8 @@ void* RooArgSet::operator new (size_t bytes)
 {
   //cout << " RooArgSet::operator new(" << bytes << ")" << endl ;
 
-  if (!_poolBegin || _poolCur+(sizeof(RooArgSet)) >= _poolEnd) {
-
-    if (_poolBegin!=0) {
-      oocxcoutD((TObject*)0,Caching) << "RooArgSet::operator new(), starting new 1MB memory pool" << endl ;
-    }
-
-    RooTrace::createSpecial("RooArgSet_pool",POOLSIZE) ;
-
-    // Start pruning empty memory pools if number exceeds 3
-    if (_memPoolList.size()>3) {
-      
-      void* toFree(0) ;
-
-      for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
-
-	// If pool is empty, delete it and remove it from list
-	if ((*(Int_t*)(poolIter->_base))==0) {
-	  oocxcoutD((TObject*)0,Caching) << "RooArgSet::operator new(), pruning empty memory pool " << (void*)(poolIter->_base) << endl ;
-
-	  toFree = poolIter->_base ;
-	  _memPoolList.erase(poolIter) ;
-	  RooTrace::destroySpecial("RooArgSet_pool") ;
-	  
-	  break ;
-	}
-      }      
-
-      free(toFree) ;      
-    }
-    
-    void* mem = malloc(POOLSIZE) ;
-
-    _poolBegin = (char*)mem ;
-    // Reserve space for pool counter at head of pool
-    _poolCur = _poolBegin+sizeof(Int_t) ;
-    _poolEnd = _poolBegin+(POOLSIZE) ;
-
-    // Clear pool counter
-    *((Int_t*)_poolBegin)=0 ;
-    
-    POOLDATA p ;
-    p._base=mem ;
-    _memPoolList.push_back(p) ;
-
-    RooSentinel::activate() ;
-  }
-
-  char* ptr = _poolCur ;
-  _poolCur += bytes ;
-
-  // Increment use counter of pool
-  (*((Int_t*)_poolBegin))++ ;
-
-  return ptr ;
-
+  RooSentinel::activate() ;
+  return memPool()->allocate(bytes) ;
 }
 
 
@@ -179,12 +117,8 @@ void* RooArgSet::operator new (size_t bytes, void* ptr) noexcept
 
 void RooArgSet::operator delete (void* ptr)
 {
-  // Decrease use count in pool that ptr is on
-  for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
-    if ((char*)ptr > (char*)poolIter->_base && (char*)ptr < (char*)poolIter->_base + POOLSIZE) {
-      (*(Int_t*)(poolIter->_base))-- ;
-      return ;
-    }
+  if (memPool()->deallocate(ptr)) {
+    return ;
   }
   // Not part of any pool; use global op delete:
   ::operator delete(ptr);
@@ -53,6 +53,7 @@ or RooStringVar objects
 #include "RooTreeData.h"
 #include "RooSentinel.h"
 #include "RooTrace.h"
+#include "RooSetMemPool.h"
 
 #if (__GNUC__==3&&__GNUC_MINOR__==2&&__GNUC_PATCHLEVEL__==3)
 char* operator+( streampos&, char* );
@@ -64,30 +65,20 @@ ClassImp(RooDataSet)
 ;
 
 
-char* RooDataSet::_poolBegin = 0 ;
-char* RooDataSet::_poolCur = 0 ;
-char* RooDataSet::_poolEnd = 0 ;
-#define POOLSIZE 1048576
-
-struct POOLDATA 
+// Function-local static so that concurrent first use from several threads is
+// safe, and so that the pool outlives all statically allocated RooDataSets
+static RooSetMemPool* memPool()
 {
-  void* _base ;
-} ;
-
-static std::list<POOLDATA> _memPoolList ;
+  static RooSetMemPool pool("RooDataSet_pool") ;
+  return &pool ;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Clear memoery pool on exit to avoid reported memory leaks
 
 void RooDataSet::cleanup()
 {
-  std::list<POOLDATA>::iterator iter = _memPoolList.begin() ;
-  while(iter!=_memPoolList.end()) {
-    free(iter->_base) ;
-    iter->_base=0 ;
-    iter++ ;
-  }
-  _memPoolList.clear() ;
+  memPool()->cleanup() ;
 }
 
 
@@ -96,7 +87,7 @@ void RooDataSet::cleanup()
 ////////////////////////////////////////////////////////////////////////////////
 /// Overloaded new operator guarantees that all RooDataSets allocated with new
 /// have a unique address, a property that is exploited in several places
-/// in roofit to quickly index contents on normalization set pointers. 
+/// in roofit to quickly index contents on normalization set pointers.
 /// The memory pool only allocates space for the class itself. The elements
 /// stored in the set are stored outside the pool.
 
@@ -104,74 +95,21 @@ void* RooDataSet::operator new (size_t bytes)
 {
   //cout << " RooDataSet::operator new(" << bytes << ")" << endl ;
 
-  if (!_poolBegin || _poolCur+(sizeof(RooDataSet)) >= _poolEnd) {
-
-    if (_poolBegin!=0) {
-      oocxcoutD((TObject*)0,Caching) << "RooDataSet::operator new(), starting new 1MB memory pool" << endl ;
-    }
-
-    // Start pruning empty memory pools if number exceeds 3
-    if (_memPoolList.size()>3) {
-      
-      void* toFree(0) ;
-
-      for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
-
-	// If pool is empty, delete it and remove it from list
-	if ((*(Int_t*)(poolIter->_base))==0) {
-	  oocxcoutD((TObject*)0,Caching) << "RooDataSet::operator new(), pruning empty memory pool " << (void*)(poolIter->_base) << endl ;
-
-	  toFree = poolIter->_base ;
-	  _memPoolList.erase(poolIter) ;
-	  break ;
-	}
-      }      
-
-      free(toFree) ;      
-    }
-    
-    void* mem = malloc(POOLSIZE) ;
-
-    _poolBegin = (char*)mem ;
-    // Reserve space for pool counter at head of pool
-    _poolCur = _poolBegin+sizeof(Int_t) ;
-    _poolEnd = _poolBegin+(POOLSIZE) ;
-
-    // Clear pool counter
-    *((Int_t*)_poolBegin)=0 ;
-    
-    POOLDATA p ;
-    p._base=mem ;
-    _memPoolList.push_back(p) ;
-
-    RooSentinel::activate() ;
-  }
-
-  char* ptr = _poolCur ;
-  _poolCur += bytes ;
-
-  // Increment use counter of pool
-  (*((Int_t*)_poolBegin))++ ;
-
-  return ptr ;
-
+  RooSentinel::activate() ;
+  return memPool()->allocate(bytes) ;
 }
 
 
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Memory is owned by pool, we need to do nothing to release it
 
 void RooDataSet::operator delete (void* ptr)
 {
-  // Decrease use count in pool that ptr is on
-  for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
-    if ((char*)ptr > (char*)poolIter->_base && (char*)ptr < (char*)poolIter->_base + POOLSIZE) {
-      (*(Int_t*)(poolIter->_base))-- ;
-      break ;
-    }
+  if (memPool()->deallocate(ptr)) {
+    return ;
   }
-  
+  // Not part of any pool; use global op delete:
+  ::operator delete(ptr);
 }
 
 #endif
@@ -1218,9 +1156,34 @@ void RooDataSet::addFast(const RooArgSet& data, Double_t wgt, Double_t wgtError)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Bulk import of nEvents events from contiguous arrays, one array of
+/// nEvents values per variable listed in varList. This bypasses the
+/// per-event RooArgSet copy and virtual setVal() calls of add(): the
+/// arrays are appended directly to the columns of the vector data
+/// store. For a weighted dataset the per-event weights are taken from
+/// wgt (unit weights when wgt is null); varList must cover all other
+/// dataset variables. Only available with the vector data store (the
+/// default) and with real-valued variables. Returns the number of
+/// imported events, or zero on error.
+
+Int_t RooDataSet::addBulk(const RooArgList& varList, const Double_t* const* data, Int_t nEvents, const Double_t* wgt)
+{
+  checkInit() ;
+  RooVectorDataStore* vstore = dynamic_cast<RooVectorDataStore*>(store()) ;
+  if (!vstore) {
+    coutE(DataHandling) << "RooDataSet::addBulk(" << GetName()
+			<< ") bulk import requires the vector data store" << endl ;
+    return 0 ;
+  }
+  return vstore->addBulkData(varList,data,nEvents,wgt) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
-Bool_t RooDataSet::merge(RooDataSet* data1, RooDataSet* data2, RooDataSet* data3, 
+Bool_t RooDataSet::merge(RooDataSet* data1, RooDataSet* data2, RooDataSet* data3,
 			 RooDataSet* data4, RooDataSet* data5, RooDataSet* data6) 
 {
   checkInit() ;
@@ -28,6 +28,7 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 **/
 
 #include <algorithm>
+#include <vector>
 
 #include "RooFit.h"
 #include "Riostream.h"
@@ -306,7 +307,61 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
   } else {
 
-    for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+    // First see if the pdf can compute the values of all events of the batch in
+    // a single vectorized pass over the column data of the dataset store. The
+    // normalization integral only depends on the parameters so it is evaluated
+    // once here and applied to the whole batch
+    Bool_t batchOk(kFALSE) ;
+    std::vector<Double_t> batchVals ;
+    if (stepSize==1 && lastEvent>firstEvent && !_weightSq) {
+      batchVals.resize(lastEvent-firstEvent) ;
+      batchOk = pdfClone->evaluateBatch(*_dataClone, firstEvent, lastEvent, &batchVals.front()) ;
+    }
+
+    if (batchOk) {
+
+      Double_t norm = pdfClone->getNorm(_normSet) ;
+      if (norm<=0. || TMath::IsNaN(norm)) {
+	// Let the event-by-event loop produce the usual evaluation errors
+	batchOk = kFALSE ;
+      } else {
+	Double_t logNorm = log(norm) ;
+	RooAbsDataStore* store = _dataClone->store() ;
+	Bool_t isWeighted = _dataClone->isWeighted() ;
+
+	for (i=firstEvent ; i<lastEvent ; i++) {
+
+	  Double_t eventWeight = isWeighted ? store->weight(i) : 1.0 ;
+	  if (0. == eventWeight * eventWeight) continue ;
+
+	  Double_t pval = batchVals[i-firstEvent] ;
+	  Double_t logProb ;
+	  if (pval<0) {
+	    logEvalError(Form("p.d.f value of (%s) is less than zero (%f) for event %d",pdfClone->GetName(),pval,i)) ;
+	    logProb = 0 ;
+	  } else if (pval==0 || TMath::IsNaN(pval)) {
+	    logEvalError(Form("p.d.f value of (%s) is zero or NaN for event %d",pdfClone->GetName(),i)) ;
+	    logProb = log((double)0) ;
+	  } else {
+	    logProb = log(pval) - logNorm ;
+	  }
+
+	  Double_t term = -eventWeight * logProb ;
+
+	  Double_t y = eventWeight - sumWeightCarry;
+	  Double_t t = sumWeight + y;
+	  sumWeightCarry = (t - sumWeight) - y;
+	  sumWeight = t;
+
+	  y = term - carry;
+	  t = result + y;
+	  carry = (t - result) - y;
+	  result = t;
+	}
+      }
+    }
+
+    if (!batchOk) for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
 
       _dataClone->get(i) ;
 
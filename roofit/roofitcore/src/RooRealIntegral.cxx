@@ -58,6 +58,7 @@ ClassImp(RooRealIntegral)
 
 
 Int_t RooRealIntegral::_cacheAllNDim(2) ;
+Int_t RooRealIntegral::_memoSize(4) ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +75,7 @@ RooRealIntegral::RooRealIntegral() :
   _numIntegrand(0),
   _rangeName(0),
   _params(0),
+  _memoNext(0),
   _cacheNum(kFALSE)
 {
   _facListIter = _facList.createIterator() ;
@@ -117,6 +119,7 @@ RooRealIntegral::RooRealIntegral(const char *name, const char *title,
   _numIntegrand(0),
   _rangeName((TNamed*)RooNameReg::ptr(rangeName)),
   _params(0),
+  _memoNext(0),
   _cacheNum(kFALSE)
 {
   //   A) Check that all dependents are lvalues 
@@ -773,6 +776,7 @@ RooRealIntegral::RooRealIntegral(const RooRealIntegral& other, const char* name)
   _numIntegrand(0),
   _rangeName(other._rangeName),
   _params(0),
+  _memoNext(0),
   _cacheNum(kFALSE)
 {
  _funcNormSet = other._funcNormSet ? (RooArgSet*)other._funcNormSet->snapshot(kFALSE) : 0 ;
@@ -902,20 +906,43 @@ Double_t RooRealIntegral::evaluate() const
 	//	cout << "using cached value of integral" << GetName() << endl ;
       } else {
 
+	// Check the memo of recently evaluated parameter points: during
+	// gradient evaluation and line searches in a fit the same points
+	// are visited repeatedly, and a parameter shift elsewhere in the
+	// model may mark this integral dirty without changing any of the
+	// parameters it actually depends on
+	std::vector<Double_t> memoKey ;
+	Bool_t memoizable = _memoSize>0 && (_intList.getSize()>0 || _sumList.getSize()>0)
+	  && fillMemoKey(memoKey) ;
+	Int_t memoSlot(-1) ;
+	if (memoizable) {
+	  for (UInt_t i=0 ; i<_memoPoints.size() ; i++) {
+	    if (_memoPoints[i]==memoKey) {
+	      memoSlot = i ;
+	      break ;
+	    }
+	  }
+	}
+
+	if (memoSlot>=0) {
+
+	  retVal = _memoValues[memoSlot] ;
+
+	} else {
 
-	// Find any function dependents that are AClean 
+	// Find any function dependents that are AClean
 	// and switch them temporarily to ADirty
 	Bool_t origState = inhibitDirty() ;
 	setDirtyInhibit(kTRUE) ;
-	
+
 	// try to initialize our numerical integration engine
 	if(!(_valid= initNumIntegrator())) {
 	  coutE(Integration) << ClassName() << "::" << GetName()
 			     << ":evaluate: cannot initialize numerical integrator" << endl;
 	  return 0;
 	}
-	
-	// Save current integral dependent values 
+
+	// Save current integral dependent values
 	_saveInt = _intList ;
 	_saveSum = _sumList ;
 
@@ -924,7 +951,7 @@ Double_t RooRealIntegral::evaluate() const
 
 	// This must happen BEFORE restoring dependents, otherwise no dirty state propagation in restore step
 	setDirtyInhibit(origState) ;
-	
+
 	// Restore integral dependent values
 	_intList=_saveInt ;
 	_sumList=_saveSum ;
@@ -935,7 +962,21 @@ Double_t RooRealIntegral::evaluate() const
 	  expensiveObjectCache().registerObject(_function.arg().GetName(),GetName(),*val,parameters())  ;
 //  	  cout << "### caching value of integral" << GetName() << " in " << &expensiveObjectCache() << endl ;
 	}
-	
+
+	// Memoize the value at this parameter point
+	if (memoizable) {
+	  if (Int_t(_memoPoints.size())<_memoSize) {
+	    _memoPoints.push_back(memoKey) ;
+	    _memoValues.push_back(retVal) ;
+	  } else {
+	    _memoPoints[_memoNext] = memoKey ;
+	    _memoValues[_memoNext] = retVal ;
+	    _memoNext = (_memoNext+1) % _memoSize ;
+	  }
+	}
+
+	}
+
       }
       break ;
     }
@@ -1090,6 +1131,11 @@ Bool_t RooRealIntegral::redirectServersHook(const RooAbsCollection& /*newServerL
     _params = 0 ;
   }
 
+  // The memoized points refer to the old parameter set
+  _memoPoints.clear() ;
+  _memoValues.clear() ;
+  _memoNext = 0 ;
+
   return kFALSE ;
 }
 
@@ -1216,6 +1262,57 @@ void RooRealIntegral::setCacheAllNumeric(Int_t ndim) {
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of recently evaluated parameter points for which each
+/// (partially) numeric integral memoizes its value. A value of zero
+/// disables the memoization.
+
+void RooRealIntegral::setNumIntMemoSize(Int_t nPoints) {
+  _memoSize = nPoints ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of recently evaluated parameter points for which
+/// each (partially) numeric integral memoizes its value
+
+Int_t RooRealIntegral::getNumIntMemoSize()
+{
+  return _memoSize ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill key with the current values of all parameters this integral
+/// depends on. Returns false when a parameter is neither real-valued
+/// nor a category, in which case the memo can not be used.
+
+Bool_t RooRealIntegral::fillMemoKey(std::vector<Double_t>& key) const
+{
+  const RooArgSet& pars = parameters() ;
+  key.reserve(pars.getSize()) ;
+  RooFIter iter = pars.fwdIterator() ;
+  RooAbsArg* arg ;
+  while ((arg=iter.next())) {
+    RooAbsReal* real = dynamic_cast<RooAbsReal*>(arg) ;
+    if (real) {
+      key.push_back(real->getVal()) ;
+      continue ;
+    }
+    RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(arg) ;
+    if (cat) {
+      key.push_back(cat->getIndex()) ;
+      continue ;
+    }
+    return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return minimum dimensions of numeric integration for which values are cached. 
 
@@ -49,6 +49,7 @@ For general multiprocessing in ROOT, please refer to the TProcessExecutor class.
 
 #ifndef _WIN32
 #include "BidirMMapPipe.h"
+#include <sys/mman.h>
 #endif
 
 #include <cstdlib>
@@ -73,6 +74,36 @@ using namespace RooFit;
 ClassImp(RooRealMPFE)
   ;
 
+#ifndef _WIN32
+namespace {
+
+  // Layout of the anonymous shared-memory block used to exchange parameter
+  // values and results between client and server process. The block is mapped
+  // before the fork so that both processes see the same physical pages, and
+  // the bulk payload (one double per parameter, the function value and the
+  // Kahan carry) no longer travels through the pipe on every iteration: the
+  // pipe only carries the short control messages, whose blocking reads and
+  // writes also order the accesses to the block between the two processes.
+  struct MPFEShmLayout {
+    Double_t _result ;    // function value calculated by the server
+    Double_t _carry ;     // Kahan carry of the test statistic, if any
+    Double_t _varVal[1] ; // parameter values, one slot per variable
+    // followed by one Bool_t constant-flag per variable
+  } ;
+
+  inline std::size_t shmSize(Int_t nVar)
+  {
+    return sizeof(MPFEShmLayout) + (nVar-1)*sizeof(Double_t) + nVar*sizeof(Bool_t) ;
+  }
+
+  inline Bool_t* shmConstFlag(MPFEShmLayout* shm, Int_t nVar)
+  {
+    return reinterpret_cast<Bool_t*>(shm->_varVal+nVar) ;
+  }
+
+}
+#endif // _WIN32
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Construct front-end object for object 'arg' whose evaluation will be calculated
@@ -90,6 +121,8 @@ RooRealMPFE::RooRealMPFE(const char *name, const char *title, RooAbsReal& arg, B
   _inlineMode(calcInline),
   _remoteEvalErrorLoggingState(RooAbsReal::PrintErrors),
   _pipe(0),
+  _shmem(0),
+  _shmemSize(0),
   _updateMaster(0),
   _retrieveDispatched(kFALSE), _evalCarry(0.)
 {
@@ -119,6 +152,8 @@ RooRealMPFE::RooRealMPFE(const RooRealMPFE& other, const char* name) :
   _forceCalc(other._forceCalc),
   _remoteEvalErrorLoggingState(other._remoteEvalErrorLoggingState),
   _pipe(0),
+  _shmem(0),
+  _shmemSize(0),
   _updateMaster(0),
   _retrieveDispatched(kFALSE), _evalCarry(other._evalCarry)
 {
@@ -193,6 +228,38 @@ void RooRealMPFE::initialize()
   // Clear eval error log prior to forking
   // to avoid confusions...
   clearEvalErrorLog() ;
+
+  // Map anonymous shared-memory block for parameter/result exchange before
+  // forking so that client and server share the same pages. If the mmap fails
+  // all traffic simply stays on the pipe, as before
+  Int_t nVar = _vars.getSize() ;
+  if (nVar>0) {
+#if defined(MAP_ANONYMOUS)
+    void* mem = ::mmap(0,shmSize(nVar),PROT_READ|PROT_WRITE,MAP_SHARED|MAP_ANONYMOUS,-1,0) ;
+#elif defined(MAP_ANON)
+    void* mem = ::mmap(0,shmSize(nVar),PROT_READ|PROT_WRITE,MAP_SHARED|MAP_ANON,-1,0) ;
+#else
+    void* mem = MAP_FAILED ;
+#endif
+    if (MAP_FAILED != mem) {
+      _shmem = mem ;
+      _shmemSize = shmSize(nVar) ;
+      // Seed the block with the current parameter values so that the server,
+      // which forks with identical values, only applies genuine changes
+      MPFEShmLayout* shm = static_cast<MPFEShmLayout*>(_shmem) ;
+      Bool_t* constFlag = shmConstFlag(shm,nVar) ;
+      for (Int_t i=0 ; i<nVar ; i++) {
+	RooAbsReal* rvar = dynamic_cast<RooAbsReal*>(_vars.at(i)) ;
+	shm->_varVal[i] = rvar ? rvar->getVal() : 0 ;
+	constFlag[i] = _vars.at(i)->isConstant() ;
+      }
+    } else {
+      coutW(Minimization) << "RooRealMPFE::initialize(" << GetName()
+			  << ") WARNING: cannot map shared-memory exchange block, "
+			  << "falling back to pipe transport for parameters and results" << endl ;
+    }
+  }
+
   // Fork server process and setup IPC
   _pipe = new BidirMMapPipe();
 
@@ -222,6 +289,36 @@ void RooRealMPFE::initialize()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Server-side function that applies the parameter values found in the
+/// shared-memory exchange block to the local variables. Values are only
+/// propagated when they differ from the current value so that unchanged
+/// parameters do not trigger any dirty-state propagation. Category variables
+/// are synchronized through the pipe and skipped here.
+
+void RooRealMPFE::syncVarsFromShared()
+{
+#ifndef _WIN32
+  MPFEShmLayout* shm = static_cast<MPFEShmLayout*>(_shmem) ;
+  Int_t nVar = _vars.getSize() ;
+  Bool_t* constFlag = shmConstFlag(shm,nVar) ;
+  for (Int_t i=0 ; i<nVar ; i++) {
+    RooRealVar* rvar = dynamic_cast<RooRealVar*>(_vars.at(i)) ;
+    if (!rvar) continue ;
+    if (rvar->getVal() != shm->_varVal[i]) {
+      if (_verboseServer) cout << "RooRealMPFE::syncVarsFromShared(" << GetName()
+			       << ") SHM fromClient> [" << i << "]=" << shm->_varVal[i] << endl ;
+      rvar->setVal(shm->_varVal[i]) ;
+    }
+    if (rvar->isConstant() != constFlag[i]) {
+      rvar->setConstant(constFlag[i]) ;
+    }
+  }
+#endif // _WIN32
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Server loop of remote processes. This function will return
 /// only when an incoming TERMINATE message is received.
@@ -273,6 +370,7 @@ void RooRealMPFE::serverLoop()
     case Calculate:
       if (_verboseServer) cout << "RooRealMPFE::serverLoop(" << GetName()
 			       << ") IPC fromClient> Calculate" << endl ;
+      if (_shmem) syncVarsFromShared() ;
       _value = _arg ;
       break ;
 
@@ -280,6 +378,7 @@ void RooRealMPFE::serverLoop()
       if (_verboseServer) cout << "RooRealMPFE::serverLoop(" << GetName()
 			       << ") IPC fromClient> Calculate" << endl ;
 
+      if (_shmem) syncVarsFromShared() ;
       RooAbsReal::setHideOffset(kFALSE) ;
       _value = _arg ;
       RooAbsReal::setHideOffset(kTRUE) ;
@@ -291,7 +390,16 @@ void RooRealMPFE::serverLoop()
 				 << ") IPC fromClient> Retrieve" << endl ;
 	msg = ReturnValue;
 	numErrors = numEvalErrors();
-	*_pipe << msg << _value << getCarry() << numErrors;
+	if (_shmem) {
+	  // Result and carry go through the shared-memory block; the pipe only
+	  // carries the control message and the error count
+	  MPFEShmLayout* shm = static_cast<MPFEShmLayout*>(_shmem) ;
+	  shm->_result = _value ;
+	  shm->_carry = getCarry() ;
+	  *_pipe << msg << numErrors;
+	} else {
+	  *_pipe << msg << _value << getCarry() << numErrors;
+	}
 
 	if (_verboseServer) cout << "RooRealMPFE::serverLoop(" << GetName()
 				 << ") IPC toClient> ReturnValue " << _value << " NumError " << numErrors << endl ;
@@ -455,10 +563,18 @@ void RooRealMPFE::calculate() const
 
 	// send message to server
 	if (dynamic_cast<RooAbsReal*>(var)) {
-	  int msg = SendReal ;
 	  Double_t val = ((RooAbsReal*)var)->getVal() ;
 	  Bool_t isC = var->isConstant() ;
-	  *_pipe << msg << i << val << isC;
+	  if (_shmem) {
+	    // Deposit value and constant-flag in the shared-memory block; the
+	    // server picks them up when the Calculate message arrives
+	    MPFEShmLayout* shm = static_cast<MPFEShmLayout*>(_shmem) ;
+	    shm->_varVal[i] = val ;
+	    shmConstFlag(shm,_vars.getSize())[i] = isC ;
+	  } else {
+	    int msg = SendReal ;
+	    *_pipe << msg << i << val << isC;
+	  }
 
 	  if (_verboseServer) cout << "RooRealMPFE::calculate(" << GetName()
 				   << ") IPC toServer> SendReal [" << i << "]=" << val << (isC?" (Constant)":"") <<  endl ;
@@ -570,7 +686,15 @@ Double_t RooRealMPFE::evaluate() const
 
     Int_t numError;
 
-    *_pipe >> msg >> value >> _evalCarry >> numError;
+    if (_shmem) {
+      // The blocking pipe read orders this access: once the ReturnValue
+      // message has arrived the server has finished writing the block
+      *_pipe >> msg >> numError;
+      value = static_cast<MPFEShmLayout*>(_shmem)->_result ;
+      _evalCarry = static_cast<MPFEShmLayout*>(_shmem)->_carry ;
+    } else {
+      *_pipe >> msg >> value >> _evalCarry >> numError;
+    }
 
     if (msg!=ReturnValue) {
       cout << "RooRealMPFE::evaluate(" << GetName()
@@ -644,6 +768,13 @@ void RooRealMPFE::standby()
     delete _pipe;
     _pipe = 0;
 
+    // Release shared-memory exchange block
+    if (_shmem) {
+      ::munmap(_shmem,_shmemSize) ;
+      _shmem = 0 ;
+      _shmemSize = 0 ;
+    }
+
     // Revert to initialize state
     _state = Initialize;
   }
@@ -0,0 +1,168 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ *    File: $Id$
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2005, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_SET_MEM_POOL
+#define ROO_SET_MEM_POOL
+
+#include "Rtypes.h"
+#include "RooTrace.h"
+
+#include <cstdlib>
+#include <list>
+#include <mutex>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Arena allocator backing the overloaded operator new/delete of RooArgSet
+/// and RooDataSet. It replaces the previous per-class pool code which bump
+/// allocated from a single active 1MB block and scanned a block list on every
+/// delete. Allocations are served from chunks that are recycled as a whole
+/// once their last object is released, so the transient sets created during
+/// getVal()/evaluate() traversals stop cycling through the global allocator.
+/// All operations are serialized with a mutex so pdfs can be evaluated from
+/// multiple threads. As before, memory inside a chunk is never handed out
+/// twice while any object in the chunk is alive, preserving the unique-address
+/// property that RooFit exploits to index normalization set caches by pointer.
+
+class RooSetMemPool {
+public:
+
+  RooSetMemPool(const char* traceTag, std::size_t chunkSize = 1048576) :
+    _traceTag(traceTag), _chunkSize(chunkSize)
+  {
+  }
+
+  ~RooSetMemPool()
+  {
+    cleanup() ;
+  }
+
+  /// Allocate bytes from the active chunk, opening or recycling a chunk when
+  /// the active one is exhausted
+  void* allocate(std::size_t bytes)
+  {
+    std::lock_guard<std::mutex> guard(_mutex) ;
+
+    // Round request up so that all objects are served malloc-style aligned
+    bytes = (bytes + 15) & ~((std::size_t)15) ;
+
+    Chunk* chunk = _chunkList.empty() ? 0 : _chunkList.back() ;
+    if (!chunk || chunk->_cur + bytes > chunk->_end) {
+      chunk = reuseOrNewChunk(bytes) ;
+    }
+
+    char* ptr = chunk->_cur ;
+    chunk->_cur += bytes ;
+    chunk->_useCount++ ;
+    return ptr ;
+  }
+
+  /// Release an object previously obtained from allocate(). Returns kFALSE if
+  /// ptr was not allocated from this pool, in which case the caller must
+  /// dispose of it through the global operator delete
+  Bool_t deallocate(void* ptr)
+  {
+    std::lock_guard<std::mutex> guard(_mutex) ;
+
+    for (std::list<Chunk*>::iterator iter = _chunkList.begin() ; iter != _chunkList.end() ; ++iter) {
+      Chunk* chunk = *iter ;
+      if ((char*)ptr >= chunk->_base && (char*)ptr < chunk->_end) {
+	chunk->_useCount-- ;
+	if (chunk->_useCount == 0 && chunk != _chunkList.back() && countEmptyChunks() > 3) {
+	  // Start pruning empty chunks if their number exceeds 3. The chunk is
+	  // deliberately not rewound here : its addresses only come back into
+	  // circulation when it is recycled in reuseOrNewChunk()
+	  free(chunk->_base) ;
+	  delete chunk ;
+	  _chunkList.erase(iter) ;
+	  RooTrace::destroySpecial(_traceTag) ;
+	}
+	return kTRUE ;
+      }
+    }
+    return kFALSE ;
+  }
+
+  /// Return all memory to the system. Called on exit via the class cleanup()
+  /// hooks registered with RooSentinel to avoid reported memory leaks
+  void cleanup()
+  {
+    std::lock_guard<std::mutex> guard(_mutex) ;
+
+    for (std::list<Chunk*>::iterator iter = _chunkList.begin() ; iter != _chunkList.end() ; ++iter) {
+      free((*iter)->_base) ;
+      delete *iter ;
+      RooTrace::destroySpecial(_traceTag) ;
+    }
+    _chunkList.clear() ;
+  }
+
+private:
+
+  struct Chunk {
+    char* _base ;     // start of chunk memory
+    char* _cur ;      // next free slot in chunk
+    char* _end ;      // end of chunk memory
+    Int_t _useCount ; // number of live objects in chunk
+  } ;
+
+  /// Rewind an empty chunk and move it to the back of the list to make it the
+  /// active one, or allocate a fresh chunk if all chunks have live objects.
+  /// Empty chunks are only recycled once more than 3 chunks exist, keeping
+  /// the rate at which addresses are handed out again comparable to the
+  /// previous code that freed pruned pools back to the system (caches indexed
+  /// on set pointers rely on addresses not coming back quickly)
+  Chunk* reuseOrNewChunk(std::size_t bytes)
+  {
+    if (_chunkList.size() > 3) {
+      for (std::list<Chunk*>::iterator iter = _chunkList.begin() ; iter != _chunkList.end() ; ++iter) {
+	Chunk* chunk = *iter ;
+	if (chunk->_useCount == 0 && (std::size_t)(chunk->_end - chunk->_base) >= bytes) {
+	  chunk->_cur = chunk->_base ;
+	  _chunkList.erase(iter) ;
+	  _chunkList.push_back(chunk) ;
+	  return chunk ;
+	}
+      }
+    }
+
+    // Allocate chunks large enough for oversized requests as well
+    std::size_t size = (bytes > _chunkSize) ? bytes : _chunkSize ;
+    RooTrace::createSpecial(_traceTag, (int)size) ;
+
+    Chunk* chunk = new Chunk ;
+    chunk->_base = (char*) malloc(size) ;
+    chunk->_cur = chunk->_base ;
+    chunk->_end = chunk->_base + size ;
+    chunk->_useCount = 0 ;
+    _chunkList.push_back(chunk) ;
+    return chunk ;
+  }
+
+  Int_t countEmptyChunks() const
+  {
+    Int_t n(0) ;
+    for (std::list<Chunk*>::const_iterator iter = _chunkList.begin() ; iter != _chunkList.end() ; ++iter) {
+      if ((*iter)->_useCount == 0) n++ ;
+    }
+    return n ;
+  }
+
+  const char* _traceTag ;        // label used for RooTrace pool accounting
+  std::size_t _chunkSize ;       // default chunk size in bytes
+  std::list<Chunk*> _chunkList ; // all chunks, active chunk at the back
+  std::mutex _mutex ;            // serializes pool access across threads
+} ;
+
+#endif
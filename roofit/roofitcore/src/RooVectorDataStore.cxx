@@ -475,10 +475,152 @@ Int_t RooVectorDataStore::fill()
   Double_t t = _sumWeight + y;
   _sumWeightCarry = (t - _sumWeight) - y;
   _sumWeight = t;
-  _nEntries++ ;  
+  _nEntries++ ;
 
   return 0 ;
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append a block of nEvents entries directly to the storage vectors,
+/// without going through the per-event value buffers.
+///
+/// varList lists the variables to fill and data holds one contiguous
+/// array of nEvents values per listed variable, in the same order.
+/// All real-valued columns of the store must be covered by varList,
+/// except for the weight column, which is filled from wgt when a
+/// weight variable is defined (unit weights when wgt is null).
+/// Category columns and columns carrying per-event errors are not
+/// supported here, use fill() for those. Returns the number of
+/// appended events, or zero on error.
+
+Int_t RooVectorDataStore::addBulkData(const RooArgList& varList, const Double_t* const* data, Int_t nEvents, const Double_t* wgt)
+{
+  if (nEvents<=0) return 0 ;
+
+  if (_catStoreList.size()>0) {
+    coutE(DataHandling) << "RooVectorDataStore::addBulkData(" << GetName()
+			<< ") category columns are not supported in bulk import" << endl ;
+    return 0 ;
+  }
+
+  // Map each listed variable onto its storage vector
+  vector<RealVector*> columns ;
+  RooFIter iter = varList.fwdIterator() ;
+  RooAbsArg* arg ;
+  while ((arg=iter.next())) {
+
+    if (_wgtVar && string(_wgtVar->GetName())==arg->GetName()) {
+      coutE(DataHandling) << "RooVectorDataStore::addBulkData(" << GetName()
+			  << ") weight variable " << arg->GetName()
+			  << " must be filled through the wgt array, not through varList" << endl ;
+      return 0 ;
+    }
+
+    RealVector* col(0) ;
+    vector<RealVector*>::iterator riter = _realStoreList.begin() ;
+    for ( ; riter!=_realStoreList.end() ; ++riter) {
+      if (string((*riter)->bufArg()->GetName())==arg->GetName()) {
+	col = *riter ;
+	break ;
+      }
+    }
+    if (!col) {
+      vector<RealFullVector*>::iterator fiter = _realfStoreList.begin() ;
+      for ( ; fiter!=_realfStoreList.end() ; ++fiter) {
+	if (string((*fiter)->bufArg()->GetName())==arg->GetName()) {
+	  if ((*fiter)->_vecE || (*fiter)->_vecEL || (*fiter)->_vecEH) {
+	    coutE(DataHandling) << "RooVectorDataStore::addBulkData(" << GetName()
+				<< ") column " << arg->GetName()
+				<< " carries per-event errors, not supported in bulk import" << endl ;
+	    return 0 ;
+	  }
+	  col = *fiter ;
+	  break ;
+	}
+      }
+    }
+    if (!col) {
+      coutE(DataHandling) << "RooVectorDataStore::addBulkData(" << GetName()
+			  << ") no column found for variable " << arg->GetName() << endl ;
+      return 0 ;
+    }
+    if (std::find(columns.begin(),columns.end(),col)!=columns.end()) {
+      coutE(DataHandling) << "RooVectorDataStore::addBulkData(" << GetName()
+			  << ") variable " << arg->GetName() << " listed twice" << endl ;
+      return 0 ;
+    }
+    columns.push_back(col) ;
+  }
+
+  // Every column must be filled to keep the store rectangular
+  UInt_t nColumns = _realStoreList.size() + _realfStoreList.size() ;
+  if (columns.size() + (_wgtVar?1:0) != nColumns) {
+    coutE(DataHandling) << "RooVectorDataStore::addBulkData(" << GetName()
+			<< ") varList covers " << columns.size() << " columns, the store has "
+			<< nColumns << (_wgtVar?" including the weight":"") << endl ;
+    return 0 ;
+  }
+
+  // Locate the weight column before appending anything, so errors
+  // cannot leave the store with columns of different lengths
+  RealVector* wgtCol(0) ;
+  if (_wgtVar) {
+    vector<RealVector*>::iterator riter = _realStoreList.begin() ;
+    for ( ; riter!=_realStoreList.end() ; ++riter) {
+      if (string((*riter)->bufArg()->GetName())==_wgtVar->GetName()) {
+	wgtCol = *riter ;
+	break ;
+      }
+    }
+    if (!wgtCol) {
+      vector<RealFullVector*>::iterator fiter = _realfStoreList.begin() ;
+      for ( ; fiter!=_realfStoreList.end() ; ++fiter) {
+	if (string((*fiter)->bufArg()->GetName())==_wgtVar->GetName()) {
+	  if ((*fiter)->_vecE || (*fiter)->_vecEL || (*fiter)->_vecEH) {
+	    coutE(DataHandling) << "RooVectorDataStore::addBulkData(" << GetName()
+				<< ") weight column carries per-event errors, not supported in bulk import" << endl ;
+	    return 0 ;
+	  }
+	  wgtCol = *fiter ;
+	  break ;
+	}
+      }
+    }
+    if (!wgtCol) {
+      coutE(DataHandling) << "RooVectorDataStore::addBulkData(" << GetName()
+			  << ") no column found for weight variable " << _wgtVar->GetName() << endl ;
+      return 0 ;
+    }
+  }
+
+  // Append the value arrays
+  for (UInt_t i=0 ; i<columns.size() ; i++) {
+    columns[i]->appendData(data[i],nEvents) ;
+  }
+
+  // Append the weights and update the weight sum with Kahan's algorithm
+  if (wgtCol) {
+    if (wgt) {
+      wgtCol->appendData(wgt,nEvents) ;
+    } else {
+      wgtCol->appendData(1.0,nEvents) ;
+    }
+  }
+  Double_t sum(_sumWeight), carry(_sumWeightCarry) ;
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    Double_t y = (wgt ? wgt[i] : 1.) - carry ;
+    Double_t t = sum + y ;
+    carry = (t - sum) - y ;
+    sum = t ;
+  }
+  _sumWeight = sum ;
+  _sumWeightCarry = carry ;
+  _nEntries += nEvents ;
+
+  return nEvents ;
+}
  
 
 
@@ -625,7 +767,7 @@ const RooArgSet* RooVectorDataStore::getNative(Int_t index) const
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the weight of the n-th data point (n='index') in memory
 
-Double_t RooVectorDataStore::weight(Int_t index) const 
+Double_t RooVectorDataStore::weight(Int_t index) const
 {
   get(index) ;
   return weight() ;
@@ -633,6 +775,32 @@ Double_t RooVectorDataStore::weight(Int_t index) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the contiguous array of values of the given observable,
+/// or zero if no column is stored for it. Used by the batch evaluation mode of
+/// RooAbsPdf to process whole columns in vectorizable loops
+
+const Double_t* RooVectorDataStore::getBatchColumn(const RooAbsArg& arg) const
+{
+  std::vector<RealVector*>::const_iterator iter = _realStoreList.begin() ;
+  for (; iter!=_realStoreList.end() ; ++iter) {
+    if ((*iter)->bufArg()->namePtr()==arg.namePtr()) {
+      return (*iter)->dataVec() ;
+    }
+  }
+
+  std::vector<RealFullVector*>::const_iterator iter2 = _realfStoreList.begin() ;
+  for (; iter2!=_realfStoreList.end() ; ++iter2) {
+    if ((*iter2)->bufArg()->namePtr()==arg.namePtr()) {
+      return (*iter2)->dataVec() ;
+    }
+  }
+
+  return 0 ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the weight of the n-th data point (n='index') in memory
 
@@ -84,6 +84,7 @@ class ToyMCSampler: public TestStatSampler {
       virtual SamplingDistribution* GetSamplingDistribution(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributions(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributionsSingleWorker(RooArgSet& paramPoint);
+      virtual RooDataSet* GetSamplingDistributionsMultiProc(RooArgSet& paramPoint);
 
       virtual SamplingDistribution* AppendSamplingDistribution(
          RooArgSet& allParameters,
@@ -232,6 +233,11 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // number of fork-based worker processes used by
+      // GetSamplingDistributions (no PROOF infrastructure required);
+      // 0 or 1 runs serially; ignored when a ProofConfig is set
+      void SetNWorkers(Int_t n) { fNWorkers = n; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
@@ -278,6 +284,8 @@ class ToyMCSampler: public TestStatSampler {
 
       ProofConfig *fProofConfig;   //!
 
+      Int_t fNWorkers;   //! number of fork-based worker processes (0 or 1: serial)
+
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
       // objects below cache information and are mutable and non-persistent
@@ -28,6 +28,10 @@ TestStatistic.
 For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
+
+Alternatively, SetNWorkers(...) runs the toy loop in parallel on the
+local machine with fork-based worker processes, without any PROOF
+infrastructure.
 */
 
 #include "RooStats/ToyMCSampler.h"
@@ -50,6 +54,8 @@ ToyMCStudy with the RooStudyManager.
 #include "RooCategory.h"
 
 #include "TMath.h"
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
 
 
 using namespace RooFit;
@@ -176,6 +182,7 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -217,6 +224,7 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) :
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -329,8 +337,11 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig) {
+      if(fNWorkers > 1)
+         return GetSamplingDistributionsMultiProc(paramPointIn);
       return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
 
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
@@ -372,6 +383,76 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// In-process parallel run with fork-based workers. It is called
+/// automatically from inside GetSamplingDistributions when a number of
+/// workers was requested with SetNWorkers(...) and no ProofConfig is
+/// given. Each worker is a forked copy of this process, so it owns
+/// private clones of the pdf, the test statistics and all workspace
+/// objects; nothing is shared between workers. The per-worker datasets
+/// of test-statistic values are streamed back to the parent process and
+/// appended to a single output dataset.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProc(RooArgSet& paramPointIn)
+{
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad Configuration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   // turn adaptive sampling off if given
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   Int_t nWorkers = fNWorkers;
+   if(nWorkers > fNToys) nWorkers = fNToys;
+
+   // adjust number of toys per worker to keep the total number of toys constant
+   Int_t totToys = fNToys;
+   fNToys = (int)ceil((double)fNToys / (double)nWorkers); // round up
+
+   // each forked worker needs its own random sequence
+   unsigned int baseSeed =
+      RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+
+   // important to cache the paramPoint b/c test statistic might modify it
+   RooArgSet *paramPoint = (RooArgSet*) paramPointIn.snapshot();
+
+   ROOT::TProcessExecutor executor(nWorkers);
+   auto runOneWorker = [&](int workerId) -> RooDataSet* {
+      RooRandom::randomGenerator()->SetSeed(baseSeed + workerId + 1);
+      return GetSamplingDistributionsSingleWorker(*paramPoint);
+   };
+   std::vector<RooDataSet*> results = executor.Map(runOneWorker, ROOT::TSeqI(nWorkers));
+
+   // reset the number of toys
+   fNToys = totToys;
+   delete paramPoint;
+
+   // append the per-worker results to one dataset
+   RooDataSet* output = NULL;
+   for(unsigned int i=0; i < results.size(); i++) {
+      if(!results[i]) continue;
+      if(!output) {
+         output = results[i];
+      } else {
+         output->append(*results[i]);
+         delete results[i];
+      }
+   }
+   if(output) {
+      oocoutP((TObject*)NULL,Generation) << "Merged toys from " << nWorkers
+         << " workers - merged data size is " << output->numEntries() << endl;
+   }
+   return output;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
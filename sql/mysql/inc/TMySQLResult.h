@@ -32,6 +32,8 @@ public:
    Int_t       GetFieldCount();
    const char *GetFieldName(Int_t field);
    TSQLRow    *Next();
+   Int_t       FetchBatch(Int_t nrows, Int_t nfields, const char *coltypes,
+                          Double_t **numdata, Long64_t **intdata, TString **txtdata);
 
    ClassDef(TMySQLResult,0)  // MySQL query result
 };
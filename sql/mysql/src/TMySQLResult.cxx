@@ -113,3 +113,56 @@ TSQLRow *TMySQLResult::Next()
    else
       return new TMySQLRow((void *) fResult, (ULong_t) row);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fetch up to nrows rows into typed columnar buffers, see
+/// TSQLResult::FetchBatch for the buffer description.
+/// The rows are taken directly from the client library without creating
+/// a TMySQLRow per row and without intermediate string copies.
+
+Int_t TMySQLResult::FetchBatch(Int_t nrows, Int_t nfields, const char *coltypes,
+                               Double_t **numdata, Long64_t **intdata, TString **txtdata)
+{
+   if (!fResult) {
+      Error("FetchBatch", "result set closed");
+      return -1;
+   }
+   if (nrows <= 0 || nfields <= 0 || !coltypes)
+      return -1;
+   if (nfields > GetFieldCount())
+      nfields = GetFieldCount();
+
+   Int_t nstored = 0;
+   MYSQL_ROW row;
+   while (nstored < nrows && (row = mysql_fetch_row(fResult)) != 0) {
+      ULong_t *lengths = (ULong_t*) mysql_fetch_lengths(fResult);
+      for (Int_t i = 0; i < nfields; i++) {
+         switch (coltypes[i]) {
+            case 'D':
+               if (numdata && numdata[i])
+                  numdata[i][nstored] = row[i] ? atof(row[i]) : 0;
+               break;
+            case 'L':
+               if (intdata && intdata[i])
+#ifdef R__WIN32
+                  intdata[i][nstored] = row[i] ? _atoi64(row[i]) : 0;
+#else
+                  intdata[i][nstored] = row[i] ? atoll(row[i]) : 0;
+#endif
+               break;
+            case 'C':
+               if (txtdata && txtdata[i]) {
+                  if (row[i])
+                     txtdata[i][nstored] = TString(row[i], lengths ? (Ssiz_t) lengths[i] : (Ssiz_t) strlen(row[i]));
+                  else
+                     txtdata[i][nstored] = "";
+               }
+               break;
+            default:
+               break;
+         }
+      }
+      nstored++;
+   }
+   return nstored;
+}
@@ -6,6 +6,8 @@
 
 #include "TString.h"
 
+#include "TGraph.h"
+
 #include "TMultiGraph.h"
 
 #include "TMVA/IMethod.h"
@@ -30,6 +32,32 @@
 
 namespace TMVA {
 
+   /// The results of a single cross-validation fold. The folds can be trained
+   /// in separate worker processes, hence everything needed to merge a fold
+   /// into the final CrossValidationResult is collected in this (streamable)
+   /// class and sent back to the parent process.
+   class CrossValidationFoldResult {
+   public:
+      CrossValidationFoldResult() : fFold(0) {}
+      explicit CrossValidationFoldResult(UInt_t iFold) : fFold(iFold) {}
+
+      UInt_t fFold;
+
+      Float_t fROC = -1;
+      TGraph fROCCurve;
+
+      Double_t fSig = 0;
+      Double_t fSep = 0;
+
+      Double_t fEff01 = -1;
+      Double_t fEff10 = -1;
+      Double_t fEff30 = -1;
+      Double_t fEffArea = -1;
+      Double_t fTrainEff01 = -1;
+      Double_t fTrainEff10 = -1;
+      Double_t fTrainEff30 = -1;
+   };
+
    class CrossValidationResult {
       friend class CrossValidation;
 
@@ -74,6 +102,7 @@ namespace TMVA {
 
    class CrossValidation : public Envelope {
       UInt_t                 fNumFolds;     //!
+      UInt_t                 fNumWorkerProcs; //! number of worker processes the folds are distributed over (1: serial evaluation)
       CrossValidationResult  fResults;      //!
       Bool_t                 fFoldStatus;   //!
    public:
@@ -83,12 +112,17 @@ namespace TMVA {
       void SetNumFolds(UInt_t i);
       UInt_t GetNumFolds() {return fNumFolds;}
 
+      void SetNumWorkerProcs(UInt_t i) {fNumWorkerProcs = i;}
+      UInt_t GetNumWorkerProcs() {return fNumWorkerProcs;}
+
       virtual void Evaluate();
-//    void EvaluateFold(UInt_t fold);//used in ParallelExecution
+      CrossValidationFoldResult EvaluateFold(UInt_t fold);
 
       const CrossValidationResult& GetResults() const;
 
    private:
+      void StoreFoldResult(const CrossValidationFoldResult &result);
+
       std::unique_ptr<Factory> fClassifier;
       ClassDef(CrossValidation, 0);
    };
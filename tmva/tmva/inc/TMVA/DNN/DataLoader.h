@@ -22,6 +22,7 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <thread>
 
 #include "TMVA/Event.h"
 
@@ -115,6 +116,11 @@ TBatchIterator(TDataLoader<Data_t, AArchitecture> & dataLoader, size_t index = 0
  * the complete training set. Using the begin() and end() member functions allows
  * the user to iterate over the batches in one epoch.
  *
+ * When more than one buffer pair is used, the loader pipelines the batch
+ * assembly: while the caller processes the current batch, a background thread
+ * fills the host buffer of the next batch, so the event-to-matrix
+ * transposition overlaps with the forward/backward passes.
+ *
  * \tparam AData The input data type.
  * \tparam AArchitecture The achitecture class of the underlying architecture.
  */
@@ -142,14 +148,38 @@ private:
 
    std::vector<size_t> fSampleIndices; ///< Ordering of the samples in the epoch.
 
+   std::thread fPrefetchThread;   ///< Thread assembling the next host buffer.
+   size_t fPrefetchBatchIndex;    ///< Batch index the pending prefetch is for.
+   bool   fPrefetchPending;       ///< Whether a prefetch is in flight.
+
+   /** Assemble the host buffer of the given stream slot for the given batch. */
+   void PrefetchBatch(size_t batchIndex, size_t streamIndex);
+   /** Wait for a pending prefetch to complete. */
+   void JoinPrefetch()
+   {
+      if (fPrefetchThread.joinable()) fPrefetchThread.join();
+      fPrefetchPending = false;
+   }
+
 public:
 
    TDataLoader(const Data_t & data, size_t nSamples, size_t batchSize,
                size_t nInputFeatures, size_t nOutputFeatures, size_t nStreams = 1);
-   TDataLoader(const TDataLoader  &) = default;
-   TDataLoader(      TDataLoader &&) = default;
-   TDataLoader & operator=(const TDataLoader  &) = default;
-   TDataLoader & operator=(      TDataLoader &&) = default;
+   // The prefetch thread refers to this object, hence it is not copied or
+   // moved: copies start with an idle pipeline.
+   TDataLoader(const TDataLoader &other)
+       : fData(other.fData), fNSamples(other.fNSamples),
+         fBatchSize(other.fBatchSize), fNInputFeatures(other.fNInputFeatures),
+         fNOutputFeatures(other.fNOutputFeatures), fBatchIndex(other.fBatchIndex),
+         fNStreams(other.fNStreams), fDeviceBuffers(other.fDeviceBuffers),
+         fHostBuffers(other.fHostBuffers), fSampleIndices(other.fSampleIndices),
+         fPrefetchThread(), fPrefetchBatchIndex(0), fPrefetchPending(false)
+   {
+   }
+   TDataLoader(      TDataLoader &&) = delete;
+   TDataLoader & operator=(const TDataLoader  &) = delete;
+   TDataLoader & operator=(      TDataLoader &&) = delete;
+   ~TDataLoader() { JoinPrefetch(); }
 
    /** Copy input matrix into the given host buffer. Function to be specialized by
     *  the architecture-specific backend. */
@@ -196,7 +226,8 @@ TDataLoader<Data_t, AArchitecture>::TDataLoader(
     : fData(data), fNSamples(nSamples), fBatchSize(batchSize),
       fNInputFeatures(nInputFeatures), fNOutputFeatures(nOutputFeatures),
       fBatchIndex(0), fNStreams(nStreams), fDeviceBuffers(), fHostBuffers(),
-      fSampleIndices()
+      fSampleIndices(), fPrefetchThread(), fPrefetchBatchIndex(0),
+      fPrefetchPending(false)
 {
    size_t inputMatrixSize  = fBatchSize * fNInputFeatures;
    size_t outputMatrixSize = fBatchSize * fNOutputFeatures;
@@ -215,10 +246,29 @@ TDataLoader<Data_t, AArchitecture>::TDataLoader(
 
 //______________________________________________________________________________
 template<typename Data_t, typename AArchitecture>
-TBatch<AArchitecture> TDataLoader<Data_t, AArchitecture>::GetBatch()
+void TDataLoader<Data_t, AArchitecture>::PrefetchBatch(size_t batchIndex,
+                                                       size_t streamIndex)
 {
-   fBatchIndex %= (fNSamples / fBatchSize); // Cycle through samples.
+   size_t inputMatrixSize  = fBatchSize * fNInputFeatures;
+   size_t outputMatrixSize = fBatchSize * fNOutputFeatures;
+
+   HostBuffer_t & hostBuffer = fHostBuffers[streamIndex];
+   HostBuffer_t inputHostBuffer  = hostBuffer.GetSubBuffer(0, inputMatrixSize);
+   HostBuffer_t outputHostBuffer = hostBuffer.GetSubBuffer(inputMatrixSize,
+                                                           outputMatrixSize);
+   IndexIterator_t sampleIndexIterator =
+       fSampleIndices.begin() + batchIndex * fBatchSize;
+
+   CopyInput(inputHostBuffer,   sampleIndexIterator, fBatchSize);
+   CopyOutput(outputHostBuffer, sampleIndexIterator, fBatchSize);
+}
 
+//______________________________________________________________________________
+template<typename Data_t, typename AArchitecture>
+TBatch<AArchitecture> TDataLoader<Data_t, AArchitecture>::GetBatch()
+{
+   size_t nBatches = fNSamples / fBatchSize;
+   fBatchIndex %= nBatches; // Cycle through samples.
 
    size_t inputMatrixSize  = fBatchSize * fNInputFeatures;
    size_t outputMatrixSize = fBatchSize * fNOutputFeatures;
@@ -227,18 +277,31 @@ TBatch<AArchitecture> TDataLoader<Data_t, AArchitecture>::GetBatch()
    HostBuffer_t   & hostBuffer   = fHostBuffers[streamIndex];
    DeviceBuffer_t & deviceBuffer = fDeviceBuffers[streamIndex];
 
-   HostBuffer_t inputHostBuffer  = hostBuffer.GetSubBuffer(0, inputMatrixSize);
-   HostBuffer_t outputHostBuffer = hostBuffer.GetSubBuffer(inputMatrixSize,
-                                                           outputMatrixSize);
-
    DeviceBuffer_t inputDeviceBuffer  = deviceBuffer.GetSubBuffer(0, inputMatrixSize);
    DeviceBuffer_t outputDeviceBuffer = deviceBuffer.GetSubBuffer(inputMatrixSize,
                                                                  outputMatrixSize);
-   size_t sampleIndex = fBatchIndex * fBatchSize;
-   IndexIterator_t sampleIndexIterator = fSampleIndices.begin() + sampleIndex;
 
-   CopyInput(inputHostBuffer,   sampleIndexIterator, fBatchSize);
-   CopyOutput(outputHostBuffer, sampleIndexIterator, fBatchSize);
+   // Use the host buffer assembled by the prefetch thread if it is the one
+   // for this batch, otherwise fill it synchronously.
+   bool prefetched = false;
+   if (fPrefetchPending) {
+      JoinPrefetch();
+      prefetched = (fPrefetchBatchIndex == fBatchIndex);
+   }
+   if (!prefetched) {
+      PrefetchBatch(fBatchIndex, streamIndex);
+   }
+
+   // Start assembling the next batch of this epoch in the background. The
+   // first batch of an epoch is always filled synchronously, after any
+   // reshuffling of the sample indices.
+   if (fNStreams > 1 && fBatchIndex + 1 < nBatches) {
+      fPrefetchBatchIndex = fBatchIndex + 1;
+      fPrefetchPending = true;
+      fPrefetchThread = std::thread(&TDataLoader::PrefetchBatch, this,
+                                    fPrefetchBatchIndex,
+                                    fPrefetchBatchIndex % fNStreams);
+   }
 
    deviceBuffer.CopyFrom(hostBuffer);
    Matrix_t  inputMatrix(inputDeviceBuffer,  fBatchSize, fNInputFeatures);
@@ -252,6 +315,7 @@ TBatch<AArchitecture> TDataLoader<Data_t, AArchitecture>::GetBatch()
 template<typename Data_t, typename AArchitecture>
 void TDataLoader<Data_t, AArchitecture>::Shuffle()
 {
+   JoinPrefetch();
    std::random_shuffle(fSampleIndices.begin(), fSampleIndices.end());
 }
 
@@ -50,6 +50,8 @@
 #include "TMVA/RegressionVariance.h"
 #include "TMVA/DataSetInfo.h"
 
+#include <map>
+
 class TRandom3;
 
 namespace TMVA {
@@ -185,6 +187,7 @@ namespace TMVA {
       inline void SetUseFisherCuts(Bool_t t=kTRUE)  { fUseFisherCuts = t;}
       inline void SetMinLinCorrForFisher(Double_t min){fMinLinCorrForFisher = min;}
       inline void SetUseExclusiveVars(Bool_t t=kTRUE){fUseExclusiveVars = t;}
+      inline void SetUseHistSubtraction(Bool_t t=kTRUE){fUseHistSubtraction = t;}
       inline void SetNVars(Int_t n){fNvars = n;}
 
 
@@ -202,6 +205,7 @@ namespace TMVA {
       Bool_t    fUseFisherCuts;  // use multivariate splits using the Fisher criterium
       Double_t  fMinLinCorrForFisher; // the minimum linear correlation between two variables demanded for use in fisher criterium in node splitting
       Bool_t    fUseExclusiveVars; // individual variables already used in fisher criterium are not anymore analysed individually for node splitting
+      Bool_t    fUseHistSubtraction; // derive the split histograms of the second daughter node by subtracting the sibling histograms from the parent ones
 
       SeparationBase *fSepType;  // the separation crition
       RegressionVariance *fRegType;  // the separation crition used in Regression
@@ -235,6 +239,24 @@ namespace TMVA {
 
       DataSetInfo*  fDataSetInfo;
 
+      // the raw (non-cumulative) split histograms of one node, kept while its
+      // daughter nodes are being trained in the histogram-subtraction mode:
+      // since both daughters inherit the parent binning, the daughter trained
+      // second can derive its histograms from the parent and sibling ones
+      // instead of refilling them from the events
+      struct NodeHists {
+         std::vector<UInt_t>                  fNBins;           // number of bins per variable
+         std::vector<Double_t>                fXmin;            // lower histogram edge per variable
+         std::vector<Double_t>                fXmax;            // upper histogram edge per variable
+         std::vector<Char_t>                  fUsed;            // variable entered the cut scan
+         std::vector< std::vector<Double_t> > fSelS;            // weighted signal events per bin
+         std::vector< std::vector<Double_t> > fSelB;            // weighted background events per bin
+         std::vector< std::vector<Double_t> > fSelS_unWeighted; // raw signal counts per bin
+         std::vector< std::vector<Double_t> > fSelB_unWeighted; // raw background counts per bin
+         std::vector< std::vector<Double_t> > fTarget;          // sum of weighted regression targets per bin
+         std::vector< std::vector<Double_t> > fTarget2;         // sum of weighted squared targets per bin
+      };
+      std::map<const DecisionTreeNode*, NodeHists> fNodeHists; //! per-node histogram cache used during training only
 
       ClassDef(DecisionTree,0);               // implementation of a Decision Tree
    };
@@ -98,6 +98,10 @@ namespace TMVA {
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0);
 
+      // calculate the MVA values for a batch of events, tree by tree over
+      // the compiled forest
+      std::vector<Double_t> GetMvaValues( const std::vector<const TMVA::Event*>& events );
+
       // get the actual forest size (might be less than fNTrees, the requested one, if boosting is stopped early
       UInt_t   GetNTrees() const {return fForest.size();}
    private:
@@ -105,6 +109,17 @@ namespace TMVA {
       Double_t PrivateGetMvaValue( const TMVA::Event *ev, Double_t* err=0, Double_t* errUpper=0, UInt_t useNTrees=0 );
       void     BoostMonitor(Int_t iTree);
 
+      // flattened representation of a decision tree node for fast inference:
+      // both children are stored adjacently in a contiguous per-tree array,
+      // leaf nodes carry the leaf value itself and a negative variable index
+      struct CompiledNode {
+         Float_t fCutValue;  // cut threshold; leaf value for leaf nodes
+         Int_t   fSelector;  // input variable index, -1 flags a leaf node
+         Int_t   fChildBase; // index of the below-cut child, the at-or-above child is at fChildBase+1
+      };
+      void     CompileForest();
+      Double_t EvaluateCompiledTree( const CompiledNode* nodes, const Float_t* x ) const;
+
    public:
       const std::vector<Float_t>& GetMulticlassValues();
 
@@ -199,6 +214,7 @@ namespace TMVA {
 
       Int_t                           fNTrees;          // number of decision trees requested
       std::vector<DecisionTree*>      fForest;          // the collection of decision trees
+      std::vector< std::vector<CompiledNode> > fCompiledForest; //! flattened trees, rebuilt when the weights are read
       std::vector<double>             fBoostWeights;    // the weights applied in the individual boosts
       Double_t                        fSigToBkgFraction;// Signal to Background fraction assumed during training
       TString                         fBoostType;       // string specifying the boost type
@@ -225,6 +241,7 @@ namespace TMVA {
       Bool_t                          fUseFisherCuts;   // use multivariate splits using the Fisher criterium
       Double_t                        fMinLinCorrForFisher; // the minimum linear correlation between two variables demanded for use in fisher criterium in node splitting
       Bool_t                          fUseExclusiveVars; // individual variables already used in fisher criterium are not anymore analysed individually for node splitting
+      Bool_t                          fUseHistSubtraction; // derive the split histograms of the second daughter node by subtracting the sibling histograms from the parent ones
       Bool_t                          fUseYesNoLeaf;    // use sig or bkg classification in leave nodes or sig/bkg
       Double_t                        fNodePurityLimit; // purity limit for sig/bkg nodes
       UInt_t                          fNNodesMax;       // max # of nodes
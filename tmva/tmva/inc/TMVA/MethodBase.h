@@ -191,6 +191,10 @@ namespace TMVA {
       // signal/background classification response
       Double_t GetMvaValue( const TMVA::Event* const ev, Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // batched classification response; methods with a batched backend
+      // (e.g. an accelerator) override this to evaluate all events per launch
+      virtual std::vector<Double_t> GetMvaValues( const std::vector<const TMVA::Event*>& events );
+
    protected:
       // helper function to set errors to -1
       void NoErrorCalc(Double_t* const err, Double_t* const errUpper);
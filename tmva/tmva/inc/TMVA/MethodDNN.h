@@ -144,6 +144,7 @@ public:
    void TrainCpu();
 
    virtual Double_t GetMvaValue( Double_t* err=0, Double_t* errUpper=0 );
+   virtual std::vector<Double_t> GetMvaValues( const std::vector<const Event*>& events );
    virtual const std::vector<Float_t>& GetRegressionValues();
    virtual const std::vector<Float_t>& GetMulticlassValues();
 
@@ -89,6 +89,10 @@ namespace TMVA {
       // returns the MVA response for given event
       Double_t EvaluateMVA( const std::vector<Float_t> &, const TString& methodTag, Double_t aux = 0 );
       Double_t EvaluateMVA( const std::vector<Double_t>&, const TString& methodTag, Double_t aux = 0 );
+
+      // batch evaluation: one MVA value per input event; methods with a
+      // batched backend evaluate the whole batch in a few device launches
+      std::vector<Double_t> EvaluateMVA( const std::vector<std::vector<Float_t> >& inputBatch, const TString& methodTag );
       Double_t EvaluateMVA( MethodBase* method,           Double_t aux = 0 );
       Double_t EvaluateMVA( const TString& methodTag,     Double_t aux = 0 );
 
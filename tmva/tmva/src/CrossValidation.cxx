@@ -18,6 +18,11 @@
 #include "TGraph.h"
 #include "TMath.h"
 
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 #include <iostream>
 #include <memory>
 
@@ -91,7 +96,7 @@ TCanvas* TMVA::CrossValidationResult::Draw(const TString name) const
 }
 
 TMVA::CrossValidation::CrossValidation(TMVA::DataLoader *dataloader):TMVA::Envelope("CrossValidation",dataloader),
-fNumFolds(5),fClassifier(new TMVA::Factory("CrossValidation","!V:!ROC:Silent:!ModelPersistence:!Color:!DrawProgressBar:AnalysisType=Classification"))
+fNumFolds(5),fNumWorkerProcs(1),fClassifier(new TMVA::Factory("CrossValidation","!V:!ROC:Silent:!ModelPersistence:!Color:!DrawProgressBar:AnalysisType=Classification"))
 {
    fFoldStatus=kFALSE;
 }
@@ -127,51 +132,26 @@ void TMVA::CrossValidation::Evaluate()
    }
 
    // Process K folds
-   for(UInt_t i=0; i<fNumFolds; ++i){
-      Log() << kDEBUG << "Fold (" << methodTitle << "): " << i << Endl;
-      // Get specific fold of dataset and setup method
-      TString foldTitle = methodTitle;
-      foldTitle += "_fold";
-      foldTitle += i+1;
-
-      fDataLoader->PrepareFoldDataSet(i, TMVA::Types::kTesting);
-      MethodBase* smethod = fClassifier->BookMethod(fDataLoader.get(), methodName, methodTitle, methodOptions);
-
-      // Train method
-      Event::SetIsTraining(kTRUE);
-      smethod->TrainMethod();
-
-      // Test method
-      Event::SetIsTraining(kFALSE);
-      smethod->AddOutput(Types::kTesting, smethod->GetAnalysisType());
-      smethod->TestClassification();
-
-      // Store results
-      fResults.fROCs[i] = fClassifier->GetROCIntegral(fDataLoader->GetName(),methodTitle);
-
-      TGraph* gr = fClassifier->GetROCCurve(fDataLoader->GetName(), methodTitle, true);
-      gr->SetLineColor(i+1);
-      gr->SetLineWidth(2);
-      gr->SetTitle(foldTitle.Data());
-      fResults.fROCCurves->Add(gr);
-
-      fResults.fSigs.push_back(smethod->GetSignificance());
-      fResults.fSeps.push_back(smethod->GetSeparation());
-
-      Double_t err;
-      fResults.fEff01s.push_back(smethod->GetEfficiency("Efficiency:0.01",Types::kTesting, err));
-      fResults.fEff10s.push_back(smethod->GetEfficiency("Efficiency:0.10",Types::kTesting,err));
-      fResults.fEff30s.push_back(smethod->GetEfficiency("Efficiency:0.30",Types::kTesting,err));
-      fResults.fEffAreas.push_back(smethod->GetEfficiency(""             ,Types::kTesting,err));
-      fResults.fTrainEff01s.push_back(smethod->GetTrainingEfficiency("Efficiency:0.01"));
-      fResults.fTrainEff10s.push_back(smethod->GetTrainingEfficiency("Efficiency:0.10"));
-      fResults.fTrainEff30s.push_back(smethod->GetTrainingEfficiency("Efficiency:0.30"));
-
-      // Clean-up for this fold
-      smethod->Data()->DeleteResults(smethod->GetMethodName(), Types::kTesting, Types::kClassification);
-      smethod->Data()->DeleteResults(smethod->GetMethodName(), Types::kTraining, Types::kClassification);
-      fClassifier->DeleteAllMethods();
-      fClassifier->fMethodsMap.clear();
+   if (fNumWorkerProcs > 1) {
+#ifndef R__WIN32
+      // The folds are independent, so they are distributed over forked worker
+      // processes. The workers only inherit a copy-on-write view of the
+      // prepared dataset from the parent, i.e. the input is not duplicated
+      // per fold, and each worker streams the results of its folds back.
+      ROOT::TProcessExecutor workers(fNumWorkerProcs);
+      auto foldResults = workers.Map(
+         [this](UInt_t iFold) { return this->EvaluateFold(iFold); },
+         ROOT::TSeqU(fNumFolds));
+      for (auto &foldResult : foldResults) StoreFoldResult(foldResult);
+#else
+      Log() << kWARNING << "Parallel fold evaluation is not supported on Windows, I will run the folds serially!" << Endl;
+      fNumWorkerProcs = 1;
+#endif
+   }
+   if (fNumWorkerProcs <= 1) {
+      for(UInt_t i=0; i<fNumFolds; ++i){
+         StoreFoldResult(EvaluateFold(i));
+      }
    }
 
    TMVA::gConfig().SetSilent(kFALSE);
@@ -179,6 +159,92 @@ void TMVA::CrossValidation::Evaluate()
    TMVA::gConfig().SetSilent(kTRUE);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Train and test the booked method on a single fold. The fold evaluation is
+/// self-contained, such that it can run either serially in the parent process
+/// or inside a forked worker process, which sends the returned
+/// CrossValidationFoldResult back to the parent.
+
+TMVA::CrossValidationFoldResult TMVA::CrossValidation::EvaluateFold(UInt_t iFold)
+{
+   TString methodName    = fMethod.GetValue<TString>("MethodName");
+   TString methodTitle   = fMethod.GetValue<TString>("MethodTitle");
+   TString methodOptions = fMethod.GetValue<TString>("MethodOptions");
+
+   Log() << kDEBUG << "Fold (" << methodTitle << "): " << iFold << Endl;
+
+   CrossValidationFoldResult result(iFold);
+
+   // Get specific fold of dataset and setup method
+   TString foldTitle = methodTitle;
+   foldTitle += "_fold";
+   foldTitle += iFold+1;
+
+   fDataLoader->PrepareFoldDataSet(iFold, TMVA::Types::kTesting);
+   MethodBase* smethod = fClassifier->BookMethod(fDataLoader.get(), methodName, methodTitle, methodOptions);
+
+   // Train method
+   Event::SetIsTraining(kTRUE);
+   smethod->TrainMethod();
+
+   // Test method
+   Event::SetIsTraining(kFALSE);
+   smethod->AddOutput(Types::kTesting, smethod->GetAnalysisType());
+   smethod->TestClassification();
+
+   // Store results
+   result.fROC = fClassifier->GetROCIntegral(fDataLoader->GetName(),methodTitle);
+
+   TGraph* gr = fClassifier->GetROCCurve(fDataLoader->GetName(), methodTitle, true);
+   if (gr) {
+      gr->SetLineColor(iFold+1);
+      gr->SetLineWidth(2);
+      gr->SetTitle(foldTitle.Data());
+      result.fROCCurve = *gr;
+      delete gr;
+   }
+
+   result.fSig = smethod->GetSignificance();
+   result.fSep = smethod->GetSeparation();
+
+   Double_t err;
+   result.fEff01 = smethod->GetEfficiency("Efficiency:0.01",Types::kTesting, err);
+   result.fEff10 = smethod->GetEfficiency("Efficiency:0.10",Types::kTesting,err);
+   result.fEff30 = smethod->GetEfficiency("Efficiency:0.30",Types::kTesting,err);
+   result.fEffArea = smethod->GetEfficiency(""             ,Types::kTesting,err);
+   result.fTrainEff01 = smethod->GetTrainingEfficiency("Efficiency:0.01");
+   result.fTrainEff10 = smethod->GetTrainingEfficiency("Efficiency:0.10");
+   result.fTrainEff30 = smethod->GetTrainingEfficiency("Efficiency:0.30");
+
+   // Clean-up for this fold
+   smethod->Data()->DeleteResults(smethod->GetMethodName(), Types::kTesting, Types::kClassification);
+   smethod->Data()->DeleteResults(smethod->GetMethodName(), Types::kTraining, Types::kClassification);
+   fClassifier->DeleteAllMethods();
+   fClassifier->fMethodsMap.clear();
+
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the results of one fold into the accumulated cross-validation results.
+
+void TMVA::CrossValidation::StoreFoldResult(const CrossValidationFoldResult &result)
+{
+   fResults.fROCs[result.fFold] = result.fROC;
+   fResults.fROCCurves->Add(new TGraph(result.fROCCurve));
+
+   fResults.fSigs.push_back(result.fSig);
+   fResults.fSeps.push_back(result.fSep);
+
+   fResults.fEff01s.push_back(result.fEff01);
+   fResults.fEff10s.push_back(result.fEff10);
+   fResults.fEff30s.push_back(result.fEff30);
+   fResults.fEffAreas.push_back(result.fEffArea);
+   fResults.fTrainEff01s.push_back(result.fTrainEff01);
+   fResults.fTrainEff10s.push_back(result.fTrainEff10);
+   fResults.fTrainEff30s.push_back(result.fTrainEff30);
+}
+
 const TMVA::CrossValidationResult& TMVA::CrossValidation::GetResults() const {
    if(fResults.fROCs.size()==0) Log() << kFATAL << "No cross-validation results available" << Endl;
    return fResults;
@@ -86,6 +86,11 @@ more signal respective background events from the training sample.
 #include "TMVA/CostComplexityPruneTool.h"
 #include "TMVA/ExpectedErrorPruneTool.h"
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TParallelSort.hxx"
+#endif
+
 const Int_t TMVA::DecisionTree::fgRandomSeed = 0; // set nonzero for debugging and zero for random seeds
 
 using std::vector;
@@ -120,6 +125,7 @@ TMVA::DecisionTree::DecisionTree():
    fUseFisherCuts  (kFALSE),
    fMinLinCorrForFisher (1),
    fUseExclusiveVars (kTRUE),
+   fUseHistSubtraction (kFALSE),
    fSepType        (NULL),
    fRegType        (NULL),
    fMinSize        (0),
@@ -157,6 +163,7 @@ TMVA::DecisionTree::DecisionTree( TMVA::SeparationBase *sepType, Float_t minSize
    fUseFisherCuts  (kFALSE),
    fMinLinCorrForFisher (1),
    fUseExclusiveVars (kTRUE),
+   fUseHistSubtraction (kFALSE),
    fSepType        (sepType),
    fRegType        (NULL),
    fMinSize        (0),
@@ -205,6 +212,7 @@ TMVA::DecisionTree::DecisionTree( const DecisionTree &d ):
    fUseFisherCuts  (d.fUseFisherCuts),
    fMinLinCorrForFisher (d.fMinLinCorrForFisher),
    fUseExclusiveVars (d.fUseExclusiveVars),
+   fUseHistSubtraction (d.fUseHistSubtraction),
    fSepType    (d.fSepType),
    fRegType    (d.fRegType),
    fMinSize    (d.fMinSize),
@@ -303,6 +311,7 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
       this->GetRoot()->SetPos('s');
       this->GetRoot()->SetDepth(0);
       this->GetRoot()->SetParentTree(this);
+      fNodeHists.clear(); // drop histograms possibly left over from a previous training
       fMinSize = fMinNodeSize/100. * eventSample.size();
       if (GetTreeID()==0){
          Log() << kDEBUG << "\tThe minimal node size MinNodeSize=" << fMinNodeSize << " fMinNodeSize="<<fMinNodeSize<< "% is translated to an actual number of events = "<< fMinSize<< " for the training sample size of " << eventSample.size() << Endl;
@@ -492,6 +501,13 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
          this->BuildTree(rightSample, rightNode);
          this->BuildTree(leftSample,  leftNode );
 
+         if (fUseHistSubtraction) {
+            // the daughter histograms were only needed while their own daughters
+            // were split: drop them to keep the cache at the size of one tree path
+            fNodeHists.erase(rightNode);
+            fNodeHists.erase(leftNode);
+         }
+
       }
    }
    else{ // it is a leaf node
@@ -1025,6 +1041,28 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
    UInt_t cNvars = fNvars;
    if (fUseFisherCuts && fisherOK) cNvars++;  // use the Fisher output simple as additional variable
 
+   // histogram-subtraction mode: when the parent histograms are still cached,
+   // the daughters inherit the parent binning, which makes the bin contents of
+   // the two daughters add up exactly to the parent ones. The daughter trained
+   // second can then skip the event scan altogether and derive its histograms
+   // by subtracting the sibling ones from the parent ones.
+   // The mode is not available with per-node variable subsets (randomised
+   // trees) or per-node fisher discriminants, as there the parent and the
+   // daughters do not scan the same set of variables.
+   const NodeHists *parentHists  = 0;
+   const NodeHists *siblingHists = 0;
+   Bool_t cacheHists = fUseHistSubtraction && !fRandomisedTree && !fUseFisherCuts;
+   if (cacheHists && node->GetParent()) {
+      std::map<const DecisionTreeNode*, NodeHists>::const_iterator it = fNodeHists.find(node->GetParent());
+      if (it != fNodeHists.end()) {
+         parentHists = &(it->second);
+         DecisionTreeNode *sibling = (node->GetParent()->GetLeft() == node) ?
+            node->GetParent()->GetRight() : node->GetParent()->GetLeft();
+         it = fNodeHists.find(sibling);
+         if (it != fNodeHists.end()) siblingHists = &(it->second);
+      }
+   }
+
    UInt_t*   nBins = new UInt_t [cNvars];
    Double_t* binWidth = new Double_t [cNvars];
    Double_t* invBinWidth = new Double_t [cNvars];
@@ -1044,6 +1082,7 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
             nBins[ivar] = node->GetSampleMax(ivar) - node->GetSampleMin(ivar) + 1;
          }
       }
+      if (parentHists) nBins[ivar] = parentHists->fNBins[ivar]; // inherit the parent binning
 
       nSelS[ivar] = new Double_t [nBins[ivar]];
       nSelB[ivar] = new Double_t [nBins[ivar]];
@@ -1055,11 +1094,40 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
 
    }
 
+   // Gather the per-event data into contiguous columns once: the splitting
+   // scans below then stream over flat arrays instead of dereferencing the
+   // Event pointers for every variable/bin access, which lets the compiler
+   // vectorize the scans and avoids the per-event pointer chasing.
+   Double_t **eventData    = new Double_t*[cNvars];
+   Double_t  *eventWeights = new Double_t[nevents];
+   Bool_t    *eventIsSig   = new Bool_t[nevents];
+   Double_t  *eventTargets = DoRegression() ? new Double_t[nevents] : 0;
+   for (UInt_t ivar=0; ivar<cNvars; ivar++) eventData[ivar] = 0;
+   for (UInt_t iev=0; iev<nevents; iev++) {
+      const Event *ev = eventSample[iev];
+      eventWeights[iev] = ev->GetWeight();
+      eventIsSig[iev]   = (ev->GetClass() == fSigClass);
+      if (eventTargets) eventTargets[iev] = ev->GetTarget(0);
+   }
+   if (useVariable[fNvars] && cNvars > fNvars) { // the fisher variable
+      eventData[fNvars] = new Double_t[nevents];
+      for (UInt_t iev=0; iev<nevents; iev++) {
+         Double_t result = fisherCoeff[fNvars]; // the fisher constant offset
+         for (UInt_t jvar=0; jvar<fNvars; jvar++)
+            result += fisherCoeff[jvar]*(eventSample[iev])->GetValueFast(jvar);
+         eventData[fNvars][iev] = result;
+      }
+   }
+
    Double_t *xmin = new Double_t[cNvars];
    Double_t *xmax = new Double_t[cNvars];
 
    for (UInt_t ivar=0; ivar < cNvars; ivar++) {
-      if (ivar < fNvars){
+      if (parentHists) { // the parent binning (and variable selection) is inherited
+         xmin[ivar]=parentHists->fXmin[ivar];
+         xmax[ivar]=parentHists->fXmax[ivar];
+         useVariable[ivar]=parentHists->fUsed[ivar];
+      } else if (ivar < fNvars){
          xmin[ivar]=node->GetSampleMin(ivar);
          xmax[ivar]=node->GetSampleMax(ivar);
          if (almost_equal_float(xmax[ivar], xmin[ivar])) {
@@ -1071,13 +1139,9 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
       } else { // the fisher variable
          xmin[ivar]=999;
          xmax[ivar]=-999;
-         // too bad, for the moment I don't know how to do this without looping
-         // once to get the "min max" and then AGAIN to fill the histogram
          for (UInt_t iev=0; iev<nevents; iev++) {
-            // returns the Fisher value (no fixed range)
-            Double_t result = fisherCoeff[fNvars]; // the fisher constant offset
-            for (UInt_t jvar=0; jvar<fNvars; jvar++)
-               result += fisherCoeff[jvar]*(eventSample[iev])->GetValueFast(jvar);
+            // the Fisher value (no fixed range), from the gathered column
+            Double_t result = eventData[ivar][iev];
             if (result > xmax[ivar]) xmax[ivar]=result;
             if (result < xmin[ivar]) xmin[ivar]=result;
          }
@@ -1130,32 +1194,56 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
    nTotS=0; nTotB=0;
    nTotS_unWeighted=0; nTotB_unWeighted=0;
    for (UInt_t iev=0; iev<nevents; iev++) {
-
-      Double_t eventWeight =  eventSample[iev]->GetWeight();
-      if (eventSample[iev]->GetClass() == fSigClass) {
-         nTotS+=eventWeight;
+      if (eventIsSig[iev]) {
+         nTotS+=eventWeights[iev];
          nTotS_unWeighted++;    }
       else {
-         nTotB+=eventWeight;
+         nTotB+=eventWeights[iev];
          nTotB_unWeighted++;
       }
+   }
 
-      Int_t iBin=-1;
+   if (siblingHists) {
+      // both daughters share the parent binning: the histograms of this one
+      // are the parent ones minus the sibling ones, no event scan needed
       for (UInt_t ivar=0; ivar < cNvars; ivar++) {
-         // now scan trough the cuts for each variable and find which one gives
-         // the best separationGain at the current stage.
-         if ( useVariable[ivar] ) {
-            Double_t eventData;
-            if (ivar < fNvars) eventData = eventSample[iev]->GetValueFast(ivar);
-            else { // the fisher variable
-               eventData = fisherCoeff[fNvars];
-               for (UInt_t jvar=0; jvar<fNvars; jvar++)
-                  eventData += fisherCoeff[jvar]*(eventSample[iev])->GetValueFast(jvar);
-
+         if (!useVariable[ivar]) continue;
+         for (UInt_t ibin=0; ibin<nBins[ivar]; ibin++) {
+            nSelS[ivar][ibin] = parentHists->fSelS[ivar][ibin] - siblingHists->fSelS[ivar][ibin];
+            nSelB[ivar][ibin] = parentHists->fSelB[ivar][ibin] - siblingHists->fSelB[ivar][ibin];
+            nSelS_unWeighted[ivar][ibin] = parentHists->fSelS_unWeighted[ivar][ibin] - siblingHists->fSelS_unWeighted[ivar][ibin];
+            nSelB_unWeighted[ivar][ibin] = parentHists->fSelB_unWeighted[ivar][ibin] - siblingHists->fSelB_unWeighted[ivar][ibin];
+            if (DoRegression()) {
+               target[ivar][ibin]  = parentHists->fTarget[ivar][ibin]  - siblingHists->fTarget[ivar][ibin];
+               target2[ivar][ibin] = parentHists->fTarget2[ivar][ibin] - siblingHists->fTarget2[ivar][ibin];
             }
+         }
+      }
+   } else {
+
+      // gather the columns of the remaining variables used in the scan (the
+      // fisher column, if any, has been filled above already)
+      for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+         if (!useVariable[ivar]) continue;
+         eventData[ivar] = new Double_t[nevents];
+         for (UInt_t iev=0; iev<nevents; iev++)
+            eventData[ivar][iev] = eventSample[iev]->GetValueFast(ivar);
+      }
+
+      // now scan through the cuts for each variable and find which one gives
+      // the best separationGain at the current stage. The scan streams over one
+      // contiguous column at a time.
+      for (UInt_t ivar=0; ivar < cNvars; ivar++) {
+         if (!useVariable[ivar]) continue;
+         const Double_t *vals = eventData[ivar];
+         const Double_t  vmin = xmin[ivar];
+         const Double_t  invBW = invBinWidth[ivar];
+         const Int_t     maxBin = Int_t(nBins[ivar]-1);
+         for (UInt_t iev=0; iev<nevents; iev++) {
             // "maximum" is nbins-1 (the "-1" because we start counting from 0 !!
-            iBin = TMath::Min(Int_t(nBins[ivar]-1),TMath::Max(0,int (invBinWidth[ivar]*(eventData-xmin[ivar]) ) ));
-            if (eventSample[iev]->GetClass() == fSigClass) {
+            Int_t iBin = TMath::Min(maxBin,TMath::Max(0,int (invBW*(vals[iev]-vmin) ) ));
+            Double_t eventWeight = eventWeights[iev];
+            if (eventIsSig[iev]) {
                nSelS[ivar][iBin]+=eventWeight;
                nSelS_unWeighted[ivar][iBin]++;
             }
@@ -1163,13 +1251,43 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                nSelB[ivar][iBin]+=eventWeight;
                nSelB_unWeighted[ivar][iBin]++;
             }
-            if (DoRegression()) {
-               target[ivar][iBin] +=eventWeight*eventSample[iev]->GetTarget(0);
-               target2[ivar][iBin]+=eventWeight*eventSample[iev]->GetTarget(0)*eventSample[iev]->GetTarget(0);
+            if (eventTargets) {
+               target[ivar][iBin] +=eventWeight*eventTargets[iev];
+               target2[ivar][iBin]+=eventWeight*eventTargets[iev]*eventTargets[iev];
             }
          }
       }
    }
+
+   if (cacheHists) {
+      // keep the raw (non-cumulative) histograms of this node: the daughter
+      // trained second will subtract the ones of the daughter trained first
+      // from them. BuildTree drops the entry once both daughters are done.
+      NodeHists &hists = fNodeHists[node];
+      hists.fNBins.assign(nBins, nBins+cNvars);
+      hists.fXmin.assign(xmin, xmin+cNvars);
+      hists.fXmax.assign(xmax, xmax+cNvars);
+      hists.fUsed.resize(cNvars);
+      hists.fSelS.resize(cNvars);
+      hists.fSelB.resize(cNvars);
+      hists.fSelS_unWeighted.resize(cNvars);
+      hists.fSelB_unWeighted.resize(cNvars);
+      hists.fTarget.resize(cNvars);
+      hists.fTarget2.resize(cNvars);
+      for (UInt_t ivar=0; ivar<cNvars; ivar++) {
+         hists.fUsed[ivar] = useVariable[ivar];
+         if (!useVariable[ivar]) continue;
+         hists.fSelS[ivar].assign(nSelS[ivar], nSelS[ivar]+nBins[ivar]);
+         hists.fSelB[ivar].assign(nSelB[ivar], nSelB[ivar]+nBins[ivar]);
+         hists.fSelS_unWeighted[ivar].assign(nSelS_unWeighted[ivar], nSelS_unWeighted[ivar]+nBins[ivar]);
+         hists.fSelB_unWeighted[ivar].assign(nSelB_unWeighted[ivar], nSelB_unWeighted[ivar]+nBins[ivar]);
+         if (DoRegression()) {
+            hists.fTarget[ivar].assign(target[ivar], target[ivar]+nBins[ivar]);
+            hists.fTarget2[ivar].assign(target2[ivar], target2[ivar]+nBins[ivar]);
+         }
+      }
+   }
+
    // now turn the "histogram" into a cumulative distribution
    for (UInt_t ivar=0; ivar < cNvars; ivar++) {
       if (useVariable[ivar]) {
@@ -1325,7 +1443,12 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
       delete [] target[i];
       delete [] target2[i];
       delete [] cutValues[i];
+      delete [] eventData[i];
    }
+   delete [] eventData;
+   delete [] eventWeights;
+   delete [] eventIsSig;
+   delete [] eventTargets;
    delete [] nSelS;
    delete [] nSelB;
    delete [] nSelS_unWeighted;
@@ -1602,7 +1725,12 @@ Double_t TMVA::DecisionTree::TrainNodeFull( const EventConstList & eventSample,
    for( UInt_t ivar = 0; ivar < fNvars; ivar++ ) { // loop over all discriminating variables
       if(!useVariable[ivar]) continue; // only optimize with selected variables
       TMVA::BDTEventWrapper::SetVarIndex(ivar); // select the variable to sort by
+#ifdef R__USE_IMT
+      // sorted once per variable and node: use the implicit MT pool when enabled
+      ROOT::ParallelSort( bdtEventSample.begin(),bdtEventSample.end() ); // sort the event data
+#else
       std::sort( bdtEventSample.begin(),bdtEventSample.end() ); // sort the event data
+#endif
 
       Double_t bkgWeightCtr = 0.0, sigWeightCtr = 0.0;
       std::vector<TMVA::BDTEventWrapper>::iterator it = bdtEventSample.begin(), it_end = bdtEventSample.end();
@@ -143,6 +143,11 @@ the selection.
 #include "TObjString.h"
 #include "TGraph.h"
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TParallelSort.hxx"
+#endif
+
 #include <algorithm>
 #include <fstream>
 #include <math.h>
@@ -182,6 +187,7 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
+   , fUseHistSubtraction(0)   // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseYesNoLeaf(kFALSE)
    , fNodePurityLimit(0)
    , fNNodesMax(0)
@@ -236,6 +242,7 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
+   , fUseHistSubtraction(0)   // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseYesNoLeaf(kFALSE)
    , fNodePurityLimit(0)
    , fNNodesMax(0)
@@ -310,6 +317,8 @@ Bool_t TMVA::MethodBDT::HasAnalysisType( Types::EAnalysisType type, UInt_t numbe
 ///  - nCuts:           the number of steps in the optimisation of the cut for a node (if < 0, then
 ///                  step size is determined by the events)
 ///  - UseFisherCuts:   use multivariate splits using the Fisher criterion
+///  - UseHistSubtraction derive the split histograms of the second daughter node from the parent
+///                  and sibling histograms instead of refilling them from the events
 ///  - UseYesNoLeaf     decide if the classification is done simply by the node type, or the S/B
 ///                  (from the training) in the leaf node
 ///  - NodePurityLimit  the minimum purity to classify a node as a signal node (used in pruning and boosting to determine
@@ -418,6 +427,7 @@ void TMVA::MethodBDT::DeclareOptions()
    DeclareOptionRef(fUseFisherCuts=kFALSE, "UseFisherCuts", "Use multivariate splits using the Fisher criterion");
    DeclareOptionRef(fMinLinCorrForFisher=.8,"MinLinCorrForFisher", "The minimum linear correlation between two variables demanded for use in Fisher criterion in node splitting");
    DeclareOptionRef(fUseExclusiveVars=kFALSE,"UseExclusiveVars","Variables already used in fisher criterion are not anymore analysed individually for node splitting");
+   DeclareOptionRef(fUseHistSubtraction=kFALSE,"UseHistSubtraction","Derive the split histograms of the second daughter node by subtracting the sibling histograms from the parent ones instead of refilling them from the events (daughter nodes then keep the parent bin edges)");
 
 
    DeclareOptionRef(fDoPreselection=kFALSE,"DoPreselection","and and apply automatic pre-selection for 100% efficient signal (bkg) cuts prior to training");
@@ -595,6 +605,18 @@ void TMVA::MethodBDT::ProcessOptions()
       //      fBoostType   = "Bagging";
    }
 
+   if (fUseHistSubtraction) {
+      if (fNCuts < 1) {
+         Log() << kWARNING << "The option UseHistSubtraction needs the binned cut scan (nCuts>0), I will ignore it!" << Endl;
+         fUseHistSubtraction = kFALSE;
+      }
+      else if (fRandomisedTrees || fUseFisherCuts) {
+         Log() << kWARNING << "The option UseHistSubtraction cannot be used together with UseRandomisedTrees or UseFisherCuts" << Endl;
+         Log() << kWARNING << "as there the daughter nodes do not scan the same variables as the parent, I will ignore it!" << Endl;
+         fUseHistSubtraction = kFALSE;
+      }
+   }
+
    if (fUseFisherCuts) {
       Log() << kWARNING << "When using the option UseFisherCuts, the other option nCuts<0 (i.e. using" << Endl;
       Log() << " a more elaborate node splitting algorithm) is not implemented. " << Endl;
@@ -1134,6 +1156,9 @@ void TMVA::MethodBDT::Train()
 {
    TMVA::DecisionTreeNode::fgIsTraining=true;
 
+   // the forest is about to change, discard any previously compiled version
+   fCompiledForest.clear();
+
    // fill the STL Vector with the event sample
    // (needs to be done here and cannot be done in "init" as the options need to be
    // known).
@@ -1290,6 +1315,7 @@ void TMVA::MethodBDT::Train()
                fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher);
                fForest.back()->SetUseExclusiveVars(fUseExclusiveVars);
             }
+            if (fUseHistSubtraction) fForest.back()->SetUseHistSubtraction();
             // the minimum linear correlation between two variables demanded for use in fisher criterion in node splitting
 
             nNodesBeforePruning = fForest.back()->BuildTree(*fTrainSample);
@@ -1314,6 +1340,7 @@ void TMVA::MethodBDT::Train()
             fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher);
             fForest.back()->SetUseExclusiveVars(fUseExclusiveVars);
          }
+         if (fUseHistSubtraction) fForest.back()->SetUseHistSubtraction();
 
          nNodesBeforePruning = fForest.back()->BuildTree(*fTrainSample);
 
@@ -1398,6 +1425,8 @@ void TMVA::MethodBDT::Train()
    fEventSample.clear();
    fValidationSample.clear();
 
+   CompileForest();
+
    if (!fExitFromTraining) fIPyMaxIter = fIPyCurrentIter;
    ExitFromTraining();
 }
@@ -1409,6 +1438,14 @@ void TMVA::MethodBDT::Train()
 Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees)
 {
    Double_t sum=0;
+   if (!fCompiledForest.empty() && fCompiledForest.size() == fForest.size()) {
+      std::vector<Float_t> x(GetNvar());
+      for (UInt_t ivar=0; ivar<GetNvar(); ivar++) x[ivar] = e->GetValue(ivar);
+      for (UInt_t itree=0; itree<nTrees; itree++) {
+         sum += EvaluateCompiledTree(fCompiledForest[itree].data(), x.data());
+      }
+      return 2.0/(1.0+exp(-2.0*sum))-1; //MVA output between -1 and 1
+   }
    for (UInt_t itree=0; itree<nTrees; itree++) {
       //loop over all trees in forest
       sum += fForest[itree]->CheckEvent(e,kFALSE);
@@ -1417,6 +1454,136 @@ Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees)
    return 2.0/(1.0+exp(-2.0*sum))-1; //MVA output between -1 and 1
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Flatten the forest into contiguous per-tree node arrays for fast
+/// inference. Each intermediate node keeps the cut variable, the threshold
+/// and the index of its two children, which are stored adjacently; cuts that
+/// select the low side (CutType false) are normalised by swapping the
+/// children, so walking a tree is one compare-and-index per level. Leaf
+/// nodes carry the value DecisionTree::CheckEvent would return for the
+/// current settings. Trees with Fisher-criterium cuts cannot be represented
+/// this way; in that case the compiled forest is discarded and evaluation
+/// keeps chasing the DecisionTreeNode pointers.
+
+void TMVA::MethodBDT::CompileForest()
+{
+   fCompiledForest.clear();
+   fCompiledForest.reserve(fForest.size());
+
+   const Bool_t useYesNoLeaf = (fBoostType != "Grad") && fUseYesNoLeaf;
+
+   for (UInt_t itree=0; itree<fForest.size(); itree++) {
+      DecisionTree *dt = fForest[itree];
+      if (!dt || !dt->GetRoot()) {
+         fCompiledForest.clear();
+         return;
+      }
+      fCompiledForest.push_back(std::vector<CompiledNode>());
+      std::vector<CompiledNode> &nodes = fCompiledForest.back();
+      nodes.resize(1);
+
+      std::vector< std::pair<const DecisionTreeNode*, Int_t> > todo;
+      todo.push_back(std::make_pair((const DecisionTreeNode*)dt->GetRoot(), 0));
+      while (!todo.empty()) {
+         const DecisionTreeNode *src = todo.back().first;
+         Int_t slot = todo.back().second;
+         todo.pop_back();
+         if (!src) {
+            fCompiledForest.clear();
+            return;
+         }
+         if (src->GetNodeType() != 0) { // leaf
+            nodes[slot].fSelector  = -1;
+            nodes[slot].fChildBase = 0;
+            if (dt->DoRegression())  nodes[slot].fCutValue = src->GetResponse();
+            else if (useYesNoLeaf)   nodes[slot].fCutValue = src->GetNodeType();
+            else                     nodes[slot].fCutValue = src->GetPurity();
+         } else {
+            if (src->GetNFisherCoeff() != 0) { // cannot flatten Fisher cuts
+               fCompiledForest.clear();
+               return;
+            }
+            Int_t base = (Int_t)nodes.size();
+            nodes.resize(base + 2);
+            nodes[slot].fSelector  = src->GetSelector();
+            nodes[slot].fCutValue  = src->GetCutValue();
+            nodes[slot].fChildBase = base;
+            const DecisionTreeNode *below = src->GetCutType() ? src->GetLeft()  : src->GetRight();
+            const DecisionTreeNode *above = src->GetCutType() ? src->GetRight() : src->GetLeft();
+            todo.push_back(std::make_pair(below, base));
+            todo.push_back(std::make_pair(above, base + 1));
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Walk one flattened tree for the input variable values x and return the
+/// leaf value; the conditional child index compiles to branch-free code.
+
+Double_t TMVA::MethodBDT::EvaluateCompiledTree( const CompiledNode* nodes, const Float_t* x ) const
+{
+   const CompiledNode *current = nodes;
+   while (current->fSelector >= 0) {
+      current = nodes + current->fChildBase + (x[current->fSelector] >= current->fCutValue ? 1 : 0);
+   }
+   return current->fCutValue;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the boosted classifier on a batch of events. With a compiled
+/// forest the loop runs tree-outer/event-inner, so every flattened node
+/// array streams through the cache once for the whole batch instead of once
+/// per event. Falls back to the per-event interface when the forest has not
+/// been compiled or for regression and multiclass.
+
+std::vector<Double_t> TMVA::MethodBDT::GetMvaValues( const std::vector<const TMVA::Event*>& events )
+{
+   if (fCompiledForest.empty() || fCompiledForest.size() != fForest.size() ||
+       DoRegression() || DataInfo().GetNClasses() > 2) {
+      return MethodBase::GetMvaValues(events);
+   }
+
+   const UInt_t nEvents = events.size();
+   const UInt_t nVars   = GetNvar();
+   const Bool_t grad    = (fBoostType == "Grad");
+
+   std::vector<Double_t> values(nEvents, 0);
+   std::vector<Float_t>  x(nEvents * nVars);
+   std::vector<char>     done(nEvents, 0); // events already decided by the preselection cuts
+
+   for (UInt_t iev=0; iev<nEvents; iev++) {
+      const Event* ev = GetTransformationHandler().Transform(events[iev]);
+      if (fDoPreselection) {
+         Double_t val = ApplyPreselectionCuts(ev);
+         if (TMath::Abs(val) > 0.05) {
+            values[iev] = val;
+            done[iev] = 1;
+            continue;
+         }
+      }
+      for (UInt_t ivar=0; ivar<nVars; ivar++) x[iev*nVars + ivar] = ev->GetValue(ivar);
+   }
+
+   Double_t norm = 0;
+   for (UInt_t itree=0; itree<fForest.size(); itree++) {
+      const CompiledNode *nodes = fCompiledForest[itree].data();
+      const Double_t weight = grad ? 1.0 : fBoostWeights[itree];
+      for (UInt_t iev=0; iev<nEvents; iev++) {
+         if (done[iev]) continue;
+         values[iev] += weight * EvaluateCompiledTree(nodes, &x[iev*nVars]);
+      }
+      norm += weight;
+   }
+
+   for (UInt_t iev=0; iev<nEvents; iev++) {
+      if (done[iev]) continue;
+      if (grad) values[iev] = 2.0/(1.0+exp(-2.0*values[iev]))-1;
+      else      values[iev] = ( norm > std::numeric_limits<double>::epsilon() ) ? values[iev]/norm : 0;
+   }
+   return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate residual for all events.
 
@@ -2280,6 +2447,8 @@ void TMVA::MethodBDT::ReadWeightsFromXML(void* parent) {
       fBoostWeights.push_back(boostWeight);
       ch = gTools().GetNextChild(ch);
    }
+
+   CompileForest();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2316,6 +2485,8 @@ void  TMVA::MethodBDT::ReadWeightsFromStream( std::istream& istr )
       fForest.back()->Read(istr, GetTrainingTMVAVersionCode());
       fBoostWeights.push_back(boostWeight);
    }
+
+   CompileForest();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2360,6 +2531,15 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
 
    Double_t myMVA = 0;
    Double_t norm  = 0;
+   if (!fCompiledForest.empty() && fCompiledForest.size() == fForest.size()) {
+      std::vector<Float_t> x(GetNvar());
+      for (UInt_t ivar=0; ivar<GetNvar(); ivar++) x[ivar] = ev->GetValue(ivar);
+      for (UInt_t itree=0; itree<nTrees; itree++) {
+         myMVA += fBoostWeights[itree] * EvaluateCompiledTree(fCompiledForest[itree].data(), x.data());
+         norm  += fBoostWeights[itree];
+      }
+      return ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA /= norm : 0 ;
+   }
    for (UInt_t itree=0; itree<nTrees; itree++) {
       //
       myMVA += fBoostWeights[itree] * fForest[itree]->CheckEvent(ev,fUseYesNoLeaf);
@@ -2889,7 +3069,11 @@ void TMVA::MethodBDT::DeterminePreselectionCuts(const std::vector<const TMVA::Ev
 
    for( UInt_t ivar = 0; ivar < GetNvar(); ivar++ ) { // loop over all discriminating variables
       TMVA::BDTEventWrapper::SetVarIndex(ivar); // select the variable to sort by
+#ifdef R__USE_IMT
+      ROOT::ParallelSort( bdtEventSample.begin(),bdtEventSample.end() ); // sort the event data
+#else
       std::sort( bdtEventSample.begin(),bdtEventSample.end() ); // sort the event data
+#endif
 
       Double_t bkgWeightCtr = 0.0, sigWeightCtr = 0.0;
       std::vector<TMVA::BDTEventWrapper>::iterator it = bdtEventSample.begin(), it_end = bdtEventSample.end();
@@ -839,6 +839,21 @@ Double_t TMVA::MethodBase::GetMvaValue( const Event* const ev, Double_t* err, Do
    return val;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// evaluates the classifier response for a batch of events; the default
+/// implementation simply loops over the single-event interface, methods with
+/// a batched backend (e.g. the DNN method on GPU) override it to evaluate
+/// many events per launch
+
+std::vector<Double_t> TMVA::MethodBase::GetMvaValues( const std::vector<const TMVA::Event*>& events )
+{
+   std::vector<Double_t> values(events.size());
+   for (UInt_t ievt=0; ievt<events.size(); ievt++) {
+      values[ievt] = GetMvaValue( events[ievt] );
+   }
+   return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// uses a pre-set cut on the MVA output (SetSignalReferenceCut and SetSignalReferenceCutOrientation)
 /// for a quick determination if an event would be selected as signal or background
@@ -786,16 +786,19 @@ void TMVA::MethodDNN::TrainGpu()
       using DataLoader_t = TDataLoader<TMVAInput_t, TCuda<>>;
 
       size_t nThreads = 1;
+      // Two buffer pairs let the loader assemble the next batch while the
+      // current one is being processed on the device.
+      size_t nStreams = 2;
       DataLoader_t trainingData(GetEventCollection(Types::kTraining),
                                 nTrainingSamples,
                                 net.GetBatchSize(),
                                 net.GetInputWidth(),
-                                net.GetOutputWidth(), nThreads);
+                                net.GetOutputWidth(), nStreams);
       DataLoader_t testData(GetEventCollection(Types::kTesting),
                             nTestSamples,
                             testNet.GetBatchSize(),
                             net.GetInputWidth(),
-                            net.GetOutputWidth(), nThreads);
+                            net.GetOutputWidth(), nStreams);
       DNN::TGradientDescent<TCuda<>> minimizer(settings.learningRate,
                                              settings.convergenceSteps,
                                              settings.testInterval);
@@ -956,16 +959,19 @@ void TMVA::MethodDNN::TrainCpu()
       using DataLoader_t = TDataLoader<TMVAInput_t, TCpu<>>;
 
       size_t nThreads = 1;
+      // Two buffer pairs let the loader assemble the next batch while the
+      // current one is being processed.
+      size_t nStreams = 2;
       DataLoader_t trainingData(GetEventCollection(Types::kTraining),
                                 nTrainingSamples,
                                 net.GetBatchSize(),
                                 net.GetInputWidth(),
-                                net.GetOutputWidth(), nThreads);
+                                net.GetOutputWidth(), nStreams);
       DataLoader_t testData(GetEventCollection(Types::kTesting),
                             nTestSamples,
                             testNet.GetBatchSize(),
                             net.GetInputWidth(),
-                            net.GetOutputWidth(), nThreads);
+                            net.GetOutputWidth(), nStreams);
       DNN::TGradientDescent<TCpu<>> minimizer(settings.learningRate,
                                                settings.convergenceSteps,
                                                settings.testInterval);
@@ -1108,6 +1114,126 @@ Double_t TMVA::MethodDNN::GetMvaValue( Double_t* /*errLower*/, Double_t* /*errUp
    return YHat(0,0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the network on a batch of events with one forward pass per chunk
+/// instead of one per event. The chunk is propagated through the backend
+/// selected by the Architecture option: with Architecture=GPU the input rows
+/// are packed into a pinned host buffer and copied to the device
+/// asynchronously, so the transfer of one chunk overlaps the kernels of the
+/// previous one; with Architecture=CPU the chunk is evaluated by the
+/// multi-core backend. The reference backend serves as fallback. The returned
+/// values are identical to per-event GetMvaValue() calls.
+
+std::vector<Double_t> TMVA::MethodDNN::GetMvaValues( const std::vector<const Event*>& events )
+{
+   std::vector<Double_t> values(events.size());
+   if (events.empty()) {
+      return values;
+   }
+
+   size_t nVariables = events[0]->GetNVariables();
+
+#ifdef DNNCUDA // Included only if DNNCUDA flag is set.
+   if (fArchitectureString == "GPU") {
+      using AFloat = typename TCuda<>::Scalar_t;
+
+      size_t batchSize = std::min(events.size(), (size_t) 4096);
+      TNet<TCuda<>> net(batchSize, fNet);
+
+      // Two pinned staging buffers: while chunk n is propagated on the
+      // device, chunk n+1 is packed on the host and its copy runs on the
+      // other buffer's stream. The incomplete last chunk is padded with the
+      // last event; the padded outputs are discarded below.
+      TCudaHostBuffer<AFloat>   hostX[2]   = {TCudaHostBuffer<AFloat>(batchSize * nVariables),
+                                             TCudaHostBuffer<AFloat>(batchSize * nVariables)};
+      TCudaDeviceBuffer<AFloat> deviceX[2] = {TCudaDeviceBuffer<AFloat>(batchSize * nVariables),
+                                             TCudaDeviceBuffer<AFloat>(batchSize * nVariables)};
+
+      size_t nBatches = (events.size() + batchSize - 1) / batchSize;
+
+      auto stage = [&](size_t batch) {
+         TCudaHostBuffer<AFloat> &host = hostX[batch % 2];
+         size_t first = batch * batchSize;
+         for (size_t i = 0; i < batchSize; i++) {
+            size_t ievt = std::min(first + i, events.size() - 1);
+            const Event *ev = GetTransformationHandler().Transform(events[ievt]);
+            const std::vector<Float_t>& inputValues = ev->GetValues();
+            for (size_t j = 0; j < nVariables; j++) {
+               // column major, matching the TCudaMatrix layout
+               host[j * batchSize + i] = static_cast<AFloat>(inputValues[j]);
+            }
+         }
+         deviceX[batch % 2].CopyFrom(host);
+      };
+
+      stage(0);
+      for (size_t batch = 0; batch < nBatches; batch++) {
+         if (batch + 1 < nBatches) {
+            stage(batch + 1);
+         }
+         typename TCuda<>::Matrix_t X(deviceX[batch % 2], batchSize, nVariables);
+         typename TCuda<>::Matrix_t YHat(batchSize, 1);
+         net.Prediction(YHat, X, fOutputFunction);
+         // The conversion copies the result back synchronously.
+         TMatrixT<Double_t> Y = (TMatrixT<Double_t>) YHat;
+         size_t first = batch * batchSize;
+         for (size_t i = 0; i < batchSize && first + i < events.size(); i++) {
+            values[first + i] = Y(i, 0);
+         }
+      }
+      return values;
+   }
+#endif // DNNCUDA
+
+#ifdef DNNCPU // Included only if DNNCPU flag is set.
+   if (fArchitectureString == "CPU") {
+      using AFloat = typename TCpu<>::Scalar_t;
+
+      size_t batchSize = std::min(events.size(), (size_t) 1024);
+      TNet<TCpu<>> net(batchSize, fNet);
+      typename TCpu<>::Matrix_t X(batchSize, nVariables);
+      typename TCpu<>::Matrix_t YHat(batchSize, 1);
+
+      for (size_t first = 0; first < events.size(); first += batchSize) {
+         for (size_t i = 0; i < batchSize; i++) {
+            size_t ievt = std::min(first + i, events.size() - 1);
+            const Event *ev = GetTransformationHandler().Transform(events[ievt]);
+            const std::vector<Float_t>& inputValues = ev->GetValues();
+            for (size_t j = 0; j < nVariables; j++) {
+               X(i, j) = static_cast<AFloat>(inputValues[j]);
+            }
+         }
+         net.Prediction(YHat, X, fOutputFunction);
+         for (size_t i = 0; i < batchSize && first + i < events.size(); i++) {
+            values[first + i] = YHat(i, 0);
+         }
+      }
+      return values;
+   }
+#endif // DNNCPU
+
+   size_t batchSize = std::min(events.size(), (size_t) 1024);
+   auto net = fNet.CreateClone(batchSize);
+   Matrix_t X(batchSize, nVariables);
+   Matrix_t YHat(batchSize, 1);
+
+   for (size_t first = 0; first < events.size(); first += batchSize) {
+      for (size_t i = 0; i < batchSize; i++) {
+         size_t ievt = std::min(first + i, events.size() - 1);
+         const Event *ev = GetTransformationHandler().Transform(events[ievt]);
+         const std::vector<Float_t>& inputValues = ev->GetValues();
+         for (size_t j = 0; j < nVariables; j++) {
+            X(i, j) = inputValues[j];
+         }
+      }
+      net.Prediction(YHat, X, fOutputFunction);
+      for (size_t i = 0; i < batchSize && first + i < events.size(); i++) {
+         values[first + i] = YHat(i, 0);
+      }
+   }
+   return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 const std::vector<Float_t> & TMVA::MethodDNN::GetRegressionValues()
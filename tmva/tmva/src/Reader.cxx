@@ -525,6 +525,39 @@ Double_t TMVA::Reader::EvaluateMVA( const std::vector<Double_t>& inputVec, const
    return EvaluateMVA( fTmpEvalVec, methodTag, aux );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate a batch of events for a given method. Each inner vector holds the
+/// input variables of one event in the order they were booked. Methods with a
+/// batched backend (e.g. the DNN method on GPU) evaluate many events per
+/// device launch; all other methods fall back to a loop over the
+/// single-event interface.
+
+std::vector<Double_t> TMVA::Reader::EvaluateMVA( const std::vector<std::vector<Float_t> >& inputBatch, const TString& methodTag )
+{
+   std::vector<Double_t> values(inputBatch.size(), -999);
+
+   IMethod* imeth = FindMVA( methodTag );
+   MethodBase* meth = dynamic_cast<TMVA::MethodBase*>(imeth);
+   if(meth==0) return values;
+
+   std::vector<const Event*> tmpEvents;
+   tmpEvents.reserve(inputBatch.size());
+   for (UInt_t ievt=0; ievt<inputBatch.size(); ievt++){
+      for (UInt_t i=0; i<inputBatch[ievt].size(); i++){
+         if (TMath::IsNaN(inputBatch[ievt][i])) {
+            Log() << kERROR << i << "-th variable of the " << ievt << "-th event is NaN --> return MVA values -999, \n that's all I can do, please fix or remove this event." << Endl;
+            for (UInt_t j=0; j<tmpEvents.size(); j++) delete tmpEvents[j];
+            return values;
+         }
+      }
+      tmpEvents.push_back(new Event(inputBatch[ievt], DataInfo().GetNVariables()));
+   }
+
+   values = meth->GetMvaValues( tmpEvents );
+   for (UInt_t ievt=0; ievt<tmpEvents.size(); ievt++) delete tmpEvents[ievt];
+   return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// evaluates MVA for given set of input variables
 
@@ -15,6 +15,7 @@
 #pragma link off all functions;
 
 #pragma link C++ class TBasket-;
+#pragma link C++ class TColumnPage+;
 #pragma link C++ class TBranch-;
 #pragma link C++ class TBranchClones-;
 #pragma link C++ class TBranchElement-;
@@ -53,6 +54,9 @@
 #pragma link C++ class TTreeCloner+;
 #pragma link C++ class TTreeCache+;
 #pragma link C++ class TTreeCacheUnzip+;
+#pragma link C++ class TTreeColumnStore+;
+#pragma link C++ class TTreeRangeSummary+;
+#pragma link C++ class TTreeRangeSummary::TBranchRange+;
 #pragma link C++ class TVirtualTreePlayer;
 #pragma link C++ class TVirtualIndex+;
 #pragma link C++ class TTreeResult+;
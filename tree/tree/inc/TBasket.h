@@ -46,6 +46,9 @@ private:
    // Helper for managing the compressed buffer.
    void InitializeCompressedBuffer(Int_t len, TFile* file);
 
+   // Helper trying the lightweight integer encodings at write time.
+   Int_t TryIntegerEncoding(char *objbuf, Int_t objlen, char *bufcur);
+
 protected:
    Int_t       fBufferSize;      ///< fBuffer length in bytes
    Int_t       fNevBufSize;      ///< Length in Int_t of fEntryOffset OR fixed length of each entry if fEntryOffset is null!
@@ -58,6 +61,7 @@ protected:
    TBuffer    *fCompressedBufferRef; ///<! Compressed buffer.
    Bool_t      fOwnsCompressedBuffer; ///<! Whether or not we own the compressed buffer.
    Int_t       fLastWriteBufferSize; ///<! Size of the buffer last time we wrote it to disk
+   Int_t       fPreparedSize;    ///<! Compressed payload size set by PrepareWriteBuffer(); -1 when the basket is not prepared
 
 public:
 
@@ -79,6 +83,7 @@ public:
            Int_t   GetLast() const {return fLast;}
    virtual void    MoveEntries(Int_t dentries);
    virtual void    PrepareBasket(Long64_t /* entry */) {};
+           Int_t   PrepareWriteBuffer();
            Int_t   ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file);
            Int_t   ReadBasketBytes(Long64_t pos, TFile *file);
    virtual void    Reset();
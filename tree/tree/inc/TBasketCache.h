@@ -0,0 +1,82 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketCache
+#define ROOT_TBasketCache
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TBasketCache                                                         //
+//                                                                      //
+// Process-wide LRU cache of compressed basket buffers. It acts as a    //
+// second cache tier behind TTreeCache: baskets evicted from the        //
+// uncompressed cache window can still be served from memory instead    //
+// of being read from storage again, so iterating a tree several times  //
+// pays decompression but not I/O on passes 2..N.                       //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TFile;
+
+class TBasketCache {
+
+protected:
+   struct Entry_t {
+      UInt_t            fFileId;  ///< Id of the owning file
+      Long64_t          fPos;     ///< Offset of the basket on file
+      std::vector<char> fData;    ///< Compressed basket bytes
+   };
+   typedef std::list<Entry_t>::iterator            EntryIter_t;
+   typedef std::pair<UInt_t, Long64_t>             Key_t;
+   typedef std::map<Key_t, EntryIter_t>            EntryMap_t;
+
+   std::list<Entry_t>           fLru;       ///< Entries, most recently used first
+   EntryMap_t                   fMap;       ///< (file id, offset) -> entry
+   std::map<std::string, UInt_t> fFileIds; ///< File UUID -> file id
+   Long64_t                     fMaxSize;   ///< Byte budget, 0 disables the cache
+   Long64_t                     fSize;      ///< Bytes currently cached
+   Long64_t                     fNHits;     ///< Number of requests served from the cache
+   Long64_t                     fNMisses;   ///< Number of requests not in the cache
+   Long64_t                     fNEvicted;  ///< Number of entries evicted to respect the budget
+   mutable std::mutex           fMutex;     ///< Protects all of the above
+
+   TBasketCache();
+   TBasketCache(const TBasketCache&);            // not implemented
+   TBasketCache& operator=(const TBasketCache&); // not implemented
+
+public:
+   static TBasketCache &Instance();
+
+   UInt_t   GetFileId(TFile *file);
+   Bool_t   ReadBuffer(UInt_t fileid, Long64_t pos, Int_t len, char *buf);
+   void     Insert(UInt_t fileid, Long64_t pos, Int_t len, const char *buf);
+
+   Bool_t   IsEnabled() const { return fMaxSize > 0; }
+   Long64_t GetMaxSize() const { return fMaxSize; }
+   void     SetMaxSize(Long64_t maxbytes);
+
+   Long64_t GetSize() const;
+   Long64_t GetNHits() const;
+   Long64_t GetNMisses() const;
+   Long64_t GetNEvicted() const;
+
+   void     Print(Option_t *option = "") const;
+};
+
+#endif
@@ -23,6 +23,7 @@
 //     the list of TLeaves (branch description)                         //
 //////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <memory>
 
 #include "TNamed.h"
@@ -63,7 +64,8 @@ protected:
    // TBranch status bits
    enum EStatusBits {
       kAutoDelete = BIT(15),
-      kDoNotUseBufferMap = BIT(22) // If set, at least one of the entry in the branch will use the buffer's map of classname and objects.
+      kDoNotUseBufferMap = BIT(22), // If set, at least one of the entry in the branch will use the buffer's map of classname and objects.
+      kUseIntegerEncoding = BIT(23) // If set, baskets first try the lightweight per-basket integer encodings (see SetIntegerEncoding)
    };
 
    static Int_t fgCount;          ///<! branch counter
@@ -82,6 +84,8 @@ protected:
    Long64_t    fFirstBasketEntry; ///<! First entry in the current basket.
    Long64_t    fNextBasketEntry;  ///<! Next entry that will requires us to go to the next basket
    TBasket    *fCurrentBasket;    ///<! Pointer to the current basket.
+   TBasket    *fStandbyBasket;    ///<! Basket kept ready to swap in when the active one is written asynchronously
+   std::atomic<Bool_t> fAsyncWriteInFlight; ///<! True while an asynchronous write of this branch's basket is running
    Long64_t    fEntries;          ///<  Number of entries
    Long64_t    fFirstEntry;       ///<  Number of the first entry in this branch
    Long64_t    fTotBytes;         ///<  Total number of bytes in all leaves before compression
@@ -101,6 +105,7 @@ protected:
    TBuffer    *fEntryBuffer;      ///<! Buffer used to directly pass the content without streaming
    TBuffer    *fTransientBuffer;  ///<! Pointer to the current transient buffer.
    TList      *fBrowsables;       ///<! List of TVirtualBranchBrowsables used for Browse()
+   mutable const char *fInternedName; ///<! Canonical interned copy of the branch name (see TStringInterner)
 
    Bool_t      fSkipZip;          ///<! After being read, the buffer will not be unzipped.
 
@@ -125,6 +130,7 @@ protected:
 private:
    Int_t FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
+   Int_t    WriteBasketAsync(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
    TBranch(const TBranch&) = delete;             // not implemented
    TBranch& operator=(const TBranch&) = delete;  // not implemented
 
@@ -146,6 +152,7 @@ public:
    virtual TLeaf    *FindLeaf(const char *name);
            Int_t     FlushBaskets();
            Int_t     FlushOneBasket(UInt_t which);
+           void      PrepareBasketsToFlush();
 
    virtual char     *GetAddress() const {return fAddress;}
            TBasket  *GetBasket(Int_t basket);
@@ -159,11 +166,15 @@ public:
            Int_t     GetCompressionLevel() const;
            Int_t     GetCompressionSettings() const;
    TDirectory       *GetDirectory() const {return fDirectory;}
+   virtual Int_t     GetBulkEntries(Long64_t entry, TBuffer &user_buf);
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall = 0);
+   virtual Int_t     GetEntryImpl(Long64_t entry, Int_t getall, ROOT::Internal::TBranchIMTHelper *) { return GetEntry(entry, getall); }
    virtual Int_t     GetEntryExport(Long64_t entry, Int_t getall, TClonesArray *list, Int_t n);
            Int_t     GetEntryOffsetLen() const { return fEntryOffsetLen; }
            Int_t     GetEvent(Long64_t entry=0) {return GetEntry(entry);}
    const char       *GetIconName() const;
+   const char       *GetInternedName() const;
+           Bool_t    GetIntegerEncoding() const { return TestBit(kUseIntegerEncoding); }
    virtual Int_t     GetExpectedType(TClass *&clptr,EDataType &type);
    virtual TLeaf    *GetLeaf(const char *name) const;
    virtual TFile    *GetFile(Int_t mode=0);
@@ -212,10 +223,13 @@ public:
    virtual void      SetEntries(Long64_t entries);
    virtual void      SetEntryOffsetLen(Int_t len, Bool_t updateSubBranches = kFALSE);
    virtual void      SetFirstEntry( Long64_t entry );
+   virtual void      SetIntegerEncoding(Bool_t use = kTRUE);
    virtual void      SetFile(TFile *file=0);
    virtual void      SetFile(const char *filename);
    virtual Bool_t    SetMakeClass(Bool_t decomposeObj = kTRUE);
+   virtual void      SetName(const char *name);
    virtual void      SetOffset(Int_t offset=0) {fOffset=offset;}
+   virtual void      SetPrecision(Double_t relTol, Double_t absTol = 0);
    virtual void      SetStatus(Bool_t status=1);
    virtual void      SetTree(TTree *tree) { fTree = tree;}
    virtual void      SetupAddresses();
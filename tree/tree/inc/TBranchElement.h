@@ -187,6 +187,7 @@ public:
    TVirtualCollectionProxy *GetCollectionProxy();
    TClass                  *GetCurrentClass(); // Class referenced by transient description
    virtual Int_t            GetEntry(Long64_t entry = 0, Int_t getall = 0);
+   virtual Int_t            GetEntryImpl(Long64_t entry, Int_t getall, ROOT::Internal::TBranchIMTHelper *);
    virtual Int_t            GetExpectedType(TClass *&clptr,EDataType &type);
            const char      *GetIconName() const;
            Int_t            GetID() const { return fID; }
@@ -24,6 +24,7 @@
 #include "TTree.h"
 
 class TFile;
+class TFileOpenHandle;
 class TBrowser;
 class TCut;
 class TEntryList;
@@ -43,6 +44,9 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   Bool_t       fPreOpenNextFile;  ///<! True: open the next file of the chain in the background
+   TFileOpenHandle *fPreOpenHandle;///<! Pending background open of the next file (see TFile::AsyncOpen())
+   Int_t        fPreOpenTree;      ///<! Tree number the pending background open is for
 
 private:
    TChain(const TChain&);            // not implemented
@@ -159,6 +163,8 @@ public:
    virtual void      SetEventList(TEventList *evlist);
    virtual void      SetMakeClass(Int_t make) { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    virtual void      SetPacketSize(Int_t size = 100);
+   virtual void      SetPreOpenNextFile(Bool_t on = kTRUE);
+           Bool_t    GetPreOpenNextFile() const { return fPreOpenNextFile; }
    virtual void      SetProof(Bool_t on = kTRUE, Bool_t refresh = kFALSE, Bool_t gettreeheader = kFALSE);
    virtual void      SetWeight(Double_t w=1, Option_t *option="");
    virtual void      UseCache(Int_t maxCacheSize = 10, Int_t pageSize = 0);
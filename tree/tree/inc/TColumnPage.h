@@ -0,0 +1,73 @@
+// @(#)root/tree:$Id$
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TColumnPage
+#define ROOT_TColumnPage
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TColumnPage                                                          //
+//                                                                      //
+// One cluster worth of values of a single leaf, stored column-major    //
+// as fixed-stride raw values without per-entry framing, plus an        //
+// optional offsets table for variable-length arrays. The columnar      //
+// counterpart of the baskets of a cluster.                             //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TNamed.h"
+
+class TColumnPage : public TNamed {
+
+protected:
+   Long64_t  fFirstEntry;     ///< First tree entry stored in this page
+   Int_t     fNEntries;       ///< Number of entries stored in this page
+   Int_t     fStride;         ///< Size in bytes of one value
+   Int_t     fValuesPerEntry; ///< Fixed number of values per entry; 0 for variable-length arrays
+   Int_t     fNValues;        ///< Total number of values stored
+   Int_t     fNBytes;         ///< fNValues*fStride
+   Char_t   *fData;           ///<[fNBytes] Raw values in on-disk (big-endian) byte order
+   Int_t     fNOffsets;       ///< fNEntries+1 for variable-length arrays, else 0
+   Long64_t *fOffsets;        ///<[fNOffsets] Cumulative value count at the start of each entry
+   Int_t     fCapacity;       ///<! Allocated size of fData in bytes
+
+   void      Reserve(Int_t nbytes);
+
+   TColumnPage(const TColumnPage&);            // not implemented
+   TColumnPage& operator=(const TColumnPage&); // not implemented
+
+public:
+   TColumnPage();
+   TColumnPage(const char *branchname, Long64_t firstEntry, Int_t stride,
+               Int_t valuesPerEntry, Int_t estEntries = 0);
+   virtual ~TColumnPage();
+
+   void            AppendEntry(const void *values, Int_t nvalues);
+   Int_t           CopyEntries(Long64_t firstEntry, Int_t n, void *dest) const;
+
+   Bool_t          Contains(Long64_t entry) const
+                      { return entry >= fFirstEntry && entry < fFirstEntry + fNEntries; }
+   Long64_t        GetFirstEntry() const { return fFirstEntry; }
+   Int_t           GetNEntries() const { return fNEntries; }
+   Int_t           GetStride() const { return fStride; }
+   Int_t           GetValuesPerEntry() const { return fValuesPerEntry; }
+   Int_t           GetNValues() const { return fNValues; }
+   Long64_t        GetEntryOffset(Int_t i) const;
+   Int_t           GetEntryLength(Int_t i) const;
+   const Char_t   *GetData() const { return fData; }
+   const Long64_t *GetOffsets() const { return fOffsets; }
+
+   virtual void    Print(Option_t *option="") const;
+
+   ClassDef(TColumnPage,1);  // Column-major page of leaf values for one cluster
+};
+
+#endif
@@ -77,6 +77,7 @@ class TEntryList: public TNamed
    virtual const char *GetFileName() const { return fFileName.Data(); }
    virtual Int_t       GetTreeNumber() const { return fTreeNumber; }
    virtual Bool_t      GetReapplyCut() const { return fReapply; };
+   virtual void        Intersect(const TEntryList *elist);
    virtual Int_t       Merge(TCollection *list);
 
    virtual Long64_t    Next();
@@ -41,10 +41,19 @@ protected:
    Bool_t      fIsUnsigned;      ///<  (=kTRUE if unsigned, kFALSE otherwise)
    TLeaf      *fLeafCount;       ///<  Pointer to Leaf count if variable length (we do not own the counter)
    TBranch    *fBranch;          ///<! Pointer to supporting branch (we do not own the branch)
+   Double_t    fQuantizeRel;     ///<! Relative error tolerance of on-write quantization, 0 when off
+   Double_t    fQuantizeAbs;     ///<! Absolute error tolerance of on-write quantization, 0 when off
+   char       *fQuantizeBuffer;  ///<! Scratch holding the quantized copy of one entry
+   Int_t       fQuantizeBufferSize; ///<! Allocated size of fQuantizeBuffer in bytes
 
    TLeaf(const TLeaf&);
    TLeaf& operator=(const TLeaf&);
 
+   Bool_t IsQuantized() const { return fQuantizeRel > 0 || fQuantizeAbs > 0; }
+   void  *GetQuantizeScratch(Int_t nbytes);
+   static void QuantizeFloats(Float_t *values, Int_t n, Double_t relTol, Double_t absTol);
+   static void QuantizeDoubles(Double_t *values, Int_t n, Double_t relTol, Double_t absTol);
+
   template <typename T> struct GetValueHelper {
     static T Exec(const TLeaf *leaf, Int_t i = 0) { return leaf->GetValue(i); }
   };
@@ -87,11 +96,13 @@ public:
    virtual void     PrintValue(Int_t i = 0) const;
    virtual void     ReadBasket(TBuffer&) {}
    virtual void     ReadBasketExport(TBuffer&, TClonesArray*, Int_t) {}
+   virtual Bool_t   ReadBasketFast(TBuffer&, Long64_t) { return kFALSE; }
    virtual void     ReadValue(std::istream& /*s*/, Char_t /*delim*/ = ' ') {
       Error("ReadValue", "Not implemented!");
    }
            Int_t    ResetAddress(void* add, Bool_t destructor = kFALSE);
    virtual void     SetAddress(void* add = 0);
+   virtual void     SetPrecision(Double_t relTol, Double_t absTol = 0);
    virtual void     SetBranch(TBranch* branch) { fBranch = branch; }
    virtual void     SetLeafCount(TLeaf* leaf);
    virtual void     SetLen(Int_t len = 1) { fLen = len; }
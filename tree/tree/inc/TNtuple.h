@@ -23,6 +23,9 @@
 
 #include "TTree.h"
 
+#include <atomic>
+#include <thread>
+
 class TBrowser;
 
 class TNtuple : public TTree {
@@ -30,8 +33,16 @@ class TNtuple : public TTree {
 protected:
    Int_t       fNvar;            ///<  Number of columns
    Float_t    *fArgs;            ///<! [fNvar] Array of variables
+   Float_t    *fRowRing;         ///<! Ring of pending rows (row-log mode), fRingRows*fNvar floats
+   Float_t    *fRowScratch;      ///<! Producer-side staging row while the logger owns fArgs
+   Int_t       fRingRows;        ///<! Capacity of the row ring, 0 when row-log mode is off
+   std::atomic<Long64_t> fRingHead;  ///<! Rows appended by the producer
+   std::atomic<Long64_t> fRingTail;  ///<! Rows columnarized by the logger thread
+   std::atomic<bool>     fRingStop;  ///<! Asks the logger thread to drain and exit
+   std::thread *fRingThread;     ///<! Background columnarization thread
 
    virtual Int_t  Fill();
+           void   RowLogLoop();
 
 private:
    TNtuple(const TNtuple&);             // not implemented
@@ -57,6 +68,10 @@ public:
    virtual Long64_t  ReadStream(std::istream& inputStream, const char *branchDescriptor="", char delimiter = ' ');
    virtual void      ResetBranchAddress(TBranch *);
            void      ResetBranchAddresses();
+   virtual void      SetRowLogMode(Int_t nrows = 65536);
+   virtual void      DrainRowLog();
+   virtual Int_t     Write(const char *name=0, Int_t option=0, Int_t bufsize=0);
+   virtual Int_t     Write(const char *name=0, Int_t option=0, Int_t bufsize=0) const;
 
    ClassDef(TNtuple,2);  //A simple tree with branches of floats.
 };
@@ -74,6 +74,7 @@ class TTreeCache;
 class TTreeCloner;
 class TFileMergeInfo;
 class TVirtualPerfStats;
+class TTreeRangeSummary;
 
 class TTree : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
@@ -131,8 +132,13 @@ protected:
    Bool_t         fCacheDoAutoInit;       ///<! true if cache auto creation or resize check is needed
    Bool_t         fCacheUserSet;          ///<! true if the cache setting was explicitly given by user
    Bool_t         fIMTEnabled;            ///<! true if implicit multi-threading is enabled for this tree
+   Bool_t         fAsyncWrite;            ///<! true if basket writes during Fill may proceed asynchronously (see SetAsyncWrite)
    UInt_t         fNEntriesSinceSorting;  ///<! Number of entries processed since the last re-sorting of branches
    std::vector<std::pair<Long64_t,TBranch*>> fSortedBranches; ///<! Branches sorted by average task time
+   TTreeRangeSummary *fRangeSummary{nullptr}; ///<! Branch range summary: fill-time accumulator or cache of the one stored in fUserInfo
+   TString        fRangeCutBranch;        ///<! Branch name of the declared range cut (see SetRangeCut)
+   Double_t       fRangeCutMin{0};        ///<! Lower bound of the declared range cut
+   Double_t       fRangeCutMax{0};        ///<! Upper bound of the declared range cut
 
    static Int_t     fgBranchStyle;        ///<  Old/New branch style
    static Long64_t  fgMaxTreeSize;        ///<  Maximum size of a file containing a Tree
@@ -145,6 +151,7 @@ private:
    mutable Bool_t fIMTFlush{false};               ///<! True if we are doing a multithreaded flush.
    mutable std::atomic<Long64_t> fIMTTotBytes;    ///<! Total bytes for the IMT flush baskets
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
+   ROOT::Internal::TBranchIMTHelper *fAsyncWriteHelper{nullptr}; ///<! Pending asynchronous basket writes (see SetAsyncWrite)
 
    void             InitializeSortedBranches();
    void             SortBranchesByTime();
@@ -187,6 +194,7 @@ protected:
    friend class TFriendLock;
    // So that the index class can use TFriendLock:
    friend class TTreeIndex;
+   friend class TTreeIndexHash;
    friend class TChainIndex;
    // So that the TTreeCloner can access the protected interfaces
    friend class TTreeCloner;
@@ -230,7 +238,13 @@ public:
    // TTree status bits
    enum {
       kForceRead   = BIT(11),
-      kCircular    = BIT(12)
+      kCircular    = BIT(12),
+      /// If set, the branches only write their baskets at the cluster
+      /// boundaries defined by fAutoFlush: a basket that fills up in the
+      /// middle of a cluster is grown in memory instead of being written,
+      /// so all branches close their baskets on the same entry and the
+      /// baskets of one cluster are contiguous on disk.
+      kOnlyFlushAtCluster = BIT(14)
    };
 
    // Split level modifier
@@ -364,6 +378,7 @@ public:
    virtual const char     *GetAlias(const char* aliasName) const;
    virtual Long64_t        GetAutoFlush() const {return fAutoFlush;}
    virtual Long64_t        GetAutoSave()  const {return fAutoSave;}
+   virtual Bool_t          GetAsyncWrite() const {return fAsyncWrite;}
    virtual TBranch        *GetBranch(const char* name);
    virtual TBranchRef     *GetBranchRef() const { return fBranchRef; };
    virtual Bool_t          GetBranchStatus(const char* branchname) const;
@@ -422,12 +437,13 @@ public:
    virtual TVirtualPerfStats *GetPerfStats() const { return fPerfStats; }
    virtual Long64_t        GetReadEntry()  const { return fReadEntry; }
    virtual Long64_t        GetReadEvent()  const { return fReadEntry; }
+   TTreeRangeSummary      *GetRangeSummary();
    virtual Int_t           GetScanField()  const { return fScanField; }
    TTreeFormula           *GetSelect()    { return GetPlayer()->GetSelect(); }
    virtual Long64_t        GetSelectedRows() { return GetPlayer()->GetSelectedRows(); }
    virtual Int_t           GetTimerInterval() const { return fTimerInterval; }
            TBuffer*        GetTransientBuffer(Int_t size);
-   virtual Long64_t        GetTotBytes() const { return fTotBytes; }
+   virtual Long64_t        GetTotBytes() const { return fIMTFlush ? fTotBytes + fIMTTotBytes : fTotBytes; }
    virtual TTree          *GetTree() const { return const_cast<TTree*>(this); }
    virtual TVirtualIndex  *GetTreeIndex() const { return fTreeIndex; }
    virtual Int_t           GetTreeNumber() const { return 0; }
@@ -455,7 +471,7 @@ public:
    virtual Double_t       *GetV4()   { return GetPlayer()->GetV4(); }
    virtual Double_t       *GetW()    { return GetPlayer()->GetW(); }
    virtual Double_t        GetWeight() const   { return fWeight; }
-   virtual Long64_t        GetZipBytes() const { return fZipBytes; }
+   virtual Long64_t        GetZipBytes() const { return fIMTFlush ? fZipBytes + fIMTZipBytes : fZipBytes; }
    virtual void            IncrementTotalBuffers(Int_t nbytes) { fTotalBuffers += nbytes; }
    Bool_t                  IsFolder() const { return kTRUE; }
    virtual Int_t           LoadBaskets(Long64_t maxmemory = 2000000000);
@@ -471,7 +487,9 @@ public:
    static  TTree          *MergeTrees(TList* list, Option_t* option = "");
    virtual Bool_t          Notify();
    virtual void            OptimizeBaskets(ULong64_t maxMemory=10000000, Float_t minComp=1.1, Option_t *option="");
+   virtual void            SetArchivalWriteMode(ULong64_t maxMemory = 500000000);
    TPrincipal             *Principal(const char* varexp = "", const char* selection = "", Option_t* option = "np", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0);
+   virtual Bool_t          PassesRangeCut();
    virtual void            Print(Option_t* option = "") const; // *MENU*
    virtual void            PrintCacheStats(Option_t* option = "") const;
    virtual Long64_t        Process(const char* filename, Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0); // *MENU*
@@ -486,6 +504,7 @@ public:
    virtual TSQLResult     *Query(const char* varexp = "", const char* selection = "", Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0);
    virtual Long64_t        ReadFile(const char* filename, const char* branchDescriptor = "", char delimiter = ' ');
    virtual Long64_t        ReadStream(std::istream& inputStream, const char* branchDescriptor = "", char delimiter = ' ');
+   virtual Long64_t        ReadSQLResult(TSQLResult* result, const char* branchDescriptor = "", Int_t batchSize = 4096);
    virtual void            Refresh();
    virtual void            RecursiveRemove(TObject *obj);
    virtual void            RemoveFriend(TTree*);
@@ -496,6 +515,7 @@ public:
    virtual Long64_t        Scan(const char* varexp = "", const char* selection = "", Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0); // *MENU*
    virtual Bool_t          SetAlias(const char* aliasName, const char* aliasFormula);
    virtual void            SetAutoSave(Long64_t autos = -300000000);
+   virtual void            SetAsyncWrite(Bool_t enable = kTRUE);
    virtual void            SetAutoFlush(Long64_t autof = -30000000);
    virtual void            SetBasketSize(const char* bname, Int_t buffsize = 16000);
 #if !defined(__CINT__)
@@ -544,6 +564,8 @@ public:
    virtual void            SetObject(const char* name, const char* title);
    virtual void            SetParallelUnzip(Bool_t opt=kTRUE, Float_t RelSize=-1);
    virtual void            SetPerfStats(TVirtualPerfStats* perf);
+   virtual void            SetRangeCut(const char *branchname, Double_t vmin, Double_t vmax);
+   virtual void            SetRangeSummaryBranches(const char *branchnames);
    virtual void            SetScanField(Int_t n = 50) { fScanField = n; } // *MENU*
    virtual void            SetTimerInterval(Int_t msec = 333) { fTimerInterval=msec; }
    virtual void            SetTreeIndex(TVirtualIndex* index);
@@ -554,6 +576,7 @@ public:
    virtual Int_t           StopCacheLearningPhase();
    virtual Int_t           UnbinnedFit(const char* funcname, const char* varexp, const char* selection = "", Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0);
    void                    UseCurrentStyle();
+           void            WaitForAsyncWrites();
    virtual Int_t           Write(const char *name=0, Int_t option=0, Int_t bufsize=0);
    virtual Int_t           Write(const char *name=0, Int_t option=0, Int_t bufsize=0) const;
 
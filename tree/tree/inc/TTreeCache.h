@@ -24,6 +24,8 @@
 #include "TFileCacheRead.h"
 #include "TObjArray.h"
 
+#include <map>
+
 class TTree;
 class TBranch;
 
@@ -56,7 +58,16 @@ protected:
    Bool_t          fEnabled;          ///<! cache enabled for cached reading
    EPrefillType    fPrefillType;      ///<  Whether a pre-filling is enabled (and if applicable which type)
    static  Int_t   fgLearnEntries;    ///<  number of entries used for learning mode
+   static  Bool_t  fgShareProfile;    ///<  true if learned profiles are shared between caches reading the same tree
    Bool_t          fAutoCreated;      ///<! true if cache was automatically created
+   UInt_t          fBasketCacheId;    ///<! id of fFile in the shared compressed basket cache
+   Bool_t          fBasketCacheSet;   ///<! true if fBasketCacheId has been looked up
+   Bool_t          fRandomAccess;     ///<! true when the cache is driven by PrefetchEntries hints
+   std::map<Long64_t,UInt_t> fBasketUse; ///<! basket page table: use count per basket seek position
+
+   Bool_t               AdoptSharedProfile();
+   void                 ShareLearnedProfile();
+   UInt_t               GetBasketCacheId();
 
 private:
    TTreeCache(const TTreeCache &);            //this class cannot be copied
@@ -80,26 +91,32 @@ public:
    virtual Int_t        GetEntryMin() const {return fEntryMin;}
    virtual Int_t        GetEntryMax() const {return fEntryMax;}
    static Int_t         GetLearnEntries();
+   static Bool_t        GetProfileSharing();
    virtual EPrefillType GetLearnPrefill() const {return fPrefillType;}
    TTree               *GetTree() const {return fTree;}
    Bool_t               IsAutoCreated() const {return fAutoCreated;}
    virtual Bool_t       IsEnabled() const {return fEnabled;}
    virtual Bool_t       IsLearning() const {return fIsLearning;}
+   Bool_t               IsRandomAccess() const {return fRandomAccess;}
 
    virtual Bool_t       FillBuffer();
    virtual void         LearnPrefill();
+   virtual Int_t        LoadLearnedProfile(const char *filename);
 
+   virtual Int_t        PrefetchEntries(const Long64_t *entries, Int_t nentries);
    virtual void         Print(Option_t *option="") const;
    virtual Int_t        ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Int_t        ReadBufferNormal(char *buf, Long64_t pos, Int_t len);
    virtual Int_t        ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len);
    virtual void         ResetCache();
+   virtual Int_t        SaveLearnedProfile(const char *filename) const;
    void                 SetAutoCreated(Bool_t val) {fAutoCreated = val;}
    virtual Int_t        SetBufferSize(Int_t buffersize);
    virtual void         SetEntryRange(Long64_t emin,   Long64_t emax);
    virtual void         SetFile(TFile *file, TFile::ECacheAction action=TFile::kDisconnect);
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
+   static void          SetProfileSharing(Bool_t share = kTRUE);
    void                 StartLearningPhase();
    virtual void         StopLearningPhase();
    virtual void         UpdateBranches(TTree *tree);
@@ -25,6 +25,8 @@
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
+#include "RConfigure.h"
+
 #include "TTreeCache.h"
 
 #include <queue>
@@ -123,6 +125,9 @@ public:
    static void    SetUnzipRelBufferSize(Float_t relbufferSize);
    Int_t          UnzipBuffer(char **dest, char *src);
    Int_t          UnzipCache(Int_t &startindex, Int_t &locbuffsz, char *&locbuff);
+#ifdef R__USE_IMT
+   Int_t          UnzipCacheImt();
+#endif
 
    // Methods to get stats
    Int_t  GetNUnzip() { return fNUnzip; }
@@ -0,0 +1,54 @@
+// @(#)root/tree:$Id$
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeColumnStore
+#define ROOT_TTreeColumnStore
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeColumnStore                                                     //
+//                                                                      //
+// Writes the flat leaves of a TTree as per-cluster column pages        //
+// (TColumnPage) into a directory and serves bulk value reads from      //
+// them.                                                                //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "THashList.h"
+
+class TColumnPage;
+class TDirectory;
+class TTree;
+
+class TTreeColumnStore : public TObject {
+
+protected:
+   TDirectory *fDir;   ///<! Directory holding the column pages
+   THashList   fPages; ///<! Cached pages, at most one per branch
+
+   TTreeColumnStore(const TTreeColumnStore&);            // not implemented
+   TTreeColumnStore& operator=(const TTreeColumnStore&); // not implemented
+
+public:
+   TTreeColumnStore(TDirectory *dir);
+   virtual ~TTreeColumnStore();
+
+   TColumnPage *GetPage(const char *branchname, Long64_t entry);
+   Int_t        GetBulkValues(const char *branchname, Long64_t entry,
+                              Int_t nentries, void *dest);
+
+   static Int_t Write(TTree *tree, TDirectory *dir);
+
+   ClassDef(TTreeColumnStore,0);  // Column page writer/reader for flat trees
+};
+
+#endif
@@ -0,0 +1,79 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeRangeSummary
+#define ROOT_TTreeRangeSummary
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeRangeSummary                                                    //
+//                                                                      //
+// Minimum/maximum/sum record for designated branches of one tree,      //
+// accumulated while the tree is filled and stored in the tree user     //
+// info list (see TTree::SetRangeSummaryBranches). A chain consults     //
+// the summary of each of its trees to skip whole files whose value     //
+// ranges cannot pass a cut (see TTree::SetRangeCut).                   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TNamed.h"
+#include "TObjArray.h"
+
+#include <vector>
+
+class TTree;
+class TLeaf;
+
+class TTreeRangeSummary : public TNamed {
+
+public:
+   class TBranchRange : public TNamed {
+   private:
+      Double_t fMin;      // smallest value seen on the branch
+      Double_t fMax;      // largest value seen on the branch
+      Double_t fSum;      // sum of the accumulated values
+      Long64_t fEntries;  // number of accumulated values
+
+   public:
+      TBranchRange(const char *name = "");
+      virtual ~TBranchRange() {}
+
+      void     Update(Double_t value);
+      Bool_t   Overlaps(Double_t vmin, Double_t vmax) const;
+      Double_t GetMin() const { return fMin; }
+      Double_t GetMax() const { return fMax; }
+      Double_t GetSum() const { return fSum; }
+      Long64_t GetEntries() const { return fEntries; }
+
+      ClassDef(TBranchRange, 1);  // Min/max/sum of the values of one branch
+   };
+
+   TTreeRangeSummary(const char *treename = "");
+   virtual ~TTreeRangeSummary() {}
+
+   TBranchRange *AddBranch(const char *branchname);
+   TBranchRange *GetBranchRange(const char *branchname) const;
+   Bool_t        Overlaps(const char *branchname, Double_t vmin, Double_t vmax) const;
+   Int_t         GetNbranches() const { return fRanges.GetEntriesFast(); }
+
+   Bool_t        RegisterLeaves(TTree *tree);
+   void          Accumulate();
+
+   virtual void  Print(Option_t *option = "") const;
+
+private:
+   TObjArray           fRanges;   //  one TBranchRange per designated branch
+   std::vector<TLeaf*> fLeaves;   //! leaves sampled at fill time, parallel to fRanges
+
+   ClassDef(TTreeRangeSummary, 1);  // Branch value ranges of a tree, used to skip files in chains
+};
+
+#endif
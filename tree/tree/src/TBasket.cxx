@@ -22,6 +22,9 @@
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
 #include "RZip.h"
+#include "ZipInteger.h"
+#include "TTrace.h"
+#include "TLeafI.h"
 
 const UInt_t kDisplacementMask = 0xFF000000;  // In the streamer the two highest bytes of
                                               // the fEntryOffset are used to stored displacement.
@@ -39,7 +42,7 @@ See picture in TTree.
 ////////////////////////////////////////////////////////////////////////////////
 /// Default contructor.
 
-TBasket::TBasket() : fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0)
+TBasket::TBasket() : fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0), fPreparedSize(-1)
 {
    fDisplacement  = 0;
    fEntryOffset   = 0;
@@ -56,7 +59,7 @@ TBasket::TBasket() : fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLa
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor used during reading.
 
-TBasket::TBasket(TDirectory *motherDir) : TKey(motherDir),fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0)
+TBasket::TBasket(TDirectory *motherDir) : TKey(motherDir),fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0), fPreparedSize(-1)
 {
    fDisplacement  = 0;
    fEntryOffset   = 0;
@@ -74,7 +77,7 @@ TBasket::TBasket(TDirectory *motherDir) : TKey(motherDir),fCompressedBufferRef(0
 /// Basket normal constructor, used during writing.
 
 TBasket::TBasket(const char *name, const char *title, TBranch *branch) :
-   TKey(branch->GetDirectory()),fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0)
+   TKey(branch->GetDirectory()),fCompressedBufferRef(0), fOwnsCompressedBuffer(kFALSE), fLastWriteBufferSize(0), fPreparedSize(-1)
 {
    SetName(name);
    SetTitle(title);
@@ -434,6 +437,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       return -1;
    }
 
+   R__TRACE(kTraceBasketRead, len, fBranch->GetName());
+
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
@@ -570,6 +575,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       Int_t nin, nbuf;
       Int_t nout = 0, noutot = 0, nintot = 0;
 
+      R__TRACE(kTraceBasketUnzip, fObjlen, fBranch->GetName());
+
       // Unzip all the compressed objects in the compressed object buffer.
       while (1) {
          // Check the header for errors.
@@ -740,6 +747,7 @@ void TBasket::Reset()
    fHeaderOnly  = kFALSE;
    fDisplacement= storeDisplacement;
    fEntryOffset = storeEntryOffset;
+   fPreparedSize= -1;
    if (fNevBufSize) {
       for (Int_t i=0;i<fNevBufSize;i++) fEntryOffset[i] = 0;
    }
@@ -915,6 +923,109 @@ void TBasket::Update(Int_t offset, Int_t skipped)
    fNevBuf++;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Try the lightweight per-basket integer encodings (see R__zipInteger) on
+/// the basket payload, when the branch has opted in with
+/// TBranch::SetIntegerEncoding and its content is a plain array of 32 bit
+/// integers: a single fixed-size TLeafI, hence no entry offset table.
+/// Returns the encoded size written into bufcur, or 0 when the encodings do
+/// not apply or none beats the raw buffer, in which case the caller goes
+/// through the regular compression path.
+
+Int_t TBasket::TryIntegerEncoding(char *objbuf, Int_t objlen, char *bufcur)
+{
+   if (!fBranch->GetIntegerEncoding()) return 0;
+   if (fEntryOffset) return 0;
+   if (objlen <= 0 || (objlen & 3) || objlen > kMAXZIPBUF) return 0;
+   if (fBranch->GetNleaves() != 1) return 0;
+   TLeaf *leaf = (TLeaf*) fBranch->GetListOfLeaves()->UncheckedAt(0);
+   if (!leaf || leaf->GetLeafCount() || leaf->IsA() != TLeafI::Class()) return 0;
+
+   Int_t nout = 0;
+   Int_t tgtsize = objlen; // accept the encoding only when smaller than raw
+   R__zipInteger(&objlen, objbuf, &tgtsize, bufcur, &nout);
+   return nout;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the basket buffer in memory, without touching the TFile, so that
+/// a subsequent WriteBuffer() only has to reserve the space in the file and
+/// write the prepared bytes out.
+///
+/// This is used by TTree::FlushBaskets to run the compression of a whole
+/// cluster of baskets in parallel (the per-branch buffers are independent)
+/// while keeping the actual file writes serialized and in branch order.
+///
+/// Returns the size of the compressed payload, 0 when the basket has to go
+/// through the regular WriteBuffer() path (compression off, incompressible
+/// data, or a basket carried over in not-decompressed form), and -1 in case
+/// of error.  The prepared state is consumed by the next WriteBuffer() call.
+
+Int_t TBasket::PrepareWriteBuffer()
+{
+   const Int_t kWrite = 1;
+
+   fPreparedSize = -1;
+   if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed))) {
+      return 0;
+   }
+   Int_t cxlevel = fBranch->GetCompressionLevel();
+   if (cxlevel <= 0) {
+      return 0;
+   }
+   TFile *file = fBranch->GetFile(kWrite);
+   if (!file) {
+      return 0;
+   }
+
+   // Transfer fEntryOffset table at the end of fBuffer.
+   fLast = fBufferRef->Length();
+   if (fEntryOffset) {
+      fBufferRef->WriteArray(fEntryOffset,fNevBuf+1);
+      if (fDisplacement) {
+         fBufferRef->WriteArray(fDisplacement,fNevBuf+1);
+         delete [] fDisplacement; fDisplacement = 0;
+      }
+   }
+   fObjlen = fBufferRef->Length() - fKeylen;
+
+   Int_t cxAlgorithm = fBranch->GetCompressionAlgorithm();
+   Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
+   Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28; //add 28 bytes in case object is placed in a deleted gap
+   InitializeCompressedBuffer(buflen, file);
+   if (!fCompressedBufferRef) {
+      Warning("PrepareWriteBuffer", "Unable to allocate the compressed buffer");
+      return -1;
+   }
+   fCompressedBufferRef->SetWriteMode();
+   char *objbuf = fBufferRef->Buffer() + fKeylen;
+   char *bufcur = fCompressedBufferRef->Buffer() + fKeylen;
+   Int_t nout = 0, noutot = 0, bufmax = 0, nzip = 0;
+   nout = TryIntegerEncoding(objbuf, fObjlen, bufcur);
+   if (nout > 0) {
+      fPreparedSize = nout;
+      return nout;
+   }
+   for (Int_t i = 0; i < nbuffers; ++i) {
+      if (i == nbuffers - 1) bufmax = fObjlen - nzip;
+      else bufmax = kMAXZIPBUF;
+      R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+      if (nout == 0 || nout >= fObjlen) {
+         // The buffer cannot be compressed; remember that the entry offset
+         // table has already been transferred so that WriteBuffer() directly
+         // writes the uncompressed buffer.
+         fPreparedSize = 0;
+         return 0;
+      }
+      bufcur += nout;
+      noutot += nout;
+      objbuf += kMAXZIPBUF;
+      nzip   += kMAXZIPBUF;
+   }
+   fPreparedSize = noutot;
+   return noutot;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write buffer of this basket on the current file.
 ///
@@ -964,20 +1075,28 @@ Int_t TBasket::WriteBuffer()
       return nBytes>0 ? fKeylen+nout : -1;
    }
 
-   // Transfer fEntryOffset table at the end of fBuffer.
-   fLast = fBufferRef->Length();
-   if (fEntryOffset) {
-      // Note: We might want to investigate the compression gain if we
-      // transform the Offsets to fBuffer in entry length to optimize
-      // compression algorithm.  The aggregate gain on a (random) CMS files
-      // is around 5.5%. So the code could something like:
-      //      for(Int_t z = fNevBuf; z > 0; --z) {
-      //         if (fEntryOffset[z]) fEntryOffset[z] = fEntryOffset[z] - fEntryOffset[z-1];
-      //      }
-      fBufferRef->WriteArray(fEntryOffset,fNevBuf+1);
-      if (fDisplacement) {
-         fBufferRef->WriteArray(fDisplacement,fNevBuf+1);
-         delete [] fDisplacement; fDisplacement = 0;
+   // Prepared state from PrepareWriteBuffer(): -1 not prepared, 0 prepared
+   // but to be written uncompressed (incompressible data), > 0 size of the
+   // compressed payload waiting in fCompressedBufferRef.
+   Int_t prepared = fPreparedSize;
+   fPreparedSize = -1;
+
+   if (prepared < 0) {
+      // Transfer fEntryOffset table at the end of fBuffer.
+      fLast = fBufferRef->Length();
+      if (fEntryOffset) {
+         // Note: We might want to investigate the compression gain if we
+         // transform the Offsets to fBuffer in entry length to optimize
+         // compression algorithm.  The aggregate gain on a (random) CMS files
+         // is around 5.5%. So the code could something like:
+         //      for(Int_t z = fNevBuf; z > 0; --z) {
+         //         if (fEntryOffset[z]) fEntryOffset[z] = fEntryOffset[z] - fEntryOffset[z-1];
+         //      }
+         fBufferRef->WriteArray(fEntryOffset,fNevBuf+1);
+         if (fDisplacement) {
+            fBufferRef->WriteArray(fDisplacement,fNevBuf+1);
+            delete [] fDisplacement; fDisplacement = 0;
+         }
       }
    }
 
@@ -989,7 +1108,19 @@ Int_t TBasket::WriteBuffer()
    fCycle = fBranch->GetWriteBasket();
    Int_t cxlevel = fBranch->GetCompressionLevel();
    Int_t cxAlgorithm = fBranch->GetCompressionAlgorithm();
-   if (cxlevel > 0) {
+   if (cxlevel > 0 && prepared != 0) {
+      if (prepared > 0) {
+         // The payload was already compressed by PrepareWriteBuffer(); only
+         // reserve the space in the file and write the bytes out.
+         nout = prepared;
+         fBuffer = fCompressedBufferRef->Buffer();
+         Create(nout,file);
+         fBufferRef->SetBufferOffset(0);
+
+         Streamer(*fBufferRef);         //write key itself again
+         memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
+         goto WriteFile;
+      }
       Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
       Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28; //add 28 bytes in case object is placed in a deleted gap
       InitializeCompressedBuffer(buflen, file);
@@ -1003,6 +1134,15 @@ Int_t TBasket::WriteBuffer()
       char *bufcur = &fBuffer[fKeylen];
       noutot = 0;
       nzip   = 0;
+      nout = TryIntegerEncoding(objbuf, fObjlen, bufcur);
+      if (nout > 0) {
+         Create(nout, file);
+         fBufferRef->SetBufferOffset(0);
+
+         Streamer(*fBufferRef);         //write key itself again
+         memcpy(fBuffer, fBufferRef->Buffer(), fKeylen);
+         goto WriteFile;
+      }
       for (Int_t i = 0; i < nbuffers; ++i) {
          if (i == nbuffers - 1) bufmax = fObjlen - nzip;
          else bufmax = kMAXZIPBUF;
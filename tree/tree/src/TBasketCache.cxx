@@ -0,0 +1,202 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class TBasketCache
+///
+/// A process-wide LRU cache of compressed basket buffers.
+///
+/// TTreeCache keeps a single uncompressed window of baskets; once the window
+/// moves on, re-reading an earlier entry range goes back to storage. This
+/// class keeps the most recently used *compressed* baskets of all trees in
+/// memory, within a shared byte budget, so analyses that iterate a tree
+/// several times pay only decompression from the second pass on.
+///
+/// The cache is disabled by default. It is enabled by giving it a budget,
+/// either in a rootrc/.rootrc resource (in MBytes):
+/// ~~~{.cpp}
+///     TTreeCache.BasketCacheSize:  500
+/// ~~~
+/// or from code:
+/// ~~~{.cpp}
+///     TBasketCache::Instance().SetMaxSize(500*1024*1024);
+/// ~~~
+///
+/// Entries are keyed by the file UUID and the basket offset, so a file that
+/// is rewritten (and gets a new UUID) cannot serve stale buffers. Baskets of
+/// writable files are never cached. TTreeCache feeds and consults the cache
+/// transparently; hit and size counters are reported by Print() and by
+/// TTreePerfStats.
+
+#include "TBasketCache.h"
+
+#include "TEnv.h"
+#include "TFile.h"
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor. The initial budget is taken from the
+/// TTreeCache.BasketCacheSize resource (in MBytes, default 0 = disabled).
+
+TBasketCache::TBasketCache()
+   : fMaxSize(0), fSize(0), fNHits(0), fNMisses(0), fNEvicted(0)
+{
+   fMaxSize = 1024*1024*Long64_t(gEnv->GetValue("TTreeCache.BasketCacheSize", 0));
+   if (fMaxSize < 0) fMaxSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the single process-wide instance.
+
+TBasketCache &TBasketCache::Instance()
+{
+   static TBasketCache gCache;
+   return gCache;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the cache id of the given file, registering it if needed.
+/// Files are identified by their UUID, which changes when a file is
+/// rewritten, so ids never resolve to stale content.
+
+UInt_t TBasketCache::GetFileId(TFile *file)
+{
+   std::string uuid = file->GetUUID().AsString();
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   std::map<std::string, UInt_t>::iterator it = fFileIds.find(uuid);
+   if (it != fFileIds.end())
+      return it->second;
+   UInt_t id = (UInt_t)fFileIds.size();
+   fFileIds[uuid] = id;
+   return id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If the basket at the given file position is cached with the same length,
+/// copy it into buf, move it to the front of the LRU list and return kTRUE.
+
+Bool_t TBasketCache::ReadBuffer(UInt_t fileid, Long64_t pos, Int_t len, char *buf)
+{
+   if (!IsEnabled()) return kFALSE;
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   EntryMap_t::iterator it = fMap.find(Key_t(fileid, pos));
+   if (it == fMap.end() || (Int_t)it->second->fData.size() != len) {
+      fNMisses++;
+      return kFALSE;
+   }
+   fLru.splice(fLru.begin(), fLru, it->second);
+   memcpy(buf, &it->second->fData[0], len);
+   fNHits++;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store a copy of the compressed basket bytes, evicting the least recently
+/// used entries if the budget is exceeded.
+
+void TBasketCache::Insert(UInt_t fileid, Long64_t pos, Int_t len, const char *buf)
+{
+   if (!IsEnabled() || len <= 0 || (Long64_t)len > fMaxSize) return;
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   EntryMap_t::iterator it = fMap.find(Key_t(fileid, pos));
+   if (it != fMap.end()) {
+      // Already cached: just refresh its position in the LRU list.
+      fLru.splice(fLru.begin(), fLru, it->second);
+      return;
+   }
+
+   fLru.push_front(Entry_t());
+   Entry_t &entry = fLru.front();
+   entry.fFileId = fileid;
+   entry.fPos    = pos;
+   entry.fData.assign(buf, buf + len);
+   fMap[Key_t(fileid, pos)] = fLru.begin();
+   fSize += len;
+
+   while (fSize > fMaxSize && !fLru.empty()) {
+      Entry_t &last = fLru.back();
+      fSize -= (Long64_t)last.fData.size();
+      fMap.erase(Key_t(last.fFileId, last.fPos));
+      fLru.pop_back();
+      fNEvicted++;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the byte budget of the cache. A value of 0 disables the cache and
+/// drops all entries; shrinking the budget evicts down to the new size.
+
+void TBasketCache::SetMaxSize(Long64_t maxbytes)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fMaxSize = (maxbytes > 0) ? maxbytes : 0;
+   while (fSize > fMaxSize && !fLru.empty()) {
+      Entry_t &last = fLru.back();
+      fSize -= (Long64_t)last.fData.size();
+      fMap.erase(Key_t(last.fFileId, last.fPos));
+      fLru.pop_back();
+      fNEvicted++;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes currently cached.
+
+Long64_t TBasketCache::GetSize() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of requests served from the cache.
+
+Long64_t TBasketCache::GetNHits() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fNHits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of requests that were not in the cache.
+
+Long64_t TBasketCache::GetNMisses() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fNMisses;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of entries evicted to respect the budget.
+
+Long64_t TBasketCache::GetNEvicted() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fNEvicted;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the cache budget, usage and counters.
+
+void TBasketCache::Print(Option_t * /*option*/) const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   printf("******TBasketCache statistics*******\n");
+   printf("Max size ........................: %lld bytes\n", fMaxSize);
+   printf("Cached ..........................: %lld bytes in %lld baskets\n",
+          fSize, (Long64_t)fLru.size());
+   printf("Hits ............................: %lld\n", fNHits);
+   printf("Misses ..........................: %lld\n", fNMisses);
+   printf("Evicted .........................: %lld\n", fNEvicted);
+}
@@ -32,6 +32,7 @@
 #include "TLeafS.h"
 #include "TMessage.h"
 #include "TROOT.h"
+#include "TStringInterner.h"
 #include "TSystem.h"
 #include "TMath.h"
 #include "TTree.h"
@@ -44,6 +45,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <thread>
 #include <string.h>
 #include <stdio.h>
 
@@ -91,6 +93,8 @@ TBranch::TBranch()
 , fFirstBasketEntry(-1)
 , fNextBasketEntry(-1)
 , fCurrentBasket(0)
+, fStandbyBasket(0)
+, fAsyncWriteInFlight(kFALSE)
 , fEntries(0)
 , fFirstEntry(0)
 , fTotBytes(0)
@@ -110,6 +114,7 @@ TBranch::TBranch()
 , fEntryBuffer(0)
 , fTransientBuffer(0)
 , fBrowsables(0)
+, fInternedName(0)
 , fSkipZip(kFALSE)
 , fReadLeaves(&TBranch::ReadLeavesImpl)
 , fFillLeaves(&TBranch::FillLeavesImpl)
@@ -194,6 +199,8 @@ TBranch::TBranch(TTree *tree, const char* name, void* address, const char* leafl
 , fFirstBasketEntry(-1)
 , fNextBasketEntry(-1)
 , fCurrentBasket(0)
+, fStandbyBasket(0)
+, fAsyncWriteInFlight(kFALSE)
 , fEntries(0)
 , fFirstEntry(0)
 , fTotBytes(0)
@@ -213,6 +220,7 @@ TBranch::TBranch(TTree *tree, const char* name, void* address, const char* leafl
 , fEntryBuffer(0)
 , fTransientBuffer(0)
 , fBrowsables(0)
+, fInternedName(0)
 , fSkipZip(kFALSE)
 , fReadLeaves(&TBranch::ReadLeavesImpl)
 , fFillLeaves(&TBranch::FillLeavesImpl)
@@ -244,6 +252,8 @@ TBranch::TBranch(TBranch *parent, const char* name, void* address, const char* l
 , fFirstBasketEntry(-1)
 , fNextBasketEntry(-1)
 , fCurrentBasket(0)
+, fStandbyBasket(0)
+, fAsyncWriteInFlight(kFALSE)
 , fEntries(0)
 , fFirstEntry(0)
 , fTotBytes(0)
@@ -263,6 +273,7 @@ TBranch::TBranch(TBranch *parent, const char* name, void* address, const char* l
 , fEntryBuffer(0)
 , fTransientBuffer(0)
 , fBrowsables(0)
+, fInternedName(0)
 , fSkipZip(kFALSE)
 , fReadLeaves(&TBranch::ReadLeavesImpl)
 , fFillLeaves(&TBranch::FillLeavesImpl)
@@ -434,6 +445,8 @@ TBranch::~TBranch()
    fBaskets.Delete();
    fNBaskets = 0;
    fCurrentBasket = 0;
+   delete fStandbyBasket;
+   fStandbyBasket = 0;
    fFirstBasketEntry = -1;
    fNextBasketEntry = -1;
 
@@ -812,7 +825,23 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
       if (fTree->TestBit(TTree::kCircular)) {
          return nbytes;
       }
-      Int_t nout = WriteBasketImpl(basket, fWriteBasket, imtHelper);
+      if (fTree->TestBit(TTree::kOnlyFlushAtCluster) && fTree->GetAutoFlush() > 0
+          && !fSkipZip && !buf->TestBit(TBufferFile::kNotDecompressed)) {
+         // Defer the write until the next cluster flush: grow the basket
+         // toward the cluster size instead, so that every branch closes its
+         // basket on the cluster boundary and the baskets stay aligned on
+         // disk. OptimizeBaskets (called at the first flush) then records
+         // the grown sizes, so later clusters reserve the right amount
+         // up front.
+         SetBasketSize(TMath::Max(fBasketSize + nbytes, 2 * fBasketSize));
+         return nbytes;
+      }
+      Int_t nout;
+      if (imtHelper && fTree->GetAsyncWrite()) {
+         nout = WriteBasketAsync(basket, fWriteBasket, imtHelper);
+      } else {
+         nout = WriteBasketImpl(basket, fWriteBasket, imtHelper);
+      }
       if (nout < 0) Error("TBranch::Fill", "Failed to write out basket.\n");
       return (nout >= 0) ? nbytes : -1;
    }
@@ -1063,6 +1092,34 @@ Int_t TBranch::FlushBaskets()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compress in memory the baskets that FlushBaskets would write, for this
+/// branch and its sub-branches, without touching the underlying TFile (see
+/// TBasket::PrepareWriteBuffer).  TTree::FlushBaskets calls this in parallel
+/// for all the branches of the tree and then runs the (now cheap) file
+/// writes serially, in branch order.
+
+void TBranch::PrepareBasketsToFlush()
+{
+   Int_t maxbasket = fWriteBasket + 1;
+   for (Int_t i = 0; i != maxbasket; ++i) {
+      TBasket *basket = (TBasket*)fBaskets.UncheckedAt(i);
+      if (basket && basket->GetNevBuf() && fBasketSeek[i] == 0) {
+         if (basket->GetBufferRef()->IsReading()) {
+            basket->SetWriteMode();
+         }
+         basket->PrepareWriteBuffer();
+      }
+   }
+   Int_t len = fBranches.GetEntriesFast();
+   for (Int_t i = 0; i < len; ++i) {
+      TBranch *branch = (TBranch*)fBranches.UncheckedAt(i);
+      if (branch) {
+         branch->PrepareBasketsToFlush();
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// If we have a write basket in memory and it contains some entries and
 /// has not yet been written to disk, we write it and delete it from memory.
@@ -1212,6 +1269,120 @@ const char* TBranch::GetIconName() const
       return "TBranchElement-leaf";
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the canonical interned copy of the branch name (see
+/// TStringInterner). Two branches (or a branch and an interned lookup key)
+/// have the same name if and only if their interned pointers are equal,
+/// which lets name scans compare pointers instead of calling strcmp.
+/// The pointer is computed on first use and cached; SetName invalidates it.
+
+const char *TBranch::GetInternedName() const
+{
+   if (!fInternedName)
+      fInternedName = TStringInterner::Intern(fName.Data());
+   return fInternedName;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read a basket's worth of entries in one pass and hand the deserialized
+/// payload to the caller without copying it.
+///
+/// The basket containing "entry" is loaded (and decompressed) once, its
+/// payload is byte-swapped in a single pass by TLeaf::ReadBasketFast, and
+/// user_buf adopts the basket buffer positioned at "entry". The caller can
+/// then access the values as a contiguous typed array, e.g.
+///
+///~~~ {.cpp}
+///     TBufferFile buf(TBuffer::kWrite);
+///     Int_t nentries = branch->GetBulkEntries(entry, buf);
+///     Float_t *values = reinterpret_cast<Float_t*>(buf.Buffer() + buf.Length());
+///~~~
+///
+/// This fast path is only available for branches with a single fixed-size
+/// leaf (no leaf count, no entry offset table); for anything else the
+/// function returns -1 and the caller must fall back to GetEntry.
+///
+/// Returns the number of entries deserialized into user_buf, 0 if the entry
+/// does not exist and -1 on error or when the branch does not support bulk
+/// reading. The basket is dropped from the branch afterwards - its payload
+/// is no longer in on-disk byte order - so per-entry reads never see the
+/// swapped buffer; ownership of the memory moves to user_buf.
+
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
+{
+   // The bulk path bypasses the ReadLeaves indirection; it only makes sense
+   // for plain branches with exactly one fixed-size leaf.
+   if (R__unlikely(fNleaves != 1)) return -1;
+   TLeaf *leaf = (TLeaf*) fLeaves.UncheckedAt(0);
+   if (R__unlikely(leaf->GetLeafCount() || fEntryOffsetLen)) return -1;
+   if (R__unlikely(TestBit(kDoNotProcess))) return -1;
+   if ((entry < fFirstEntry) || (entry >= fEntryNumber)) return 0;
+
+   fReadEntry = entry;
+
+   // Locate the basket containing this entry (same search as GetEntry).
+   Long64_t first = fFirstBasketEntry;
+   Long64_t last = fNextBasketEntry - 1;
+   if ((entry < first) || (entry > last)) {
+      fReadBasket = TMath::BinarySearch(fWriteBasket + 1, fBasketEntry, entry);
+      if (fReadBasket < 0) {
+         fNextBasketEntry = -1;
+         Error("GetBulkEntries", "In the branch %s, no basket contains the entry %lld", GetName(), entry);
+         return -1;
+      }
+      if (fReadBasket == fWriteBasket) {
+         fNextBasketEntry = fEntryNumber;
+      } else {
+         fNextBasketEntry = fBasketEntry[fReadBasket+1];
+      }
+      first = fFirstBasketEntry = fBasketEntry[fReadBasket];
+   }
+   TBasket *basket = (TBasket*) fBaskets.UncheckedAt(fReadBasket);
+   if (!basket) {
+      basket = GetBasket(fReadBasket);
+      if (!basket) {
+         fCurrentBasket = 0;
+         fFirstBasketEntry = -1;
+         fNextBasketEntry = -1;
+         return -1;
+      }
+   }
+   basket->PrepareBasket(entry);
+   TBuffer *buf = basket->GetBufferRef();
+   if (R__unlikely(!buf)) {
+      TFile *file = GetFile(0);
+      if (!file) return -1;
+      basket->ReadBasketBuffers(fBasketSeek[fReadBasket], fBasketBytes[fReadBasket], file);
+      buf = basket->GetBufferRef();
+      if (!buf) return -1;
+   }
+   // An entry offset table means variable-size entries; no bulk path.
+   if (R__unlikely(basket->GetEntryOffset())) return -1;
+
+   Long64_t bulkEntries = basket->GetNevBuf() - (entry - first);
+   Int_t bufbegin = basket->GetKeylen() + ((entry - first) * basket->GetNevBufSize());
+   buf->SetBufferOffset(bufbegin);
+   if (!leaf->ReadBasketFast(*buf, bulkEntries)) return -1;
+
+   // Hand the deserialized payload over to the caller and forget about the
+   // basket: its content is no longer serialized, so it must not be seen
+   // again by the regular per-entry read path.
+   char *rawbuf = buf->Buffer();
+   Int_t rawsiz = buf->BufferSize();
+   buf->DetachBuffer();
+   user_buf.SetBuffer(rawbuf, rawsiz, kTRUE);
+   user_buf.SetBufferOffset(bufbegin);
+
+   fBaskets[fReadBasket] = 0;
+   --fNBaskets;
+   if (fCurrentBasket == basket) fCurrentBasket = 0;
+   fFirstBasketEntry = -1;
+   fNextBasketEntry = -1;
+   delete basket;
+
+   return bulkEntries;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of entry and return total number of bytes read.
 ///
@@ -2333,6 +2504,16 @@ Bool_t TBranch::SetMakeClass(Bool_t /* decomposeObj */)
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Rename the branch and drop the cached interned name pointer, so that
+/// GetInternedName re-interns the new name on next use.
+
+void TBranch::SetName(const char *name)
+{
+   fInternedName = 0;
+   TNamed::SetName(name);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set object this branch is pointing to.
 
@@ -2344,6 +2525,28 @@ void TBranch::SetObject(void * /* obj */)
    Warning("SetObject","is not supported in TBranch objects");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable on-write quantization of the floating point leaves of this
+/// branch: values are rounded to the coarsest float/double satisfying
+/// the given relative and/or absolute error tolerance before being
+/// written, which makes the baskets compress much better, and are read
+/// back as ordinary floats/doubles with no special handling. Call right
+/// after TTree::Branch; see TLeaf::SetPrecision for the exact bounds.
+/// Pass 0 for both tolerances to switch quantization off.
+
+void TBranch::SetPrecision(Double_t relTol, Double_t absTol)
+{
+   TIter next(&fLeaves);
+   while (TLeaf *leaf = (TLeaf*) next()) {
+      if (leaf->IsA() == TLeafF::Class() || leaf->IsA() == TLeafD::Class()) {
+         leaf->SetPrecision(relTol, absTol);
+      } else if (relTol > 0 || absTol > 0) {
+         Warning("SetPrecision", "leaf %s of branch %s is not a floating point leaf; quantization not enabled",
+                 leaf->GetName(), GetName());
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set branch status to Process or DoNotProcess.
 
@@ -2660,6 +2863,87 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the current basket to disk asynchronously (see TTree::SetAsyncWrite):
+/// swap a standby basket in as the new write basket, so that filling can
+/// resume immediately, and hand the full basket to a task of the helper for
+/// compression and writing. All the bookkeeping that the next Fill depends on
+/// (fWriteBasket, fBaskets, fBasketEntry) is updated here, on the calling
+/// thread; the task only touches the detached basket, its fBasketBytes and
+/// fBasketSeek slots and the byte counters. Always returns 0: the bytes
+/// written are accounted through the tree's IMT counters and folded into the
+/// totals by TTree::WaitForAsyncWrites.
+
+Int_t TBranch::WriteBasketAsync(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *imtHelper)
+{
+   Int_t nevbuf = basket->GetNevBuf();
+   if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
+      // Make sure that the fEntryOffset array does not stay large unnecessarily.
+      fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf; // assume some fluctuations.
+   } else if (fEntryOffsetLen && nevbuf > fEntryOffsetLen) {
+      // Increase the array ...
+      fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
+   }
+
+   // With one standby basket there is at most one write of this branch in
+   // flight: if the previous basket is still being compressed, wait for it.
+   // This is the only point where Fill can stall in asynchronous mode.
+   while (fAsyncWriteInFlight.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+   }
+
+   // Detach the full basket and advance the write basket, reusing the basket
+   // parked by the previous write when there is one. GetBasket returns
+   // nullptr for an empty write slot, so FillImpl creates a fresh basket on
+   // the first few entries, before a parked one is available.
+   fBaskets[where] = 0;
+   --fNBaskets;
+   if (basket == fCurrentBasket) {
+      fCurrentBasket    = 0;
+      fFirstBasketEntry = -1;
+      fNextBasketEntry  = -1;
+   }
+   ++fWriteBasket;
+   if (fWriteBasket >= fMaxBaskets) {
+      ExpandBasketArrays();
+   }
+   TBasket *standby = fStandbyBasket;
+   fStandbyBasket = 0;
+   if (standby) {
+      ++fNBaskets;
+   }
+   fBaskets.AddAtAndExpand(standby,fWriteBasket);
+   fBasketEntry[fWriteBasket] = fEntryNumber;
+
+   fAsyncWriteInFlight.store(kTRUE, std::memory_order_release);
+   // Captures `basket` and `where` by value: the write basket moves on while
+   // the task still owns the detached basket.
+   imtHelper->Run([=]() -> Long64_t {
+      Int_t nout = basket->WriteBuffer();    //  Write buffer
+      if (nout < 0) Error("TBranch::WriteBasketAsync", "basket's WriteBuffer failed.\n");
+      fBasketBytes[where] = basket->GetNbytes();
+      fBasketSeek[where]  = basket->GetSeekKey();
+      if (nout > 0) {
+         Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+         fZipBytes += nout;
+         fTotBytes += addbytes;
+         fTree->AddTotBytes(addbytes);
+         fTree->AddZipBytes(nout);
+         // Park the basket for the next swap.
+         basket->Reset();
+         fStandbyBasket = basket;
+      } else {
+         // The write failed and the entries of this basket are lost; the
+         // error count of the helper reports this to WaitForAsyncWrites.
+         basket->DropBuffers();
+         delete basket;
+      }
+      fAsyncWriteInFlight.store(kFALSE, std::memory_order_release);
+      return nout;
+   });
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///set the first entry number (case of TBranchSTL)
 
@@ -2674,6 +2958,25 @@ void TBranch::SetFirstEntry(Long64_t entry)
       ((TBranch*)fBranches[i])->SetFirstEntry( entry );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable (or disable) the lightweight per-basket integer encodings for
+/// this branch: at write time each basket of a single fixed-size integer
+/// leaf first tries run-length, dictionary and delta+bitpack encoding and
+/// keeps the smallest result, falling back to the regular compression
+/// path when none beats the raw buffer (see TBasket::WriteBuffer). The
+/// encodings shrink flag, category and run-number branches far more than
+/// a byte oriented compressor and decode at memory bandwidth. Files
+/// containing encoded baskets cannot be read by older ROOT versions.
+
+void TBranch::SetIntegerEncoding(Bool_t use)
+{
+   if (use) {
+      SetBit(kUseIntegerEncoding);
+   } else {
+      ResetBit(kUseIntegerEncoding);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// If the branch address is not set,  we set all addresses starting with
 /// the top level parent branch.
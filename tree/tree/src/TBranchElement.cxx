@@ -18,6 +18,7 @@ A Branch for the case of an object.
 #include "TBranchElement.h"
 
 #include "TBasket.h"
+#include "TBranchIMTHelper.h"
 #include "TBranchObject.h"
 #include "TBranchRef.h"
 #include "TBrowser.h"
@@ -1890,6 +1891,12 @@ char* TBranchElement::GetAddress() const
 void TBranchElement::InitInfo()
 {
    if (!fInfo) {
+      // In case the file was opened with lazy streamer info activation,
+      // register the infos describing this branch's class before looking
+      // them up.
+      if (fDirectory && fDirectory->GetFile())
+         fDirectory->GetFile()->ActivateStreamerInfo(fClassName);
+
       // We did not already have streamer info, so now we must find it.
       TClass* cl = fBranchClass.GetClass();
 
@@ -2251,6 +2258,23 @@ TClass* TBranchElement::GetCurrentClass()
 /// See IMPORTANT REMARKS in TTree::GetEntry.
 
 Int_t TBranchElement::GetEntry(Long64_t entry, Int_t getall)
+{
+   return GetEntryImpl(entry, getall, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GetEntry, with optional fan-out of the sub-branches to
+/// the implicit multi-threading pool (read-side counterpart of FillImpl).
+///
+/// When imtHelper is non-null and this branch has independent sub-branches,
+/// the part of the branch that must be processed in order (its own payload
+/// and the counter branches shared between sub-branches) is read here, and
+/// every sub-branch is then handed to the helper as a task that recursively
+/// does the same. The bytes read and the errors of the tasks are accumulated
+/// in the helper; the caller must Wait() on it and add GetNbytes() to the
+/// return value of this function to get the total.
+
+Int_t TBranchElement::GetEntryImpl(Long64_t entry, Int_t getall, ROOT::Internal::TBranchIMTHelper *imtHelper)
 {
    // Remember which entry we are reading.
    fReadEntry = entry;
@@ -2304,13 +2328,47 @@ Int_t TBranchElement::GetEntry(Long64_t entry, Int_t getall)
             break;
          default:
             ValidateAddress(); // There is no ReadLeave for this node, so we need to do the validation here.
-            for (Int_t i = 0; i < nbranches; ++i) {
-               TBranch* branch = (TBranch*) fBranches.UncheckedAt(i);
-               Int_t nb = branch->GetEntry(entry, getall);
-               if (nb < 0) {
-                  return nb;
+            if (imtHelper && nbranches > 1) {
+               // Settle the counter branches serially first: sub-branches
+               // sharing a counter would otherwise both pull it from their
+               // task. Inside one task the counter of a container branch is
+               // still read before its sub-branches are spawned, so deeper
+               // levels keep their ordering.
+               for (Int_t i = 0; i < nbranches; ++i) {
+                  TBranchElement *branch = dynamic_cast<TBranchElement*>(fBranches.UncheckedAt(i));
+                  if (!branch) continue;
+                  TBranchElement *bcount = branch->fBranchCount;
+                  if (bcount && (bcount->GetReadEntry() != entry)) {
+                     Int_t nb = bcount->TBranch::GetEntry(entry, getall);
+                     if (nb < 0) {
+                        return nb;
+                     }
+                     nbytes += nb;
+                  }
+                  TBranchElement *bcount2 = branch->fBranchCount2;
+                  if (bcount2 && (bcount2->GetReadEntry() != entry)) {
+                     Int_t nb = bcount2->TBranch::GetEntry(entry, getall);
+                     if (nb < 0) {
+                        return nb;
+                     }
+                     nbytes += nb;
+                  }
+               }
+               for (Int_t i = 0; i < nbranches; ++i) {
+                  TBranch *branch = (TBranch*) fBranches.UncheckedAt(i);
+                  imtHelper->Run([branch, entry, getall, imtHelper]() -> Long64_t {
+                     return branch->GetEntryImpl(entry, getall, imtHelper);
+                  });
+               }
+            } else {
+               for (Int_t i = 0; i < nbranches; ++i) {
+                  TBranch* branch = (TBranch*) fBranches.UncheckedAt(i);
+                  Int_t nb = branch->GetEntryImpl(entry, getall, imtHelper);
+                  if (nb < 0) {
+                     return nb;
+                  }
+                  nbytes += nb;
                }
-               nbytes += nb;
             }
             break;
       }
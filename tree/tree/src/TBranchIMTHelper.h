@@ -41,6 +41,16 @@ public:
 #endif
    }
 
+   /// Create the underlying task group up front. Run() creates it lazily,
+   /// which is fine when all Run() calls come from one thread (the Fill
+   /// case) but races when tasks themselves spawn sub-tasks; callers that
+   /// hand the helper to concurrent tasks must call Reserve() first.
+   void Reserve() {
+#ifdef R__USE_IMT
+      if (!fGroup) { fGroup.reset(new tbb::task_group()); }
+#endif
+   }
+
    void Wait() {
 #ifdef R__USE_IMT
       if (fGroup) fGroup->wait();
@@ -71,6 +71,9 @@ TChain::TChain()
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fPreOpenNextFile(kFALSE)
+, fPreOpenHandle(0)
+, fPreOpenTree(-1)
 {
    fTreeOffset = new Long64_t[fTreeOffsetLen];
    fFiles = new TObjArray(fTreeOffsetLen);
@@ -144,6 +147,9 @@ TChain::TChain(const char* name, const char* title)
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fPreOpenNextFile(kFALSE)
+, fPreOpenHandle(0)
+, fPreOpenTree(-1)
 {
    //
    //*-*
@@ -185,6 +191,13 @@ TChain::~TChain()
    delete fFiles;
    fFiles = 0;
 
+   // Let a pending background open of the next file finish, then close it.
+   if (fPreOpenHandle) {
+      TFile *prefile = TFile::Open(fPreOpenHandle);
+      fPreOpenHandle = 0;
+      delete prefile;
+   }
+
    //first delete cache if exists
    if (fFile && fFile->GetCacheRead(fTree)) {
       delete fFile->GetCacheRead(fTree);
@@ -1456,10 +1469,34 @@ Long64_t TChain::LoadTree(Long64_t entry)
    //        if we did not delete it above.
    {
       TDirectory::TContext ctxt;
-      fFile = TFile::Open(element->GetTitle());
+      TFile* prefile = 0;
+      if (fPreOpenHandle) {
+         // A background open of a file was started on a previous transition
+         // (see below): collect it. If the chain is not read sequentially it
+         // may be the wrong file, in which case it is closed again.
+         prefile = TFile::Open(fPreOpenHandle);
+         fPreOpenHandle = 0;
+         if (prefile && (fPreOpenTree != treenum)) {
+            delete prefile;
+            prefile = 0;
+         }
+      }
+      fFile = prefile ? prefile : TFile::Open(element->GetTitle());
       if (fFile) fFile->SetBit(kMustCleanup);
    }
 
+   // Start opening the next file of the chain in the background, so that
+   // the open latency (which for remote files can be a full network round
+   // trip) is overlapped with the processing of the current file and the
+   // next transition finds the file header already fetched.
+   if (fPreOpenNextFile && ((treenum + 1) < fNtrees)) {
+      TChainElement* nextelement = (TChainElement*) fFiles->At(treenum + 1);
+      if (nextelement) {
+         fPreOpenHandle = TFile::AsyncOpen(nextelement->GetTitle());
+         fPreOpenTree = treenum + 1;
+      }
+   }
+
    // ----- Begin of modifications by MvL
    Int_t returnCode = 0;
    if (!fFile || fFile->IsZombie()) {
@@ -2755,6 +2792,28 @@ void TChain::SetPacketSize(Int_t size)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the pre-opening of the next file of the chain in the
+/// background. When enabled, as soon as LoadTree() switches to a new file
+/// the following one is opened asynchronously (see TFile::AsyncOpen()), so
+/// that a sequential event loop finds the header of the next file already
+/// fetched when it crosses the file boundary. This mostly pays off for
+/// remote files, where a synchronous open stalls the loop for at least one
+/// network round trip. The file is only opened in advance: the tree and the
+/// branch addresses are still set up in LoadTree() when the boundary is
+/// actually crossed.
+
+void TChain::SetPreOpenNextFile(Bool_t on)
+{
+   if (!on && fPreOpenHandle) {
+      // Let a pending background open finish and close the file again.
+      TFile *prefile = TFile::Open(fPreOpenHandle);
+      fPreOpenHandle = 0;
+      delete prefile;
+   }
+   fPreOpenNextFile = on;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Enable/Disable PROOF processing on the current default Proof (gProof).
 ///
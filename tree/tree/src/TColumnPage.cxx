@@ -0,0 +1,201 @@
+// @(#)root/tree:$Id$
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TColumnPage
+One cluster worth of values of a single leaf, stored column-major.
+
+Where a basket stores the entries of a cluster interleaved with
+per-entry framing, a TColumnPage holds the values of one leaf for one
+cluster as a single run of fixed-stride raw values - the TTree
+equivalent of a Parquet column chunk. Variable-length arrays (leaves
+with a leaf count) get a separate offsets table with the cumulative
+value count at the start of each entry, so any entry range maps to one
+contiguous byte range of the data block.
+
+The values are kept in the on-disk (big-endian) byte order used
+everywhere else in ROOT I/O, so CopyEntries() is a single memcpy and
+delivers the same raw representation as TBranch::GetBulkEntries();
+byte swapping, where needed, is left to the consumer of the bulk range.
+
+Pages are produced and read back through TTreeColumnStore.
+*/
+
+#include "TColumnPage.h"
+#include "Bytes.h"
+#include "TError.h"
+#include <string.h>
+
+ClassImp(TColumnPage)
+
+namespace {
+   // Convert a run of values between host and on-disk (big-endian) order.
+   // A no-op on big-endian hosts.
+   void SwapValues(Char_t *data, Int_t nvalues, Int_t stride)
+   {
+#ifdef R__BYTESWAP
+      switch (stride) {
+      case 2: {
+         UShort_t *p = (UShort_t*)data;
+         for (Int_t i = 0; i < nvalues; ++i) p[i] = Rbswap_16(p[i]);
+         break;
+      }
+      case 4: {
+         UInt_t *p = (UInt_t*)data;
+         for (Int_t i = 0; i < nvalues; ++i) p[i] = Rbswap_32(p[i]);
+         break;
+      }
+      case 8: {
+         ULong64_t *p = (ULong64_t*)data;
+         for (Int_t i = 0; i < nvalues; ++i) p[i] = Rbswap_64(p[i]);
+         break;
+      }
+      default: // stride 1: nothing to swap
+         break;
+      }
+#else
+      (void) data; (void) nvalues; (void) stride;
+#endif
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor (for I/O).
+
+TColumnPage::TColumnPage() : fFirstEntry(0), fNEntries(0), fStride(0),
+   fValuesPerEntry(0), fNValues(0), fNBytes(0), fData(0), fNOffsets(0),
+   fOffsets(0), fCapacity(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an empty page for the leaf of branch branchname, starting at
+/// tree entry firstEntry. stride is the size in bytes of one value,
+/// valuesPerEntry the fixed number of values per entry or 0 for
+/// variable-length arrays (which get an offsets table). estEntries, when
+/// given, presizes the data block.
+
+TColumnPage::TColumnPage(const char *branchname, Long64_t firstEntry,
+                         Int_t stride, Int_t valuesPerEntry, Int_t estEntries)
+   : TNamed(branchname, "column page"),
+   fFirstEntry(firstEntry), fNEntries(0), fStride(stride),
+   fValuesPerEntry(valuesPerEntry), fNValues(0), fNBytes(0), fData(0),
+   fNOffsets(0), fOffsets(0), fCapacity(0)
+{
+   if (estEntries > 0) {
+      Int_t perEntry = valuesPerEntry > 0 ? valuesPerEntry : 1;
+      Reserve(estEntries * perEntry * stride);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TColumnPage::~TColumnPage()
+{
+   delete [] fData;
+   delete [] fOffsets;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure the data block can hold at least nbytes bytes.
+
+void TColumnPage::Reserve(Int_t nbytes)
+{
+   if (nbytes <= fCapacity) return;
+   Int_t newcap = fCapacity > 0 ? 2*fCapacity : 4096;
+   if (newcap < nbytes) newcap = nbytes;
+   Char_t *data = new Char_t[newcap];
+   if (fNBytes > 0) memcpy(data, fData, fNBytes);
+   delete [] fData;
+   fData = data;
+   fCapacity = newcap;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the nvalues values of the next entry. values points to the
+/// host-order values (e.g. the leaf value pointer); they are stored in
+/// on-disk byte order.
+
+void TColumnPage::AppendEntry(const void *values, Int_t nvalues)
+{
+   if (fValuesPerEntry > 0 && nvalues != fValuesPerEntry) {
+      Error("AppendEntry", "page %s expects %d values per entry, got %d",
+            GetName(), fValuesPerEntry, nvalues);
+      return;
+   }
+   if (fValuesPerEntry == 0) {
+      // Grow the offsets table; entry i spans values [fOffsets[i], fOffsets[i+1])
+      Long64_t *offsets = new Long64_t[fNEntries + 2];
+      if (fOffsets) {
+         memcpy(offsets, fOffsets, (fNEntries + 1) * sizeof(Long64_t));
+         delete [] fOffsets;
+      } else {
+         offsets[0] = 0;
+      }
+      offsets[fNEntries + 1] = fNValues + nvalues;
+      fOffsets = offsets;
+      fNOffsets = fNEntries + 2;
+   }
+   Reserve(fNBytes + nvalues * fStride);
+   memcpy(fData + fNBytes, values, nvalues * fStride);
+   SwapValues(fData + fNBytes, nvalues, fStride);
+   fNBytes += nvalues * fStride;
+   fNValues += nvalues;
+   ++fNEntries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cumulative value count at the start of entry fFirstEntry+i.
+
+Long64_t TColumnPage::GetEntryOffset(Int_t i) const
+{
+   if (fValuesPerEntry > 0) return (Long64_t)i * fValuesPerEntry;
+   return fOffsets ? fOffsets[i] : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of values of entry fFirstEntry+i.
+
+Int_t TColumnPage::GetEntryLength(Int_t i) const
+{
+   if (fValuesPerEntry > 0) return fValuesPerEntry;
+   return fOffsets ? (Int_t)(fOffsets[i+1] - fOffsets[i]) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the values of entries [firstEntry, firstEntry+n) into dest as a
+/// single memcpy and return the number of values copied (-1 when the
+/// range is not contained in this page). The values are delivered in
+/// on-disk (big-endian) byte order, like TBranch::GetBulkEntries().
+
+Int_t TColumnPage::CopyEntries(Long64_t firstEntry, Int_t n, void *dest) const
+{
+   if (firstEntry < fFirstEntry || firstEntry + n > fFirstEntry + fNEntries) {
+      Error("CopyEntries", "page %s holds entries [%lld, %lld), requested [%lld, %lld)",
+            GetName(), fFirstEntry, fFirstEntry + fNEntries, firstEntry, firstEntry + n);
+      return -1;
+   }
+   Int_t i = (Int_t)(firstEntry - fFirstEntry);
+   Long64_t firstValue = GetEntryOffset(i);
+   Long64_t nvalues = GetEntryOffset(i + n) - firstValue;
+   memcpy(dest, fData + firstValue * fStride, nvalues * fStride);
+   return (Int_t)nvalues;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the page layout.
+
+void TColumnPage::Print(Option_t *) const
+{
+   Printf("TColumnPage %s: entries [%lld, %lld), %d values, stride %d, %d bytes%s",
+          GetName(), fFirstEntry, fFirstEntry + fNEntries, fNValues, fStride,
+          fNBytes, fValuesPerEntry == 0 ? " (variable length)" : "");
+}
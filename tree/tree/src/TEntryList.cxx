@@ -55,6 +55,9 @@ End_Macro
 - __Subtract__() - if the lists are for the same TTree, removes the entries of the second
                list from the first list. If the lists are for TChains, loops over all
                sub-lists
+- __Intersect__() - if the lists are for the same TTree, only keeps the entries that
+               are also present in the second list. If the lists are for TChains,
+               loops over all sub-lists
 - __GetEntry(n)__ - returns the n-th entry number
 - __Next__()      - returns next entry number. Note, that this function is
                 much faster than GetEntry, and it's called when GetEntry() is called
@@ -1216,6 +1219,101 @@ void TEntryList::SetTree(const TTree *tree)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Only keep the entries of this entry list that are also contained in elist.
+/// The intersection is computed block by block with a word-at-a-time AND (see
+/// TEntryListBlock::Intersect()), which is much faster than testing the
+/// entries one by one.
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   if (!elist) return;
+   TEntryList *templist = 0;
+   if (!fLists){
+      if (!fBlocks) return;
+      //check if lists are for the same tree
+      if (!elist->fLists){
+         //second list is also only for 1 tree
+         if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(elist->fFileName.Data(),fFileName.Data())){
+            //same tree, intersect block by block
+            TEntryListBlock *block1 = 0;
+            TEntryListBlock *block2 = 0;
+            Int_t nmin = 0;
+            if (elist->fBlocks)
+               nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            Int_t i;
+            Long64_t nold;
+            for (i=0; i<nmin; i++){
+               block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               nold = block1->GetNPassed();
+               fN = fN - nold + block1->Intersect(block2);
+            }
+            //the blocks after the end of the second list have an empty intersection
+            for (i=fNBlocks-1; i>=nmin; i--){
+               block1 = (TEntryListBlock*)fBlocks->RemoveAt(i);
+               if (block1){
+                  fN -= block1->GetNPassed();
+                  delete block1;
+               }
+            }
+            fNBlocks = nmin;
+            if (fNBlocks==0){
+               delete fBlocks;
+               fBlocks = 0;
+            }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
+         } else {
+            //lists are for different trees - the intersection is empty
+            fBlocks->Delete();
+            delete fBlocks;
+            fBlocks = 0;
+            fNBlocks = 0;
+            fN = 0;
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
+         }
+      } else {
+         //second list has sublists, try to find one for the same tree as this list
+         TIter next1(elist->GetLists());
+         templist = 0;
+         Bool_t found = kFALSE;
+         while ((templist = (TEntryList*)next1())){
+            if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+                !strcmp(templist->fFileName.Data(),fFileName.Data())){
+               found = kTRUE;
+               break;
+            }
+         }
+         if (found) {
+            Intersect(templist);
+         } else {
+            //no sublist for this tree - the intersection is empty
+            fBlocks->Delete();
+            delete fBlocks;
+            fBlocks = 0;
+            fNBlocks = 0;
+            fN = 0;
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
+         }
+      }
+   } else {
+      //this list has sublists
+      TIter next2(fLists);
+      templist = 0;
+      Long64_t oldn=0;
+      while ((templist = (TEntryList*)next2())){
+         oldn = templist->GetN();
+         templist->Intersect(elist);
+         fN = fN - oldn + templist->GetN();
+      }
+   }
+   return;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove all the entries of this entry list, that are contained in elist
 
@@ -1229,12 +1327,20 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (elist->fBlocks){
+               TEntryListBlock *block1 = 0;
+               TEntryListBlock *block2 = 0;
+               Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+               Long64_t nold;
+               for (Int_t i=0; i<nmin; i++){
+                  block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+                  block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+                  nold = block1->GetNPassed();
+                  fN = fN - nold + block1->Subtract(block2);
+               }
+               fLastIndexQueried = -1;
+               fLastIndexReturned = 0;
             }
          } else {
             //different trees
@@ -38,6 +38,10 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Intersect__() - only keeps the entries that are also present in the other
+                 block (bitwise AND, done one 16-bit word at a time)
+ - __Subtract__()  - removes the entries that are present in the other block
+                 (bitwise AND-NOT, done one 16-bit word at a time)
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
@@ -242,7 +246,7 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
@@ -259,36 +263,17 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
       return fNPassed;
    }
    if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
-         }
+      //this block is stored as bits: merge one 16-bit word at a time
+      UShort_t *otherbits = new UShort_t[kBlockSize];
+      block->FillBitmap(otherbits);
+      Int_t npassed = 0;
+      for (i=0; i<kBlockSize; i++){
+         UShort_t bits = fIndices[i] | otherbits[i];
+         fIndices[i] = bits;
+         while (bits) { bits &= bits-1; npassed++; }
       }
+      delete [] otherbits;
+      fNPassed = npassed;
    } else {
       //stored as a list
       if (GetNPassed() + block->GetNPassed() > kBlockSize){
@@ -363,6 +348,107 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array bits (of kBlockSize UShort_t words) with the bits
+/// representation of this block, whatever the current representation is.
+/// This block itself is not modified, only the internal fCurrent may move.
+
+void TEntryListBlock::FillBitmap(UShort_t *bits)
+{
+   Int_t i, ibite, ibit;
+   if (fType==0 && fIndices){
+      //already bits
+      for (i=0; i<kBlockSize; i++)
+         bits[i] = fIndices[i];
+      return;
+   }
+   if (fPassing){
+      //a list of the entries that pass (an empty list if fIndices=0)
+      for (i=0; i<kBlockSize; i++)
+         bits[i] = 0;
+      if (!fIndices) return;
+      for (i=0; i<fNPassed; i++){
+         ibite = fIndices[i]>>4;
+         ibit = fIndices[i] & 15;
+         bits[ibite] |= 1<<ibit;
+      }
+   } else {
+      //a list of the entries that don't pass (all entries pass if fIndices=0)
+      for (i=0; i<kBlockSize; i++)
+         bits[i] = 65535;
+      if (!fIndices) return;
+      for (i=0; i<fNPassed; i++){
+         ibite = fIndices[i]>>4;
+         ibit = fIndices[i] & 15;
+         bits[ibite] &= (0xFFFF^(1<<ibit));
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Only keep the entries that are also present in the other block (AND).
+/// The AND is computed one 16-bit word at a time, whatever the representations
+/// of the 2 blocks are - the blocks are transformed to bits when needed.
+/// Returns the resulting number of entries in the block.
+
+Int_t TEntryListBlock::Intersect(TEntryListBlock *block)
+{
+   Int_t i;
+   if (GetNPassed() == 0) return 0;
+   if (fType!=0){
+      //change to bits
+      UShort_t *bits = new UShort_t[kBlockSize];
+      Transform(1, bits);
+   }
+   UShort_t *otherbits = new UShort_t[kBlockSize];
+   block->FillBitmap(otherbits);
+   Int_t npassed = 0;
+   for (i=0; i<kBlockSize; i++){
+      UShort_t bits = fIndices[i] & otherbits[i];
+      fIndices[i] = bits;
+      while (bits) { bits &= bits-1; npassed++; }
+   }
+   delete [] otherbits;
+   fNPassed = npassed;
+   fCurrent = 0;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries that are present in the other block (AND-NOT).
+/// Computed one 16-bit word at a time, like Intersect().
+/// Returns the resulting number of entries in the block.
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   Int_t i;
+   if (GetNPassed() == 0) return 0;
+   if (block->GetNPassed() == 0) return GetNPassed();
+   if (fType!=0){
+      //change to bits
+      UShort_t *bits = new UShort_t[kBlockSize];
+      Transform(1, bits);
+   }
+   UShort_t *otherbits = new UShort_t[kBlockSize];
+   block->FillBitmap(otherbits);
+   Int_t npassed = 0;
+   for (i=0; i<kBlockSize; i++){
+      UShort_t bits = fIndices[i] & ~otherbits[i];
+      fIndices[i] = bits;
+      while (bits) { bits &= bits-1; npassed++; }
+   }
+   delete [] otherbits;
+   fNPassed = npassed;
+   fCurrent = 0;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
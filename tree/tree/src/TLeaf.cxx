@@ -24,6 +24,7 @@ See TBranch structure in TTree.
 #include "TClass.h"
 
 #include <ctype.h>
+#include <math.h>
 
 ClassImp(TLeaf)
 
@@ -39,6 +40,10 @@ TLeaf::TLeaf()
    , fIsUnsigned(kFALSE)
    , fLeafCount(0)
    , fBranch(0)
+   , fQuantizeRel(0)
+   , fQuantizeAbs(0)
+   , fQuantizeBuffer(0)
+   , fQuantizeBufferSize(0)
 {
 }
 
@@ -57,6 +62,10 @@ TLeaf::TLeaf(TBranch *parent, const char* name, const char *)
    , fIsUnsigned(kFALSE)
    , fLeafCount(0)
    , fBranch(parent)
+   , fQuantizeRel(0)
+   , fQuantizeAbs(0)
+   , fQuantizeBuffer(0)
+   , fQuantizeBufferSize(0)
 {
    fLeafCount = GetLeafCounter(fLen);
 
@@ -81,7 +90,11 @@ TLeaf::TLeaf(const TLeaf& lf) :
   fIsRange(lf.fIsRange),
   fIsUnsigned(lf.fIsUnsigned),
   fLeafCount(lf.fLeafCount),
-  fBranch(lf.fBranch)
+  fBranch(lf.fBranch),
+  fQuantizeRel(lf.fQuantizeRel),
+  fQuantizeAbs(lf.fQuantizeAbs),
+  fQuantizeBuffer(0),
+  fQuantizeBufferSize(0)
 {
 }
 
@@ -100,6 +113,8 @@ TLeaf& TLeaf::operator=(const TLeaf& lf)
       fIsUnsigned=lf.fIsUnsigned;
       fLeafCount=lf.fLeafCount;
       fBranch=lf.fBranch;
+      fQuantizeRel=lf.fQuantizeRel;
+      fQuantizeAbs=lf.fQuantizeAbs;
    }
    return *this;
 }
@@ -118,6 +133,8 @@ TLeaf::~TLeaf()
       }
    }
    fLeafCount = 0;
+   delete [] fQuantizeBuffer;
+   fQuantizeBuffer = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -380,3 +397,113 @@ void TLeaf::Streamer(TBuffer &b)
    }
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable on-write quantization of this leaf's values.
+///
+/// Floating point values are rounded before being written to the basket
+/// so that they carry only as many mantissa bits as the requested
+/// tolerance needs; the zeroed low bits make the baskets compress much
+/// better and the stored value stays an ordinary float/double, read back
+/// without any special handling. relTol bounds the relative rounding
+/// error (e.g. 1e-3 keeps 10 mantissa bits), absTol the absolute one;
+/// the least demanding enabled bound is applied per value. Pass 0 for
+/// both to switch quantization off. Only floating point leaves (TLeafF,
+/// TLeafD) honor the setting.
+
+void TLeaf::SetPrecision(Double_t relTol, Double_t absTol)
+{
+   if (relTol < 0 || absTol < 0) {
+      Error("SetPrecision", "tolerances must be positive (rel=%g, abs=%g)", relTol, absTol);
+      return;
+   }
+   fQuantizeRel = relTol;
+   fQuantizeAbs = absTol;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a scratch buffer of at least nbytes for the quantized copy of
+/// one entry (FillBasket must not modify the user's values in place).
+
+void *TLeaf::GetQuantizeScratch(Int_t nbytes)
+{
+   if (nbytes > fQuantizeBufferSize) {
+      delete [] fQuantizeBuffer;
+      fQuantizeBuffer = new char[nbytes];
+      fQuantizeBufferSize = nbytes;
+   }
+   return fQuantizeBuffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Round n floats in place to the coarsest representation satisfying the
+/// enabled error bounds. Non-finite values are left untouched.
+
+void TLeaf::QuantizeFloats(Float_t *values, Int_t n, Double_t relTol, Double_t absTol)
+{
+   Int_t keep = 23;
+   if (relTol > 0) {
+      keep = (Int_t) ceil(-log2(relTol));
+      if (keep > 23) keep = 23;
+      if (keep < 1)  keep = 1;
+   }
+   const UInt_t shift = 23 - keep;
+   const UInt_t mask  = ~((1u << shift) - 1);
+
+   // Power-of-two grid not larger than the absolute tolerance.
+   Double_t grid = 0;
+   if (absTol > 0) grid = pow(2.0, floor(log2(absTol)));
+
+   for (Int_t i = 0; i < n; ++i) {
+      Float_t v = values[i];
+      if (v != v || v*0 != 0) continue; // NaN or Inf
+      // Absolute bound: values below the grid round to multiples of it.
+      if (grid > 0 && fabs(v) < grid * 8388608.) {
+         v = (Float_t)(grid * nearbyint(v / grid));
+      }
+      // Relative bound: round-to-nearest then drop the low mantissa bits.
+      if (relTol > 0 && shift > 0) {
+         union { Float_t f; UInt_t u; } w;
+         w.f = v;
+         w.u += 1u << (shift - 1);
+         w.u &= mask;
+         v = w.f;
+      }
+      values[i] = v;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Round n doubles in place to the coarsest representation satisfying
+/// the enabled error bounds. Non-finite values are left untouched.
+
+void TLeaf::QuantizeDoubles(Double_t *values, Int_t n, Double_t relTol, Double_t absTol)
+{
+   Int_t keep = 52;
+   if (relTol > 0) {
+      keep = (Int_t) ceil(-log2(relTol));
+      if (keep > 52) keep = 52;
+      if (keep < 1)  keep = 1;
+   }
+   const ULong64_t shift = 52 - keep;
+   const ULong64_t mask  = ~((1ULL << shift) - 1);
+
+   Double_t grid = 0;
+   if (absTol > 0) grid = pow(2.0, floor(log2(absTol)));
+
+   for (Int_t i = 0; i < n; ++i) {
+      Double_t v = values[i];
+      if (v != v || v*0 != 0) continue; // NaN or Inf
+      if (grid > 0 && fabs(v) < grid * 4503599627370496.) {
+         v = grid * nearbyint(v / grid);
+      }
+      if (relTol > 0 && shift > 0) {
+         union { Double_t f; ULong64_t u; } w;
+         w.f = v;
+         w.u += 1ULL << (shift - 1);
+         w.u &= mask;
+         v = w.f;
+      }
+      values[i] = v;
+   }
+}
@@ -18,6 +18,8 @@ A TLeaf for a 64 bit floating point data type.
 #include "TLeafD.h"
 #include "TBranch.h"
 #include "TBuffer.h"
+#include "Byteswap.h"
+#include <string.h>
 #include "TClonesArray.h"
 #include "Riostream.h"
 
@@ -75,6 +77,15 @@ void TLeafD::FillBasket(TBuffer &b)
 {
    Int_t len = GetLen();
    if (fPointer) fValue = *fPointer;
+   if (IsQuantized()) {
+      // Round a copy (never the user's values) to the requested precision
+      // before writing; see TLeaf::SetPrecision.
+      Double_t *scratch = (Double_t*) GetQuantizeScratch(len * sizeof(Double_t));
+      memcpy(scratch, fValue, len * sizeof(Double_t));
+      QuantizeDoubles(scratch, len, fQuantizeRel, fQuantizeAbs);
+      b.WriteFastArray(scratch, len);
+      return;
+   }
    b.WriteFastArray(fValue,len);
 }
 
@@ -129,6 +140,25 @@ void TLeafD::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize nentries of the basket in one pass, starting at the current
+/// buffer position. The byte swap is done over the whole payload instead of
+/// with one TBuffer call per entry; the values stay in the basket buffer.
+/// Returns kFALSE when this leaf cannot use the fast path (variable size).
+
+Bool_t TLeafD::ReadBasketFast(TBuffer &b, Long64_t nentries)
+{
+   if (R__unlikely(fLeafCount)) return kFALSE;
+#ifdef R__BYTESWAP
+   ULong64_t *buf = reinterpret_cast<ULong64_t*>(b.Buffer() + b.Length());
+   Long64_t len = nentries*fLen;
+   for (Long64_t idx = 0; idx < len; ++idx) {
+      buf[idx] = Rbswap_64(buf[idx]);
+   }
+#endif
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
@@ -18,6 +18,8 @@ A TLeaf for a 32 bit floating point data type.
 #include "TLeafF.h"
 #include "TBranch.h"
 #include "TBuffer.h"
+#include "Byteswap.h"
+#include <string.h>
 #include "TClonesArray.h"
 #include "Riostream.h"
 
@@ -79,6 +81,15 @@ void TLeafF::FillBasket(TBuffer &b)
 {
    Int_t len = GetLen();
    if (fPointer) fValue = *fPointer;
+   if (IsQuantized()) {
+      // Round a copy (never the user's values) to the requested precision
+      // before writing; see TLeaf::SetPrecision.
+      Float_t *scratch = (Float_t*) GetQuantizeScratch(len * sizeof(Float_t));
+      memcpy(scratch, fValue, len * sizeof(Float_t));
+      QuantizeFloats(scratch, len, fQuantizeRel, fQuantizeAbs);
+      b.WriteFastArray(scratch, len);
+      return;
+   }
    b.WriteFastArray(fValue,len);
 }
 
@@ -133,6 +144,25 @@ void TLeafF::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize nentries of the basket in one pass, starting at the current
+/// buffer position. The byte swap is done over the whole payload instead of
+/// with one TBuffer call per entry; the values stay in the basket buffer.
+/// Returns kFALSE when this leaf cannot use the fast path (variable size).
+
+Bool_t TLeafF::ReadBasketFast(TBuffer &b, Long64_t nentries)
+{
+   if (R__unlikely(fLeafCount)) return kFALSE;
+#ifdef R__BYTESWAP
+   UInt_t *buf = reinterpret_cast<UInt_t*>(b.Buffer() + b.Length());
+   Long64_t len = nentries*fLen;
+   for (Long64_t idx = 0; idx < len; ++idx) {
+      buf[idx] = Rbswap_32(buf[idx]);
+   }
+#endif
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
@@ -18,6 +18,7 @@ A TLeaf for an Integer data type.
 #include "TLeafI.h"
 #include "TBranch.h"
 #include "TBuffer.h"
+#include "Byteswap.h"
 #include "TClonesArray.h"
 #include "Riostream.h"
 
@@ -166,6 +167,25 @@ void TLeafI::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize nentries of the basket in one pass, starting at the current
+/// buffer position. The byte swap is done over the whole payload instead of
+/// with one TBuffer call per entry; the values stay in the basket buffer.
+/// Returns kFALSE when this leaf cannot use the fast path (variable size).
+
+Bool_t TLeafI::ReadBasketFast(TBuffer &b, Long64_t nentries)
+{
+   if (R__unlikely(fLeafCount)) return kFALSE;
+#ifdef R__BYTESWAP
+   UInt_t *buf = reinterpret_cast<UInt_t*>(b.Buffer() + b.Length());
+   Long64_t len = nentries*fLen;
+   for (Long64_t idx = 0; idx < len; ++idx) {
+      buf[idx] = Rbswap_32(buf[idx]);
+   }
+#endif
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
@@ -18,6 +18,7 @@ A TLeaf for a 64 bit Integer data type.
 #include "TLeafL.h"
 #include "TBranch.h"
 #include "TBuffer.h"
+#include "Byteswap.h"
 #include "TClonesArray.h"
 #include "Riostream.h"
 
@@ -177,6 +178,25 @@ void TLeafL::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize nentries of the basket in one pass, starting at the current
+/// buffer position. The byte swap is done over the whole payload instead of
+/// with one TBuffer call per entry; the values stay in the basket buffer.
+/// Returns kFALSE when this leaf cannot use the fast path (variable size).
+
+Bool_t TLeafL::ReadBasketFast(TBuffer &b, Long64_t nentries)
+{
+   if (R__unlikely(fLeafCount)) return kFALSE;
+#ifdef R__BYTESWAP
+   ULong64_t *buf = reinterpret_cast<ULong64_t*>(b.Buffer() + b.Length());
+   Long64_t len = nentries*fLen;
+   for (Long64_t idx = 0; idx < len; ++idx) {
+      buf[idx] = Rbswap_64(buf[idx]);
+   }
+#endif
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
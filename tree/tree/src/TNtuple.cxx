@@ -19,6 +19,7 @@
 #include "TClass.h"
 #include "TreeUtils.h"
 
+#include <cstring>
 #include <string>
 
 ClassImp(TNtuple)
@@ -48,6 +49,13 @@ TNtuple::TNtuple(): TTree()
 {
    fNvar = 0;
    fArgs = 0;
+   fRowRing = 0;
+   fRowScratch = 0;
+   fRingRows = 0;
+   fRingHead = 0;
+   fRingTail = 0;
+   fRingStop = false;
+   fRingThread = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +78,13 @@ TNtuple::TNtuple(const char *name, const char *title, const char *varlist, Int_t
    Int_t i;
    fNvar = 0;
    fArgs = 0;
+   fRowRing = 0;
+   fRowScratch = 0;
+   fRingRows = 0;
+   fRingHead = 0;
+   fRingTail = 0;
+   fRingStop = false;
+   fRingThread = 0;
 
 //   Count number of variables (separated by :)
    Int_t nch = strlen(varlist);
@@ -103,6 +118,7 @@ TNtuple::TNtuple(const char *name, const char *title, const char *varlist, Int_t
 
 TNtuple::~TNtuple()
 {
+   DrainRowLog();
    delete [] fArgs;
    fArgs = 0;
 }
@@ -177,6 +193,18 @@ Int_t TNtuple::Fill()
 
 Int_t TNtuple::Fill(const Float_t *x)
 {
+   if (fRowRing) {
+      // Row-log mode: append the row to the ring and return; the logger
+      // thread owns fArgs and the branch machinery. Single producer.
+      Long64_t head = fRingHead.load(std::memory_order_relaxed);
+      while (head - fRingTail.load(std::memory_order_acquire) >= fRingRows) {
+         // Ring full: the logger is behind (typically flushing a cluster).
+         std::this_thread::yield();
+      }
+      memcpy(&fRowRing[(head % fRingRows) * fNvar], x, fNvar*sizeof(Float_t));
+      fRingHead.store(head + 1, std::memory_order_release);
+      return (Int_t)(fNvar*sizeof(Float_t));
+   }
 
    // Store array x into buffer
    for (Int_t i=0;i<fNvar;i++)  {
@@ -193,25 +221,120 @@ Int_t TNtuple::Fill(Float_t x0,Float_t x1,Float_t x2,Float_t x3,Float_t x4
               ,Float_t x5,Float_t x6,Float_t x7,Float_t x8,Float_t x9
               ,Float_t x10,Float_t x11,Float_t x12,Float_t x13,Float_t x14)
 {
-   if (fNvar >  0) fArgs[0]  = x0;
-   if (fNvar >  1) fArgs[1]  = x1;
-   if (fNvar >  2) fArgs[2]  = x2;
-   if (fNvar >  3) fArgs[3]  = x3;
-   if (fNvar >  4) fArgs[4]  = x4;
-   if (fNvar >  5) fArgs[5]  = x5;
-   if (fNvar >  6) fArgs[6]  = x6;
-   if (fNvar >  7) fArgs[7]  = x7;
-   if (fNvar >  8) fArgs[8]  = x8;
-   if (fNvar >  9) fArgs[9]  = x9;
-   if (fNvar > 10) fArgs[10] = x10;
-   if (fNvar > 11) fArgs[11] = x11;
-   if (fNvar > 12) fArgs[12] = x12;
-   if (fNvar > 13) fArgs[13] = x13;
-   if (fNvar > 14) fArgs[14] = x14;
+   Float_t *dest = fRowRing ? fRowScratch : fArgs;
+   if (fNvar >  0) dest[0]  = x0;
+   if (fNvar >  1) dest[1]  = x1;
+   if (fNvar >  2) dest[2]  = x2;
+   if (fNvar >  3) dest[3]  = x3;
+   if (fNvar >  4) dest[4]  = x4;
+   if (fNvar >  5) dest[5]  = x5;
+   if (fNvar >  6) dest[6]  = x6;
+   if (fNvar >  7) dest[7]  = x7;
+   if (fNvar >  8) dest[8]  = x8;
+   if (fNvar >  9) dest[9]  = x9;
+   if (fNvar > 10) dest[10] = x10;
+   if (fNvar > 11) dest[11] = x11;
+   if (fNvar > 12) dest[12] = x12;
+   if (fNvar > 13) dest[13] = x13;
+   if (fNvar > 14) dest[14] = x14;
+
+   if (fRowRing) return Fill(fRowScratch);
 
    return TTree::Fill();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable (nrows > 0) or disable (nrows <= 0) the append-optimized row-log
+/// mode. While the mode is active, Fill() only copies the row into a
+/// lock-free ring of nrows rows and returns immediately; a background
+/// logger thread columnarizes the rows through the regular branch
+/// machinery, so basket compression and cluster flushes happen off the
+/// producer's critical path. With the default ring of 65536 rows a
+/// producer is only ever delayed when it outruns compression and I/O for
+/// the whole depth of the ring.
+///
+/// There must be a single producer, and while the mode is active the
+/// producer may only call Fill(); any other access to the ntuple (Write,
+/// GetEntries, drawing, ...) requires calling DrainRowLog() first - Write
+/// and the destructor drain automatically. The mode applies to the Fill
+/// overloads, not to ReadStream.
+
+void TNtuple::SetRowLogMode(Int_t nrows)
+{
+   DrainRowLog();
+   if (nrows <= 0 || fNvar <= 0) return;
+
+   fRingRows   = nrows;
+   fRowRing    = new Float_t[(size_t)nrows * fNvar];
+   fRowScratch = new Float_t[fNvar];
+   fRingHead   = 0;
+   fRingTail   = 0;
+   fRingStop   = false;
+   fRingThread = new std::thread(&TNtuple::RowLogLoop, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Columnarize the pending rows of the ring and leave row-log mode. After
+/// the call the ntuple behaves like a regular TNtuple again; all rows
+/// appended by Fill() are in the tree. No-op when the mode is not active.
+
+void TNtuple::DrainRowLog()
+{
+   if (!fRingThread) return;
+
+   fRingStop.store(true, std::memory_order_release);
+   fRingThread->join();
+   delete fRingThread;
+   fRingThread = 0;
+   delete [] fRowRing;
+   fRowRing = 0;
+   delete [] fRowScratch;
+   fRowScratch = 0;
+   fRingRows = 0;
+   fRingStop = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Body of the logger thread: pop rows from the ring into fArgs and run
+/// them through TTree::Fill, which does the columnarization, the basket
+/// compression and the cluster flushes. Exits once asked to stop and the
+/// ring is empty.
+
+void TNtuple::RowLogLoop()
+{
+   for (;;) {
+      Long64_t tail = fRingTail.load(std::memory_order_relaxed);
+      if (tail == fRingHead.load(std::memory_order_acquire)) {
+         if (fRingStop.load(std::memory_order_acquire) &&
+             tail == fRingHead.load(std::memory_order_acquire)) break;
+         std::this_thread::yield();
+         continue;
+      }
+      memcpy(fArgs, &fRowRing[(tail % fRingRows) * fNvar], fNvar*sizeof(Float_t));
+      TTree::Fill();
+      fRingTail.store(tail + 1, std::memory_order_release);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write this ntuple to the current directory, draining the row log first
+/// so that every appended row is part of what is written.
+
+Int_t TNtuple::Write(const char *name, Int_t option, Int_t bufsize)
+{
+   DrainRowLog();
+   return TTree::Write(name, option, bufsize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write this ntuple to the current directory. See the non-const Write().
+
+Int_t TNtuple::Write(const char *name, Int_t option, Int_t bufsize) const
+{
+   const_cast<TNtuple*>(this)->DrainRowLog();
+   return TTree::Write(name, option, bufsize);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read from filename as many columns as variables in the ntuple
 /// the function returns the number of rows found in the file
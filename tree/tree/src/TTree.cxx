@@ -336,6 +336,7 @@ End_Macro
 #include "RConfig.h"
 #include "TTree.h"
 
+#include "Compression.h"
 #include "TArrayC.h"
 #include "TBufferFile.h"
 #include "TBaseClass.h"
@@ -375,13 +376,17 @@ End_Macro
 #include "TROOT.h"
 #include "TRealData.h"
 #include "TRegexp.h"
+#include "TSQLResult.h"
 #include "TStreamerElement.h"
 #include "TStreamerInfo.h"
+#include "TStringInterner.h"
 #include "TStyle.h"
 #include "TSystem.h"
+#include "TObjString.h"
 #include "TTreeCloner.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
+#include "TTreeRangeSummary.h"
 #include "TVirtualCollectionProxy.h"
 #include "TEmulatedCollectionProxy.h"
 #include "TVirtualFitter.h"
@@ -401,6 +406,7 @@ End_Macro
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <stdio.h>
 #include <limits.h>
 
@@ -703,6 +709,7 @@ TTree::TTree()
 , fCacheDoAutoInit(kTRUE)
 , fCacheUserSet(kFALSE)
 , fIMTEnabled(ROOT::IsImplicitMTEnabled())
+, fAsyncWrite(kFALSE)
 , fNEntriesSinceSorting(0)
 {
    fMaxEntries = 1000000000;
@@ -781,6 +788,7 @@ TTree::TTree(const char* name, const char* title, Int_t splitlevel /* = 99 */)
 , fCacheDoAutoInit(kTRUE)
 , fCacheUserSet(kFALSE)
 , fIMTEnabled(ROOT::IsImplicitMTEnabled())
+, fAsyncWrite(kFALSE)
 , fNEntriesSinceSorting(0)
 {
    // TAttLine state.
@@ -827,6 +835,12 @@ TTree::TTree(const char* name, const char* title, Int_t splitlevel /* = 99 */)
 
 TTree::~TTree()
 {
+   if (fAsyncWriteHelper) {
+      // Make sure no asynchronous basket write still references our branches.
+      WaitForAsyncWrites();
+      delete fAsyncWriteHelper;
+      fAsyncWriteHelper = 0;
+   }
    if (fDirectory) {
       // We are in a directory, which may possibly be a file.
       if (fDirectory->GetList()) {
@@ -1336,6 +1350,8 @@ TFriendElement* TTree::AddFriend(TTree* tree, const char* alias, Bool_t warn)
 Long64_t TTree::AutoSave(Option_t* option)
 {
    if (!fDirectory || fDirectory == gROOT || !fDirectory->IsWritable()) return 0;
+   // The header we are about to write must describe settled baskets.
+   WaitForAsyncWrites();
    if (gDebug > 0) {
       Info("AutoSave", "Tree:%s after %lld bytes written\n",GetName(),GetTotBytes());
    }
@@ -3340,6 +3356,13 @@ namespace {
 /// done without unzipping or unstreaming the baskets (i.e., a direct copy of the
 /// raw bytes on disk).
 ///
+/// When 'fast' is specified and the input tree has an associated TEntryList
+/// (see TTree::SetEntryList), the raw basket copy is still used for every
+/// (sub-)tree in which the entry list selects all the entries; the entries of
+/// partially selected sub-trees are unstreamed and refilled individually.
+/// For skims that keep whole files of a chain this avoids decompressing and
+/// recompressing the bulk of the data.
+///
 /// When 'fast' is specified, 'option' can also contains a sorting order for the
 /// baskets in the output file.
 ///
@@ -3409,6 +3432,8 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
       nentries = treeEntries;
    }
 
+   TEntryList *selectedList = fastClone ? tree->GetEntryList() : 0;
+
    if (fastClone && (nentries < 0 || nentries == tree->GetEntriesFast())) {
       // Quickly copy the basket without decompression and streaming.
       Long64_t totbytes = GetTotBytes();
@@ -3416,6 +3441,36 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
          if (tree->LoadTree(i) < 0) {
             break;
          }
+         if (selectedList) {
+            // An entry list filters this copy: the raw basket copy is only
+            // valid for a sub-tree in which every entry is selected.
+            selectedList->SetTree(tree->GetTree());
+            TEntryList *localList = selectedList;
+            if (selectedList->GetLists() && selectedList->GetCurrentList()) {
+               localList = selectedList->GetCurrentList();
+            }
+            Long64_t localEntries = tree->GetTree()->GetEntries();
+            Long64_t nselected = localList->GetN();
+            if (nselected == 0) {
+               continue;
+            }
+            if (nselected < localEntries) {
+               // Re-pack the selected entries of this partially selected
+               // sub-tree one by one; its index (if any) is not merged since
+               // it would describe entries that are not copied.
+               TTree *localtree = tree->GetTree();
+               for (Long64_t ii = 0; ii < localEntries; ++ii) {
+                  if (!selectedList->Contains(ii)) {
+                     continue;
+                  }
+                  if (localtree->GetEntry(ii) <= 0) {
+                     break;
+                  }
+                  this->Fill();
+               }
+               continue;
+            }
+         }
          if ( withIndex ) {
             withIndex = R__HandleIndex( onIndexError, this, tree );
          }
@@ -4370,6 +4425,13 @@ void TTree::DropBuffers(Int_t)
 /// Note that calling FlushBaskets too often increases the IO time.
 ///
 /// Note that calling AutoSave too often increases the IO time and also the file size.
+///
+/// When the tree has the TTree::kOnlyFlushAtCluster bit set and fAutoFlush is
+/// a (positive) number of entries, a basket filling up in the middle of a
+/// cluster is grown in memory instead of being written out: all branches then
+/// close their baskets together at the cluster boundary, which keeps the
+/// baskets of one cluster contiguous on disk and avoids over-reading in
+/// TTreeCache at the cost of a larger write-time memory footprint.
 
 Int_t TTree::Fill()
 {
@@ -4387,11 +4449,25 @@ Int_t TTree::Fill()
    }
 
    ROOT::Internal::TBranchIMTHelper imtHelper;
+   ROOT::Internal::TBranchIMTHelper *fillHelper = &imtHelper;
    #ifdef R__USE_IMT
+   Bool_t asyncWrite = kFALSE;
    if (fIMTEnabled) {
+      asyncWrite = fAsyncWrite;
+      if (asyncWrite) {
+         // Route the basket writes through a helper that outlives this call,
+         // so that compression can proceed while the next entries are filled
+         // (see SetAsyncWrite).
+         if (!fAsyncWriteHelper) fAsyncWriteHelper = new ROOT::Internal::TBranchIMTHelper;
+         fillHelper = fAsyncWriteHelper;
+      }
       fIMTFlush = true;
-      fIMTZipBytes.store(0);
-      fIMTTotBytes.store(0);
+      if (!asyncWrite) {
+         // In asynchronous mode writes from a previous Fill may still be
+         // counting: the counters are only reset in WaitForAsyncWrites.
+         fIMTZipBytes.store(0);
+         fIMTTotBytes.store(0);
+      }
    }
    #endif
 
@@ -4401,7 +4477,7 @@ Int_t TTree::Fill()
       if (branch->TestBit(kDoNotProcess)) {
          continue;
       }
-      Int_t nwrite = branch->FillImpl(fIMTEnabled ? &imtHelper : nullptr);
+      Int_t nwrite = branch->FillImpl(fIMTEnabled ? fillHelper : nullptr);
       if (nwrite < 0)  {
          if (nerror < 2) {
             Error("Fill", "Failed filling branch:%s.%s, nbytes=%d, entry=%lld\n"
@@ -4422,7 +4498,7 @@ Int_t TTree::Fill()
       }
    }
    #ifdef R__USE_IMT
-   if (fIMTFlush) {
+   if (fIMTFlush && !asyncWrite) {
       imtHelper.Wait();
       fIMTFlush = false;
       const_cast<TTree*>(this)->AddTotBytes(fIMTTotBytes);
@@ -4430,8 +4506,16 @@ Int_t TTree::Fill()
       nbytes += imtHelper.GetNbytes();
       nerror += imtHelper.GetNerrors();
    }
+   // In asynchronous mode fIMTFlush stays true: the writes still in flight
+   // keep adding to the atomic counters, which are folded into the totals
+   // by WaitForAsyncWrites (called e.g. when the baskets are flushed).
    #endif
 
+   if (fRangeSummary) {
+      // record min/max/sum of the designated branches (see SetRangeSummaryBranches)
+      fRangeSummary->Accumulate();
+   }
+
    if (fBranchRef) {
       fBranchRef->Fill();
    }
@@ -4823,11 +4907,68 @@ struct BoolRAIIToggle {
 };
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable asynchronous basket writes during Fill.
+///
+/// When enabled (and implicit multi-threading is active for this tree, see
+/// SetImplicitMT), a basket that fills up during Fill is swapped with a
+/// standby basket and handed to a task that compresses and writes it in the
+/// background, so Fill returns without waiting for the compression to finish.
+/// A branch only stalls if its previous basket is still being written when
+/// the next one fills up. The pending writes are completed and the byte
+/// counters settled whenever the tree flushes its baskets, auto-saves or is
+/// deleted; call WaitForAsyncWrites() before reading back freshly written
+/// entries. This mode is intended for latency-critical writers (e.g. online
+/// event recording) where the worst-case Fill time matters more than the
+/// aggregate throughput.
+
+void TTree::SetAsyncWrite(Bool_t enable)
+{
+#ifdef R__USE_IMT
+   if (enable && !fIMTEnabled) {
+      Warning("SetAsyncWrite", "asynchronous basket writes require implicit multi-threading for this tree, see TTree::SetImplicitMT");
+   }
+   if (!enable) {
+      WaitForAsyncWrites();
+   }
+   fAsyncWrite = enable;
+#else
+   if (enable) {
+      Warning("SetAsyncWrite", "asynchronous basket writes are only available when ROOT is built with implicit multi-threading support");
+   }
+   fAsyncWrite = kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until all basket writes dispatched by Fill in asynchronous mode (see
+/// SetAsyncWrite) have reached the file and fold their byte counts into the
+/// tree totals. Called automatically before the baskets are flushed, before
+/// AutoSave writes the tree header and in the destructor; call it explicitly
+/// before reading back entries that were just written.
+
+void TTree::WaitForAsyncWrites()
+{
+   if (!fAsyncWriteHelper) return;
+#ifdef R__USE_IMT
+   fAsyncWriteHelper->Wait();
+   if (fIMTFlush) {
+      fIMTFlush = false;
+      AddTotBytes(fIMTTotBytes);
+      AddZipBytes(fIMTZipBytes);
+      fIMTTotBytes.store(0);
+      fIMTZipBytes.store(0);
+   }
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write to disk all the basket that have not yet been individually written.
 ///
 /// If ROOT has IMT-mode enabled, this will launch multiple TBB tasks in parallel
-/// to do this operation; one per basket compression.  If the caller utilizes
+/// to compress the outstanding baskets (one task per branch); the prepared
+/// buffers are then written to the file serially, in branch order, so that
+/// the basket layout on disk stays deterministic.  If the caller utilizes
 /// TBB also, care must be taken to prevent deadlocks.
 ///
 /// For example, let's say the caller holds mutex A and calls FlushBaskets; while
@@ -4855,6 +4996,9 @@ struct BoolRAIIToggle {
 Int_t TTree::FlushBaskets() const
 {
    if (!fDirectory) return 0;
+   // Settle the basket writes still in flight from asynchronous Fill mode
+   // before flushing (and before the IMT byte counters are reused below).
+   const_cast<TTree*>(this)->WaitForAsyncWrites();
    Int_t nbytes = 0;
    Int_t nerror = 0;
    TObjArray *lb = const_cast<TTree*>(this)->GetListOfBranches();
@@ -4867,13 +5011,14 @@ Int_t TTree::FlushBaskets() const
       BoolRAIIToggle sentry(fIMTFlush);
       fIMTZipBytes.store(0);
       fIMTTotBytes.store(0);
-      std::atomic<Int_t> nerrpar(0);
-      std::atomic<Int_t> nbpar(0);
       std::atomic<Int_t> pos(0);
-      tbb::task_group g;
+      ROOT::Internal::TBranchIMTHelper imtHelper;
 
+      // First compress the outstanding baskets of all the branches in
+      // parallel; the per-branch buffers are independent so the tasks do
+      // not interact with the TFile at all.
       for (Int_t i = 0; i < nb; i++) {
-         g.run([&]() {
+         imtHelper.Run([&]() -> Long64_t {
             // The branch to process is obtained when the task starts to run.
             // This way, since branches are sorted, we make sure that branches
             // leading to big tasks are processed first. If we assigned the
@@ -4882,28 +5027,37 @@ Int_t TTree::FlushBaskets() const
             Int_t j = pos.fetch_add(1);
 
             auto branch = fSortedBranches[j].second;
-            if (R__unlikely(!branch)) { return; }
+            if (R__unlikely(!branch)) { return 0; }
 
             if (R__unlikely(gDebug > 0)) {
                std::stringstream ss;
                ss << std::this_thread::get_id();
                Info("FlushBaskets", "[IMT] Thread %s", ss.str().c_str());
-               Info("FlushBaskets", "[IMT] Running task for branch #%d: %s", j, branch->GetName());
+               Info("FlushBaskets", "[IMT] Running compression task for branch #%d: %s", j, branch->GetName());
             }
 
-            Int_t nbtask = branch->FlushBaskets();
-
-            if (nbtask < 0) { nerrpar++; }
-            else            { nbpar += nbtask; }
+            branch->PrepareBasketsToFlush();
+            return 0;
          });
       }
-      g.wait();
+      imtHelper.Wait();
+
+      // Then reserve the space in the file and write the prepared buffers
+      // serially, in branch order, so that the basket layout on disk is
+      // deterministic.
+      for (Int_t j = 0; j < nb; j++) {
+         TBranch* branch = (TBranch*) lb->UncheckedAt(j);
+         if (!branch) { continue; }
+         Int_t nwrite = branch->FlushBaskets();
+         if (nwrite < 0) { ++nerror; }
+         else            { nbytes += nwrite; }
+      }
 
       fIMTFlush = false;
       const_cast<TTree*>(this)->AddTotBytes(fIMTTotBytes);
       const_cast<TTree*>(this)->AddZipBytes(fIMTZipBytes);
 
-      return nerrpar ? -1 : nbpar.load();
+      return nerror ? -1 : nbytes;
    }
 #endif
    for (Int_t j = 0; j < nb; j++) {
@@ -4978,25 +5132,30 @@ TBranch* TTree::GetBranch(const char* name)
       return 0;
    }
 
+   // Intern the wanted name once: interned strings are canonical (see
+   // TStringInterner), so the scans below compare a single pointer per
+   // branch instead of running strcmp on every name.
+   const char* iname = TStringInterner::Intern(name);
+
    // Search using branches.
    Int_t nb = fBranches.GetEntriesFast();
    for (Int_t i = 0; i < nb; i++) {
       TBranch* branch = (TBranch*) fBranches.UncheckedAt(i);
-      if (!strcmp(branch->GetName(), name)) {
+      if (branch->GetInternedName() == iname) {
          return branch;
       }
       TObjArray* lb = branch->GetListOfBranches();
       Int_t nb1 = lb->GetEntriesFast();
       for (Int_t j = 0; j < nb1; j++) {
          TBranch* b1 = (TBranch*) lb->UncheckedAt(j);
-         if (!strcmp(b1->GetName(), name)) {
+         if (b1->GetInternedName() == iname) {
             return b1;
          }
          TObjArray* lb1 = b1->GetListOfBranches();
          Int_t nb2 = lb1->GetEntriesFast();
          for (Int_t k = 0; k < nb2; k++) {
             TBranch* b2 = (TBranch*) lb1->UncheckedAt(k);
-            if (!strcmp(b2->GetName(), name)) {
+            if (b2->GetInternedName() == iname) {
                return b2;
             }
          }
@@ -5009,7 +5168,7 @@ TBranch* TTree::GetBranch(const char* name)
    for (Int_t i = 0; i < nleaves; i++) {
       TLeaf* leaf = (TLeaf*) leaves->UncheckedAt(i);
       TBranch* branch = leaf->GetBranch();
-      if (!strcmp(branch->GetName(), name)) {
+      if (branch->GetInternedName() == iname) {
          return branch;
       }
    }
@@ -5348,7 +5507,11 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
       Int_t errnb = 0;
       std::atomic<Int_t> pos(0);
       std::atomic<Int_t> nbpar(0);
-      tbb::task_group g;
+
+      // collects the sub-branch tasks spawned by split branches; Reserve
+      // because Run will be called from the branch tasks concurrently
+      ROOT::Internal::TBranchIMTHelper imtHelper;
+      imtHelper.Reserve();
 
       auto mapFunction = [&]() {
             // The branch to process is obtained when the task starts to run.
@@ -5371,7 +5534,9 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
             std::chrono::time_point<std::chrono::system_clock> start, end;
 
             start = std::chrono::system_clock::now();
-            nbtask = branch->GetEntry(entry, getall);
+            // split branches hand their sub-branches to the helper as
+            // further tasks instead of reading them in this one
+            nbtask = branch->GetEntryImpl(entry, getall, &imtHelper);
             end = std::chrono::system_clock::now();
 
             Long64_t tasktime = (Long64_t)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
@@ -5384,13 +5549,14 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
 
       ROOT::TThreadExecutor pool;
       pool.Map(mapFunction, nbranches);
+      imtHelper.Wait();
 
-      if (errnb < 0) {
-         nb = errnb;
+      if (errnb < 0 || imtHelper.GetNerrors() != 0) {
+         nb = errnb < 0 ? errnb : -1;
       }
       else {
          // Save the number of bytes read by the tasks
-         nbytes = nbpar;
+         nbytes = nbpar + imtHelper.GetNbytes();
 
          // Re-sort branches if necessary
          if (++fNEntriesSinceSorting == kNEntriesResort) {
@@ -5965,6 +6131,87 @@ TList* TTree::GetUserInfo()
    return fUserInfo;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the branch range summary of this tree, or 0 if there is none.
+///
+/// The summary is created by SetRangeSummaryBranches on the writing side;
+/// on the reading side it is looked up in the user info list, where it was
+/// stored together with the tree header.
+
+TTreeRangeSummary *TTree::GetRangeSummary()
+{
+   if (!fRangeSummary && fUserInfo) {
+      fRangeSummary = dynamic_cast<TTreeRangeSummary*>(fUserInfo->FindObject("RangeSummary"));
+   }
+   return fRangeSummary;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare the branches whose minimum, maximum and sum should be recorded
+/// while this tree is filled.
+///
+/// branchnames is a comma separated list of branch names; the branches must
+/// exist already. The resulting TTreeRangeSummary is kept in the user info
+/// list of the tree, so it is written (and read back) together with the
+/// tree header. A chain reading the files back can then skip the ones
+/// whose value ranges cannot pass a cut declared with SetRangeCut, without
+/// touching their baskets. Only the first leaf value is sampled per entry,
+/// so designate scalar bookkeeping branches, e.g. the run number or the
+/// luminosity block.
+
+void TTree::SetRangeSummaryBranches(const char *branchnames)
+{
+   if (!branchnames || !branchnames[0]) return;
+   if (!fRangeSummary) {
+      fRangeSummary = new TTreeRangeSummary(GetName());
+      // the user info list owns (and streams) the summary
+      GetUserInfo()->Add(fRangeSummary);
+   }
+   TString list = branchnames;
+   TObjArray *tokens = list.Tokenize(", ");
+   TIter nextname(tokens);
+   TObjString *bname;
+   while ((bname = (TObjString*)nextname())) {
+      fRangeSummary->AddBranch(bname->GetString().Data());
+   }
+   delete tokens;
+   fRangeSummary->RegisterLeaves(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare a value window for a branch summarized with
+/// SetRangeSummaryBranches.
+///
+/// Entry loops going through the tree player - in particular TChain::Draw
+/// and Process - then skip the trees of a chain whose recorded [min,max]
+/// cannot intersect [vmin,vmax], without reading their baskets. The cut is
+/// advisory: trees without a range summary are always processed, so the
+/// selection itself must still be applied. Call with a null or empty
+/// branch name to remove the cut.
+
+void TTree::SetRangeCut(const char *branchname, Double_t vmin, Double_t vmax)
+{
+   fRangeCutBranch = branchname ? branchname : "";
+   fRangeCutMin = vmin;
+   fRangeCutMax = vmax;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kFALSE if the cut declared with SetRangeCut excludes every entry
+/// of the currently loaded tree, judged by its range summary. For a chain
+/// the summary of the current sub-tree is consulted. Trees without summary,
+/// or when no cut is declared, always pass.
+
+Bool_t TTree::PassesRangeCut()
+{
+   if (fRangeCutBranch.Length() == 0) return kTRUE;
+   TTree *t = GetTree();
+   if (!t) return kTRUE;
+   TTreeRangeSummary *summary = t->GetRangeSummary();
+   if (!summary) return kTRUE;
+   return summary->Overlaps(fRangeCutBranch, fRangeCutMin, fRangeCutMax);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Appends the cluster range information stored in 'fromtree' to this tree,
 /// including the value of fAutoFlush.
@@ -6742,6 +6989,52 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Configure this tree for archive-grade output: every branch compresses
+/// with LZMA at the maximum level, and the basket sizes are aligned with
+/// the cluster size so that, memory budget permitting, each branch writes
+/// one compression stream per cluster instead of many small independent
+/// ones. A cluster-scoped stream sees the redundancy across all the
+/// entries of the cluster, which is where most of the ratio of an external
+/// re-pack comes from. maxMemory bounds the total size of the branch
+/// buffers, as in OptimizeBaskets.
+///
+/// The typical use is re-packing an existing tree:
+/// ~~~ {.cpp}
+///     TFile out("archive.root", "RECREATE");
+///     TTree *packed = input->CloneTree(0);
+///     packed->SetArchivalWriteMode();
+///     packed->CopyEntries(input);
+/// ~~~
+/// For a tree still being filled the call only sets the compression: the
+/// automatic OptimizeBaskets call at the first flush aligns the basket
+/// sizes once real sizes have been observed.
+///
+/// The output is an ordinary ROOT file, readable by any ROOT version that
+/// understands LZMA compression: each basket remains an independently
+/// decompressible unit, which random access and the parallel read paths
+/// rely on. The baskets of one flush are compressed in parallel across
+/// branches (see FlushBaskets), so the higher LZMA level is partly hidden
+/// by the other streams of the cluster.
+
+void TTree::SetArchivalWriteMode(ULong64_t maxMemory)
+{
+   TIter next(GetListOfBranches());
+   TBranch *branch;
+   while ((branch = (TBranch*) next()))
+      branch->SetCompressionSettings(ROOT::CompressionSettings(ROOT::kLZMA, 9));
+
+   if (fAutoFlush == 0) {
+      // Cluster-scoped streams need clusters; use the default cluster budget.
+      SetAutoFlush(-30000000);
+   }
+   if (GetTotBytes() > 0) {
+      // For a tree with data (or a clone carrying the statistics of its
+      // original) align the basket sizes with the cluster size right away.
+      OptimizeBaskets(maxMemory, 1, "");
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to the Principal Components Analysis class.
 ///
@@ -7111,6 +7404,140 @@ Long64_t TTree::ReadFile(const char* filename, const char* branchDescriptor, cha
    return ReadStream(in, branchDescriptor, delimiter);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill this tree from a SQL query result, fetching batchSize rows per
+/// TSQLResult::FetchBatch call into columnar buffers.
+///
+/// The branchDescriptor follows the TTree::ReadFile convention
+/// "name/D:name2/L:name3/C" with the supported types
+/// -  D : Double_t
+/// -  L : Long64_t
+/// -  C : character string (truncated to 255 characters)
+///
+/// If branchDescriptor is empty, one Double_t branch is created per field
+/// of the result set, named after TSQLResult::GetFieldName.
+/// When the tree already has branches (e.g. when importing several result
+/// sets into the same tree), the existing branch addresses are reused.
+///
+/// Returns the number of rows imported.
+
+Long64_t TTree::ReadSQLResult(TSQLResult *result, const char *branchDescriptor, Int_t batchSize)
+{
+   if (!result) {
+      Error("ReadSQLResult", "no result set specified");
+      return 0;
+   }
+   Int_t nfields = result->GetFieldCount();
+   if (nfields <= 0) {
+      Error("ReadSQLResult", "result set has no fields");
+      return 0;
+   }
+   if (batchSize < 1) batchSize = 1;
+
+   // Determine the name and type of each field.
+   std::vector<TString> names(nfields);
+   std::vector<char> types(nfields);
+   if (branchDescriptor && *branchDescriptor) {
+      TString desc = branchDescriptor;
+      Int_t ifield = 0;
+      Int_t from = 0;
+      TString token;
+      while (desc.Tokenize(token, from, ":")) {
+         if (ifield >= nfields) {
+            Error("ReadSQLResult", "branch descriptor has more elements than the result set has fields (%d)", nfields);
+            return 0;
+         }
+         char type = 'D';
+         Ssiz_t slash = token.Last('/');
+         if (slash != kNPOS) {
+            if (token.Length() != slash+2) {
+               Error("ReadSQLResult", "invalid branch descriptor element: %s", token.Data());
+               return 0;
+            }
+            type = token[slash+1];
+            token.Remove(slash);
+         }
+         if (type != 'D' && type != 'L' && type != 'C') {
+            Error("ReadSQLResult", "unsupported type %c in branch descriptor, only D, L and C are supported", type);
+            return 0;
+         }
+         names[ifield] = token;
+         types[ifield] = type;
+         ifield++;
+      }
+      if (ifield != nfields) {
+         Error("ReadSQLResult", "branch descriptor has %d elements, result set has %d fields", ifield, nfields);
+         return 0;
+      }
+   } else {
+      for (Int_t i = 0; i < nfields; i++) {
+         const char *fname = result->GetFieldName(i);
+         if (fname && *fname)
+            names[i] = fname;
+         else
+            names[i] = TString::Format("field%d", i);
+         types[i] = 'D';
+      }
+   }
+
+   // Per-row scalars the branches point to and per-field batch buffers.
+   std::vector<Double_t> dval(nfields);
+   std::vector<Long64_t> lval(nfields);
+   std::vector<std::vector<char> > cval(nfields);
+   std::vector<Double_t*> numdata(nfields, (Double_t*)0);
+   std::vector<Long64_t*> intdata(nfields, (Long64_t*)0);
+   std::vector<TString*> txtdata(nfields, (TString*)0);
+
+   Bool_t makeBranches = (fBranches.GetEntries() == 0);
+   for (Int_t i = 0; i < nfields; i++) {
+      switch (types[i]) {
+         case 'D':
+            numdata[i] = new Double_t[batchSize];
+            if (makeBranches) Branch(names[i], &dval[i], TString::Format("%s/D", names[i].Data()));
+            else              SetBranchAddress(names[i], &dval[i]);
+            break;
+         case 'L':
+            intdata[i] = new Long64_t[batchSize];
+            if (makeBranches) Branch(names[i], &lval[i], TString::Format("%s/L", names[i].Data()));
+            else              SetBranchAddress(names[i], &lval[i]);
+            break;
+         case 'C':
+            txtdata[i] = new TString[batchSize];
+            cval[i].resize(256);
+            if (makeBranches) Branch(names[i], &cval[i][0], TString::Format("%s/C", names[i].Data()));
+            else              SetBranchAddress(names[i], &cval[i][0]);
+            break;
+      }
+   }
+
+   Long64_t nrows = 0;
+   Int_t nbatch;
+   while ((nbatch = result->FetchBatch(batchSize, nfields, &types[0],
+                                       &numdata[0], &intdata[0], &txtdata[0])) > 0) {
+      for (Int_t irow = 0; irow < nbatch; irow++) {
+         for (Int_t i = 0; i < nfields; i++) {
+            switch (types[i]) {
+               case 'D': dval[i] = numdata[i][irow]; break;
+               case 'L': lval[i] = intdata[i][irow]; break;
+               case 'C': strlcpy(&cval[i][0], txtdata[i][irow].Data(), 256); break;
+            }
+         }
+         Fill();
+      }
+      nrows += nbatch;
+      if (nbatch < batchSize) break;
+   }
+   if (nbatch < 0)
+      Error("ReadSQLResult", "error fetching rows after %lld rows", nrows);
+
+   for (Int_t i = 0; i < nfields; i++) {
+      delete [] numdata[i];
+      delete [] intdata[i];
+      delete [] txtdata[i];
+   }
+   return nrows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Determine which newline this file is using.
 /// Return '\\r' for Windows '\\r\\n' as that already terminates.
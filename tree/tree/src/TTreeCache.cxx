@@ -231,6 +231,7 @@ of effective system reads for a given file with a code like
 #include "TSystem.h"
 #include "TEnv.h"
 #include "TTreeCache.h"
+#include "TBasketCache.h"
 #include "TChain.h"
 #include "TList.h"
 #include "TBranch.h"
@@ -240,12 +241,54 @@ of effective system reads for a given file with a code like
 #include "TLeaf.h"
 #include "TFriendElement.h"
 #include "TFile.h"
+#include "TMath.h"
+#include "TMemoryGovernor.h"
 #include <limits.h>
+#include <algorithm>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+   // Registry of learned cache profiles, keyed by tree name and shared by
+   // all the caches of the process (see TTreeCache::SetProfileSharing).
+   std::mutex &R__ProfileMutex()
+   {
+      static std::mutex m;
+      return m;
+   }
+   std::map<std::string, std::vector<std::string> > &R__ProfileRegistry()
+   {
+      static std::map<std::string, std::vector<std::string> > registry;
+      return registry;
+   }
+}
 
 Int_t TTreeCache::fgLearnEntries = 100;
+Bool_t TTreeCache::fgShareProfile = kFALSE;
 
 ClassImp(TTreeCache)
 
+////////////////////////////////////////////////////////////////////////////////
+/// Reclaim callback registered with TMemoryGovernor: shrink the cache
+/// buffer (not below 1 MByte) to give memory back under budget pressure.
+/// The prefetch lists are invalidated by SetBufferSize and refilled at the
+/// next read.
+
+static Long64_t R__ReclaimTreeCache(void *ctx, Long64_t nbytes)
+{
+   TTreeCache *cache = (TTreeCache*)ctx;
+   const Long64_t minSize = 1000000;
+   Long64_t size = cache->GetBufferSize();
+   Long64_t target = size - nbytes;
+   if (target < minSize) target = minSize;
+   if (target >= size) return 0;
+   if (cache->SetBufferSize((Int_t)target) < 0) return 0;
+   return size - target;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor.
 
@@ -272,7 +315,10 @@ TTreeCache::TTreeCache() : TFileCacheRead(),
    fReadDirectionSet(kFALSE),
    fEnabled(kTRUE),
    fPrefillType(GetConfiguredPrefillType()),
-   fAutoCreated(kFALSE)
+   fAutoCreated(kFALSE),
+   fBasketCacheId(0),
+   fBasketCacheSet(kFALSE),
+   fRandomAccess(kFALSE)
 {
 }
 
@@ -302,11 +348,16 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize) : TFileCacheRead(tree->Get
    fReadDirectionSet(kFALSE),
    fEnabled(kTRUE),
    fPrefillType(GetConfiguredPrefillType()),
-   fAutoCreated(kFALSE)
+   fAutoCreated(kFALSE),
+   fBasketCacheId(0),
+   fBasketCacheSet(kFALSE),
+   fRandomAccess(kFALSE)
 {
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntries();
    fBranches = new TObjArray(nleaves);
+   AdoptSharedProfile();
+   TMemoryGovernor::RegisterReclaimer("TFileCacheRead", this, R__ReclaimTreeCache);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -314,6 +365,8 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize) : TFileCacheRead(tree->Get
 
 TTreeCache::~TTreeCache()
 {
+   TMemoryGovernor::UnregisterReclaimer(this);
+
    // Informe the TFile that we have been deleted (in case
    // we are deleted explicitly by legacy user code).
    if (fFile) fFile->SetCacheRead(0, fTree);
@@ -618,6 +671,11 @@ Int_t TTreeCache::DropBranch(const char *bname, Bool_t subbranches /*= kFALSE*/)
 
 Bool_t TTreeCache::FillBuffer()
 {
+   // In the hinted random-access mode the cache content is driven entirely
+   // by PrefetchEntries: refilling here would replace the announced basket
+   // set with a sequential guess, so a miss falls through to a direct read.
+   if (fRandomAccess) return kFALSE;
+
    if (fNbranches <= 0) return kFALSE;
    TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
    Long64_t entry = tree->GetReadEntry();
@@ -912,6 +970,11 @@ Bool_t TTreeCache::FillBuffer()
          fFirstTime = kFALSE;
       }
    }
+   if (fIsLearning) {
+      // The learning phase ends here; publish the profile for other caches
+      // reading the same tree (see SetProfileSharing).
+      ShareLearnedProfile();
+   }
    fIsLearning = kFALSE;
    return kTRUE;
 }
@@ -973,6 +1036,117 @@ Int_t TTreeCache::GetLearnEntries()
    return fgLearnEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning kTRUE when the learned profiles are shared
+/// between the caches of this process, see SetProfileSharing.
+
+Bool_t TTreeCache::GetProfileSharing()
+{
+   return fgShareProfile;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Announce the entries the next batch of random-access lookups will read
+/// (e.g. the result of a block of TTreeIndex searches in a tag-and-probe
+/// selection) and fetch the baskets they need in one grouped request.
+///
+/// The sequential policy of FillBuffer is useless under index-driven reads:
+/// it caches the entry range following the current read position, which a
+/// random pattern never visits. This method switches the cache to a hinted
+/// random-access mode: the baskets covering the announced entries are looked
+/// up in each cached branch, registered together (so the underlying
+/// TFileCacheRead sorts and coalesces them into few large reads) and kept
+/// until the next call. A per-basket use count is maintained across calls;
+/// when the batch needs more baskets than fit in the buffer, the most
+/// frequently requested ones are retained and the rest are left to direct
+/// reads. While the mode is active FillBuffer is disabled, so a miss reads
+/// from the file without disturbing the announced set.
+///
+/// If the cache is still learning, the hint ends the learning phase; when no
+/// branch was registered yet all branches are cached, since an index lookup
+/// may deserialize any of them. Restrict this with AddBranch/DropBranch as
+/// usual. Entry numbers are local to the tree attached to this cache.
+///
+/// Calling with nentries <= 0 leaves the random-access mode, clears the use
+/// counts and returns the cache to the sequential policy.
+///
+/// Returns the number of bytes registered for prefetching, or -1 on error.
+
+Int_t TTreeCache::PrefetchEntries(const Long64_t *entries, Int_t nentries)
+{
+   if (!fTree) return -1;
+   if (nentries <= 0 || !entries) {
+      fRandomAccess = kFALSE;
+      fBasketUse.clear();
+      TFileCacheRead::Prefetch(0,0);
+      return 0;
+   }
+   if (fIsLearning) {
+      if (fNbranches == 0) AddBranch("*", kTRUE);
+      StopLearningPhase();
+   }
+   if (fNbranches <= 0) return -1;
+   fRandomAccess = kTRUE;
+
+   // collect the baskets covering the announced entries, counting in the
+   // page table how often each one is asked for
+   std::map<Long64_t,Int_t> needed;   // seek position -> length
+   for (Int_t i = 0; i < fNbranches; i++) {
+      TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
+      if (b->GetDirectory()==0) continue;
+      if (b->GetDirectory()->GetFile() != fFile) continue;
+      Int_t nb = b->GetWriteBasket() + 1;
+      if (nb > b->GetMaxBaskets()) nb = b->GetMaxBaskets();
+      Int_t *lbaskets   = b->GetBasketBytes();
+      Long64_t *starts  = b->GetBasketEntry();
+      if (!lbaskets || !starts) continue;
+      Int_t blistsize = b->GetListOfBaskets()->GetSize();
+      for (Int_t k = 0; k < nentries; k++) {
+         Int_t j = (Int_t)TMath::BinarySearch(nb, starts, entries[k]);
+         if (j < 0) continue;
+         Long64_t pos = b->GetBasketSeek(j);
+         Int_t len = lbaskets[j];
+         if (pos <= 0 || len <= 0) continue;
+         if (len > fBufferSizeMin) continue;   // larger than the whole cache
+         fBasketUse[pos]++;
+         // a basket already deserialized in the branch needs no prefetch
+         if (j < blistsize && b->GetListOfBaskets()->UncheckedAt(j)) continue;
+         needed[pos] = len;
+      }
+   }
+
+   // frequency-based retention: when the batch does not fit in the buffer,
+   // keep the baskets with the highest use count and leave the rest to
+   // direct reads
+   std::vector<std::pair<UInt_t,Long64_t> > order;
+   order.reserve(needed.size());
+   for (std::map<Long64_t,Int_t>::const_iterator it = needed.begin(); it != needed.end(); ++it) {
+      order.push_back(std::make_pair(fBasketUse[it->first], it->first));
+   }
+   std::sort(order.begin(), order.end(),
+             [](const std::pair<UInt_t,Long64_t> &a, const std::pair<UInt_t,Long64_t> &b) {
+                if (a.first != b.first) return a.first > b.first;
+                return a.second < b.second;   // by offset for coalescing ties
+             });
+
+   TFileCacheRead::Prefetch(0,0);
+   Int_t ntotal = 0;
+   for (std::vector<std::pair<UInt_t,Long64_t> >::const_iterator it = order.begin(); it != order.end(); ++it) {
+      Int_t len = needed[it->second];
+      if (ntotal + len > fBufferSizeMin) {
+         if (ntotal > 0) continue;   // full: try the smaller remaining ones
+      }
+      TFileCacheRead::Prefetch(it->second, len);
+      ntotal += len;
+      fNReadPref++;
+   }
+   if (gDebug > 0) {
+      Info("PrefetchEntries", "registered %d bytes in %d baskets for %d announced entries",
+           ntotal, fNseek, nentries);
+   }
+   return ntotal;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print cache statistics. Like:
 ///
@@ -1013,6 +1187,9 @@ void TTreeCache::Print(Option_t *option) const
          printf("Branch name........................: %s\n",branch->GetName());
       }
    }
+   if (TBasketCache::Instance().IsEnabled()) {
+      TBasketCache::Instance().Print(opt);
+   }
    TFileCacheRead::Print(opt);
 }
 
@@ -1020,8 +1197,20 @@ void TTreeCache::Print(Option_t *option) const
 /// Old method ReadBuffer before the addition of the prefetch mechanism.
 
 Int_t TTreeCache::ReadBufferNormal(char *buf, Long64_t pos, Int_t len){
+   // The shared compressed-basket tier is only used for read-only files:
+   // a writable file may reuse freed space for new baskets.
+   TBasketCache &tier = TBasketCache::Instance();
+   Bool_t useTier = tier.IsEnabled() && fFile && !fFile->IsWritable();
+
    //Is request already in the cache?
    if (TFileCacheRead::ReadBuffer(buf,pos,len) == 1){
+      fNReadOk++;
+      if (useTier) tier.Insert(GetBasketCacheId(), pos, len, buf);
+      return 1;
+   }
+
+   //second tier: compressed baskets kept in memory past the cache window
+   if (useTier && tier.ReadBuffer(GetBasketCacheId(), pos, len, buf)) {
       fNReadOk++;
       return 1;
    }
@@ -1031,9 +1220,10 @@ Int_t TTreeCache::ReadBufferNormal(char *buf, Long64_t pos, Int_t len){
    if (bufferFilled) {
       Int_t res = TFileCacheRead::ReadBuffer(buf,pos,len);
 
-      if (res == 1)
+      if (res == 1) {
          fNReadOk++;
-      else if (res == 0)
+         if (useTier) tier.Insert(GetBasketCacheId(), pos, len, buf);
+      } else if (res == 0)
          fNReadMiss++;
 
       return res;
@@ -1185,9 +1375,24 @@ void TTreeCache::SetFile(TFile *file, TFile::ECacheAction action)
       fFile = 0;
       prevFile->SetCacheRead(0, fTree, action);
    }
+   fBasketCacheSet = kFALSE;
    TFileCacheRead::SetFile(file, action);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the id of the current file in the shared compressed basket cache,
+/// registering the file on first use. Reset by SetFile when a chain moves
+/// the cache to another file.
+
+UInt_t TTreeCache::GetBasketCacheId()
+{
+   if (!fBasketCacheSet) {
+      fBasketCacheId = TBasketCache::Instance().GetFileId(fFile);
+      fBasketCacheSet = kTRUE;
+   }
+   return fBasketCacheId;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static function to set the number of entries to be used in learning mode
 /// The default value for n is 10. n must be >= 1
@@ -1198,6 +1403,20 @@ void TTreeCache::SetLearnEntries(Int_t n)
    fgLearnEntries = n;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static function to enable or disable the sharing of learned profiles.
+/// When enabled, the first cache that finishes its learning phase publishes
+/// its branch list in a process wide registry and every cache created
+/// afterwards for a tree of the same name starts with that plan instead of
+/// learning again. This is meant for multi-threaded processing where every
+/// worker reads (a clone of) the same tree. Sharing can also be enabled
+/// with the resource variable TTreeCache.ShareProfile.
+
+void TTreeCache::SetProfileSharing(Bool_t share)
+{
+   fgShareProfile = share;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set whether the learning period is started with a prefilling of the
 /// cache and which type of prefilling is used.
@@ -1225,6 +1444,8 @@ void TTreeCache::StartLearningPhase()
    if (fBrNames) fBrNames->Delete();
    fIsTransferred = kFALSE;
    fEntryCurrent = -1;
+   fRandomAccess = kFALSE;
+   fBasketUse.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1240,6 +1461,7 @@ void TTreeCache::StopLearningPhase()
       // This will force FillBuffer to read the buffers.
       fEntryNext = -1;
       fIsLearning = kFALSE;
+      ShareLearnedProfile();
    }
    fIsManual = kTRUE;
 
@@ -1251,6 +1473,140 @@ void TTreeCache::StopLearningPhase()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Save the list of branches learned (or selected manually) by this cache
+/// into a small sidecar text file, one branch name per line. Lines starting
+/// with a '#' are comments. The file can be given to LoadLearnedProfile in
+/// later jobs reading the same dataset, so that they start with a warm cache
+/// plan instead of reading suboptimally during the learning phase.
+/// Returns the number of branch names written, or -1 on error.
+
+Int_t TTreeCache::SaveLearnedProfile(const char *filename) const
+{
+   if (!filename || !*filename) {
+      Error("SaveLearnedProfile", "no file name given");
+      return -1;
+   }
+   if (!fBrNames) return -1;
+   FILE *fp = fopen(filename, "w");
+   if (!fp) {
+      Error("SaveLearnedProfile", "cannot open file %s", filename);
+      return -1;
+   }
+   fprintf(fp, "# TTreeCache profile for tree %s\n", fTree ? fTree->GetName() : "");
+   Int_t nbranches = 0;
+   TIter next(fBrNames);
+   TObjString *os;
+   while ((os = (TObjString*)next())) {
+      fprintf(fp, "%s\n", os->GetName());
+      ++nbranches;
+   }
+   fclose(fp);
+   return nbranches;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load a branch access profile saved by SaveLearnedProfile and register the
+/// branches it lists, then stop the learning phase: the cache reads with the
+/// recorded plan from the first entry on. Branches that no longer exist in
+/// the tree are reported by AddBranch and skipped. Returns the number of
+/// branch names registered, or -1 if the file cannot be read.
+
+Int_t TTreeCache::LoadLearnedProfile(const char *filename)
+{
+   if (!filename || !*filename) {
+      Error("LoadLearnedProfile", "no file name given");
+      return -1;
+   }
+   FILE *fp = fopen(filename, "r");
+   if (!fp) {
+      Error("LoadLearnedProfile", "cannot open file %s", filename);
+      return -1;
+   }
+   // AddBranch only registers branches while the cache is learning.
+   Bool_t wasLearning = fIsLearning;
+   fIsLearning = kTRUE;
+   Int_t nbranches = 0;
+   char line[4096];
+   while (fgets(line, sizeof(line), fp)) {
+      char *name = line;
+      while (*name == ' ' || *name == '\t') ++name;
+      if (*name == '#') continue;
+      size_t len = strlen(name);
+      while (len && (name[len-1] == '\n' || name[len-1] == '\r' || name[len-1] == ' ')) {
+         name[--len] = 0;
+      }
+      if (!len) continue;
+      if (AddBranch(name, kFALSE) == 0) ++nbranches;
+   }
+   fclose(fp);
+   if (nbranches > 0) {
+      // We have a complete plan, no need to learn on this job.
+      fIsLearning = kFALSE;
+      fIsManual = kTRUE;
+      fEntryNext = -1;
+   } else {
+      fIsLearning = wasLearning;
+   }
+   return nbranches;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Publish the learned branch list in the process wide registry, so that
+/// caches created later for a tree of the same name (e.g. by the workers of
+/// a multi-threaded processor reading the same dataset) skip their learning
+/// phase. The first cache to finish learning wins. No-op unless profile
+/// sharing is enabled, see SetProfileSharing.
+
+void TTreeCache::ShareLearnedProfile()
+{
+   if (!fgShareProfile && !gEnv->GetValue("TTreeCache.ShareProfile", 0)) return;
+   if (!fTree || !fBrNames || fBrNames->GetEntries() == 0) return;
+
+   std::vector<std::string> names;
+   TIter next(fBrNames);
+   TObjString *os;
+   while ((os = (TObjString*)next())) {
+      names.push_back(os->GetName());
+   }
+   std::lock_guard<std::mutex> guard(R__ProfileMutex());
+   std::map<std::string, std::vector<std::string> > &registry = R__ProfileRegistry();
+   if (registry.find(fTree->GetName()) == registry.end()) {
+      registry[fTree->GetName()] = names;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If profile sharing is enabled and another cache of this process already
+/// learned a profile for a tree of the same name, register its branches and
+/// skip the learning phase. Returns kTRUE when a profile was adopted.
+
+Bool_t TTreeCache::AdoptSharedProfile()
+{
+   if (!fgShareProfile && !gEnv->GetValue("TTreeCache.ShareProfile", 0)) return kFALSE;
+   if (!fTree) return kFALSE;
+
+   std::vector<std::string> names;
+   {
+      std::lock_guard<std::mutex> guard(R__ProfileMutex());
+      std::map<std::string, std::vector<std::string> > &registry = R__ProfileRegistry();
+      std::map<std::string, std::vector<std::string> >::const_iterator it = registry.find(fTree->GetName());
+      if (it == registry.end()) return kFALSE;
+      names = it->second;
+   }
+   for (size_t i = 0; i < names.size(); ++i) {
+      AddBranch(names[i].c_str(), kFALSE);
+   }
+   // Same state as when UpdateBranches finds the branch list of a previous
+   // file: we have a plan, no need to learn.
+   fIsLearning = kFALSE;
+   fEntryNext = -1;
+   if (gDebug > 0)
+      Info("AdoptSharedProfile", "adopted a shared cache profile with %d branches for tree %s",
+           (Int_t)names.size(), fTree->GetName());
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Update pointer to current Tree and recompute pointers to the branches in the cache.
 
@@ -52,9 +52,15 @@ where bufferSize must be passed in bytes.
 #include "TCondition.h"
 #include "TMath.h"
 #include "Bytes.h"
+#include "TROOT.h"
 
 #include "TEnv.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include <vector>
+#endif
+
 #define THREADCNT 2
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
@@ -149,6 +155,11 @@ void TTreeCacheUnzip::Init()
 
       for (Int_t i = 0; i < 10; i++) fUnzipThread[i] = 0;
 
+#ifdef R__USE_IMT
+      // With implicit multi-threading the blocks are inflated in bulk on the
+      // global pool (see UnzipCacheImt); no dedicated threads are needed.
+      if (!ROOT::IsImplicitMTEnabled())
+#endif
       StartThreadUnzip(THREADCNT);
 
    }
@@ -710,6 +721,13 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
    Int_t res = 0;
    Int_t loc = -1;
 
+#ifdef R__USE_IMT
+   // With implicit multi-threading on, inflate all the blocks of the current
+   // transfer in one parallel pass; afterwards every lookup below is a hit.
+   if (fParallel && !fIsLearning && ROOT::IsImplicitMTEnabled())
+      UnzipCacheImt();
+#endif
+
    {
       R__LOCKGUARD(fMutexList);
 
@@ -1241,6 +1259,93 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t &startindex, Int_t &locbuffsz, char *&lo
    return 0;
 }
 
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Inflate every block of the current cache transfer in one pass, scheduling
+/// the work on the implicit multi-threading pool instead of the dedicated
+/// unzip threads. The blocks are claimed with the same pending protocol as
+/// UnzipCache, so the two mechanisms can coexist. Unlike the incremental
+/// thread mode the whole transfer is inflated at once; the fUnzipBufferSize
+/// budget only limits the size of individual blocks.
+///
+/// Returns 0 if at least one block was processed, 1 if there was nothing
+/// to do.
+
+Int_t TTreeCacheUnzip::UnzipCacheImt()
+{
+   Int_t myCycle;
+   std::vector<Int_t> blks;
+   {
+      R__LOCKGUARD(fMutexList);
+
+      if (!fNseek || fIsLearning || !fIsTransferred) return 1;
+
+      myCycle = fCycle;
+      for (Int_t reqi = 0; reqi < fNseek; reqi++) {
+         if (!fUnzipStatus[reqi] && (fSeekLen[reqi] > 256)) {
+            fUnzipStatus[reqi] = 1; // Set it as pending
+            blks.push_back(reqi);
+         }
+      }
+      if (blks.empty()) return 1;
+      fBlocksToGo = 0;
+   }
+
+   auto unzipBlk = [&](Int_t reqi) {
+      const Int_t hlen = 128;
+      Int_t objlen = 0, keylen = 0, nbytes = 0;
+      Long64_t rdoffs;
+      Int_t rdlen;
+      {
+         R__LOCKGUARD(fMutexList);
+         rdoffs = fSeek[reqi];
+         rdlen = fSeekLen[reqi];
+      }
+
+      std::vector<char> locbuff(rdlen);
+      Int_t loc = -1;
+      Int_t readbuf = ReadBufferExt(&locbuff[0], rdoffs, rdlen, loc);
+
+      char *ptr = 0;
+      Int_t loclen = 0;
+      if (readbuf > 0) {
+         GetRecordHeader(&locbuff[0], hlen, nbytes, objlen, keylen);
+         Int_t len = (objlen > nbytes-keylen) ? keylen+objlen : nbytes;
+         // Blocks which are too big are left to the synchronous path.
+         if (len <= 4*fUnzipBufferSize)
+            loclen = UnzipBuffer(&ptr, &locbuff[0]);
+      }
+
+      R__LOCKGUARD(fMutexList);
+      if ((myCycle != fCycle) || !fIsTransferred || (loclen <= 0) || (loclen != objlen+keylen)) {
+         if (ptr) delete [] ptr;
+         fUnzipStatus[reqi] = 2; // Set it as done; the main thread will inflate it
+         fUnzipChunks[reqi] = 0;
+         fUnzipLen[reqi] = 0;
+         return 0;
+      }
+
+      fUnzipStatus[reqi] = 2; // Set it as done
+      fUnzipChunks[reqi] = ptr;
+      fUnzipLen[reqi] = loclen;
+      fTotalUnzipBytes += loclen;
+      fNUnzip++;
+      return 0;
+   };
+
+   // Each task allocates its output chunk itself, so the unzipped pages are
+   // first touched - and, with the pool threads pinned to their NUMA node
+   // (TThreadExecutor::SetThreadAffinity), allocated - on the socket of the
+   // worker that inflates them.
+   ROOT::TThreadExecutor pool;
+   pool.Map(unzipBlk, blks);
+
+   fUnzipDoneCondition->Broadcast();
+
+   return 0;
+}
+#endif
+
 void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
@@ -0,0 +1,190 @@
+// @(#)root/tree:$Id$
+// Author: ROOT team
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeColumnStore
+Writes the flat leaves of a TTree as per-cluster column pages and serves
+bulk value reads from them.
+
+Write() walks the clusters of a tree and stores, for every top-level
+branch with a single numeric leaf, one TColumnPage per cluster into a
+directory: fixed-stride raw values without per-entry framing, plus an
+offsets page for leaves with a leaf count. Pages are keyed
+"branchname__firstentry" so the page covering an entry is located from
+the key names alone.
+
+On the read side, GetBulkValues() copies a range of entries of a branch
+into a user buffer with a single memcpy per page, in the same raw
+on-disk byte order delivered by TBranch::GetBulkEntries(); GetPage()
+exposes the page itself for consumers that want the data and offsets
+blocks without any copy.
+
+~~~{.cpp}
+   // Convert the flat leaves once:
+   TFile f("ntuple.root","UPDATE");
+   TTree *tree = (TTree*)f.Get("events");
+   TDirectory *cols = f.mkdir("events_columns");
+   TTreeColumnStore::Write(tree, cols);
+
+   // Bulk read one branch:
+   TTreeColumnStore store(cols);
+   std::vector<Double_t> px(nentries);
+   for (Long64_t i = 0; i < nentries; )
+      i += store.GetBulkValues("px", i, nentries - i, &px[i]);
+~~~
+*/
+
+#include "TTreeColumnStore.h"
+#include "TColumnPage.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TLeafC.h"
+#include "TDirectory.h"
+#include "TKey.h"
+#include "TError.h"
+#include <stdlib.h>
+
+ClassImp(TTreeColumnStore)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a reader for the column pages stored in directory dir.
+
+TTreeColumnStore::TTreeColumnStore(TDirectory *dir) : fDir(dir)
+{
+   fPages.SetOwner(kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor; drops the cached pages.
+
+TTreeColumnStore::~TTreeColumnStore()
+{
+   fPages.Delete();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the page of branch branchname containing entry, reading and
+/// caching it if needed (at most one page per branch is cached).
+/// Returns 0 when no page covers the entry.
+
+TColumnPage *TTreeColumnStore::GetPage(const char *branchname, Long64_t entry)
+{
+   TColumnPage *page = (TColumnPage*)fPages.FindObject(branchname);
+   if (page && page->Contains(entry)) return page;
+   if (page) {
+      fPages.Remove(page);
+      delete page;
+   }
+   if (!fDir) return 0;
+
+   // The page keys are named "branchname__firstentry": find the key with
+   // the largest first entry not beyond the requested one.
+   TString prefix = TString::Format("%s__", branchname);
+   TKey *best = 0;
+   Long64_t bestFirst = -1;
+   TIter next(fDir->GetListOfKeys());
+   while (TKey *key = (TKey*)next()) {
+      if (strncmp(key->GetName(), prefix.Data(), prefix.Length()) != 0) continue;
+      Long64_t first = atoll(key->GetName() + prefix.Length());
+      if (first <= entry && first > bestFirst) {
+         bestFirst = first;
+         best = key;
+      }
+   }
+   if (!best) return 0;
+
+   page = (TColumnPage*)best->ReadObj();
+   if (!page || !page->Contains(entry)) {
+      delete page;
+      return 0;
+   }
+   page->SetName(branchname);
+   fPages.Add(page);
+   return page;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the values of up to nentries entries of branch branchname,
+/// starting at entry, into dest and return the number of entries served
+/// (what fits in the page covering entry; call again for the rest).
+/// Returns -1 when no page covers the entry. The values come in on-disk
+/// (big-endian) byte order, like TBranch::GetBulkEntries(); for
+/// variable-length leaves use GetPage() to reach the offsets table.
+
+Int_t TTreeColumnStore::GetBulkValues(const char *branchname, Long64_t entry,
+                                      Int_t nentries, void *dest)
+{
+   TColumnPage *page = GetPage(branchname, entry);
+   if (!page) return -1;
+
+   Long64_t pageEnd = page->GetFirstEntry() + page->GetNEntries();
+   if (entry + nentries > pageEnd) nentries = (Int_t)(pageEnd - entry);
+   if (page->CopyEntries(entry, nentries, dest) < 0) return -1;
+   return nentries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the values of every top-level branch of tree with a single
+/// numeric leaf as one column page per cluster into directory dir.
+/// Branches with sub-branches and character-string leaves are skipped.
+/// Returns the number of pages written, -1 on error.
+
+Int_t TTreeColumnStore::Write(TTree *tree, TDirectory *dir)
+{
+   if (!tree || !dir) return -1;
+   if (!dir->IsWritable()) {
+      ::Error("TTreeColumnStore::Write", "directory %s is not writable", dir->GetName());
+      return -1;
+   }
+
+   Long64_t nentries = tree->GetEntries();
+   Int_t npages = 0;
+
+   TTree::TClusterIterator clusterIter = tree->GetClusterIterator(0);
+   Long64_t clusterStart;
+   while ((clusterStart = clusterIter()) < nentries) {
+      Long64_t clusterEnd = clusterIter.GetNextEntry();
+      if (clusterEnd > nentries) clusterEnd = nentries;
+
+      TIter nextBranch(tree->GetListOfBranches());
+      while (TBranch *branch = (TBranch*)nextBranch()) {
+         if (branch->GetListOfBranches()->GetEntriesFast() > 0) continue;
+         if (branch->GetListOfLeaves()->GetEntriesFast() != 1) continue;
+         TLeaf *leaf = (TLeaf*)branch->GetListOfLeaves()->UncheckedAt(0);
+         if (leaf->IsA() == TLeafC::Class()) continue;
+         Int_t stride = leaf->GetLenType();
+         if (stride <= 0) continue;
+
+         // With a leaf count the entry length varies and the page keeps
+         // an offsets table; otherwise the static length is the fixed
+         // number of values per entry.
+         Int_t valuesPerEntry = leaf->GetLeafCount() ? 0 : leaf->GetLenStatic();
+
+         TColumnPage page(branch->GetName(), clusterStart, stride,
+                          valuesPerEntry, (Int_t)(clusterEnd - clusterStart));
+         for (Long64_t i = clusterStart; i < clusterEnd; ++i) {
+            if (branch->GetEntry(i) <= 0) {
+               ::Error("TTreeColumnStore::Write", "cannot read entry %lld of branch %s",
+                       i, branch->GetName());
+               return -1;
+            }
+            page.AppendEntry(leaf->GetValuePointer(), leaf->GetLen());
+         }
+         TString keyname = TString::Format("%s__%lld", branch->GetName(), clusterStart);
+         if (dir->WriteTObject(&page, keyname) <= 0) {
+            ::Error("TTreeColumnStore::Write", "cannot write page %s", keyname.Data());
+            return -1;
+         }
+         ++npages;
+      }
+   }
+   return npages;
+}
@@ -0,0 +1,161 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeRangeSummary
+Minimum/maximum/sum record for designated branches of one tree.
+
+The summary is created by TTree::SetRangeSummaryBranches before the fill
+loop, updated with the current branch values on every TTree::Fill and
+stored in the user info list of the tree, so it is written (and read
+back) together with the tree header. When a cut window is declared with
+TTree::SetRangeCut, a chain compares it against the summary of every
+tree it loads and skips the files whose value ranges cannot overlap the
+window - without reading any of their baskets.
+
+Only the first value of a branch is sampled per entry, which matches the
+intended use for scalar bookkeeping quantities like run or luminosity
+block numbers.
+*/
+
+#include "TTreeRangeSummary.h"
+
+#include "TTree.h"
+#include "TLeaf.h"
+#include "TError.h"
+
+ClassImp(TTreeRangeSummary)
+ClassImp(TTreeRangeSummary::TBranchRange)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an empty range record for the branch with the given name.
+
+TTreeRangeSummary::TBranchRange::TBranchRange(const char *name)
+   : TNamed(name, ""), fMin(0), fMax(0), fSum(0), fEntries(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fold one value into the range record.
+
+void TTreeRangeSummary::TBranchRange::Update(Double_t value)
+{
+   if (fEntries == 0) {
+      fMin = fMax = value;
+   } else {
+      if (value < fMin) fMin = value;
+      if (value > fMax) fMax = value;
+   }
+   fSum += value;
+   fEntries++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if some accumulated value may lie inside [vmin, vmax].
+/// An empty record cannot overlap anything: no entry of the tree can pass.
+
+Bool_t TTreeRangeSummary::TBranchRange::Overlaps(Double_t vmin, Double_t vmax) const
+{
+   if (fEntries == 0) return kFALSE;
+   return !(fMax < vmin || fMin > vmax);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a summary for the tree with the given name. The object name is
+/// fixed ("RangeSummary") so the summary can be looked up in the user info
+/// list of the tree; the tree name is kept as title.
+
+TTreeRangeSummary::TTreeRangeSummary(const char *treename)
+   : TNamed("RangeSummary", treename)
+{
+   fRanges.SetOwner(kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register a branch to be summarized and return its range record.
+/// Registering the same branch twice returns the existing record.
+
+TTreeRangeSummary::TBranchRange *TTreeRangeSummary::AddBranch(const char *branchname)
+{
+   TBranchRange *r = GetBranchRange(branchname);
+   if (!r) {
+      r = new TBranchRange(branchname);
+      fRanges.Add(r);
+   }
+   return r;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the range record of the given branch, or 0 if the branch was not
+/// registered.
+
+TTreeRangeSummary::TBranchRange *TTreeRangeSummary::GetBranchRange(const char *branchname) const
+{
+   return (TBranchRange*) fRanges.FindObject(branchname);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if values of branchname inside [vmin, vmax] may exist in
+/// the summarized tree. A branch without range record always overlaps:
+/// nothing is known about it, so no entry can be excluded.
+
+Bool_t TTreeRangeSummary::Overlaps(const char *branchname, Double_t vmin, Double_t vmax) const
+{
+   TBranchRange *r = GetBranchRange(branchname);
+   if (!r) return kTRUE;
+   return r->Overlaps(vmin, vmax);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Resolve the leaf of every registered branch in the given tree, to be
+/// sampled by Accumulate. Returns kFALSE if a branch has no leaf in the
+/// tree; the other branches are still accumulated.
+
+Bool_t TTreeRangeSummary::RegisterLeaves(TTree *tree)
+{
+   Int_t nranges = fRanges.GetEntriesFast();
+   fLeaves.assign(nranges, (TLeaf*)0);
+   Bool_t allfound = kTRUE;
+   for (Int_t i = 0; i < nranges; i++) {
+      const char *bname = fRanges.UncheckedAt(i)->GetName();
+      TLeaf *leaf = tree ? tree->GetLeaf(bname) : 0;
+      if (!leaf) {
+         ::Warning("TTreeRangeSummary::RegisterLeaves", "no leaf for branch %s in tree %s",
+                   bname, tree ? tree->GetName() : "(null)");
+         allfound = kFALSE;
+      }
+      fLeaves[i] = leaf;
+   }
+   return allfound;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fold the current value of every registered leaf into its range record.
+/// Called by TTree::Fill after the branches have been filled.
+
+void TTreeRangeSummary::Accumulate()
+{
+   for (size_t i = 0; i < fLeaves.size(); i++) {
+      if (fLeaves[i])
+         ((TBranchRange*) fRanges.UncheckedAt(i))->Update(fLeaves[i]->GetValue(0));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the accumulated ranges.
+
+void TTreeRangeSummary::Print(Option_t *) const
+{
+   Printf("TTreeRangeSummary of tree %s: %d branch(es)", GetTitle(), GetNbranches());
+   for (Int_t i = 0; i < fRanges.GetEntriesFast(); i++) {
+      TBranchRange *r = (TBranchRange*) fRanges.UncheckedAt(i);
+      Printf("  %-20s entries=%lld min=%g max=%g sum=%g",
+             r->GetName(), r->GetEntries(), r->GetMin(), r->GetMax(), r->GetSum());
+   }
+}
@@ -19,15 +19,20 @@
 #pragma link C++ class TSelectorEntries;
 #pragma link C++ class TFileDrawMap+;
 #pragma link C++ class TTreeIndex-;
+#pragma link C++ class TTreeIndexHash-;
 #pragma link C++ class TChainIndex+;
 #pragma link C++ class TChainIndex::TChainIndexEntry+;
 #pragma link C++ class TTreeFormulaManager;
 #pragma link C++ class TTreeDrawArgsParser+;
 #pragma link C++ class TTreePerfStats+;
+#pragma link C++ class TTreeShuffler;
+#pragma link C++ class TTreeTransformer;
+#pragma link C++ class TTreeExporter;
 #pragma link C++ class TTreeReader+;
 #pragma link C++ class TTreeTableInterface;
 #pragma link C++ class TSimpleAnalysis+;
 #pragma link C++ class ROOT::TTreeProcessorMT-;
+#pragma link C++ class ROOT::Experimental::TTreeProjector-;
 
 #pragma link C++ class ROOT::Internal::TBranchProxyDirector+;
 #pragma link C++ class ROOT::Detail::TBranchProxy+;
@@ -18,13 +18,16 @@ The ROOT Data Frame allows to analyse data stored in TTrees with a high level in
 #define ROOT_TDATAFRAME
 
 #include "ROOT/RArrayView.hxx"
+#include "ROOT/TVec.hxx"
 #include "ROOT/TDFOperations.hxx"
 #include "ROOT/TDFTraitsUtils.hxx"
 #include "TBranchElement.h"
 #include "TChain.h"
+#include "TFileMerger.h" // For Snapshot
 #include "TH1F.h" // For Histo actions
 #include "TH2F.h" // For Histo actions
 #include "TH3F.h" // For Histo actions
+#include "TMemFile.h" // For Snapshot
 #include "TProfile.h" // For Histo actions
 #include "TProfile2D.h" // For Histo actions
 #include "TTreeReader.h"
@@ -36,6 +39,7 @@ The ROOT Data Frame allows to analyse data stored in TTrees with a high level in
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <typeinfo>
 #include <vector>
 
@@ -183,6 +187,13 @@ ReaderValueOrArray(TTreeReader& r, const std::string& branch, TDFTraitsUtils::TT
 }
 
 
+template<typename BranchType, unsigned int N>
+std::shared_ptr<ROOT::Internal::TTreeReaderValueBase>
+ReaderValueOrArray(TTreeReader& r, const std::string& branch, TDFTraitsUtils::TTypeList<ROOT::Experimental::TVec<BranchType, N>>) {
+   return std::make_shared<TTreeReaderArray<BranchType>>(r, branch.c_str());
+}
+
+
 
 template <int... S, typename... BranchTypes>
 TVBVec_t BuildReaderValues(TTreeReader &r, const BranchNames &bl, const BranchNames &tmpbl,
@@ -217,6 +228,19 @@ void CheckFilter(Filter&)
 
 void CheckTmpBranch(const std::string& branchName, TTree *treePtr);
 
+///////////////////////////////////////////////////////////////////////////////
+/// Create in `t` one branch per name in `bnames`, holding the address of the
+/// corresponding element of the `values` tuple. Used by
+/// TDataFrameInterface::Snapshot to wire the staging trees.
+template <int... S, typename... BranchTypes>
+void BookSnapshotBranches(TTree &t, std::tuple<BranchTypes...> &values, const BranchNames &bnames,
+                          TDFTraitsUtils::TStaticSeq<S...>)
+{
+   // the comma operator makes the expansion well-formed for any branch type
+   std::initializer_list<int> expander = {(t.Branch(bnames[S].c_str(), &std::get<S>(values)), 0)...};
+   (void)expander;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Check that the callable passed to TDataFrameInterface::Reduce:
 /// - takes exactly two arguments of the same type
@@ -263,6 +287,9 @@ T &GetBranchValue(TVBPtr_t &readerValues, unsigned int slot, Long64_t entry, con
 template<typename T>
 std::array_view<T> GetBranchValue(TVBPtr_t &readerValues, unsigned int slot, Long64_t entry, const std::string& branch,
                   std::shared_ptr<ROOT::Detail::TDataFrameImpl> df, TDFTraitsUtils::TTypeList<std::array_view<T>>);
+template<typename T, unsigned int N>
+ROOT::Experimental::TVec<T, N> GetBranchValue(TVBPtr_t &readerValues, unsigned int slot, Long64_t entry, const std::string& branch,
+                  std::shared_ptr<ROOT::Detail::TDataFrameImpl> df, TDFTraitsUtils::TTypeList<ROOT::Experimental::TVec<T, N>>);
 
 
 template <typename Helper, typename PrevDataFrame,
@@ -316,6 +343,44 @@ public:
    }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// An action that materializes the values of a single branch into a contiguous
+/// buffer indexed by entry number. It is booked by TDataFrameInterface::Cache
+/// and runs in the same event loop as the other booked actions. Every entry is
+/// written by exactly one processing slot, so the (pre-sized) buffer is shared
+/// by all slots without synchronization.
+template <typename T, typename PrevDataFrame>
+class TDataFrameCacheAction final : public TDataFrameActionBase {
+   using BranchTypes_t = TDFTraitsUtils::TTypeList<T>;
+   using TypeInd_t = typename TDFTraitsUtils::TGenStaticSeq<BranchTypes_t::fgSize>::Type_t;
+
+   std::shared_ptr<std::vector<T>> fBuffer;
+   const BranchNames fBranches;
+   const BranchNames fTmpBranches;
+   PrevDataFrame &fPrevData;
+   std::weak_ptr<ROOT::Detail::TDataFrameImpl> fFirstData;
+
+public:
+   TDataFrameCacheAction(const std::shared_ptr<std::vector<T>>& buffer, const BranchNames &bl, PrevDataFrame& pd)
+      : fBuffer(buffer), fBranches(bl), fTmpBranches(pd.GetTmpBranches()), fPrevData(pd),
+        fFirstData(pd.GetDataFrame()) { }
+
+   TDataFrameCacheAction(const TDataFrameCacheAction &) = delete;
+
+   void BuildReaderValues(TTreeReader &r, unsigned int slot) final
+   {
+      fReaderValues[slot] = ROOT::Internal::BuildReaderValues(r, fBranches, fTmpBranches, BranchTypes_t(), TypeInd_t());
+   }
+
+   void Run(unsigned int slot, Long64_t entry) final
+   {
+      // entries not passing the upstream filters keep a default-constructed value
+      if (fPrevData.CheckFilters(slot, entry))
+         (*fBuffer)[entry] = GetBranchValue(fReaderValues[slot][0], slot, entry, fBranches[0],
+                                            fFirstData.lock(), TDFTraitsUtils::TTypeList<T>());
+   }
+};
+
 namespace ActionTypes {
    struct Histo1D {};
    struct Min {};
@@ -363,6 +428,8 @@ class TDataFrameFilter;
 class TDataFrameBranchBase;
 template <typename F, typename PrevData>
 class TDataFrameBranch;
+template <typename T, typename PrevData>
+class TDataFrameCachedBranch;
 class TDataFrameImpl;
 class TDataFrameGuessedType{};
 }
@@ -536,6 +603,56 @@ public:
       df->Run();
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Write selected branches to a new TTree in a new file (*instant action*)
+   /// \tparam BranchTypes The types of the branches, in the same order as the branch names.
+   /// \param[in] treename The name of the tree to be written.
+   /// \param[in] filename The name of the output file.
+   /// \param[in] bnames The names of the branches to be written, one per branch type.
+   ///
+   /// The entries passing all the preceding filters are written out. Each
+   /// processing slot stages its share of the entries in a tree living in an
+   /// in-memory TMemFile, so that basket compression happens on the worker
+   /// threads; when the event loop is over the staged trees are merged into
+   /// `filename` in slot order. Branches can be real branches of the TTree or
+   /// temporary ones created with AddColumn.
+   /// This is an *instant action*: the event loop is run upon invocation,
+   /// together with all other booked actions.
+   template <typename... BranchTypes>
+   void Snapshot(const std::string &treename, const std::string &filename, const BranchNames &bnames)
+   {
+      if (bnames.size() != sizeof...(BranchTypes)) {
+         throw std::runtime_error("the number of branch names must be equal to the number of branch types");
+      }
+      auto df = GetDataFrameChecked();
+      unsigned int nSlots = df->GetNSlots();
+      using Values_t = std::tuple<BranchTypes...>;
+      using TypeInd_t = typename ROOT::Internal::TDFTraitsUtils::TGenStaticSeq<sizeof...(BranchTypes)>::Type_t;
+      std::vector<std::unique_ptr<TMemFile>> memFiles(nSlots);
+      std::vector<std::unique_ptr<Values_t>> values(nSlots);
+      std::vector<TTree*> trees(nSlots); // owned by the staging files
+      for (unsigned int slot = 0; slot < nSlots; ++slot) {
+         const auto stageName = filename + "_slot" + std::to_string(slot);
+         memFiles[slot].reset(new TMemFile(stageName.c_str(), "RECREATE"));
+         values[slot].reset(new Values_t());
+         trees[slot] = new TTree(treename.c_str(), treename.c_str());
+         trees[slot]->SetDirectory(memFiles[slot].get());
+         ROOT::Internal::BookSnapshotBranches(*trees[slot], *values[slot], bnames, TypeInd_t());
+      }
+      ForeachSlot([&trees, &values](unsigned int slot, BranchTypes... vs) {
+         *values[slot] = std::forward_as_tuple(vs...);
+         trees[slot]->Fill();
+      }, bnames);
+      TFileMerger merger(kFALSE, kFALSE);
+      merger.SetPrintLevel(0);
+      merger.OutputFile(filename.c_str(), "RECREATE");
+      for (unsigned int slot = 0; slot < nSlots; ++slot) {
+         memFiles[slot]->Write();
+         merger.AddFile(memFiles[slot].get(), kFALSE);
+      }
+      merger.Merge();
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Execute a user-defined reduce operation on the values of a branch
    /// \tparam F The type of the reduce callable. Automatically deduced.
@@ -624,6 +741,47 @@ public:
       return df->MakeActionResultProxy(valuesPtr);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Materialize the values of a branch in memory and serve subsequent event loops from there (*instant action*)
+   /// \tparam T The type of the branch.
+   /// \param[in] branchName The name of the branch to be cached. If omitted, the default branch is used instead.
+   ///
+   /// The values of the branch (a real branch of the TTree or a temporary one
+   /// created with AddColumn) are materialized once into a contiguous buffer
+   /// indexed by entry number. The returned node shadows the branch name: all
+   /// subsequent transformations and actions read the cached values from memory
+   /// instead of re-reading the TTree or re-evaluating the temporary branch
+   /// expression, which pays off when several event loops are run over the same
+   /// data frame, e.g. in multi-pass systematic-variation analyses.
+   ///
+   /// Entries discarded by the filters upstream of this call hold a
+   /// default-constructed value in the cache.
+   /// This is an *instant action*: the materializing event loop is run upon
+   /// invocation, together with all actions booked so far.
+   template <typename T>
+   TDataFrameInterface<ROOT::Detail::TDataFrameBranchBase>
+   Cache(const std::string &branchName = "")
+   {
+      auto df = GetDataFrameChecked();
+      auto bl = GetBranchNames<T>({branchName}, "cache the values of the branch");
+      auto tree = df->GetTree();
+      if (df->GetNSlots() > 1 && nullptr != dynamic_cast<TChain*>(tree)) {
+         // with TTreeProcessorMT entry numbers are local to the chain elements,
+         // so they cannot index a chain-wide buffer
+         throw std::runtime_error("caching a branch of a TChain is not supported with implicit multi-threading");
+      }
+      auto bufferPtr = std::make_shared<std::vector<T>>(tree->GetEntries());
+      using DFCA_t = ROOT::Internal::TDataFrameCacheAction<T, Proxied>;
+      df->Book(std::make_shared<DFCA_t>(bufferPtr, bl, *fProxiedPtr));
+      df->Run();
+      using DFCB_t = ROOT::Detail::TDataFrameCachedBranch<T, Proxied>;
+      auto cachedPtr = std::make_shared<DFCB_t>(bl[0], bufferPtr, *fProxiedPtr);
+      // TmpBranchBasePtr_t is not declared yet at this point, spell the type out
+      df->Book(std::shared_ptr<ROOT::Detail::TDataFrameBranchBase>(cachedPtr));
+      TDataFrameInterface<ROOT::Detail::TDataFrameBranchBase> tdf_c(std::move(cachedPtr));
+      return tdf_c;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Fill and return a one-dimensional histogram with the values of a branch (*lazy action*)
    /// \tparam T The type of the branch the values of which are used to fill the histogram.
@@ -1377,6 +1535,56 @@ public:
 
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// A temporary branch served from a contiguous in-memory buffer filled once by
+/// TDataFrameInterface::Cache. It shadows the name of the cached branch, so
+/// downstream nodes transparently read the materialized values instead of
+/// re-reading the TTree or re-evaluating a temporary branch expression.
+template <typename T, typename PrevData>
+class TDataFrameCachedBranch final : public TDataFrameBranchBase {
+   std::shared_ptr<std::vector<T>> fBuffer;
+   PrevData &fPrevData;
+
+public:
+   TDataFrameCachedBranch(const std::string &name, const std::shared_ptr<std::vector<T>>& buffer, PrevData& pd)
+      : TDataFrameBranchBase(pd.GetDataFrame(), pd.GetTmpBranches(), name),
+        fBuffer(buffer), fPrevData(pd)
+   {
+      fTmpBranches.emplace_back(name);
+   }
+
+   TDataFrameCachedBranch(const TDataFrameCachedBranch &) = delete;
+
+   // no reader values are needed: all values come from the buffer
+   void BuildReaderValues(TTreeReader &, unsigned int) final { }
+
+   void CreateSlots(unsigned int) final { }
+
+   void *GetValue(unsigned int, Long64_t entry) final
+   {
+      return static_cast<void *>(&(*fBuffer)[entry]);
+   }
+
+   const std::type_info &GetTypeId() const { return typeid(T); }
+
+   bool CheckFilters(unsigned int slot, Long64_t entry) final
+   {
+      // dummy call: it just forwards to the previous object in the chain
+      return fPrevData.CheckFilters(slot, entry);
+   }
+
+   // recursive chain of `Report`s
+   // TDataFrameCachedBranch simply forwards the call to the previous node
+   void Report() const final {
+      fPrevData.PartialReport();
+   }
+
+   void PartialReport() const final {
+      fPrevData.PartialReport();
+   }
+
+};
+
 class TDataFrameFilterBase {
 protected:
    std::weak_ptr<TDataFrameImpl> fFirstData;
@@ -1591,6 +1799,32 @@ std::array_view<T> GetBranchValue(TVBPtr_t& readerValue, unsigned int slot,
    }
 }
 
+template<typename T, unsigned int N>
+ROOT::Experimental::TVec<T, N> GetBranchValue(TVBPtr_t& readerValue, unsigned int slot,
+                                              Long64_t entry, const std::string& branch,
+                                              std::shared_ptr<ROOT::Detail::TDataFrameImpl> df,
+                                              TDFTraitsUtils::TTypeList<ROOT::Experimental::TVec<T, N>>)
+{
+   if(readerValue == nullptr) {
+      // temporary branch
+      void* tmpBranchVal = df->GetTmpBranchValue(branch, slot, entry);
+      return *static_cast<ROOT::Experimental::TVec<T, N> *>(tmpBranchVal);
+   } else {
+      // real branch: the TVec adopts the memory of the TTreeReaderArray, no copy
+      auto& tra = *std::static_pointer_cast<TTreeReaderArray<T>>(readerValue);
+      if (tra.GetSize() > 1 &&
+          1 != (&tra[1] - &tra[0])) {
+         std::string exceptionText = "Branch ";
+         exceptionText += branch;
+         exceptionText += " hangs from a non-split branch. For this reason, it cannot be accessed via a TVec. Please read the top level branch instead.";
+         throw std::runtime_error(exceptionText.c_str());
+      }
+      if (tra.GetSize() == 0)
+         return ROOT::Experimental::TVec<T, N>();
+      return ROOT::Experimental::TVec<T, N>(&tra[0], tra.GetSize());
+   }
+}
+
 } // end NS Internal
 
 } // end NS ROOT
@@ -19,6 +19,7 @@
 #include "TTreeReader.h"
 #include "TError.h"
 #include "TEntryList.h"
+#include "TTreeCache.h"
 #include "ROOT/TThreadedObject.hxx"
 
 #include <string.h>
@@ -195,10 +196,36 @@ namespace ROOT {
             return fCurrentTree->GetClusterIterator(0);
          }
 
+         //////////////////////////////////////////////////////////////////////////
+         /// Configure a TTreeCache for the entry range of the task about to be
+         /// processed. For non-local files the cache is put in asynchronous
+         /// prefetching mode: the TFilePrefetch thread attached to it issues the
+         /// reads for the following cluster range while the entries of the
+         /// current one are being processed, hiding the storage latency.
+         void SetupCache(Long64_t start, Long64_t end)
+         {
+            if (!fCurrentFile)
+               return;
+
+            TTreeCache *cache = (TTreeCache*)fCurrentFile->GetCacheRead(fCurrentTree.get());
+            if (!cache) {
+               fCurrentTree->SetCacheSize();
+               cache = (TTreeCache*)fCurrentFile->GetCacheRead(fCurrentTree.get());
+               // Asynchronous prefetching only pays off when reads are remote;
+               // for local files keep the plain synchronous cache.
+               if (cache && strcmp(fCurrentFile->GetEndpointUrl()->GetProtocol(), "file") != 0)
+                  cache->SetEnablePrefetching(kTRUE);
+            }
+            if (cache)
+               cache->SetEntryRange(start, end);
+         }
+
          //////////////////////////////////////////////////////////////////////////
          /// Get a TTreeReader for the current tree of this view.
          std::unique_ptr<TTreeReader> GetTreeReader(Long64_t start, Long64_t end)
          {
+            SetupCache(start, end);
+
             TTreeReader *reader;
             if (fEntryLists.size() > 0 && fEntryLists[fCurrentIdx].GetN() > 0) {
                // TEntryList and SetEntriesRange do not work together (the former has precedence).
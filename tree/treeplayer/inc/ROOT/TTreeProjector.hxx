@@ -0,0 +1,173 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeProjector
+#define ROOT_TTreeProjector
+
+#include "TChain.h"
+#include "TH1F.h"
+#include "TROOT.h" // IsImplicitMTEnabled
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "ROOT/TDFTraitsUtils.hxx"
+#include "ROOT/TThreadedObject.hxx"
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#endif
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/** \class ROOT::Experimental::TTreeProjector
+    \brief Typed, compiled projection of tree branches into histograms.
+
+A light-weight alternative to TTree::Draw for the common quick-look case:
+the branches of interest and the quantity to histogram are known at compile
+time, so the interpreted TTreeFormula machinery is pure overhead. The
+projector runs a bulk read loop over the tree - in parallel when implicit
+multi-threading is enabled - and calls a user provided callable with the
+typed branch values of each entry. Per-thread partial results are cloned
+from a model object and merged at the end of the single pass, so one call
+can fill one or many histograms.
+
+~~~{.cpp}
+ROOT::EnableImplicitMT();
+ROOT::Experimental::TTreeProjector proj("Events", {"f1.root", "f2.root"});
+
+// Histogram one branch directly ...
+auto hpt = proj.Histo1D<float>(TH1F("pt", "p_{T}", 128, 0., 64.), "pt");
+
+// ... or a compiled expression of several branches ...
+auto hm = proj.Histo1D<float, float>(TH1F("m", "mass", 100, 0., 10.),
+                                     {"e", "pz"},
+                                     [](float e, float pz) { return sqrt(e*e - pz*pz); });
+
+// ... or fill an arbitrary mergeable object in a single pass.
+auto hs = proj.Project<float, int>(TH2F("h", "", 64, 0., 64., 5, 0., 5.),
+                                   {"pt", "ncand"},
+                                   [](TH2F &h, float pt, int n) { h.Fill(pt, n); });
+~~~
+
+The partial result type passed to Project() must be copy-constructible,
+clonable and mergeable in the TObject sense (`Merge(TCollection*)`), which
+all histogram classes are; a small user class holding several histograms
+and forwarding Merge() to them works as well. Unlike TDataFrame no graph
+of actions is built: every call runs its own loop over the data.
+*/
+
+namespace ROOT {
+
+namespace Experimental {
+
+class TTreeProjector {
+private:
+   TTree *fTree = nullptr;              ///< Tree to process, tree mode (not owned)
+   std::string fTreeName;               ///< Name of the tree, file mode
+   std::vector<std::string> fFileNames; ///< Input files, file mode
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Read the requested branches through typed reader values and invoke the
+   /// filler for every entry the reader yields.
+   template <typename... BranchTypes, typename Partial, typename Filler, int... S>
+   static void ProjectLoop(TTreeReader &reader, const std::vector<std::string> &branchNames, Partial &partial,
+                           Filler &filler, ROOT::Internal::TDFTraitsUtils::TStaticSeq<S...>)
+   {
+      std::tuple<std::unique_ptr<TTreeReaderValue<BranchTypes>>...> values{
+         std::unique_ptr<TTreeReaderValue<BranchTypes>>(
+            new TTreeReaderValue<BranchTypes>(reader, branchNames[S].c_str()))...};
+      while (reader.Next()) {
+         filler(partial, *(*std::get<S>(values))...);
+      }
+   }
+
+public:
+   ////////////////////////////////////////////////////////////////////////////
+   /// Project entries of the given tree (or chain). The tree is not owned and
+   /// must outlive the projector.
+   TTreeProjector(TTree &tree) : fTree(&tree) {}
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Project entries of the tree called treeName in the given files.
+   TTreeProjector(const std::string &treeName, const std::vector<std::string> &fileNames)
+      : fTreeName(treeName), fFileNames(fileNames)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Run one loop over the tree, calling filler(partial, branchValues...) for
+   /// every entry. Each thread fills its own clone of the model; the merged
+   /// result is returned. BranchTypes are the types of the listed branches,
+   /// in order.
+   template <typename... BranchTypes, typename Partial, typename Filler>
+   std::shared_ptr<Partial> Project(const Partial &model, const std::vector<std::string> &branchNames, Filler filler)
+   {
+      using Seq_t = typename ROOT::Internal::TDFTraitsUtils::TGenStaticSeq<sizeof...(BranchTypes)>::Type_t;
+      if (branchNames.size() != sizeof...(BranchTypes)) {
+         throw std::runtime_error("the number of branch names must be equal to the number of branch types");
+      }
+
+      ROOT::TThreadedObject<Partial> partials(model);
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled()) {
+         std::unique_ptr<ROOT::TTreeProcessorMT> tp;
+         if (fTree) {
+            tp.reset(new ROOT::TTreeProcessorMT(*fTree));
+         } else {
+            std::vector<std::string_view> fileNames(fFileNames.begin(), fFileNames.end());
+            tp.reset(new ROOT::TTreeProcessorMT(fileNames, fTreeName));
+         }
+         tp->Process([&](TTreeReader &reader) {
+            auto partial = partials.Get(); // one lookup per cluster range, not per entry
+            ProjectLoop<BranchTypes...>(reader, branchNames, *partial, filler, Seq_t());
+         });
+      } else {
+#endif // R__USE_IMT
+         TChain localChain(fTreeName.c_str());
+         TTree *tree = fTree;
+         if (!tree) {
+            for (auto &fileName : fFileNames) localChain.Add(fileName.c_str());
+            tree = &localChain;
+         }
+         TTreeReader reader(tree);
+         auto partial = partials.Get();
+         ProjectLoop<BranchTypes...>(reader, branchNames, *partial, filler, Seq_t());
+#ifdef R__USE_IMT
+      }
+#endif // R__USE_IMT
+      return partials.Merge();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Fill the model histogram with expr(branchValues...) for every entry.
+   template <typename... BranchTypes, typename Expr>
+   std::shared_ptr<::TH1F> Histo1D(const ::TH1F &model, const std::vector<std::string> &branchNames, Expr expr)
+   {
+      return Project<BranchTypes...>(model, branchNames,
+                                     [&expr](::TH1F &h, const BranchTypes &... vs) { h.Fill(expr(vs...)); });
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Fill the model histogram with the value of the given branch.
+   template <typename T>
+   std::shared_ptr<::TH1F> Histo1D(const ::TH1F &model, const std::string &branchName)
+   {
+      return Project<T>(model, {branchName}, [](::TH1F &h, const T &v) { h.Fill(v); });
+   }
+};
+
+} // namespace Experimental
+
+} // namespace ROOT
+
+#endif // ROOT_TTreeProjector
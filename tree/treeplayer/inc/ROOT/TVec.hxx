@@ -0,0 +1,357 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TVec
+#define ROOT_TVec
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ROOT {
+
+namespace Experimental {
+
+/**
+* \class ROOT::Experimental::TVec
+* \brief A contiguous owning container tuned for short per-entry collections.
+* \tparam T The type of the elements.
+* \tparam N The number of elements stored inline; defaults to 8.
+*
+* TVec is the collection type meant to cross the per-entry hot loop of an
+* analysis: unlike std::vector it keeps up to N elements in an inline buffer,
+* so a five-element track collection lives on the stack of the user lambda
+* and costs no allocation, and it can adopt memory it does not own, so a
+* column already resident in a TTreeReaderArray can be handed to user code
+* without a copy.
+*
+* Elements of an adopted TVec read and write the external memory directly.
+* The first operation that needs to grow the container (push_back beyond the
+* adopted size) detaches it: the elements are copied to owned storage first,
+* and the external memory is left untouched from then on.
+*
+* Element-wise arithmetic operators are provided between two TVec (sizes
+* must match, std::runtime_error otherwise) and between a TVec and a scalar,
+* together with the Sum and Dot reductions, so short kernels like
+* `pts * weights` need neither loops nor heap traffic.
+*
+* Example with TDataFrame, where a column requested as a TVec is transported
+* by adoption from the underlying TTreeReaderArray:
+* ~~~{.cpp}
+* ROOT::Experimental::TDataFrame d("tr", "f.root");
+* auto h = d.Define("scaledPts", [](const TVec<float> &pts) { return pts * 2.f; },
+*                   {"pts"})
+*           .Histo1D("scaledPts");
+* ~~~
+*/
+template <typename T, unsigned int N = 8>
+class TVec {
+   typename std::aligned_storage<sizeof(T), alignof(T)>::type fBuffer[N]; ///< inline storage for up to N elements
+   T *fData;                ///< elements; points to fBuffer, to owned heap storage or to adopted memory
+   std::size_t fSize;       ///< number of elements
+   std::size_t fCapacity;   ///< number of elements the current storage can hold
+   bool fOwns;              ///< false while viewing adopted memory
+
+   bool IsSmall() const { return fData == reinterpret_cast<const T *>(fBuffer); }
+
+   /// Move the elements to owned storage able to hold at least newCapacity
+   /// elements. Used both to grow and to detach from adopted memory.
+   void Grow(std::size_t newCapacity)
+   {
+      if (newCapacity < 2 * fCapacity) newCapacity = 2 * fCapacity;
+      T *newData;
+      if (!fOwns && newCapacity <= N) {
+         // detaching a short adopted view: the inline buffer is free and big enough
+         newData = reinterpret_cast<T *>(fBuffer);
+         newCapacity = N;
+      } else {
+         newData = static_cast<T *>(::operator new(newCapacity * sizeof(T)));
+      }
+      for (std::size_t i = 0; i < fSize; ++i) {
+         new (newData + i) T(std::move(fData[i]));
+         if (fOwns) fData[i].~T();
+      }
+      if (fOwns && !IsSmall()) ::operator delete(fData);
+      fData = newData;
+      fCapacity = newCapacity;
+      fOwns = true;
+   }
+
+   void DestroyAndFree()
+   {
+      if (fOwns) {
+         for (std::size_t i = 0; i < fSize; ++i) fData[i].~T();
+         if (!IsSmall()) ::operator delete(fData);
+      }
+   }
+
+public:
+   using value_type = T;
+   using size_type = std::size_t;
+   using iterator = T *;
+   using const_iterator = const T *;
+
+   TVec() : fData(reinterpret_cast<T *>(fBuffer)), fSize(0), fCapacity(N), fOwns(true) {}
+
+   /// Construct with size elements, value-initialized.
+   explicit TVec(std::size_t size) : TVec()
+   {
+      resize(size);
+   }
+
+   TVec(std::initializer_list<T> init) : TVec()
+   {
+      reserve(init.size());
+      for (const T &v : init) push_back(v);
+   }
+
+   template <typename InputIt,
+             typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+   TVec(InputIt first, InputIt last) : TVec()
+   {
+      for (; first != last; ++first) push_back(*first);
+   }
+
+   /// Adopt the external memory [data, data+size): the TVec reads and writes
+   /// it in place and does not free it. The first growing operation copies
+   /// the elements to owned storage and detaches from the external memory.
+   TVec(T *data, std::size_t size)
+      : fData(data), fSize(size), fCapacity(size), fOwns(false)
+   {
+      if (!data) {
+         fData = reinterpret_cast<T *>(fBuffer);
+         fSize = 0;
+         fCapacity = N;
+         fOwns = true;
+      }
+   }
+
+   TVec(const TVec &other) : TVec()
+   {
+      reserve(other.fSize);
+      for (std::size_t i = 0; i < other.fSize; ++i) push_back(other.fData[i]);
+   }
+
+   TVec(TVec &&other) : TVec()
+   {
+      if (other.fOwns && !other.IsSmall()) {
+         // steal the heap storage
+         fData = other.fData;
+         fSize = other.fSize;
+         fCapacity = other.fCapacity;
+      } else if (!other.fOwns) {
+         // share the adopted memory, like copying a view
+         fData = other.fData;
+         fSize = other.fSize;
+         fCapacity = other.fCapacity;
+         fOwns = false;
+      } else {
+         // inline elements are moved one by one
+         for (std::size_t i = 0; i < other.fSize; ++i) push_back(std::move(other.fData[i]));
+         other.DestroyAndFree();
+      }
+      other.fData = reinterpret_cast<T *>(other.fBuffer);
+      other.fSize = 0;
+      other.fCapacity = N;
+      other.fOwns = true;
+   }
+
+   TVec &operator=(const TVec &other)
+   {
+      if (this != &other) {
+         clear();
+         reserve(other.fSize);
+         for (std::size_t i = 0; i < other.fSize; ++i) push_back(other.fData[i]);
+      }
+      return *this;
+   }
+
+   TVec &operator=(TVec &&other)
+   {
+      if (this != &other) {
+         DestroyAndFree();
+         fData = reinterpret_cast<T *>(fBuffer);
+         fSize = 0;
+         fCapacity = N;
+         fOwns = true;
+         if (other.fOwns && !other.IsSmall()) {
+            fData = other.fData;
+            fSize = other.fSize;
+            fCapacity = other.fCapacity;
+         } else if (!other.fOwns) {
+            fData = other.fData;
+            fSize = other.fSize;
+            fCapacity = other.fCapacity;
+            fOwns = false;
+         } else {
+            for (std::size_t i = 0; i < other.fSize; ++i) push_back(std::move(other.fData[i]));
+            other.DestroyAndFree();
+         }
+         other.fData = reinterpret_cast<T *>(other.fBuffer);
+         other.fSize = 0;
+         other.fCapacity = N;
+         other.fOwns = true;
+      }
+      return *this;
+   }
+
+   ~TVec() { DestroyAndFree(); }
+
+   std::size_t size() const { return fSize; }
+   bool empty() const { return fSize == 0; }
+   std::size_t capacity() const { return fCapacity; }
+   /// Return true while the elements live in external adopted memory.
+   bool adopts() const { return !fOwns; }
+
+   T *data() { return fData; }
+   const T *data() const { return fData; }
+
+   T &operator[](std::size_t i) { return fData[i]; }
+   const T &operator[](std::size_t i) const { return fData[i]; }
+
+   T &front() { return fData[0]; }
+   const T &front() const { return fData[0]; }
+   T &back() { return fData[fSize - 1]; }
+   const T &back() const { return fData[fSize - 1]; }
+
+   iterator begin() { return fData; }
+   const_iterator begin() const { return fData; }
+   iterator end() { return fData + fSize; }
+   const_iterator end() const { return fData + fSize; }
+
+   void reserve(std::size_t newCapacity)
+   {
+      if (newCapacity > fCapacity || !fOwns) Grow(newCapacity);
+   }
+
+   void push_back(const T &v)
+   {
+      if (fSize == fCapacity || !fOwns) Grow(fSize + 1);
+      new (fData + fSize) T(v);
+      ++fSize;
+   }
+
+   void push_back(T &&v)
+   {
+      if (fSize == fCapacity || !fOwns) Grow(fSize + 1);
+      new (fData + fSize) T(std::move(v));
+      ++fSize;
+   }
+
+   template <typename... Args>
+   void emplace_back(Args &&... args)
+   {
+      if (fSize == fCapacity || !fOwns) Grow(fSize + 1);
+      new (fData + fSize) T(std::forward<Args>(args)...);
+      ++fSize;
+   }
+
+   void resize(std::size_t newSize)
+   {
+      if (newSize < fSize) {
+         if (fOwns)
+            for (std::size_t i = newSize; i < fSize; ++i) fData[i].~T();
+         fSize = newSize;
+      } else {
+         if (newSize > fCapacity || !fOwns) Grow(newSize);
+         for (std::size_t i = fSize; i < newSize; ++i) new (fData + i) T();
+         fSize = newSize;
+      }
+   }
+
+   void clear()
+   {
+      if (fOwns)
+         for (std::size_t i = 0; i < fSize; ++i) fData[i].~T();
+      fSize = 0;
+      if (!fOwns) {
+         fData = reinterpret_cast<T *>(fBuffer);
+         fCapacity = N;
+         fOwns = true;
+      }
+   }
+};
+
+namespace Internal {
+
+inline void CheckVecSizes(std::size_t s1, std::size_t s2, const char *opName)
+{
+   if (s1 != s2) {
+      std::string msg = "cannot apply operator";
+      msg += opName;
+      msg += " to TVec instances of different sizes";
+      throw std::runtime_error(msg);
+   }
+}
+
+} // namespace Internal
+
+#define R__TVEC_BINARY_OPERATOR(OP)                                            \
+   template <typename T, unsigned int N>                                       \
+   TVec<T, N> operator OP(const TVec<T, N> &a, const TVec<T, N> &b)            \
+   {                                                                           \
+      Internal::CheckVecSizes(a.size(), b.size(), #OP);                        \
+      TVec<T, N> res;                                                          \
+      res.reserve(a.size());                                                   \
+      for (std::size_t i = 0; i < a.size(); ++i) res.push_back(a[i] OP b[i]);  \
+      return res;                                                              \
+   }                                                                           \
+   template <typename T, unsigned int N>                                       \
+   TVec<T, N> operator OP(const TVec<T, N> &a, const T &s)                     \
+   {                                                                           \
+      TVec<T, N> res;                                                          \
+      res.reserve(a.size());                                                   \
+      for (std::size_t i = 0; i < a.size(); ++i) res.push_back(a[i] OP s);     \
+      return res;                                                              \
+   }                                                                           \
+   template <typename T, unsigned int N>                                       \
+   TVec<T, N> operator OP(const T &s, const TVec<T, N> &a)                     \
+   {                                                                           \
+      TVec<T, N> res;                                                          \
+      res.reserve(a.size());                                                   \
+      for (std::size_t i = 0; i < a.size(); ++i) res.push_back(s OP a[i]);     \
+      return res;                                                              \
+   }
+
+R__TVEC_BINARY_OPERATOR(+)
+R__TVEC_BINARY_OPERATOR(-)
+R__TVEC_BINARY_OPERATOR(*)
+R__TVEC_BINARY_OPERATOR(/)
+
+#undef R__TVEC_BINARY_OPERATOR
+
+/// Sum of the elements.
+template <typename T, unsigned int N>
+T Sum(const TVec<T, N> &v)
+{
+   T sum = T();
+   for (std::size_t i = 0; i < v.size(); ++i) sum += v[i];
+   return sum;
+}
+
+/// Scalar product of two TVec of the same size.
+template <typename T, unsigned int N>
+T Dot(const TVec<T, N> &a, const TVec<T, N> &b)
+{
+   Internal::CheckVecSizes(a.size(), b.size(), " (Dot)");
+   T sum = T();
+   for (std::size_t i = 0; i < a.size(); ++i) sum += a[i] * b[i];
+   return sum;
+}
+
+} // namespace Experimental
+
+} // namespace ROOT
+
+#endif // ROOT_TVec
@@ -94,6 +94,7 @@ namespace Detail {
       TVirtualCollectionProxy *fCollection; // Handle to the collection containing the data chunk.
 
       Int_t    fCurrentTreeNumber;
+      Int_t    fSetupGeneration; // incremented every time Setup() rebinds, so cached addresses can be revalidated with one compare
 
    public:
       virtual void Print();
@@ -183,6 +184,11 @@ namespace Detail {
 
       void* GetWhere() const { return fWhere; } // intentionally non-virtual
 
+      // fWhere can only move when Setup() runs again (e.g. new tree of a
+      // chain); a caller that cached the resolved address revalidates it by
+      // comparing this generation count.
+      Int_t GetSetupGeneration() const { return fSetupGeneration; }
+
       TVirtualCollectionProxy *GetCollection() { return fCollection; }
 
       // protected:
@@ -0,0 +1,55 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeExporter
+#define ROOT_TTreeExporter
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeExporter                                                        //
+//                                                                      //
+// Export tree columns to delimiter-separated text at I/O speed. The    //
+// entry range is partitioned along cluster boundaries, the partitions  //
+// are scanned in parallel (each worker reading through its own file    //
+// handle) with fast number-to-string formatting into per-worker        //
+// buffers, and the buffers are written out in entry order.             //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "TString.h"
+
+class TTree;
+
+class TTreeExporter : public TObject {
+
+protected:
+   TTree   *fTree;      ///< input tree (not owned)
+   TString  fColumns;   ///< ":"-separated column expressions
+   TString  fSelection; ///< selection expression, empty selects all entries
+   char     fDelimiter; ///< field delimiter of the output
+   Bool_t   fHeader;    ///< write a header line with the column expressions
+
+public:
+   TTreeExporter(TTree *tree = 0, const char *columns = "");
+   virtual ~TTreeExporter() { }
+
+   Long64_t Export(const char *filename);
+
+   void     SetTree(TTree *tree)               { fTree = tree; }
+   void     SetColumns(const char *columns)    { fColumns = columns; }
+   void     SetSelection(const char *selection){ fSelection = selection; }
+   void     SetDelimiter(char delimiter)       { fDelimiter = delimiter; }
+   void     SetHeader(Bool_t header = kTRUE)   { fHeader = header; }
+
+   ClassDef(TTreeExporter,0)  //Parallel tree-to-text export with ordered output
+};
+
+#endif
@@ -121,6 +121,9 @@ protected:
 
    LongDouble_t*        fConstLD;   //! local version of fConsts able to store bigger numbers
 
+   typedef Double_t (*TreeJitFunc_t)(const Double_t*);
+   TreeJitFunc_t        fJitFunc;   //! Native version of the expression compiled by the interpreter's JIT, see TryJitCompile.
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -142,6 +145,7 @@ protected:
    void              LoadBranches();
    Bool_t            LoadCurrentDim();
    void              ResetDimensions();
+   void              TryJitCompile();
 
    virtual TClass*   EvalClass(Int_t oper) const;
    virtual Bool_t    IsLeafInteger(Int_t code) const;
@@ -38,6 +38,7 @@ protected:
    TTreeFormula  *fMinorFormula;        //! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
+   mutable Long64_t fLastLookupPos;     //! Position found by the previous FindValues, cursor of the sequential-alignment fast path
 
 private:
    TTreeIndex(const TTreeIndex&);            // Not implemented.
@@ -48,6 +49,7 @@ public:
    TTreeIndex(const TTree *T, const char *majorname, const char *minorname);
    virtual               ~TTreeIndex();
    virtual void           Append(const TVirtualIndex *,Bool_t delaySort = kFALSE);
+   virtual Long64_t       AppendNewEntries();
    bool                   ConvertOldToNew();
    Long64_t               FindValues(Long64_t major, Long64_t minor) const;
    virtual Long64_t       GetEntryNumberFriend(const TTree *parent);
@@ -0,0 +1,75 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeIndexHash
+#define ROOT_TTreeIndexHash
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeIndexHash                                                       //
+//                                                                      //
+// A Tree Index with majorname and minorname based on an                //
+// open-addressing hash table instead of sorted tables.                 //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "TVirtualIndex.h"
+#include "TTreeFormula.h"
+
+class TTreeIndexHash : public TVirtualIndex {
+
+protected:
+   TString        fMajorName;           // Index major name
+   TString        fMinorName;           // Index minor name
+   Long64_t       fN;                   // Number of indexed entries
+   Long64_t       fNslots;              // Number of slots in the hash table (power of two)
+   ULong64_t     *fHashes;              //[fNslots] Hash of the pair major,minor per slot, 0 marks an empty slot
+   Long64_t      *fEntries;             //[fNslots] Entry serial number per slot
+   TTreeFormula  *fMajorFormula;        //! Pointer to major TreeFormula
+   TTreeFormula  *fMinorFormula;        //! Pointer to minor TreeFormula
+   TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
+   TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
+
+   void                   Insert(ULong64_t hash, Long64_t entry);
+   void                   Rehash(Long64_t nslots);
+   static ULong64_t       HashPair(Long64_t major, Long64_t minor);
+   static Long64_t        SlotsForEntries(Long64_t n);
+
+private:
+   TTreeIndexHash(const TTreeIndexHash&);            // Not implemented.
+   TTreeIndexHash &operator=(const TTreeIndexHash&); // Not implemented.
+
+public:
+   TTreeIndexHash();
+   TTreeIndexHash(const TTree *T, const char *majorname, const char *minorname);
+   virtual               ~TTreeIndexHash();
+   virtual void           Append(const TVirtualIndex *,Bool_t delaySort = kFALSE);
+   virtual Long64_t       AppendNewEntries();
+   virtual Long64_t       GetEntryNumberFriend(const TTree *parent);
+   virtual Long64_t       GetEntryNumberWithIndex(Long64_t major, Long64_t minor) const;
+   virtual Long64_t       GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor) const;
+   const char            *GetMajorName()    const {return fMajorName.Data();}
+   const char            *GetMinorName()    const {return fMinorName.Data();}
+   virtual Long64_t       GetN()            const {return fN;}
+   virtual Long64_t       GetNslots()       const {return fNslots;}
+   virtual TTreeFormula  *GetMajorFormula();
+   virtual TTreeFormula  *GetMinorFormula();
+   virtual TTreeFormula  *GetMajorFormulaParent(const TTree *parent);
+   virtual TTreeFormula  *GetMinorFormulaParent(const TTree *parent);
+   virtual void           Print(Option_t *option="") const;
+   virtual void           UpdateFormulaLeaves(const TTree *parent);
+   virtual void           SetTree(const TTree *T);
+
+   ClassDef(TTreeIndexHash,1);  //A hash table based Tree Index with majorname and minorname.
+};
+
+#endif
@@ -24,6 +24,8 @@
 #include "TVirtualPerfStats.h"
 #include "TString.h"
 
+#include <map>
+
 
 class TBrowser;
 class TFile;
@@ -58,6 +60,24 @@ protected:
    TStopwatch   *fWatch;         //TStopwatch pointer
    TGaxis       *fRealTimeAxis;  //pointer to TGaxis object showing real-time
    TText        *fHostInfoText;  //Graphics Text object with the fHostInfo data
+   Int_t         fSampling;      //graph sampling period (record 1 read out of fSampling, 0/1 = all)
+   Int_t         fRingSize;      //size of the ring buffer of recent reads (0 = disabled)
+   Int_t         fRingNext;      //!next slot to be overwritten in the ring buffer
+   Long64_t      fRingTotal;     //!total number of reads seen by the ring buffer
+   Double_t     *fRingEntry;     //![fRingSize] tree entry number of recent reads
+   Double_t     *fRingOffset;    //![fRingSize] file offset of recent reads (bytes)
+   Double_t     *fRingLen;       //![fRingSize] length of recent reads (bytes)
+   Double_t     *fRingTime;      //![fRingSize] duration of recent reads (seconds)
+   Long64_t     *fLeafBytes;     //![fNleaves] bytes read per leaf (EnableBranchStats)
+   Double_t     *fLeafTime;      //![fNleaves] disk time per leaf (seconds)
+   Int_t        *fLeafReads;     //![fNleaves] read calls per leaf
+   Long64_t      fOtherBytes;    //!bytes read not attributed to a single leaf (eg cache prefetches)
+   Double_t      fOtherTime;     //!disk time not attributed to a single leaf
+   std::map<Long64_t,Int_t> *fSeekMap; //!map of basket seek position to leaf index
+   TString       fLiveFileName;  //!file name for the periodic live JSON snapshots
+   Int_t         fLivePeriod;    //!number of read calls between two live snapshots
+
+   Int_t         LeafIndex(Long64_t offset);
 
 public:
    TTreePerfStats();
@@ -66,7 +86,12 @@ public:
    virtual void     Browse(TBrowser *b);
    virtual Int_t    DistancetoPrimitive(Int_t px, Int_t py);
    virtual void     Draw(Option_t *option="");
+   virtual void     DumpLive();
+   virtual void     EnableBranchStats();
+   virtual void     EnableRingBuffer(Int_t nevents=10000);
    virtual void     ExecuteEvent(Int_t event, Int_t px, Int_t py);
+   virtual void     ExportFolded(const char *filename) const;
+   virtual void     ExportJSON(const char *filename) const;
    virtual void     Finish();
    virtual Long64_t GetBytesRead() const {return fBytesRead;}
    virtual Long64_t GetBytesReadExtra() const {return fBytesReadExtra;}
@@ -82,6 +107,9 @@ public:
    virtual Int_t    GetReadaheadSize() const {return fReadaheadSize;}
    virtual Int_t    GetReadCalls() const {return fReadCalls;}
    virtual Double_t GetRealTime()  const {return fRealTime;}
+   virtual Int_t    GetRingSize() const {return fRingSize;}
+   virtual Long64_t GetRingTotal() const {return fRingTotal;}
+   virtual Int_t    GetSampling() const {return fSampling;}
    TStopwatch      *GetStopwatch() const {return fWatch;}
    virtual Int_t    GetTreeCacheSize() const {return fTreeCacheSize;}
    virtual Double_t GetUnzipTime() const {return fUnzipTime; }
@@ -108,16 +136,18 @@ public:
    virtual void     SetGraphIO(TGraphErrors *gr) {fGraphIO = gr;}
    virtual void     SetGraphTime(TGraphErrors *gr) {fGraphTime = gr;}
    virtual void     SetHostInfo(const char *info) {fHostInfo = info;}
+   virtual void     SetLiveExport(const char *filename, Int_t period=1000);
    virtual void     SetName(const char *name) {fName = name;}
    virtual void     SetNleaves(Int_t nleaves) {fNleaves = nleaves;}
    virtual void     SetReadaheadSize(Int_t nbytes) {fReadaheadSize = nbytes;}
    virtual void     SetReadCalls(Int_t ncalls) {fReadCalls = ncalls;}
    virtual void     SetRealNorm(Double_t rnorm) {fRealNorm = rnorm;}
+   virtual void     SetSampling(Int_t period) {fSampling = period;}
    virtual void     SetRealTime(Double_t rtime) {fRealTime = rtime;}
    virtual void     SetTreeCacheSize(Int_t nbytes) {fTreeCacheSize = nbytes;}
    virtual void     SetUnzipTime(Double_t uztime) {fUnzipTime = uztime;}
 
-   ClassDef(TTreePerfStats,6)  // TTree I/O performance measurement
+   ClassDef(TTreePerfStats,7)  // TTree I/O performance measurement
 };
 
 #endif
@@ -53,6 +53,7 @@ protected:
    TList         *fInput;           //! input list to the selector
    TList         *fFormulaList;     //! Pointer to a list of coordinated list TTreeFormula (used by Scan and Query)
    TSelector     *fSelectorUpdate;  //! Set to the selector address when it's entry list needs to be updated by the UpdateFormulaLeaves function
+   Long64_t       fDrawSample;      //! Target number of sampled entries set by DrawSelect's sample(n) option, 0 for a full loop
 
 protected:
    const   char  *GetNameByIndex(TString &varexp, Int_t *index,Int_t colindex);
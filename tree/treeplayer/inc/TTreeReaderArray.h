@@ -41,6 +41,7 @@ namespace Internal {
 
    protected:
       void* UntypedAt(size_t idx) const { return fImpl->At(GetProxy(), idx); }
+      void* UntypedData() const { return fImpl->GetContiguousStart(GetProxy()); }
       virtual void CreateProxy();
       bool GetBranchAndLeaf(TBranch* &branch, TLeaf* &myLeaf,
                             TDictionary* &branchActualType);
@@ -130,6 +131,15 @@ public:
    T& At(size_t idx) { return *(T*)UntypedAt(idx); }
    T& operator[](size_t idx) { return At(idx); }
 
+   // Return a pointer to the first element if the elements of the current
+   // entry are stored contiguously in memory (e.g. a vector of values, a
+   // leaf-list array or a split object array), and a null pointer for layouts
+   // that need the per-element collection proxy indirection. Together with
+   // GetSize() this gives raw access to the entry's data without a virtual
+   // call per element; the pointer is only valid until the next entry is
+   // loaded.
+   T* Data() { return (T*)UntypedData(); }
+
    Iterator_t begin() {
       // Return an iterator to the 0th TTree entry or an empty iterator if the
       // array is empty.
@@ -69,6 +69,10 @@ namespace Internal {
       virtual ~TVirtualCollectionReader();
       virtual size_t GetSize(Detail::TBranchProxy*) = 0;
       virtual void* At(Detail::TBranchProxy*, size_t /*idx*/) = 0;
+      // Address of the first element if the elements of the current entry are
+      // stored contiguously in memory, 0 otherwise. Readers that go through a
+      // collection proxy with a per-element indirection keep the default.
+      virtual void* GetContiguousStart(Detail::TBranchProxy*) { return 0; }
    };
 
 }
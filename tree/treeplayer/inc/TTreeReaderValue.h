@@ -96,7 +96,7 @@ namespace Internal {
 
       Detail::TBranchProxy* GetProxy() const { return fProxy; }
 
-      void MarkTreeReaderUnavailable() { fTreeReader = 0; fSetupStatus = kSetupTreeDestructed; }
+      void MarkTreeReaderUnavailable() { fTreeReader = 0; fSetupStatus = kSetupTreeDestructed; fCachedWhere = 0; }
 
       /// Stringify the template argument.
       static std::string GetElementTypeName(const std::type_info& ti);
@@ -109,6 +109,8 @@ namespace Internal {
       TLeaf*       fLeaf;
       ESetupStatus fSetupStatus; // setup status of this data access
       EReadStatus  fReadStatus; // read status of this data access
+      void*        fCachedWhere; //! steady-state data pointer cached by TTreeReaderValue<T>::Get()
+      Int_t        fCachedGeneration; //! proxy setup generation fCachedWhere was resolved against
       std::vector<Long64_t> fStaticClassOffsets;
 
       // FIXME: re-introduce once we have ClassDefInline!
@@ -131,12 +133,31 @@ public:
                            TDictionary::GetDictionary(typeid(NonConstT_t))) {}
 
    T* Get() {
+      if (fCachedWhere) {
+         // Steady state: the resolved address can only move when the proxy
+         // runs Setup() again (e.g. on the next tree of a chain), so a
+         // compare of the setup generation is enough to revalidate it and
+         // the dereference reduces to TBranchProxy::Read() plus one load.
+         if (fProxy->Read() && fCachedGeneration == fProxy->GetSetupGeneration()) {
+            fReadStatus = kReadSuccess;
+            return (T*)fCachedWhere;
+         }
+         fCachedWhere = 0;
+      }
       if (!fProxy){
          Error("Get()", "Value reader not properly initialized, did you remember to call TTreeReader.Set(Next)Entry()?");
          return 0;
       }
       void *address = GetAddress(); // Needed to figure out if it's a pointer
-      return fProxy->IsaPointer() ? *(T**)address : (T*)address; }
+      Bool_t isPointer = fProxy->IsaPointer();
+      // Cache the resolved address when nothing in the resolution can change
+      // from one entry to the next: fundamental types and flat structs read
+      // without per-entry pointer chasing.
+      if (address && !isPointer && fLeafName.Length() == 0 && fStaticClassOffsets.empty()) {
+         fCachedWhere = address;
+         fCachedGeneration = fProxy->GetSetupGeneration();
+      }
+      return isPointer ? *(T**)address : (T*)address; }
    T* operator->() { return Get(); }
    T& operator*() { return *Get(); }
 
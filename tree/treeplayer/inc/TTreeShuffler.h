@@ -0,0 +1,54 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeShuffler
+#define ROOT_TTreeShuffler
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeShuffler                                                        //
+//                                                                      //
+// Export the entries of a TTree in shuffled order at near-sequential   //
+// throughput, by permuting entries only inside a bounded window of     //
+// whole clusters so that every read is served by the TTreeCache.       //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+
+class TTree;
+
+class TTreeShuffler : public TObject {
+
+protected:
+   TTree      *fTree;           ///< input tree (not owned)
+   Int_t       fWindowClusters; ///< number of clusters shuffled together
+   UInt_t      fSeed;           ///< seed of the random generator
+   Long64_t    fCacheSize;      ///< cache size set on the input tree, 0 leaves it untouched
+
+public:
+   TTreeShuffler(TTree *tree = 0);
+   virtual ~TTreeShuffler() { }
+
+   TTree   *Shuffle();
+
+   Int_t    GetWindowClusters() const { return fWindowClusters; }
+   UInt_t   GetSeed() const           { return fSeed; }
+   Long64_t GetCacheSize() const      { return fCacheSize; }
+
+   void     SetTree(TTree *tree)            { fTree = tree; }
+   void     SetWindowClusters(Int_t n)      { fWindowClusters = (n > 0) ? n : 1; }
+   void     SetSeed(UInt_t seed)            { fSeed = seed; }
+   void     SetCacheSize(Long64_t nbytes)   { fCacheSize = nbytes; }
+
+   ClassDef(TTreeShuffler,0)  //Windowed shuffling exporter for TTree entries
+};
+
+#endif
@@ -0,0 +1,61 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeTransformer
+#define ROOT_TTreeTransformer
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeTransformer                                                     //
+//                                                                      //
+// Produce a derived TTree from a declarative column mapping: drop      //
+// branches, rename branches and define recomputed columns, in a        //
+// single native pass. Untouched branches are carried over with a fast  //
+// clone, i.e. their baskets are copied at the compressed level and     //
+// are never deserialized; only the inputs of the defined columns are   //
+// actually read.                                                       //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+#include "TString.h"
+
+#include <utility>
+#include <vector>
+
+class TTree;
+
+class TTreeTransformer : public TObject {
+
+protected:
+   TTree    *fTree;      ///< input tree (not owned)
+   Long64_t  fCacheSize; ///< cache size set on the input tree, 0 leaves it untouched
+
+   std::vector<TString>                     fDrops;   ///< branch name patterns to drop
+   std::vector<std::pair<TString,TString> > fRenames; ///< (old name, new name) pairs
+   std::vector<std::pair<TString,TString> > fDefines; ///< (column name, expression) pairs
+
+public:
+   TTreeTransformer(TTree *tree = 0);
+   virtual ~TTreeTransformer() { }
+
+   void     Drop(const char *pattern);
+   void     Rename(const char *oldname, const char *newname);
+   void     Define(const char *name, const char *expression);
+
+   TTree   *Transform();
+
+   void     SetTree(TTree *tree)          { fTree = tree; }
+   void     SetCacheSize(Long64_t nbytes) { fCacheSize = nbytes; }
+
+   ClassDef(TTreeTransformer,0)  //Declarative drop/rename/recompute tree transform
+};
+
+#endif
@@ -29,7 +29,7 @@ ROOT::Detail::TBranchProxy::TBranchProxy() :
    fDataMember(""), fIsMember(false), fIsClone(false), fIsaPointer(0),
    fClassName(""), fClass(0), fElement(0), fMemberOffset(0), fOffset(0),
    fBranch(0), fBranchCount(0),
-   fLastTree(0), fRead(-1), fWhere(0),fCollection(0), fCurrentTreeNumber(-1)
+   fLastTree(0), fRead(-1), fWhere(0),fCollection(0), fCurrentTreeNumber(-1), fSetupGeneration(0)
 {
    // Constructor.
 };
@@ -40,7 +40,7 @@ ROOT::Detail::TBranchProxy::TBranchProxy(TBranchProxyDirector* boss, const char*
    fDataMember(""), fIsMember(false), fIsClone(false), fIsaPointer(false),
    fClassName(""), fClass(0), fElement(0), fMemberOffset(0), fOffset(0),
    fBranch(0), fBranchCount(0),
-   fLastTree(0), fRead(-1),  fWhere(0),fCollection(0), fCurrentTreeNumber(-1)
+   fLastTree(0), fRead(-1),  fWhere(0),fCollection(0), fCurrentTreeNumber(-1), fSetupGeneration(0)
 {
    // Constructor.
 
@@ -56,7 +56,7 @@ ROOT::Detail::TBranchProxy::TBranchProxy(TBranchProxyDirector* boss, const char
    fDataMember(membername), fIsMember(true), fIsClone(false), fIsaPointer(false),
    fClassName(""), fClass(0), fElement(0), fMemberOffset(0), fOffset(0),
    fBranch(0), fBranchCount(0),
-   fLastTree(0), fRead(-1), fWhere(0),fCollection(0), fCurrentTreeNumber(-1)
+   fLastTree(0), fRead(-1), fWhere(0),fCollection(0), fCurrentTreeNumber(-1), fSetupGeneration(0)
 {
    // Constructor.
 
@@ -75,7 +75,7 @@ ROOT::Detail::TBranchProxy::TBranchProxy(TBranchProxyDirector* boss, Detail::TBr
    fDataMember(membername), fIsMember(true), fIsClone(false), fIsaPointer(false),
    fClassName(""), fClass(0), fElement(0), fMemberOffset(0), fOffset(0),
    fBranch(0), fBranchCount(0),
-   fLastTree(0), fRead(-1), fWhere(0),fCollection(0), fCurrentTreeNumber(-1)
+   fLastTree(0), fRead(-1), fWhere(0),fCollection(0), fCurrentTreeNumber(-1), fSetupGeneration(0)
 {
    // Constructor.
 
@@ -93,7 +93,7 @@ ROOT::Detail::TBranchProxy::TBranchProxy(TBranchProxyDirector* boss, TBranch* br
    fDataMember(membername), fIsMember(membername != 0 && membername[0]), fIsClone(false), fIsaPointer(false),
    fClassName(""), fClass(0), fElement(0), fMemberOffset(0), fOffset(0),
    fBranch(0), fBranchCount(0),
-   fLastTree(0), fRead(-1), fWhere(0),fCollection(0), fCurrentTreeNumber(-1)
+   fLastTree(0), fRead(-1), fWhere(0),fCollection(0), fCurrentTreeNumber(-1), fSetupGeneration(0)
 {
    // Constructor.
 
@@ -436,6 +436,7 @@ Bool_t ROOT::Detail::TBranchProxy::Setup()
       fLastTree = fDirector->GetTree();
       fCurrentTreeNumber = fLastTree->GetTreeNumber();
       fInitialized = true;
+      ++fSetupGeneration;
       return true;
    } else {
       return false;
@@ -0,0 +1,304 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeExporter
+Export tree columns to delimiter-separated text at I/O speed.
+
+TTreePlayer::Scan formats every field with Form() on a single thread,
+which caps large CSV exports far below disk speed.  TTreeExporter
+targets the bulk-export case:
+
+  - the entry range is partitioned along cluster boundaries, so every
+    worker decompresses only whole baskets;
+  - with implicit multi-threading enabled the partitions are scanned in
+    parallel, each worker reading the file through its own TFile so the
+    workers share nothing;
+  - fields are formatted with direct integer/float-to-string conversion
+    into a per-worker buffer, avoiding the Form() buffer and one format
+    parse per field;
+  - the buffers are written to the output file in entry order, a wave of
+    partitions at a time, so memory stays bounded by
+    (workers x partition size) while the output is exactly what a serial
+    scan would produce.
+
+~~~{.cpp}
+ROOT::EnableImplicitMT();
+TTreeExporter exporter(tree, "run:event:jet_pt[0]:Sum$(jet_pt)");
+exporter.SetSelection("njet > 0");
+Long64_t rows = exporter.Export("jets.csv");
+~~~
+
+Column and selection expressions use the TTreeFormula syntax; each
+column is evaluated at instance 0, i.e. exported columns are scalars.
+Parallel scanning needs a tree that lives in the top directory of a
+file; chains and in-memory trees are exported serially with the same
+formatting fast path.
+*/
+
+#include "TTreeExporter.h"
+
+#include "TError.h"
+#include "TFile.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+ClassImp(TTreeExporter)
+
+namespace {
+
+   /// Append v to buf without going through a format string: integers are
+   /// converted by hand, everything else with the shortest round-trippable
+   /// %g conversion.
+   void AppendValue(std::string &buf, Double_t v, Bool_t isInteger)
+   {
+      char tmp[40];
+      if (isInteger) {
+         Long64_t x = (Long64_t)v;
+         char *end = tmp + sizeof(tmp);
+         char *p = end;
+         ULong64_t u = (ULong64_t)x;
+         if (x < 0) u = 0 - u;   // two's complement, safe also for kMinLong64
+         do { *--p = (char)('0' + u % 10); u /= 10; } while (u);
+         if (x < 0) *--p = '-';
+         buf.append(p, end - p);
+      } else {
+         buf.append(tmp, snprintf(tmp, sizeof(tmp), "%.9g", v));
+      }
+   }
+
+   /// Scan the entries [first, last) of the given tree and format the
+   /// selected rows into buf. The formulas and the tree belong to the
+   /// calling worker. Returns the number of rows kept.
+   Long64_t FormatRange(TTree *tree, std::vector<TTreeFormula*> &columns,
+                        TTreeFormula *selection, Long64_t first, Long64_t last,
+                        char delimiter, std::string &buf)
+   {
+      Long64_t rows = 0;
+      Int_t treenumber = -1;
+      for (Long64_t entry = first; entry < last; entry++) {
+         if (tree->LoadTree(entry) < 0) break;
+         if (treenumber != tree->GetTreeNumber()) {
+            treenumber = tree->GetTreeNumber();
+            for (std::size_t i = 0; i < columns.size(); i++)
+               columns[i]->UpdateFormulaLeaves();
+            if (selection) selection->UpdateFormulaLeaves();
+         }
+         if (selection) {
+            selection->GetNdata();
+            if (selection->EvalInstance(0) == 0) continue;
+         }
+         for (std::size_t i = 0; i < columns.size(); i++) {
+            if (i) buf.push_back(delimiter);
+            columns[i]->GetNdata();
+            AppendValue(buf, columns[i]->EvalInstance(0), columns[i]->IsInteger());
+         }
+         buf.push_back('\n');
+         ++rows;
+      }
+      return rows;
+   }
+
+   /// Create the column and selection formulas against tree. Returns false
+   /// (and cleans up) when any expression is invalid.
+   Bool_t MakeFormulas(TTree *tree, const std::vector<TString> &expressions,
+                       const TString &selection, std::vector<TTreeFormula*> &columns,
+                       TTreeFormula *&selform)
+   {
+      for (std::size_t i = 0; i < expressions.size(); i++) {
+         TTreeFormula *f = new TTreeFormula(expressions[i], expressions[i], tree);
+         if (f->GetNdim() <= 0) {
+            delete f;
+            for (std::size_t j = 0; j < columns.size(); j++) delete columns[j];
+            columns.clear();
+            return kFALSE;
+         }
+         columns.push_back(f);
+      }
+      selform = 0;
+      if (selection.Length() > 0) {
+         selform = new TTreeFormula("selection", selection, tree);
+         if (selform->GetNdim() <= 0) {
+            delete selform;
+            selform = 0;
+            for (std::size_t j = 0; j < columns.size(); j++) delete columns[j];
+            columns.clear();
+            return kFALSE;
+         }
+      }
+      return kTRUE;
+   }
+
+   void DeleteFormulas(std::vector<TTreeFormula*> &columns, TTreeFormula *selform)
+   {
+      for (std::size_t j = 0; j < columns.size(); j++) delete columns[j];
+      columns.clear();
+      delete selform;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an exporter for the given tree and ":"-separated column
+/// expressions, e.g. "run:event:Sum$(jet_pt)".
+
+TTreeExporter::TTreeExporter(TTree *tree /*= 0*/, const char *columns /*= ""*/)
+   : fTree(tree), fColumns(columns), fSelection(), fDelimiter(','), fHeader(kTRUE)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Export the selected rows of the configured columns to filename and
+/// return the number of rows written, or -1 on error.
+
+Long64_t TTreeExporter::Export(const char *filename)
+{
+   if (!fTree) {
+      Error("Export", "no input tree set");
+      return -1;
+   }
+   if (fColumns.Length() == 0) {
+      Error("Export", "no columns set");
+      return -1;
+   }
+
+   std::vector<TString> expressions;
+   TObjArray *tokens = fColumns.Tokenize(":");
+   for (Int_t i = 0; i <= tokens->GetLast(); i++)
+      expressions.push_back(((TObjString*)tokens->At(i))->GetString());
+   delete tokens;
+   if (expressions.empty()) {
+      Error("Export", "no columns set");
+      return -1;
+   }
+
+   FILE *out = fopen(filename, "w");
+   if (!out) {
+      Error("Export", "cannot open output file %s", filename);
+      return -1;
+   }
+
+   if (fHeader) {
+      std::string header;
+      for (std::size_t i = 0; i < expressions.size(); i++) {
+         if (i) header.push_back(fDelimiter);
+         header.append(expressions[i].Data());
+      }
+      header.push_back('\n');
+      fwrite(header.data(), 1, header.size(), out);
+   }
+
+   Long64_t nentries = fTree->GetEntries();
+   Long64_t rows = 0;
+
+#ifdef R__USE_IMT
+   // Parallel path: plain tree in the top directory of a file, so every
+   // worker can reach it through its own TFile.
+   TFile *file = fTree->GetCurrentFile();
+   const Bool_t parallel = ROOT::IsImplicitMTEnabled() && nentries > 0 && file &&
+                           fTree->GetTree() == fTree &&
+                           fTree->GetDirectory() == (TDirectory*)file;
+   if (parallel) {
+      // Partition along cluster boundaries into roughly 4 chunks per worker.
+      const UInt_t nworkers = ROOT::GetImplicitMTPoolSize() > 0 ? ROOT::GetImplicitMTPoolSize() : 1;
+      const Long64_t target = nentries / (4 * (Long64_t)nworkers) + 1;
+      std::vector<std::pair<Long64_t,Long64_t> > ranges;
+      TTree::TClusterIterator clusterIter = fTree->GetClusterIterator(0);
+      Long64_t start = 0;
+      while (start < nentries) {
+         Long64_t end = start;
+         while (end < nentries && end - start < target)
+            end = clusterIter.Next();
+         if (end <= start || end > nentries) end = nentries;
+         ranges.push_back(std::make_pair(start, end));
+         start = end;
+      }
+
+      const std::string fname = file->GetName();
+      const std::string tname = fTree->GetName();
+      const TString selection = fSelection;
+      const char delimiter = fDelimiter;
+
+      auto scanRange = [&](unsigned int ichunk) -> std::pair<Long64_t, std::string> {
+         std::pair<Long64_t, std::string> result(-1, std::string());
+         TFile *wfile = TFile::Open(fname.c_str(), "READ");
+         if (!wfile || wfile->IsZombie()) { delete wfile; return result; }
+         TTree *wtree = (TTree*)wfile->Get(tname.c_str());
+         if (!wtree) { delete wfile; return result; }
+         std::vector<TTreeFormula*> columns;
+         TTreeFormula *selform = 0;
+         if (!MakeFormulas(wtree, expressions, selection, columns, selform)) {
+            delete wfile;
+            return result;
+         }
+         result.second.reserve(64 * (ranges[ichunk].second - ranges[ichunk].first));
+         result.first = FormatRange(wtree, columns, selform, ranges[ichunk].first,
+                                    ranges[ichunk].second, delimiter, result.second);
+         DeleteFormulas(columns, selform);
+         delete wfile;
+         return result;
+      };
+
+      // Scan a wave of partitions at a time and write each wave in entry
+      // order, keeping memory bounded while the output stays ordered.
+      ROOT::TThreadExecutor pool;
+      Bool_t failed = kFALSE;
+      for (std::size_t wave = 0; wave < ranges.size() && !failed; wave += nworkers) {
+         const unsigned int lo = (unsigned int)wave;
+         const unsigned int hi = (unsigned int)TMath::Min(ranges.size(), wave + nworkers);
+         std::vector<unsigned int> chunks;
+         for (unsigned int c = lo; c < hi; c++) chunks.push_back(c);
+         std::vector<std::pair<Long64_t, std::string> > results = pool.Map(scanRange, chunks);
+         for (std::size_t r = 0; r < results.size(); r++) {
+            if (results[r].first < 0) { failed = kTRUE; break; }
+            fwrite(results[r].second.data(), 1, results[r].second.size(), out);
+            rows += results[r].first;
+         }
+      }
+      fclose(out);
+      if (failed) {
+         Error("Export", "a worker could not read tree %s from %s; is the tree in the top directory?",
+               tname.c_str(), fname.c_str());
+         return -1;
+      }
+      return rows;
+   }
+#endif
+
+   // Serial path: chains, in-memory trees, or IMT disabled. Same
+   // formatting fast path, one buffer flushed per cluster-sized batch.
+   std::vector<TTreeFormula*> columns;
+   TTreeFormula *selform = 0;
+   if (!MakeFormulas(fTree, expressions, fSelection, columns, selform)) {
+      fclose(out);
+      Error("Export", "invalid column or selection expression");
+      return -1;
+   }
+   const Long64_t batch = 65536;
+   std::string buf;
+   for (Long64_t first = 0; first < nentries; first += batch) {
+      buf.clear();
+      Long64_t last = TMath::Min(nentries, first + batch);
+      rows += FormatRange(fTree, columns, selform, first, last, fDelimiter, buf);
+      fwrite(buf.data(), 1, buf.size(), out);
+   }
+   DeleteFormulas(columns, selform);
+   fclose(out);
+   return rows;
+}
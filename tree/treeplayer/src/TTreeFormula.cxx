@@ -50,7 +50,9 @@
 #include <stdio.h>
 #include <math.h>
 #include <stdlib.h>
+#include <atomic>
 #include <typeinfo>
+#include <type_traits>
 #include <algorithm>
 
 const Int_t kMaxLen     = 1024;
@@ -137,6 +139,7 @@ TTreeFormula::TTreeFormula(): ROOT::v5::TFormula(), fQuickLoad(kFALSE), fNeedLoa
    fManager      = 0;
    fMultiplicity = 0;
    fConstLD      = 0;
+   fJitFunc      = 0;
 
    Int_t j,k;
    for (j=0; j<kMAXCODES; j++) {
@@ -187,6 +190,7 @@ void TTreeFormula::Init(const char*name, const char* expression)
    fAxis         = 0;
    fHasCast      = 0;
    fConstLD      = 0;
+   fJitFunc      = 0;
    Int_t i,j,k;
    fManager      = new TTreeFormulaManager;
    fManager->Add(this);
@@ -316,6 +320,8 @@ void TTreeFormula::Init(const char*name, const char* expression)
 
    }
 
+   TryJitCompile();
+
    if(savedir) savedir->cd();
 }
 
@@ -3918,6 +3924,155 @@ template<> inline LongDouble_t TTreeFormula::GetConstant(Int_t k) {
 }
 template<> inline Long64_t TTreeFormula::GetConstant(Int_t k) { return (Long64_t)GetConstant<LongDouble_t>(k); }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Attempt to compile the parsed expression into a native function using the
+/// interpreter's just-in-time compiler, like TFormula does for function
+/// expressions.
+///
+/// This is only done for expressions made of pure numeric arithmetic on plain
+/// scalar leaves (multiplicity 0, lookup type kDirect): the per-entry opcode
+/// interpretation loop of EvalInstance is then replaced by a single call into
+/// the compiled function, which matters for TTree::Draw selections evaluated
+/// over many entries. Expressions involving strings, arrays, aliases,
+/// external cuts, method calls, ternaries or special variables keep using the
+/// interpreted path; the transpilation below reproduces the exact semantics
+/// (including the indetermination conventions) of the corresponding opcodes
+/// in EvalInstance and bails out on any opcode it does not know.
+
+void TTreeFormula::TryJitCompile()
+{
+   fJitFunc = 0;
+
+   if (fNoper <= 1 || fNcodes <= 0 || fNcodes >= kMAXCODES) return;
+   if (fMultiplicity != 0 || fAxis || fHasCast) return;
+   if (TestBit(kMissingLeaf) || TestBit(kNeedEntries) || TestBit(kIsCharacter)) return;
+
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      if (fCodes[code] < 0 || fLookupType[code] != kDirect) return;
+      if (fNdimensions[code] != 0) return;
+      TLeaf *leaf = code <= fLeaves.GetLast() ? (TLeaf*)fLeaves.UncheckedAt(code) : 0;
+      if (!leaf || leaf->GetLeafCount() || leaf->GetLenStatic() != 1) return;
+      if (IsLeafString(code)) return;
+   }
+
+   // Transpile the postfix opcode list into a C++ expression by simulating
+   // the evaluation stack with strings.
+   std::vector<TString> stack;
+   Bool_t bad = kFALSE;
+   auto pop = [&stack, &bad]() -> TString {
+      if (stack.empty()) { bad = kTRUE; return ""; }
+      TString t = stack.back(); stack.pop_back(); return t;
+   };
+   auto unary = [&stack, &pop](const char *fmt) {
+      TString a = pop();
+      stack.push_back(TString::Format(fmt, a.Data(), a.Data(), a.Data()));
+   };
+   auto binary = [&stack, &pop](const char *fmt) {
+      TString b = pop();
+      TString a = pop();
+      stack.push_back(TString::Format(fmt, a.Data(), b.Data(), a.Data(), b.Data()));
+   };
+
+   for (Int_t i = 0; i < fNoper && !bad; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t newaction = oper >> kTFOperShift;
+
+      if (newaction == kDefinedVariable) {
+         stack.push_back(TString::Format("x[%d]", (oper & kTFOperMask)));
+         continue;
+      }
+      if (newaction > kDefinedVariable) return;   // alias, string, MinIf$, ...
+
+      switch (newaction) {
+         case kEnd        : i = fNoper; continue;
+         case kConstant   : stack.push_back(TString::Format("%.17g",
+                               (Double_t)GetConstant<LongDouble_t>(oper & kTFOperMask))); continue;
+         case kpi         : stack.push_back("acos(-1.0)"); continue;
+         // The operands of the safe opcodes are free of side effects, so the
+         // strict evaluation of && and || below yields the same value as the
+         // interpreter's boolean short-circuit optimization.
+         case kBoolOptimize: continue;
+
+         case kAdd        : binary("(%s + %s)"); continue;
+         case kSubstract  : binary("(%s - %s)"); continue;
+         case kMultiply   : binary("(%s * %s)"); continue;
+         case kDivide     : {
+            // The divisor comes first in the emitted code, so this one cannot
+            // go through the binary() helper.
+            TString b = pop();
+            TString a = pop();
+            stack.push_back(TString::Format("((%s) == 0 ? 0.0 : (%s) / (%s))",
+                            b.Data(), a.Data(), b.Data()));
+            break;
+         }
+         case kModulo     : binary("(double)((long long)(%s) %% (long long)(%s))"); continue;
+
+         case kcos        : unary("cos(%s)"); continue;
+         case ksin        : unary("sin(%s)"); continue;
+         case ktan        : unary("(cos(%s) == 0 ? 0.0 : tan(%s))"); continue;
+         case kacos       : unary("(fabs(%s) > 1 ? 0.0 : acos(%s))"); continue;
+         case kasin       : unary("(fabs(%s) > 1 ? 0.0 : asin(%s))"); continue;
+         case katan       : unary("atan(%s)"); continue;
+         case kcosh       : unary("cosh(%s)"); continue;
+         case ksinh       : unary("sinh(%s)"); continue;
+         case ktanh       : unary("(cosh(%s) == 0 ? 0.0 : tanh(%s))"); continue;
+         case kacosh      : unary("((%s) < 1 ? 0.0 : acosh(%s))"); continue;
+         case kasinh      : unary("asinh(%s)"); continue;
+         case katanh      : unary("(fabs(%s) > 1 ? 0.0 : atanh(%s))"); continue;
+         case katan2      : binary("atan2(%s, %s)"); continue;
+
+         case kfmod       : binary("fmod(%s, %s)"); continue;
+         case kpow        : binary("pow(%s, %s)"); continue;
+         case ksq         : unary("((%s) * (%s))"); continue;
+         case ksqrt       : unary("sqrt(fabs(%s))"); continue;
+
+         case kmin        : binary("(((%s) < (%s)) ? (%s) : (%s))"); continue;
+         case kmax        : binary("(((%s) > (%s)) ? (%s) : (%s))"); continue;
+
+         case klog        : unary("((%s) > 0 ? log(%s) : 0.0)"); continue;
+         case kexp        : unary("((%s) < -700 ? 0.0 : ((%s) > 700 ? exp(700.0) : exp(%s)))"); continue;
+         case klog10      : unary("((%s) > 0 ? log10(%s) : 0.0)"); continue;
+
+         case kabs        : unary("fabs(%s)"); continue;
+         case ksign       : unary("((%s) < 0 ? -1.0 : 1.0)"); continue;
+         case kint        : unary("(double)(long long)(%s)"); continue;
+         case kSignInv    : unary("(-(%s))"); continue;
+
+         case kAnd        : binary("(((%s) != 0 && (%s) != 0) ? 1.0 : 0.0)"); continue;
+         case kOr         : binary("(((%s) != 0 || (%s) != 0) ? 1.0 : 0.0)"); continue;
+
+         case kEqual      : binary("((%s) == (%s) ? 1.0 : 0.0)"); continue;
+         case kNotEqual   : binary("((%s) != (%s) ? 1.0 : 0.0)"); continue;
+         case kLess       : binary("((%s) <  (%s) ? 1.0 : 0.0)"); continue;
+         case kGreater    : binary("((%s) >  (%s) ? 1.0 : 0.0)"); continue;
+         case kLessThan   : binary("((%s) <= (%s) ? 1.0 : 0.0)"); continue;
+         case kGreaterThan: binary("((%s) >= (%s) ? 1.0 : 0.0)"); continue;
+         case kNot        : unary("((%s) != 0 ? 0.0 : 1.0)"); continue;
+
+         case kBitAnd     : binary("(double)((unsigned long long)(%s) & (unsigned long long)(%s))"); continue;
+         case kBitOr      : binary("(double)((unsigned long long)(%s) | (unsigned long long)(%s))"); continue;
+         case kLeftShift  : binary("(double)((unsigned long long)(%s) << (unsigned long long)(%s))"); continue;
+         case kRightShift : binary("(double)((unsigned long long)(%s) >> (unsigned long long)(%s))"); continue;
+
+         default          : return;  // krndm, kstrstr, kJump(If), kFunctionCall, ...
+      }
+      // kDivide reaches here: the divisor is expanded twice, guard against
+      // pathological nesting blowing up the generated source.
+      if (!stack.empty() && stack.back().Length() > 100000) return;
+   }
+   if (bad || stack.size() != 1 || stack[0].Length() > 100000) return;
+
+   static std::atomic<UInt_t> gJitFormulaCounter(0);
+   TString fnname = TString::Format("TTreeFormula__jit%u", gJitFormulaCounter++);
+   TString code = TString::Format(
+      "#include <cmath>\n"
+      "double %s(const double* x) { (void)x; return (double)(%s); }\n",
+      fnname.Data(), stack[0].Data());
+
+   if (!gInterpreter->Declare(code)) return;
+   fJitFunc = (TreeJitFunc_t)gInterpreter->ProcessLine(TString::Format("(void*)::%s;", fnname.Data()));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate this treeformula.
 
@@ -3982,6 +4137,23 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
       }
    }
 
+   if (std::is_same<T, Double_t>::value && fJitFunc && instance == 0) {
+      // The expression was compiled to native code by TryJitCompile; its
+      // eligibility conditions guarantee that every operand is a plain
+      // scalar numeric leaf read with lookup type kDirect.
+      Double_t jitvals[kMAXCODES];
+      for (Int_t code = 0; code < fNcodes; ++code) {
+         TLeaf *jleaf = (TLeaf*)fLeaves.UncheckedAt(code);
+         TBranch *jbranch = (TBranch*)fBranches.UncheckedAt(code);
+         if (jbranch) {
+            Long64_t treeEntry = jbranch->GetTree()->GetReadEntry();
+            R__LoadBranch(jbranch, treeEntry, fQuickLoad);
+         }
+         jitvals[code] = jleaf->GetTypedValue<Double_t>(0);
+      }
+      return (T)fJitFunc(jitvals);
+   }
+
    T tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -17,6 +17,11 @@ A Tree Index with majorname and minorname.
 #include "TTree.h"
 #include "TMath.h"
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TParallelSort.hxx"
+#endif
+
 ClassImp(TTreeIndex)
 
 
@@ -54,6 +59,7 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
    fMinorFormula       = 0;
    fMajorFormulaParent = 0;
    fMinorFormulaParent = 0;
+   fLastLookupPos      = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +138,7 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    fMinorFormula       = 0;
    fMajorFormulaParent = 0;
    fMinorFormulaParent = 0;
+   fLastLookupPos      = -1;
    fMajorName          = majorname;
    fMinorName          = minorname;
    if (!T) return;
@@ -179,7 +186,13 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    }
    fIndex = new Long64_t[fN];
    for(i = 0; i < fN; i++) { fIndex[i] = i; }
+#ifdef R__USE_IMT
+   // splits the sort over the implicit MT pool; plain std::sort when
+   // implicit multi-threading is not enabled
+   ROOT::ParallelSort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor));
+#else
    std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
+#endif
    //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
@@ -268,7 +281,11 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       Long64_t *conv = new Long64_t[fN];
 
       for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
+#ifdef R__USE_IMT
+      ROOT::ParallelSort(conv, conv + fN, IndexSortComparator(addValues, addValues2));
+#else
       std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
+#endif
       //Long64_t *w = fIndexValues;
       //TMath::Sort(fN,w,conv,0);
 
@@ -290,6 +307,106 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Extend the index with the entries appended to the tree since the index
+/// was built (or last extended).
+///
+/// Only the entries in [GetN(), fTree->GetEntries()) are read and evaluated;
+/// the new pairs major,minor are sorted among themselves and merged with the
+/// already sorted tables. For m new entries on top of n indexed ones the cost
+/// is O(m log m + n) instead of the O(n log n) re-read and full sort that
+/// rebuilding the index with TTree::BuildIndex would require.
+///
+/// The return value is the number of entries added to the index
+/// (0 if the tree has not grown, < 0 indicates failure).
+
+Long64_t TTreeIndex::AppendNewEntries()
+{
+   if (!fTree) return -1;
+   Long64_t nentries = fTree->GetEntries();
+   if (nentries <= fN) return 0;
+   Long64_t nnew = nentries - fN;
+
+   GetMajorFormula();
+   GetMinorFormula();
+   if (!fMajorFormula || !fMinorFormula ||
+       (fMajorFormula->GetNdim() != 1) || (fMinorFormula->GetNdim() != 1)) {
+      Error("AppendNewEntries","Cannot evaluate major=%s, minor=%s",fMajorName.Data(), fMinorName.Data());
+      return -1;
+   }
+
+   Long64_t *tmp_major = new Long64_t[nnew];
+   Long64_t *tmp_minor = new Long64_t[nnew];
+   Long64_t i;
+   Long64_t oldEntry = fTree->GetReadEntry();
+   Int_t current = -1;
+   for (i=0;i<nnew;i++) {
+      Long64_t centry = fTree->LoadTree(fN+i);
+      if (centry < 0) break;
+      if (fTree->GetTreeNumber() != current) {
+         current = fTree->GetTreeNumber();
+         fMajorFormula->UpdateFormulaLeaves();
+         fMinorFormula->UpdateFormulaLeaves();
+      }
+      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
+   }
+   Long64_t *conv = new Long64_t[nnew];
+   for(i = 0; i < nnew; i++) { conv[i] = i; }
+#ifdef R__USE_IMT
+   ROOT::ParallelSort(conv, conv + nnew, IndexSortComparator(tmp_major, tmp_minor));
+#else
+   std::sort(conv, conv + nnew, IndexSortComparator(tmp_major, tmp_minor) );
+#endif
+
+   Long64_t *newValues = new Long64_t[fN+nnew];
+   Long64_t *newValues2 = new Long64_t[fN+nnew];
+   Long64_t *newIndex = new Long64_t[fN+nnew];
+
+   // merge the sorted tail with the existing sorted tables,
+   // already indexed entries come first for equal pairs major,minor
+   Long64_t iold = 0, inew = 0, ipos = 0;
+   while (iold < fN || inew < nnew) {
+      Bool_t takeOld;
+      if (inew >= nnew) {
+         takeOld = kTRUE;
+      } else if (iold >= fN) {
+         takeOld = kFALSE;
+      } else {
+         Long64_t addMajor = tmp_major[conv[inew]];
+         Long64_t addMinor = tmp_minor[conv[inew]];
+         takeOld = (fIndexValues[iold] < addMajor ||
+                    (fIndexValues[iold] == addMajor && fIndexValuesMinor[iold] <= addMinor));
+      }
+      if (takeOld) {
+         newValues[ipos]  = fIndexValues[iold];
+         newValues2[ipos] = fIndexValuesMinor[iold];
+         newIndex[ipos]   = fIndex[iold];
+         iold++;
+      } else {
+         newValues[ipos]  = tmp_major[conv[inew]];
+         newValues2[ipos] = tmp_minor[conv[inew]];
+         newIndex[ipos]   = fN + conv[inew];
+         inew++;
+      }
+      ipos++;
+   }
+
+   delete [] tmp_major;
+   delete [] tmp_minor;
+   delete [] conv;
+   delete [] fIndexValues;
+   delete [] fIndexValuesMinor;
+   delete [] fIndex;
+   fIndexValues = newValues;
+   fIndexValuesMinor = newValues2;
+   fIndex = newIndex;
+   fN = nentries;
+   fTree->LoadTree(oldEntry);
+   return nnew;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// conversion from old 64bit indexes
 /// return true if index was converted
@@ -350,10 +467,34 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 /// find position where major|minor values are in the IndexValues tables
 /// this is the index in IndexValues table, not entry# !
 /// use lower_bound STD algorithm.
+///
+/// The search does not always bisect the full table: the position found by
+/// the previous call is kept as a cursor, and when the new pair is larger
+/// than the value at the cursor - the case of a master tree processed
+/// sequentially with keys sorted like the friend - a galloping search from
+/// the cursor brackets the lower bound first. Lookups of sorted keys are
+/// then amortized O(1) instead of O(log n) and visit the friend entries, and
+/// hence its baskets, in storage order. When the new pair is not larger than
+/// the cursor value the bisection runs on the full table as before.
 
 Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 {
    Long64_t mid, step, pos = 0, count = fN;
+   Long64_t cursor = fLastLookupPos;
+   if (cursor >= 0 && cursor < fN &&
+       (fIndexValues[cursor] < major
+        || (fIndexValues[cursor] == major && fIndexValuesMinor[cursor] < minor))) {
+      // the lower bound is above the cursor: gallop to bracket it
+      pos = cursor + 1;
+      step = 1;
+      while (pos + step <= fN
+             && (fIndexValues[pos+step-1] < major
+                 || (fIndexValues[pos+step-1] == major && fIndexValuesMinor[pos+step-1] < minor))) {
+         pos += step;
+         step *= 2;
+      }
+      count = (step - 1 < fN - pos) ? step - 1 : fN - pos;
+   }
    // find lower bound using bisection
    while( count > 0 ) {
       step = count / 2;
@@ -366,6 +507,7 @@ Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
       } else
          count = step;
    }
+   fLastLookupPos = pos;
    return pos;
 }
 
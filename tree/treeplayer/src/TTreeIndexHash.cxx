@@ -0,0 +1,489 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeIndexHash
+A Tree Index with majorname and minorname based on an open-addressing
+hash table.
+
+Compared to TTreeIndex, which keeps three sorted Long64_t tables
+(24 bytes per entry) and pays an O(n log n) sort at build time, this
+index stores one 64 bit hash of the pair (major,minor) plus one entry
+number per slot. With the default maximum load factor of 75% this is
+at most ~21 bytes per entry and typically less, the build is a single
+O(n) pass over the tree, and lookups are O(1) exact matches.
+
+The price is that only exact lookups are possible:
+GetEntryNumberWithBestIndex() cannot return the entry with the pair
+immediately lower than the requested one and behaves like
+GetEntryNumberWithIndex(). Friend trees with missing entries therefore
+still need a TTreeIndex; use TTreeIndexHash for the pure lookup case,
+e.g.
+~~~{.cpp}
+    tree->SetTreeIndex(new TTreeIndexHash(tree,"Run","Event"));
+    tree->GetEntryWithIndex(1234,56789);
+~~~
+If two distinct pairs (major,minor) collide on the same 64 bit hash
+(probability ~n^2/2^65 for n entries), the entry read last wins, just
+as for genuinely duplicate pairs.
+*/
+
+#include "TTreeIndexHash.h"
+#include "TTree.h"
+#include "TMath.h"
+
+ClassImp(TTreeIndexHash)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor for TTreeIndexHash
+
+TTreeIndexHash::TTreeIndexHash(): TVirtualIndex()
+{
+   fTree               = 0;
+   fN                  = 0;
+   fNslots             = 0;
+   fHashes             = 0;
+   fEntries            = 0;
+   fMajorFormula       = 0;
+   fMinorFormula       = 0;
+   fMajorFormulaParent = 0;
+   fMinorFormulaParent = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for TTreeIndexHash
+///
+/// Build a hash index using the leaves of Tree T with major & minor names.
+/// The expressions given in "majorname" and "minorname" are evaluated for
+/// each entry exactly as in TTreeIndex; the resulting pair major,minor is
+/// hashed to 64 bits and inserted together with the entry serial number
+/// into an open-addressing table with linear probing. No sort is performed.
+///
+/// Once the index is computed, one can retrieve one entry via
+/// ~~~{.cpp}
+///     T->GetEntryWithIndex(majornumber, minornumber)
+/// ~~~
+/// Note that majorname and minorname may be expressions using original
+/// Tree variables eg: "run-90000", "event +3*xx". However the result
+/// must be integer.
+///
+/// To build an index with only majorname, specify minorname="0" (default).
+
+TTreeIndexHash::TTreeIndexHash(const TTree *T, const char *majorname, const char *minorname)
+               : TVirtualIndex()
+{
+   fTree               = (TTree*)T;
+   fN                  = 0;
+   fNslots             = 0;
+   fHashes             = 0;
+   fEntries            = 0;
+   fMajorFormula       = 0;
+   fMinorFormula       = 0;
+   fMajorFormulaParent = 0;
+   fMinorFormulaParent = 0;
+   fMajorName          = majorname;
+   fMinorName          = minorname;
+   if (!T) return;
+   Long64_t nentries = T->GetEntries();
+   if (nentries <= 0) {
+      MakeZombie();
+      Error("TreeIndexHash","Cannot build a TreeIndexHash with a Tree having no entries");
+      return;
+   }
+
+   GetMajorFormula();
+   GetMinorFormula();
+   if (!fMajorFormula || !fMinorFormula) {
+      MakeZombie();
+      Error("TreeIndexHash","Cannot build the index with major=%s, minor=%s",fMajorName.Data(), fMinorName.Data());
+      return;
+   }
+   if ((fMajorFormula->GetNdim() != 1) || (fMinorFormula->GetNdim() != 1)) {
+      MakeZombie();
+      Error("TreeIndexHash","Cannot build the index with major=%s, minor=%s",fMajorName.Data(), fMinorName.Data());
+      return;
+   }
+
+   fNslots  = SlotsForEntries(nentries);
+   fHashes  = new ULong64_t[fNslots];
+   fEntries = new Long64_t[fNslots];
+   memset(fHashes, 0, fNslots*sizeof(ULong64_t));
+
+   Long64_t i;
+   Long64_t oldEntry = fTree->GetReadEntry();
+   Int_t current = -1;
+   for (i=0;i<nentries;i++) {
+      Long64_t centry = fTree->LoadTree(i);
+      if (centry < 0) break;
+      if (fTree->GetTreeNumber() != current) {
+         current = fTree->GetTreeNumber();
+         fMajorFormula->UpdateFormulaLeaves();
+         fMinorFormula->UpdateFormulaLeaves();
+      }
+      Long64_t majorv = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+      Long64_t minorv = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
+      Insert(HashPair(majorv,minorv), i);
+   }
+   fN = nentries;
+   fTree->LoadTree(oldEntry);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TTreeIndexHash::~TTreeIndexHash()
+{
+   if (fTree && fTree->GetTreeIndex() == this) fTree->SetTreeIndex(0);
+   delete [] fHashes;           fHashes  = 0;
+   delete [] fEntries;          fEntries = 0;
+   delete fMajorFormula;        fMajorFormula  = 0;
+   delete fMinorFormula;        fMinorFormula  = 0;
+   delete fMajorFormulaParent;  fMajorFormulaParent = 0;
+   delete fMinorFormulaParent;  fMinorFormulaParent = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hash the pair major,minor to 64 bits (splittable mix of both words).
+/// The value 0 is reserved to mark empty slots and is remapped to 1.
+
+ULong64_t TTreeIndexHash::HashPair(Long64_t major, Long64_t minor)
+{
+   ULong64_t h = (ULong64_t)major * 0x9E3779B97F4A7C15ULL ^ (ULong64_t)minor;
+   h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+   h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+   h ^= h >> 31;
+   return h ? h : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the table size (power of two) for n entries such that the
+/// load factor stays below 75%.
+
+Long64_t TTreeIndexHash::SlotsForEntries(Long64_t n)
+{
+   Long64_t nslots = 16;
+   while (nslots*3 < n*4) nslots <<= 1;
+   return nslots;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Insert an entry with the given hash, probing linearly for a free slot.
+/// If the hash is already present the entry number is overwritten, i.e.
+/// for duplicate (or colliding) pairs the entry inserted last wins.
+
+void TTreeIndexHash::Insert(ULong64_t hash, Long64_t entry)
+{
+   const ULong64_t mask = fNslots - 1;
+   ULong64_t slot = hash & mask;
+   while (fHashes[slot] && fHashes[slot] != hash) {
+      slot = (slot + 1) & mask;
+   }
+   fHashes[slot]  = hash;
+   fEntries[slot] = entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Grow the table to nslots slots and re-insert all occupied slots.
+/// Only the stored hashes are needed, the tree is not re-read.
+
+void TTreeIndexHash::Rehash(Long64_t nslots)
+{
+   ULong64_t *oldHashes  = fHashes;
+   Long64_t  *oldEntries = fEntries;
+   Long64_t   oldNslots  = fNslots;
+
+   fNslots  = nslots;
+   fHashes  = new ULong64_t[fNslots];
+   fEntries = new Long64_t[fNslots];
+   memset(fHashes, 0, fNslots*sizeof(ULong64_t));
+
+   for (Long64_t slot = 0; slot < oldNslots; slot++) {
+      if (oldHashes[slot]) Insert(oldHashes[slot], oldEntries[slot]);
+   }
+   delete [] oldHashes;
+   delete [] oldEntries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append 'add' to this index. Entry 0 in add will become entry n+1 in this.
+/// The delaySort argument is ignored: a hash table needs no sort pass.
+
+void TTreeIndexHash::Append(const TVirtualIndex *add, Bool_t /* delaySort */)
+{
+   if (add && add->GetN()) {
+      const TTreeIndexHash *th_add = dynamic_cast<const TTreeIndexHash*>(add);
+      if (th_add == 0) {
+         Error("Append","Can only Append a TTreeIndexHash to a TTreeIndexHash but got a %s",
+               add->IsA()->GetName());
+         return;
+      }
+
+      Long64_t oldn = fN;
+      fN += add->GetN();
+      if (fNslots*3 < fN*4) Rehash(SlotsForEntries(fN));
+
+      for (Long64_t slot = 0; slot < th_add->fNslots; slot++) {
+         if (th_add->fHashes[slot]) {
+            Insert(th_add->fHashes[slot], th_add->fEntries[slot] + oldn);
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Extend the index with the entries appended to the tree since the index
+/// was built (or last extended).
+///
+/// Only the entries in [GetN(), fTree->GetEntries()) are read and hashed;
+/// the table is grown in memory when the load factor would exceed 75%.
+///
+/// The return value is the number of entries added to the index
+/// (0 if the tree has not grown, < 0 indicates failure).
+
+Long64_t TTreeIndexHash::AppendNewEntries()
+{
+   if (!fTree) return -1;
+   Long64_t nentries = fTree->GetEntries();
+   if (nentries <= fN) return 0;
+
+   GetMajorFormula();
+   GetMinorFormula();
+   if (!fMajorFormula || !fMinorFormula ||
+       (fMajorFormula->GetNdim() != 1) || (fMinorFormula->GetNdim() != 1)) {
+      Error("AppendNewEntries","Cannot evaluate major=%s, minor=%s",fMajorName.Data(), fMinorName.Data());
+      return -1;
+   }
+   if (fNslots*3 < nentries*4) Rehash(SlotsForEntries(nentries));
+
+   Long64_t i;
+   Long64_t oldEntry = fTree->GetReadEntry();
+   Int_t current = -1;
+   for (i=fN;i<nentries;i++) {
+      Long64_t centry = fTree->LoadTree(i);
+      if (centry < 0) break;
+      if (fTree->GetTreeNumber() != current) {
+         current = fTree->GetTreeNumber();
+         fMajorFormula->UpdateFormulaLeaves();
+         fMinorFormula->UpdateFormulaLeaves();
+      }
+      Long64_t majorv = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+      Long64_t minorv = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
+      Insert(HashPair(majorv,minorv), i);
+   }
+   Long64_t nnew = nentries - fN;
+   fN = nentries;
+   fTree->LoadTree(oldEntry);
+   return nnew;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the entry number in this (friend) Tree corresponding to entry in
+/// the master Tree 'parent'.
+/// In case this (friend) Tree and 'master' do not share an index with the same
+/// major and minor name, the entry serial number in the (friend) tree
+/// and in the master Tree are assumed to be the same
+
+Long64_t TTreeIndexHash::GetEntryNumberFriend(const TTree *parent)
+{
+   if (!parent) return -3;
+   GetMajorFormulaParent(parent);
+   GetMinorFormulaParent(parent);
+   if (!fMajorFormulaParent || !fMinorFormulaParent) return -1;
+   if (!fMajorFormulaParent->GetNdim() || !fMinorFormulaParent->GetNdim()) {
+      // The Tree Index in the friend has a pair majorname,minorname
+      // not available in the parent Tree T.
+      // if the friend Tree has less entries than the parent, this is an error
+      Long64_t pentry = parent->GetReadEntry();
+      if (pentry >= fTree->GetEntries()) return -2;
+      // otherwise we ignore the Tree Index and return the entry number
+      // in the parent Tree.
+      return pentry;
+   }
+
+   // majorname, minorname exist in the parent Tree
+   // we find the current values pair majorv,minorv in the parent Tree
+   Double_t majord = fMajorFormulaParent->EvalInstance();
+   Double_t minord = fMinorFormulaParent->EvalInstance();
+   Long64_t majorv = (Long64_t)majord;
+   Long64_t minorv = (Long64_t)minord;
+   // we check if this pair exist in the index.
+   // if yes, we return the corresponding entry number
+   // if not the function returns -1
+   return fTree->GetEntryNumberWithIndex(majorv,minorv);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return entry number corresponding to major and minor number.
+/// A hash table keeps no ordering information, so contrary to
+/// TTreeIndex::GetEntryNumberWithBestIndex this function cannot return the
+/// entry with the pair immediately lower than the requested one: it returns
+/// the exact match or -1, like GetEntryNumberWithIndex.
+
+Long64_t TTreeIndexHash::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor) const
+{
+   return GetEntryNumberWithIndex(major, minor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return entry number corresponding to major and minor number.
+/// Note that this function returns only the entry number, not the data
+/// To read the data corresponding to an entry number, use TTree::GetEntryWithIndex
+/// The function probes the hash table and returns the stored entry number
+/// if the hash of the pair major,minor is found, otherwise it returns -1.
+
+Long64_t TTreeIndexHash::GetEntryNumberWithIndex(Long64_t major, Long64_t minor) const
+{
+   if (fNslots == 0) return -1;
+
+   const ULong64_t hash = HashPair(major, minor);
+   const ULong64_t mask = fNslots - 1;
+   ULong64_t slot = hash & mask;
+   while (fHashes[slot]) {
+      if (fHashes[slot] == hash) return fEntries[slot];
+      slot = (slot + 1) & mask;
+   }
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the TreeFormula corresponding to the majorname.
+
+TTreeFormula *TTreeIndexHash::GetMajorFormula()
+{
+   if (!fMajorFormula) {
+      fMajorFormula = new TTreeFormula("Major",fMajorName.Data(),fTree);
+      fMajorFormula->SetQuickLoad(kTRUE);
+   }
+   return fMajorFormula;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the TreeFormula corresponding to the minorname.
+
+TTreeFormula *TTreeIndexHash::GetMinorFormula()
+{
+   if (!fMinorFormula) {
+      fMinorFormula = new TTreeFormula("Minor",fMinorName.Data(),fTree);
+      fMinorFormula->SetQuickLoad(kTRUE);
+   }
+   return fMinorFormula;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the TreeFormula corresponding to the majorname in parent tree.
+
+TTreeFormula *TTreeIndexHash::GetMajorFormulaParent(const TTree *parent)
+{
+   if (!fMajorFormulaParent) {
+      // Prevent TTreeFormula from finding any of the branches in our TTree even if it
+      // is a friend of the parent TTree.
+      TTree::TFriendLock friendlock(fTree, TTree::kFindLeaf | TTree::kFindBranch | TTree::kGetBranch | TTree::kGetLeaf);
+      fMajorFormulaParent = new TTreeFormula("MajorP",fMajorName.Data(),const_cast<TTree*>(parent));
+      fMajorFormulaParent->SetQuickLoad(kTRUE);
+   }
+   if (fMajorFormulaParent->GetTree() != parent) {
+      fMajorFormulaParent->SetTree(const_cast<TTree*>(parent));
+      fMajorFormulaParent->UpdateFormulaLeaves();
+   }
+   return fMajorFormulaParent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the TreeFormula corresponding to the minorname in parent tree.
+
+TTreeFormula *TTreeIndexHash::GetMinorFormulaParent(const TTree *parent)
+{
+   if (!fMinorFormulaParent) {
+      // Prevent TTreeFormula from finding any of the branches in our TTree even if it
+      // is a friend of the parent TTree.
+      TTree::TFriendLock friendlock(fTree, TTree::kFindLeaf | TTree::kFindBranch | TTree::kGetBranch | TTree::kGetLeaf);
+      fMinorFormulaParent = new TTreeFormula("MinorP",fMinorName.Data(),const_cast<TTree*>(parent));
+      fMinorFormulaParent->SetQuickLoad(kTRUE);
+   }
+   if (fMinorFormulaParent->GetTree() != parent) {
+      fMinorFormulaParent->SetTree(const_cast<TTree*>(parent));
+      fMinorFormulaParent->UpdateFormulaLeaves();
+   }
+   return fMinorFormulaParent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print a summary of the hash index: number of entries, slots and
+/// resulting load factor.
+
+void TTreeIndexHash::Print(Option_t * /* option */) const
+{
+   Printf("\n**********************************************");
+   Printf("*    Hash index of Tree: %s/%s",fTree->GetName(),fTree->GetTitle());
+   Printf("**********************************************");
+   Printf("major: %s  minor: %s",fMajorName.Data(),fMinorName.Data());
+   Printf("entries: %lld  slots: %lld  load factor: %.2f",
+          fN, fNslots, fNslots ? Double_t(fN)/Double_t(fNslots) : 0.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stream an object of class TTreeIndexHash.
+/// Note that this Streamer should be changed to an automatic Streamer
+/// once TStreamerInfo supports an index of type Long64_t
+
+void TTreeIndexHash::Streamer(TBuffer &R__b)
+{
+   UInt_t R__s, R__c;
+   if (R__b.IsReading()) {
+      Version_t R__v = R__b.ReadVersion(&R__s, &R__c); if (R__v) { }
+      TVirtualIndex::Streamer(R__b);
+      fMajorName.Streamer(R__b);
+      fMinorName.Streamer(R__b);
+      R__b >> fN;
+      R__b >> fNslots;
+      fHashes = new ULong64_t[fNslots];
+      R__b.ReadFastArray(fHashes,fNslots);
+      fEntries = new Long64_t[fNslots];
+      R__b.ReadFastArray(fEntries,fNslots);
+      R__b.CheckByteCount(R__s, R__c, TTreeIndexHash::IsA());
+   } else {
+      R__c = R__b.WriteVersion(TTreeIndexHash::IsA(), kTRUE);
+      TVirtualIndex::Streamer(R__b);
+      fMajorName.Streamer(R__b);
+      fMinorName.Streamer(R__b);
+      R__b << fN;
+      R__b << fNslots;
+      R__b.WriteFastArray(fHashes, fNslots);
+      R__b.WriteFastArray(fEntries, fNslots);
+      R__b.SetByteCount(R__c, kTRUE);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by TChain::LoadTree when the parent chain changes it's tree.
+
+void TTreeIndexHash::UpdateFormulaLeaves(const TTree *parent)
+{
+   if (fMajorFormula)       { fMajorFormula->UpdateFormulaLeaves();}
+   if (fMinorFormula)       { fMinorFormula->UpdateFormulaLeaves();}
+   if (fMajorFormulaParent) {
+      if (parent) fMajorFormulaParent->SetTree(const_cast<TTree*>(parent));
+      fMajorFormulaParent->UpdateFormulaLeaves();
+   }
+   if (fMinorFormulaParent) {
+      if (parent) fMinorFormulaParent->SetTree(const_cast<TTree*>(parent));
+      fMinorFormulaParent->UpdateFormulaLeaves();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// this function is called by TChain::LoadTree and TTreePlayer::UpdateFormulaLeaves
+/// when a new Tree is loaded.
+/// Because Trees in a TChain may have a different list of leaves, one
+/// must update the leaves numbers in the TTreeFormula used by the TreeIndex.
+
+void TTreeIndexHash::SetTree(const TTree *T)
+{
+   fTree = (TTree*)T;
+}
@@ -77,6 +77,31 @@ ReadTotal +ReadTotal*Readextra/100. Same for ReadSize.
 A consequence of NOTE1, the Disk I/O speed corresponds to the effective
 number of bytes returned to the application per second.
 The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
+
+ ### Continuous monitoring :
+By default every read call adds a point to fGraphIO and fGraphTime, which
+is too expensive to leave enabled in a production job. Calling
+SetSampling(100) keeps only one graph point out of 100 (the counters
+fReadCalls, fBytesRead, fDiskTime remain exact) and EnableRingBuffer(n)
+records the last n reads in a fixed size ring buffer instead of growing
+the graphs without bound. EnableBranchStats() accumulates bytes, disk time
+and read calls per leaf; the per-branch tables can be written with
+ExportJSON (machine readable summary) or ExportFolded (collapsed stack
+format, one "tree;branch time" line per leaf, suitable for flamegraph
+tools). SetLiveExport("snap.json",1000) rewrites a small JSON snapshot
+atomically every 1000 read calls, so an external monitor can scrape the
+basket-read efficiency of a running job:
+~~~{.cpp}
+  TTreePerfStats *ps = new TTreePerfStats("ioperf",T);
+  ps->SetSampling(100);
+  ps->EnableBranchStats();
+  ps->SetLiveExport("ioperf-live.json",1000);
+  // ... event loop ...
+  ps->ExportJSON("ioperf.json");
+~~~
+Per-leaf attribution works on reads that fetch a single basket (ie when
+the TTreeCache is off or a basket misses the cache); large cache prefetch
+reads spanning many baskets are accumulated in the "other" entry.
 */
 
 #include "TTreePerfStats.h"
@@ -85,6 +110,9 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "Riostream.h"
 #include "TFile.h"
 #include "TTree.h"
+#include "TBasketCache.h"
+#include "TBranch.h"
+#include "TLeaf.h"
 #include "TAxis.h"
 #include "TBrowser.h"
 #include "TVirtualPad.h"
@@ -125,6 +153,21 @@ TTreePerfStats::TTreePerfStats() : TVirtualPerfStats()
    fCompress      = 0;
    fRealTimeAxis  = 0;
    fHostInfoText  = 0;
+   fSampling      = 0;
+   fRingSize      = 0;
+   fRingNext      = 0;
+   fRingTotal     = 0;
+   fRingEntry     = 0;
+   fRingOffset    = 0;
+   fRingLen       = 0;
+   fRingTime      = 0;
+   fLeafBytes     = 0;
+   fLeafTime      = 0;
+   fLeafReads     = 0;
+   fOtherBytes    = 0;
+   fOtherTime     = 0;
+   fSeekMap       = 0;
+   fLivePeriod    = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -159,6 +202,21 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    fDiskTime      = 0;
    fUnzipTime     = 0;
    fRealTimeAxis  = 0;
+   fSampling      = 0;
+   fRingSize      = 0;
+   fRingNext      = 0;
+   fRingTotal     = 0;
+   fRingEntry     = 0;
+   fRingOffset    = 0;
+   fRingLen       = 0;
+   fRingTime      = 0;
+   fLeafBytes     = 0;
+   fLeafTime      = 0;
+   fLeafReads     = 0;
+   fOtherBytes    = 0;
+   fOtherTime     = 0;
+   fSeekMap       = 0;
+   fLivePeriod    = 0;
    fCompress      = (T->GetTotBytes()+0.00001)/T->GetZipBytes();
 
    Bool_t isUNIX = strcmp(gSystem->GetName(), "Unix") == 0;
@@ -188,6 +246,14 @@ TTreePerfStats::~TTreePerfStats()
    delete fWatch;
    delete fRealTimeAxis;
    delete fHostInfoText;
+   delete [] fRingEntry;
+   delete [] fRingOffset;
+   delete [] fRingLen;
+   delete [] fRingTime;
+   delete [] fLeafBytes;
+   delete [] fLeafTime;
+   delete [] fLeafReads;
+   delete fSeekMap;
 
    if (gPerfStats == this) {
       gPerfStats = 0;
@@ -280,18 +346,120 @@ void TTreePerfStats::FileReadEvent(TFile *file, Int_t len, Double_t start)
 {
    if (file == this->fFile){
       Long64_t offset = file->GetRelOffset();
-      Int_t np = fGraphIO->GetN();
       Int_t entry = fTree->GetReadEntry();
-      fGraphIO->SetPoint(np,entry,1e-6*offset);
-      fGraphIO->SetPointError(np,0.001,1e-9*len);
       Double_t tnow = TTimeStamp();
       Double_t dtime = tnow-start;
       fDiskTime += dtime;
-      fGraphTime->SetPoint(np,entry,tnow);
-      fGraphTime->SetPointError(np,0.001,dtime);
       fReadCalls++;
       fBytesRead += len;
+      if (fLeafBytes) {
+         Int_t ileaf = LeafIndex(offset-len);
+         if (ileaf >= 0) {
+            fLeafBytes[ileaf] += len;
+            fLeafTime[ileaf]  += dtime;
+            fLeafReads[ileaf]++;
+         } else {
+            fOtherBytes += len;
+            fOtherTime  += dtime;
+         }
+      }
+      if (fRingSize) {
+         fRingEntry[fRingNext]  = entry;
+         fRingOffset[fRingNext] = offset-len;
+         fRingLen[fRingNext]    = len;
+         fRingTime[fRingNext]   = dtime;
+         fRingNext = (fRingNext+1)%fRingSize;
+         fRingTotal++;
+      }
+      if (fSampling <= 1 || (fReadCalls%fSampling) == 0) {
+         Int_t np = fGraphIO->GetN();
+         fGraphIO->SetPoint(np,entry,1e-6*offset);
+         fGraphIO->SetPointError(np,0.001,1e-9*len);
+         fGraphTime->SetPoint(np,entry,tnow);
+         fGraphTime->SetPointError(np,0.001,dtime);
+      }
+      if (fLivePeriod > 0 && (fReadCalls%fLivePeriod) == 0) DumpLive();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep the last nevents read events in a fixed size ring buffer instead of
+/// relying only on the ever growing fGraphIO/fGraphTime. Combined with
+/// SetSampling this bounds the memory used by a long running job.
+
+void TTreePerfStats::EnableRingBuffer(Int_t nevents)
+{
+   delete [] fRingEntry;
+   delete [] fRingOffset;
+   delete [] fRingLen;
+   delete [] fRingTime;
+   fRingSize  = nevents > 0 ? nevents : 0;
+   fRingNext  = 0;
+   fRingTotal = 0;
+   fRingEntry = fRingOffset = fRingLen = fRingTime = 0;
+   if (!fRingSize) return;
+   fRingEntry  = new Double_t[fRingSize];
+   fRingOffset = new Double_t[fRingSize];
+   fRingLen    = new Double_t[fRingSize];
+   fRingTime   = new Double_t[fRingSize];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Accumulate bytes read, disk time and number of read calls per leaf.
+/// The tables are written by ExportJSON and ExportFolded.
+
+void TTreePerfStats::EnableBranchStats()
+{
+   if (fLeafBytes || fNleaves <= 0) return;
+   fLeafBytes = new Long64_t[fNleaves];
+   fLeafTime  = new Double_t[fNleaves];
+   fLeafReads = new Int_t[fNleaves];
+   for (Int_t i=0;i<fNleaves;i++) {
+      fLeafBytes[i] = 0;
+      fLeafTime[i]  = 0;
+      fLeafReads[i] = 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Rewrite a small JSON snapshot to filename every period read calls
+/// (see DumpLive). Pass period=0 to disable the live export again.
+
+void TTreePerfStats::SetLiveExport(const char *filename, Int_t period)
+{
+   fLiveFileName = filename;
+   fLivePeriod   = period > 0 ? period : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index in the list of leaves of the leaf whose basket starts
+/// at the given file offset, or -1 if the offset does not match a basket
+/// (eg a TTreeCache prefetch covering many baskets).
+/// The basket seek table is built once on the first call and extended
+/// whenever an offset is not found (new baskets written since).
+
+Int_t TTreePerfStats::LeafIndex(Long64_t offset)
+{
+   if (!fSeekMap) fSeekMap = new std::map<Long64_t,Int_t>;
+   std::map<Long64_t,Int_t>::const_iterator it = fSeekMap->find(offset);
+   if (it != fSeekMap->end()) return it->second;
+   // (re)scan the basket seek tables of all leaves
+   TObjArray *leaves = fTree->GetListOfLeaves();
+   Int_t nleaves = leaves->GetEntriesFast();
+   for (Int_t i=0;i<nleaves && i<fNleaves;i++) {
+      TLeaf *leaf = (TLeaf*)leaves->UncheckedAt(i);
+      TBranch *branch = leaf->GetBranch();
+      if (!branch) continue;
+      Int_t nb = branch->GetWriteBasket()+1;
+      if (nb > branch->GetMaxBaskets()) nb = branch->GetMaxBaskets();
+      for (Int_t j=0;j<nb;j++) {
+         Long64_t seek = branch->GetBasketSeek(j);
+         if (seek > 0) (*fSeekMap)[seek] = i;
+      }
    }
+   it = fSeekMap->find(offset);
+   if (it != fSeekMap->end()) return it->second;
+   return -1;
 }
 
 
@@ -448,6 +616,11 @@ void TTreePerfStats::Print(Option_t * option) const
       printf("Strm Time = %7.3f seconds\n",fCpuTime-fUnzipTime);
       printf("UnzipTime = %7.3f seconds\n",fUnzipTime);
    }
+   TBasketCache &bc = TBasketCache::Instance();
+   if (bc.IsEnabled()) {
+      printf("BasketLRU = %g MBytes used (%g max), %lld hits, %lld misses\n",
+             1e-6*bc.GetSize(),1e-6*bc.GetMaxSize(),bc.GetNHits(),bc.GetNMisses());
+   }
    printf("Disk IO   = %7.3f MBytes/s\n",1e-6*fBytesRead/fDiskTime);
    printf("ReadUZRT  = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fRealTime);
    printf("ReadUZCP  = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fCpuTime);
@@ -469,6 +642,95 @@ void TTreePerfStats::SaveAs(const char *filename, Option_t * /*option*/) const
    ps->TObject::SaveAs(filename);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the global counters and, if EnableBranchStats was called, the
+/// per-leaf bytes/time/read tables to filename as a JSON document.
+/// The format is stable and meant to be parsed by monitoring tools.
+
+void TTreePerfStats::ExportJSON(const char *filename) const
+{
+   FILE *fp = fopen(filename,"w");
+   if (!fp) {
+      Error("ExportJSON","cannot open file %s",filename);
+      return;
+   }
+   Double_t extra = fBytesRead ? 100.*fBytesReadExtra/fBytesRead : 0;
+   fprintf(fp,"{\n");
+   fprintf(fp,"  \"name\": \"%s\",\n",fName.Data());
+   fprintf(fp,"  \"treeCacheSize\": %d,\n",fTreeCacheSize);
+   fprintf(fp,"  \"nLeaves\": %d,\n",fNleaves);
+   fprintf(fp,"  \"readCalls\": %d,\n",fReadCalls);
+   fprintf(fp,"  \"bytesRead\": %lld,\n",fBytesRead);
+   fprintf(fp,"  \"bytesReadExtra\": %lld,\n",fBytesReadExtra);
+   fprintf(fp,"  \"readExtraPercent\": %g,\n",extra);
+   fprintf(fp,"  \"diskTime\": %g,\n",fDiskTime);
+   fprintf(fp,"  \"unzipTime\": %g,\n",fUnzipTime);
+   fprintf(fp,"  \"realTime\": %g,\n",fWatch ? fWatch->RealTime() : fRealTime);
+   if (fWatch) fWatch->Continue();
+   fprintf(fp,"  \"compressionFactor\": %g",fCompress);
+   if (fLeafBytes) {
+      fprintf(fp,",\n  \"branches\": [\n");
+      TObjArray *leaves = fTree ? fTree->GetListOfLeaves() : 0;
+      for (Int_t i=0;i<fNleaves;i++) {
+         const char *lname = (leaves && i<leaves->GetEntriesFast()) ?
+                             leaves->UncheckedAt(i)->GetName() : "";
+         fprintf(fp,"    {\"name\": \"%s\", \"bytes\": %lld, \"time\": %g, \"reads\": %d}%s\n",
+                 lname,fLeafBytes[i],fLeafTime[i],fLeafReads[i],
+                 (i==fNleaves-1 && !fOtherBytes) ? "" : ",");
+      }
+      if (fOtherBytes) {
+         fprintf(fp,"    {\"name\": \"other\", \"bytes\": %lld, \"time\": %g, \"reads\": 0}\n",
+                 fOtherBytes,fOtherTime);
+      }
+      fprintf(fp,"  ]");
+   }
+   fprintf(fp,"\n}\n");
+   fclose(fp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the per-leaf disk time in collapsed stack format, one
+/// "tree;leaf microseconds" line per leaf with data, as expected by the
+/// usual flamegraph tools. Requires EnableBranchStats.
+
+void TTreePerfStats::ExportFolded(const char *filename) const
+{
+   if (!fLeafBytes) {
+      Error("ExportFolded","no per-branch statistics, call EnableBranchStats first");
+      return;
+   }
+   FILE *fp = fopen(filename,"w");
+   if (!fp) {
+      Error("ExportFolded","cannot open file %s",filename);
+      return;
+   }
+   const char *tname = fTree ? fTree->GetName() : fName.Data();
+   TObjArray *leaves = fTree ? fTree->GetListOfLeaves() : 0;
+   for (Int_t i=0;i<fNleaves;i++) {
+      if (!fLeafReads[i]) continue;
+      const char *lname = (leaves && i<leaves->GetEntriesFast()) ?
+                          leaves->UncheckedAt(i)->GetName() : "";
+      fprintf(fp,"%s;%s %lld\n",tname,lname,(Long64_t)(1e6*fLeafTime[i]));
+   }
+   if (fOtherBytes) fprintf(fp,"%s;other %lld\n",tname,(Long64_t)(1e6*fOtherTime));
+   fclose(fp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the live JSON snapshot set up with SetLiveExport.
+/// The snapshot is written to a temporary file first and renamed into
+/// place, so a scraper never sees a partially written document.
+/// Called automatically from FileReadEvent every fLivePeriod read calls,
+/// can also be called by hand.
+
+void TTreePerfStats::DumpLive()
+{
+   if (fLiveFileName.IsNull()) return;
+   TString tmpname = fLiveFileName + ".tmp";
+   ExportJSON(tmpname.Data());
+   gSystem->Rename(tmpname.Data(),fLiveFileName.Data());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
 
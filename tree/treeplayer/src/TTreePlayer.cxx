@@ -75,8 +75,12 @@ extra libraries (Histogram, display, etc).
 #include "TRefArrayProxy.h"
 #include "TVirtualMonitoring.h"
 #include "TTreeCache.h"
+#include "TRandom.h"
 #include "TStyle.h"
 
+#include <utility>
+#include <vector>
+
 #include "HFitInterface.h"
 #include "Foption.h"
 #include "Fit/DataVector.h"
@@ -108,6 +112,7 @@ TTreePlayer::TTreePlayer()
    fSelectorFromFile = 0;
    fSelectorClass    = 0;
    fSelectorUpdate   = 0;
+   fDrawSample       = 0;
    fInput            = new TList();
    fInput->Add(new TNamed("varexp",""));
    fInput->Add(new TNamed("selection",""));
@@ -328,6 +333,22 @@ Long64_t TTreePlayer::DrawScript(const char* wrapperPrefix,
 /// Draw expression varexp for specified entries that matches the selection.
 /// Returns -1 in case of error or number of selected events in case of success.
 ///
+/// The option "sample(n)" draws from a progressive sample instead of the
+/// full statistics: the entries are streamed in randomized cluster order,
+/// the canvas is updated as the points accumulate and the loop stops once n
+/// entries passed the selection. A scatter plot whose visual density
+/// saturates well below the total number of entries renders identically
+/// from such a sample at a fraction of the cost, e.g.
+/// ~~~{.cpp}
+///    tree->Draw("py:px","pt>1","sample(100000)");
+/// ~~~
+/// The sample is unbiased (whole clusters are shuffled, which keeps the
+/// reads sequential within each basket range) but the filled histogram
+/// holds only the sampled entries: do not use it for quantitative results
+/// without scaling. With an event list, an entry list or a chain the
+/// entries are streamed in their normal order and only the early stop
+/// applies.
+///
 /// See the documentation of TTree::Draw for the complete details.
 
 Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Option_t *option,Long64_t nentries, Long64_t firstentry)
@@ -390,6 +411,28 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
 
    TString opt = option;
    opt.ToLower();
+   // progressive sampling: "sample(n)" is handled by the entry loop in
+   // Process and must not reach the histogram paint options
+   TString optFull = option;
+   fDrawSample = 0;
+   Ssiz_t sampleIdx = opt.Index("sample(");
+   if (sampleIdx != kNPOS) {
+      Ssiz_t sampleEnd = opt.Index(")", sampleIdx);
+      if (sampleEnd == kNPOS) {
+         Error("DrawSelect", "missing ')' in the sample(n) draw option");
+         return -1;
+      }
+      TString num = opt(sampleIdx + 7, sampleEnd - sampleIdx - 7);
+      fDrawSample = num.Atoll();
+      if (fDrawSample <= 0) {
+         Error("DrawSelect", "invalid sample size in the sample(n) draw option: %s", num.Data());
+         fDrawSample = 0;
+         return -1;
+      }
+      opt.Remove(sampleIdx, sampleEnd - sampleIdx + 1);
+      optFull.Remove(sampleIdx, sampleEnd - sampleIdx + 1);
+      option = optFull.Data();
+   }
    Bool_t optpara   = kFALSE;
    Bool_t optcandle = kFALSE;
    Bool_t optgl5d   = kFALSE;
@@ -412,6 +455,7 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
 
    // invoke the selector
    Long64_t nrows = Process(fSelector,option,nentries,firstentry);
+   fDrawSample = 0;
    fSelectedRows = nrows;
    fDimension = fSelector->GetDimension();
 
@@ -2190,7 +2234,28 @@ Long64_t TTreePlayer::Process(const char *filename,Option_t *option, Long64_t ne
    // string! so let copy it first:
    TString opt(option);
    TString file(filename);
-   TSelector *selector = TSelector::GetSelector(file);
+
+   TSelector *selector = 0;
+
+   // Transparently promote an interpreted selector script to a compiled one
+   // for long event loops: an interpreted Process() call per entry is easily
+   // an order of magnitude slower, and ACLiC caches the compiled library
+   // across jobs so the compilation cost is paid only when the source
+   // changed.  Controlled by TreePlayer.AutoCompileSelector (default on)
+   // and TreePlayer.AutoCompileSelectorEntries (entry count below which
+   // interpreting is cheaper than compiling, default 100000).
+   if (file.Contains(".") && !file.Contains("+") && !file.Contains("(") &&
+       gEnv->GetValue("TreePlayer.AutoCompileSelector", 1)) {
+      Long64_t towarm = (Long64_t)gEnv->GetValue("TreePlayer.AutoCompileSelectorEntries", 100000);
+      if (GetEntriesToProcess(firstentry, nentries) >= towarm) {
+         selector = TSelector::GetSelector(file + "+");
+         if (!selector)
+            Warning("Process", "cannot compile selector %s, falling back to the interpreted version",
+                    file.Data());
+      }
+   }
+
+   if (!selector) selector = TSelector::GetSelector(file);
    if (!selector) return -1;
 
    fSelectorFromFile = selector;
@@ -2283,28 +2348,84 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
       fSelectorUpdate = selector;
       UpdateFormulaLeaves();
 
-      for (entry=firstentry;entry<firstentry+nentries;entry++) {
+      Int_t lastRangeTree = -1;
+
+      // With DrawSelect's sample(n) option the entries are streamed in
+      // randomized cluster order and the loop stops once n entries were
+      // sampled. Shuffling whole clusters keeps the reads sequential
+      // within each basket range and still gives an unbiased sample. An
+      // event list, an entry list or a chain keeps the normal order (the
+      // mapping from loop index to entry number must be preserved); the
+      // early stop still applies. Without sampling there is one range
+      // covering the full requested interval and the loop is unchanged.
+      Bool_t sampling = (fDrawSample > 0);
+      std::vector<std::pair<Long64_t, Long64_t> > ranges;
+      if (sampling && !fTree->GetEntryList() && !fTree->GetEventList()
+          && fTree->IsA() != TChain::Class()) {
+         TTree::TClusterIterator clusterIter = fTree->GetClusterIterator(firstentry);
+         Long64_t clusterStart = clusterIter();
+         while (clusterStart < firstentry + nentries) {
+            Long64_t clusterNext = clusterIter.GetNextEntry();
+            Long64_t lo = (clusterStart > firstentry) ? clusterStart : firstentry;
+            Long64_t hi = (clusterNext < firstentry + nentries) ? clusterNext : firstentry + nentries;
+            if (lo < hi) ranges.push_back(std::make_pair(lo, hi));
+            if (clusterNext <= clusterStart) break;
+            clusterStart = clusterIter.Next();
+         }
+         for (size_t i = ranges.size(); i > 1; --i) {
+            size_t j = (size_t)(gRandom->Rndm() * i);
+            if (j >= i) j = i - 1;
+            std::swap(ranges[i-1], ranges[j]);
+         }
+      }
+      if (ranges.empty())
+         ranges.push_back(std::make_pair(firstentry, firstentry + nentries));
+      Long64_t nsampled = 0;
+      Bool_t endOfLoop = kFALSE;
+
+      for (std::vector<std::pair<Long64_t, Long64_t> >::const_iterator range = ranges.begin();
+           !endOfLoop && range != ranges.end(); ++range) {
+      for (entry=range->first;entry<range->second;entry++) {
          entryNumber = fTree->GetEntryNumber(entry);
-         if (entryNumber < 0) break;
-         if (timer && timer->ProcessEvents()) break;
-         if (gROOT->IsInterrupted()) break;
+         if (entryNumber < 0) { endOfLoop = kTRUE; break; }
+         if (timer && timer->ProcessEvents()) { endOfLoop = kTRUE; break; }
+         if (gROOT->IsInterrupted()) { endOfLoop = kTRUE; break; }
          localEntry = fTree->LoadTree(entryNumber);
-         if (localEntry < 0) break;
+         if (localEntry < 0) { endOfLoop = kTRUE; break; }
+         if (fTree->GetTreeNumber() != lastRangeTree) {
+            // On every new (sub-)tree check the declared range cut (see
+            // TTree::SetRangeCut) against the tree's range summary and
+            // skip the whole tree when no entry can pass. The entry jump
+            // assumes the identity entry mapping, so an entry list
+            // disables the shortcut.
+            lastRangeTree = fTree->GetTreeNumber();
+            if (!fTree->GetEntryList() && !fTree->PassesRangeCut()) {
+               entry += fTree->GetTree()->GetEntries() - localEntry - 1;
+               continue;
+            }
+         }
          if(useCutFill) {
-            if (selector->ProcessCut(localEntry))
+            if (selector->ProcessCut(localEntry)) {
                selector->ProcessFill(localEntry); //<==call user analysis function
+               ++nsampled;
+            }
          } else {
             selector->Process(localEntry);        //<==call user analysis function
+            ++nsampled;
          }
          if (gMonitoringWriter)
             gMonitoringWriter->SendProcessingProgress((entry-firstentry),TFile::GetFileBytesRead()-readbytesatstart,kTRUE);
-         if (selector->GetAbort() == TSelector::kAbortProcess) break;
+         if (selector->GetAbort() == TSelector::kAbortProcess) { endOfLoop = kTRUE; break; }
          if (selector->GetAbort() == TSelector::kAbortFile) {
             // Skip to the next file.
             entry += fTree->GetTree()->GetEntries() - localEntry;
             // Reset the abort status.
             selector->ResetAbort();
          }
+         if (sampling && nsampled >= fDrawSample) { endOfLoop = kTRUE; break; }
+      }
+      // let the accumulated points of the sample appear as they come in
+      if (sampling && gPad) gPad->Update();
       }
       delete timer;
       //we must reset the cache
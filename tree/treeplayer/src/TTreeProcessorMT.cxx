@@ -27,6 +27,8 @@ objects.
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+#include <algorithm>
+
 using namespace ROOT;
 
 ////////////////////////////////////////////////////////////////////////
@@ -78,16 +80,49 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    // Enable this IMT use case (activate its locks)
    Internal::TParTreeProcessingRAII ptpRAII;
 
-   // Iterate over the collection of files
-   std::vector<std::tuple<Long64_t, Long64_t, size_t>> vTuple;
+   // Iterate over the collection of files and collect the cluster boundaries
+   std::vector<std::tuple<Long64_t, Long64_t, size_t>> vClusters;
+   Long64_t totalEntries = 0;
    for (size_t i = 0; i < treeView->GetNumFiles(); ++i) {
       treeView->SetCurrent(i);
       auto clusterIter = treeView->GetClusterIterator();
       Long64_t start = 0, end = 0;
-      // Iterate over the clusters in the current file and generate a task for each of them
+      // Iterate over the clusters in the current file
       while ((start = clusterIter()) < treeView->GetEntries()) {
          end = clusterIter.GetNextEntry();
-         vTuple.emplace_back(start, end, i);
+         vClusters.emplace_back(start, end, i);
+         totalEntries += end - start;
+      }
+   }
+
+   // Repack the clusters into tasks of roughly uniform entry count. Cluster
+   // sizes can be very skewed (e.g. a file written with one large basket next
+   // to files with many small ones); with one task per cluster most workers
+   // then idle at the end of the event loop while a few chew on the big
+   // clusters. The executor steals work at task granularity, so aim for
+   // several tasks per worker: runs of small clusters of the same file are
+   // packed into one task and oversized clusters are split (the sub-tasks
+   // decompress the same baskets twice, which is still cheaper than an idle
+   // core). Tasks of the same file stay adjacent in the list, so the
+   // contiguous chunks a worker grabs tend to refer to the file it already
+   // has open.
+   auto nWorkers = ROOT::GetImplicitMTPoolSize();
+   if (nWorkers == 0) nWorkers = 1;
+   const Long64_t maxTaskEntries = std::max(Long64_t(1), totalEntries / (8 * (Long64_t)nWorkers));
+
+   std::vector<std::tuple<Long64_t, Long64_t, size_t>> vTuple;
+   for (auto &c : vClusters) {
+      Long64_t start = std::get<0>(c), end = std::get<1>(c);
+      size_t fileIdx = std::get<2>(c);
+      if (end - start > maxTaskEntries) {
+         for (Long64_t s = start; s < end; s += maxTaskEntries)
+            vTuple.emplace_back(s, std::min(s + maxTaskEntries, end), fileIdx);
+      } else if (!vTuple.empty() && std::get<2>(vTuple.back()) == fileIdx &&
+                 std::get<1>(vTuple.back()) == start &&
+                 (std::get<1>(vTuple.back()) - std::get<0>(vTuple.back())) + (end - start) <= maxTaskEntries) {
+         std::get<1>(vTuple.back()) = end;
+      } else {
+         vTuple.emplace_back(start, end, fileIdx);
       }
    }
 
@@ -101,6 +101,16 @@ namespace {
             return myCollectionProxy->At(idx);
          }
       }
+
+      virtual void* GetContiguousStart(ROOT::Detail::TBranchProxy* proxy) {
+         // Only a vector of values is guaranteed to keep its elements back to
+         // back in memory; other collection types and collections of pointers
+         // need the per-element proxy access.
+         TVirtualCollectionProxy *myCollectionProxy = GetCP(proxy);
+         if (!myCollectionProxy || myCollectionProxy->HasPointers()) return 0;
+         if (myCollectionProxy->GetCollectionType() != ROOT::kSTLvector) return 0;
+         return myCollectionProxy->Size() ? myCollectionProxy->At(0) : 0;
+      }
    };
 
    class TCollectionLessSTLReader : public TVirtualCollectionReader {
@@ -140,6 +150,15 @@ namespace {
             return myCollectionProxy->At(idx);
          }
       }
+
+      virtual void* GetContiguousStart(ROOT::Detail::TBranchProxy* proxy) {
+         // See TSTLReader::GetContiguousStart().
+         TVirtualCollectionProxy *myCollectionProxy = GetCP(proxy);
+         if (!myCollectionProxy || myCollectionProxy->HasPointers()) return 0;
+         if (myCollectionProxy->GetCollectionType() != ROOT::kSTLvector) return 0;
+         TVirtualCollectionProxy::TPushPop ppRaii(myCollectionProxy, proxy->GetWhere());
+         return myCollectionProxy->Size() ? myCollectionProxy->At(0) : 0;
+      }
    };
 
 
@@ -185,6 +204,13 @@ namespace {
          return (void*)((Byte_t*)array + (objectSize * idx));
       }
 
+      virtual void* GetContiguousStart(ROOT::Detail::TBranchProxy* proxy) {
+         // At() is plain pointer arithmetic on GetStart(), so the elements are
+         // contiguous by construction.
+         if (!proxy->Read()) return 0;
+         return (void*)proxy->GetStart();
+      }
+
       void SetBasicTypeSize(Int_t size){
          fBasicTypeSize = size;
       }
@@ -294,6 +320,12 @@ namespace {
          return (Byte_t*)address + (fElementSize * idx);
       }
 
+      virtual void* GetContiguousStart(ROOT::Detail::TBranchProxy* /*proxy*/){
+         // Leaf arrays are a single block at the value reader's address.
+         ProxyRead();
+         return fValueReader->GetAddress();
+      }
+
    protected:
       void ProxyRead(){
          fValueReader->ProxyRead();
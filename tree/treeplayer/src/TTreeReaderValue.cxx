@@ -46,7 +46,9 @@ ROOT::Internal::TTreeReaderValueBase::TTreeReaderValueBase(TTreeReader* reader /
    fProxy(NULL),
    fLeaf(NULL),
    fSetupStatus(kSetupNotSetup),
-   fReadStatus(kReadNothingYet)
+   fReadStatus(kReadNothingYet),
+   fCachedWhere(NULL),
+   fCachedGeneration(0)
 {
    RegisterWithTreeReader();
 }
@@ -63,6 +65,8 @@ ROOT::Internal::TTreeReaderValueBase::TTreeReaderValueBase(const TTreeReaderValu
    fLeaf(rhs.fLeaf),
    fSetupStatus(rhs.fSetupStatus),
    fReadStatus(rhs.fReadStatus),
+   fCachedWhere(NULL),
+   fCachedGeneration(0),
    fStaticClassOffsets(rhs.fStaticClassOffsets)
 {
    RegisterWithTreeReader();
@@ -87,6 +91,8 @@ ROOT::Internal::TTreeReaderValueBase::operator=(const TTreeReaderValueBase& rhs)
       fLeaf = rhs.fLeaf;
       fSetupStatus = rhs.fSetupStatus;
       fReadStatus = rhs.fReadStatus;
+      fCachedWhere = NULL;
+      fCachedGeneration = 0;
       fStaticClassOffsets = rhs.fStaticClassOffsets;
    }
    return *this;
@@ -193,6 +199,7 @@ void ROOT::Internal::TTreeReaderValueBase::CreateProxy() {
       return;
    }
 
+   fCachedWhere = NULL; // a new proxy invalidates any previously cached address
    fSetupStatus = kSetupInternalError; // Fallback; set to something concrete below.
    if (!fTreeReader) {
       Error("TTreeReaderValueBase::CreateProxy()", "TTreeReader object not set / available for branch %s!",
@@ -0,0 +1,128 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeShuffler
+Export the entries of a TTree in shuffled order at near-sequential
+throughput.
+
+Machine-learning trainings want their events in random order, but
+calling TTree::GetEntry with a fully random permutation defeats the
+TTreeCache: every entry touches baskets scattered over the file and the
+export can run orders of magnitude slower than a sequential read.
+
+TTreeShuffler permutes the entries only inside a sliding window of
+whole clusters.  The window advances strictly forward, so all baskets
+needed by one window are read once, in file order, and every GetEntry
+inside the window is then served from the cache.  The shuffle quality
+is set by the window size: with the default of 10 clusters and typical
+cluster sizes an event is displaced by many thousands of entries, which
+is plenty to decorrelate the batches of a training; a larger window
+mixes more at the price of a bigger cache.  For full-range mixing,
+shuffle twice with different seeds: the cluster layout of the output
+tree does not match the window boundaries of the first pass.
+
+The output tree is created with CloneTree(0) in the current directory,
+so the usual idiom is:
+~~~{.cpp}
+TFile out("train.root", "RECREATE");
+TTreeShuffler shuffler(inputTree);
+shuffler.SetSeed(12345);
+TTree *shuffled = shuffler.Shuffle();
+out.Write();
+~~~
+The shuffled tree is a plain TTree; TMVA (or any other consumer) reads
+it like the original.
+*/
+
+#include "TTreeShuffler.h"
+
+#include "TError.h"
+#include "TRandom3.h"
+#include "TTree.h"
+
+#include <vector>
+
+ClassImp(TTreeShuffler)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a shuffler for the given tree.  The defaults shuffle inside a
+/// window of 10 clusters with a clock-derived random seed and leave the
+/// cache settings of the tree untouched.
+
+TTreeShuffler::TTreeShuffler(TTree *tree /*= 0*/)
+   : fTree(tree), fWindowClusters(10), fSeed(0), fCacheSize(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Clone the structure of the input tree into the current directory and
+/// fill the clone with the entries of the input tree, shuffled inside a
+/// sliding window of GetWindowClusters() clusters.  Returns the shuffled
+/// tree, or 0 on error.
+
+TTree *TTreeShuffler::Shuffle()
+{
+   if (!fTree) {
+      Error("Shuffle", "no input tree set");
+      return 0;
+   }
+
+   Long64_t nentries = fTree->GetEntries();
+   TTree *newtree = fTree->CloneTree(0);
+   if (!newtree) {
+      Error("Shuffle", "cannot clone the structure of tree %s", fTree->GetName());
+      return 0;
+   }
+
+   if (fCacheSize > 0) {
+      fTree->SetCacheSize(fCacheSize);
+      fTree->AddBranchToCache("*", kTRUE);
+   }
+
+   TRandom3 rndm(fSeed);
+   std::vector<Long64_t> window;
+   TTree::TClusterIterator clusterIter = fTree->GetClusterIterator(0);
+
+   Long64_t winStart = 0;
+   while (winStart < nentries) {
+      // advance by whole clusters so the window never straddles a basket
+      Long64_t winEnd = winStart;
+      for (Int_t ic = 0; ic < fWindowClusters && winEnd < nentries; ++ic) {
+         winEnd = clusterIter.Next();
+      }
+      if (winEnd <= winStart || winEnd > nentries) winEnd = nentries;
+
+      // Fisher-Yates permutation of the entries of the window
+      window.resize(winEnd - winStart);
+      for (Long64_t i = 0; i < winEnd - winStart; ++i) {
+         window[i] = winStart + i;
+      }
+      for (Long64_t i = winEnd - winStart - 1; i > 0; --i) {
+         Long64_t j = (Long64_t)rndm.Integer(i + 1);
+         Long64_t tmp = window[i];
+         window[i] = window[j];
+         window[j] = tmp;
+      }
+
+      // the reads are random inside the window but the window is only a few
+      // clusters wide: the baskets stay resident in the TTreeCache
+      for (std::vector<Long64_t>::const_iterator it = window.begin(); it != window.end(); ++it) {
+         if (fTree->GetEntry(*it) < 0) {
+            Error("Shuffle", "error reading entry %lld of tree %s", *it, fTree->GetName());
+            return 0;
+         }
+         newtree->Fill();
+      }
+
+      winStart = winEnd;
+   }
+
+   return newtree;
+}
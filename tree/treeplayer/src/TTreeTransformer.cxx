@@ -0,0 +1,188 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeTransformer
+Produce a derived TTree from a declarative column mapping.
+
+Derivation productions typically copy the vast majority of a tree
+unchanged and only drop a few columns, rename a few others and add a
+handful of recomputed ones.  Doing this with per-entry GetEntry/Fill
+deserializes and recompresses every basket just to write most of the
+bytes back untouched.
+
+TTreeTransformer instead carries all untouched branches over with a
+fast clone: their baskets are copied at the compressed level and are
+never deserialized.  Dropped branches are excluded from the clone,
+renames are applied to the branch and leaf objects of the output tree
+(the stored baskets need no rewrite for that), and each Define()d
+column is evaluated with a TTreeFormula in a single native loop that
+reads only the branches the expressions actually use.
+
+~~~{.cpp}
+TFile out("derived.root", "RECREATE");
+TTreeTransformer transformer(inputTree);
+transformer.Drop("trig_*");
+transformer.Rename("mu_pt", "muon_pt");
+transformer.Define("ht", "Sum$(jet_pt)");
+TTree *derived = transformer.Transform();
+out.Write();
+~~~
+
+Defined columns are scalar double precision branches; for anything
+more structured write a TSelector or use TDataFrame with Snapshot.
+*/
+
+#include "TTreeTransformer.h"
+
+#include "TBranch.h"
+#include "TError.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+ClassImp(TTreeTransformer)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a transformer for the given tree.  With no Drop/Rename/Define
+/// calls Transform() degenerates into a plain fast clone.
+
+TTreeTransformer::TTreeTransformer(TTree *tree /*= 0*/)
+   : fTree(tree), fCacheSize(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Exclude the branches matching pattern (TRegexp wildcards, as in
+/// TTree::SetBranchStatus) from the output tree.
+
+void TTreeTransformer::Drop(const char *pattern)
+{
+   fDrops.push_back(TString(pattern));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Rename the branch oldname (and its homonymous leaf) to newname in the
+/// output tree.  The carried-over baskets are not rewritten: branches are
+/// located through the tree header, so the rename costs nothing.
+
+void TTreeTransformer::Rename(const char *oldname, const char *newname)
+{
+   fRenames.push_back(std::make_pair(TString(oldname), TString(newname)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a recomputed scalar column to the output tree.  The expression uses
+/// the TTreeFormula syntax against the *input* tree, so it may refer to
+/// dropped branches and must use the original names of renamed ones.
+
+void TTreeTransformer::Define(const char *name, const char *expression)
+{
+   fDefines.push_back(std::make_pair(TString(name), TString(expression)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce the derived tree in the current directory and return it, or 0
+/// on error.  Untouched branches are fast cloned (compressed basket copy),
+/// then the defined columns are filled in one loop over the input entries
+/// that reads only the branches used by the expressions.
+
+TTree *TTreeTransformer::Transform()
+{
+   if (!fTree) {
+      Error("Transform", "no input tree set");
+      return 0;
+   }
+
+   for (std::vector<TString>::const_iterator it = fDrops.begin(); it != fDrops.end(); ++it)
+      fTree->SetBranchStatus(it->Data(), 0);
+
+   // The deactivated branches are left out of the clone; the fast option
+   // makes CopyEntries go through TTreeCloner, which moves the baskets of
+   // the remaining branches without unzipping them.
+   TTree *newtree = fTree->CloneTree(-1, "fast SortBasketsByEntry");
+
+   for (std::vector<TString>::const_iterator it = fDrops.begin(); it != fDrops.end(); ++it)
+      fTree->SetBranchStatus(it->Data(), 1);
+
+   if (!newtree) {
+      Error("Transform", "cannot fast clone tree %s", fTree->GetName());
+      return 0;
+   }
+
+   for (std::size_t i = 0; i < fRenames.size(); i++) {
+      const TString &oldname = fRenames[i].first;
+      const TString &newname = fRenames[i].second;
+      TBranch *branch = newtree->GetBranch(oldname);
+      if (!branch) {
+         Warning("Transform", "cannot rename branch %s: no such branch in the output tree",
+                 oldname.Data());
+         continue;
+      }
+      TObjArray *leaves = branch->GetListOfLeaves();
+      for (Int_t l = 0; leaves && l < leaves->GetEntriesFast(); l++) {
+         TLeaf *leaf = (TLeaf*) leaves->UncheckedAt(l);
+         if (leaf && oldname == leaf->GetName())
+            leaf->SetName(newname);
+      }
+      TString title = branch->GetTitle();
+      if (title.BeginsWith(oldname))
+         title.Replace(0, oldname.Length(), newname);
+      branch->SetTitle(title);
+      branch->SetName(newname);
+   }
+
+   if (!fDefines.empty()) {
+      Long64_t nentries = fTree->GetEntries();
+      std::vector<TTreeFormula*> formulas;
+      std::vector<TBranch*> branches;
+      std::vector<Double_t> values(fDefines.size());
+
+      for (std::size_t i = 0; i < fDefines.size(); i++) {
+         const TString &name = fDefines[i].first;
+         const TString &expression = fDefines[i].second;
+         TTreeFormula *formula = new TTreeFormula(name, expression, fTree);
+         if (formula->GetNdim() <= 0) {
+            Error("Transform", "invalid expression \"%s\" for column %s",
+                  expression.Data(), name.Data());
+            delete formula;
+            for (std::size_t j = 0; j < formulas.size(); j++) delete formulas[j];
+            delete newtree;
+            return 0;
+         }
+         formulas.push_back(formula);
+         branches.push_back(newtree->Branch(name, &values[i], name + "/D"));
+      }
+
+      if (fCacheSize > 0)
+         fTree->SetCacheSize(fCacheSize);
+
+      Int_t treenumber = -1;
+      for (Long64_t entry = 0; entry < nentries; entry++) {
+         if (fTree->LoadTree(entry) < 0) break;
+         if (treenumber != fTree->GetTreeNumber()) {
+            treenumber = fTree->GetTreeNumber();
+            for (std::size_t i = 0; i < formulas.size(); i++)
+               formulas[i]->UpdateFormulaLeaves();
+         }
+         for (std::size_t i = 0; i < formulas.size(); i++) {
+            formulas[i]->GetNdata();
+            values[i] = formulas[i]->EvalInstance(0);
+            branches[i]->Fill();
+         }
+      }
+
+      for (std::size_t i = 0; i < formulas.size(); i++) delete formulas[i];
+      // The new branches point to the local values vector; detach them.
+      newtree->ResetBranchAddresses();
+   }
+
+   return newtree;
+}